@@ -36,6 +36,7 @@
 #include "PxPhysXConfig.h"
 #include "PxDeletionListener.h"
 #include "foundation/PxTransform.h"
+#include "foundation/PxFoundation.h"
 #include "PxShape.h"
 #include "PxAggregate.h"
 #include "PxBuffer.h"
@@ -67,6 +68,7 @@ class PxFoundation;
 
 class PxPruningStructure;
 class PxBVH;
+class PxCpuDispatcher;
 /**
  * @deprecated
  */
@@ -489,6 +491,25 @@ public:
 	*/
 	virtual PxPruningStructure* createPruningStructure(PxRigidActor*const* actors, PxU32 nbActors) = 0;
 
+	/**
+	\brief Creates a pruning structure from actors, building its trees on multiple threads.
+
+	The call blocks until the build is complete. The same requirements as for the single-threaded version apply to the actors.
+
+	\note The default implementation ignores the dispatcher and builds the trees on the calling thread.
+
+	\param	[in] actors		Array of actors to add to the pruning structure. Must be non NULL.
+	\param	[in] nbActors	Number of actors in the array. Must be >0.
+	\param	[in] dispatcher	CPU dispatcher running the build tasks.
+	\return Pruning structure created from given actors, or NULL if any of the actors did not comply with the above requirements.
+	@see PxActor PxPruningStructure PxCpuDispatcher
+	*/
+	virtual PxPruningStructure* createPruningStructure(PxRigidActor*const* actors, PxU32 nbActors, PxCpuDispatcher& dispatcher)
+	{
+		PX_UNUSED(dispatcher);
+		return createPruningStructure(actors, nbActors);
+	}
+
 	//@}
 	/** @name Shapes
 	*/
@@ -1181,6 +1202,42 @@ public:
 	virtual PxInsertionCallback& getPhysicsInsertionCallback() = 0;
 
 	//@}
+
+	/** @name Meshes (continued)
+	*/
+	//@{
+
+	/**
+	\brief Creates a triangle mesh object that directly references a cooked in-place image.
+
+	Contrary to #createTriangleMesh(), the vertices, triangles, per-triangle data and BVH34 nodes are not copied: the mesh
+	points into the image, so a file mapped into memory is usable without any decoding, and its pages can be shared between
+	processes. The image must have been produced by #PxCookTriangleMeshInPlace() on a platform with the same endianness.
+
+	The memory must be 16-byte aligned, and it must stay valid and unmodified until the mesh has been released. The mesh never
+	writes to it, unless #PxTriangleMesh::getVerticesForModification() or #PxTriangleMesh::refitBVH() are used, in which case
+	the memory must be writable (e.g. a private copy-on-write mapping).
+
+	The image is validated before use: array bounds, triangle indices and the BVH34 tree are checked, which takes time linear
+	in the size of the image but does not allocate or copy anything.
+
+	\note The default implementation reports an eINVALID_OPERATION error and returns NULL.
+
+	\param	[in] memory	The in-place image. Must be 16-byte aligned.
+	\param	[in] size	Size of the image in bytes.
+	\return The new triangle mesh, or NULL if the image is invalid.
+
+	@see PxCookTriangleMeshInPlace createTriangleMesh PxTriangleMesh.release()
+	*/
+	virtual PxTriangleMesh* createTriangleMeshInPlace(const void* memory, PxU32 size)
+	{
+		PX_UNUSED(memory);
+		PX_UNUSED(size);
+		PxGetFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, "PxPhysics::createTriangleMeshInPlace: not supported.");
+		return NULL;
+	}
+
+	//@}
 };
 
 #if !PX_DOXYGEN
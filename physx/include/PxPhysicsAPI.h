@@ -249,5 +249,6 @@ Alternatively, one can instead directly #include a subset of the below files.
 #include "pvd/PxPvdSceneClient.h"
 #include "pvd/PxPvd.h"
 #include "pvd/PxPvdTransport.h"
+#include "pvd/PxPvdAsyncFileTransport.h"
 /** @} */
 #endif
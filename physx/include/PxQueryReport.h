@@ -32,6 +32,8 @@
 @{
 */
 #include "foundation/PxVec3.h"
+#include "foundation/PxBounds3.h"
+#include "foundation/PxTransform.h"
 #include "foundation/PxFlags.h"
 #include "foundation/PxAssert.h"
 #include "geometry/PxGeometryHit.h"
@@ -242,6 +244,94 @@ struct PxSweepBufferN : public PxHitBuffer<PxSweepHit>
 	PxSweepBufferN() : PxHitBuffer<PxSweepHit>(hits, N) {}
 };
 
+/**
+\brief Candidate shape captured by a PxQueryCandidateCache.
+
+@see PxQueryCandidateCache
+*/
+struct PxQueryCandidate
+{
+	size_t			payload[2];	//!< Internal data identifying the shape
+	PxTransform		pose;		//!< World pose of the shape
+};
+
+/**
+\brief Candidate cache for repeated overlap and sweep queries.
+
+Character, AI or camera code often issues nearly identical overlaps and sweeps every frame. When a candidate cache is supplied
+to such a query (see PxQueryCache::candidates), the static shapes whose bounds touch the query volume enlarged by #tolerance are
+captured in the user-provided candidate buffer. Subsequent queries whose volume remains within that enlarged volume reuse the
+captured candidates and only run the narrow-phase tests, as long as the static scene query structure has not changed since
+(see PxSceneQuerySystemBase::getStaticTimestamp()).
+
+\note Only static shapes are cached. Dynamic shapes are always queried as usual.
+\note Raycasts do not use the candidate cache.
+\note If the candidate buffer is too small for a query volume, the query falls back to a regular traversal.
+\note Sweeps cache the bounds of the whole swept volume, so the cache is best suited to short sweeps.
+\note Candidates are tested in a different order than in a regular traversal, so blocking hits at equal distances (e.g. initial overlaps) may resolve to a different shape.
+\note A candidate cache must not be used by multiple threads at the same time.
+\note With custom scene query systems (see PxCreateCustomSceneQuerySystem()) the cached shapes are those of the pruners that contain no
+dynamic objects and that pass PxCustomSceneQuerySystemAdapter::processPruner(). Only the first 32 pruners can be cached, and the candidates
+are captured again whenever one of the cached pruners is modified.
+
+@see PxQueryCache PxQueryCandidate
+*/
+struct PxQueryCandidateCache
+{
+	/**
+	\brief constructor to set properties
+
+	\param[in] buffer			User-provided buffer for the candidates. Must remain valid while the cache is in use.
+	\param[in] maxCandidates	Number of candidates the buffer can hold
+	\param[in] tol				Distance by which the query volume is enlarged when candidates are captured
+	*/
+	PX_INLINE PxQueryCandidateCache(PxQueryCandidate* buffer, PxU32 maxCandidates, PxReal tol=0.1f) :
+		candidates		(buffer),
+		maxNbCandidates	(maxCandidates),
+		tolerance		(tol),
+		nbHits			(0),
+		nbMisses		(0),
+		owner			(NULL),
+		timestamp		(0),
+		nbCandidates	(0),
+		prunerMask		(0)
+	{
+		cachedBounds.setEmpty();
+	}
+
+	/**
+	\brief forces the next query to capture new candidates
+	*/
+	PX_INLINE void		invalidate()				{ owner = NULL;	nbCandidates = 0;	}
+
+	/**
+	\brief resets the hit-rate counters
+	*/
+	PX_INLINE void		resetCounters()				{ nbHits = 0;	nbMisses = 0;		}
+
+	/**
+	\brief returns the ratio of queries that reused cached candidates, between 0 and 1
+	*/
+	PX_INLINE PxReal	getHitRate()		const
+	{
+		const PxU32 nbQueries = nbHits + nbMisses;
+		return nbQueries ? PxReal(nbHits)/PxReal(nbQueries) : 0.0f;
+	}
+
+	PxQueryCandidate*	candidates;			//!< User-provided candidate buffer
+	PxU32				maxNbCandidates;	//!< Size of the candidate buffer
+	PxReal				tolerance;			//!< Distance by which the query volume is enlarged when candidates are captured
+	PxU32				nbHits;				//!< Number of queries that reused the cached candidates
+	PxU32				nbMisses;			//!< Number of queries that had to capture new candidates or could not use the cache
+
+	// Internal state
+	PxBounds3			cachedBounds;		//!< Volume covered by the cached candidates
+	const void*			owner;				//!< Scene query system that captured the candidates
+	PxU32				timestamp;			//!< Static timestamp at capture time
+	PxU32				nbCandidates;		//!< Number of cached candidates, 0xffffffff if the last capture overflowed the buffer
+	PxU32				prunerMask;			//!< Pruners covered by the cached candidates (custom scene query systems only)
+};
+
 /**
 \brief single hit cache for scene queries.
 
@@ -258,23 +348,32 @@ when deleting shapes to invalidate cached references.
 
 The faceIndex field is an additional hint for a mesh or height field which is not currently used.
 
-@see PxScene.raycast
+The candidates field is an optional candidate cache for overlap and sweep queries, used independently from the
+cached actor/shape pair. Shape and actor can be left NULL when only the candidate cache is needed.
+
+@see PxScene.raycast PxQueryCandidateCache
 */
 struct PxQueryCache
 {
 	/**
 	\brief constructor sets to default 
 	*/
-	PX_INLINE PxQueryCache() : shape(NULL), actor(NULL), faceIndex(0xffffffff) {}
+	PX_INLINE PxQueryCache() : shape(NULL), actor(NULL), faceIndex(0xffffffff), candidates(NULL) {}
 
 	/**
 	\brief constructor to set properties
 	*/
-	PX_INLINE PxQueryCache(PxShape* s, PxU32 findex) : shape(s), actor(NULL), faceIndex(findex) {}
+	PX_INLINE PxQueryCache(PxShape* s, PxU32 findex) : shape(s), actor(NULL), faceIndex(findex), candidates(NULL) {}
+
+	/**
+	\brief constructor for candidate caches
+	*/
+	PX_INLINE PxQueryCache(PxQueryCandidateCache* c) : shape(NULL), actor(NULL), faceIndex(0xffffffff), candidates(c) {}
 
-	PxShape*		shape;		//!< Shape to test for intersection first
-	PxRigidActor*	actor;		//!< Actor to which the shape belongs
-	PxU32			faceIndex;	//!< Triangle index to test first - NOT CURRENTLY SUPPORTED
+	PxShape*				shape;		//!< Shape to test for intersection first
+	PxRigidActor*			actor;		//!< Actor to which the shape belongs
+	PxU32					faceIndex;	//!< Triangle index to test first - NOT CURRENTLY SUPPORTED
+	PxQueryCandidateCache*	candidates;	//!< Optional candidate cache for overlap and sweep queries
 };
 
 #if !PX_DOXYGEN
@@ -850,6 +850,35 @@ public:
 	*/
 	PxU32	contactPairSlabSize;	
 
+	/**
+	\brief Defines the size of the chunks of the task pool, in bytes.
+
+	Tasks and other data living for one simulation step are allocated from the task pool, which is reset when
+	fetchResults() completes. Each thread bumps through the chunk it took last, and takes a new chunk from the pool
+	when the current one is full. Allocations larger than a chunk get their own block, released at the end of the
+	step. Larger chunks mean fewer chunk changes, but more unused memory at the end of each thread's last chunk.
+
+	<b>Range:</b> [1024, PX_MAX_U32)<br>
+	<b>Default:</b> 16384
+
+	@see taskPoolSize PxSimulationStatistics::taskPoolPeakBytes
+	*/
+	PxU32	taskPoolChunkSize;
+
+	/**
+	\brief Defines the amount of memory reserved for the task pool, in bytes.
+
+	The chunks needed to hold this amount are allocated when the scene is created and are kept for its lifetime. Beyond
+	it, the pool keeps the chunks used during the last step plus a couple of spare ones. Setting it to
+	PxSimulationStatistics::taskPoolPeakBytes of a representative run avoids allocating chunks during the simulation.
+
+	<b>Range:</b> [0, PX_MAX_U32)<br>
+	<b>Default:</b> 0
+
+	@see taskPoolChunkSize PxSimulationStatistics::taskPoolPeakBytes
+	*/
+	PxU32	taskPoolSize;
+
 	/**
 	\brief The scene query sub-system for the scene.
 
@@ -954,6 +983,8 @@ PX_INLINE PxSceneDesc::PxSceneDesc(const PxTolerancesScale& scale):
 	gpuMaxNumStaticPartitions		(16),
 	gpuComputeVersion				(0),
 	contactPairSlabSize				(256),
+	taskPoolChunkSize				(16384),
+	taskPoolSize					(0),
 	sceneQuerySystem				(NULL),
 	tolerancesScale					(scale)
 {
@@ -1031,6 +1062,9 @@ PX_INLINE bool PxSceneDesc::isValid() const
 	if(contactPairSlabSize == 0)
 		return false;
 
+	if(taskPoolChunkSize < 1024)
+		return false;
+
 	return true;
 }
 
@@ -232,6 +232,32 @@ public:
 	*/
 	PxBVHBuildStrategy::Enum	dynamicBVHBuildStrategy;
 
+	/**
+	\brief Node width for PxSceneQueryDesc::staticStructure.
+
+	This parameter selects the node width of the tree used by PxSceneQueryDesc::staticStructure for queries. This is only
+	used with PxPruningStructureType::eDYNAMIC_AABB_TREE and PxPruningStructureType::eSTATIC_AABB_TREE.
+
+	<b>Default:</b> PxBVHNodeWidth::eBINARY
+
+	@see PxBVHNodeWidth PxSceneQueryDesc::staticStructure
+	*/
+	PxBVHNodeWidth::Enum		staticBVHNodeWidth;
+
+	/**
+	\brief Node width for PxSceneQueryDesc::dynamicStructure.
+
+	This parameter selects the node width of the tree used by PxSceneQueryDesc::dynamicStructure for queries. This is only
+	used with PxPruningStructureType::eDYNAMIC_AABB_TREE and PxPruningStructureType::eSTATIC_AABB_TREE.
+
+	Wide trees are refit each time the pruner is committed, so they are best suited for structures with few updates.
+
+	<b>Default:</b> PxBVHNodeWidth::eBINARY
+
+	@see PxBVHNodeWidth PxSceneQueryDesc::dynamicStructure
+	*/
+	PxBVHNodeWidth::Enum		dynamicBVHNodeWidth;
+
 	/**
 	\brief Number of objects per node for PxSceneQueryDesc::staticStructure.
 
@@ -298,6 +324,8 @@ PX_INLINE PxSceneQueryDesc::PxSceneQueryDesc():
 	dynamicTreeSecondaryPruner	(PxDynamicTreeSecondaryPruner::eINCREMENTAL),
 	staticBVHBuildStrategy		(PxBVHBuildStrategy::eFAST),
 	dynamicBVHBuildStrategy		(PxBVHBuildStrategy::eFAST),
+	staticBVHNodeWidth			(PxBVHNodeWidth::eBINARY),
+	dynamicBVHNodeWidth			(PxBVHNodeWidth::eBINARY),
 	staticNbObjectsPerNode		(4),
 	dynamicNbObjectsPerNode		(4),
 	sceneQueryUpdateMode		(PxSceneQueryUpdateMode::eBUILD_ENABLED_COMMIT_ENABLED)
@@ -317,6 +345,12 @@ PX_INLINE bool PxSceneQueryDesc::isValid() const
 	if(dynamicTreeRebuildRateHint < 4)
 		return false;
 
+	if(staticBVHNodeWidth!=PxBVHNodeWidth::eBINARY && staticBVHNodeWidth!=PxBVHNodeWidth::eWIDE_4 && staticBVHNodeWidth!=PxBVHNodeWidth::eWIDE_8)
+		return false;
+
+	if(dynamicBVHNodeWidth!=PxBVHNodeWidth::eBINARY && dynamicBVHNodeWidth!=PxBVHNodeWidth::eWIDE_4 && dynamicBVHNodeWidth!=PxBVHNodeWidth::eWIDE_8)
+		return false;
+
 	return true;
 }
 
@@ -34,6 +34,7 @@
 #include "foundation/PxSimpleTypes.h"
 #include "foundation/PxBitMap.h"
 #include "foundation/PxTransform.h"
+#include "foundation/PxFoundation.h"
 #include "PxSceneQueryDesc.h"
 #include "PxQueryReport.h"
 #include "PxQueryFiltering.h"
@@ -47,6 +48,7 @@ namespace physx
 	class PxBaseTask;
 	class PxRenderOutput;
 	class PxGeometry;
+	class PxPlane;
 	class PxRigidActor;
 	class PxShape;
 	class PxBVH;
@@ -242,6 +244,47 @@ namespace physx
 		virtual bool	overlap(const PxGeometry& geometry, const PxTransform& pose, PxOverlapCallback& hitCall,
 								const PxQueryFilterData& filterData = PxQueryFilterData(), PxQueryFilterCallback* filterCall = NULL,
 								const PxQueryCache* cache = NULL, PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT) const = 0;
+
+		/**
+		\brief Performs a frustum / convex-volume culling test against objects in the scene, returns results in a PxOverlapBuffer object
+		or via a custom user callback implementation inheriting from PxOverlapCallback.
+
+		The volume is defined by a set of planes. Points P for which plane.distance(P)>0 are outside the volume. The pruners'
+		trees are traversed with SIMD plane-vs-AABB tests, and subtrees fully inside the volume are reported without further tests.
+
+		This is similar in spirit to an overlap query using a convex object around the volume, but it only tests the objects'
+		bounds: no narrow-phase test is performed. Some reported objects may thus be outside the volume, close to its edges.
+		This is usually an ok trade-off for view-frustum culling or portal-based visibility.
+
+		\note Filtering: pre-filters and post-filters are supported. Returning eBLOCK from user filters is treated as for overlap().
+
+		\param[in] nbPlanes		Number of planes. Only 32 planes max are supported.
+		\param[in] planes		Array of planes, in world space.
+		\param[out] hitCall		Overlap hit buffer or callback object used to report visible objects. Face indices are set to 0xffffffff.
+		\param[in] filterData	Filtering data and simple logic. See #PxQueryFilterData #PxQueryFilterCallback
+		\param[in] filterCall	Custom filtering logic (optional). Only used if the corresponding #PxQueryFlag flags are set.
+		\param[in] queryFlags	Optional flags controlling the query.
+
+		\return True if any touching or blocking hits were found or any hit was found in case PxQueryFlag::eANY_HIT was specified.
+
+		\note The default implementation reports an eINVALID_OPERATION error and returns false, so that existing user-implemented
+		scene query systems do not need to support culling.
+
+		@see PxOverlapCallback PxOverlapBuffer PxQueryFilterData PxQueryFilterCallback PxGeometryQueryFlag PxBVH::cull
+		*/
+		virtual bool	cull(PxU32 nbPlanes, const PxPlane* planes, PxOverlapCallback& hitCall,
+							const PxQueryFilterData& filterData = PxQueryFilterData(), PxQueryFilterCallback* filterCall = NULL,
+							PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT) const
+		{
+			PX_UNUSED(nbPlanes);
+			PX_UNUSED(planes);
+			PX_UNUSED(hitCall);
+			PX_UNUSED(filterData);
+			PX_UNUSED(filterCall);
+			PX_UNUSED(queryFlags);
+			PxGetFoundation().error(PxErrorCode::eINVALID_OPERATION, __FILE__, __LINE__, "PxSceneQuerySystemBase::cull: not supported by this scene query system.");
+			return false;
+		}
 		//@}
 	};
 
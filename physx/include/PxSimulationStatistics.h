@@ -86,6 +86,51 @@ public:
 		eTRIGGER_PAIRS
 	};
 
+	/**
+	\brief Phases of a simulation step for which timings are recorded.
+
+	\note Phases overlap: for example the island generation starts while the narrow phase is still running. The wall times of
+	the phases can thus add up to more than the wall time of the whole step.
+
+	@see phaseWallTime phaseCpuTime phaseNbTasks
+	*/
+	enum PhaseType
+	{
+		eBROAD_PHASE,			//!< Broad phase, including the processing of the new and lost pairs it found
+		eNARROW_PHASE,			//!< Contact generation
+		eISLAND_GEN,			//!< Island generation, touch events and sleeping
+		eSOLVER_SETUP,			//!< Force integration and creation of the solver constraints
+		eSOLVER,				//!< Constraint solver iterations
+		eINTEGRATION,			//!< Position integration and post-solver updates of bodies and shapes
+		eCCD,					//!< Continuous collision detection passes
+		eSCENE_QUERY_UPDATE,	//!< Update of the scene query structures with the new poses, in PxScene::fetchResults()
+		eFETCH_RESULTS,			//!< Remainder of PxScene::fetchResults(): user callbacks, active actors, etc
+
+		ePHASE_COUNT
+	};
+
+	/**
+	\brief Maximum number of threads for which worker statistics are recorded.
+
+	@see nbWorkers
+	*/
+	enum { eMAX_NB_WORKERS = 64 };
+
+	/**
+	\brief Users of the scratch memory block passed to PxScene::simulate().
+
+	@see scratchPeakBytes
+	*/
+	enum ScratchUsageType
+	{
+		eSCRATCH_BROAD_PHASE,				//!< Temporary pair and handle buffers of the broad phase
+		eSCRATCH_NARROW_PHASE,				//!< Trigger pair processing
+		eSCRATCH_SOLVER,					//!< Solver constraint blocks, in 16K blocks
+		eSCRATCH_CONSTRAINT_PROJECTION,		//!< Constraint projection trees
+		eSCRATCH_OTHER,						//!< Anything else
+
+		eSCRATCH_USAGE_COUNT
+	};
 
 //objects:
 	/**
@@ -372,6 +417,112 @@ public:
 	*/
 	PxU64	gpuMemHeapOther;
 
+//timings:
+	/**
+	\brief Wall clock time in milliseconds from the start of the simulation step to the end of PxScene::fetchResults().
+
+	\note The timings are recorded without a profiler. They are only available once PxScene::fetchResults() has returned.
+	*/
+	PxReal	simulationWallTime;
+
+	/**
+	\brief Wall clock time in milliseconds between the first and the last task of each phase of the simulation step.
+
+	@see PhaseType
+	*/
+	PxReal	phaseWallTime[ePHASE_COUNT];
+
+	/**
+	\brief Time in milliseconds spent by all threads in the tasks of each phase of the simulation step.
+
+	\note This is the sum of the execution times of the tasks, on all threads. With several worker threads it can be larger
+	than the wall time of the phase.
+
+	@see PhaseType
+	*/
+	PxReal	phaseCpuTime[ePHASE_COUNT];
+
+	/**
+	\brief Number of tasks executed in each phase of the simulation step.
+
+	\note A task which runs code of another phase inline is counted in both phases.
+
+	@see PhaseType
+	*/
+	PxU32	phaseNbTasks[ePHASE_COUNT];
+
+	/**
+	\brief Number of threads which executed simulation tasks of this scene so far, including the application thread.
+
+	Worker i of the following arrays always refers to the same thread from one simulation step to the next. Threads beyond
+	eMAX_NB_WORKERS are not reported.
+	*/
+	PxU32	nbWorkers;
+
+	/**
+	\brief Number of tasks executed by each worker during the simulation step.
+	*/
+	PxU32	workerNbTasks[eMAX_NB_WORKERS];
+
+	/**
+	\brief Time in milliseconds spent by each worker in the tasks of the simulation step.
+	*/
+	PxReal	workerBusyTime[eMAX_NB_WORKERS];
+
+	/**
+	\brief Time in milliseconds during which each worker did not run tasks of the simulation step, i.e. simulationWallTime minus workerBusyTime.
+	*/
+	PxReal	workerIdleTime[eMAX_NB_WORKERS];
+
+//step memory:
+	/**
+	\brief Peak amount of scratch memory in bytes requested by each user during the simulation step.
+
+	The requests are counted whether they were served from the scratch block passed to PxScene::simulate() or from the heap,
+	because the block was missing or too small.
+
+	@see ScratchUsageType scratchPeakTotalBytes
+	*/
+	PxU32	scratchPeakBytes[eSCRATCH_USAGE_COUNT];
+
+	/**
+	\brief Peak amount of scratch memory in bytes in use at any time during the simulation step, all users combined.
+
+	A scratch block of at least this size, rounded up to a multiple of 16K, lets the simulation step run without scratch
+	allocations from the heap.
+
+	\note This is less than the sum of scratchPeakBytes, since the users do not all reach their peak at the same time.
+
+	@see PxScene::simulate() scratchHeapFallbackBytes
+	*/
+	PxU32	scratchPeakTotalBytes;
+
+	/**
+	\brief Scratch memory in bytes which was allocated from the heap during the simulation step because it did not fit in the
+	scratch block.
+
+	\note This does not include the solver constraint blocks, which come from a pool of 16K blocks when the scratch block
+	is exhausted.
+	*/
+	PxU32	scratchHeapFallbackBytes;
+
+	/**
+	\brief Memory in bytes used by the task pool of the scene during the simulation step.
+
+	The task pool holds the tasks and other data which live until the end of PxScene::fetchResults(). Its memory is kept
+	from one step to the next.
+
+	@see taskPoolPeakBytes
+	*/
+	PxU64	taskPoolBytes;
+
+	/**
+	\brief Largest value of taskPoolBytes over all simulation steps so far.
+
+	@see PxSceneDesc::taskPoolSize
+	*/
+	PxU64	taskPoolPeakBytes;
+
 	PxSimulationStatistics() :
 		nbActiveConstraints					(0),
 		nbActiveDynamicBodies				(0),
@@ -412,7 +563,13 @@ public:
 		gpuMemHeapSoftBodies				(0),
 		gpuMemHeapFEMCloths                 (0), 
 		gpuMemHeapHairSystems				(0),
-		gpuMemHeapOther						(0)
+		gpuMemHeapOther						(0),
+		simulationWallTime					(0.0f),
+		nbWorkers							(0),
+		scratchPeakTotalBytes				(0),
+		scratchHeapFallbackBytes			(0),
+		taskPoolBytes						(0),
+		taskPoolPeakBytes					(0)
 	{
 		nbBroadPhaseAdds = 0;
 		nbBroadPhaseRemoves = 0;
@@ -432,6 +589,25 @@ public:
 		{
 			nbShapes[i] = 0;
 		}
+
+		for(PxU32 i=0; i < ePHASE_COUNT; i++)
+		{
+			phaseWallTime[i] = 0.0f;
+			phaseCpuTime[i] = 0.0f;
+			phaseNbTasks[i] = 0;
+		}
+
+		for(PxU32 i=0; i < eMAX_NB_WORKERS; i++)
+		{
+			workerNbTasks[i] = 0;
+			workerBusyTime[i] = 0.0f;
+			workerIdleTime[i] = 0.0f;
+		}
+
+		for(PxU32 i=0; i < eSCRATCH_USAGE_COUNT; i++)
+		{
+			scratchPeakBytes[i] = 0;
+		}
 	}
 
 
@@ -42,6 +42,8 @@ namespace physx
 {
 #endif
 
+class PxCpuDispatcher;
+
 /**
 \brief Descriptor class for #PxBVH.
 
@@ -88,6 +90,24 @@ public:
 	*/
 	PxBVHBuildStrategy::Enum	buildStrategy;
 
+	/**
+	\brief Desired node width for the BVH queries
+
+	<b>Default value:</b> eBINARY
+	*/
+	PxBVHNodeWidth::Enum		nodeWidth;
+
+	/**
+	\brief Optional CPU dispatcher used to build the BVH on multiple threads
+
+	The build call still blocks until the BVH is complete. The dispatcher is only used during the build and is not stored in the BVH.
+
+	<b>Default value:</b> NULL (the BVH is built on the calling thread)
+
+	@see PxCpuDispatcher
+	*/
+	PxCpuDispatcher*			dispatcher;
+
 	/**
 	\brief	Initialize the BVH descriptor
 	*/
@@ -102,7 +122,7 @@ public:
 protected:	
 };
 
-PX_INLINE PxBVHDesc::PxBVHDesc() : enlargement(0.01f), numPrimsPerLeaf(4), buildStrategy(PxBVHBuildStrategy::eDEFAULT)
+PX_INLINE PxBVHDesc::PxBVHDesc() : enlargement(0.01f), numPrimsPerLeaf(4), buildStrategy(PxBVHBuildStrategy::eDEFAULT), nodeWidth(PxBVHNodeWidth::eBINARY), dispatcher(NULL)
 {
 }
 
@@ -128,6 +148,9 @@ PX_INLINE bool PxBVHDesc::isValid() const
 	if(numPrimsPerLeaf>=16)
 		return false;
 
+	if(nodeWidth!=PxBVHNodeWidth::eBINARY && nodeWidth!=PxBVHNodeWidth::eWIDE_4 && nodeWidth!=PxBVHNodeWidth::eWIDE_8)
+		return false;
+
 	return true;
 }
 
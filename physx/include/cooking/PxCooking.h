@@ -53,6 +53,7 @@ class PxInsertionCallback;
 class PxFoundation;
 class PxAllocatorCallback;
 class PxHeightFieldDesc;
+class PxCpuDispatcher;
 
 /**
 \brief Result from convex cooking.
@@ -297,7 +298,8 @@ struct PxCookingParams
 	/**
 	\brief Vertex limit beyond which additional acceleration structures are computed for each convex mesh. Increase that limit to reduce memory usage.
 	Computing the extra structures all the time does not guarantee optimal performance. There is a per-platform break-even point below which the
-	extra structures actually hurt performance.
+	extra structures actually hurt performance. Below the limit, support mapping uses a SIMD search over all vertices. SnippetConvexSupport can
+	be used to find the break-even point for a given set of hulls.
 
 	<b>Default value:</b> 32
 	*/
@@ -312,6 +314,22 @@ struct PxCookingParams
 	*/
 	PxReal maxWeightRatioInTet;
 
+	/**
+	\brief Optional CPU dispatcher used to cook triangle meshes on multiple threads.
+
+	When set, vertex welding, active edges and adjacency computation, and the BVH34 midphase build use the dispatcher's worker threads.
+	Cooking calls still block until the mesh is complete, and the cooked data is identical to the data produced without a dispatcher.
+	The dispatcher is only used during the cooking call and is not stored in the cooked mesh.
+
+	The batch functions PxCookConvexMeshes() and PxCookTriangleMeshes() use the dispatcher to cook several meshes
+	concurrently instead, each of them on a single thread.
+
+	<b>Default value:</b> NULL (meshes are cooked on the calling thread)
+
+	@see PxCpuDispatcher PxCookConvexMeshes PxCookTriangleMeshes
+	*/
+	PxCpuDispatcher* dispatcher;
+
 	PxCookingParams(const PxTolerancesScale& sc):
 		areaTestEpsilon					(0.06f*sc.length*sc.length),
 		planeTolerance					(0.0007f),
@@ -323,7 +341,8 @@ struct PxCookingParams
 		meshPreprocessParams			(0),
 		meshWeldTolerance				(0.f),
 		gaussMapLimit					(32),
-		maxWeightRatioInTet             (FLT_MAX)
+		maxWeightRatioInTet             (FLT_MAX),
+		dispatcher						(NULL)
 	{
 	}
 };
@@ -925,6 +944,24 @@ PX_FORCE_INLINE	physx::PxConvexMesh* PxCreateConvexMesh(const physx::PxCookingPa
 	return PxCreateConvexMesh(params, desc, *PxGetStandaloneInsertionCallback());
 }
 
+/**
+\brief Cooks a batch of convex meshes, e.g. the parts of a convex decomposition.
+
+This is equivalent to calling PxCookConvexMesh() for each descriptor, but temporary cooking buffers are recycled from
+one mesh to the next, and meshes are cooked concurrently on the worker threads of PxCookingParams::dispatcher if set.
+The cooked data is identical to the one produced by PxCookConvexMesh().
+
+\param[in] params		The cooking parameters
+\param[in] nbMeshes	The number of meshes to cook
+\param[in] descs		The convex mesh descriptors, one per mesh
+\param[in] streams		The output streams, one per mesh. Streams can be written concurrently and must all be different.
+\param[out] conditions	Optional array receiving the cooking result of each mesh
+\return true if all meshes were cooked successfully
+
+@see PxCookConvexMesh PxCookingParams::dispatcher
+*/
+PX_C_EXPORT PX_PHYSX_COOKING_API	bool PxCookConvexMeshes(const physx::PxCookingParams& params, physx::PxU32 nbMeshes, const physx::PxConvexMeshDesc* descs, physx::PxOutputStream* const* streams, physx::PxConvexMeshCookingResult::Enum* conditions=NULL);
+
 PX_C_EXPORT PX_PHYSX_COOKING_API	bool PxValidateConvexMesh(const physx::PxCookingParams& params, const physx::PxConvexMeshDesc& desc);
 PX_C_EXPORT PX_PHYSX_COOKING_API	bool PxComputeHullPolygons(const physx::PxCookingParams& params, const physx::PxSimpleTriangleMesh& mesh, physx::PxAllocatorCallback& inCallback, physx::PxU32& nbVerts, physx::PxVec3*& vertices,
 														physx::PxU32& nbIndices, physx::PxU32*& indices, physx::PxU32& nbPolygons, physx::PxHullPolygon*& hullPolygons);
@@ -939,6 +976,44 @@ PX_FORCE_INLINE	physx::PxTriangleMesh*	PxCreateTriangleMesh(const physx::PxCooki
 	return PxCreateTriangleMesh(params, desc, *PxGetStandaloneInsertionCallback());
 }
 
+/**
+\brief Cooks a batch of triangle meshes, e.g. the tiles of a large level.
+
+This is equivalent to calling PxCookTriangleMesh() for each descriptor, but temporary cooking buffers are recycled from
+one mesh to the next, and meshes are cooked concurrently on the worker threads of PxCookingParams::dispatcher if set.
+The cooked data is identical to the one produced by PxCookTriangleMesh().
+
+\param[in] params		The cooking parameters
+\param[in] nbMeshes	The number of meshes to cook
+\param[in] descs		The triangle mesh descriptors, one per mesh
+\param[in] streams		The output streams, one per mesh. Streams can be written concurrently and must all be different.
+\param[out] conditions	Optional array receiving the cooking result of each mesh
+\return true if all meshes were cooked successfully
+
+@see PxCookTriangleMesh PxCookingParams::dispatcher
+*/
+PX_C_EXPORT PX_PHYSX_COOKING_API	bool PxCookTriangleMeshes(const physx::PxCookingParams& params, physx::PxU32 nbMeshes, const physx::PxTriangleMeshDesc* descs, physx::PxOutputStream* const* streams, physx::PxTriangleMeshCookingResult::Enum* conditions=NULL);
+
+/**
+\brief Cooks a triangle mesh into an in-place image, for zero-copy loading with PxPhysics::createTriangleMeshInPlace().
+
+The image is a direct copy of the runtime mesh data, with each array aligned to 16 bytes. When the image is loaded at a
+16-byte aligned address (e.g. from a memory-mapped file), the runtime mesh references it directly instead of decoding
+and copying it. The image is larger than the regular cooked format and is only valid for platforms with the same endianness.
+
+Only BVH34 meshes are supported (PxCookingParams::midphaseDesc must be PxMeshMidPhase::eBVH34). GPU data
+(PxCookingParams::buildGPUData) and SDFs (PxTriangleMeshDesc::sdfDesc) are not supported.
+
+\param[in] params		The cooking parameters
+\param[in] desc		The triangle mesh descriptor to read the mesh from.
+\param[in] stream		User stream to output the in-place image.
+\param[out] condition	Result from triangle mesh cooking.
+\return true on success
+
+@see PxPhysics::createTriangleMeshInPlace PxCookTriangleMesh
+*/
+PX_C_EXPORT PX_PHYSX_COOKING_API	bool PxCookTriangleMeshInPlace(const physx::PxCookingParams& params, const physx::PxTriangleMeshDesc& desc, physx::PxOutputStream& stream, physx::PxTriangleMeshCookingResult::Enum* condition=NULL);
+
 // Tetrahedron & soft body meshes
 PX_C_EXPORT PX_PHYSX_COOKING_API	bool PxCookTetrahedronMesh(const physx::PxCookingParams& params, const physx::PxTetrahedronMeshDesc& meshDesc, physx::PxOutputStream& stream);
 PX_C_EXPORT PX_PHYSX_COOKING_API	physx::PxTetrahedronMesh* PxCreateTetrahedronMesh(const physx::PxCookingParams& params, const physx::PxTetrahedronMeshDesc& meshDesc, physx::PxInsertionCallback& insertionCallback);
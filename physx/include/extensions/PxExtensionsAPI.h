@@ -52,6 +52,7 @@
 #include "extensions/PxShapeExt.h"
 #include "extensions/PxTriangleMeshExt.h"
 #include "extensions/PxSerialization.h"
+#include "extensions/PxStreamingCollectionLoader.h"
 #include "extensions/PxDefaultCpuDispatcher.h"
 #include "extensions/PxSmoothNormals.h"
 #include "extensions/PxSimpleFactory.h"
@@ -59,11 +60,13 @@
 #include "extensions/PxBroadPhaseExt.h"
 #include "extensions/PxMassProperties.h"
 #include "extensions/PxSceneQueryExt.h"
+#include "extensions/PxSceneSnapshot.h"
 #include "extensions/PxSceneQuerySystemExt.h"
 #include "extensions/PxCustomSceneQuerySystem.h"
 #include "extensions/PxConvexMeshExt.h"
 #include "extensions/PxSamplingExt.h"
 #include "extensions/PxTetrahedronMeshExt.h"
+#include "extensions/PxTiledHeightField.h"
 
 /** \brief Initialize the PhysXExtensions library. 
 
@@ -0,0 +1,143 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef PX_SCENE_SNAPSHOT_H
+#define PX_SCENE_SNAPSHOT_H
+/** \addtogroup extensions
+  @{
+*/
+
+#include "PxPhysXConfig.h"
+#include "foundation/PxSimpleTypes.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+class PxScene;
+
+/**
+\brief Captures and restores the API-visible dynamic state of a scene's rigid dynamics and articulations.
+
+The context keeps a copy of the state written by the last capture() or applied by the last restore(), called the baseline.
+A delta snapshot only contains the actors whose state differs from the baseline, and only the parts of their state that changed.
+A full snapshot contains the complete state of all actors. The captured state of an actor is:
+
+- rigid dynamics: global pose, linear and angular velocities, wake counter and sleep state. Only the pose of kinematic actors and
+of actors with PxActorFlag::eDISABLE_SIMULATION is captured.
+- articulations: root global pose, root velocities, joint positions and velocities, wake counter and sleep state.
+
+A delta snapshot can only be restored on top of the state it was captured against, i.e. right after the capture() or restore() call
+that produced the baseline it refers to. To go back several frames, restore a full snapshot and then all delta snapshots captured after
+it, in order. restore() fails with an error otherwise.
+
+Snapshots capture state, not structure. Actors added to the scene after a snapshot was captured keep their state when the snapshot is
+restored, and the state of actors that have since been removed from the scene is skipped.
+
+Snapshots only contain the state listed above. They do not contain the state of the low-level pipeline that is not exposed through
+the API, i.e. persistent contact and friction caches used for warm-starting, broadphase pairs, island graph and the velocity
+accumulators that decide when actors fall asleep. Restoring a snapshot is therefore not an exact rollback of the simulation: the
+actors get their captured state back, but the following simulation steps start from the low-level state of the current frame, and
+a resimulation can diverge from the original run, e.g. for actors in contact.
+
+The snapshot data uses the native endianness and is meant for the platform that captured it.
+
+\note The scene must not be simulating during capture() and restore().
+
+@see PxCreateSceneSnapshotContext
+*/
+class PxSceneSnapshotContext
+{
+public:
+	/**
+	\brief Releases the context.
+	*/
+	virtual	void		release()	= 0;
+
+	/**
+	\brief Writes a snapshot of the scene into a caller-owned buffer and makes it the new baseline.
+
+	The buffer must be 4-byte aligned. Nothing is written, and the baseline is left unchanged, if the buffer is too small.
+
+	\param[out] buffer			The buffer receiving the snapshot
+	\param[in] bufferSize		Size of the buffer in bytes
+	\param[in] fullSnapshot		True to write the complete state of all actors, false to only write changes since the baseline
+
+	\return	The size of the snapshot in bytes, or 0 if the buffer is too small
+
+	@see getMaxSnapshotSize
+	*/
+	virtual	PxU32		capture(void* buffer, PxU32 bufferSize, bool fullSnapshot = false)	= 0;
+
+	/**
+	\brief Applies a snapshot to the scene and makes the resulting state the new baseline.
+
+	Actors are restored without waking up others, i.e. the sleep state of each actor is the captured one.
+	Only the captured state is restored, see the class description for what is not part of a snapshot.
+
+	\param[in] buffer	A snapshot written by capture() on this context
+	\param[in] size		Size of the snapshot in bytes, as returned by capture()
+
+	\return	True on success. False if the snapshot is invalid, or if it is a delta snapshot that does not apply to the current baseline.
+	*/
+	virtual	bool		restore(const void* buffer, PxU32 size)	= 0;
+
+	/**
+	\brief Returns the size of a full snapshot of the actors currently in the scene.
+
+	This is an upper bound for the size of the next snapshot, full or delta.
+	*/
+	virtual	PxU32		getMaxSnapshotSize()	const	= 0;
+
+	/**
+	\brief Returns the scene whose state is captured.
+	*/
+	virtual	PxScene&	getScene()	const	= 0;
+
+protected:
+	virtual				~PxSceneSnapshotContext()	{}
+};
+
+/**
+\brief Creates a snapshot context for a scene. The baseline is empty initially, i.e. the first snapshot contains all actors.
+
+\param[in] scene	The scene whose state is captured and restored
+
+\return	The new context
+
+@see PxSceneSnapshotContext
+*/
+PxSceneSnapshotContext*	PxCreateSceneSnapshotContext(PxScene& scene);
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+/** @} */
+#endif
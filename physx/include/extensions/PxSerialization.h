@@ -44,7 +44,7 @@
 PX_BINARY_SERIAL_VERSION is used to version the PhysX binary data and meta data. The global unique identifier of the PhysX SDK needs to match 
 the one in the data and meta data, otherwise they are considered incompatible. A 32 character wide GUID can be generated with https://www.guidgenerator.com/ for example. 
 */
-#define PX_BINARY_SERIAL_VERSION "4ACDCFBFCFC047699FFC47263E9670C0"
+#define PX_BINARY_SERIAL_VERSION "96B857E4BA5F420F9340D7F239BD6E11"
 
 
 #if !PX_DOXYGEN
@@ -53,6 +53,10 @@ namespace physx
 #endif
 
 	class PxBinaryConverter;
+	class PxCpuDispatcher;
+	class PxScene;
+	class PxStreamingCollectionLoader;
+	class PxStreamingCollectionLoaderDesc;
 
 /**
 \brief Utility functions for serialization
@@ -178,13 +182,39 @@ public:
 	which is defined by "PX_PHYSICS_VERSION_MAJOR.PX_PHYSICS_VERSION_MINOR.PX_PHYSICS_VERSION_BUGFIX-PX_BINARY_SERIAL_VERSION".
 	For a list of compatible sdk releases refer to the documentation of PX_BINARY_SERIAL_VERSION.
 
+	If a CPU dispatcher is provided, objects are created, have their references resolved and import their extra data on the dispatcher's
+	worker threads. Objects that depend on each other (for example a shape and its material) are still created one after the other.
+	The objects are then registered with the physics SDK on the calling thread. The call blocks until the collection is complete, and
+	the resulting collection is the same as without a dispatcher. Data that went through PxBinaryConverter is always deserialized on
+	the calling thread.
+
 	\param[in] memBlock Pointer to memory block containing the serialized collection
 	\param[in] sr PxSerializationRegistry instance with information about registered classes.
 	\param[in] externalRefs Collection to resolve external dependencies
+	\param[in] dispatcher Optional CPU dispatcher used to deserialize objects on multiple threads. Custom serializers must support concurrent
+	PxSerializer::createObject calls for objects that do not require each other.
+
+	@see PxCollection, PxSerialization::complete, PxSerialization::serializeCollectionToBinary, PxSerializationRegistry, PX_BINARY_SERIAL_VERSION, PxCpuDispatcher
+	*/
+	static	PxCollection*	createCollectionFromBinary(void* memBlock, PxSerializationRegistry& sr, const PxCollection* externalRefs = NULL, PxCpuDispatcher* dispatcher = NULL);
+
+	/**
+	\brief Creates a loader that deserializes a binary collection and adds it to a scene over several frames.
+
+	The binary data is read from the input stream as the loader makes progress, see PxStreamingCollectionLoader::update(). Loading
+	starts with the first update() call. The input data and the externalRefs collection need to remain valid until the loader leaves
+	the PxStreamingCollectionLoaderState::eDESERIALIZING state, and the scene as long as the loader exists.
+
+	\param[in] data Input data containing the serialized collection, as written by PxSerialization::serializeCollectionToBinary
+	\param[in] sr PxSerializationRegistry instance with information about registered classes.
+	\param[in] scene Scene receiving the actors, aggregates, articulations and pruning structures of the collection
+	\param[in] desc Limits of the work done per update
+	\param[in] externalRefs Collection to resolve external dependencies
+	\return The new loader, or NULL if the descriptor is invalid
 
-	@see PxCollection, PxSerialization::complete, PxSerialization::serializeCollectionToBinary, PxSerializationRegistry, PX_BINARY_SERIAL_VERSION
+	@see PxStreamingCollectionLoader, PxStreamingCollectionLoaderDesc, PxSerialization::createCollectionFromBinary
 	*/
-	static	PxCollection*	createCollectionFromBinary(void* memBlock, PxSerializationRegistry& sr, const PxCollection* externalRefs = NULL);
+	static	PxStreamingCollectionLoader*	createStreamingCollectionLoader(PxInputData& data, PxSerializationRegistry& sr, PxScene& scene, const PxStreamingCollectionLoaderDesc& desc, const PxCollection* externalRefs = NULL);
 
 	/**
 	\brief Serializes a physics collection to an XML output stream.
@@ -0,0 +1,180 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef PX_STREAMING_COLLECTION_LOADER_H
+#define PX_STREAMING_COLLECTION_LOADER_H
+/** \addtogroup extensions
+  @{
+*/
+
+#include "PxPhysXConfig.h"
+#include "foundation/PxSimpleTypes.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+class PxCollection;
+
+/**
+\brief Loading states of a PxStreamingCollectionLoader.
+
+@see PxStreamingCollectionLoader
+*/
+struct PxStreamingCollectionLoaderState
+{
+	enum Enum
+	{
+		eREADING,			//!< Binary data is read from the input stream
+		eDESERIALIZING,		//!< Objects are created from the binary data and registered with PxPhysics
+		eINSERTING,			//!< Actors, aggregates, articulations and pruning structures are added to the scene
+		eCOMPLETE,			//!< All objects are in the scene
+		eFAILED				//!< Loading failed. Objects created so far have been released
+	};
+};
+
+/**
+\brief Descriptor for PxStreamingCollectionLoader.
+
+The limits bound the work done by a single PxStreamingCollectionLoader::update() call, in addition to its time budget.
+
+@see PxStreamingCollectionLoader PxSerialization::createStreamingCollectionLoader
+*/
+class PxStreamingCollectionLoaderDesc
+{
+public:
+	/**
+	\brief Number of bytes read from the input stream at once.
+	*/
+	PxU32	readChunkSize;
+
+	/**
+	\brief Maximum number of bytes read by one update() call.
+	*/
+	PxU32	maxBytesPerUpdate;
+
+	/**
+	\brief Maximum number of objects deserialized by one update() call.
+	*/
+	PxU32	maxObjectsPerUpdate;
+
+	/**
+	\brief Maximum number of actors added to the scene by one update() call.
+
+	Aggregates, articulations and pruning structures are added at once, with all their actors. They count as their number of actors,
+	and are added by an update() call that has not added anything yet even if they exceed the limit.
+	*/
+	PxU32	maxActorsPerUpdate;
+
+	PX_INLINE PxStreamingCollectionLoaderDesc() :
+		readChunkSize		(1<<20),
+		maxBytesPerUpdate	(0xffffffff),
+		maxObjectsPerUpdate	(0xffffffff),
+		maxActorsPerUpdate	(0xffffffff)
+	{
+	}
+
+	/**
+	\brief Returns true if the descriptor is valid.
+	\return true if the current settings are valid.
+	*/
+	PX_INLINE bool isValid() const
+	{
+		return readChunkSize && maxBytesPerUpdate && maxObjectsPerUpdate && maxActorsPerUpdate;
+	}
+};
+
+/**
+\brief Loads a binary serialized collection into a scene over several frames.
+
+Each update() call makes progress under a time budget: the binary data is read from the input stream in chunks, then the objects are
+deserialized in small batches, and finally the actors are added to the scene in batches. Pruning structures found in the collection
+are added with PxScene::addActors(const PxPruningStructure&), which reuses their precomputed scene query trees. Other actors go
+through the regular scene insertion.
+
+The loader owns the memory block of the deserialized objects. The objects of its collection are released along with the loader,
+which also removes them from the scene. The collection is read-only, so that the loader knows all the objects in its memory block.
+
+\note Reading the binary tables and building their reference maps happens in a single update() call, and so does the insertion
+of each aggregate, articulation and pruning structure. The other steps are split into batches.
+
+\note update() must not be called while the scene is simulating. Actors are added to the scene progressively, so the simulation can
+run between two update() calls with part of the collection in the scene.
+
+@see PxSerialization::createStreamingCollectionLoader PxStreamingCollectionLoaderDesc PxSerialization::createCollectionFromBinary
+*/
+class PxStreamingCollectionLoader
+{
+public:
+	/**
+	\brief Releases the loaded objects, the collection and the loader.
+
+	The objects are released with PxCollectionExt::releaseObjects(), which removes them from the scene.
+
+	The objects live in the memory block of the loader, which is freed along with it. If a reference-counted object of the collection
+	is still referenced from outside, e.g. a loaded shape attached to another actor, a loaded material or mesh used by another shape, or
+	a reference acquired with PxRefCounted::acquireReference(), the function reports an error and does nothing. Release these references
+	first, then release the loader again.
+	*/
+	virtual	void									release()	= 0;
+
+	/**
+	\brief Makes progress until the time budget is spent, a limit of the descriptor is reached or loading is done.
+
+	At least one step is made per call, e.g. reading one chunk or deserializing a small batch of objects, so that loading completes even
+	with a zero time budget.
+
+	\param[in] timeBudget	Time budget in seconds
+
+	\return	The loading state after the call
+	*/
+	virtual	PxStreamingCollectionLoaderState::Enum	update(PxReal timeBudget)	= 0;
+
+	/**
+	\brief Returns the current loading state.
+	*/
+	virtual	PxStreamingCollectionLoaderState::Enum	getState()	const	= 0;
+
+	/**
+	\brief Returns the loaded collection, or NULL before deserialization is complete.
+
+	The collection is owned by the loader and released with it.
+	*/
+	virtual	const PxCollection*						getCollection()	const	= 0;
+
+protected:
+	virtual											~PxStreamingCollectionLoader()	{}
+};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+/** @} */
+#endif
@@ -0,0 +1,329 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef PX_TILED_HEIGHT_FIELD_H
+#define PX_TILED_HEIGHT_FIELD_H
+/** \addtogroup extensions
+  @{
+*/
+
+#include "PxPhysXConfig.h"
+#include "foundation/PxTransform.h"
+#include "foundation/PxBounds3.h"
+#include "geometry/PxHeightFieldSample.h"
+#include "geometry/PxHeightFieldFlag.h"
+#include "PxShape.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+class PxPhysics;
+class PxScene;
+class PxMaterial;
+class PxRigidStatic;
+class PxHeightField;
+
+/**
+\brief Source of heightfield tiles for PxTiledHeightField.
+
+A tile covers (tileSize+1)*(tileSize+1) samples. Neighbor tiles share their border samples, i.e. tile (tileRow, tileColumn)
+covers the global samples [tileRow*tileSize, tileRow*tileSize+tileSize] x [tileColumn*tileSize, tileColumn*tileSize+tileSize].
+
+@see PxTiledHeightField PxTiledHeightFieldDesc
+*/
+class PxTiledHeightFieldSource
+{
+public:
+	virtual ~PxTiledHeightFieldSource()	{}
+
+	/**
+	\brief Called when a tile gets loaded.
+
+	\param[in] tileRow		Row index of the tile
+	\param[in] tileColumn	Column index of the tile
+	\param[out] samples		Tile samples to fill, (tileSize+1)*(tileSize+1) entries in row-major order
+
+	\return	True if the tile is available. The tile is not loaded otherwise.
+	*/
+	virtual	bool	loadTile(PxU32 tileRow, PxU32 tileColumn, PxHeightFieldSample* samples)	= 0;
+
+	/**
+	\brief Called when a tile modified by PxTiledHeightField::modifySamples() gets evicted.
+
+	This gives the source an opportunity to keep runtime modifications, which would be lost otherwise.
+
+	\param[in] tileRow		Row index of the tile
+	\param[in] tileColumn	Column index of the tile
+	\param[in] samples		Current tile samples, (tileSize+1)*(tileSize+1) entries in row-major order
+	*/
+	virtual	void	storeTile(PxU32 tileRow, PxU32 tileColumn, const PxHeightFieldSample* samples)
+	{
+		PX_UNUSED(tileRow);
+		PX_UNUSED(tileColumn);
+		PX_UNUSED(samples);
+	}
+};
+
+/**
+\brief Descriptor for PxTiledHeightField.
+
+@see PxTiledHeightField PxCreateTiledHeightField
+*/
+class PxTiledHeightFieldDesc
+{
+public:
+	/**
+	\brief Number of tiles along the heightfield rows (local x axis).
+	*/
+	PxU32						nbTileRows;
+
+	/**
+	\brief Number of tiles along the heightfield columns (local z axis).
+	*/
+	PxU32						nbTileColumns;
+
+	/**
+	\brief Number of cells along each side of a tile. Each tile has (tileSize+1)*(tileSize+1) samples.
+	*/
+	PxU32						tileSize;
+
+	/**
+	\brief Scales applied to all tiles. See PxHeightFieldGeometry.
+
+	@see PxHeightFieldGeometry
+	*/
+	PxReal						heightScale;
+	PxReal						rowScale;
+	PxReal						columnScale;
+
+	/**
+	\brief World pose of the whole tiled heightfield. Tile (0,0) starts at the origin of this frame.
+	*/
+	PxTransform					pose;
+
+	/**
+	\brief Materials used by all tiles, and their number.
+	*/
+	PxMaterial*const*			materials;
+	PxU16						nbMaterials;
+
+	/**
+	\brief Flags of the tiles' shapes.
+	*/
+	PxShapeFlags				shapeFlags;
+
+	/**
+	\brief Flags of the tiles' heightfields.
+
+	Tile borders are heightfield boundaries. The default eNO_BOUNDARY_EDGES flag prevents contacts against the internal
+	edges of these borders, which would otherwise make objects bump when crossing from one tile to the next.
+	*/
+	PxHeightFieldFlags			heightFieldFlags;
+
+	/**
+	\brief Tile source. Must remain valid as long as the tiled heightfield exists.
+	*/
+	PxTiledHeightFieldSource*	source;
+
+	/**
+	\brief Maximum number of tiles loaded by one PxTiledHeightField::updateStreaming() call, to spread loading costs over several frames.
+	*/
+	PxU32						maxLoadsPerUpdate;
+
+	/**
+	\brief Ratio between the eviction and loading radii used by PxTiledHeightField::updateStreaming(). Must be >= 1.
+
+	Values larger than 1 avoid loading and evicting the same tiles repeatedly when the streaming center moves back and forth.
+	*/
+	PxReal						evictionRadiusScale;
+
+	PX_INLINE PxTiledHeightFieldDesc() :
+		nbTileRows			(0),
+		nbTileColumns		(0),
+		tileSize			(0),
+		heightScale			(1.0f),
+		rowScale			(1.0f),
+		columnScale			(1.0f),
+		pose				(PxIdentity),
+		materials			(NULL),
+		nbMaterials			(0),
+		shapeFlags			(PxShapeFlag::eVISUALIZATION | PxShapeFlag::eSCENE_QUERY_SHAPE | PxShapeFlag::eSIMULATION_SHAPE),
+		heightFieldFlags	(PxHeightFieldFlag::eNO_BOUNDARY_EDGES),
+		source				(NULL),
+		maxLoadsPerUpdate	(4),
+		evictionRadiusScale	(1.25f)
+	{
+	}
+
+	/**
+	\brief Returns true if the descriptor is valid.
+	\return true if the current settings are valid.
+	*/
+	PX_INLINE bool isValid() const
+	{
+		if(!nbTileRows || !nbTileColumns || tileSize<1)
+			return false;
+		if(!materials || !nbMaterials || !source)
+			return false;
+		if(!(heightScale>0.0f) || !(rowScale>0.0f) || !(columnScale>0.0f))
+			return false;
+		if(!pose.isValid())
+			return false;
+		if(!(evictionRadiusScale>=1.0f))
+			return false;
+		return true;
+	}
+};
+
+/**
+\brief A large heightfield split into tiles that are streamed in and out of a scene.
+
+Each loaded tile is a regular PxHeightField, attached to its own static actor. As a result the scene's broadphase and scene-query
+pruners cull whole tiles by their bounds before any per-cell work is done, and runtime modifications only touch the tiles they overlap.
+
+Heightfield modifications are applied immediately to the tiles' samples, but the tiles' bounds are only updated by
+flushModifications(). This way many small modifications made during a frame only cost one bounds update per modified tile.
+
+\note This class is not thread-safe and must not be used while the scene is simulating.
+
+@see PxCreateTiledHeightField PxTiledHeightFieldDesc PxTiledHeightFieldSource
+*/
+class PxTiledHeightField
+{
+public:
+	/**
+	\brief Evicts all tiles and releases the tiled heightfield.
+	*/
+	virtual	void				release()	= 0;
+
+	/**
+	\brief Loads a tile from the source and adds it to the scene. Does nothing if the tile is already loaded.
+
+	\return	True if the tile is loaded after the call.
+	*/
+	virtual	bool				loadTile(PxU32 tileRow, PxU32 tileColumn)	= 0;
+
+	/**
+	\brief Removes a tile from the scene and releases it. Modified tiles are passed to PxTiledHeightFieldSource::storeTile() first.
+	*/
+	virtual	void				evictTile(PxU32 tileRow, PxU32 tileColumn)	= 0;
+
+	/**
+	\brief Returns true if the tile is currently loaded.
+	*/
+	virtual	bool				isTileLoaded(PxU32 tileRow, PxU32 tileColumn)	const	= 0;
+
+	/**
+	\brief Returns the number of currently loaded tiles.
+	*/
+	virtual	PxU32				getNbLoadedTiles()	const	= 0;
+
+	/**
+	\brief Loads tiles close to a streaming center and evicts distant ones.
+
+	Missing tiles within loadRadius of the center are loaded, closest first, up to PxTiledHeightFieldDesc::maxLoadsPerUpdate tiles
+	per call. Loaded tiles farther than loadRadius*PxTiledHeightFieldDesc::evictionRadiusScale are evicted. Distances are measured
+	in the heightfield's plane.
+
+	\param[in] center		Streaming center, in world space
+	\param[in] loadRadius	Loading radius
+
+	\return	Number of tiles loaded by this call
+	*/
+	virtual	PxU32				updateStreaming(const PxVec3& center, PxReal loadRadius)	= 0;
+
+	/**
+	\brief Replaces a rectangular region of samples, in global sample coordinates.
+
+	Only loaded tiles are modified. Samples on tile borders are shared and written to all the tiles containing them.
+	Bounds of modified tiles are updated by the next flushModifications() call.
+
+	\param[in] startRow		First global sample row
+	\param[in] startColumn	First global sample column
+	\param[in] nbRows		Number of sample rows to modify
+	\param[in] nbColumns	Number of sample columns to modify
+	\param[in] samples		New samples, nbRows*nbColumns entries in row-major order
+
+	\return	Number of loaded tiles touched by the modification
+	*/
+	virtual	PxU32				modifySamples(PxU32 startRow, PxU32 startColumn, PxU32 nbRows, PxU32 nbColumns, const PxHeightFieldSample* samples)	= 0;
+
+	/**
+	\brief Recomputes the bounds of tiles modified since the last call, and updates their shapes in the scene.
+
+	\return	Number of updated tiles
+	*/
+	virtual	PxU32				flushModifications()	= 0;
+
+	/**
+	\brief Returns the world bounds of a loaded tile, including its current height range.
+
+	\return	False if the tile is not loaded
+	*/
+	virtual	bool				getTileBounds(PxU32 tileRow, PxU32 tileColumn, PxBounds3& bounds)	const	= 0;
+
+	/**
+	\brief Returns the actor of a loaded tile, or NULL.
+	*/
+	virtual	PxRigidStatic*		getTileActor(PxU32 tileRow, PxU32 tileColumn)	const	= 0;
+
+	/**
+	\brief Returns the heightfield of a loaded tile, or NULL.
+	*/
+	virtual	PxHeightField*		getTileHeightField(PxU32 tileRow, PxU32 tileColumn)	const	= 0;
+
+	/**
+	\brief Returns the descriptor used to create the tiled heightfield.
+	*/
+	virtual	const PxTiledHeightFieldDesc&	getDesc()	const	= 0;
+
+protected:
+	virtual						~PxTiledHeightField()	{}
+};
+
+/**
+\brief Creates a tiled heightfield. No tile is loaded initially.
+
+\param[in] physics	The physics object used to create the tiles' heightfields, actors and shapes
+\param[in] scene	The scene receiving the tiles' actors
+\param[in] desc		The tiled heightfield descriptor
+
+\return	The new tiled heightfield, or NULL if the descriptor is invalid
+
+@see PxTiledHeightField PxTiledHeightFieldDesc
+*/
+PxTiledHeightField*	PxCreateTiledHeightField(PxPhysics& physics, PxScene& scene, const PxTiledHeightFieldDesc& desc);
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+/** @} */
+#endif
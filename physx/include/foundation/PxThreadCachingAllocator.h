@@ -0,0 +1,153 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+
+
+#ifndef PX_THREAD_CACHING_ALLOCATOR_H
+#define PX_THREAD_CACHING_ALLOCATOR_H
+
+/** \addtogroup foundation
+  @{
+*/
+
+#include "foundation/PxAllocatorCallback.h"
+#include "foundation/PxFoundationConfig.h"
+#include "foundation/PxSimpleTypes.h"
+
+/**
+\brief Default bound on the bytes held in the bins of all threads of a thread caching allocator.
+
+@see PxCreateThreadCachingAllocator()
+*/
+#define PX_THREAD_CACHING_ALLOCATOR_DEFAULT_MAX_THREAD_CACHED_BYTES	(16 * 1024 * 1024)
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+/**
+\brief Allocation counters of a thread caching allocator.
+
+The counters are summed over all threads without synchronization, so they are approximate while other threads
+allocate.
+
+@see PxThreadCachingAllocator::getStats() PxGetTempAllocatorStats()
+*/
+struct PxThreadCachingAllocatorStats
+{
+	PxU64	nbAllocations;				//!< Number of allocate() calls
+	PxU64	nbDeallocations;			//!< Number of deallocate() calls
+	PxU64	nbThreadCacheHits;			//!< Allocations served from the bins of the calling thread, without any lock
+	PxU64	nbSharedPoolTransfers;		//!< Batches of blocks moved between a thread's bins and the shared pool
+	PxU64	nbSharedPoolContentions;	//!< Shared pool accesses which had to wait for another thread
+	PxU64	nbBaseAllocations;			//!< Allocations forwarded to the underlying allocator, including large ones
+	PxU64	nbBaseDeallocations;		//!< Deallocations forwarded to the underlying allocator
+	PxU64	nbCachedBytes;				//!< Bytes held in the thread bins and the shared pool, ready for reuse
+	PxU32	nbThreads;					//!< Number of threads which allocated so far
+};
+
+/**
+\brief Allocator keeping per-thread caches of freed blocks.
+
+Blocks up to 128kB are rounded up to a power of two size class. Each thread keeps a bin of free blocks per size
+class, so most allocations and deallocations take no lock. When a bin is full, half of it is moved to a shared pool
+in one batch, and an empty bin is refilled with a batch from the shared pool, so threads which free memory allocated
+by other threads do not hoard it. Larger blocks are forwarded to the underlying allocator.
+
+The allocator does not use the foundation, so it can be passed to PxCreateFoundation() as the allocator callback.
+Blocks cached by a thread are only returned to the underlying allocator when the allocator is released or trimmed,
+which suits the long lived worker threads of the SDK. The bins of all threads share a budget, so threads which exit
+leave a bounded amount of memory behind until the next trim. Blocks freed while the budget is exhausted go back to the
+underlying allocator.
+
+Returned blocks are 16 byte aligned.
+
+@see PxCreateThreadCachingAllocator()
+*/
+class PxThreadCachingAllocator : public PxAllocatorCallback
+{
+protected:
+	virtual					~PxThreadCachingAllocator()	{}
+
+public:
+	/**
+	\brief Releases the allocator and returns all cached blocks to the underlying allocator.
+
+	All the blocks allocated through it must have been deallocated, and no thread may use it anymore.
+	*/
+	virtual	void			release()	= 0;
+
+	/**
+	\brief Returns the blocks cached in the shared pool and in the bins of all threads to the underlying allocator.
+
+	This also reclaims the bins and the budget of threads which exited. No other thread may allocate or deallocate
+	through the allocator during the call.
+	*/
+	virtual	void			trim()	= 0;
+
+	/**
+	\brief Retrieves the allocation counters.
+
+	\param[out] stats	The counters, summed over all threads.
+	*/
+	virtual	void			getStats(PxThreadCachingAllocatorStats& stats)	const	= 0;
+
+	/**
+	\brief Resets the allocation counters. nbCachedBytes and nbThreads are not affected.
+	*/
+	virtual	void			resetStats()	= 0;
+};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+/**
+\brief Creates a thread caching allocator.
+
+\param[in] baseAllocator			Allocator the blocks and the allocator's own data are taken from. Must outlive the allocator.
+\param[in] maxThreadCachedBytes	Bound on the bytes held in the bins of all threads together. The shared pool is bounded separately.
+\return The new allocator, or NULL on failure.
+
+@see PxThreadCachingAllocator
+*/
+PX_C_EXPORT PX_FOUNDATION_API physx::PxThreadCachingAllocator* PX_CALL_CONV PxCreateThreadCachingAllocator(physx::PxAllocatorCallback& baseAllocator,
+	physx::PxU32 maxThreadCachedBytes = PX_THREAD_CACHING_ALLOCATOR_DEFAULT_MAX_THREAD_CACHED_BYTES);
+
+/**
+\brief Retrieves the allocation counters of the temporary allocator of the foundation.
+
+PxTempAllocator, used for short lived scratch memory throughout the SDK, is a thread caching allocator owned by the
+foundation. The foundation must have been created.
+
+\param[out] stats	The counters, summed over all threads.
+
+@see PxTempAllocator PxThreadCachingAllocatorStats
+*/
+PX_C_EXPORT PX_FOUNDATION_API void PX_CALL_CONV PxGetTempAllocatorStats(physx::PxThreadCachingAllocatorStats& stats);
+
+/** @} */
+#endif
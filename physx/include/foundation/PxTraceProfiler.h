@@ -0,0 +1,121 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+
+#ifndef PX_TRACE_PROFILER_H
+#define PX_TRACE_PROFILER_H
+
+/** \addtogroup foundation
+  @{
+*/
+
+#include "foundation/PxProfiler.h"
+#include "foundation/PxFoundationConfig.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+class PxOutputStream;
+
+/**
+\brief Built-in low overhead profiler recording the profile zones of the SDK.
+
+The profiler records the start and end of each zone, with a time stamp, into a ring buffer owned by the thread
+emitting the zone. Recording takes no lock and does no allocation, apart from creating the buffer the first time
+a thread records a zone. When a buffer is full the oldest events of that thread are overwritten, so the profiler
+can be left installed indefinitely and always holds the most recent history.
+
+The recorded events are written out in the Chrome trace event format (JSON), which can be loaded in
+chrome://tracing or in the Perfetto UI.
+
+Install the profiler with PxSetProfilerCallback(). Before releasing it, uninstall it and make sure that no thread
+is still inside a profile zone.
+
+@see PxCreateTraceProfiler() PxSetProfilerCallback()
+*/
+class PxTraceProfiler : public PxProfilerCallback
+{
+protected:
+	virtual					~PxTraceProfiler()	{}
+
+public:
+	/**
+	\brief Releases the profiler and all recorded events.
+	*/
+	virtual	void			release()	= 0;
+
+	/**
+	\brief Writes the recorded events of all threads to a stream, in the Chrome trace event format.
+
+	This can be called while zones are being recorded. Events that get overwritten while they are written out are
+	skipped. Zones whose start has already been overwritten are skipped as well.
+
+	\param[in] stream	Stream to write the JSON document to, typically a file stream
+	\return	True on success, false if the stream did not accept all the data.
+	*/
+	virtual	bool			writeChromeTrace(PxOutputStream& stream)	= 0;
+
+	/**
+	\brief Discards all events recorded so far.
+
+	This can be called while zones are being recorded.
+	*/
+	virtual	void			reset()	= 0;
+
+	/**
+	\brief Returns the number of threads which recorded zones so far.
+	*/
+	virtual	PxU32			getNbThreads()	const	= 0;
+
+	/**
+	\brief Returns the number of events that can be held per thread before the oldest ones get overwritten.
+
+	\note writeChromeTrace() outputs at most getNbEventsPerThread() - 1 events per thread, since the last slot can be in the middle of
+	being written by its thread.
+	*/
+	virtual	PxU32			getNbEventsPerThread()	const	= 0;
+};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+/**
+\brief Creates a trace profiler.
+
+The foundation must have been created.
+
+\param[in] nbEventsPerThread	Capacity of the ring buffer of each thread, in events. Rounded up to a power of two.
+A zone uses two events, and an event uses 32 bytes.
+\return The new profiler, or NULL on failure.
+
+@see PxTraceProfiler
+*/
+PX_C_EXPORT PX_FOUNDATION_API physx::PxTraceProfiler* PX_CALL_CONV PxCreateTraceProfiler(physx::PxU32 nbEventsPerThread);
+
+/** @} */
+#endif
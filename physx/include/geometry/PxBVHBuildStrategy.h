@@ -54,6 +54,26 @@ struct PxBVHBuildStrategy
 	};
 };
 
+/**
+\brief Desired node width for bounding-volume hierarchies queries
+
+BVHs are always built as binary trees. Wide modes additionally collapse the binary tree into a tree with 4 or 8 children
+per node, whose bounds are tested together with SIMD instructions during traversal. This reduces the number of visited
+nodes (and touched cache lines) in raycast, sweep and overlap queries, at the cost of some extra memory and a slightly
+more expensive refit.
+
+@see PxBVHBuildStrategy
+*/
+struct PxBVHNodeWidth
+{
+	enum Enum
+	{
+		eBINARY = 2,	//!< Regular binary tree. Cheapest to build and refit. Recommended for frequently updated trees.
+		eWIDE_4 = 4,	//!< Binary tree collapsed to 4 children per node for queries.
+		eWIDE_8 = 8		//!< Binary tree collapsed to 8 children per node for queries. Best for large static trees.
+	};
+};
+
 #if !PX_DOXYGEN
 } // namespace physx
 #endif
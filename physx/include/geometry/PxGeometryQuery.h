@@ -45,6 +45,7 @@ The reason for this is GJK support cannot be evaluated near infinity. A viable a
 #include "geometry/PxGeometryHit.h"
 #include "geometry/PxGeometryQueryFlags.h"
 #include "geometry/PxGeometryQueryContext.h"
+#include "geometry/PxGjkQuery.h"
 
 #if !PX_DOXYGEN
 namespace physx
@@ -195,12 +196,42 @@ public:
 														const PxGeometry& geom1, const PxTransform& pose1,
 														PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT);
 
+	/**
+	\brief Compute minimum translational distance (MTD) between two geometry objects, warm-started with a cached simplex.
+
+	Same as the other computePenetration() function, and returns the same results. When one object is a convex mesh and
+	the other one is a sphere, a capsule, a box or a convex mesh, a GJK test runs first and separated objects are rejected
+	without computing the MTD. This overload starts that test from the simplex stored in the cache. For objects queried
+	every frame with small pose changes, it typically terminates after one or two iterations. The cache is updated with
+	the new simplex. Other pairs of geometries ignore the cache.
+
+	A cache must only be used with one pair of objects, always passed in the same order.
+
+	\param[out] direction	Computed MTD unit direction
+	\param[out] depth		Penetration depth. Always positive or null.
+	\param[in] geom0		The first geometry object
+	\param[in] pose0		Pose of the first geometry object
+	\param[in] geom1		The second geometry object
+	\param[in] pose1		Pose of the second geometry object
+	\param[in,out] cache	Warm-start data for this pair of objects
+	\param[in] queryFlags	Optional flags controlling the query.
+	\return True if the MTD has successfully been computed, i.e. if objects do overlap.
+
+	@see PxGjkQuery::Cache PxGeometry PxTransform
+	*/
+	PX_PHYSX_COMMON_API static bool	computePenetration(	PxVec3& direction, PxF32& depth,
+														const PxGeometry& geom0, const PxTransform& pose0,
+														const PxGeometry& geom1, const PxTransform& pose1,
+														PxGjkQuery::Cache& cache,
+														PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT);
+
 	/**
 	\brief Computes distance between a point and a geometry object.
 
 	Currently supported geometry objects: box, sphere, capsule, convex, mesh.
 
-	\note For meshes, only the BVH34 midphase data-structure is supported.
+	\note For meshes, both midphase data-structures are supported. BVH33 meshes use a slower search based on growing
+	bounding boxes, since the BVH33 tree cannot be traversed closest-first.
 
 	\param[in] point			The point P
 	\param[in] geom				The geometry object
@@ -216,6 +247,78 @@ public:
 													PxVec3* closestPoint=NULL, PxU32* closestIndex=NULL,
 													PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT);
 
+	/**
+	\brief Raycast test of multiple rays against the same geometry object.
+
+	This is equivalent to calling #raycast() for each ray with maxHits=1, but the per-call overhead (parameter checks,
+	function dispatch) is paid once for the whole batch. Rays against spheres and boxes are processed 4 at a time using SIMD.
+
+	\param[in] nbRays			Number of rays
+	\param[in] origins			The origins of the rays (nbRays entries)
+	\param[in] unitDirs			Normalized directions of the rays (nbRays entries)
+	\param[in] geom				The geometry object to test the rays against
+	\param[in] pose				Pose of the geometry object
+	\param[in] maxDist			Maximum ray length, has to be in the [0, inf) range
+	\param[in] hitFlags			Specification of the kind of information to retrieve on hit. Combination of #PxHitFlag flags
+	\param[out] rayHits			Raycast hits, one per ray. For rays that miss, the distance is set to PX_MAX_F32 and the flags are cleared.
+	\param[in] stride			Stride value (in number of bytes) for rayHits array. Typically sizeof(PxGeomRaycastHit) for packed arrays.
+	\param[in] queryFlags		Optional flags controlling the query.
+	\param[in] threadContext	Optional user-defined per-thread context.
+
+	\return Number of rays that hit the geometry object
+
+	@see raycast PxGeomRaycastHit PxGeometry PxTransform
+	*/
+	PX_PHYSX_COMMON_API static PxU32 raycasts(	PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs,
+												const PxGeometry& geom, const PxTransform& pose,
+												PxReal maxDist, PxHitFlags hitFlags,
+												PxGeomRaycastHit* PX_RESTRICT rayHits, PxU32 stride, PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT,
+												PxRaycastThreadContext* threadContext = NULL);
+
+	/**
+	\brief Overlap tests of multiple instances of a geometry object against another geometry object.
+
+	This is equivalent to calling #overlap() for each pose in poses0, but the per-call overhead is paid once for the whole
+	batch. Sphere vs {sphere, capsule, box} and box vs box are processed 4 at a time using SIMD.
+
+	\param[in] nb				Number of tests
+	\param[in] geom0			The first geometry object
+	\param[in] poses0			Poses of the first geometry object (nb entries)
+	\param[in] geom1			The second geometry object
+	\param[in] pose1			Pose of the second geometry object
+	\param[out] results			Overlap results (nb entries)
+	\param[in] queryFlags		Optional flags controlling the query.
+	\param[in] threadContext	Optional user-defined per-thread context.
+
+	\return Number of overlapping pairs
+
+	@see overlap PxGeometry PxTransform
+	*/
+	PX_PHYSX_COMMON_API static PxU32 overlaps(	PxU32 nb, const PxGeometry& geom0, const PxTransform* poses0,
+												const PxGeometry& geom1, const PxTransform& pose1, bool* results,
+												PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT, PxOverlapThreadContext* threadContext=NULL);
+
+	/**
+	\brief Computes distances between multiple points and the same geometry object.
+
+	This is equivalent to calling #pointDistance() for each point, but the per-call overhead is paid once for the whole
+	batch. Points against spheres, capsules and boxes are processed 4 at a time using SIMD.
+
+	\param[in] nbPoints			Number of points
+	\param[in] points			The points (nbPoints entries)
+	\param[in] geom				The geometry object
+	\param[in] pose				Pose of the geometry object
+	\param[out] sqDistances		Square distances between the points and the geom object, see #pointDistance() (nbPoints entries)
+	\param[out] closestPoints	Optional closest points, see #pointDistance() (nbPoints entries)
+	\param[out] closestIndices	Optional closest (triangle) indices. Only valid for triangle meshes (nbPoints entries)
+	\param[in] queryFlags		Optional flags controlling the query.
+
+	@see pointDistance PxGeometry PxTransform
+	*/
+	PX_PHYSX_COMMON_API static void pointDistances(	PxU32 nbPoints, const PxVec3* points, const PxGeometry& geom, const PxTransform& pose,
+													PxReal* sqDistances, PxVec3* closestPoints=NULL, PxU32* closestIndices=NULL,
+													PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT);
+
 	/**
 	\brief computes the bounds for a geometry object
 
@@ -32,6 +32,7 @@
 #include "common/PxPhysXCommonConfig.h"
 #include "foundation/PxVec3.h"
 #include "foundation/PxQuat.h"
+#include "foundation/PxTransform.h"
 
 #if !PX_DOXYGEN
 namespace physx
@@ -71,6 +72,48 @@ public:
 		virtual PxVec3 supportLocal(const PxVec3& dir) const = 0;
 	};
 
+	/**
+	\brief Warm-start data for repeated queries between the same two shapes.
+
+	Queries taking a cache start from the simplex found by the previous query, instead of starting from scratch. The simplex
+	vertices are stored in the local space of each shape, so they remain valid when the shapes move. When the relative pose of
+	the shapes only changed a little since the previous query, GJK typically terminates after one or two iterations.
+
+	A cache must only be used with one pair of shapes, always passed in the same order. Call reset() when the shapes change.
+	*/
+	struct Cache
+	{
+		PxVec3	pointsA[4];	//!< Simplex vertices on shape A's core, in shape A's local space
+		PxVec3	pointsB[4];	//!< Simplex vertices on shape B's core, in shape B's local space
+		PxU32	size;		//!< Number of simplex vertices. Zero means the next query starts from scratch.
+
+		PX_INLINE		Cache() : size(0)	{}
+		PX_INLINE void	reset()				{ size = 0;	}
+	};
+
+	/**
+	\brief A pair of shapes for batched queries.
+	*/
+	struct Pair
+	{
+		const Support*	a;		//!< Shape A support mapping
+		const Support*	b;		//!< Shape B support mapping
+		PxTransform		poseA;	//!< Shape A transformation
+		PxTransform		poseB;	//!< Shape B transformation
+	};
+
+	/**
+	\brief Result of a batched proximity query, see #proximityInfos().
+	*/
+	struct ProximityInfo
+	{
+		PxVec3	pointA;			//!< The closest/deepest point on shape A surface
+		PxVec3	pointB;			//!< The closest/deepest point on shape B surface
+		PxVec3	separatingAxis;	//!< Translating shape B along 'separatingAxis' by 'separation' makes the shapes touching
+		PxReal	separation;		//!< Translating shape B along 'separatingAxis' by 'separation' makes the shapes touching
+		bool	hit;			//!< False if the distance is greater than contactDistance. Other members are undefined in this case.
+	};
+
 	/**
 	\brief Computes proximity information for two shapes using GJK-EPA algorithm
 
@@ -90,6 +133,47 @@ public:
 	PX_PHYSX_COMMON_API static bool proximityInfo(const Support& a, const Support& b, const PxTransform& poseA, const PxTransform& poseB,
 		PxReal contactDistance, PxReal toleranceLength, PxVec3& pointA, PxVec3& pointB, PxVec3& separatingAxis, PxReal& separation);
 
+	/**
+	\brief Computes proximity information for two shapes using GJK-EPA algorithm, warm-started with a cached simplex
+
+	Same as the other proximityInfo() function, but GJK starts from the simplex stored in the cache, and the cache is updated
+	with the new simplex. See #Cache.
+
+	\param[in] a				Shape A support mapping
+	\param[in] b				Shape B support mapping
+	\param[in] poseA			Shape A transformation
+	\param[in] poseB			Shape B transformation
+	\param[in] contactDistance	The distance at which proximity info begins to be computed between the shapes
+	\param[in] toleranceLength	The toleranceLength. Used for scaling distance-based thresholds internally to produce appropriate results given simulations in different units
+	\param[out] pointA			The closest/deepest point on shape A surface
+	\param[out] pointB			The closest/deepest point on shape B surface
+	\param[out] separatingAxis	Translating shape B along 'separatingAxis' by 'separation' makes the shapes touching
+	\param[out] separation		Translating shape B along 'separatingAxis' by 'separation' makes the shapes touching
+	\param[in,out] cache		Warm-start data for this pair of shapes
+
+	\return						False if the distance greater than contactDistance.
+	*/
+	PX_PHYSX_COMMON_API static bool proximityInfo(const Support& a, const Support& b, const PxTransform& poseA, const PxTransform& poseB,
+		PxReal contactDistance, PxReal toleranceLength, PxVec3& pointA, PxVec3& pointB, PxVec3& separatingAxis, PxReal& separation, Cache& cache);
+
+	/**
+	\brief Computes proximity information for multiple pairs of shapes
+
+	This is equivalent to calling #proximityInfo() for each pair, with or without a cache. Using caches is recommended when
+	the same pairs are queried repeatedly with small pose changes, e.g. once per frame.
+
+	\param[in] nbPairs			Number of pairs
+	\param[in] pairs			The pairs of shapes (nbPairs entries)
+	\param[in] contactDistance	The distance at which proximity info begins to be computed between the shapes
+	\param[in] toleranceLength	The toleranceLength. Used for scaling distance-based thresholds internally to produce appropriate results given simulations in different units
+	\param[out] results			Proximity information, one per pair (nbPairs entries)
+	\param[in,out] caches		Optional warm-start data, one per pair (nbPairs entries). See #Cache.
+
+	\return						Number of pairs within contactDistance
+	*/
+	PX_PHYSX_COMMON_API static PxU32 proximityInfos(PxU32 nbPairs, const Pair* pairs, PxReal contactDistance, PxReal toleranceLength,
+		ProximityInfo* results, Cache* caches = NULL);
+
 	/**
 	\brief Raycast test against the given shape.
 
@@ -119,6 +203,22 @@ public:
 	*/
 	PX_PHYSX_COMMON_API static bool overlap(const Support& a, const Support& b, const PxTransform& poseA, const PxTransform& poseB);
 
+	/**
+	\brief Overlap test for two shapes, warm-started with a cached simplex
+
+	Same as the other overlap() function, but GJK starts from the simplex stored in the cache, and the cache is updated
+	with the new simplex. See #Cache.
+
+	\param[in] a				Shape A support mapping
+	\param[in] b				Shape B support mapping
+	\param[in] poseA			Shape A transformation
+	\param[in] poseB			Shape B transformation
+	\param[in,out] cache		Warm-start data for this pair of shapes
+
+	\return					True if the shapes overlap.
+	*/
+	PX_PHYSX_COMMON_API static bool overlap(const Support& a, const Support& b, const PxTransform& poseA, const PxTransform& poseB, Cache& cache);
+
 	/**
 	\brief Sweep the shape B in space and test for collision with the shape A.
 
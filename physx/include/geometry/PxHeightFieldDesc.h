@@ -172,7 +172,7 @@ PX_INLINE bool PxHeightFieldDesc::isValid() const
 		return false;
 	if (convexEdgeThreshold < 0)
 		return false;
-	if ((flags & PxHeightFieldFlag::eNO_BOUNDARY_EDGES) != flags)
+	if ((flags & (PxHeightFieldFlag::eNO_BOUNDARY_EDGES | PxHeightFieldFlag::eMIN_MAX_PYRAMID)) != flags)
 		return false;
 	return true;
 }
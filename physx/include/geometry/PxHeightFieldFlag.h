@@ -140,7 +140,19 @@ struct PxHeightFieldFlag
 
 		@see PxHeightFieldDesc.flags
 		*/
-		eNO_BOUNDARY_EDGES = (1 << 0)
+		eNO_BOUNDARY_EDGES = (1 << 0),
+
+		/**
+		\brief Build a min/max height pyramid for the height field.
+
+		The pyramid lets raycasts and sweeps skip large regions of the height field that they cannot touch, instead of
+		visiting every cell along their path. This is mostly useful for large height fields queried with long rays or
+		sweeps, for example line-of-sight tests grazing the terrain. The pyramid is rebuilt when the height field is
+		loaded or deserialized, and updated by PxHeightField::modifySamples(). It uses about 1/3 byte per cell.
+
+		@see PxHeightFieldDesc.flags
+		*/
+		eMIN_MAX_PYRAMID = (1 << 1)
 	};
 };
 
@@ -49,6 +49,7 @@ class PxTriangleMeshGeometry;
 class PxHeightFieldGeometry;
 
 class PxTriangle;
+class PxCpuDispatcher;
 
 	struct PxMeshMeshQueryFlag
 	{
@@ -61,6 +62,17 @@ class PxTriangle;
 
 	PX_FLAGS_TYPEDEF(PxMeshMeshQueryFlag, PxU32)
 
+	/**
+	\brief Closest point on a triangle mesh, as returned by #PxMeshQuery::pointDistances().
+	*/
+	struct PxMeshClosestPoint
+	{
+		PxVec3	position;		//!< Closest point on the mesh, in world space
+		PxReal	distance;		//!< Distance between the query point and the closest point. PX_MAX_F32 if no triangle was found.
+		PxU32	faceIndex;		//!< Index of the closest triangle. 0xffffffff if no triangle was found.
+		PxReal	u, v;			//!< Barycentric coordinates of the closest point within the closest triangle.
+	};
+
 class PxMeshQuery
 {
 public:
@@ -192,6 +204,58 @@ public:
 															PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT);
 
 
+	/**
+	\brief Computes the closest points on a triangle mesh for a set of query points.
+
+	This is the batched version of PxGeometryQuery::pointDistance() for triangle meshes. The query points are sorted
+	spatially and grouped in small clusters, and the mesh's BVH is traversed once per cluster instead of once per point.
+	Clusters are processed in parallel when a CPU dispatcher is provided.
+
+	\param[in] meshGeom		The triangle mesh geometry.
+	\param[in] meshPose		Pose of the triangle mesh.
+	\param[in] nbPoints		Number of query points.
+	\param[in] points		Query points, in world space.
+	\param[in] maxDist		Triangles further than this distance from a query point are ignored for that point.
+	\param[out] results		Closest points, one per query point.
+	\param[in] dispatcher	Optional CPU dispatcher used to process the clusters on multiple threads. NULL to run everything on the calling thread.
+	\param[in] queryFlags	Optional flags controlling the query.
+	\return Number of query points for which a triangle was found within maxDist.
+
+	\note The (u, v) barycentric coordinates are such that position = (1-u-v)*p0 + u*p1 + v*p2, with p0, p1, p2 the vertices of the closest triangle.
+	\note For meshes with a non-uniform scale, the closest point is searched in the mesh's vertex space, as in PxGeometryQuery::pointDistance().
+	\note Only meshes using the #PxMeshMidPhase::eBVH34 midphase structure use the clustered traversal. For #PxMeshMidPhase::eBVH33
+	meshes the points are processed one by one, as with PxGeometryQuery::pointDistance(), optionally distributed over the dispatcher.
+
+	@see PxMeshClosestPoint PxGeometryQuery::pointDistance() PxGeometryQueryFlags
+	*/
+	PX_PHYSX_COMMON_API static PxU32 pointDistances(const PxTriangleMeshGeometry& meshGeom, const PxTransform& meshPose,
+													PxU32 nbPoints, const PxVec3* points, PxReal maxDist, PxMeshClosestPoint* results,
+													PxCpuDispatcher* dispatcher = NULL,
+													PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT);
+
+	/**
+	\brief Samples the signed distance field (SDF) of a triangle mesh at a set of query points.
+
+	The SDF is interpolated trilinearly. Negative distances are inside the mesh. Points outside of the SDF bounds are clamped
+	to the bounds, and their distance to the bounds is added to the interpolated value.
+
+	\param[in] meshGeom		The triangle mesh geometry. The mesh must have been cooked with an SDF, see #PxSDFDesc.
+	\param[in] meshPose		Pose of the triangle mesh.
+	\param[in] nbPoints		Number of query points.
+	\param[in] points		Query points, in world space.
+	\param[out] distances	Signed distances, one per query point.
+	\param[out] normals		Optional normalized gradients of the distance field in world space, i.e. the surface normals for points close to the surface. Can be NULL.
+	\param[in] queryFlags	Optional flags controlling the query.
+	\return True if the mesh has an SDF and the points have been sampled, false otherwise.
+
+	\note For meshes with a non-uniform scale, the SDF is sampled in the mesh's vertex space and the distance is rescaled along the gradient. This is a first order approximation.
+
+	@see PxSDFDesc PxGeometryQueryFlags
+	*/
+	PX_PHYSX_COMMON_API static bool sdfDistances(const PxTriangleMeshGeometry& meshGeom, const PxTransform& meshPose,
+												PxU32 nbPoints, const PxVec3* points, PxReal* distances, PxVec3* normals = NULL,
+												PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT);
+
 	/**
 	\brief Sweep a specified geometry object in space and test for collision with a set of given triangles.
 
@@ -0,0 +1,211 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#ifndef PX_PVD_ASYNC_FILE_TRANSPORT_H
+#define PX_PVD_ASYNC_FILE_TRANSPORT_H
+
+/** \addtogroup pvd
+@{
+*/
+#include "pvd/PxPvdTransport.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+/**
+\brief Flags controlling the behavior of the asynchronous file transport.
+
+@see PxPvdAsyncFileTransportDesc
+*/
+struct PxPvdAsyncFileTransportFlag
+{
+	enum Enum
+	{
+		/**
+			\brief Compress the capture.
+
+			The data is compressed in blocks with a fast LZ77 codec on the writer thread. A compressed capture must
+			be converted back with PxDecompressPvdCapture() before it can be opened in PVD. Without this flag the
+			file is a regular PVD capture.
+		*/
+		eCOMPRESS				= 1 << 0,
+
+		/**
+			\brief Drop property updates instead of blocking when the memory budget is exceeded.
+
+			While the data waiting for the writer thread exceeds the budget, the transport discards the events
+			that update the properties of existing objects (single property updates and property message
+			groups). Events that create, destroy or link objects are always kept, so the capture stays consistent
+			but misses the state of some frames. Without this flag the simulation thread waits for the writer
+			thread instead.
+		*/
+		eDROP_WHEN_OVER_BUDGET	= 1 << 1
+	};
+};
+
+/**
+\brief Bitfield that contains a set of raised flags defined in PxPvdAsyncFileTransportFlag.
+
+@see PxPvdAsyncFileTransportFlag
+*/
+typedef PxFlags<PxPvdAsyncFileTransportFlag::Enum, PxU32> PxPvdAsyncFileTransportFlags;
+PX_FLAGS_OPERATORS(PxPvdAsyncFileTransportFlag::Enum, PxU32)
+
+/**
+\brief Descriptor of the asynchronous file transport.
+
+@see PxDefaultPvdAsyncFileTransportCreate()
+*/
+class PxPvdAsyncFileTransportDesc
+{
+public:
+	/**
+	\brief Full path of the capture file.
+	*/
+	const char*						filename;
+
+	/**
+	\brief Amount of data, in bytes, collected before it is handed to the writer thread.
+
+	Larger blocks compress better and reduce the synchronization between the threads.
+
+	<b>Range:</b> [4096, memoryBudget/2]<br>
+	<b>Default:</b> 256 KB
+	*/
+	PxU32							blockSize;
+
+	/**
+	\brief Maximum amount of data, in bytes, waiting for the writer thread.
+
+	<b>Range:</b> [2*blockSize, 1 GB]<br>
+	<b>Default:</b> 64 MB
+	*/
+	PxU32							memoryBudget;
+
+	/**
+	\brief Flags, see PxPvdAsyncFileTransportFlag.
+
+	<b>Default:</b> no flag, the capture is a regular PVD capture
+	*/
+	PxPvdAsyncFileTransportFlags	flags;
+
+	PX_INLINE PxPvdAsyncFileTransportDesc(const char* filename_ = NULL)
+	{
+		setToDefault();
+		filename = filename_;
+	}
+
+	PX_INLINE void setToDefault()
+	{
+		filename = NULL;
+		blockSize = 256 * 1024;
+		memoryBudget = 64 * 1024 * 1024;
+		flags = PxPvdAsyncFileTransportFlags();
+	}
+
+	PX_INLINE bool isValid() const
+	{
+		if(!filename)
+			return false;
+		if(blockSize < 4096)
+			return false;
+		if(memoryBudget > (1u << 30) || memoryBudget / 2 < blockSize)
+			return false;
+		return true;
+	}
+};
+
+/**
+\brief Counters of the asynchronous file transport.
+
+@see PxPvdAsyncFileTransport::getStats()
+*/
+struct PxPvdAsyncFileTransportStats
+{
+	PxU64	bytesReceived;	//!< Bytes sent by PVD to the transport, including the dropped ones
+	PxU64	bytesWritten;	//!< Bytes written to the file, after compression
+	PxU64	bytesDropped;	//!< Bytes discarded because the memory budget was exceeded
+	PxU32	eventsDropped;	//!< Number of events discarded because the memory budget was exceeded
+	PxU32	nbThrottles;	//!< Number of times the producing thread had to wait for the writer thread
+	PxU32	maxQueuedBytes;	//!< Highest amount of data waiting for the writer thread
+};
+
+/**
+\brief PVD file transport writing the capture on a dedicated thread.
+
+The thread sending the PVD data only copies it into a block. Full blocks are handed to the writer thread through
+a lock-free queue, and the writer thread optionally compresses them and writes them to the file. The amount of data
+in flight is bounded by PxPvdAsyncFileTransportDesc::memoryBudget.
+
+disconnect() and flush() wait until all the data received so far is in the file.
+
+@see PxDefaultPvdAsyncFileTransportCreate()
+*/
+class PxPvdAsyncFileTransport : public PxPvdTransport
+{
+public:
+	/**
+	\brief Retrieves the counters of the transport.
+
+	The number of bytes written is only up to date once the transport has been flushed.
+
+	\param[out] stats	The counters
+	*/
+	virtual void getStats(PxPvdAsyncFileTransportStats& stats) const = 0;
+
+protected:
+	virtual ~PxPvdAsyncFileTransport()
+	{
+	}
+};
+
+/**
+	\brief Create an asynchronous file transport.
+	\param desc description of the transport.
+	\return The new transport, or NULL if the descriptor is invalid.
+
+	@see PxPvdAsyncFileTransportDesc
+*/
+PX_C_EXPORT PxPvdAsyncFileTransport* PX_CALL_CONV PxDefaultPvdAsyncFileTransportCreate(const PxPvdAsyncFileTransportDesc& desc);
+
+/**
+	\brief Converts a capture written with PxPvdAsyncFileTransportFlag::eCOMPRESS to a regular PVD capture.
+	\param srcName path of the compressed capture.
+	\param dstName path of the capture to write.
+	\return True on success, false if a file cannot be opened or the compressed capture is invalid or truncated.
+*/
+PX_C_EXPORT bool PX_CALL_CONV PxDecompressPvdCapture(const char* srcName, const char* dstName);
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+/** @} */
+#endif
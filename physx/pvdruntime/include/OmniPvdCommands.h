@@ -45,7 +45,8 @@ struct OmniPvdCommandEnum
 		eOmniPvdCreateObject,
 		eOmniPvdDestroyObject,
 		eOmniPvdStartFrame,
-		eOmniPvdStopFrame
+		eOmniPvdStopFrame,
+		eOmniPvdSetBulkAttribute
 	};
 };
 
@@ -30,12 +30,15 @@
 #define OMNI_PVD_DEFINES_H
 
 #define OMNI_PVD_VERSION_MAJOR 0
-#define OMNI_PVD_VERSION_MINOR 3
+#define OMNI_PVD_VERSION_MINOR 4
 #define OMNI_PVD_VERSION_PATCH 0
 
 ////////////////////////////////////////////////////////////////////////////////
 // Versions so far : (major, minor, patch), top one is newest
 //
+// [0, 4,  0]
+//   adds the bulk attribute command, setting the same attribute of many objects at once
+//   backwards compatible with [0, 3, 0], [0, 2, 0] and [0, 1, 42]
 // [0, 3,  0]
 //   writes/read out the base class handle in the class registration call
 //   backwards compatible with [0, 2, 0] and [0, 1, 42]
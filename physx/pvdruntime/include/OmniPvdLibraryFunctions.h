@@ -51,4 +51,6 @@ typedef void (OMNI_PVD_CALL *destroyOmniPvdFileWriteStreamFp)(OmniPvdFileWriteSt
 typedef OmniPvdMemoryStream* (OMNI_PVD_CALL *createOmniPvdMemoryStreamFp)();
 typedef void (OMNI_PVD_CALL *destroyOmniPvdMemoryStreamFp)(OmniPvdMemoryStream *memoryStream);
 
+typedef void (OMNI_PVD_CALL *getOmniPvdVersionFp)(OmniPvdVersionType& major, OmniPvdVersionType& minor, OmniPvdVersionType& patch);
+
 #endif
@@ -46,6 +46,8 @@ public:
 	~OmniPvdLoader();
 	bool loadOmniPvd(const char *libFile);
 	void unloadOmniPvd();
+	void getOmniPvdVersion(OmniPvdVersionType& major, OmniPvdVersionType& minor, OmniPvdVersionType& patch) const;
+	bool supportsBulkAttributes() const;
 	void* mLibraryHandle;	
 	
 	createOmniPvdWriterFp mCreateOmniPvdWriter;
@@ -62,6 +64,9 @@ public:
 
 	createOmniPvdMemoryStreamFp mCreateOmniPvdMemoryStream;
 	destroyOmniPvdMemoryStreamFp mDestroyOmniPvdMemoryStream;
+
+	// Optional, runtimes older than version 0.4.0 do not export it
+	getOmniPvdVersionFp mGetOmniPvdVersion;
 };
 
 inline OmniPvdLoader::OmniPvdLoader()
@@ -82,6 +87,8 @@ inline OmniPvdLoader::OmniPvdLoader()
 
 	mCreateOmniPvdMemoryStream = 0;
 	mDestroyOmniPvdMemoryStream = 0;
+
+	mGetOmniPvdVersion = 0;
 }
 
 inline OmniPvdLoader::~OmniPvdLoader()
@@ -115,6 +122,8 @@ inline bool OmniPvdLoader::loadOmniPvd(const char *libFile)
 
 		mCreateOmniPvdMemoryStream = (createOmniPvdMemoryStreamFp)GetProcAddress((HINSTANCE)mLibraryHandle, "createOmniPvdMemoryStream");
 		mDestroyOmniPvdMemoryStream = (destroyOmniPvdMemoryStreamFp)GetProcAddress((HINSTANCE)mLibraryHandle, "destroyOmniPvdMemoryStream");
+
+		mGetOmniPvdVersion = (getOmniPvdVersionFp)GetProcAddress((HINSTANCE)mLibraryHandle, "getOmniPvdVersion");
 #elif defined(__linux__)
 		mCreateOmniPvdWriter = (createOmniPvdWriterFp)dlsym(mLibraryHandle, "createOmniPvdWriter");
 		mDestroyOmniPvdWriter = (destroyOmniPvdWriterFp)dlsym(mLibraryHandle, "destroyOmniPvdWriter");
@@ -131,6 +140,8 @@ inline bool OmniPvdLoader::loadOmniPvd(const char *libFile)
 		mCreateOmniPvdMemoryStream = (createOmniPvdMemoryStreamFp)dlsym(mLibraryHandle, "createOmniPvdMemoryStream");
 		mDestroyOmniPvdMemoryStream = (destroyOmniPvdMemoryStreamFp)dlsym(mLibraryHandle, "destroyOmniPvdMemoryStream");
 
+		mGetOmniPvdVersion = (getOmniPvdVersionFp)dlsym(mLibraryHandle, "getOmniPvdVersion");
+
 #endif
 
 		if ((!mCreateOmniPvdWriter)           ||
@@ -171,6 +182,31 @@ inline void OmniPvdLoader::unloadOmniPvd()
 #endif		
 		mLibraryHandle = 0;
 	}
+	mGetOmniPvdVersion = 0;
+}
+
+inline void OmniPvdLoader::getOmniPvdVersion(OmniPvdVersionType& major, OmniPvdVersionType& minor, OmniPvdVersionType& patch) const
+{
+	if (mGetOmniPvdVersion)
+	{
+		mGetOmniPvdVersion(major, minor, patch);
+	}
+	else
+	{
+		// The version query was added in 0.4.0, the runtime is 0.3.0 or older
+		major = 0;
+		minor = 3;
+		patch = 0;
+	}
+}
+
+// OmniPvdWriter::setBulkAttributeShallow() was added in 0.4.0, calling it on an older runtime would go through a
+// slot of the vtable that does not exist.
+inline bool OmniPvdLoader::supportsBulkAttributes() const
+{
+	OmniPvdVersionType major, minor, patch;
+	getOmniPvdVersion(major, minor, patch);
+	return (major > 0) || (minor >= 4);
 }
 
 #endif
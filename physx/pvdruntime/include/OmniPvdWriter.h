@@ -320,6 +320,24 @@ public:
 	 */
 	virtual void OMNI_PVD_CALL stopFrame(const OmniPvdContextHandle contextHandle, const uint64_t timeStamp) = 0;
 
+	/**
+	 * @brief Sets the value of the same attribute for many objects at once.
+	 *
+	 * Equivalent to calling setAttributeShallow() once per object, but the context and attribute handles are only
+	 * written once, which makes the stream considerably smaller when many objects get updated every frame. A reader
+	 * reports the command as a sequence of individual set attribute commands.
+	 *
+	 * @param contextHandle The user-defined context handle for grouping objects
+	 * @param attributeHandle The handle from the registerAttribute() call
+	 * @param objectHandles The user-defined unique handles of the objects
+	 * @param nbrObjects The number of objects
+	 * @param data The pointer to the data, nbrBytesPerObject bytes per object, in the order of the object handles
+	 * @param nbrBytesPerObject The number of bytes to be written per object
+	 *
+	 * @see OmniPvdWriter::setAttributeShallow()
+	 */
+	virtual void OMNI_PVD_CALL setBulkAttributeShallow(const OmniPvdContextHandle contextHandle, const OmniPvdAttributeHandle attributeHandle, const OmniPvdObjectHandle* objectHandles, const uint32_t nbrObjects, const uint8_t* data, const uint32_t nbrBytesPerObject) = 0;
+
 	
 };
 
@@ -33,6 +33,16 @@ OmniPvdFileWriteStreamImpl::OmniPvdFileWriteStreamImpl()
 	mFileName = 0;
 	mFileWasOpened = false;
 	mPFile = 0;
+	for (uint32_t i = 0; i < NBR_BUFFERS; i++)
+	{
+		mBuffers[i] = 0;
+		mBufferSizes[i] = 0;
+	}
+	mFillIndex = 0;
+	mWriteIndex = 0;
+	mNbrQueued = 0;
+	mQuitWriter = false;
+	mWriteFailed = false;
 }
 
 OmniPvdFileWriteStreamImpl::~OmniPvdFileWriteStreamImpl()
@@ -77,36 +87,155 @@ bool OMNI_PVD_CALL OmniPvdFileWriteStreamImpl::openFile()
 	}
 #else
 	mPFile = fopen(mFileName, "wb");
+	if (!mPFile)
+	{
+		mFileWasOpened = false;
+	}
 #endif
+	if (mFileWasOpened)
+	{
+		for (uint32_t i = 0; i < NBR_BUFFERS; i++)
+		{
+			mBuffers[i] = new uint8_t[BUFFER_SIZE];
+			mBufferSizes[i] = 0;
+		}
+		mFillIndex = 0;
+		mWriteIndex = 0;
+		mNbrQueued = 0;
+		mQuitWriter = false;
+		mWriteFailed = false;
+		mWriterThread = std::thread(&OmniPvdFileWriteStreamImpl::writerLoop, this);
+	}
 	return mFileWasOpened;
 }
 
 bool OMNI_PVD_CALL OmniPvdFileWriteStreamImpl::closeFile()
 {
+	bool success = true;
 	if (mFileWasOpened)
 	{
-		fclose(mPFile);
+		success = flush();
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mQuitWriter = true;
+		}
+		mQueuedCondition.notify_one();
+		mWriterThread.join();
+		if (fclose(mPFile) != 0)
+		{
+			success = false;
+		}
+		mPFile = 0;
+		for (uint32_t i = 0; i < NBR_BUFFERS; i++)
+		{
+			delete[] mBuffers[i];
+			mBuffers[i] = 0;
+		}
 		mFileWasOpened = false;
 	}
-	return true;
+	return success;
 }
 
 uint64_t OMNI_PVD_CALL OmniPvdFileWriteStreamImpl::writeBytes(const uint8_t *bytes, const uint64_t nbrBytes)
 {
-	size_t result = 0;
-	if (mFileWasOpened)
+	uint64_t result = 0;
+	if (mFileWasOpened && !mWriteFailed)
 	{
-		result = fwrite(bytes, 1, nbrBytes, mPFile);
-		result++;
+		uint64_t nbrBytesLeft = nbrBytes;
+		while (nbrBytesLeft)
+		{
+			uint64_t& fillSize = mBufferSizes[mFillIndex];
+			uint64_t nbrBytesToCopy = BUFFER_SIZE - fillSize;
+			if (nbrBytesToCopy > nbrBytesLeft)
+			{
+				nbrBytesToCopy = nbrBytesLeft;
+			}
+			memcpy(mBuffers[mFillIndex] + fillSize, bytes, nbrBytesToCopy);
+			fillSize += nbrBytesToCopy;
+			bytes += nbrBytesToCopy;
+			nbrBytesLeft -= nbrBytesToCopy;
+			if (fillSize == BUFFER_SIZE)
+			{
+				submitBuffer();
+			}
+		}
+		result = nbrBytes;
 	}
 	return result;
 }
 
 bool OMNI_PVD_CALL OmniPvdFileWriteStreamImpl::flush()
 {
+	if (mFileWasOpened)
+	{
+		if (mBufferSizes[mFillIndex])
+		{
+			submitBuffer();
+		}
+		waitForWriter();
+		if (!mWriteFailed && (fflush(mPFile) != 0))
+		{
+			mWriteFailed = true;
+		}
+		return !mWriteFailed;
+	}
 	return true;
 }
 
+void OmniPvdFileWriteStreamImpl::submitBuffer()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	mNbrQueued++;
+	mQueuedCondition.notify_one();
+	mFillIndex = (mFillIndex + 1) % NBR_BUFFERS;
+	////////////////////////////////////////////////////////////////////////////////
+	// Only wait when the next buffer to fill is still queued for writing
+	////////////////////////////////////////////////////////////////////////////////
+	while (mNbrQueued == NBR_BUFFERS)
+	{
+		mWrittenCondition.wait(lock);
+	}
+}
+
+void OmniPvdFileWriteStreamImpl::waitForWriter()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	while (mNbrQueued)
+	{
+		mWrittenCondition.wait(lock);
+	}
+}
+
+void OmniPvdFileWriteStreamImpl::writerLoop()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	for (;;)
+	{
+		while (!mNbrQueued && !mQuitWriter)
+		{
+			mQueuedCondition.wait(lock);
+		}
+		if (!mNbrQueued)
+		{
+			break;
+		}
+		const uint32_t index = mWriteIndex;
+		lock.unlock();
+		////////////////////////////////////////////////////////////////////////////////
+		// After a failure the remaining buffers are dropped, the file is unusable anyway
+		////////////////////////////////////////////////////////////////////////////////
+		if (!mWriteFailed && (fwrite(mBuffers[index], 1, mBufferSizes[index], mPFile) != mBufferSizes[index]))
+		{
+			mWriteFailed = true;
+		}
+		mBufferSizes[index] = 0;
+		lock.lock();
+		mWriteIndex = (mWriteIndex + 1) % NBR_BUFFERS;
+		mNbrQueued--;
+		mWrittenCondition.notify_all();
+	}
+}
+
 bool OMNI_PVD_CALL OmniPvdFileWriteStreamImpl::openStream()
 {
 	return openFile();
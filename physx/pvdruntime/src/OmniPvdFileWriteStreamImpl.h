@@ -33,6 +33,10 @@
 #include <stdarg.h>
 #include <stdio.h>
 #include <string.h>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 
 class OmniPvdFileWriteStreamImpl : public OmniPvdFileWriteStream {
 public:
@@ -46,9 +50,40 @@ public:
 	bool OMNI_PVD_CALL openStream();
 	bool OMNI_PVD_CALL closeStream();
 
+	// Internal helpers
+	void submitBuffer();
+	void waitForWriter();
+	void writerLoop();
+
 	char *mFileName;
 	bool mFileWasOpened;
 	FILE *mPFile;
+
+	////////////////////////////////////////////////////////////////////////////////
+	// The bytes are collected in a ring of buffers. Full buffers are written to the
+	// file by a background thread, so that the caller only waits for the disk when
+	// all the buffers are still queued.
+	////////////////////////////////////////////////////////////////////////////////
+	static const uint64_t BUFFER_SIZE = 1 << 20;
+	static const uint32_t NBR_BUFFERS = 4;
+
+	uint8_t *mBuffers[NBR_BUFFERS];
+	uint64_t mBufferSizes[NBR_BUFFERS];
+	uint32_t mFillIndex;
+	uint32_t mWriteIndex;
+	uint32_t mNbrQueued;
+	bool mQuitWriter;
+
+	////////////////////////////////////////////////////////////////////////////////
+	// Set by the writer thread when fwrite fails. From then on nothing more is
+	// written, writeBytes() returns 0 and flush() and closeFile() return false.
+	////////////////////////////////////////////////////////////////////////////////
+	std::atomic<bool> mWriteFailed;
+
+	std::thread mWriterThread;
+	std::mutex mMutex;
+	std::condition_variable mQueuedCondition;
+	std::condition_variable mWrittenCondition;
 };
 
 #endif
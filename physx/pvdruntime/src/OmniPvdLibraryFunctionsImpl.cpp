@@ -87,3 +87,10 @@ OMNI_PVD_EXPORT void OMNI_PVD_CALL destroyOmniPvdMemoryStream(OmniPvdMemoryStrea
 	OmniPvdMemoryStreamImpl *impl = (OmniPvdMemoryStreamImpl*)memoryStream;
 	delete impl;
 }
+
+OMNI_PVD_EXPORT void OMNI_PVD_CALL getOmniPvdVersion(OmniPvdVersionType& major, OmniPvdVersionType& minor, OmniPvdVersionType& patch)
+{
+	major = OMNI_PVD_VERSION_MAJOR;
+	minor = OMNI_PVD_VERSION_MINOR;
+	patch = OMNI_PVD_VERSION_PATCH;
+}
@@ -29,6 +29,7 @@
 #include "OmniPvdReaderImpl.h"
 
 #include <inttypes.h>
+#include <string.h>
 
 OmniPvdReaderImpl::OmniPvdReaderImpl()
 {
@@ -39,6 +40,12 @@ OmniPvdReaderImpl::OmniPvdReaderImpl()
 	mDataBuffer = 0;
 	mDataBuffAllocatedLen = 0;
 	mCmdAttributeDataPtr = 0;
+	mBulkBuffer = 0;
+	mBulkBuffAllocatedLen = 0;
+	mBulkAttributeHandle = 0;
+	mBulkNbrBytesPerObject = 0;
+	mBulkNbrObjects = 0;
+	mBulkNextObject = 0;
 	mIsReadingStarted = false;
 	mReadBaseClassHandle = 1;
 }
@@ -49,6 +56,9 @@ OmniPvdReaderImpl::~OmniPvdReaderImpl()
 	delete[] mDataBuffer;
 	mDataBuffer = 0;
 	mDataBuffAllocatedLen = 0;
+	delete[] mBulkBuffer;
+	mBulkBuffer = 0;
+	mBulkBuffAllocatedLen = 0;
 }
 
 void OMNI_PVD_CALL OmniPvdReaderImpl::setLogFunction(OmniPvdLogFunction logFunction)
@@ -129,6 +139,11 @@ OmniPvdCommandEnum::Enum OMNI_PVD_CALL OmniPvdReaderImpl::getNextCommand()
 			return OmniPvdCommandEnum::eOmniPvdInvalid;
 		}
 	}
+	if (mBulkNextObject < mBulkNbrObjects)
+	{
+		nextBulkElement();
+		return mCmdType;
+	}
 	mCmdType = OmniPvdCommandEnum::eOmniPvdInvalid;
 	if (mStream) {
 		unsigned char command;
@@ -287,6 +302,26 @@ OmniPvdCommandEnum::Enum OMNI_PVD_CALL OmniPvdReaderImpl::getNextCommand()
 					mLog.outputLine("[parser] stop frame (contextHandle: %llu, timeStamp: %llu)\n", static_cast<unsigned long long>(mCmdContextHandle), static_cast<unsigned long long>(mCmdFrameTimeStop));
 				}
 				break;
+				case OmniPvdCommandEnum::eOmniPvdSetBulkAttribute:
+				{
+					uint32_t nbrObjects = 0;
+					mStream->readBytes((unsigned char*)&mCmdContextHandle, sizeof(OmniPvdContextHandle));
+					mStream->readBytes((unsigned char*)&mBulkAttributeHandle, sizeof(OmniPvdAttributeHandle));
+					mStream->readBytes((unsigned char*)&mBulkNbrBytesPerObject, sizeof(uint32_t));
+					mStream->readBytes((unsigned char*)&nbrObjects, sizeof(uint32_t));
+					mLog.outputLine("[parser] set bulk attribute (contextHandle:%llu, attributeHandle: %llu, nbrObjects: %llu, dataLen: %llu)\n", static_cast<unsigned long long>(mCmdContextHandle), static_cast<unsigned long long>(mBulkAttributeHandle), static_cast<unsigned long long>(nbrObjects), static_cast<unsigned long long>(mBulkNbrBytesPerObject));
+					////////////////////////////////////////////////////////////////////////////////
+					// The object handles are followed by the data of all objects
+					////////////////////////////////////////////////////////////////////////////////
+					const uint64_t byteLen = uint64_t(nbrObjects) * (sizeof(OmniPvdObjectHandle) + mBulkNbrBytesPerObject);
+					if (nbrObjects && readBulkDataFromStream(byteLen))
+					{
+						mBulkNbrObjects = nbrObjects;
+						mBulkNextObject = 0;
+						nextBulkElement();
+					}
+				}
+				break;
 				default:
 				{
 				}
@@ -410,7 +445,28 @@ void OmniPvdReaderImpl::readLongDataFromStream(uint32_t streamByteLen) {
 		delete[] mDataBuffer;
 		mDataBuffAllocatedLen = (uint32_t)(streamByteLen * 1.3f);
 		mDataBuffer = new uint8_t[mDataBuffAllocatedLen];
-		mCmdAttributeDataPtr = mDataBuffer;
 	}
+	mCmdAttributeDataPtr = mDataBuffer;
 	mStream->readBytes(mCmdAttributeDataPtr, streamByteLen);
 }
+
+bool OmniPvdReaderImpl::readBulkDataFromStream(uint64_t streamByteLen) {
+	if (streamByteLen > mBulkBuffAllocatedLen) {
+		delete[] mBulkBuffer;
+		mBulkBuffAllocatedLen = (uint64_t)(streamByteLen * 1.3f);
+		mBulkBuffer = new uint8_t[mBulkBuffAllocatedLen];
+	}
+	return mStream->readBytes(mBulkBuffer, streamByteLen) == streamByteLen;
+}
+
+void OmniPvdReaderImpl::nextBulkElement() {
+	const uint8_t* handles = mBulkBuffer;
+	const uint32_t index = mBulkNextObject++;
+	mCmdType = OmniPvdCommandEnum::eOmniPvdSetAttribute;
+	memcpy(&mCmdObjectHandle, handles + index * sizeof(OmniPvdObjectHandle), sizeof(OmniPvdObjectHandle));
+	mCmdAttributeHandle = mBulkAttributeHandle;
+	mCmdAttributeHandleStack[0] = mBulkAttributeHandle;
+	mCmdAttributeHandleDepth = 1;
+	mCmdAttributeDataLen = mBulkNbrBytesPerObject;
+	mCmdAttributeDataPtr = mBulkBuffer + uint64_t(mBulkNbrObjects) * sizeof(OmniPvdObjectHandle) + uint64_t(index) * mBulkNbrBytesPerObject;
+}
@@ -75,6 +75,8 @@ public:
 
 	// Internal helper
 	void readLongDataFromStream(uint32_t streamByteLen);
+	bool readBulkDataFromStream(uint64_t streamByteLen);
+	void nextBulkElement();
 
 	OmniPvdLog mLog;
 
@@ -125,6 +127,16 @@ public:
 	uint8_t *mDataBuffer;
 	uint32_t mDataBuffAllocatedLen;
 
+	////////////////////////////////////////////////////////////////////////////////
+	// A bulk attribute command is handed out as one set attribute command per object
+	////////////////////////////////////////////////////////////////////////////////
+	uint8_t *mBulkBuffer;
+	uint64_t mBulkBuffAllocatedLen;
+	OmniPvdAttributeHandle mBulkAttributeHandle;
+	uint32_t mBulkNbrBytesPerObject;
+	uint32_t mBulkNbrObjects;
+	uint32_t mBulkNextObject;
+
 	bool mIsReadingStarted;
 	uint8_t mReadBaseClassHandle;
 };
@@ -359,3 +359,19 @@ void OMNI_PVD_CALL OmniPvdWriterImpl::stopFrame(const OmniPvdContextHandle conte
 		mStream->writeBytes((unsigned char*)&timeStamp, sizeof(uint64_t));
 	}
 }
+
+void OMNI_PVD_CALL OmniPvdWriterImpl::setBulkAttributeShallow(const OmniPvdContextHandle contextHandle, const OmniPvdAttributeHandle attributeHandle, const OmniPvdObjectHandle* objectHandles, const uint32_t nbrObjects, const uint8_t* data, const uint32_t nbrBytesPerObject)
+{
+	setVersionHelper();
+	if (mStream && nbrObjects)
+	{
+		unsigned char command = OmniPvdCommandEnum::eOmniPvdSetBulkAttribute;
+		mStream->writeBytes(&command, sizeof(uint8_t));
+		mStream->writeBytes((unsigned char*)&contextHandle, sizeof(OmniPvdContextHandle));
+		mStream->writeBytes((unsigned char*)&attributeHandle, sizeof(OmniPvdAttributeHandle));
+		mStream->writeBytes((unsigned char*)&nbrBytesPerObject, sizeof(uint32_t));
+		mStream->writeBytes((unsigned char*)&nbrObjects, sizeof(uint32_t));
+		mStream->writeBytes((unsigned char*)objectHandles, sizeof(OmniPvdObjectHandle) * nbrObjects);
+		mStream->writeBytes((unsigned char*)data, nbrBytesPerObject * nbrObjects);
+	}
+}
@@ -61,6 +61,8 @@ public:
 	void OMNI_PVD_CALL destroyObject(const OmniPvdContextHandle contextHandle, const OmniPvdObjectHandle objectHandle);
 	void OMNI_PVD_CALL startFrame(const OmniPvdContextHandle contextHandle, const uint64_t timeStamp);
 	void OMNI_PVD_CALL stopFrame(const OmniPvdContextHandle contextHandle, const uint64_t timeStamp);
+
+	void OMNI_PVD_CALL setBulkAttributeShallow(const OmniPvdContextHandle contextHandle, const OmniPvdAttributeHandle attributeHandle, const OmniPvdObjectHandle* objectHandles, const uint32_t nbrObjects, const uint8_t* data, const uint32_t nbrBytesPerObject);
 	
 	bool mIsFirstWrite;
 	OmniPvdLog mLog;
@@ -0,0 +1,206 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet measures the build time of PxBVH and PxPruningStructure
+// objects, with and without a CPU dispatcher.
+//
+// The same BVH is built on the calling thread and on multiple threads, for
+// each build strategy. The snippet prints the build times and runs the same
+// set of raycasts against each BVH, to show that multi-threaded builds give
+// trees of the same quality.
+// ****************************************************************************
+
+#include <ctype.h>
+#include "PxPhysicsAPI.h"
+#include "foundation/PxArray.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxPhysics*				gPhysics	= NULL;
+static PxDefaultCpuDispatcher*	gDispatcher = NULL;
+
+static const PxU32	gNbBounds		= 1000000;
+static const PxU32	gNbActors		= 200000;
+static const PxU32	gNbRaycasts		= 100000;
+static const float	gWorldSize		= 1000.0f;
+
+static float randomFloat()
+{
+	return float(rand())/float(RAND_MAX);
+}
+
+static PxVec3 randomPoint()
+{
+	return PxVec3(randomFloat(), randomFloat(), randomFloat()) * gWorldSize;
+}
+
+static void createRandomBounds(PxArray<PxBounds3>& bounds, PxU32 nb)
+{
+	bounds.resize(nb);
+	for(PxU32 i=0;i<nb;i++)
+	{
+		const PxVec3 extents = PxVec3(randomFloat(), randomFloat(), randomFloat()) * 2.0f + PxVec3(0.1f);
+		bounds[i] = PxBounds3::centerExtents(randomPoint(), extents);
+	}
+}
+
+namespace
+{
+	class CountHits : public PxBVH::RaycastCallback
+	{
+		public:
+						CountHits() : mNbHits(0)	{}
+
+		virtual bool	reportHit(PxU32, float&)
+		{
+			mNbHits++;
+			return true;
+		}
+
+		PxU32	mNbHits;
+	};
+}
+
+static void raycastBVH(const PxBVH& bvh, const PxArray<PxVec3>& origins, const PxArray<PxVec3>& dirs)
+{
+	const PxU64 startTime = SnippetUtils::getCurrentTimeCounterValue();
+
+	CountHits cb;
+	const PxU32 nb = origins.size();
+	for(PxU32 i=0;i<nb;i++)
+		bvh.raycast(origins[i], dirs[i], gWorldSize, cb);
+
+	const PxU64 stopTime = SnippetUtils::getCurrentTimeCounterValue();
+	printf("\t\t %d raycasts: %f ms (%d hits)\n", nb, double(SnippetUtils::getElapsedTimeInMilliseconds(stopTime - startTime)), cb.mNbHits);
+}
+
+static void buildBVH(const PxArray<PxBounds3>& bounds, PxBVHBuildStrategy::Enum strategy, PxCpuDispatcher* dispatcher, const PxArray<PxVec3>& origins, const PxArray<PxVec3>& dirs)
+{
+	PxBVHDesc bvhDesc;
+	bvhDesc.bounds.count = bounds.size();
+	bvhDesc.bounds.data = bounds.begin();
+	bvhDesc.bounds.stride = sizeof(PxBounds3);
+	bvhDesc.buildStrategy = strategy;
+	bvhDesc.dispatcher = dispatcher;
+
+	const PxU64 startTime = SnippetUtils::getCurrentTimeCounterValue();
+	PxBVH* bvh = PxCreateBVH(bvhDesc);
+	const PxU64 stopTime = SnippetUtils::getCurrentTimeCounterValue();
+
+	const char* strategyName = strategy==PxBVHBuildStrategy::eFAST ? "eFAST" : strategy==PxBVHBuildStrategy::eDEFAULT ? "eDEFAULT" : "eSAH";
+	printf("\t -----------------------------------------------\n");
+	printf("\t PxBVH, %d bounds, %s, %s\n", bvhDesc.bounds.count, strategyName, dispatcher ? "multi-threaded" : "single-threaded");
+	printf("\t\t Build time: %f ms\n", double(SnippetUtils::getElapsedTimeInMilliseconds(stopTime - startTime)));
+
+	if(bvh)
+	{
+		raycastBVH(*bvh, origins, dirs);
+		bvh->release();
+	}
+}
+
+static void buildPruningStructure(PxCpuDispatcher* dispatcher)
+{
+	PxMaterial* material = gPhysics->createMaterial(0.5f, 0.5f, 0.5f);
+
+	PxArray<PxRigidActor*> actors(gNbActors);
+	for(PxU32 i=0;i<gNbActors;i++)
+		actors[i] = PxCreateStatic(*gPhysics, PxTransform(randomPoint()), PxSphereGeometry(0.1f + randomFloat()), *material);
+
+	const PxU64 startTime = SnippetUtils::getCurrentTimeCounterValue();
+	PxPruningStructure* ps = dispatcher ? gPhysics->createPruningStructure(actors.begin(), gNbActors, *dispatcher) : gPhysics->createPruningStructure(actors.begin(), gNbActors);
+	const PxU64 stopTime = SnippetUtils::getCurrentTimeCounterValue();
+
+	printf("\t -----------------------------------------------\n");
+	printf("\t PxPruningStructure, %d actors, %s\n", gNbActors, dispatcher ? "multi-threaded" : "single-threaded");
+	printf("\t\t Build time: %f ms\n", double(SnippetUtils::getElapsedTimeInMilliseconds(stopTime - startTime)));
+
+	PX_RELEASE(ps);
+	for(PxU32 i=0;i<gNbActors;i++)
+		actors[i]->release();
+	material->release();
+}
+
+void initPhysics()
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale(), true);
+
+	const PxU32 nbThreads = PxMax<PxU32>(2, SnippetUtils::getNbPhysicalCores());
+	gDispatcher = PxDefaultCpuDispatcherCreate(nbThreads);
+	printf("Using %d worker threads for multi-threaded builds\n", nbThreads);
+}
+
+void cleanupPhysics()
+{
+	PX_RELEASE(gDispatcher);
+	PX_RELEASE(gPhysics);
+	PX_RELEASE(gFoundation);
+
+	printf("SnippetBVHBuild done.\n");
+}
+
+void runBenchmarks()
+{
+	srand(42);
+
+	PxArray<PxBounds3> bounds;
+	createRandomBounds(bounds, gNbBounds);
+
+	PxArray<PxVec3> origins(gNbRaycasts);
+	PxArray<PxVec3> dirs(gNbRaycasts);
+	for(PxU32 i=0;i<gNbRaycasts;i++)
+	{
+		origins[i] = randomPoint();
+		dirs[i] = (PxVec3(randomFloat(), randomFloat(), randomFloat()) - PxVec3(0.5f)).getNormalized();
+	}
+
+	const PxBVHBuildStrategy::Enum strategies[] = { PxBVHBuildStrategy::eDEFAULT, PxBVHBuildStrategy::eSAH };
+	for(PxU32 i=0;i<2;i++)
+	{
+		buildBVH(bounds, strategies[i], NULL, origins, dirs);
+		buildBVH(bounds, strategies[i], gDispatcher, origins, dirs);
+	}
+
+	buildPruningStructure(NULL);
+	buildPruningStructure(gDispatcher);
+}
+
+int snippetMain(int, const char*const*)
+{
+	initPhysics();
+	runBenchmarks();
+	cleanupPhysics();
+
+	return 0;
+}
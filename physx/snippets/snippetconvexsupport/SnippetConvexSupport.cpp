@@ -0,0 +1,246 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+// ****************************************************************************
+// This snippet measures how the support mapping of convex meshes affects
+// convex-convex contact generation (PCM), for hulls of increasing size.
+//
+// Each hull is cooked twice. Below PxCookingParams::gaussMapLimit vertices the
+// support mapping is a SIMD brute-force search over all vertices. Above it,
+// cooking adds a cube-map and vertex adjacency data, and the support mapping
+// hill-climbs from a cube-map sample. The snippet generates contacts with the
+// immediate mode API for the same touching pairs, with both versions, and
+// reports the time spent. Persistent caches are either kept between frames or
+// discarded each frame, the latter forcing the full contact generation path.
+// Use it to pick the gaussMapLimit that suits your hulls and platform.
+// ****************************************************************************
+
+#include "PxPhysicsAPI.h"
+#include "PxImmediateMode.h"
+#include "foundation/PxArray.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxPhysics*				gPhysics = NULL;
+
+static const PxU32	gNbPairs		= 2000;
+static const PxU32	gNbFrames		= 20;
+static const PxU32	gCacheSize		= 1024;	// Bytes of persistent cache memory per pair
+
+namespace
+{
+	class Timer
+	{
+		public:
+			Timer() : mStartTime(SnippetUtils::getCurrentTimeCounterValue())	{}
+
+			float	getElapsedTime()	const
+			{
+				const PxU64 stopTime = SnippetUtils::getCurrentTimeCounterValue();
+				return SnippetUtils::getElapsedTimeInMilliseconds(stopTime - mStartTime);
+			}
+		private:
+			PxU64	mStartTime;
+	};
+
+	// Persistent caches of a frame must remain valid during the next frame, so we alternate between two buffers
+	class CacheAllocator : public PxCacheAllocator
+	{
+		public:
+			CacheAllocator() : mCurrent(0), mUsed(0)
+			{
+				mBuffers[0].resize(gNbPairs*gCacheSize);
+				mBuffers[1].resize(gNbPairs*gCacheSize);
+			}
+
+			void	nextFrame()
+			{
+				mCurrent ^= 1;
+				mUsed = 0;
+			}
+
+			virtual PxU8* allocateCacheData(const PxU32 byteSize)
+			{
+				const PxU32 size = (byteSize + 15) & ~15;
+				if(mUsed + size > mBuffers[mCurrent].size())
+					return NULL;
+				PxU8* data = mBuffers[mCurrent].begin() + mUsed;
+				mUsed += size;
+				return data;
+			}
+
+		private:
+			PxArray<PxU8>	mBuffers[2];
+			PxU32			mCurrent;
+			PxU32			mUsed;
+	};
+
+	class ContactCounter : public immediate::PxContactRecorder
+	{
+		public:
+			ContactCounter() : mNbContacts(0)	{}
+
+			virtual bool recordContacts(const PxContactPoint*, const PxU32 nbContacts, const PxU32)
+			{
+				mNbContacts += nbContacts;
+				return true;
+			}
+
+			PxU32	mNbContacts;
+	};
+
+	struct Pair
+	{
+		PxTransform	mPose0;
+		PxTransform	mPose1;
+		PxQuat		mSpin;
+	};
+}
+
+// Random points on an ellipsoid, so that most of them end up on the hull
+static void createPoints(PxArray<PxVec3>& points, PxU32 nbPoints)
+{
+	SnippetUtils::BasicRandom rnd(42);
+	points.resize(nbPoints);
+	for(PxU32 i=0;i<nbPoints;i++)
+	{
+		PxVec3 p(rnd.randomFloat(), rnd.randomFloat(), rnd.randomFloat());
+		p.normalize();
+		points[i] = PxVec3(p.x*0.5f, p.y*0.3f, p.z*0.4f);
+	}
+}
+
+static PxConvexMesh* createConvexMesh(const PxArray<PxVec3>& points, PxU32 vertexLimit, PxU32 gaussMapLimit)
+{
+	PxConvexMeshDesc convexDesc;
+	convexDesc.points.count		= points.size();
+	convexDesc.points.stride	= sizeof(PxVec3);
+	convexDesc.points.data		= points.begin();
+	convexDesc.flags			= PxConvexFlag::eCOMPUTE_CONVEX;
+	convexDesc.vertexLimit		= PxU16(vertexLimit);
+
+	PxCookingParams params(gPhysics->getTolerancesScale());
+	params.gaussMapLimit = gaussMapLimit;
+	return PxCreateConvexMesh(params, convexDesc, gPhysics->getPhysicsInsertionCallback());
+}
+
+// Pairs of hulls that touch or slightly overlap, each spinning a little around its own axis
+static void createPairs(PxArray<Pair>& pairs)
+{
+	SnippetUtils::BasicRandom rnd(42);
+	pairs.resize(gNbPairs);
+	for(PxU32 i=0;i<gNbPairs;i++)
+	{
+		PxVec3 dir(rnd.randomFloat(), rnd.randomFloat(), rnd.randomFloat());
+		dir.normalize();
+		pairs[i].mPose0 = PxTransform(PxVec3(PxReal(i)*10.0f, 0.0f, 0.0f), rnd.unitRandomQuat());
+		pairs[i].mPose1 = PxTransform(pairs[i].mPose0.p + dir*rnd.rand(0.5f, 0.7f), rnd.unitRandomQuat());
+		pairs[i].mSpin = PxQuat(0.01f, rnd.unitRandomPt().getNormalized());
+	}
+}
+
+static float runContactGeneration(PxConvexMesh* mesh, const PxArray<Pair>& pairsIn, bool persistentCaches, PxU32& nbContacts)
+{
+	const PxConvexMeshGeometry geom(mesh);
+	PxArray<Pair> pairs(pairsIn);
+	PxArray<PxCache> caches(gNbPairs);
+	CacheAllocator cacheAllocator;
+	ContactCounter counter;
+
+	const PxGeometry* geom0 = &geom;
+	const PxGeometry* geom1 = &geom;
+	const PxReal contactDistance = 0.04f;
+	const PxReal meshContactMargin = 0.01f;
+	const PxReal toleranceLength = gPhysics->getTolerancesScale().length;
+
+	Timer timer;
+	for(PxU32 frame=0;frame<gNbFrames;frame++)
+	{
+		cacheAllocator.nextFrame();
+		for(PxU32 i=0;i<gNbPairs;i++)
+		{
+			Pair& pair = pairs[i];
+			pair.mPose1.q = (pair.mPose1.q * pair.mSpin).getNormalized();
+			if(!persistentCaches)
+				caches[i] = PxCache();
+			immediate::PxGenerateContacts(&geom0, &geom1, &pair.mPose0, &pair.mPose1, &caches[i], 1, counter, contactDistance, meshContactMargin, toleranceLength, cacheAllocator);
+		}
+	}
+	nbContacts = counter.mNbContacts;
+	return timer.getElapsedTime();
+}
+
+static void runBenchmarks()
+{
+	printf("%d pairs, %d frames\n", gNbPairs, gNbFrames);
+
+	PxArray<PxVec3> points;
+	createPoints(points, 1024);
+
+	PxArray<Pair> pairs;
+	createPairs(pairs);
+
+	const PxU32 vertexLimits[] = { 16, 32, 64, 128, 255 };
+	for(PxU32 i=0;i<PX_ARRAY_SIZE(vertexLimits);i++)
+	{
+		// A gauss map limit above the number of vertices selects the brute-force support mapping, a limit below it
+		// selects hill-climbing.
+		PxConvexMesh* bruteForceMesh = createConvexMesh(points, vertexLimits[i], 256);
+		PxConvexMesh* hillClimbingMesh = createConvexMesh(points, vertexLimits[i], 4);
+
+		for(PxU32 j=0;j<2;j++)
+		{
+			const bool persistentCaches = j==0;
+			PxU32 nbContacts0, nbContacts1;
+			const float bruteForceTime = runContactGeneration(bruteForceMesh, pairs, persistentCaches, nbContacts0);
+			const float hillClimbingTime = runContactGeneration(hillClimbingMesh, pairs, persistentCaches, nbContacts1);
+			printf("%3d vertices, %s caches: %8.2f ms brute-force, %8.2f ms hill-climbing (%d / %d contacts)\n",
+				bruteForceMesh->getNbVertices(), persistentCaches ? "warm" : "cold", double(bruteForceTime), double(hillClimbingTime), nbContacts0, nbContacts1);
+		}
+
+		hillClimbingMesh->release();
+		bruteForceMesh->release();
+	}
+}
+
+int snippetMain(int, const char*const*)
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale());
+
+	runBenchmarks();
+
+	PX_RELEASE(gPhysics);
+	PX_RELEASE(gFoundation);
+	printf("SnippetConvexSupport done.\n");
+
+	return 0;
+}
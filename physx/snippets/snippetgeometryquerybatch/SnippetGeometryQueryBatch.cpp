@@ -0,0 +1,285 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet measures the batched PxGeometryQuery functions
+// (PxGeometryQuery::raycasts, PxGeometryQuery::overlaps and
+// PxGeometryQuery::pointDistances) against the equivalent loops of single
+// queries.
+//
+// For each geometry type the snippet runs the same random queries both ways,
+// prints the timings and checks that both versions return the same results.
+// ****************************************************************************
+
+#include "PxPhysicsAPI.h"
+#include "foundation/PxArray.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxConvexMesh*			gConvexMesh = NULL;
+static PxTriangleMesh*			gTriangleMesh = NULL;
+
+static const PxU32	gNbQueries	= 100000;
+static const PxU32	gNbRuns		= 10;
+
+namespace
+{
+	struct QueryData
+	{
+		PxArray<PxVec3>			mOrigins;
+		PxArray<PxVec3>			mDirs;
+		PxArray<PxTransform>	mPoses;
+	};
+
+	class Timer
+	{
+		public:
+			Timer() : mStartTime(SnippetUtils::getCurrentTimeCounterValue())	{}
+
+			float	getElapsedTime()	const
+			{
+				const PxU64 stopTime = SnippetUtils::getCurrentTimeCounterValue();
+				return SnippetUtils::getElapsedTimeInMilliseconds(stopTime - mStartTime);
+			}
+		private:
+			PxU64	mStartTime;
+	};
+}
+
+static void createQueries(QueryData& data, SnippetUtils::BasicRandom& rnd)
+{
+	data.mOrigins.resize(gNbQueries);
+	data.mDirs.resize(gNbQueries);
+	data.mPoses.resize(gNbQueries);
+	for(PxU32 i=0;i<gNbQueries;i++)
+	{
+		data.mOrigins[i] = rnd.unitRandomPt() * rnd.rand(0.5f, 5.0f);
+		// Aim the rays roughly at the query shape so that a good fraction of them hits
+		const PxVec3 target = rnd.unitRandomPt() * 0.5f;
+		data.mDirs[i] = (target - data.mOrigins[i]).getNormalized();
+		data.mPoses[i] = PxTransform(rnd.unitRandomPt() * rnd.rand(0.5f, 5.0f), rnd.unitRandomQuat());
+	}
+}
+
+static void printResults(const char* name, float singleTime, float batchTime, PxU32 nbPositives, bool identical)
+{
+	const float nbQueries = float(gNbQueries*gNbRuns);
+	printf("\t\t %-16s single: %8.3f ms (%6.2f Mq/s) | batch: %8.3f ms (%6.2f Mq/s) | x%.2f | %d positives | %s\n", name,
+		double(singleTime), double(nbQueries/(singleTime*1000.0f)), double(batchTime), double(nbQueries/(batchTime*1000.0f)),
+		double(singleTime/batchTime), nbPositives, identical ? "identical" : "DIFFERENT");
+}
+
+static void benchRaycasts(const QueryData& data, const PxGeometry& geom, const PxTransform& pose)
+{
+	const PxHitFlags hitFlags = PxHitFlag::eDEFAULT;
+	const PxReal maxDist = 10.0f;
+	PxArray<PxGeomRaycastHit> singleHits(gNbQueries);
+	PxArray<PxGeomRaycastHit> batchHits(gNbQueries);
+
+	PxU32 nbHits = 0;
+	Timer singleTimer;
+	for(PxU32 run=0;run<gNbRuns;run++)
+	{
+		nbHits = 0;
+		for(PxU32 i=0;i<gNbQueries;i++)
+		{
+			if(PxGeometryQuery::raycast(data.mOrigins[i], data.mDirs[i], geom, pose, maxDist, hitFlags, 1, &singleHits[i]))
+				nbHits++;
+			else
+				singleHits[i].distance = PX_MAX_F32;
+		}
+	}
+	const float singleTime = singleTimer.getElapsedTime();
+
+	PxU32 nbBatchHits = 0;
+	Timer batchTimer;
+	for(PxU32 run=0;run<gNbRuns;run++)
+		nbBatchHits = PxGeometryQuery::raycasts(gNbQueries, data.mOrigins.begin(), data.mDirs.begin(), geom, pose, maxDist, hitFlags, batchHits.begin(), sizeof(PxGeomRaycastHit));
+	const float batchTime = batchTimer.getElapsedTime();
+
+	bool identical = nbHits==nbBatchHits;
+	for(PxU32 i=0;i<gNbQueries && identical;i++)
+		identical = PxAbs(singleHits[i].distance - batchHits[i].distance) < 1e-3f;
+
+	printResults("raycasts", singleTime, batchTime, nbHits, identical);
+}
+
+static void benchOverlaps(const QueryData& data, const PxGeometry& queryGeom, const PxGeometry& geom, const PxTransform& pose)
+{
+	PxArray<bool> singleResults(gNbQueries);
+	PxArray<bool> batchResults(gNbQueries);
+
+	PxU32 nbOverlaps = 0;
+	Timer singleTimer;
+	for(PxU32 run=0;run<gNbRuns;run++)
+	{
+		nbOverlaps = 0;
+		for(PxU32 i=0;i<gNbQueries;i++)
+		{
+			singleResults[i] = PxGeometryQuery::overlap(queryGeom, data.mPoses[i], geom, pose);
+			if(singleResults[i])
+				nbOverlaps++;
+		}
+	}
+	const float singleTime = singleTimer.getElapsedTime();
+
+	PxU32 nbBatchOverlaps = 0;
+	Timer batchTimer;
+	for(PxU32 run=0;run<gNbRuns;run++)
+		nbBatchOverlaps = PxGeometryQuery::overlaps(gNbQueries, queryGeom, data.mPoses.begin(), geom, pose, batchResults.begin());
+	const float batchTime = batchTimer.getElapsedTime();
+
+	bool identical = nbOverlaps==nbBatchOverlaps;
+	for(PxU32 i=0;i<gNbQueries && identical;i++)
+		identical = singleResults[i]==batchResults[i];
+
+	const char* name = queryGeom.getType()==PxGeometryType::eSPHERE ? "sphere overlaps" : "box overlaps";
+	printResults(name, singleTime, batchTime, nbOverlaps, identical);
+}
+
+static void benchPointDistances(const QueryData& data, const PxGeometry& geom, const PxTransform& pose)
+{
+	PxArray<PxReal> singleDistances(gNbQueries);
+	PxArray<PxReal> batchDistances(gNbQueries);
+	PxArray<PxVec3> closestPoints(gNbQueries);
+
+	Timer singleTimer;
+	for(PxU32 run=0;run<gNbRuns;run++)
+	{
+		for(PxU32 i=0;i<gNbQueries;i++)
+			singleDistances[i] = PxGeometryQuery::pointDistance(data.mOrigins[i], geom, pose, &closestPoints[i]);
+	}
+	const float singleTime = singleTimer.getElapsedTime();
+
+	Timer batchTimer;
+	for(PxU32 run=0;run<gNbRuns;run++)
+		PxGeometryQuery::pointDistances(gNbQueries, data.mOrigins.begin(), geom, pose, batchDistances.begin(), closestPoints.begin());
+	const float batchTime = batchTimer.getElapsedTime();
+
+	PxU32 nbInside = 0;
+	bool identical = true;
+	for(PxU32 i=0;i<gNbQueries;i++)
+	{
+		if(singleDistances[i]==0.0f)
+			nbInside++;
+		if(PxAbs(singleDistances[i] - batchDistances[i]) > 1e-3f*PxMax(1.0f, singleDistances[i]))
+			identical = false;
+	}
+
+	printResults("point distances", singleTime, batchTime, nbInside, identical);
+}
+
+static void runBenchmarks()
+{
+	SnippetUtils::BasicRandom rnd(42);
+	QueryData data;
+	createQueries(data, rnd);
+
+	const PxSphereGeometry sphereGeom(1.5f);
+	const PxBoxGeometry boxGeom(1.0f, 0.5f, 2.0f);
+	const PxCapsuleGeometry capsuleGeom(0.75f, 1.5f);
+	const PxConvexMeshGeometry convexGeom(gConvexMesh);
+	const PxTriangleMeshGeometry meshGeom(gTriangleMesh, PxMeshScale(0.5f));
+
+	const PxGeometry* geoms[] = { &sphereGeom, &boxGeom, &capsuleGeom, &convexGeom, &meshGeom };
+	const char* names[] = { "Sphere", "Box", "Capsule", "Convex", "Triangle mesh" };
+
+	const PxTransform pose(PxVec3(0.1f, -0.2f, 0.3f), rnd.unitRandomQuat());
+	for(PxU32 i=0;i<5;i++)
+	{
+		const PxGeometry& geom = *geoms[i];
+		printf("\t -----------------------------------------------\n");
+		printf("\t %s: %d queries x %d runs\n", names[i], gNbQueries, gNbRuns);
+		benchRaycasts(data, geom, pose);
+		benchOverlaps(data, sphereGeom, geom, pose);
+		if(geom.getType()==PxGeometryType::eBOX)
+			benchOverlaps(data, boxGeom, geom, pose);
+		if(geom.getType()!=PxGeometryType::eTRIANGLEMESH)
+			benchPointDistances(data, geom, pose);
+	}
+}
+
+static void initPhysics()
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+
+	const PxTolerancesScale scale;
+	PxCookingParams params(scale);
+	params.midphaseDesc.setToDefault(PxMeshMidPhase::eBVH34);
+
+	{
+		PxVec3 points[2*16];
+		for(PxU32 i=0;i<16;i++)
+		{
+			const PxF32 cosTheta = PxCos(i*PxPi*2.0f/16.0f);
+			const PxF32 sinTheta = PxSin(i*PxPi*2.0f/16.0f);
+			points[2*i+0] = PxVec3(-1.5f, cosTheta, sinTheta);
+			points[2*i+1] = PxVec3(+1.5f, cosTheta, sinTheta);
+		}
+
+		PxConvexMeshDesc convexDesc;
+		convexDesc.points.count		= 32;
+		convexDesc.points.stride	= sizeof(PxVec3);
+		convexDesc.points.data		= points;
+		convexDesc.flags			= PxConvexFlag::eCOMPUTE_CONVEX;
+		gConvexMesh = PxCreateConvexMesh(params, convexDesc);
+	}
+
+	{
+		PxTriangleMeshDesc meshDesc;
+		meshDesc.points.count		= SnippetUtils::Bunny_getNbVerts();
+		meshDesc.points.stride		= sizeof(PxVec3);
+		meshDesc.points.data		= SnippetUtils::Bunny_getVerts();
+		meshDesc.triangles.count	= SnippetUtils::Bunny_getNbFaces();
+		meshDesc.triangles.stride	= sizeof(int)*3;
+		meshDesc.triangles.data		= SnippetUtils::Bunny_getFaces();
+		gTriangleMesh = PxCreateTriangleMesh(params, meshDesc);
+	}
+}
+
+static void cleanupPhysics()
+{
+	PX_RELEASE(gTriangleMesh);
+	PX_RELEASE(gConvexMesh);
+	PX_RELEASE(gFoundation);
+
+	printf("SnippetGeometryQueryBatch done.\n");
+}
+
+int snippetMain(int, const char*const*)
+{
+	initPhysics();
+	runBenchmarks();
+	cleanupPhysics();
+
+	return 0;
+}
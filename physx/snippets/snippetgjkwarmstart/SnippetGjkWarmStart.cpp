@@ -0,0 +1,275 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet illustrates how to warm-start repeated GJK queries with
+// PxGjkQuery::Cache.
+//
+// A set of pairs of shapes (a convex mesh against a convex mesh, a box, a
+// capsule or a sphere) moves slowly over many frames, entering and leaving
+// contact. Each frame, the pairs are queried with PxGjkQuery::proximityInfos(),
+// PxGjkQuery::overlap() and PxGeometryQuery::computePenetration(), once from
+// scratch and once with one cache per pair. The snippet checks that both
+// versions give the same results and prints their timings. Proximity results
+// are compared with a small tolerance, see sameProximityResults().
+// ****************************************************************************
+
+#include "PxPhysicsAPI.h"
+#include "extensions/PxGjkQueryExt.h"
+#include "foundation/PxArray.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+
+static const PxU32	gNbPairs			= 1000;
+static const PxU32	gNbFrames			= 100;
+static const PxReal	gContactDistance	= 0.5f;
+static const PxReal	gToleranceLength	= 1.0f;
+
+namespace
+{
+	class Timer
+	{
+		public:
+			Timer() : mStartTime(SnippetUtils::getCurrentTimeCounterValue())	{}
+
+			float	getElapsedTime()	const
+			{
+				const PxU64 stopTime = SnippetUtils::getCurrentTimeCounterValue();
+				return SnippetUtils::getElapsedTimeInMilliseconds(stopTime - mStartTime);
+			}
+		private:
+			PxU64	mStartTime;
+	};
+
+	// Each pair oscillates around a rest configuration where the shapes are close to each other
+	struct PairMotion
+	{
+		PxVec3	mCenter;
+		PxVec3	mAxis;
+		PxVec3	mRotationAxis;
+		PxReal	mFrequency;
+		PxReal	mAmplitude;
+		PxU32	mShapeB;
+	};
+
+	struct Timings
+	{
+		Timings() : mProximity(0.0f), mOverlap(0.0f), mPenetration(0.0f)	{}
+
+		float	mProximity;
+		float	mOverlap;
+		float	mPenetration;
+	};
+}
+
+static PxConvexMesh* createConvexMesh(SnippetUtils::BasicRandom& rnd)
+{
+	PxVec3 verts[32];
+	for(PxU32 i=0;i<32;i++)
+	{
+		PxVec3 v;
+		rnd.unitRandomPt(v);
+		verts[i] = v.multiply(PxVec3(1.0f, 0.6f, 0.8f));
+	}
+
+	const PxTolerancesScale scale;
+	PxCookingParams params(scale);
+
+	PxConvexMeshDesc convexDesc;
+	convexDesc.points.count		= 32;
+	convexDesc.points.stride	= sizeof(PxVec3);
+	convexDesc.points.data		= verts;
+	convexDesc.flags			= PxConvexFlag::eCOMPUTE_CONVEX;
+	return PxCreateConvexMesh(params, convexDesc);
+}
+
+static void computePoses(const PairMotion& motion, PxU32 frame, PxTransform& poseA, PxTransform& poseB)
+{
+	const PxReal t = PxReal(frame) * motion.mFrequency;
+	poseA = PxTransform(motion.mCenter, PxQuat(t*0.3f, motion.mRotationAxis));
+	poseB = PxTransform(motion.mCenter + motion.mAxis * (1.6f + motion.mAmplitude*PxSin(t)), PxQuat(-t*0.2f, motion.mRotationAxis));
+}
+
+static bool sameProximityResults(const PxGjkQuery::ProximityInfo& r0, const PxGjkQuery::ProximityInfo& r1)
+{
+	if(r0.hit != r1.hit)
+		return false;
+	if(!r0.hit)
+		return true;
+	// The separating axis is not unique for touching shapes, so we only compare the separation. When GJK degenerates
+	// from scratch, it retries with shapes shrunk by 0.1%, while the warm-started version may converge directly. Shapes
+	// used here extend at most 1 unit from their origin, so the separation can differ by up to 2 * 0.001.
+	return PxAbs(r0.separation - r1.separation) <= 2e-3f;
+}
+
+int snippetMain(int, const char*const*)
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+
+	SnippetUtils::BasicRandom rnd(42);
+	PxConvexMesh* convexMesh = createConvexMesh(rnd);
+
+	bool success = convexMesh!=NULL;
+	if(convexMesh)
+	{
+		// Shape A is always the convex mesh. Shape B is one of these.
+		const PxConvexMeshGeometry convexGeom(convexMesh);
+		const PxBoxGeometry boxGeom(0.5f, 0.4f, 0.6f);
+		const PxCapsuleGeometry capsuleGeom(0.4f, 0.6f);
+		const PxSphereGeometry sphereGeom(0.5f);
+		const PxGeometry* geoms[] = { &convexGeom, &boxGeom, &capsuleGeom, &sphereGeom };
+
+		const PxGjkQueryExt::ConvexMeshSupport convexSupport(convexGeom);
+		const PxGjkQueryExt::BoxSupport boxSupport(boxGeom);
+		const PxGjkQueryExt::CapsuleSupport capsuleSupport(capsuleGeom);
+		const PxGjkQueryExt::SphereSupport sphereSupport(sphereGeom);
+		const PxGjkQuery::Support* supports[] = { &convexSupport, &boxSupport, &capsuleSupport, &sphereSupport };
+
+		PxArray<PairMotion> motions(gNbPairs);
+		for(PxU32 i=0;i<gNbPairs;i++)
+		{
+			PairMotion& m = motions[i];
+			m.mCenter = PxVec3(rnd.rand(-100.0f, 100.0f), rnd.rand(-100.0f, 100.0f), rnd.rand(-100.0f, 100.0f));
+			rnd.unitRandomPt(m.mAxis);
+			rnd.unitRandomPt(m.mRotationAxis);
+			m.mFrequency = rnd.rand(0.01f, 0.05f);
+			m.mAmplitude = rnd.rand(0.5f, 1.0f);
+			m.mShapeB = i%4;
+		}
+
+		PxArray<PxGjkQuery::Pair> pairs(gNbPairs);
+		for(PxU32 i=0;i<gNbPairs;i++)
+		{
+			pairs[i].a = &convexSupport;
+			pairs[i].b = supports[motions[i].mShapeB];
+		}
+
+		// One cache per pair and per query type, since a cache must only be used with one query on one pair
+		PxArray<PxGjkQuery::Cache> proximityCaches(gNbPairs);
+		PxArray<PxGjkQuery::Cache> overlapCaches(gNbPairs);
+		PxArray<PxGjkQuery::Cache> penetrationCaches(gNbPairs);
+
+		PxArray<PxGjkQuery::ProximityInfo> results(gNbPairs);
+		PxArray<PxGjkQuery::ProximityInfo> cachedResults(gNbPairs);
+		PxArray<bool> overlaps(gNbPairs);
+		PxArray<bool> penetrations(gNbPairs);
+		PxArray<PxReal> depths(gNbPairs);
+
+		Timings timings, cachedTimings;
+		PxU32 nbMismatches = 0;
+		PxU32 nbOverlaps = 0;
+		for(PxU32 frame=0;frame<gNbFrames;frame++)
+		{
+			for(PxU32 i=0;i<gNbPairs;i++)
+				computePoses(motions[i], frame, pairs[i].poseA, pairs[i].poseB);
+
+			// Proximity queries
+			{
+				Timer timer;
+				PxGjkQuery::proximityInfos(gNbPairs, pairs.begin(), gContactDistance, gToleranceLength, results.begin());
+				timings.mProximity += timer.getElapsedTime();
+			}
+			{
+				Timer timer;
+				PxGjkQuery::proximityInfos(gNbPairs, pairs.begin(), gContactDistance, gToleranceLength, cachedResults.begin(), proximityCaches.begin());
+				cachedTimings.mProximity += timer.getElapsedTime();
+			}
+			for(PxU32 i=0;i<gNbPairs;i++)
+			{
+				if(!sameProximityResults(results[i], cachedResults[i]))
+					nbMismatches++;
+			}
+
+			// Overlap queries
+			{
+				Timer timer;
+				for(PxU32 i=0;i<gNbPairs;i++)
+					overlaps[i] = PxGjkQuery::overlap(*pairs[i].a, *pairs[i].b, pairs[i].poseA, pairs[i].poseB);
+				timings.mOverlap += timer.getElapsedTime();
+			}
+			{
+				Timer timer;
+				for(PxU32 i=0;i<gNbPairs;i++)
+				{
+					const bool overlap = PxGjkQuery::overlap(*pairs[i].a, *pairs[i].b, pairs[i].poseA, pairs[i].poseB, overlapCaches[i]);
+					if(overlap != overlaps[i])
+						nbMismatches++;
+					if(overlap)
+						nbOverlaps++;
+				}
+				cachedTimings.mOverlap += timer.getElapsedTime();
+			}
+
+			// Penetration queries
+			{
+				Timer timer;
+				for(PxU32 i=0;i<gNbPairs;i++)
+				{
+					PxVec3 dir;
+					penetrations[i] = PxGeometryQuery::computePenetration(dir, depths[i], convexGeom, pairs[i].poseA, *geoms[motions[i].mShapeB], pairs[i].poseB);
+				}
+				timings.mPenetration += timer.getElapsedTime();
+			}
+			{
+				Timer timer;
+				for(PxU32 i=0;i<gNbPairs;i++)
+				{
+					PxVec3 dir;
+					PxReal depth;
+					const bool penetration = PxGeometryQuery::computePenetration(dir, depth, convexGeom, pairs[i].poseA, *geoms[motions[i].mShapeB], pairs[i].poseB, penetrationCaches[i]);
+					if(penetration != penetrations[i] || (penetration && PxAbs(depth - depths[i]) > 1e-3f))
+						nbMismatches++;
+				}
+				cachedTimings.mPenetration += timer.getElapsedTime();
+			}
+		}
+
+		printf("%d pairs, %d frames, %d overlapping pairs on average\n", gNbPairs, gNbFrames, nbOverlaps/gNbFrames);
+		printf("proximityInfos:     %8.2f ms without caches, %8.2f ms with caches (x%.2f)\n",
+			double(timings.mProximity), double(cachedTimings.mProximity), double(timings.mProximity/cachedTimings.mProximity));
+		printf("overlap:            %8.2f ms without caches, %8.2f ms with caches (x%.2f)\n",
+			double(timings.mOverlap), double(cachedTimings.mOverlap), double(timings.mOverlap/cachedTimings.mOverlap));
+		printf("computePenetration: %8.2f ms without caches, %8.2f ms with caches (x%.2f)\n",
+			double(timings.mPenetration), double(cachedTimings.mPenetration), double(timings.mPenetration/cachedTimings.mPenetration));
+		printf("%d mismatches\n", nbMismatches);
+		success = nbMismatches==0;
+
+		convexMesh->release();
+	}
+
+	PX_RELEASE(gFoundation);
+
+	printf("SnippetGjkWarmStart %s.\n", success ? "done" : "FAILED");
+
+	return success ? 0 : 1;
+}
@@ -0,0 +1,230 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+// ****************************************************************************
+// This snippet measures the effect of the heightfield min/max pyramid
+// (PxHeightFieldFlag::eMIN_MAX_PYRAMID) on raycasts and sweeps.
+//
+// It creates the same large terrain with and without the pyramid, then casts
+// long rays and sweeps against both. Grazing queries, which travel a long way
+// above the terrain before hitting it, benefit the most. The results of both
+// heightfields are compared to make sure they agree.
+// ****************************************************************************
+
+#include "PxPhysicsAPI.h"
+#include "foundation/PxArray.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxPhysics*				gPhysics = NULL;
+
+static const PxU32	gNbSamplesPerSide	= 2049;
+static const PxReal	gHeightScale		= 0.01f;
+static const PxReal	gRowScale			= 1.0f;
+static const PxReal	gColumnScale		= 1.0f;
+static const PxU32	gNbRays				= 100000;
+static const PxU32	gNbSweeps			= 2000;
+
+namespace
+{
+	class Timer
+	{
+		public:
+			Timer() : mStartTime(SnippetUtils::getCurrentTimeCounterValue())	{}
+
+			float	getElapsedTime()	const
+			{
+				const PxU64 stopTime = SnippetUtils::getCurrentTimeCounterValue();
+				return SnippetUtils::getElapsedTimeInMilliseconds(stopTime - mStartTime);
+			}
+		private:
+			PxU64	mStartTime;
+	};
+
+	struct Query
+	{
+		PxVec3	mOrigin;
+		PxVec3	mDir;
+		PxReal	mLength;
+	};
+}
+
+static PxHeightField* createHeightField(const PxArray<PxHeightFieldSample>& samples, PxHeightFieldFlags flags)
+{
+	PxHeightFieldDesc hfDesc;
+	hfDesc.nbRows			= gNbSamplesPerSide;
+	hfDesc.nbColumns		= gNbSamplesPerSide;
+	hfDesc.samples.data		= samples.begin();
+	hfDesc.samples.stride	= sizeof(PxHeightFieldSample);
+	hfDesc.flags			= flags;
+	return PxCreateHeightField(hfDesc, gPhysics->getPhysicsInsertionCallback());
+}
+
+// Rolling hills with a few holes. Heights stay within [-25, 25] in world space.
+static void createTerrain(PxArray<PxHeightFieldSample>& samples)
+{
+	samples.resize(gNbSamplesPerSide*gNbSamplesPerSide);
+	for(PxU32 r=0;r<gNbSamplesPerSide;r++)
+	{
+		for(PxU32 c=0;c<gNbSamplesPerSide;c++)
+		{
+			const PxReal h = 2000.0f*PxSin(PxReal(r)*0.01f)*PxCos(PxReal(c)*0.007f) + 300.0f*PxSin(PxReal(r)*0.2f + PxReal(c)*0.13f);
+			PxHeightFieldSample& sample = samples[r*gNbSamplesPerSide + c];
+			sample.height = PxI16(h);
+			sample.materialIndex0 = 0;
+			sample.materialIndex1 = 0;
+			if(((r/64)%8)==3 && ((c/64)%8)==5)
+			{
+				sample.materialIndex0 = PxHeightFieldMaterial::eHOLE;
+				sample.materialIndex1 = PxHeightFieldMaterial::eHOLE;
+			}
+		}
+	}
+}
+
+// Queries start above the terrain and end at heights between 'minEndHeight' and 'maxEndHeight'
+static void createQueries(PxArray<Query>& queries, PxU32 nbQueries, PxReal minEndHeight, PxReal maxEndHeight)
+{
+	SnippetUtils::BasicRandom rnd(42);
+	const PxReal sizeX = PxReal(gNbSamplesPerSide-1)*gRowScale;
+	const PxReal sizeZ = PxReal(gNbSamplesPerSide-1)*gColumnScale;
+	queries.resize(nbQueries);
+	for(PxU32 i=0;i<nbQueries;i++)
+	{
+		const PxVec3 start(rnd.rand(0.0f, sizeX), rnd.rand(20.0f, 30.0f), rnd.rand(0.0f, sizeZ));
+		const PxVec3 end(rnd.rand(0.0f, sizeX), rnd.rand(minEndHeight, maxEndHeight), rnd.rand(0.0f, sizeZ));
+		queries[i].mOrigin = start;
+		queries[i].mDir = end - start;
+		queries[i].mLength = queries[i].mDir.normalize() * 1.1f;
+	}
+}
+
+static float runRaycasts(const PxHeightFieldGeometry& geom, const PxArray<Query>& queries, PxArray<PxReal>& distances)
+{
+	const PxTransform pose(PxIdentity);
+	distances.resize(queries.size());
+	Timer timer;
+	for(PxU32 i=0;i<queries.size();i++)
+	{
+		PxRaycastHit hit;
+		const PxU32 nbHits = PxGeometryQuery::raycast(queries[i].mOrigin, queries[i].mDir, geom, pose, queries[i].mLength, PxHitFlag::eDEFAULT, 1, &hit);
+		distances[i] = nbHits ? hit.distance : -1.0f;
+	}
+	return timer.getElapsedTime();
+}
+
+static float runSweeps(const PxHeightFieldGeometry& geom, const PxArray<Query>& queries, PxArray<PxReal>& distances)
+{
+	const PxTransform pose(PxIdentity);
+	const PxCapsuleGeometry capsule(0.5f, 1.0f);
+	distances.resize(queries.size());
+	Timer timer;
+	for(PxU32 i=0;i<queries.size();i++)
+	{
+		PxGeomSweepHit hit;
+		const bool status = PxGeometryQuery::sweep(queries[i].mDir, queries[i].mLength, capsule, PxTransform(queries[i].mOrigin), geom, pose, hit);
+		distances[i] = status ? hit.distance : -1.0f;
+	}
+	return timer.getElapsedTime();
+}
+
+static PxU32 countMismatches(const PxArray<PxReal>& distances0, const PxArray<PxReal>& distances1)
+{
+	PxU32 nbMismatches = 0;
+	for(PxU32 i=0;i<distances0.size();i++)
+	{
+		if(PxAbs(distances0[i] - distances1[i]) > 1e-3f*PxMax(1.0f, distances0[i]))
+			nbMismatches++;
+	}
+	return nbMismatches;
+}
+
+static void runBenchmarks()
+{
+	PxArray<PxHeightFieldSample> samples;
+	createTerrain(samples);
+
+	PxHeightField* plainHF = createHeightField(samples, PxHeightFieldFlags());
+	PxHeightField* pyramidHF = createHeightField(samples, PxHeightFieldFlag::eMIN_MAX_PYRAMID);
+
+	const PxHeightFieldGeometry plainGeom(plainHF, PxMeshGeometryFlags(), gHeightScale, gRowScale, gColumnScale);
+	const PxHeightFieldGeometry pyramidGeom(pyramidHF, PxMeshGeometryFlags(), gHeightScale, gRowScale, gColumnScale);
+
+	printf("Heightfield: %dx%d samples\n", gNbSamplesPerSide, gNbSamplesPerSide);
+
+	struct Scenario
+	{
+		const char*	mName;
+		PxReal		mMinEndHeight;
+		PxReal		mMaxEndHeight;
+	};
+	const Scenario scenarios[] = {
+		{ "Grazing",	15.0f,	25.0f	},
+		{ "Steep",		-40.0f,	-20.0f	},
+	};
+
+	for(PxU32 s=0;s<2;s++)
+	{
+		PxArray<Query> rays;
+		createQueries(rays, gNbRays, scenarios[s].mMinEndHeight, scenarios[s].mMaxEndHeight);
+
+		PxArray<PxReal> plainDistances, pyramidDistances;
+		const float plainTime = runRaycasts(plainGeom, rays, plainDistances);
+		const float pyramidTime = runRaycasts(pyramidGeom, rays, pyramidDistances);
+		printf("%-8s raycasts: %8.2f ms without pyramid, %8.2f ms with pyramid (x%.2f) | %d mismatches\n",
+			scenarios[s].mName, double(plainTime), double(pyramidTime), double(plainTime/pyramidTime), countMismatches(plainDistances, pyramidDistances));
+
+		PxArray<Query> sweeps;
+		createQueries(sweeps, gNbSweeps, scenarios[s].mMinEndHeight, scenarios[s].mMaxEndHeight);
+		const float plainSweepTime = runSweeps(plainGeom, sweeps, plainDistances);
+		const float pyramidSweepTime = runSweeps(pyramidGeom, sweeps, pyramidDistances);
+		printf("%-8s sweeps:   %8.2f ms without pyramid, %8.2f ms with pyramid (x%.2f) | %d mismatches\n",
+			scenarios[s].mName, double(plainSweepTime), double(pyramidSweepTime), double(plainSweepTime/pyramidSweepTime), countMismatches(plainDistances, pyramidDistances));
+	}
+
+	pyramidHF->release();
+	plainHF->release();
+}
+
+int snippetMain(int, const char*const*)
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+	// The physics SDK registers the heightfield query functions
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale());
+
+	runBenchmarks();
+
+	PX_RELEASE(gPhysics);
+	PX_RELEASE(gFoundation);
+	printf("SnippetHeightFieldPyramid done.\n");
+
+	return 0;
+}
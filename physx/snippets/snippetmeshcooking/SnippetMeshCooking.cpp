@@ -0,0 +1,355 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet measures triangle mesh cooking throughput, with and without a
+// CPU dispatcher in the cooking parameters.
+//
+// A set of procedural terrain tiles and one large terrain mesh are cooked on
+// the calling thread and then on multiple threads. The snippet prints the
+// cooking times and checks that both versions produce the same cooked data.
+//
+// It then cooks the tiles and a convex decomposition made of many small convex
+// parts with the batch functions PxCookTriangleMeshes / PxCookConvexMeshes, and
+// compares them to cooking the same meshes one by one.
+// ****************************************************************************
+
+#include "PxPhysicsAPI.h"
+#include "foundation/PxArray.h"
+#include <string.h>
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxDefaultCpuDispatcher*	gDispatcher = NULL;
+
+static const PxU32	gNbTiles		= 32;
+static const PxU32	gTileSize		= 128;
+static const PxU32	gLargeMeshSize	= 512;
+static const PxU32	gNbConvexParts	= 2000;
+
+namespace
+{
+	struct TerrainMesh
+	{
+		PxArray<PxVec3>	mVerts;
+		PxArray<PxU32>	mIndices;
+	};
+}
+
+static float randomFloat()
+{
+	return float(rand())/float(RAND_MAX);
+}
+
+static void createTerrain(TerrainMesh& mesh, PxU32 size, const PxVec3& origin)
+{
+	const PxU32 nbVerts = (size+1)*(size+1);
+	mesh.mVerts.resize(nbVerts);
+	for(PxU32 z=0;z<=size;z++)
+	{
+		for(PxU32 x=0;x<=size;x++)
+		{
+			const float h = PxSin(float(x)*0.15f)*PxCos(float(z)*0.1f)*4.0f + randomFloat()*0.2f;
+			mesh.mVerts[z*(size+1)+x] = origin + PxVec3(float(x), h, float(z));
+		}
+	}
+
+	mesh.mIndices.resize(size*size*6);
+	PxU32* indices = mesh.mIndices.begin();
+	for(PxU32 z=0;z<size;z++)
+	{
+		for(PxU32 x=0;x<size;x++)
+		{
+			const PxU32 i0 = z*(size+1)+x;
+			const PxU32 i1 = i0+1;
+			const PxU32 i2 = i0+size+1;
+			const PxU32 i3 = i2+1;
+			*indices++ = i0;	*indices++ = i2;	*indices++ = i1;
+			*indices++ = i1;	*indices++ = i2;	*indices++ = i3;
+		}
+	}
+}
+
+static void createConvexPart(PxArray<PxVec3>& verts)
+{
+	const PxU32 nbVerts = 8 + PxU32(rand()%56);
+	const PxVec3 extents(0.5f + randomFloat(), 0.5f + randomFloat(), 0.5f + randomFloat());
+	verts.resize(nbVerts);
+	for(PxU32 i=0;i<nbVerts;i++)
+		verts[i] = PxVec3(randomFloat()*extents.x, randomFloat()*extents.y, randomFloat()*extents.z);
+}
+
+static void setupCookingParams(PxCookingParams& params, PxBVH34BuildStrategy::Enum strategy, PxCpuDispatcher* dispatcher)
+{
+	params.midphaseDesc = PxMeshMidPhase::eBVH34;
+	params.midphaseDesc.mBVH34Desc.buildStrategy = strategy;
+	params.buildTriangleAdjacencies = true;
+	params.meshPreprocessParams = PxMeshPreprocessingFlag::eWELD_VERTICES;
+	params.meshWeldTolerance = 0.01f;
+	params.dispatcher = dispatcher;
+}
+
+// Cooks all meshes, stores the cooked data in the given streams and returns the elapsed time in ms
+static float cookMeshes(const PxArray<TerrainMesh>& meshes, const PxCookingParams& params, PxArray<PxDefaultMemoryOutputStream*>& streams)
+{
+	const PxU64 startTime = SnippetUtils::getCurrentTimeCounterValue();
+	const PxU32 nbMeshes = meshes.size();
+	for(PxU32 i=0;i<nbMeshes;i++)
+	{
+		PxTriangleMeshDesc meshDesc;
+		meshDesc.points.count		= meshes[i].mVerts.size();
+		meshDesc.points.stride		= sizeof(PxVec3);
+		meshDesc.points.data		= meshes[i].mVerts.begin();
+		meshDesc.triangles.count	= meshes[i].mIndices.size()/3;
+		meshDesc.triangles.stride	= 3*sizeof(PxU32);
+		meshDesc.triangles.data		= meshes[i].mIndices.begin();
+
+		PxCookTriangleMesh(params, meshDesc, *streams[i]);
+	}
+	const PxU64 stopTime = SnippetUtils::getCurrentTimeCounterValue();
+	return SnippetUtils::getElapsedTimeInMilliseconds(stopTime - startTime);
+}
+
+static void runBenchmark(const char* name, const PxArray<TerrainMesh>& meshes, PxBVH34BuildStrategy::Enum strategy)
+{
+	const PxU32 nbMeshes = meshes.size();
+	PxU32 nbTris = 0;
+	for(PxU32 i=0;i<nbMeshes;i++)
+		nbTris += meshes[i].mIndices.size()/3;
+
+	PxArray<PxDefaultMemoryOutputStream*> serialStreams(nbMeshes);
+	PxArray<PxDefaultMemoryOutputStream*> parallelStreams(nbMeshes);
+	for(PxU32 i=0;i<nbMeshes;i++)
+	{
+		serialStreams[i] = new PxDefaultMemoryOutputStream;
+		parallelStreams[i] = new PxDefaultMemoryOutputStream;
+	}
+
+	const PxTolerancesScale scale;
+	PxCookingParams params(scale);
+
+	setupCookingParams(params, strategy, NULL);
+	const float serialTime = cookMeshes(meshes, params, serialStreams);
+
+	setupCookingParams(params, strategy, gDispatcher);
+	const float parallelTime = cookMeshes(meshes, params, parallelStreams);
+
+	bool identical = true;
+	for(PxU32 i=0;i<nbMeshes;i++)
+	{
+		if(serialStreams[i]->getSize()!=parallelStreams[i]->getSize() || memcmp(serialStreams[i]->getData(), parallelStreams[i]->getData(), serialStreams[i]->getSize()))
+			identical = false;
+		delete serialStreams[i];
+		delete parallelStreams[i];
+	}
+
+	const char* strategyName = strategy==PxBVH34BuildStrategy::eFAST ? "eFAST" : strategy==PxBVH34BuildStrategy::eDEFAULT ? "eDEFAULT" : "eSAH";
+	printf("\t -----------------------------------------------\n");
+	printf("\t %s: %d mesh(es), %d triangles, %s\n", name, nbMeshes, nbTris, strategyName);
+	printf("\t\t single-threaded: %f ms (%f Mtris/s)\n", double(serialTime), double(float(nbTris)/(serialTime*1000.0f)));
+	printf("\t\t multi-threaded:  %f ms (%f Mtris/s)\n", double(parallelTime), double(float(nbTris)/(parallelTime*1000.0f)));
+	printf("\t\t cooked data is %s\n", identical ? "identical" : "DIFFERENT");
+}
+
+static void getOutputStreams(PxArray<PxDefaultMemoryOutputStream*>& streams, PxArray<PxOutputStream*>& outputStreams)
+{
+	const PxU32 nbStreams = streams.size();
+	outputStreams.resize(nbStreams);
+	for(PxU32 i=0;i<nbStreams;i++)
+		outputStreams[i] = streams[i];
+}
+
+static bool compareStreams(PxArray<PxDefaultMemoryOutputStream*>& streams0, PxArray<PxDefaultMemoryOutputStream*>& streams1)
+{
+	bool identical = true;
+	const PxU32 nbStreams = streams0.size();
+	for(PxU32 i=0;i<nbStreams;i++)
+	{
+		if(streams0[i]->getSize()!=streams1[i]->getSize() || memcmp(streams0[i]->getData(), streams1[i]->getData(), streams0[i]->getSize()))
+			identical = false;
+		delete streams0[i];
+		delete streams1[i];
+	}
+	return identical;
+}
+
+static void runTriangleMeshBatchBenchmark(const PxArray<TerrainMesh>& meshes)
+{
+	const PxU32 nbMeshes = meshes.size();
+
+	PxArray<PxDefaultMemoryOutputStream*> serialStreams(nbMeshes);
+	PxArray<PxDefaultMemoryOutputStream*> batchStreams(nbMeshes);
+	PxArray<PxTriangleMeshDesc> descs(nbMeshes);
+	for(PxU32 i=0;i<nbMeshes;i++)
+	{
+		serialStreams[i] = new PxDefaultMemoryOutputStream;
+		batchStreams[i] = new PxDefaultMemoryOutputStream;
+
+		descs[i].points.count		= meshes[i].mVerts.size();
+		descs[i].points.stride		= sizeof(PxVec3);
+		descs[i].points.data		= meshes[i].mVerts.begin();
+		descs[i].triangles.count	= meshes[i].mIndices.size()/3;
+		descs[i].triangles.stride	= 3*sizeof(PxU32);
+		descs[i].triangles.data		= meshes[i].mIndices.begin();
+	}
+
+	const PxTolerancesScale scale;
+	PxCookingParams params(scale);
+
+	setupCookingParams(params, PxBVH34BuildStrategy::eDEFAULT, NULL);
+	const float serialTime = cookMeshes(meshes, params, serialStreams);
+
+	setupCookingParams(params, PxBVH34BuildStrategy::eDEFAULT, gDispatcher);
+	PxArray<PxOutputStream*> outputStreams;
+	getOutputStreams(batchStreams, outputStreams);
+
+	const PxU64 startTime = SnippetUtils::getCurrentTimeCounterValue();
+	PxCookTriangleMeshes(params, nbMeshes, descs.begin(), outputStreams.begin());
+	const float batchTime = SnippetUtils::getElapsedTimeInMilliseconds(SnippetUtils::getCurrentTimeCounterValue() - startTime);
+
+	const bool identical = compareStreams(serialStreams, batchStreams);
+
+	printf("\t -----------------------------------------------\n");
+	printf("\t Terrain tiles, batch cooking: %d meshes\n", nbMeshes);
+	printf("\t\t one by one, single-threaded: %f ms\n", double(serialTime));
+	printf("\t\t PxCookTriangleMeshes:        %f ms\n", double(batchTime));
+	printf("\t\t cooked data is %s\n", identical ? "identical" : "DIFFERENT");
+}
+
+static void runConvexBatchBenchmark()
+{
+	PxArray<PxArray<PxVec3> > parts(gNbConvexParts);
+	PxArray<PxConvexMeshDesc> descs(gNbConvexParts);
+	PxArray<PxDefaultMemoryOutputStream*> serialStreams(gNbConvexParts);
+	PxArray<PxDefaultMemoryOutputStream*> batchStreams(gNbConvexParts);
+	for(PxU32 i=0;i<gNbConvexParts;i++)
+	{
+		createConvexPart(parts[i]);
+		descs[i].points.count	= parts[i].size();
+		descs[i].points.stride	= sizeof(PxVec3);
+		descs[i].points.data	= parts[i].begin();
+		descs[i].flags			= PxConvexFlag::eCOMPUTE_CONVEX;
+
+		serialStreams[i] = new PxDefaultMemoryOutputStream;
+		batchStreams[i] = new PxDefaultMemoryOutputStream;
+	}
+
+	const PxTolerancesScale scale;
+	PxCookingParams params(scale);
+
+	PxU64 startTime = SnippetUtils::getCurrentTimeCounterValue();
+	for(PxU32 i=0;i<gNbConvexParts;i++)
+		PxCookConvexMesh(params, descs[i], *serialStreams[i]);
+	const float serialTime = SnippetUtils::getElapsedTimeInMilliseconds(SnippetUtils::getCurrentTimeCounterValue() - startTime);
+
+	PxArray<PxOutputStream*> outputStreams;
+	getOutputStreams(batchStreams, outputStreams);
+
+	startTime = SnippetUtils::getCurrentTimeCounterValue();
+	PxCookConvexMeshes(params, gNbConvexParts, descs.begin(), outputStreams.begin());
+	const float batchTime = SnippetUtils::getElapsedTimeInMilliseconds(SnippetUtils::getCurrentTimeCounterValue() - startTime);
+
+	params.dispatcher = gDispatcher;
+	PxArray<PxDefaultMemoryOutputStream*> parallelStreams(gNbConvexParts);
+	for(PxU32 i=0;i<gNbConvexParts;i++)
+		parallelStreams[i] = new PxDefaultMemoryOutputStream;
+
+	getOutputStreams(parallelStreams, outputStreams);
+
+	startTime = SnippetUtils::getCurrentTimeCounterValue();
+	PxCookConvexMeshes(params, gNbConvexParts, descs.begin(), outputStreams.begin());
+	const float parallelTime = SnippetUtils::getElapsedTimeInMilliseconds(SnippetUtils::getCurrentTimeCounterValue() - startTime);
+
+	bool identical = true;
+	for(PxU32 i=0;i<gNbConvexParts;i++)
+	{
+		if(serialStreams[i]->getSize()!=parallelStreams[i]->getSize() || memcmp(serialStreams[i]->getData(), parallelStreams[i]->getData(), serialStreams[i]->getSize()))
+			identical = false;
+		delete parallelStreams[i];
+	}
+	identical &= compareStreams(serialStreams, batchStreams);
+
+	printf("\t -----------------------------------------------\n");
+	printf("\t Convex decomposition, batch cooking: %d parts\n", gNbConvexParts);
+	printf("\t\t one by one:                       %f ms\n", double(serialTime));
+	printf("\t\t PxCookConvexMeshes, no dispatcher: %f ms\n", double(batchTime));
+	printf("\t\t PxCookConvexMeshes, dispatcher:    %f ms\n", double(parallelTime));
+	printf("\t\t cooked data is %s\n", identical ? "identical" : "DIFFERENT");
+}
+
+void initPhysics()
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+
+	const PxU32 nbThreads = PxMax<PxU32>(2, SnippetUtils::getNbPhysicalCores());
+	gDispatcher = PxDefaultCpuDispatcherCreate(nbThreads);
+	printf("Using %d worker threads for multi-threaded cooking\n", nbThreads);
+}
+
+void cleanupPhysics()
+{
+	PX_RELEASE(gDispatcher);
+	PX_RELEASE(gFoundation);
+
+	printf("SnippetMeshCooking done.\n");
+}
+
+void runBenchmarks()
+{
+	srand(42);
+
+	PxArray<TerrainMesh> tiles(gNbTiles);
+	for(PxU32 i=0;i<gNbTiles;i++)
+		createTerrain(tiles[i], gTileSize, PxVec3(float((i%8)*gTileSize), 0.0f, float((i/8)*gTileSize)));
+
+	PxArray<TerrainMesh> largeMesh(1);
+	createTerrain(largeMesh[0], gLargeMeshSize, PxVec3(0.0f));
+
+	const PxBVH34BuildStrategy::Enum strategies[] = { PxBVH34BuildStrategy::eDEFAULT, PxBVH34BuildStrategy::eSAH };
+	for(PxU32 i=0;i<2;i++)
+	{
+		runBenchmark("Terrain tiles", tiles, strategies[i]);
+		runBenchmark("Large terrain", largeMesh, strategies[i]);
+	}
+
+	runTriangleMeshBatchBenchmark(tiles);
+	runConvexBatchBenchmark();
+}
+
+int snippetMain(int, const char*const*)
+{
+	initPhysics();
+	runBenchmarks();
+	cleanupPhysics();
+
+	return 0;
+}
@@ -0,0 +1,376 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet illustrates how to use the paged static pruner to stream a
+// large static world.
+//
+// The world is split into a grid of cells. The BVH of each cell is pre-built
+// offline with savePagedPrunerCell(), then cells are loaded either from a
+// stream (the data is copied) or in place from memory (e.g. a memory-mapped
+// file), and unloaded again. Raycasts and overlaps are checked against a
+// brute-force reference that only considers the loaded cells, to show that
+// unloaded cells are skipped.
+//
+// Finally the snippet feeds corrupted cell data to the pruner, which must
+// reject it instead of trusting it.
+//
+// ****************************************************************************
+
+#include "PxPhysicsAPI.h"
+#include "GuPruner.h"
+#include "GuFactory.h"
+#include "GuBounds.h"
+#include "foundation/PxArray.h"
+#include "../snippetcommon/SnippetPrint.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+using namespace Gu;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+
+#define GRID_SIZE			4
+#define NB_CELLS			(GRID_SIZE*GRID_SIZE)
+#define NB_OBJECTS_PER_CELL	64
+#define CELL_EXTENTS		10.0f
+#define SPHERE_RADIUS		0.5f
+#define NB_QUERIES			1000
+
+namespace
+{
+	struct Cell
+	{
+		PxBounds3					mBounds;
+		PxTransform					mPoses[NB_OBJECTS_PER_CELL];
+		PxBounds3					mObjectBounds[NB_OBJECTS_PER_CELL];
+		PxDefaultMemoryOutputStream	mData;	// Serialized cell, as it would be stored on disk
+		PagedCellHandle				mHandle;
+	};
+
+	// Payloads are stored verbatim in the cell data, so they contain indices rather than pointers
+	PX_FORCE_INLINE PxU32 getCellIndex(const PrunerPayload& payload)	{ return PxU32(payload.data[0]);	}
+	PX_FORCE_INLINE PxU32 getObjectIndex(const PrunerPayload& payload)	{ return PxU32(payload.data[1]);	}
+
+	struct ClosestRaycastCallback : PrunerRaycastCallback
+	{
+		ClosestRaycastCallback(const PxVec3& origin, const PxVec3& dir) : mOrigin(origin), mDir(dir), mCell(0xffffffff), mObject(0xffffffff)	{}
+
+		virtual bool invoke(PxReal& distance, PxU32 primIndex, const PrunerPayload* payloads, const PxTransform* transforms)
+		{
+			PxGeomRaycastHit hit;
+			if(PxGeometryQuery::raycast(mOrigin, mDir, PxSphereGeometry(SPHERE_RADIUS), transforms[primIndex], distance, PxHitFlag::eDEFAULT, 1, &hit))
+			{
+				if(hit.distance<distance)
+				{
+					// Shrinking the distance lets the pruner cull the rest of the traversal
+					distance = hit.distance;
+					mCell = getCellIndex(payloads[primIndex]);
+					mObject = getObjectIndex(payloads[primIndex]);
+				}
+			}
+			return true;
+		}
+
+		const PxVec3	mOrigin;
+		const PxVec3	mDir;
+		PxU32			mCell;
+		PxU32			mObject;
+	};
+
+	struct CountOverlapCallback : PrunerOverlapCallback
+	{
+		CountOverlapCallback() : mNbHits(0), mChecksum(0)	{}
+
+		virtual bool invoke(PxU32 primIndex, const PrunerPayload* payloads, const PxTransform*)
+		{
+			const PxU32 id = getCellIndex(payloads[primIndex])*NB_OBJECTS_PER_CELL + getObjectIndex(payloads[primIndex]);
+			mNbHits++;
+			mChecksum += id*id + 1;
+			return true;
+		}
+
+		PxU32	mNbHits;
+		PxU64	mChecksum;
+	};
+}
+
+static Cell*		gCells = NULL;
+static PagedPruner*	gPruner = NULL;
+
+static void createCells()
+{
+	SnippetUtils::BasicRandom rnd(42);
+
+	gCells = new Cell[NB_CELLS];
+	for(PxU32 j=0;j<GRID_SIZE;j++)
+	{
+		for(PxU32 i=0;i<GRID_SIZE;i++)
+		{
+			const PxU32 cellIndex = j*GRID_SIZE+i;
+			Cell& cell = gCells[cellIndex];
+
+			const PxVec3 cellMin(float(i)*CELL_EXTENTS, 0.0f, float(j)*CELL_EXTENTS);
+			cell.mBounds = PxBounds3::empty();
+
+			PrunerPayload payloads[NB_OBJECTS_PER_CELL];
+			for(PxU32 k=0;k<NB_OBJECTS_PER_CELL;k++)
+			{
+				const PxVec3 p = cellMin + PxVec3(rnd.rand(0.0f, CELL_EXTENTS), rnd.rand(0.0f, 4.0f), rnd.rand(0.0f, CELL_EXTENTS));
+				cell.mPoses[k] = PxTransform(p);
+				cell.mObjectBounds[k] = PxBounds3::centerExtents(p, PxVec3(SPHERE_RADIUS));
+				cell.mBounds.include(cell.mObjectBounds[k]);
+
+				payloads[k].data[0] = cellIndex;
+				payloads[k].data[1] = k;
+			}
+
+			// This would typically be done offline, with the result written to disk
+			savePagedPrunerCell(cell.mData, NB_OBJECTS_PER_CELL, cell.mObjectBounds, payloads, cell.mPoses, BVH_SPLATTER_POINTS, 4);
+		}
+	}
+}
+
+// Reference results, computed by brute-force over the loaded cells only
+static void bruteForceRaycast(const PxVec3& origin, const PxVec3& dir, PxReal maxDist, PxU32& closestCell, PxU32& closestObject)
+{
+	closestCell = closestObject = 0xffffffff;
+	for(PxU32 i=0;i<NB_CELLS;i++)
+	{
+		if(!gPruner->isCellLoaded(gCells[i].mHandle))
+			continue;
+
+		for(PxU32 k=0;k<NB_OBJECTS_PER_CELL;k++)
+		{
+			PxGeomRaycastHit hit;
+			if(PxGeometryQuery::raycast(origin, dir, PxSphereGeometry(SPHERE_RADIUS), gCells[i].mPoses[k], maxDist, PxHitFlag::eDEFAULT, 1, &hit) && hit.distance<maxDist)
+			{
+				maxDist = hit.distance;
+				closestCell = i;
+				closestObject = k;
+			}
+		}
+	}
+}
+
+static void bruteForceOverlap(const PxBounds3& box, PxU32& nbHits, PxU64& checksum)
+{
+	nbHits = 0;
+	checksum = 0;
+	for(PxU32 i=0;i<NB_CELLS;i++)
+	{
+		if(!gPruner->isCellLoaded(gCells[i].mHandle))
+			continue;
+
+		for(PxU32 k=0;k<NB_OBJECTS_PER_CELL;k++)
+		{
+			if(gCells[i].mObjectBounds[k].intersects(box))
+			{
+				const PxU32 id = i*NB_OBJECTS_PER_CELL + k;
+				nbHits++;
+				checksum += id*id + 1;
+			}
+		}
+	}
+}
+
+static bool runQueries(const char* label)
+{
+	SnippetUtils::BasicRandom rnd(1234);
+
+	const float worldSize = float(GRID_SIZE)*CELL_EXTENTS;
+	const float maxDist = worldSize*2.0f;
+
+	PxU32 nbRaycastHits = 0;
+	PxU32 nbOverlapHits = 0;
+	PxU32 nbErrors = 0;
+	for(PxU32 i=0;i<NB_QUERIES;i++)
+	{
+		// Raycasts
+		{
+			const PxVec3 origin(rnd.rand(-5.0f, worldSize+5.0f), 10.0f, rnd.rand(-5.0f, worldSize+5.0f));
+			const PxVec3 target(rnd.rand(0.0f, worldSize), 0.0f, rnd.rand(0.0f, worldSize));
+			const PxVec3 dir = (target - origin).getNormalized();
+
+			ClosestRaycastCallback cb(origin, dir);
+			PxReal dist = maxDist;
+			gPruner->raycast(origin, dir, dist, cb);
+
+			PxU32 refCell, refObject;
+			bruteForceRaycast(origin, dir, maxDist, refCell, refObject);
+
+			if(cb.mCell!=refCell || cb.mObject!=refObject)
+				nbErrors++;
+			if(refCell!=0xffffffff)
+				nbRaycastHits++;
+		}
+
+		// Overlaps. We use an axis-aligned box so that the reference test is a plain AABB-AABB test. Note that
+		// pruners are conservative and test a slightly inflated query volume, so we use the same bounds here.
+		{
+			const PxVec3 center(rnd.rand(0.0f, worldSize), rnd.rand(0.0f, 4.0f), rnd.rand(0.0f, worldSize));
+			const PxVec3 extents(rnd.rand(0.5f, 4.0f), rnd.rand(0.5f, 4.0f), rnd.rand(0.5f, 4.0f));
+
+			const ShapeData queryVolume(PxBoxGeometry(extents), PxTransform(center), 0.0f);
+
+			CountOverlapCallback cb;
+			gPruner->overlap(queryVolume, cb);
+
+			PxU32 refNbHits;
+			PxU64 refChecksum;
+			bruteForceOverlap(queryVolume.getPrunerInflatedWorldAABB(), refNbHits, refChecksum);
+
+			if(cb.mNbHits!=refNbHits || cb.mChecksum!=refChecksum)
+				nbErrors++;
+			nbOverlapHits += refNbHits;
+		}
+	}
+
+	printf("%s: %d/%d cells loaded, %d raycast hits, %d overlap hits, %d mismatches.\n", label, gPruner->getNbLoadedCells(), gPruner->getNbCells(), nbRaycastHits, nbOverlapHits, nbErrors);
+	return nbErrors==0;
+}
+
+static bool testCorruptData()
+{
+	const Cell& cell = gCells[0];
+	const PxU32 size = cell.mData.getSize();
+
+	// Copy the data so that we can damage it. Memory used in place must be 8-bytes aligned.
+	PxU32* copy = reinterpret_cast<PxU32*>(gAllocator.allocate(size, "SnippetPagedPruner", PX_FL));
+
+	bool success = true;
+
+	// The cell data starts with a 32-bytes header: magic, version, payload size, then the number of objects, nodes and indices.
+	// A huge object count must be rejected before the pruner tries to allocate or read that much memory.
+	PxMemCopy(copy, cell.mData.getData(), size);
+	copy[3] = 0xffffffff;
+	{
+		PxDefaultMemoryInputData input(reinterpret_cast<PxU8*>(copy), size);
+		success &= !gPruner->loadCell(cell.mHandle, input);
+		success &= !gPruner->loadCell(cell.mHandle, copy, size);
+	}
+
+	// Truncated data must be rejected
+	PxMemCopy(copy, cell.mData.getData(), size);
+	{
+		PxDefaultMemoryInputData input(reinterpret_cast<PxU8*>(copy), size-4);
+		success &= !gPruner->loadCell(cell.mHandle, input);
+		success &= !gPruner->loadCell(cell.mHandle, copy, size-4);
+	}
+
+	// The primitive indices are stored last. An out-of-range index must be rejected as well.
+	copy[size/sizeof(PxU32)-1] = 0xffffffff;
+	success &= !gPruner->loadCell(cell.mHandle, copy, size);
+
+	success &= !gPruner->isCellLoaded(cell.mHandle);
+
+	gAllocator.deallocate(copy);
+
+	printf("Corrupt cell data %s.\n", success ? "rejected" : "NOT rejected");
+	return success;
+}
+
+int snippetMain(int, const char*const*)
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+
+	createCells();
+
+	// The pruner can be used as-is, as done here, or added to a custom query system (see SnippetStandaloneQuerySystem)
+	gPruner = createPagedPruner(0);
+
+	// Registering cells is cheap: only the bounds are given here, the data is loaded later on demand
+	for(PxU32 i=0;i<NB_CELLS;i++)
+		gCells[i].mHandle = gPruner->addCell(gCells[i].mBounds);
+
+	// Rebuilds the top-level tree over the cell bounds. Loading and unloading cells does not need it.
+	gPruner->commit();
+
+	bool success = true;
+
+	success &= runQueries("Nothing loaded");
+
+	// Load half of the cells from streams (the data is copied)...
+	for(PxU32 i=0;i<NB_CELLS;i+=2)
+	{
+		PxDefaultMemoryInputData input(gCells[i].mData.getData(), gCells[i].mData.getSize());
+		success &= gPruner->loadCell(gCells[i].mHandle, input);
+	}
+	success &= runQueries("Stream-loaded cells");
+
+	// ...and the other half in place (zero-copy)
+	for(PxU32 i=1;i<NB_CELLS;i+=2)
+		success &= gPruner->loadCell(gCells[i].mHandle, gCells[i].mData.getData(), gCells[i].mData.getSize());
+	success &= runQueries("All cells loaded");
+
+	// Unload a checkerboard pattern, queries must now skip these cells
+	for(PxU32 j=0;j<GRID_SIZE;j++)
+	{
+		for(PxU32 i=0;i<GRID_SIZE;i++)
+		{
+			if((i+j)&1)
+				gPruner->unloadCell(gCells[j*GRID_SIZE+i].mHandle);
+		}
+	}
+	success &= runQueries("Checkerboard");
+
+	// Shifting the origin copies the in-place data before modifying it, so the source memory must not change
+	{
+		const PxVec3 shift(3.0f, 0.0f, -2.0f);
+		const PxDefaultMemoryOutputStream& inPlaceData = gCells[1].mData;
+		const PxU32 checksumBefore = PxU32(inPlaceData.getData()[inPlaceData.getSize()/2]);
+		gPruner->shiftOrigin(shift);
+		gPruner->shiftOrigin(-shift);
+		success &= checksumBefore==PxU32(inPlaceData.getData()[inPlaceData.getSize()/2]);
+	}
+	success &= runQueries("After origin shift");
+
+	// Reload everything
+	for(PxU32 i=0;i<NB_CELLS;i++)
+	{
+		if(!gPruner->isCellLoaded(gCells[i].mHandle))
+			success &= gPruner->loadCell(gCells[i].mHandle, gCells[i].mData.getData(), gCells[i].mData.getSize());
+	}
+	success &= runQueries("Reloaded");
+
+	// Failed loads must leave the cell unloaded
+	gPruner->unloadCell(gCells[0].mHandle);
+	success &= testCorruptData();
+
+	PX_DELETE(gPruner);
+	delete [] gCells;
+	gCells = NULL;
+
+	gFoundation->release();
+
+	printf("SnippetPagedPruner %s.\n", success ? "done" : "FAILED");
+
+	return success ? 0 : 1;
+}
@@ -0,0 +1,228 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet illustrates the batched point-distance query for triangle
+// meshes, PxMeshQuery::pointDistances().
+//
+// A terrain mesh is cooked with both midphase structures (BVH33 and BVH34).
+// For each of them, the closest points of a large set of query points are
+// computed with one PxGeometryQuery::pointDistance() call per point, then with
+// PxMeshQuery::pointDistances() on the calling thread and on a CPU dispatcher.
+// The snippet prints the timings and checks that all versions find the same
+// distances. BVH34 meshes use the clustered traversal, while BVH33 meshes fall
+// back to running the single-point query for each point.
+//
+// ****************************************************************************
+
+#include "PxPhysicsAPI.h"
+#include "foundation/PxArray.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxDefaultCpuDispatcher*	gDispatcher = NULL;
+
+static const PxU32	gTerrainSize	= 128;
+static const PxU32	gNbPoints		= 20000;
+static const float	gMaxDist		= 4.0f;
+
+static float randomFloat()
+{
+	return float(rand())/float(RAND_MAX);
+}
+
+static void createTerrain(PxArray<PxVec3>& verts, PxArray<PxU32>& indices, PxU32 size)
+{
+	verts.resize((size+1)*(size+1));
+	for(PxU32 z=0;z<=size;z++)
+	{
+		for(PxU32 x=0;x<=size;x++)
+		{
+			const float h = PxSin(float(x)*0.15f)*PxCos(float(z)*0.1f)*4.0f + randomFloat()*0.2f;
+			verts[z*(size+1)+x] = PxVec3(float(x), h, float(z));
+		}
+	}
+
+	indices.resize(size*size*6);
+	PxU32* dst = indices.begin();
+	for(PxU32 z=0;z<size;z++)
+	{
+		for(PxU32 x=0;x<size;x++)
+		{
+			const PxU32 i0 = z*(size+1)+x;
+			const PxU32 i1 = i0+1;
+			const PxU32 i2 = i0+size+1;
+			const PxU32 i3 = i2+1;
+			*dst++ = i0;	*dst++ = i2;	*dst++ = i1;
+			*dst++ = i1;	*dst++ = i2;	*dst++ = i3;
+		}
+	}
+}
+
+static PxTriangleMesh* createMesh(const PxArray<PxVec3>& verts, const PxArray<PxU32>& indices, PxMeshMidPhase::Enum midphase)
+{
+	const PxTolerancesScale scale;
+	PxCookingParams params(scale);
+	params.midphaseDesc = midphase;
+
+	PxTriangleMeshDesc meshDesc;
+	meshDesc.points.count		= verts.size();
+	meshDesc.points.stride		= sizeof(PxVec3);
+	meshDesc.points.data		= verts.begin();
+	meshDesc.triangles.count	= indices.size()/3;
+	meshDesc.triangles.stride	= 3*sizeof(PxU32);
+	meshDesc.triangles.data		= indices.begin();
+
+	return PxCreateTriangleMesh(params, meshDesc);
+}
+
+static bool sameDistance(float d0, float d1)
+{
+	// PT: the closest triangle can differ when several triangles are at the same distance, but the distance cannot
+	return PxAbs(d0 - d1) <= 1e-4f * PxMax(1.0f, d0);
+}
+
+static PxU32 compareResults(const PxArray<PxMeshClosestPoint>& ref, const PxArray<PxMeshClosestPoint>& results)
+{
+	PxU32 nbMismatches = 0;
+	for(PxU32 i=0;i<ref.size();i++)
+	{
+		const bool refFound = ref[i].faceIndex != 0xffffffff;
+		const bool found = results[i].faceIndex != 0xffffffff;
+		if(refFound != found || (found && (!sameDistance(ref[i].distance, results[i].distance) || (ref[i].position - results[i].position).magnitude() > 1e-3f)))
+			nbMismatches++;
+	}
+	return nbMismatches;
+}
+
+static bool runTest(const char* name, PxTriangleMesh* mesh, const PxArray<PxVec3>& points, PxArray<PxMeshClosestPoint>& results)
+{
+	const PxTriangleMeshGeometry meshGeom(mesh);
+	const PxTransform meshPose(PxVec3(-float(gTerrainSize)*0.5f, 0.0f, -float(gTerrainSize)*0.5f), PxQuat(0.3f, PxVec3(0.0f, 1.0f, 0.0f)));
+	const PxU32 nbPoints = points.size();
+
+	// Reference: one pointDistance() call per point, filtered by gMaxDist
+	PxArray<PxMeshClosestPoint> ref(nbPoints);
+	PxU64 startTime = SnippetUtils::getCurrentTimeCounterValue();
+	for(PxU32 i=0;i<nbPoints;i++)
+	{
+		PxVec3 cp;
+		PxU32 index;
+		const float sqDist = PxGeometryQuery::pointDistance(points[i], meshGeom, meshPose, &cp, &index);
+		ref[i].faceIndex = 0xffffffff;
+		if(sqDist <= gMaxDist*gMaxDist)
+		{
+			ref[i].faceIndex = index;
+			ref[i].distance = PxSqrt(sqDist);
+			ref[i].position = cp;
+		}
+	}
+	const float refTime = SnippetUtils::getElapsedTimeInMilliseconds(SnippetUtils::getCurrentTimeCounterValue() - startTime);
+
+	startTime = SnippetUtils::getCurrentTimeCounterValue();
+	const PxU32 nbFound = PxMeshQuery::pointDistances(meshGeom, meshPose, nbPoints, points.begin(), gMaxDist, results.begin());
+	const float batchTime = SnippetUtils::getElapsedTimeInMilliseconds(SnippetUtils::getCurrentTimeCounterValue() - startTime);
+	const PxU32 nbMismatches = compareResults(ref, results);
+
+	startTime = SnippetUtils::getCurrentTimeCounterValue();
+	const PxU32 nbFoundMT = PxMeshQuery::pointDistances(meshGeom, meshPose, nbPoints, points.begin(), gMaxDist, results.begin(), gDispatcher);
+	const float batchTimeMT = SnippetUtils::getElapsedTimeInMilliseconds(SnippetUtils::getCurrentTimeCounterValue() - startTime);
+	const PxU32 nbMismatchesMT = compareResults(ref, results);
+
+	// The barycentric coordinates must give back the closest point
+	PxU32 nbBadBarycentrics = 0;
+	for(PxU32 i=0;i<nbPoints;i++)
+	{
+		const PxMeshClosestPoint& r = results[i];
+		if(r.faceIndex == 0xffffffff)
+			continue;
+		PxTriangle tri;
+		PxMeshQuery::getTriangle(meshGeom, meshPose, r.faceIndex, tri);
+		const PxVec3 p = tri.verts[0]*(1.0f - r.u - r.v) + tri.verts[1]*r.u + tri.verts[2]*r.v;
+		if((p - r.position).magnitude() > 1e-3f)
+			nbBadBarycentrics++;
+	}
+
+	PxU32 nbRefFound = 0;
+	for(PxU32 i=0;i<nbPoints;i++)
+	{
+		if(ref[i].faceIndex != 0xffffffff)
+			nbRefFound++;
+	}
+
+	printf("%s: %d points, %d within max distance\n", name, nbPoints, nbRefFound);
+	printf("%s: pointDistance loop %f ms, pointDistances %f ms, pointDistances with dispatcher %f ms\n", name, double(refTime), double(batchTime), double(batchTimeMT));
+	printf("%s: %d + %d mismatches, %d bad barycentric coordinates\n", name, nbMismatches, nbMismatchesMT, nbBadBarycentrics);
+
+	return !nbMismatches && !nbMismatchesMT && !nbBadBarycentrics && nbFound==nbRefFound && nbFoundMT==nbRefFound;
+}
+
+int snippetMain(int, const char*const*)
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+	gDispatcher = PxDefaultCpuDispatcherCreate(4);
+
+	bool success = true;
+	{
+		PxArray<PxVec3> verts;
+		PxArray<PxU32> indices;
+		createTerrain(verts, indices, gTerrainSize);
+
+		// Points around the terrain, some of them further than gMaxDist
+		PxArray<PxVec3> points(gNbPoints);
+		const float halfSize = float(gTerrainSize)*0.6f;
+		for(PxU32 i=0;i<gNbPoints;i++)
+			points[i] = PxVec3((randomFloat()*2.0f-1.0f)*halfSize, randomFloat()*16.0f - 8.0f, (randomFloat()*2.0f-1.0f)*halfSize);
+
+		PxArray<PxMeshClosestPoint> results(gNbPoints);
+
+		PxTriangleMesh* meshBVH33 = createMesh(verts, indices, PxMeshMidPhase::eBVH33);
+		PxTriangleMesh* meshBVH34 = createMesh(verts, indices, PxMeshMidPhase::eBVH34);
+		if(meshBVH33 && meshBVH34)
+		{
+			success &= runTest("BVH34", meshBVH34, points, results);
+			success &= runTest("BVH33", meshBVH33, points, results);
+		}
+		else
+			success = false;
+
+		PX_RELEASE(meshBVH33);
+		PX_RELEASE(meshBVH34);
+	}
+
+	PX_RELEASE(gDispatcher);
+	PX_RELEASE(gFoundation);
+
+	printf("SnippetPointDistanceBatch %s.\n", success ? "done" : "FAILED");
+
+	return success ? 0 : 1;
+}
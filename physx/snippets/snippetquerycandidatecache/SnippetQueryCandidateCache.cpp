@@ -0,0 +1,278 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet illustrates the use of PxQueryCandidateCache for repeated
+// overlap and sweep queries, e.g. for a character moving through a static
+// level.
+//
+// The same level is created in three scenes, using the default scene query
+// system, the external one (PxCreateExternalSceneQuerySystem) and a custom
+// one (PxCreateCustomSceneQuerySystem). A capsule then moves through each
+// level, and each frame it runs an overlap and a sweep twice: once with a
+// candidate cache and once without. The results must be the same.
+//
+// Halfway through, a new static box is added on the capsule's path. Its
+// arrival changes the static timestamps, so the cached candidates must be
+// captured again and the new box must show up in the cached queries.
+//
+// ****************************************************************************
+
+#include "PxPhysicsAPI.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxSort.h"
+#include "../snippetcommon/SnippetPrint.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxPhysics*				gPhysics	= NULL;
+static PxDefaultCpuDispatcher*	gDispatcher = NULL;
+static PxMaterial*				gMaterial	= NULL;
+
+#define GRID_SIZE			32
+#define NB_DYNAMICS			64
+#define NB_FRAMES			600
+#define MAX_NB_CANDIDATES	256
+#define MAX_NB_TOUCHES		256
+
+namespace
+{
+	enum SceneType
+	{
+		DEFAULT_SQ,
+		EXTERNAL_SQ,
+		CUSTOM_SQ
+	};
+
+	// Static actors go to the first pruner, dynamic actors to the second one. The candidate cache
+	// only caches pruners without dynamic objects, i.e. the first one here.
+	class CustomSceneQuerySystemAdapter : public PxCustomSceneQuerySystemAdapter
+	{
+		public:
+		virtual	PxU32	getPrunerIndex(const PxRigidActor& actor, const PxShape&)	const
+		{
+			return actor.is<PxRigidStatic>() ? 0 : 1;
+		}
+
+		virtual	bool	processPruner(PxU32 prunerIndex, const PxQueryThreadContext*, const PxQueryFilterData& filterData, PxQueryFilterCallback*)	const
+		{
+			return filterData.flags & (prunerIndex ? PxQueryFlag::eDYNAMIC : PxQueryFlag::eSTATIC);
+		}
+	};
+}
+
+static CustomSceneQuerySystemAdapter gAdapter;
+
+static PxScene* createScene(SceneType type)
+{
+	PxSceneDesc sceneDesc(gPhysics->getTolerancesScale());
+	sceneDesc.gravity		= PxVec3(0.0f, -9.81f, 0.0f);
+	sceneDesc.cpuDispatcher	= gDispatcher;
+	sceneDesc.filterShader	= PxDefaultSimulationFilterShader;
+
+	if(type==EXTERNAL_SQ)
+	{
+		sceneDesc.sceneQuerySystem = PxCreateExternalSceneQuerySystem(sceneDesc, 0);
+	}
+	else if(type==CUSTOM_SQ)
+	{
+		PxCustomSceneQuerySystem* customSQ = PxCreateCustomSceneQuerySystem(sceneDesc.sceneQueryUpdateMode, 0, gAdapter);
+		customSQ->addPruner(PxPruningStructureType::eDYNAMIC_AABB_TREE, PxDynamicTreeSecondaryPruner::eINCREMENTAL);
+		customSQ->addPruner(PxPruningStructureType::eDYNAMIC_AABB_TREE, PxDynamicTreeSecondaryPruner::eINCREMENTAL);
+		sceneDesc.sceneQuerySystem = customSQ;
+	}
+
+	PxScene* scene = gPhysics->createScene(sceneDesc);
+
+	scene->addActor(*PxCreatePlane(*gPhysics, PxPlane(0,1,0,0), *gMaterial));
+
+	// A grid of static pillars and boxes for the capsule to walk through
+	SnippetUtils::BasicRandom rnd(42);
+	for(PxU32 j=0;j<GRID_SIZE;j++)
+	{
+		for(PxU32 i=0;i<GRID_SIZE;i++)
+		{
+			const PxVec3 extents(rnd.rand(0.1f, 0.4f), rnd.rand(0.2f, 2.0f), rnd.rand(0.1f, 0.4f));
+			const PxVec3 pos(float(i) - float(GRID_SIZE/2) + rnd.rand(-0.3f, 0.3f), extents.y, float(j) - float(GRID_SIZE/2) + rnd.rand(-0.3f, 0.3f));
+			scene->addActor(*PxCreateStatic(*gPhysics, PxTransform(pos), PxBoxGeometry(extents), *gMaterial));
+		}
+	}
+
+	// Some dynamic objects, which are always queried as usual
+	for(PxU32 i=0;i<NB_DYNAMICS;i++)
+	{
+		const PxVec3 pos(rnd.rand(-8.0f, 8.0f), rnd.rand(3.0f, 10.0f), rnd.rand(-8.0f, 8.0f));
+		scene->addActor(*PxCreateDynamic(*gPhysics, PxTransform(pos), PxSphereGeometry(0.25f), *gMaterial, 1.0f));
+	}
+
+	return scene;
+}
+
+static PxVec3 computeCharacterPos(PxU32 frame)
+{
+	const float t = float(frame) * 0.01f;
+	return PxVec3(sinf(t*2.17f) * sinf(t) * 8.0f, 1.0f, sinf(t*0.77f) * cosf(t) * 8.0f);
+}
+
+static bool compareOverlaps(PxOverlapBufferN<MAX_NB_TOUCHES>& buf0, PxOverlapBufferN<MAX_NB_TOUCHES>& buf1)
+{
+	if(buf0.getNbTouches()!=buf1.getNbTouches())
+		return false;
+
+	// Candidates are tested in a different order than a regular traversal, so we compare sorted results
+	PxShape* shapes0[MAX_NB_TOUCHES];
+	PxShape* shapes1[MAX_NB_TOUCHES];
+	const PxU32 nb = buf0.getNbTouches();
+	for(PxU32 i=0;i<nb;i++)
+	{
+		shapes0[i] = buf0.getTouch(i).shape;
+		shapes1[i] = buf1.getTouch(i).shape;
+	}
+	PxSort(shapes0, nb);
+	PxSort(shapes1, nb);
+
+	for(PxU32 i=0;i<nb;i++)
+	{
+		if(shapes0[i]!=shapes1[i])
+			return false;
+	}
+	return true;
+}
+
+static bool compareSweeps(const PxSweepBuffer& buf0, const PxSweepBuffer& buf1)
+{
+	if(buf0.hasBlock!=buf1.hasBlock)
+		return false;
+	if(!buf0.hasBlock)
+		return true;
+	return PxAbs(buf0.block.distance - buf1.block.distance)<1e-4f;
+}
+
+static bool runTest(SceneType type, const char* name)
+{
+	PxScene* scene = createScene(type);
+
+	const PxCapsuleGeometry capsule(0.3f, 0.5f);
+	const PxQuat capsuleRot(PxHalfPi, PxVec3(0.0f, 0.0f, 1.0f));
+
+	PxQueryCandidate candidates[MAX_NB_CANDIDATES];
+	PxQueryCandidateCache candidateCache(candidates, MAX_NB_CANDIDATES, 0.5f);
+	const PxQueryCache cache(&candidateCache);
+
+	PxU32 nbOverlapErrors = 0;
+	PxU32 nbSweepErrors = 0;
+	PxU32 nbOverlapHits = 0;
+	PxRigidStatic* newBox = NULL;
+	bool newBoxFound = false;
+
+	for(PxU32 frame=0;frame<NB_FRAMES;frame++)
+	{
+		scene->simulate(1.0f/60.0f);
+		scene->fetchResults(true);
+
+		const PxVec3 pos = computeCharacterPos(frame);
+		const PxTransform pose(pos, capsuleRot);
+
+		// Halfway through, drop a new static box right on the character. This must invalidate the cached candidates.
+		if(frame==NB_FRAMES/2)
+		{
+			newBox = PxCreateStatic(*gPhysics, PxTransform(pos), PxBoxGeometry(0.2f, 0.2f, 0.2f), *gMaterial);
+			scene->addActor(*newBox);
+		}
+
+		// Overlaps
+		{
+			PxOverlapBufferN<MAX_NB_TOUCHES> cached;
+			PxOverlapBufferN<MAX_NB_TOUCHES> reference;
+			scene->overlap(capsule, pose, cached, PxQueryFilterData(), NULL, &cache);
+			scene->overlap(capsule, pose, reference);
+
+			if(!compareOverlaps(cached, reference))
+				nbOverlapErrors++;
+			nbOverlapHits += reference.getNbTouches();
+
+			if(frame==NB_FRAMES/2)
+			{
+				for(PxU32 i=0;i<cached.getNbTouches();i++)
+				{
+					if(cached.getTouch(i).actor==newBox)
+						newBoxFound = true;
+				}
+			}
+		}
+
+		// Short sweeps in the direction of motion
+		{
+			PxVec3 dir = computeCharacterPos(frame+1) - pos;
+			const float dist = dir.normalize();
+			if(dist>0.0f)
+			{
+				PxSweepBuffer cached;
+				PxSweepBuffer reference;
+				scene->sweep(capsule, pose, dir, dist*4.0f, cached, PxHitFlag::eDEFAULT, PxQueryFilterData(), NULL, &cache);
+				scene->sweep(capsule, pose, dir, dist*4.0f, reference);
+
+				if(!compareSweeps(cached, reference))
+					nbSweepErrors++;
+			}
+		}
+	}
+
+	printf("%s: %d overlap hits, cache hit rate %.2f, %d overlap mismatches, %d sweep mismatches, new static box %s.\n",
+		name, nbOverlapHits, double(candidateCache.getHitRate()), nbOverlapErrors, nbSweepErrors, newBoxFound ? "found" : "NOT found");
+
+	scene->release();
+
+	return !nbOverlapErrors && !nbSweepErrors && newBoxFound && candidateCache.nbHits;
+}
+
+int snippetMain(int, const char*const*)
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale(), true);
+	gDispatcher = PxDefaultCpuDispatcherCreate(2);
+	gMaterial = gPhysics->createMaterial(0.5f, 0.5f, 0.6f);
+
+	bool success = true;
+	success &= runTest(DEFAULT_SQ, "Default scene query system");
+	success &= runTest(EXTERNAL_SQ, "External scene query system");
+	success &= runTest(CUSTOM_SQ, "Custom scene query system");
+
+	PX_RELEASE(gMaterial);
+	PX_RELEASE(gDispatcher);
+	PX_RELEASE(gPhysics);
+	PX_RELEASE(gFoundation);
+
+	printf("SnippetQueryCandidateCache %s.\n", success ? "done" : "FAILED");
+
+	return success ? 0 : 1;
+}
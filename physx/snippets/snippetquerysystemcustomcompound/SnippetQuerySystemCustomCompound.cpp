@@ -500,7 +500,7 @@ CustomScene::CustomScene() : mNbObjects(0)
 {
 	const PxU64 contextID = PxU64(this);
 	mQuerySystem = PX_NEW(QuerySystem)(contextID, gBoundsInflation, *this);
-	Pruner* pruner = createAABBPruner(contextID, true, COMPANION_PRUNER_INCREMENTAL, BVH_SPLATTER_POINTS, 4);
+	Pruner* pruner = createAABBPruner(contextID, true, COMPANION_PRUNER_INCREMENTAL, BVH_SPLATTER_POINTS, 4, BVH_BINARY);
 	mPrunerIndex = mQuerySystem->addPruner(pruner, 0);
 
 	const PxU32 nb = gFactor[gSceneIndex];
@@ -0,0 +1,352 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+
+// ****************************************************************************
+// This snippet measures the cost of capturing and restoring scene snapshots,
+// i.e. the poses, velocities and sleep state of the dynamic actors.
+//
+// It creates a scene with stacks of boxes and articulated chains, simulates
+// it, and captures a snapshot after each frame with a PxSceneSnapshotContext.
+// A full snapshot is captured at regular intervals, and delta snapshots that
+// only contain the state that changed since the previous snapshot otherwise.
+// The stacks fall asleep over time, and the size of the delta snapshots drops
+// accordingly.
+//
+// The scene is then rolled back several frames, by restoring the last full
+// snapshot before the target frame and the delta snapshots after it, and
+// simulated again up to the last frame. Snapshots do not contain the
+// low-level state of the simulation, such as contact caches, so restoring
+// them is not an exact rollback. The resimulated poses are reported as a
+// difference to the original run.
+//
+// Finally, one of the chains is removed, extended and added back, and the
+// snapshots captured before and after the change are restored again.
+// ****************************************************************************
+
+#include "PxPhysicsAPI.h"
+#include "foundation/PxArray.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxPhysics*				gPhysics	= NULL;
+static PxDefaultCpuDispatcher*	gDispatcher = NULL;
+static PxScene*					gScene		= NULL;
+static PxMaterial*				gMaterial	= NULL;
+
+static const PxU32	gNbStacks			= 16;
+static const PxU32	gStackSize			= 12;
+static const PxU32	gNbChains			= 16;
+static const PxU32	gNbChainLinks		= 8;
+static const PxU32	gNbFrames			= 240;
+static const PxU32	gKeyframeInterval	= 30;	// A full snapshot is captured every gKeyframeInterval frames
+static const PxU32	gRollbackFrames		= 45;
+static const PxReal	gTimeStep			= 1.0f/60.0f;
+
+namespace
+{
+	class Timer
+	{
+		public:
+			Timer() : mStartTime(SnippetUtils::getCurrentTimeCounterValue())	{}
+
+			float	getElapsedTime()	const
+			{
+				const PxU64 stopTime = SnippetUtils::getCurrentTimeCounterValue();
+				return SnippetUtils::getElapsedTimeInMilliseconds(stopTime - mStartTime);
+			}
+		private:
+			PxU64	mStartTime;
+	};
+
+	// Snapshots of all frames, stored back to back. Snapshot buffers must be 4-byte aligned.
+	class SnapshotStore
+	{
+		public:
+			void			add(const PxU32* data, PxU32 size)
+			{
+				mOffsets.pushBack(mData.size());
+				mSizes.pushBack(size);
+				for(PxU32 i=0;i<size/sizeof(PxU32);i++)
+					mData.pushBack(data[i]);
+			}
+
+			const void*		getData(PxU32 frame)	const	{ return mData.begin() + mOffsets[frame];	}
+			PxU32			getSize(PxU32 frame)	const	{ return mSizes[frame];	}
+		private:
+			PxArray<PxU32>	mData;
+			PxArray<PxU32>	mOffsets;
+			PxArray<PxU32>	mSizes;
+	};
+}
+
+static void createStack(const PxTransform& t, PxU32 size, PxReal halfExtent)
+{
+	PxShape* shape = gPhysics->createShape(PxBoxGeometry(halfExtent, halfExtent, halfExtent), *gMaterial);
+	for(PxU32 i=0; i<size;i++)
+	{
+		for(PxU32 j=0;j<size-i;j++)
+		{
+			const PxTransform localTm(PxVec3(PxReal(j*2) - PxReal(size-i), PxReal(i*2+1), 0) * halfExtent);
+			PxRigidDynamic* body = gPhysics->createRigidDynamic(t.transform(localTm));
+			body->attachShape(*shape);
+			PxRigidBodyExt::updateMassAndInertia(*body, 10.0f);
+			gScene->addActor(*body);
+		}
+	}
+	shape->release();
+}
+
+static const PxReal gChainHalfLength = 0.25f;
+
+// Appends a capsule to the last link of a chain
+static PxArticulationLink* addChainLink(PxArticulationReducedCoordinate* articulation, PxArticulationLink* link, const PxVec3& pos, bool first)
+{
+	PxArticulationLink* child = articulation->createLink(link, PxTransform(pos));
+	PxRigidActorExt::createExclusiveShape(*child, PxCapsuleGeometry(0.05f, gChainHalfLength), *gMaterial);
+	PxRigidBodyExt::updateMassAndInertia(*child, 1.0f);
+
+	PxArticulationJointReducedCoordinate* joint = child->getInboundJoint();
+	joint->setJointType(PxArticulationJointType::eREVOLUTE);
+	joint->setMotion(PxArticulationAxis::eSWING2, PxArticulationMotion::eFREE);
+	joint->setParentPose(PxTransform(first ? PxVec3(0.0f) : PxVec3(gChainHalfLength, 0.0f, 0.0f)));
+	joint->setChildPose(PxTransform(PxVec3(-gChainHalfLength, 0.0f, 0.0f)));
+	return child;
+}
+
+// A chain of capsules hanging from a fixed base, released from a horizontal position so that it keeps swinging
+static void createChain(const PxVec3& pos)
+{
+	PxArticulationReducedCoordinate* articulation = gPhysics->createArticulationReducedCoordinate();
+	articulation->setArticulationFlag(PxArticulationFlag::eFIX_BASE, true);
+	articulation->setSleepThreshold(0.0f);
+
+	PxArticulationLink* link = articulation->createLink(NULL, PxTransform(pos));
+	PxRigidActorExt::createExclusiveShape(*link, PxSphereGeometry(0.1f), *gMaterial);
+	PxRigidBodyExt::updateMassAndInertia(*link, 1.0f);
+
+	for(PxU32 i=0;i<gNbChainLinks;i++)
+		link = addChainLink(articulation, link, pos + PxVec3(gChainHalfLength*PxReal(2*i+1), 0.0f, 0.0f), i==0);
+
+	gScene->addArticulation(*articulation);
+}
+
+// Removes a chain from the scene, adds a link at its end and adds it back. Links can only be created while the
+// articulation is not in a scene.
+static void extendChain(PxArticulationReducedCoordinate* articulation)
+{
+	gScene->removeArticulation(*articulation);
+
+	const PxU32 nbLinks = articulation->getNbLinks();
+	PxArticulationLink* link;
+	articulation->getLinks(&link, 1, nbLinks-1);
+	const PxVec3 pos = link->getGlobalPose().transform(PxVec3(gChainHalfLength*2.0f, 0.0f, 0.0f));
+	addChainLink(articulation, link, pos, false);
+
+	gScene->addArticulation(*articulation);
+}
+
+static void initPhysics()
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale());
+	PxInitExtensions(*gPhysics, NULL);
+
+	PxSceneDesc sceneDesc(gPhysics->getTolerancesScale());
+	sceneDesc.gravity = PxVec3(0.0f, -9.81f, 0.0f);
+	gDispatcher = PxDefaultCpuDispatcherCreate(2);
+	sceneDesc.cpuDispatcher	= gDispatcher;
+	sceneDesc.filterShader	= PxDefaultSimulationFilterShader;
+	gScene = gPhysics->createScene(sceneDesc);
+
+	gMaterial = gPhysics->createMaterial(0.5f, 0.5f, 0.6f);
+
+	PxRigidStatic* groundPlane = PxCreatePlane(*gPhysics, PxPlane(0,1,0,0), *gMaterial);
+	gScene->addActor(*groundPlane);
+
+	for(PxU32 i=0;i<gNbStacks;i++)
+		createStack(PxTransform(PxVec3(PxReal(i%4)*15.0f, 0.0f, PxReal(i/4)*15.0f)), gStackSize, 0.5f);
+
+	for(PxU32 i=0;i<gNbChains;i++)
+		createChain(PxVec3(0.0f, 10.0f, -20.0f - PxReal(i)));
+}
+
+static void stepPhysics()
+{
+	gScene->simulate(gTimeStep);
+	gScene->fetchResults(true);
+}
+
+static void getPoses(PxArray<PxVec3>& positions)
+{
+	PxArray<PxActor*> actors(gScene->getNbActors(PxActorTypeFlag::eRIGID_DYNAMIC));
+	gScene->getActors(PxActorTypeFlag::eRIGID_DYNAMIC, actors.begin(), actors.size());
+
+	positions.clear();
+	for(PxU32 i=0;i<actors.size();i++)
+		positions.pushBack(static_cast<PxRigidDynamic*>(actors[i])->getGlobalPose().p);
+
+	const PxU32 nbArticulations = gScene->getNbArticulations();
+	for(PxU32 i=0;i<nbArticulations;i++)
+	{
+		PxArticulationReducedCoordinate* articulation;
+		gScene->getArticulations(&articulation, 1, i);
+
+		const PxU32 nbLinks = articulation->getNbLinks();
+		for(PxU32 j=0;j<nbLinks;j++)
+		{
+			PxArticulationLink* link;
+			articulation->getLinks(&link, 1, j);
+			positions.pushBack(link->getGlobalPose().p);
+		}
+	}
+}
+
+static void runBenchmark()
+{
+	PxSceneSnapshotContext* context = PxCreateSceneSnapshotContext(*gScene);
+
+	PxArray<PxU32> buffer(context->getMaxSnapshotSize()/sizeof(PxU32));
+	SnapshotStore store;
+
+	// The first capture also registers all actors with the context
+	float firstTime;
+	{
+		Timer timer;
+		const PxU32 size = context->capture(buffer.begin(), buffer.size()*sizeof(PxU32), true);
+		firstTime = timer.getElapsedTime();
+		store.add(buffer.begin(), size);
+	}
+
+	float fullTime = 0.0f, deltaTime = 0.0f;
+	PxU32 fullSize = 0, deltaSize = 0, lastDeltaSize = 0;
+	for(PxU32 frame=1;frame<=gNbFrames;frame++)
+	{
+		stepPhysics();
+
+		const bool fullSnapshot = !(frame % gKeyframeInterval);
+
+		Timer timer;
+		const PxU32 size = context->capture(buffer.begin(), buffer.size()*sizeof(PxU32), fullSnapshot);
+		const float captureTime = timer.getElapsedTime();
+
+		if(fullSnapshot)
+		{
+			fullTime += captureTime;
+			fullSize += size;
+		}
+		else
+		{
+			deltaTime += captureTime;
+			deltaSize += size;
+			lastDeltaSize = size;
+		}
+		store.add(buffer.begin(), size);
+	}
+
+	const PxU32 nbFull = gNbFrames/gKeyframeInterval;
+	const PxU32 nbDelta = gNbFrames - nbFull;
+	printf("Scene: %d rigid dynamics, %d articulations\n", gScene->getNbActors(PxActorTypeFlag::eRIGID_DYNAMIC), gScene->getNbArticulations());
+	printf("First snapshot: capture %.3f ms, size %d bytes\n", double(firstTime), store.getSize(0));
+	printf("Full snapshots: %d, average capture %.3f ms, average size %d bytes\n", nbFull, double(fullTime/float(nbFull)), fullSize/nbFull);
+	printf("Delta snapshots: %d, average capture %.3f ms, average size %d bytes, last %d bytes\n", nbDelta, double(deltaTime/float(nbDelta)), deltaSize/nbDelta, lastDeltaSize);
+
+	PxArray<PxVec3> originalPositions;
+	getPoses(originalPositions);
+
+	// Roll back to an earlier frame: restore the previous full snapshot, then all delta snapshots up to that frame
+	const PxU32 targetFrame = gNbFrames - gRollbackFrames;
+	const PxU32 keyframe = targetFrame - targetFrame % gKeyframeInterval;
+	float restoreTime;
+	{
+		Timer timer;
+		for(PxU32 frame=keyframe;frame<=targetFrame;frame++)
+			context->restore(store.getData(frame), store.getSize(frame));
+		restoreTime = timer.getElapsedTime();
+	}
+	printf("Rollback to frame %d: restored %d snapshots in %.3f ms\n", targetFrame, targetFrame - keyframe + 1, double(restoreTime));
+
+	for(PxU32 frame=targetFrame;frame<gNbFrames;frame++)
+		stepPhysics();
+
+	PxArray<PxVec3> positions;
+	getPoses(positions);
+	PxReal maxError = 0.0f;
+	for(PxU32 i=0;i<positions.size();i++)
+		maxError = PxMax(maxError, (positions[i] - originalPositions[i]).magnitude());
+	printf("Resimulated %d frames, largest position difference to the original run: %f\n", gRollbackFrames, double(maxError));
+
+	// Change the structure of a chain between two snapshots. The context tracks the new layout of its state, and the state
+	// captured before the change no longer applies to it.
+	PxArticulationReducedCoordinate* chain;
+	gScene->getArticulations(&chain, 1, 0);
+	const PxU32 baseSize = context->capture(buffer.begin(), buffer.size()*sizeof(PxU32), true);
+	SnapshotStore changeStore;
+	changeStore.add(buffer.begin(), baseSize);
+
+	extendChain(chain);
+	stepPhysics();
+	buffer.resize(context->getMaxSnapshotSize()/sizeof(PxU32));
+	const PxU32 changeSize = context->capture(buffer.begin(), buffer.size()*sizeof(PxU32));
+	changeStore.add(buffer.begin(), changeSize);
+
+	getPoses(originalPositions);
+	for(PxU32 i=0;i<10;i++)
+		stepPhysics();
+
+	const bool restored = context->restore(changeStore.getData(0), changeStore.getSize(0)) && context->restore(changeStore.getData(1), changeStore.getSize(1));
+	getPoses(positions);
+	maxError = 0.0f;
+	for(PxU32 i=0;i<positions.size();i++)
+		maxError = PxMax(maxError, (positions[i] - originalPositions[i]).magnitude());
+	printf("Extended a chain to %d links: delta snapshot %d bytes, restored %s, largest position difference: %f\n", chain->getNbLinks(), changeSize, restored ? "yes" : "no", double(maxError));
+
+	context->release();
+}
+
+static void cleanupPhysics()
+{
+	PX_RELEASE(gScene);
+	PX_RELEASE(gDispatcher);
+	PxCloseExtensions();
+	PX_RELEASE(gPhysics);
+	PX_RELEASE(gFoundation);
+}
+
+int snippetMain(int, const char*const*)
+{
+	initPhysics();
+	runBenchmark();
+	cleanupPhysics();
+
+	printf("SnippetSceneSnapshot done.\n");
+
+	return 0;
+}
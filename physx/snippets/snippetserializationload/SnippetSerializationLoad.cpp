@@ -0,0 +1,332 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+
+// ****************************************************************************
+// This snippet measures the time needed to deserialize a large binary collection.
+//
+// It creates a level made of many jointed actors, plus a shared collection with
+// materials and meshes, and serializes both to memory. The level collection is
+// then deserialized several times, first on the calling thread and then with
+// CPU dispatchers that have an increasing number of worker threads. The
+// dispatcher is passed to PxSerialization::createCollectionFromBinary. The
+// deserialized actors are added to a scene, which is simulated for a frame, so
+// that the data is known to be valid.
+//
+// Finally the level is loaded with a PxStreamingCollectionLoader, which spreads
+// reading, deserialization and scene insertion over several simulated frames
+// under a per-frame time budget. The longest update is compared to the time
+// needed to deserialize the level and add it to the scene at once.
+// ****************************************************************************
+
+#include "PxPhysicsAPI.h"
+#include "extensions/PxCollectionExt.h"
+#include "foundation/PxArray.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxPhysics*				gPhysics	= NULL;
+
+static const PxU32	gNbActors		= 50000;
+static const PxU32	gNbMaterials	= 8;
+static const PxReal	gTimeBudget		= 0.002f;	// Streaming time budget per frame, in seconds
+
+namespace
+{
+	class Timer
+	{
+		public:
+			Timer() : mStartTime(SnippetUtils::getCurrentTimeCounterValue())	{}
+
+			float	getElapsedTime()	const
+			{
+				const PxU64 stopTime = SnippetUtils::getCurrentTimeCounterValue();
+				return SnippetUtils::getElapsedTimeInMilliseconds(stopTime - mStartTime);
+			}
+		private:
+			PxU64	mStartTime;
+	};
+
+	// Binary collections must be deserialized from 128-byte aligned memory
+	class AlignedBlock
+	{
+		public:
+			AlignedBlock(PxU32 size)	{ mBase = static_cast<PxU8*>(malloc(size + PX_SERIAL_FILE_ALIGN - 1));	}
+			~AlignedBlock()				{ free(mBase);	}
+
+			void*	get()	const		{ return reinterpret_cast<void*>((size_t(mBase) + PX_SERIAL_FILE_ALIGN - 1) & ~size_t(PX_SERIAL_FILE_ALIGN - 1));	}
+		private:
+			PxU8*	mBase;
+	};
+}
+
+static PxConvexMesh* createConvexMesh()
+{
+	SnippetUtils::BasicRandom rnd(42);
+	PxVec3 points[32];
+	for(PxU32 i=0;i<32;i++)
+		points[i] = rnd.unitRandomPt() * 0.5f;
+
+	PxConvexMeshDesc convexDesc;
+	convexDesc.points.count		= 32;
+	convexDesc.points.stride	= sizeof(PxVec3);
+	convexDesc.points.data		= points;
+	convexDesc.flags			= PxConvexFlag::eCOMPUTE_CONVEX;
+
+	PxCookingParams params(gPhysics->getTolerancesScale());
+	return PxCreateConvexMesh(params, convexDesc, gPhysics->getPhysicsInsertionCallback());
+}
+
+/**
+Releases the joints and actors of a level collection, and the collection itself. Releasing joints and actors also releases
+their constraints and exclusive shapes, so the objects are gathered before releasing anything. Deserialized shapes hold a
+reference of their own, like shapes created with PxPhysics::createShape, which is released as well.
+*/
+static void releaseLevel(PxCollection& levelCollection, bool deserialized)
+{
+	PxArray<PxJoint*> joints;
+	PxArray<PxRigidActor*> actors;
+	PxArray<PxShape*> shapes;
+	for(PxU32 i=0;i<levelCollection.getNbObjects();i++)
+	{
+		PxBase& object = levelCollection.getObject(i);
+		if(PxJoint* joint = object.is<PxJoint>())
+			joints.pushBack(joint);
+		else if(PxRigidActor* actor = object.is<PxRigidActor>())
+			actors.pushBack(actor);
+		else if(deserialized && object.is<PxShape>())
+			shapes.pushBack(object.is<PxShape>());
+	}
+	levelCollection.release();
+
+	for(PxU32 i=0;i<joints.size();i++)
+		joints[i]->release();
+	for(PxU32 i=0;i<actors.size();i++)
+		actors[i]->release();
+	for(PxU32 i=0;i<shapes.size();i++)
+		shapes[i]->release();
+}
+
+/**
+Creates the shared collection (materials and meshes) and the level collection (actors, shapes and joints), and serializes
+them to the given streams.
+*/
+static void serializeObjects(PxSerializationRegistry& sr, PxOutputStream& sharedStream, PxOutputStream& levelStream)
+{
+	PxCollection* sharedCollection = PxCreateCollection();
+	PxCollection* levelCollection = PxCreateCollection();
+
+	PxMaterial* materials[gNbMaterials];
+	for(PxU32 i=0;i<gNbMaterials;i++)
+	{
+		materials[i] = gPhysics->createMaterial(0.5f, 0.5f, PxReal(i)/PxReal(gNbMaterials));
+		sharedCollection->add(*materials[i]);
+	}
+
+	PxConvexMesh* convexMesh = createConvexMesh();
+	sharedCollection->add(*convexMesh);
+	PxSerialization::createSerialObjectIds(*sharedCollection, PxSerialObjectId(1));
+
+	// Chains of jointed dynamic actors with boxes, spheres and convexes
+	PxRigidDynamic* previous = NULL;
+	for(PxU32 i=0;i<gNbActors;i++)
+	{
+		const PxTransform pose(PxVec3(PxReal(i%100)*2.0f, 2.0f + PxReal((i/100)%10)*2.0f, PxReal(i/1000)*2.0f));
+		PxMaterial& material = *materials[i%gNbMaterials];
+
+		PxRigidDynamic* actor;
+		if(i%3==0)
+			actor = PxCreateDynamic(*gPhysics, pose, PxBoxGeometry(0.5f, 0.5f, 0.5f), material, 1.0f);
+		else if(i%3==1)
+			actor = PxCreateDynamic(*gPhysics, pose, PxSphereGeometry(0.5f), material, 1.0f);
+		else
+			actor = PxCreateDynamic(*gPhysics, pose, PxConvexMeshGeometry(convexMesh), material, 1.0f);
+		levelCollection->add(*actor);
+
+		if(previous && i%10)
+		{
+			PxSphericalJoint* joint = PxSphericalJointCreate(*gPhysics, previous, PxTransform(PxVec3(1.0f, 0.0f, 0.0f)), actor, PxTransform(PxVec3(-1.0f, 0.0f, 0.0f)));
+			levelCollection->add(*joint);
+		}
+		previous = actor;
+	}
+	PxSerialization::complete(*levelCollection, sr, sharedCollection);
+
+	PxSerialization::serializeCollectionToBinary(sharedStream, *sharedCollection, sr);
+	PxSerialization::serializeCollectionToBinary(levelStream, *levelCollection, sr, sharedCollection);
+
+	printf("Level collection: %d objects, %d bytes\n", levelCollection->getNbObjects(), static_cast<PxDefaultMemoryOutputStream&>(levelStream).getSize());
+
+	releaseLevel(*levelCollection, false);
+
+	convexMesh->release();
+	for(PxU32 i=0;i<gNbMaterials;i++)
+		materials[i]->release();
+	sharedCollection->release();
+}
+
+static PxScene* createScene(PxCpuDispatcher& dispatcher)
+{
+	PxSceneDesc sceneDesc(gPhysics->getTolerancesScale());
+	sceneDesc.gravity = PxVec3(0.0f, -9.81f, 0.0f);
+	sceneDesc.cpuDispatcher	= &dispatcher;
+	sceneDesc.filterShader	= PxDefaultSimulationFilterShader;
+	return gPhysics->createScene(sceneDesc);
+}
+
+/**
+Deserializes the level collection, adds it to a scene and simulates one frame. Returns the deserialization time.
+*/
+static float loadLevel(PxSerializationRegistry& sr, const PxDefaultMemoryOutputStream& levelStream, PxCollection& sharedCollection, PxCpuDispatcher* loadDispatcher)
+{
+	AlignedBlock block(levelStream.getSize());
+	PxMemCopy(block.get(), levelStream.getData(), levelStream.getSize());
+
+	float loadTime;
+	PxCollection* levelCollection;
+	{
+		Timer timer;
+		levelCollection = PxSerialization::createCollectionFromBinary(block.get(), sr, &sharedCollection, loadDispatcher);
+		loadTime = timer.getElapsedTime();
+	}
+
+	PxDefaultCpuDispatcher* sceneDispatcher = PxDefaultCpuDispatcherCreate(0);
+	PxScene* scene = createScene(*sceneDispatcher);
+
+	scene->addCollection(*levelCollection);
+	scene->simulate(1.0f/60.0f);
+	scene->fetchResults(true);
+
+	// Deserialized objects live in the memory block, so they must be released before the block is freed
+	scene->release();
+	releaseLevel(*levelCollection, true);
+	sceneDispatcher->release();
+
+	return loadTime;
+}
+
+/**
+Loads the level collection with a streaming loader, simulating the scene between updates. Prints the number of frames and the longest frame.
+*/
+static void streamLevel(PxSerializationRegistry& sr, const PxDefaultMemoryOutputStream& levelStream, PxCollection& sharedCollection)
+{
+	PxDefaultCpuDispatcher* sceneDispatcher = PxDefaultCpuDispatcherCreate(0);
+	PxScene* scene = createScene(*sceneDispatcher);
+
+	// Blocking load for reference: the whole level is deserialized and added to the scene at once
+	float blockingLoadTime;
+	{
+		AlignedBlock block(levelStream.getSize());
+		PxMemCopy(block.get(), levelStream.getData(), levelStream.getSize());
+
+		Timer timer;
+		PxCollection* levelCollection = PxSerialization::createCollectionFromBinary(block.get(), sr, &sharedCollection);
+		scene->addCollection(*levelCollection);
+		blockingLoadTime = timer.getElapsedTime();
+
+		PxCollectionExt::releaseObjects(*levelCollection);
+		levelCollection->release();
+	}
+
+	PxDefaultMemoryInputData input(const_cast<PxU8*>(levelStream.getData()), levelStream.getSize());
+	PxStreamingCollectionLoaderDesc loaderDesc;
+	PxStreamingCollectionLoader* loader = PxSerialization::createStreamingCollectionLoader(input, sr, *scene, loaderDesc, &sharedCollection);
+
+	// The scene is simulated between updates, with the part of the level loaded so far
+	PxU32 nbFrames = 0;
+	float maxUpdateTime = 0.0f;
+	while(loader->getState() != PxStreamingCollectionLoaderState::eCOMPLETE && loader->getState() != PxStreamingCollectionLoaderState::eFAILED)
+	{
+		{
+			Timer timer;
+			loader->update(gTimeBudget);
+			maxUpdateTime = PxMax(maxUpdateTime, timer.getElapsedTime());
+		}
+		scene->simulate(1.0f/60.0f);
+		scene->fetchResults(true);
+		nbFrames++;
+	}
+
+	printf("Blocking load: %.2f ms\n", double(blockingLoadTime));
+	printf("Streaming load with a %.1f ms budget: %d frames, longest update %.2f ms (%d actors)\n", double(gTimeBudget*1000.0f), nbFrames, double(maxUpdateTime),
+		scene->getNbActors(PxActorTypeFlag::eRIGID_DYNAMIC));
+
+	// The loader releases the level objects and removes them from the scene
+	loader->release();
+	scene->release();
+	sceneDispatcher->release();
+}
+
+static void runBenchmark()
+{
+	PxSerializationRegistry* sr = PxSerialization::createSerializationRegistry(*gPhysics);
+
+	PxDefaultMemoryOutputStream sharedStream;
+	PxDefaultMemoryOutputStream levelStream;
+	serializeObjects(*sr, sharedStream, levelStream);
+
+	// The shared collection is loaded once and referenced by each instance of the level
+	AlignedBlock sharedBlock(sharedStream.getSize());
+	PxMemCopy(sharedBlock.get(), sharedStream.getData(), sharedStream.getSize());
+	PxCollection* sharedCollection = PxSerialization::createCollectionFromBinary(sharedBlock.get(), *sr);
+
+	printf("Deserialization on the calling thread: %.2f ms\n", double(loadLevel(*sr, levelStream, *sharedCollection, NULL)));
+
+	const PxU32 nbThreads[] = { 2, 4, 8 };
+	for(PxU32 i=0;i<PX_ARRAY_SIZE(nbThreads);i++)
+	{
+		PxDefaultCpuDispatcher* dispatcher = PxDefaultCpuDispatcherCreate(nbThreads[i]);
+		printf("Deserialization with %d worker threads: %.2f ms\n", nbThreads[i], double(loadLevel(*sr, levelStream, *sharedCollection, dispatcher)));
+		dispatcher->release();
+	}
+
+	streamLevel(*sr, levelStream, *sharedCollection);
+
+	for(PxU32 i=0;i<sharedCollection->getNbObjects();i++)
+		sharedCollection->getObject(i).release();
+	sharedCollection->release();
+	sr->release();
+}
+
+int snippetMain(int, const char*const*)
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale());
+	PxInitExtensions(*gPhysics, NULL);
+
+	runBenchmark();
+
+	PxCloseExtensions();
+	PX_RELEASE(gPhysics);
+	PX_RELEASE(gFoundation);
+	printf("SnippetSerializationLoad done.\n");
+
+	return 0;
+}
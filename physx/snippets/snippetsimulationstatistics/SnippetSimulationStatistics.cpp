@@ -0,0 +1,203 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+// ****************************************************************************
+// This snippet illustrates how to read the timings of a simulation step.
+//
+// After PxScene::fetchResults() the simulation statistics contain the wall
+// time and the CPU time of each phase of the step, the number of tasks it
+// ran, and how busy each worker thread was. No profiler is needed.
+//
+// The statistics also report how much scratch memory each part of the step
+// needed, so that the scratch block passed to PxScene::simulate() can be
+// sized to avoid heap allocations during the step.
+//
+// The snippet simulates a few box stacks with several worker threads and
+// prints the timings of a couple of frames. It then simulates with a
+// scratch block sized from the statistics of the first frames.
+// ****************************************************************************
+
+#include <stdio.h>
+#include "PxPhysicsAPI.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxPhysics*				gPhysics	= NULL;
+static PxDefaultCpuDispatcher*	gDispatcher = NULL;
+static PxScene*					gScene		= NULL;
+static PxMaterial*				gMaterial	= NULL;
+static void*					gScratchBlock		= NULL;
+static PxU32					gScratchBlockSize	= 0;
+
+static const char* gPhaseNames[PxSimulationStatistics::ePHASE_COUNT] =
+{
+	"Broad phase",
+	"Narrow phase",
+	"Island gen",
+	"Solver setup",
+	"Solver",
+	"Integration",
+	"CCD",
+	"SQ update",
+	"Fetch results"
+};
+
+static const char* gScratchUsageNames[PxSimulationStatistics::eSCRATCH_USAGE_COUNT] =
+{
+	"Broad phase",
+	"Narrow phase",
+	"Solver",
+	"Projection",
+	"Other"
+};
+
+static void createStack(const PxTransform& t, PxU32 size, PxReal halfExtent)
+{
+	PxShape* shape = gPhysics->createShape(PxBoxGeometry(halfExtent, halfExtent, halfExtent), *gMaterial);
+	for(PxU32 i=0; i<size;i++)
+	{
+		for(PxU32 j=0;j<size-i;j++)
+		{
+			PxTransform localTm(PxVec3(PxReal(j*2) - PxReal(size-i), PxReal(i*2+1), 0) * halfExtent);
+			PxRigidDynamic* body = gPhysics->createRigidDynamic(t.transform(localTm));
+			body->attachShape(*shape);
+			PxRigidBodyExt::updateMassAndInertia(*body, 10.0f);
+			gScene->addActor(*body);
+		}
+	}
+	shape->release();
+}
+
+static void initPhysics()
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale(), true);
+
+	PxSceneDesc sceneDesc(gPhysics->getTolerancesScale());
+	sceneDesc.gravity = PxVec3(0.0f, -9.81f, 0.0f);
+	gDispatcher = PxDefaultCpuDispatcherCreate(4);
+	sceneDesc.cpuDispatcher	= gDispatcher;
+	sceneDesc.filterShader	= PxDefaultSimulationFilterShader;
+	gScene = gPhysics->createScene(sceneDesc);
+
+	gMaterial = gPhysics->createMaterial(0.5f, 0.5f, 0.6f);
+
+	PxRigidStatic* groundPlane = PxCreatePlane(*gPhysics, PxPlane(0,1,0,0), *gMaterial);
+	gScene->addActor(*groundPlane);
+
+	PxReal stackZ = 10.0f;
+	for(PxU32 i=0;i<10;i++)
+		createStack(PxTransform(PxVec3(0,0,stackZ-=10.0f)), 10, 2.0f);
+}
+
+static void stepPhysics()
+{
+	gScene->simulate(1.0f/60.0f, NULL, gScratchBlock, gScratchBlockSize);
+	gScene->fetchResults(true);
+}
+
+static void printTimings(PxU32 frame)
+{
+	PxSimulationStatistics stats;
+	gScene->getSimulationStatistics(stats);
+
+	printf("Frame %d: %.3f ms\n", frame, double(stats.simulationWallTime));
+
+	printf("  %-14s %10s %10s %6s\n", "Phase", "Wall (ms)", "CPU (ms)", "Tasks");
+	for(PxU32 i=0;i<PxSimulationStatistics::ePHASE_COUNT;i++)
+		printf("  %-14s %10.3f %10.3f %6d\n", gPhaseNames[i], double(stats.phaseWallTime[i]), double(stats.phaseCpuTime[i]), stats.phaseNbTasks[i]);
+
+	printf("  %-14s %10s %10s %6s\n", "Worker", "Busy (ms)", "Idle (ms)", "Tasks");
+	for(PxU32 i=0;i<stats.nbWorkers;i++)
+		printf("  %-14d %10.3f %10.3f %6d\n", i, double(stats.workerBusyTime[i]), double(stats.workerIdleTime[i]), stats.workerNbTasks[i]);
+}
+
+static void printScratchUsage()
+{
+	PxSimulationStatistics stats;
+	gScene->getSimulationStatistics(stats);
+
+	printf("  %-14s %10s\n", "Scratch user", "Peak (kB)");
+	for(PxU32 i=0;i<PxSimulationStatistics::eSCRATCH_USAGE_COUNT;i++)
+		printf("  %-14s %10.1f\n", gScratchUsageNames[i], double(stats.scratchPeakBytes[i])/1024.0);
+
+	printf("  Scratch peak %.1f kB, %.1f kB from the heap, block %.1f kB\n", double(stats.scratchPeakTotalBytes)/1024.0,
+		double(stats.scratchHeapFallbackBytes)/1024.0, double(gScratchBlockSize)/1024.0);
+	printf("  Task pool %.1f kB, peak %.1f kB\n", double(stats.taskPoolBytes)/1024.0, double(stats.taskPoolPeakBytes)/1024.0);
+}
+
+static void cleanupPhysics()
+{
+	PX_RELEASE(gScene);
+	PX_RELEASE(gDispatcher);
+	PX_RELEASE(gPhysics);
+	PX_RELEASE(gFoundation);
+	if(gScratchBlock)
+		gAllocator.deallocate(gScratchBlock);
+
+	printf("SnippetSimulationStatistics done.\n");
+}
+
+int snippetMain(int, const char*const*)
+{
+	static const PxU32 frameCount = 100;
+	static const PxU32 sizingFrameCount = 50;
+	initPhysics();
+	PxU32 scratchPeak = 0;
+	for(PxU32 i=0; i<frameCount; i++)
+	{
+		stepPhysics();
+
+		// The first frames create the contact pairs, later ones mostly solve the stacks.
+		if(i==1 || i==frameCount-1)
+		{
+			printTimings(i);
+			printScratchUsage();
+		}
+
+		// Size the scratch block from the peak usage of the first frames. The size must be a multiple of 16K.
+		if(i<sizingFrameCount)
+		{
+			PxSimulationStatistics stats;
+			gScene->getSimulationStatistics(stats);
+			scratchPeak = PxMax(scratchPeak, stats.scratchPeakTotalBytes);
+		}
+		else if(!gScratchBlock && scratchPeak)
+		{
+			gScratchBlockSize = (scratchPeak + 16383) & ~16383;
+			gScratchBlock = gAllocator.allocate(gScratchBlockSize, "ScratchBlock", __FILE__, __LINE__);
+		}
+	}
+	cleanupPhysics();
+
+	return 0;
+}
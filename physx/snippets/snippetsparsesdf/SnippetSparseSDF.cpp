@@ -0,0 +1,207 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+// ****************************************************************************
+// This snippet measures the CPU side of sparse signed distance fields (SDFs).
+//
+// It cooks a triangle mesh with sparse SDFs of increasing resolutions and
+// reports the time spent building the SDF. Then it samples each SDF with
+// PxMeshQuery::sdfDistances() and compares the throughput and the results
+// against exact closest-point queries (PxGeometryQuery::pointDistance).
+// ****************************************************************************
+
+#include "PxPhysicsAPI.h"
+#include "foundation/PxArray.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+
+static const PxU32	gNbSamples		= 1000000;
+static const PxU32	gNbExactSamples	= 100000;
+
+namespace
+{
+	class Timer
+	{
+		public:
+			Timer() : mStartTime(SnippetUtils::getCurrentTimeCounterValue())	{}
+
+			float	getElapsedTime()	const
+			{
+				const PxU64 stopTime = SnippetUtils::getCurrentTimeCounterValue();
+				return SnippetUtils::getElapsedTimeInMilliseconds(stopTime - mStartTime);
+			}
+		private:
+			PxU64	mStartTime;
+	};
+}
+
+// A closed torus, so that the SDF has a well-defined inside
+static void createTorus(PxArray<PxVec3>& verts, PxArray<PxU32>& indices, PxReal majorRadius, PxReal minorRadius, PxU32 nbMajor, PxU32 nbMinor)
+{
+	for(PxU32 i=0;i<nbMajor;i++)
+	{
+		const PxReal a = PxReal(i)*PxTwoPi/PxReal(nbMajor);
+		for(PxU32 j=0;j<nbMinor;j++)
+		{
+			const PxReal b = PxReal(j)*PxTwoPi/PxReal(nbMinor);
+			const PxReal r = majorRadius + minorRadius*PxCos(b);
+			verts.pushBack(PxVec3(r*PxCos(a), minorRadius*PxSin(b), r*PxSin(a)));
+		}
+	}
+
+	for(PxU32 i=0;i<nbMajor;i++)
+	{
+		const PxU32 nextI = (i+1)%nbMajor;
+		for(PxU32 j=0;j<nbMinor;j++)
+		{
+			const PxU32 nextJ = (j+1)%nbMinor;
+			const PxU32 v0 = i*nbMinor + j;
+			const PxU32 v1 = nextI*nbMinor + j;
+			const PxU32 v2 = i*nbMinor + nextJ;
+			const PxU32 v3 = nextI*nbMinor + nextJ;
+			indices.pushBack(v0);	indices.pushBack(v2);	indices.pushBack(v1);
+			indices.pushBack(v1);	indices.pushBack(v2);	indices.pushBack(v3);
+		}
+	}
+}
+
+static PxTriangleMesh* cookMesh(const PxArray<PxVec3>& verts, const PxArray<PxU32>& indices, PxReal sdfSpacing, float& cookingTime)
+{
+	PxTriangleMeshDesc meshDesc;
+	meshDesc.points.count		= verts.size();
+	meshDesc.points.stride		= sizeof(PxVec3);
+	meshDesc.points.data		= verts.begin();
+	meshDesc.triangles.count	= indices.size()/3;
+	meshDesc.triangles.stride	= sizeof(PxU32)*3;
+	meshDesc.triangles.data		= indices.begin();
+
+	PxSDFDesc sdfDesc;
+	if(sdfSpacing>0.0f)
+	{
+		sdfDesc.spacing				= sdfSpacing;
+		sdfDesc.subgridSize			= 6;
+		sdfDesc.bitsPerSubgridPixel	= PxSdfBitsPerSubgridPixel::e16_BIT_PER_PIXEL;
+		meshDesc.sdfDesc			= &sdfDesc;
+	}
+
+	const PxTolerancesScale scale;
+	PxCookingParams params(scale);
+	params.midphaseDesc.setToDefault(PxMeshMidPhase::eBVH34);
+
+	Timer timer;
+	PxTriangleMesh* mesh = PxCreateTriangleMesh(params, meshDesc);
+	cookingTime = timer.getElapsedTime();
+	return mesh;
+}
+
+static void runBenchmarks()
+{
+	PxArray<PxVec3> verts;
+	PxArray<PxU32> indices;
+	createTorus(verts, indices, 1.0f, 0.4f, 128, 64);
+
+	float baseTime;
+	PxTriangleMesh* baseMesh = cookMesh(verts, indices, 0.0f, baseTime);
+	printf("Torus: %d triangles, cooked without SDF in %.3f ms\n", indices.size()/3, double(baseTime));
+
+	// Random points in and around the torus
+	SnippetUtils::BasicRandom rnd(42);
+	PxArray<PxVec3> points(gNbSamples);
+	for(PxU32 i=0;i<gNbSamples;i++)
+		points[i] = PxVec3(rnd.rand(-1.6f, 1.6f), rnd.rand(-0.6f, 0.6f), rnd.rand(-1.6f, 1.6f));
+
+	const PxTransform pose(PxIdentity);
+
+	// Exact (unsigned) distances, used as the reference
+	PxArray<PxReal> exactDistances(gNbExactSamples);
+	Timer exactTimer;
+	for(PxU32 i=0;i<gNbExactSamples;i++)
+		exactDistances[i] = PxSqrt(PxGeometryQuery::pointDistance(points[i], PxTriangleMeshGeometry(baseMesh), pose));
+	const float exactTime = exactTimer.getElapsedTime();
+	printf("Exact closest points: %.2f Msamples/s\n", double(gNbExactSamples)/(double(exactTime)*1000.0));
+
+	const PxReal spacings[] = { 0.04f, 0.02f, 0.01f };
+	for(PxU32 s=0;s<3;s++)
+	{
+		float cookingTime;
+		PxTriangleMesh* mesh = cookMesh(verts, indices, spacings[s], cookingTime);
+		if(!mesh)
+			continue;
+
+		PxU32 nbX, nbY, nbZ;
+		mesh->getSDFDimensions(nbX, nbY, nbZ);
+
+		const PxTriangleMeshGeometry geom(mesh);
+		PxArray<PxReal> distances(gNbSamples);
+		PxArray<PxVec3> normals(gNbSamples);
+
+		Timer distanceTimer;
+		PxMeshQuery::sdfDistances(geom, pose, gNbSamples, points.begin(), distances.begin());
+		const float distanceTime = distanceTimer.getElapsedTime();
+
+		Timer normalTimer;
+		PxMeshQuery::sdfDistances(geom, pose, gNbSamples, points.begin(), distances.begin(), normals.begin());
+		const float normalTime = normalTimer.getElapsedTime();
+
+		// Compare against the exact distances. The sparse SDF is only accurate close to the surface.
+		PxReal maxError = 0.0f;
+		PxU32 nbCloseSamples = 0;
+		for(PxU32 i=0;i<gNbExactSamples;i++)
+		{
+			if(exactDistances[i] > 2.0f*spacings[s])
+				continue;
+			nbCloseSamples++;
+			maxError = PxMax(maxError, PxAbs(PxAbs(distances[i]) - exactDistances[i]));
+		}
+
+		printf("Spacing %.3f (%dx%dx%d): SDF built in %8.3f ms | sampling: %6.2f Msamples/s (distances), %6.2f Msamples/s (distances+normals) | max error %f (%f cells) near the surface (%d samples)\n",
+			double(spacings[s]), nbX, nbY, nbZ, double(cookingTime - baseTime),
+			double(gNbSamples)/(double(distanceTime)*1000.0), double(gNbSamples)/(double(normalTime)*1000.0),
+			double(maxError), double(maxError/spacings[s]), nbCloseSamples);
+
+		mesh->release();
+	}
+
+	baseMesh->release();
+}
+
+int snippetMain(int, const char*const*)
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+
+	runBenchmarks();
+
+	PX_RELEASE(gFoundation);
+	printf("SnippetSparseSDF done.\n");
+
+	return 0;
+}
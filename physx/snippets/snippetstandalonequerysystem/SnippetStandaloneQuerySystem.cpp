@@ -145,7 +145,7 @@ CustomScene::CustomScene() : mNbObjects(0)
 	// and an optional one for compound). The query system here is more flexible and supports an
 	// arbitrary number of pruners, which have to be created by users and added to the system
 	// explicitly. In this snippet we just use a single pruner of a chosen type:
-	Pruner* pruner = createAABBPruner(contextID, true, COMPANION_PRUNER_INCREMENTAL, BVH_SPLATTER_POINTS, 4);
+	Pruner* pruner = createAABBPruner(contextID, true, COMPANION_PRUNER_INCREMENTAL, BVH_SPLATTER_POINTS, 4, BVH_BINARY);
 
 	// Then we add it to the query system, which takes ownership of the object (it will delete
 	// the pruner when the query system is released). Each pruner is given an index by the
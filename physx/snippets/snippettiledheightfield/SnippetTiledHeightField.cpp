@@ -0,0 +1,419 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet illustrates how to stream a large terrain with
+// PxTiledHeightField, and checks it against a regular heightfield.
+//
+// The terrain is split into tiles that are provided by a user source. A
+// streaming center moves over the terrain, loading close tiles and evicting
+// distant ones. Craters are then dug into the loaded tiles, evicted tiles
+// hand their modifications back to the source, and get them back when they
+// are loaded again.
+//
+// The same terrain and the same modifications are applied to one monolithic
+// heightfield in a second scene. At each step, vertical raycasts against both
+// scenes are compared: loaded tiles must give the same results as the
+// monolithic heightfield, unloaded tiles must not be hit. The snippet also
+// prints the timings of raycasts and modifications in both versions.
+// ****************************************************************************
+
+#include "PxPhysicsAPI.h"
+#include "foundation/PxArray.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxPhysics*				gPhysics = NULL;
+static PxDefaultCpuDispatcher*	gDispatcher = NULL;
+static PxMaterial*				gMaterial = NULL;
+
+static const PxU32	gNbTiles			= 8;	// Tiles per side
+static const PxU32	gTileSize			= 32;	// Cells per tile side
+static const PxU32	gNbSamplesPerSide	= gNbTiles*gTileSize + 1;
+static const PxReal	gHeightScale		= 0.01f;
+static const PxReal	gRowScale			= 1.0f;
+static const PxReal	gColumnScale		= 1.0f;
+static const PxReal	gLoadRadius			= 70.0f;
+static const PxU32	gNbRays				= 20000;
+static const PxU32	gNbCraters			= 20;
+static const PxU32	gCraterSize			= 9;	// Samples per crater side
+
+namespace
+{
+	class Timer
+	{
+		public:
+			Timer() : mStartTime(SnippetUtils::getCurrentTimeCounterValue())	{}
+
+			float	getElapsedTime()	const
+			{
+				const PxU64 stopTime = SnippetUtils::getCurrentTimeCounterValue();
+				return SnippetUtils::getElapsedTimeInMilliseconds(stopTime - mStartTime);
+			}
+		private:
+			PxU64	mStartTime;
+	};
+
+	// Tile source backed by one big array of samples, standing in for terrain data on disk
+	class TerrainSource : public PxTiledHeightFieldSource
+	{
+		public:
+			TerrainSource(const PxArray<PxHeightFieldSample>& samples) : mSamples(samples), mNbLoads(0), mNbStores(0)	{}
+
+			virtual	bool	loadTile(PxU32 tileRow, PxU32 tileColumn, PxHeightFieldSample* samples)
+			{
+				for(PxU32 r=0;r<=gTileSize;r++)
+					for(PxU32 c=0;c<=gTileSize;c++)
+						samples[r*(gTileSize+1) + c] = mSamples[(tileRow*gTileSize + r)*gNbSamplesPerSide + tileColumn*gTileSize + c];
+				mNbLoads++;
+				return true;
+			}
+
+			virtual	void	storeTile(PxU32 tileRow, PxU32 tileColumn, const PxHeightFieldSample* samples)
+			{
+				for(PxU32 r=0;r<=gTileSize;r++)
+					for(PxU32 c=0;c<=gTileSize;c++)
+						mSamples[(tileRow*gTileSize + r)*gNbSamplesPerSide + tileColumn*gTileSize + c] = samples[r*(gTileSize+1) + c];
+				mNbStores++;
+			}
+
+			PxArray<PxHeightFieldSample>	mSamples;
+			PxU32							mNbLoads;
+			PxU32							mNbStores;
+	};
+
+	// The monolithic heightfield used as a reference
+	struct Reference
+	{
+		PxScene*						mScene;
+		PxShape*						mShape;
+		PxHeightField*					mHeightField;
+		PxArray<PxHeightFieldSample>	mSamples;	// Current samples, including modifications
+	};
+}
+
+// Rolling hills. Heights stay within [-25, 25] in world space.
+static void createTerrain(PxArray<PxHeightFieldSample>& samples)
+{
+	samples.resize(gNbSamplesPerSide*gNbSamplesPerSide);
+	for(PxU32 r=0;r<gNbSamplesPerSide;r++)
+	{
+		for(PxU32 c=0;c<gNbSamplesPerSide;c++)
+		{
+			const PxReal h = 2000.0f*PxSin(PxReal(r)*0.03f)*PxCos(PxReal(c)*0.02f) + 300.0f*PxSin(PxReal(r)*0.2f + PxReal(c)*0.13f);
+			PxHeightFieldSample& sample = samples[r*gNbSamplesPerSide + c];
+			sample.height = PxI16(h);
+			sample.materialIndex0 = 0;
+			sample.materialIndex1 = 0;
+		}
+	}
+}
+
+static PxScene* createScene()
+{
+	PxSceneDesc sceneDesc(gPhysics->getTolerancesScale());
+	sceneDesc.gravity		= PxVec3(0.0f, -9.81f, 0.0f);
+	sceneDesc.cpuDispatcher	= gDispatcher;
+	sceneDesc.filterShader	= PxDefaultSimulationFilterShader;
+	return gPhysics->createScene(sceneDesc);
+}
+
+static PxHeightFieldGeometry getReferenceGeometry(PxHeightField* heightField)
+{
+	return PxHeightFieldGeometry(heightField, PxMeshGeometryFlags(), gHeightScale, gRowScale, gColumnScale);
+}
+
+static void createReference(Reference& ref, const PxArray<PxHeightFieldSample>& samples)
+{
+	ref.mSamples = samples;
+
+	PxHeightFieldDesc hfDesc;
+	hfDesc.nbRows			= gNbSamplesPerSide;
+	hfDesc.nbColumns		= gNbSamplesPerSide;
+	hfDesc.samples.data		= samples.begin();
+	hfDesc.samples.stride	= sizeof(PxHeightFieldSample);
+	hfDesc.flags			= PxHeightFieldFlag::eNO_BOUNDARY_EDGES;
+	ref.mHeightField = PxCreateHeightField(hfDesc, gPhysics->getPhysicsInsertionCallback());
+
+	ref.mScene = createScene();
+	PxRigidStatic* actor = gPhysics->createRigidStatic(PxTransform(PxIdentity));
+	ref.mShape = PxRigidActorExt::createExclusiveShape(*actor, getReferenceGeometry(ref.mHeightField), *gMaterial);
+	ref.mScene->addActor(*actor);
+}
+
+static void releaseReference(Reference& ref)
+{
+	PX_RELEASE(ref.mScene);
+	PX_RELEASE(ref.mHeightField);
+}
+
+static PxVec3 getRayOrigin(SnippetUtils::BasicRandom& rnd)
+{
+	const PxReal sizeX = PxReal(gNbSamplesPerSide-1)*gRowScale;
+	const PxReal sizeZ = PxReal(gNbSamplesPerSide-1)*gColumnScale;
+	return PxVec3(rnd.rand(0.0f, sizeX), 30.0f, rnd.rand(0.0f, sizeZ));
+}
+
+// Casts vertical rays against both scenes. Rays above loaded tiles must give the same results, rays above unloaded tiles must miss.
+static PxU32 compareRaycasts(const char* name, PxTiledHeightField& tiled, PxScene& tiledScene, PxScene& refScene)
+{
+	SnippetUtils::BasicRandom rnd(42);
+	const PxVec3 dir(0.0f, -1.0f, 0.0f);
+
+	PxArray<PxVec3> origins(gNbRays);
+	for(PxU32 i=0;i<gNbRays;i++)
+		origins[i] = getRayOrigin(rnd);
+
+	PxArray<PxReal> tiledDistances(gNbRays);
+	PxArray<PxReal> refDistances(gNbRays);
+
+	Timer tiledTimer;
+	for(PxU32 i=0;i<gNbRays;i++)
+	{
+		PxRaycastBuffer buf;
+		tiledDistances[i] = tiledScene.raycast(origins[i], dir, 100.0f, buf) && buf.hasBlock ? buf.block.distance : -1.0f;
+	}
+	const float tiledTime = tiledTimer.getElapsedTime();
+
+	Timer refTimer;
+	for(PxU32 i=0;i<gNbRays;i++)
+	{
+		PxRaycastBuffer buf;
+		refDistances[i] = refScene.raycast(origins[i], dir, 100.0f, buf) && buf.hasBlock ? buf.block.distance : -1.0f;
+	}
+	const float refTime = refTimer.getElapsedTime();
+
+	PxU32 nbMismatches = 0;
+	PxU32 nbLoaded = 0;
+	for(PxU32 i=0;i<gNbRays;i++)
+	{
+		const PxU32 tileRow = PxMin(PxU32(origins[i].x / (PxReal(gTileSize)*gRowScale)), gNbTiles-1);
+		const PxU32 tileColumn = PxMin(PxU32(origins[i].z / (PxReal(gTileSize)*gColumnScale)), gNbTiles-1);
+		if(tiled.isTileLoaded(tileRow, tileColumn))
+		{
+			nbLoaded++;
+			if(PxAbs(tiledDistances[i] - refDistances[i]) > 1e-3f)
+				nbMismatches++;
+		}
+		else if(tiledDistances[i]>=0.0f)
+		{
+			nbMismatches++;
+		}
+	}
+
+	printf("%s: %d tiles loaded, %d rays over loaded tiles, %d mismatches. Raycasts: tiled %f ms, monolithic %f ms\n",
+		name, tiled.getNbLoadedTiles(), nbLoaded, nbMismatches, double(tiledTime), double(refTime));
+	return nbMismatches;
+}
+
+// Checks that the bounds of loaded tiles match the height range of their samples
+static PxU32 checkTileBounds(PxTiledHeightField& tiled, const Reference& ref)
+{
+	PxU32 nbErrors = 0;
+	for(PxU32 i=0;i<gNbTiles;i++)
+	{
+		for(PxU32 j=0;j<gNbTiles;j++)
+		{
+			PxBounds3 bounds;
+			if(!tiled.getTileBounds(i, j, bounds))
+				continue;
+
+			PxI32 minHeight = 0x7fff;
+			PxI32 maxHeight = -0x8000;
+			for(PxU32 r=0;r<=gTileSize;r++)
+			{
+				for(PxU32 c=0;c<=gTileSize;c++)
+				{
+					const PxI32 h = ref.mSamples[(i*gTileSize + r)*gNbSamplesPerSide + j*gTileSize + c].height;
+					minHeight = PxMin(minHeight, h);
+					maxHeight = PxMax(maxHeight, h);
+				}
+			}
+
+			if(PxAbs(bounds.minimum.y - PxReal(minHeight)*gHeightScale) > 1e-3f || PxAbs(bounds.maximum.y - PxReal(maxHeight)*gHeightScale) > 1e-3f)
+				nbErrors++;
+		}
+	}
+	return nbErrors;
+}
+
+// Moves the streaming center until all tiles around it are loaded
+static void stream(PxTiledHeightField& tiled, const PxVec3& center)
+{
+	while(tiled.updateStreaming(center, gLoadRadius));
+}
+
+static bool isRegionLoaded(PxTiledHeightField& tiled, PxU32 startRow, PxU32 startColumn, PxU32 nbRows, PxU32 nbColumns)
+{
+	for(PxU32 i=startRow/gTileSize; i<=PxMin((startRow+nbRows-1)/gTileSize, gNbTiles-1); i++)
+		for(PxU32 j=startColumn/gTileSize; j<=PxMin((startColumn+nbColumns-1)/gTileSize, gNbTiles-1); j++)
+			if(!tiled.isTileLoaded(i, j))
+				return false;
+	return true;
+}
+
+// Digs craters in loaded tiles, in both the tiled and the monolithic heightfield
+static void digCraters(PxTiledHeightField& tiled, Reference& ref)
+{
+	SnippetUtils::BasicRandom rnd(7);
+	PxHeightFieldSample crater[gCraterSize*gCraterSize];
+
+	float tiledTime = 0.0f;
+	float refTime = 0.0f;
+	PxU32 nbCraters = 0;
+	for(PxU32 attempt=0; attempt<1000 && nbCraters<gNbCraters; attempt++)
+	{
+		const PxU32 startRow = PxU32(rnd.randomize()) % (gNbSamplesPerSide - gCraterSize);
+		const PxU32 startColumn = PxU32(rnd.randomize()) % (gNbSamplesPerSide - gCraterSize);
+		// Modifications of unloaded tiles are lost, so we only dig where the terrain is loaded
+		if(!isRegionLoaded(tiled, startRow, startColumn, gCraterSize, gCraterSize))
+			continue;
+
+		for(PxU32 r=0;r<gCraterSize;r++)
+		{
+			for(PxU32 c=0;c<gCraterSize;c++)
+			{
+				PxHeightFieldSample& sample = ref.mSamples[(startRow + r)*gNbSamplesPerSide + startColumn + c];
+				sample.height = PxI16(sample.height - 1000);
+				crater[r*gCraterSize + c] = sample;
+			}
+		}
+
+		Timer tiledTimer;
+		tiled.modifySamples(startRow, startColumn, gCraterSize, gCraterSize, crater);
+		tiledTime += tiledTimer.getElapsedTime();
+
+		Timer refTimer;
+		PxHeightFieldDesc subfieldDesc;
+		subfieldDesc.nbRows			= gCraterSize;
+		subfieldDesc.nbColumns		= gCraterSize;
+		subfieldDesc.samples.data	= crater;
+		subfieldDesc.samples.stride	= sizeof(PxHeightFieldSample);
+		ref.mHeightField->modifySamples(PxI32(startColumn), PxI32(startRow), subfieldDesc, true);
+		refTime += refTimer.getElapsedTime();
+		nbCraters++;
+	}
+
+	// Bounds are updated once for all craters
+	Timer tiledTimer;
+	const PxU32 nbUpdatedTiles = tiled.flushModifications();
+	tiledTime += tiledTimer.getElapsedTime();
+
+	Timer refTimer;
+	ref.mShape->setGeometry(getReferenceGeometry(ref.mHeightField));
+	refTime += refTimer.getElapsedTime();
+
+	printf("Dug %d craters, %d tiles updated. Modifications: tiled %f ms, monolithic %f ms\n", nbCraters, nbUpdatedTiles, double(tiledTime), double(refTime));
+}
+
+static bool runTest()
+{
+	PxArray<PxHeightFieldSample> samples;
+	createTerrain(samples);
+
+	Reference ref;
+	createReference(ref, samples);
+
+	TerrainSource source(samples);
+	PxScene* tiledScene = createScene();
+
+	PxTiledHeightFieldDesc desc;
+	desc.nbTileRows		= gNbTiles;
+	desc.nbTileColumns	= gNbTiles;
+	desc.tileSize		= gTileSize;
+	desc.heightScale	= gHeightScale;
+	desc.rowScale		= gRowScale;
+	desc.columnScale	= gColumnScale;
+	desc.materials		= &gMaterial;
+	desc.nbMaterials	= 1;
+	desc.source			= &source;
+	PxTiledHeightField* tiled = PxCreateTiledHeightField(*gPhysics, *tiledScene, desc);
+
+	PxU32 nbErrors = 0;
+	if(tiled)
+	{
+		const PxReal size = PxReal(gNbSamplesPerSide-1);
+		const PxVec3 nearCorner(size*0.25f, 0.0f, size*0.25f);
+		const PxVec3 farCorner(size*0.9f, 0.0f, size*0.9f);
+
+		// Stream the first part of the terrain in
+		stream(*tiled, nearCorner);
+		nbErrors += compareRaycasts("Initial streaming", *tiled, *tiledScene, *ref.mScene);
+
+		// Modify the loaded tiles
+		digCraters(*tiled, ref);
+		nbErrors += compareRaycasts("After modifications", *tiled, *tiledScene, *ref.mScene);
+		nbErrors += checkTileBounds(*tiled, ref);
+
+		// Move away: the modified tiles are evicted and stored back to the source
+		stream(*tiled, farCorner);
+		nbErrors += compareRaycasts("After moving away", *tiled, *tiledScene, *ref.mScene);
+		if(!source.mNbStores)
+			nbErrors++;
+
+		// Come back: the tiles are loaded again, with their modifications
+		stream(*tiled, nearCorner);
+		nbErrors += compareRaycasts("After coming back", *tiled, *tiledScene, *ref.mScene);
+		nbErrors += checkTileBounds(*tiled, ref);
+
+		printf("%d tiles loaded and %d tiles stored by the source in total\n", source.mNbLoads, source.mNbStores);
+
+		tiled->release();
+	}
+	else
+		nbErrors++;
+
+	PX_RELEASE(tiledScene);
+	releaseReference(ref);
+	return nbErrors==0;
+}
+
+int snippetMain(int, const char*const*)
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale(), true);
+	PxInitExtensions(*gPhysics, NULL);
+	gDispatcher = PxDefaultCpuDispatcherCreate(2);
+	gMaterial = gPhysics->createMaterial(0.5f, 0.5f, 0.6f);
+
+	const bool success = runTest();
+
+	PX_RELEASE(gMaterial);
+	PX_RELEASE(gDispatcher);
+	PxCloseExtensions();
+	PX_RELEASE(gPhysics);
+	PX_RELEASE(gFoundation);
+
+	printf("SnippetTiledHeightField %s.\n", success ? "done" : "FAILED");
+
+	return success ? 0 : 1;
+}
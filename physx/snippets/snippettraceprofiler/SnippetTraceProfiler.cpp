@@ -0,0 +1,179 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+// ****************************************************************************
+// This snippet illustrates how to use the built-in trace profiler.
+//
+// The profiler is installed with PxSetProfilerCallback(). It records the
+// profile zones of all threads into per-thread ring buffers, without locks,
+// and writes them out in the Chrome trace event format. The resulting
+// PhysXTrace.json file can be opened in chrome://tracing or in the Perfetto UI.
+//
+// The snippet first measures the cost of recording a zone, then simulates a
+// few box stacks with several worker threads and writes the trace to a file.
+// The SDK only emits profile zones in debug, checked and profile builds.
+// ****************************************************************************
+
+#include <stdio.h>
+#include "PxPhysicsAPI.h"
+#include "foundation/PxTraceProfiler.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxTraceProfiler*			gProfiler	= NULL;
+static PxPhysics*				gPhysics	= NULL;
+static PxDefaultCpuDispatcher*	gDispatcher = NULL;
+static PxScene*					gScene		= NULL;
+static PxMaterial*				gMaterial	= NULL;
+
+static const PxU32 gNbEventsPerThread = 1<<16;
+
+static void createStack(const PxTransform& t, PxU32 size, PxReal halfExtent)
+{
+	PxShape* shape = gPhysics->createShape(PxBoxGeometry(halfExtent, halfExtent, halfExtent), *gMaterial);
+	for(PxU32 i=0; i<size;i++)
+	{
+		for(PxU32 j=0;j<size-i;j++)
+		{
+			PxTransform localTm(PxVec3(PxReal(j*2) - PxReal(size-i), PxReal(i*2+1), 0) * halfExtent);
+			PxRigidDynamic* body = gPhysics->createRigidDynamic(t.transform(localTm));
+			body->attachShape(*shape);
+			PxRigidBodyExt::updateMassAndInertia(*body, 10.0f);
+			gScene->addActor(*body);
+		}
+	}
+	shape->release();
+}
+
+static void initPhysics()
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+
+	gProfiler = PxCreateTraceProfiler(gNbEventsPerThread);
+	PxSetProfilerCallback(gProfiler);
+
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale(), true);
+
+	PxSceneDesc sceneDesc(gPhysics->getTolerancesScale());
+	sceneDesc.gravity = PxVec3(0.0f, -9.81f, 0.0f);
+	gDispatcher = PxDefaultCpuDispatcherCreate(4);
+	sceneDesc.cpuDispatcher	= gDispatcher;
+	sceneDesc.filterShader	= PxDefaultSimulationFilterShader;
+	gScene = gPhysics->createScene(sceneDesc);
+
+	gMaterial = gPhysics->createMaterial(0.5f, 0.5f, 0.6f);
+
+	PxRigidStatic* groundPlane = PxCreatePlane(*gPhysics, PxPlane(0,1,0,0), *gMaterial);
+	gScene->addActor(*groundPlane);
+
+	PxReal stackZ = 10.0f;
+	for(PxU32 i=0;i<10;i++)
+		createStack(PxTransform(PxVec3(0,0,stackZ-=10.0f)), 10, 2.0f);
+}
+
+static void measureZoneCost()
+{
+	// Record nested zones from the main thread, the same way the SDK does with PX_PROFILE_ZONE.
+	// The ring buffer is smaller than the number of recorded events, so this also exercises the
+	// overwriting of old events.
+	const PxU32 nbZones = 1000000;
+
+	PxReal bestTime = PX_MAX_F32;
+	for(PxU32 j=0;j<5;j++)
+	{
+		const PxU64 startTime = SnippetUtils::getCurrentTimeCounterValue();
+		for(PxU32 i=0;i<nbZones/2;i++)
+		{
+			PxProfileScoped outerZone(PxGetProfilerCallback(), "Snippet.outerZone", false, 0);
+			PxProfileScoped innerZone(PxGetProfilerCallback(), "Snippet.innerZone", false, 0);
+		}
+		const PxU64 stopTime = SnippetUtils::getCurrentTimeCounterValue();
+		bestTime = PxMin(bestTime, SnippetUtils::getElapsedTimeInMilliseconds(stopTime - startTime));
+	}
+
+	printf("Recorded %d zones in %.2f ms: %.1f ns per zone.\n", nbZones, double(bestTime), double(bestTime)*1000000.0/double(nbZones));
+
+	// Only keep the simulation in the trace.
+	gProfiler->reset();
+}
+
+static void stepPhysics()
+{
+	gScene->simulate(1.0f/60.0f);
+	gScene->fetchResults(true);
+}
+
+static void writeTrace()
+{
+	const char* filename = "PhysXTrace.json";
+
+	PxDefaultFileOutputStream stream(filename);
+	if(!stream.isValid() || !gProfiler->writeChromeTrace(stream))
+	{
+		printf("Failed to write %s.\n", filename);
+		return;
+	}
+
+	printf("Wrote the zones of %d threads to %s.\n", gProfiler->getNbThreads(), filename);
+}
+
+static void cleanupPhysics()
+{
+	PX_RELEASE(gScene);
+	PX_RELEASE(gDispatcher);
+	PX_RELEASE(gPhysics);
+
+	// The profiler must be uninstalled before it is released.
+	PxSetProfilerCallback(NULL);
+	PX_RELEASE(gProfiler);
+
+	PX_RELEASE(gFoundation);
+
+#if (PX_DEBUG || PX_CHECKED || PX_PROFILE)
+	printf("SnippetTraceProfiler done.\n");
+#else
+	printf("Warning: SnippetTraceProfiler does not capture the SDK's profile zones in release build.\n");
+#endif
+}
+
+int snippetMain(int, const char*const*)
+{
+	static const PxU32 frameCount = 100;
+	initPhysics();
+	measureZoneCost();
+	for(PxU32 i=0; i<frameCount; i++)
+		stepPhysics();
+	writeTrace();
+	cleanupPhysics();
+
+	return 0;
+}
@@ -0,0 +1,401 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet illustrates how to load a triangle mesh in place, i.e. without
+// decoding or copying the cooked data.
+//
+// A terrain mesh is cooked twice: once with PxCookTriangleMesh and once with
+// PxCookTriangleMeshInPlace. The first image is loaded with the regular
+// createTriangleMesh() path, the second one is copied to a 16-byte aligned
+// buffer (standing in for a memory-mapped file) and loaded with
+// createTriangleMeshInPlace(). The snippet prints the loading times and checks
+// that raycasts, sweeps and overlaps against both meshes return the same
+// results, with quantized and non-quantized BVH34 trees.
+//
+// Finally the snippet feeds truncated and corrupted images to the in-place
+// path, which must either reject them or produce a mesh that can be queried
+// safely.
+//
+// ****************************************************************************
+
+#include "PxPhysicsAPI.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxMemory.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxPhysics*				gPhysics = NULL;
+
+static const PxU32	gTerrainSize	= 256;
+static const PxU32	gNbQueries		= 2000;
+static const PxU32	gNbLoads		= 20;
+static const PxU32	gNbCorruptions	= 200;
+static const PxU32	gMaxOverlaps	= 4096;
+
+// Silences the errors expected from the truncated and corrupted images
+class SwitchableErrorCallback : public PxErrorCallback
+{
+public:
+	SwitchableErrorCallback() : mQuiet(false)	{}
+
+	virtual void reportError(PxErrorCode::Enum code, const char* message, const char* file, int line)
+	{
+		if(!mQuiet)
+			gErrorCallback.reportError(code, message, file, line);
+	}
+
+	bool	mQuiet;
+};
+
+static SwitchableErrorCallback	gSwitchableErrorCallback;
+
+static float randomFloat()
+{
+	return float(rand())/float(RAND_MAX);
+}
+
+static void createTerrain(PxArray<PxVec3>& verts, PxArray<PxU32>& indices, PxU32 size)
+{
+	verts.resize((size+1)*(size+1));
+	for(PxU32 z=0;z<=size;z++)
+	{
+		for(PxU32 x=0;x<=size;x++)
+		{
+			const float h = PxSin(float(x)*0.15f)*PxCos(float(z)*0.1f)*4.0f + randomFloat()*0.2f;
+			verts[z*(size+1)+x] = PxVec3(float(x), h, float(z));
+		}
+	}
+
+	indices.resize(size*size*6);
+	PxU32* dst = indices.begin();
+	for(PxU32 z=0;z<size;z++)
+	{
+		for(PxU32 x=0;x<size;x++)
+		{
+			const PxU32 i0 = z*(size+1)+x;
+			const PxU32 i1 = i0+1;
+			const PxU32 i2 = i0+size+1;
+			const PxU32 i3 = i2+1;
+			*dst++ = i0;	*dst++ = i2;	*dst++ = i1;
+			*dst++ = i1;	*dst++ = i2;	*dst++ = i3;
+		}
+	}
+}
+
+namespace
+{
+	// Stands in for a memory-mapped file: a 16-byte aligned copy of a cooked in-place image
+	struct AlignedImage
+	{
+		AlignedImage(const void* data, PxU32 size) : mSize(size)
+		{
+			mMemory = gAllocator.allocate(size ? size : 16, "AlignedImage", __FILE__, __LINE__);
+			PxMemCopy(mMemory, data, size);
+		}
+
+		~AlignedImage()
+		{
+			gAllocator.deallocate(mMemory);
+		}
+
+		void*	mMemory;
+		PxU32	mSize;
+	};
+
+	struct Query
+	{
+		PxVec3	mOrigin;
+		PxVec3	mDir;
+		PxVec3	mBoxCenter;
+		PxVec3	mBoxExtents;
+	};
+}
+
+static void generateQueries(PxArray<Query>& queries, PxU32 nbQueries, float worldSize)
+{
+	queries.resize(nbQueries);
+	for(PxU32 i=0;i<nbQueries;i++)
+	{
+		Query& q = queries[i];
+		q.mOrigin = PxVec3(randomFloat()*worldSize, 10.0f + randomFloat()*5.0f, randomFloat()*worldSize);
+		q.mDir = PxVec3(randomFloat()-0.5f, -1.0f, randomFloat()-0.5f).getNormalized();
+		q.mBoxCenter = PxVec3(randomFloat()*worldSize, randomFloat()*4.0f - 2.0f, randomFloat()*worldSize);
+		q.mBoxExtents = PxVec3(0.5f + randomFloat()*3.0f, 0.5f + randomFloat()*3.0f, 0.5f + randomFloat()*3.0f);
+	}
+}
+
+static void sortResults(PxU32* results, PxU32 nb)
+{
+	// Overlap results are returned in traversal order, which depends on the tree layout
+	for(PxU32 i=1;i<nb;i++)
+	{
+		const PxU32 v = results[i];
+		PxU32 j = i;
+		while(j && results[j-1]>v)
+		{
+			results[j] = results[j-1];
+			j--;
+		}
+		results[j] = v;
+	}
+}
+
+// Runs all queries against both meshes and returns the number of mismatches
+static PxU32 compareMeshes(PxTriangleMesh* refMesh, PxTriangleMesh* inPlaceMesh, const PxArray<Query>& queries)
+{
+	const PxTriangleMeshGeometry refGeom(refMesh);
+	const PxTriangleMeshGeometry inPlaceGeom(inPlaceMesh);
+	const PxTransform meshPose(PxIdentity);
+	const PxSphereGeometry sphereGeom(0.5f);
+	const PxHitFlags hitFlags = PxHitFlag::eDEFAULT;
+
+	PxArray<PxU32> refResults(gMaxOverlaps);
+	PxArray<PxU32> inPlaceResults(gMaxOverlaps);
+
+	PxU32 nbMismatches = 0;
+	const PxU32 nbQueries = queries.size();
+	for(PxU32 i=0;i<nbQueries;i++)
+	{
+		const Query& q = queries[i];
+
+		{
+			PxRaycastHit refHit, inPlaceHit;
+			const PxU32 nbRef = PxGeometryQuery::raycast(q.mOrigin, q.mDir, refGeom, meshPose, 100.0f, hitFlags, 1, &refHit);
+			const PxU32 nbInPlace = PxGeometryQuery::raycast(q.mOrigin, q.mDir, inPlaceGeom, meshPose, 100.0f, hitFlags, 1, &inPlaceHit);
+			if(nbRef!=nbInPlace || (nbRef && (refHit.faceIndex!=inPlaceHit.faceIndex || refHit.distance!=inPlaceHit.distance)))
+				nbMismatches++;
+		}
+
+		{
+			const PxTransform spherePose(q.mOrigin);
+			PxSweepHit refHit, inPlaceHit;
+			const bool refStatus = PxGeometryQuery::sweep(q.mDir, 100.0f, sphereGeom, spherePose, refGeom, meshPose, refHit, hitFlags);
+			const bool inPlaceStatus = PxGeometryQuery::sweep(q.mDir, 100.0f, sphereGeom, spherePose, inPlaceGeom, meshPose, inPlaceHit, hitFlags);
+			if(refStatus!=inPlaceStatus || (refStatus && (refHit.faceIndex!=inPlaceHit.faceIndex || refHit.distance!=inPlaceHit.distance)))
+				nbMismatches++;
+		}
+
+		{
+			const PxBoxGeometry boxGeom(q.mBoxExtents);
+			const PxTransform boxPose(q.mBoxCenter);
+			bool refOverflow, inPlaceOverflow;
+			const PxU32 nbRef = PxMeshQuery::findOverlapTriangleMesh(boxGeom, boxPose, refGeom, meshPose, refResults.begin(), gMaxOverlaps, 0, refOverflow);
+			const PxU32 nbInPlace = PxMeshQuery::findOverlapTriangleMesh(boxGeom, boxPose, inPlaceGeom, meshPose, inPlaceResults.begin(), gMaxOverlaps, 0, inPlaceOverflow);
+			if(nbRef!=nbInPlace || refOverflow!=inPlaceOverflow)
+			{
+				nbMismatches++;
+			}
+			else
+			{
+				sortResults(refResults.begin(), nbRef);
+				sortResults(inPlaceResults.begin(), nbInPlace);
+				for(PxU32 j=0;j<nbRef;j++)
+				{
+					if(refResults[j]!=inPlaceResults[j])
+					{
+						nbMismatches++;
+						break;
+					}
+				}
+			}
+		}
+	}
+	return nbMismatches;
+}
+
+// Corrupts random words of the image and checks that the in-place path either rejects it or returns a usable mesh
+static PxU32 fuzzImage(const PxDefaultMemoryOutputStream& image, const PxArray<Query>& queries)
+{
+	PxU32 nbRejected = 0;
+	const PxU32 nbWords = image.getSize()/sizeof(PxU32);
+
+	gSwitchableErrorCallback.mQuiet = true;
+	for(PxU32 i=0;i<gNbCorruptions;i++)
+	{
+		AlignedImage corrupted(image.getData(), image.getSize());
+		PxU32* words = reinterpret_cast<PxU32*>(corrupted.mMemory);
+		const PxU32 nbCorruptedWords = 1 + PxU32(rand()%4);
+		for(PxU32 j=0;j<nbCorruptedWords;j++)
+		{
+			const PxU32 index = PxU32(rand()) % nbWords;
+			// Mix small values, large values and bit flips, which catch different kinds of checks
+			switch(rand()%3)
+			{
+				case 0:	words[index] = PxU32(rand()%256);							break;
+				case 1:	words[index] = 0xffffffff - PxU32(rand()%256);				break;
+				case 2:	words[index] ^= 1u<<(rand()%32);							break;
+			}
+		}
+
+		PxTriangleMesh* mesh = gPhysics->createTriangleMeshInPlace(corrupted.mMemory, corrupted.mSize);
+		if(!mesh)
+		{
+			nbRejected++;
+			continue;
+		}
+
+		// The image passed validation, so queries must not crash. Results are meaningless here.
+		const PxTriangleMeshGeometry meshGeom(mesh);
+		const PxTransform meshPose(PxIdentity);
+		PxU32 results[64];
+		for(PxU32 j=0;j<queries.size();j+=20)
+		{
+			const Query& q = queries[j];
+			PxRaycastHit hit;
+			PxGeometryQuery::raycast(q.mOrigin, q.mDir, meshGeom, meshPose, 100.0f, PxHitFlag::eDEFAULT, 1, &hit);
+			bool overflow;
+			PxMeshQuery::findOverlapTriangleMesh(PxBoxGeometry(q.mBoxExtents), PxTransform(q.mBoxCenter), meshGeom, meshPose, results, 64, 0, overflow);
+		}
+		mesh->release();
+	}
+	gSwitchableErrorCallback.mQuiet = false;
+	return nbRejected;
+}
+
+static bool runTest(const char* name, bool quantized, const PxArray<PxVec3>& verts, const PxArray<PxU32>& indices, const PxArray<Query>& queries)
+{
+	const PxTolerancesScale scale;
+	PxCookingParams params(scale);
+	params.midphaseDesc = PxMeshMidPhase::eBVH34;
+	params.midphaseDesc.mBVH34Desc.quantized = quantized;
+
+	PxTriangleMeshDesc meshDesc;
+	meshDesc.points.count		= verts.size();
+	meshDesc.points.stride		= sizeof(PxVec3);
+	meshDesc.points.data		= verts.begin();
+	meshDesc.triangles.count	= indices.size()/3;
+	meshDesc.triangles.stride	= 3*sizeof(PxU32);
+	meshDesc.triangles.data		= indices.begin();
+
+	PxDefaultMemoryOutputStream regularImage;
+	PxDefaultMemoryOutputStream inPlaceImage;
+	if(!PxCookTriangleMesh(params, meshDesc, regularImage) || !PxCookTriangleMeshInPlace(params, meshDesc, inPlaceImage))
+	{
+		printf("%s: cooking failed\n", name);
+		return false;
+	}
+
+	// This would typically be a memory-mapped file
+	AlignedImage mapped(inPlaceImage.getData(), inPlaceImage.getSize());
+
+	// Measure both loading paths. The in-place path only validates the image.
+	float regularTime = 0.0f;
+	float inPlaceTime = 0.0f;
+	PxTriangleMesh* refMesh = NULL;
+	PxTriangleMesh* inPlaceMesh = NULL;
+	for(PxU32 i=0;i<gNbLoads;i++)
+	{
+		if(refMesh)
+			refMesh->release();
+		if(inPlaceMesh)
+			inPlaceMesh->release();
+
+		PxU64 startTime = SnippetUtils::getCurrentTimeCounterValue();
+		PxDefaultMemoryInputData input(regularImage.getData(), regularImage.getSize());
+		refMesh = gPhysics->createTriangleMesh(input);
+		regularTime += SnippetUtils::getElapsedTimeInMilliseconds(SnippetUtils::getCurrentTimeCounterValue() - startTime);
+
+		startTime = SnippetUtils::getCurrentTimeCounterValue();
+		inPlaceMesh = gPhysics->createTriangleMeshInPlace(mapped.mMemory, mapped.mSize);
+		inPlaceTime += SnippetUtils::getElapsedTimeInMilliseconds(SnippetUtils::getCurrentTimeCounterValue() - startTime);
+
+		if(!refMesh || !inPlaceMesh)
+		{
+			printf("%s: mesh creation failed\n", name);
+			if(refMesh)
+				refMesh->release();
+			if(inPlaceMesh)
+				inPlaceMesh->release();
+			return false;
+		}
+	}
+
+	printf("%s: %d triangles, regular image %d bytes, in-place image %d bytes\n", name, indices.size()/3, regularImage.getSize(), inPlaceImage.getSize());
+	printf("%s: createTriangleMesh %f ms, createTriangleMeshInPlace %f ms\n", name, double(regularTime/float(gNbLoads)), double(inPlaceTime/float(gNbLoads)));
+
+	bool success = true;
+
+	const PxU32 nbMismatches = compareMeshes(refMesh, inPlaceMesh, queries);
+	printf("%s: %d mismatches over %d queries\n", name, nbMismatches, queries.size()*3);
+	if(nbMismatches)
+		success = false;
+
+	refMesh->release();
+	inPlaceMesh->release();
+
+	// Truncated images must be rejected
+	gSwitchableErrorCallback.mQuiet = true;
+	const PxU32 truncatedSizes[] = { 0, 16, mapped.mSize/2, mapped.mSize-16 };
+	for(PxU32 i=0;i<PX_ARRAY_SIZE(truncatedSizes);i++)
+	{
+		PxTriangleMesh* mesh = gPhysics->createTriangleMeshInPlace(mapped.mMemory, truncatedSizes[i]);
+		if(mesh)
+		{
+			printf("%s: truncated image (%d bytes) was accepted\n", name, truncatedSizes[i]);
+			mesh->release();
+			success = false;
+		}
+	}
+	gSwitchableErrorCallback.mQuiet = false;
+
+	const PxU32 nbRejected = fuzzImage(inPlaceImage, queries);
+	printf("%s: %d corrupted images rejected out of %d\n", name, nbRejected, gNbCorruptions);
+
+	return success;
+}
+
+int snippetMain(int, const char*const*)
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gSwitchableErrorCallback);
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale());
+
+	bool success = true;
+	{
+		PxArray<PxVec3> verts;
+		PxArray<PxU32> indices;
+		createTerrain(verts, indices, gTerrainSize);
+
+		PxArray<Query> queries;
+		generateQueries(queries, gNbQueries, float(gTerrainSize));
+
+		success &= runTest("Non-quantized", false, verts, indices, queries);
+		success &= runTest("Quantized", true, verts, indices, queries);
+	}
+
+	PX_RELEASE(gPhysics);
+	PX_RELEASE(gFoundation);
+
+	printf("SnippetTriangleMeshInPlace %s.\n", success ? "done" : "FAILED");
+
+	return success ? 0 : 1;
+}
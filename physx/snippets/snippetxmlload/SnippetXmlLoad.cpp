@@ -0,0 +1,306 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+// ****************************************************************************
+// This snippet measures the throughput of loading RepX (xml) collections.
+//
+// It creates a collection with triangle meshes, convex meshes and a large
+// number of actors, serializes it to xml in memory, and loads it back several
+// times with PxSerialization::createCollectionFromXml. The objects are
+// instantiated while the document is being parsed, so the reported peak
+// memory stays close to the size of the created objects rather than the size
+// of the document.
+//
+// The number of loaded objects is compared with the original collection, to
+// check that nothing was lost on the way.
+// ****************************************************************************
+
+#include <stdio.h>
+#include "PxPhysicsAPI.h"
+#include "foundation/PxArray.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxPhysics*				gPhysics	= NULL;
+static PxCooking*				gCooking	= NULL;
+
+static const PxU32	gNbTriangleMeshes	= 8;
+static const PxU32	gTriangleMeshGrid	= 64;	// Each triangle mesh is a gTriangleMeshGrid x gTriangleMeshGrid height grid
+static const PxU32	gNbConvexMeshes		= 16;
+static const PxU32	gNbDynamics			= 5000;
+static const PxU32	gNbLoads			= 5;
+
+namespace
+{
+	// Tracks the memory allocated through the SDK, to report the peak memory of a load.
+	class TrackingAllocator : public PxAllocatorCallback
+	{
+		public:
+			TrackingAllocator() : mCurrent(0), mPeak(0)	{}
+
+			virtual void* allocate(size_t size, const char* typeName, const char* filename, int line)
+			{
+				// The header keeps the 16-byte alignment of the returned memory
+				PxU8* mem = reinterpret_cast<PxU8*>(mAllocator.allocate(size + 16, typeName, filename, line));
+				if(!mem)
+					return NULL;
+				*reinterpret_cast<size_t*>(mem) = size;
+				mCurrent += size;
+				if(mCurrent > mPeak)
+					mPeak = mCurrent;
+				return mem + 16;
+			}
+
+			virtual void deallocate(void* ptr)
+			{
+				if(!ptr)
+					return;
+				PxU8* mem = reinterpret_cast<PxU8*>(ptr) - 16;
+				mCurrent -= *reinterpret_cast<size_t*>(mem);
+				mAllocator.deallocate(mem);
+			}
+
+			void	resetPeak()				{ mPeak = mCurrent;	}
+			size_t	getCurrent()	const	{ return mCurrent;	}
+			size_t	getPeak()		const	{ return mPeak;		}
+		private:
+			PxDefaultAllocator	mAllocator;
+			size_t				mCurrent;
+			size_t				mPeak;
+	};
+
+	class Timer
+	{
+		public:
+			Timer() : mStartTime(SnippetUtils::getCurrentTimeCounterValue())	{}
+
+			float	getElapsedTime()	const
+			{
+				const PxU64 stopTime = SnippetUtils::getCurrentTimeCounterValue();
+				return SnippetUtils::getElapsedTimeInMilliseconds(stopTime - mStartTime);
+			}
+		private:
+			PxU64	mStartTime;
+	};
+}
+
+static TrackingAllocator	gAllocator;
+
+static PxTriangleMesh* createTriangleMesh(PxU32 index)
+{
+	const PxU32 n = gTriangleMeshGrid;
+	PxVec3* verts = new PxVec3[n*n];
+	PxU32* indices = new PxU32[(n-1)*(n-1)*6];
+
+	for(PxU32 i=0;i<n;i++)
+	{
+		for(PxU32 j=0;j<n;j++)
+		{
+			const PxReal height = PxSin(PxReal(i)*0.37f + PxReal(index)) * PxCos(PxReal(j)*0.23f) * 2.0f;
+			verts[i*n+j] = PxVec3(PxReal(i) - PxReal(n)*0.5f, height, PxReal(j) - PxReal(n)*0.5f);
+		}
+	}
+
+	PxU32* tri = indices;
+	for(PxU32 i=0;i<n-1;i++)
+	{
+		for(PxU32 j=0;j<n-1;j++)
+		{
+			const PxU32 v = i*n+j;
+			*tri++ = v;		*tri++ = v+1;	*tri++ = v+n;
+			*tri++ = v+1;	*tri++ = v+n+1;	*tri++ = v+n;
+		}
+	}
+
+	PxTriangleMeshDesc meshDesc;
+	meshDesc.points.count		= n*n;
+	meshDesc.points.stride		= sizeof(PxVec3);
+	meshDesc.points.data		= verts;
+	meshDesc.triangles.count	= (n-1)*(n-1)*2;
+	meshDesc.triangles.stride	= 3*sizeof(PxU32);
+	meshDesc.triangles.data		= indices;
+
+	PxTriangleMesh* mesh = gCooking->createTriangleMesh(meshDesc, gPhysics->getPhysicsInsertionCallback());
+	delete [] indices;
+	delete [] verts;
+	return mesh;
+}
+
+static PxConvexMesh* createConvexMesh(PxU32 index)
+{
+	PxVec3 verts[32];
+	for(PxU32 i=0;i<32;i++)
+	{
+		const PxReal theta = PxReal(i) * 2.399963f;
+		const PxReal y = 1.0f - PxReal(i)/15.5f;
+		const PxReal r = PxSqrt(PxMax(0.0f, 1.0f - y*y));
+		verts[i] = PxVec3(PxCos(theta)*r, y, PxSin(theta)*r) * (0.5f + PxReal(index)*0.05f);
+	}
+
+	PxConvexMeshDesc convexDesc;
+	convexDesc.points.count		= 32;
+	convexDesc.points.stride	= sizeof(PxVec3);
+	convexDesc.points.data		= verts;
+	convexDesc.flags			= PxConvexFlag::eCOMPUTE_CONVEX;
+	return gCooking->createConvexMesh(convexDesc, gPhysics->getPhysicsInsertionCallback());
+}
+
+static PxCollection* createCollection()
+{
+	PxCollection* collection = PxCreateCollection();
+	PxMaterial* material = gPhysics->createMaterial(0.5f, 0.5f, 0.6f);
+	collection->add(*material);
+
+	for(PxU32 i=0;i<gNbTriangleMeshes;i++)
+	{
+		PxTriangleMesh* mesh = createTriangleMesh(i);
+		PxRigidStatic* ground = gPhysics->createRigidStatic(PxTransform(PxVec3(PxReal(i)*PxReal(gTriangleMeshGrid), 0.0f, 0.0f)));
+		PxRigidActorExt::createExclusiveShape(*ground, PxTriangleMeshGeometry(mesh), *material);
+		collection->add(*ground);
+	}
+
+	PxConvexMesh* convexes[gNbConvexMeshes];
+	for(PxU32 i=0;i<gNbConvexMeshes;i++)
+		convexes[i] = createConvexMesh(i);
+
+	for(PxU32 i=0;i<gNbDynamics;i++)
+	{
+		const PxVec3 pos(PxReal(i%100)*2.0f, 5.0f + PxReal(i/100)*2.0f, PxReal(i%7));
+		PxRigidDynamic* body = gPhysics->createRigidDynamic(PxTransform(pos));
+		if(i&1)
+			PxRigidActorExt::createExclusiveShape(*body, PxConvexMeshGeometry(convexes[i%gNbConvexMeshes]), *material);
+		else
+			PxRigidActorExt::createExclusiveShape(*body, PxBoxGeometry(0.5f, 0.25f + PxReal(i%5)*0.1f, 0.5f), *material);
+		PxRigidBodyExt::updateMassAndInertia(*body, 10.0f);
+		collection->add(*body);
+	}
+
+	// Pulls in the meshes and gives every object an id. The collection owns the
+	// meshes and the material, like a loaded collection does.
+	PxSerializationRegistry* sr = PxSerialization::createSerializationRegistry(*gPhysics);
+	PxSerialization::complete(*collection, *sr);
+	PxSerialization::createSerialObjectIds(*collection, PxSerialObjectId(1));
+	sr->release();
+	return collection;
+}
+
+static void releaseCollection(PxCollection* collection)
+{
+	// The exclusive shapes go away with their actors, the meshes and materials are released last
+	PxArray<PxBase*> sharedObjects;
+	const PxU32 nbObjects = collection->getNbObjects();
+	for(PxU32 i=0;i<nbObjects;i++)
+	{
+		PxBase& object = collection->getObject(i);
+		if(!object.is<PxRigidActor>() && !object.is<PxShape>())
+			sharedObjects.pushBack(&object);
+	}
+	for(PxU32 i=0;i<nbObjects;i++)
+	{
+		PxRigidActor* actor = collection->getObject(i).is<PxRigidActor>();
+		if(actor)
+			actor->release();
+	}
+	for(PxU32 i=0;i<sharedObjects.size();i++)
+		sharedObjects[i]->release();
+	collection->release();
+}
+
+static void initPhysics()
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale(), true);
+	gCooking = PxCreateCooking(PX_PHYSICS_VERSION, *gFoundation, PxCookingParams(PxTolerancesScale()));
+	PxInitExtensions(*gPhysics, NULL);
+}
+
+static void loadCollections()
+{
+	PxSerializationRegistry* sr = PxSerialization::createSerializationRegistry(*gPhysics);
+
+	PxDefaultMemoryOutputStream document;
+	PxU32 nbOriginalObjects;
+	{
+		PxCollection* collection = createCollection();
+		PxSerialization::serializeCollectionToXml(document, *collection, *sr, gCooking);
+		nbOriginalObjects = collection->getNbObjects();
+		releaseCollection(collection);
+	}
+	const PxReal documentSizeMB = PxReal(document.getSize())/(1024.0f*1024.0f);
+	printf("Document: %.2f MB\n", double(documentSizeMB));
+
+	float bestTime = PX_MAX_F32;
+	size_t peakMemory = 0;
+	PxU32 nbObjects = 0;
+	for(PxU32 i=0;i<gNbLoads;i++)
+	{
+		PxDefaultMemoryInputData input(document.getData(), document.getSize());
+
+		const size_t baseMemory = gAllocator.getCurrent();
+		gAllocator.resetPeak();
+		const Timer timer;
+		PxCollection* collection = PxSerialization::createCollectionFromXml(input, *gCooking, *sr);
+		const float loadTime = timer.getElapsedTime();
+		if(!collection)
+		{
+			printf("Failed to load the document.\n");
+			break;
+		}
+		bestTime = PxMin(bestTime, loadTime);
+		peakMemory = gAllocator.getPeak() - baseMemory;
+		nbObjects = collection->getNbObjects();
+		releaseCollection(collection);
+	}
+
+	printf("Loaded %d of %d objects in %.2f ms (best of %d), %.1f MB/s\n", nbObjects, nbOriginalObjects, double(bestTime), gNbLoads, double(documentSizeMB*1000.0f/bestTime));
+	printf("Peak memory during the load: %.2f MB\n", double(peakMemory)/(1024.0*1024.0));
+
+	sr->release();
+}
+
+static void cleanupPhysics()
+{
+	PxCloseExtensions();
+	PX_RELEASE(gCooking);
+	PX_RELEASE(gPhysics);
+	PX_RELEASE(gFoundation);
+}
+
+int snippetMain(int, const char*const*)
+{
+	initPhysics();
+	loadCollections();
+	cleanupPhysics();
+
+	printf("SnippetXmlLoad done.\n");
+
+	return 0;
+}
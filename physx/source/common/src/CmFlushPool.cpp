@@ -0,0 +1,84 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "foundation/PxAtomic.h"
+#include "CmFlushPool.h"
+
+using namespace physx;
+
+namespace
+{
+	// Guards the creation and release of the TLS slot, which can happen from any thread creating or releasing a scene.
+	// A static PxMutex would be constructed before the foundation exists, so this spins instead.
+	volatile PxI32	gLock = 0;
+	PxU32			gNbPools = 0;
+	PxU32			gTlsIndex = 0;
+	volatile PxI32	gNbThreads = 0;
+
+	class SpinLock
+	{
+	public:
+		SpinLock()
+		{
+			while(PxAtomicCompareExchange(&gLock, 1, 0))
+				PxThread::yield();
+		}
+
+		~SpinLock()
+		{
+			PxAtomicExchange(&gLock, 0);
+		}
+	};
+}
+
+PxU32 Cm::acquireFlushPoolTlsIndex()
+{
+	SpinLock lock;
+	if(!gNbPools++)
+	{
+		// the new slot reads 0 on all threads, so the thread indices can start over
+		gTlsIndex = PxTlsAlloc();
+		gNbThreads = 0;
+	}
+	return gTlsIndex;
+}
+
+void Cm::releaseFlushPoolTlsIndex()
+{
+	SpinLock lock;
+	PX_ASSERT(gNbPools);
+	if(!--gNbPools)
+		PxTlsFree(gTlsIndex);
+}
+
+PxU32 Cm::claimFlushPoolThreadIndex(PxU32 tlsIndex)
+{
+	const PxU32 threadIndex = PxU32(PxAtomicIncrement(&gNbThreads) - 1);
+	PxTlsSetValue(tlsIndex, size_t(threadIndex) + 1);
+	return threadIndex;
+}
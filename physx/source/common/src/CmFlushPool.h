@@ -25,18 +25,29 @@
 // Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
 // Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
 // Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
-
 #ifndef CM_FLUSH_POOL_H
 #define CM_FLUSH_POOL_H
 
 #include "foundation/Px.h"
 #include "foundation/PxUserAllocated.h"
 #include "foundation/PxBitUtils.h"
+#include "foundation/PxMath.h"
 #include "foundation/PxMutex.h"
-#include "foundation/PxArray.h"
+#include "foundation/PxMemory.h"
+#include "foundation/PxAlignedMalloc.h"
+#include "foundation/PxThread.h"
+#include "common/PxPhysXCommonConfig.h"
 
 /*
-Pool used to allocate variable sized tasks. It's intended to be cleared after a short period (time step).
+Pool used to allocate variable sized tasks and other data living for one simulation step. It's intended to be cleared
+after a short period (time step).
+
+Each thread allocates from its own sub-arena, i.e. from the chunk it took last, so allocations do not lock unless the
+thread needs a new chunk. All pools share one TLS slot, holding a process-wide index of the thread into the sub-arena
+table of each pool. Threads beyond the size of the table share one sub-arena, under the lock. Chunks are chained and recycled from one step to the next, and allocations larger than a chunk
+get their own block. The chunks covering a user-defined reserved size are allocated up front and never released before
+the pool. Clearing the pool only splices the used chunks back into the free list and bumps an epoch, which
+invalidates the sub-arenas of all threads at once.
 */
 
 namespace physx
@@ -45,54 +56,107 @@ namespace Cm
 {
 	static const PxU32 sSpareChunkCount = 2;
 
+	// The shared TLS slot of the flush pools, allocated with the first pool and freed with the last one
+	PX_PHYSX_COMMON_API PxU32	acquireFlushPoolTlsIndex();
+	PX_PHYSX_COMMON_API void	releaseFlushPoolTlsIndex();
+
+	// Gives the calling thread its index, stored in the TLS slot plus one so that 0 means no index yet
+	PX_PHYSX_COMMON_API PxU32	claimFlushPoolThreadIndex(PxU32 tlsIndex);
+
 	class FlushPool
 	{
 		PX_NOCOPY(FlushPool)
+
+		struct Chunk
+		{
+			Chunk*	mNext;
+		};
+
+		// aligned to keep the sub-arenas of different threads on different cache lines
+		PX_ALIGN_PREFIX(64)
+		struct SubArena
+		{
+			PxU8*	mCurrent;
+			PxU8*	mEnd;
+			PxU32	mEpoch;
+
+			PX_FORCE_INLINE void* allocate(PxU32 size, PxU32 alignment)
+			{
+				PxU8* ptr = reinterpret_cast<PxU8*>((size_t(mCurrent)+alignment-1)&~(size_t(alignment)-1));
+				if(ptr + size > mEnd)
+					return NULL;
+				mCurrent = ptr + size;
+				return ptr;
+			}
+		}
+		PX_ALIGN_SUFFIX(64);
+
+		// chunk header, rounded up to keep the payload 16-byte aligned
+		static const PxU32 sHeaderSize = (sizeof(Chunk)+15)&~15;
+
+		static const PxU32 sMaxNbThreads = 256;
+
 	public:
-		FlushPool(PxU32 chunkSize) : mChunks("FlushPoolChunk"), mChunkIndex(0), mOffset(0), mChunkSize(chunkSize)
+		FlushPool(PxU32 chunkSize, PxU32 reservedSize = 0) :
+			mTlsIndex		(acquireFlushPoolTlsIndex()),
+			mSharedArena	(NULL),
+			mEpoch			(1),
+			mFreeChunks		(NULL),
+			mUsedChunks		(NULL),
+			mUsedChunksTail	(NULL),
+			mLargeBlocks	(NULL),
+			mNbChunks		(0),
+			mNbUsedChunks	(0),
+			mNbReservedChunks(PxU32((PxU64(reservedSize) + chunkSize - 1) / chunkSize)),
+			mChunkSize		(chunkSize),
+			mLargeBytes		(0),
+			mLastUsedBytes	(0),
+			mPeakUsedBytes	(0)
 		{
-			mChunks.pushBack(static_cast<PxU8*>(PX_ALLOC(mChunkSize, "PxU8")));
+			PxMemZero(mSubArenas, sizeof(mSubArenas));
+
+			for(; mNbChunks < mNbReservedChunks; mNbChunks++)
+			{
+				Chunk* chunk = reinterpret_cast<Chunk*>(PX_ALLOC(sHeaderSize + mChunkSize, "FlushPoolChunk"));
+				chunk->mNext = mFreeChunks;
+				mFreeChunks = chunk;
+			}
 		}
 
 		~FlushPool()
 		{
-			for (PxU32 i = 0; i < mChunks.size(); ++i)
-				PX_FREE(mChunks[i]);
+			resetNotThreadSafe();
+
+			for (PxU32 i = 0; i < sMaxNbThreads; ++i)
+				PxAlignedAllocator<64>().deallocate(mSubArenas[i]);
+			PxAlignedAllocator<64>().deallocate(mSharedArena);
+
+			releaseFlushPoolTlsIndex();
 		}
 
 		// alignment must be a power of two
 		void* allocate(PxU32 size, PxU32 alignment=16)
 		{
-			PxMutex::ScopedLock lock(mMutex);
-			return allocateNotThreadSafe(size, alignment);
+			PX_ASSERT(PxIsPowerOfTwo(alignment));
+
+			SubArena* arena = getSubArena();
+			void* ptr = arena ? arena->allocate(size, alignment) : NULL;
+			if(!ptr)
+			{
+				PxMutex::ScopedLock lock(mMutex);
+				ptr = allocateSlow(arena, size, alignment);
+			}
+			return ptr;
 		}
 
-		// alignment must be a power of two
+		// alignment must be a power of two. The caller holds the lock (see lock()).
 		void* allocateNotThreadSafe(PxU32 size, PxU32 alignment=16)
 		{
 			PX_ASSERT(PxIsPowerOfTwo(alignment));
-			PX_ASSERT(size <= mChunkSize && !mChunks.empty());
-			
-			// padding for alignment
-			size_t unalignedStart = size_t(mChunks[mChunkIndex]+mOffset);
-			PxU32 pad = PxU32(((unalignedStart+alignment-1)&~(size_t(alignment)-1)) - unalignedStart);
-
-			if (mOffset + size + pad > mChunkSize)
-			{
-				mChunkIndex++;
-				mOffset = 0;
-				if (mChunkIndex >= mChunks.size())
-					mChunks.pushBack(static_cast<PxU8*>(PX_ALLOC(mChunkSize, "PxU8")));
-
-				// update padding to ensure new alloc is aligned
-				unalignedStart = size_t(mChunks[mChunkIndex]);
-				pad = PxU32(((unalignedStart+alignment-1)&~(size_t(alignment)-1)) - unalignedStart);
-			}
 
-			void* ptr = mChunks[mChunkIndex] + mOffset + pad;
-			PX_ASSERT((size_t(ptr)&(size_t(alignment)-1)) == 0);
-			mOffset += size + pad;
-			return ptr;
+			SubArena* arena = getSubArena();
+			void* ptr = arena ? arena->allocate(size, alignment) : NULL;
+			return ptr ? ptr : allocateSlow(arena, size, alignment);
 		}
 
 		void clear(PxU32 spareChunkCount = sSpareChunkCount)
@@ -102,33 +166,58 @@ namespace Cm
 			clearNotThreadSafe(spareChunkCount);
 		}
 
+		// Releases everything allocated since the last clear. Apart from releasing the spare chunks beyond spareChunkCount
+		// and the reserved ones, and the blocks of allocations larger than a chunk, this does not depend on the number of
+		// allocations or chunks.
 		void clearNotThreadSafe(PxU32 spareChunkCount = sSpareChunkCount)
 		{
-			PX_UNUSED(spareChunkCount);
+			const PxU64 usedBytes = PxU64(mNbUsedChunks)*mChunkSize + mLargeBytes;
+			mLastUsedBytes = usedBytes;
+			mPeakUsedBytes = PxMax(mPeakUsedBytes, usedBytes);
+
+			if(mUsedChunks)
+			{
+				mUsedChunksTail->mNext = mFreeChunks;
+				mFreeChunks = mUsedChunks;
+				mUsedChunks = mUsedChunksTail = NULL;
+			}
 
 			//release memory not used previously
-			PxU32 targetSize = mChunkIndex+sSpareChunkCount;
-			while (mChunks.size() > targetSize)
+			const PxU32 targetSize = PxMax(mNbUsedChunks + spareChunkCount, mNbReservedChunks);
+			while(mNbChunks > targetSize)
 			{
-				PxU8* ptr = mChunks.popBack();
-				PX_FREE(ptr);
+				Chunk* chunk = mFreeChunks;
+				mFreeChunks = chunk->mNext;
+				PX_FREE(chunk);
+				mNbChunks--;
 			}
 
-			mChunkIndex = 0;
-			mOffset = 0;
+			while(mLargeBlocks)
+			{
+				Chunk* block = mLargeBlocks;
+				mLargeBlocks = block->mNext;
+				PX_FREE(block);
+			}
+
+			mNbUsedChunks = 0;
+			mLargeBytes = 0;
+
+			// invalidates the sub-arenas of all threads
+			mEpoch++;
 		}
 
+		// Same as clearNotThreadSafe(), releasing all chunks including the reserved ones
 		void resetNotThreadSafe()
 		{
-			PxU8* firstChunk = mChunks[0];
+			clearNotThreadSafe(0);
 
-			for (PxU32 i = 1; i < mChunks.size(); ++i)
-				PX_FREE(mChunks[i]);
-
-			mChunks.clear();
-			mChunks.pushBack(firstChunk);
-			mChunkIndex = 0;
-			mOffset = 0;
+			while(mFreeChunks)
+			{
+				Chunk* chunk = mFreeChunks;
+				mFreeChunks = chunk->mNext;
+				PX_FREE(chunk);
+			}
+			mNbChunks = 0;
 		}
 
 		void lock()
@@ -141,12 +230,110 @@ namespace Cm
 			mMutex.unlock();	
 		}
 
+		// Memory taken from the pool between the last two clears, in bytes. Chunks are counted as a whole.
+		PX_FORCE_INLINE	PxU64	getLastUsedBytes()	const	{ return mLastUsedBytes;	}
+
+		// Largest value of getLastUsedBytes() so far
+		PX_FORCE_INLINE	PxU64	getPeakUsedBytes()	const	{ return mPeakUsedBytes;	}
+
 	private:
-		PxMutex mMutex;
-		PxArray<PxU8*> mChunks;
-		PxU32 mChunkIndex;
-		PxU32 mOffset;
-		PxU32 mChunkSize;
+		// Returns NULL if the calling thread has no sub-arena yet, or if it is not valid for this step. A sub-arena is only
+		// touched by its thread, except for the shared one which is only used under the lock and never returned here.
+		PX_FORCE_INLINE SubArena* getSubArena() const
+		{
+			const size_t threadIndex = PxTlsGetValue(mTlsIndex) - 1;
+			SubArena* arena = threadIndex < sMaxNbThreads ? mSubArenas[threadIndex] : NULL;
+			return arena && arena->mEpoch == mEpoch ? arena : NULL;
+		}
+
+		// mMutex must be held
+		SubArena* getOrCreateSubArena()
+		{
+			const size_t value = PxTlsGetValue(mTlsIndex);
+			const PxU32 threadIndex = value ? PxU32(value - 1) : claimFlushPoolThreadIndex(mTlsIndex);
+			SubArena*& arena = threadIndex < sMaxNbThreads ? mSubArenas[threadIndex] : mSharedArena;
+			if(!arena)
+			{
+				arena = reinterpret_cast<SubArena*>(PxAlignedAllocator<64>().allocate(sizeof(SubArena), PX_FL));
+				arena->mCurrent = arena->mEnd = NULL;
+				arena->mEpoch = mEpoch - 1;
+			}
+			return arena;
+		}
+
+		// mMutex must be held. arena is the sub-arena of the calling thread, or NULL if it is not valid for this step.
+		void* allocateSlow(SubArena* arena, PxU32 size, PxU32 alignment)
+		{
+			if(!arena)
+			{
+				arena = getOrCreateSubArena();
+				if(arena->mEpoch != mEpoch)
+				{
+					arena->mCurrent = arena->mEnd = NULL;
+					arena->mEpoch = mEpoch;
+				}
+				else
+				{
+					// the shared sub-arena of the threads without an index can still have room
+					void* ptr = arena->allocate(size, alignment);
+					if(ptr)
+						return ptr;
+				}
+			}
+
+			// allocations which do not fit in a chunk get their own block, released by the next clear
+			const PxU32 worstCaseSize = size + (alignment > 16 ? alignment : 0);
+			if(worstCaseSize > mChunkSize)
+			{
+				Chunk* block = reinterpret_cast<Chunk*>(PX_ALLOC(sHeaderSize + worstCaseSize, "FlushPoolLargeBlock"));
+				block->mNext = mLargeBlocks;
+				mLargeBlocks = block;
+				mLargeBytes += worstCaseSize;
+
+				const size_t start = size_t(block) + sHeaderSize;
+				return reinterpret_cast<void*>((start+alignment-1)&~(size_t(alignment)-1));
+			}
+
+			Chunk* chunk = mFreeChunks;
+			if(chunk)
+				mFreeChunks = chunk->mNext;
+			else
+			{
+				chunk = reinterpret_cast<Chunk*>(PX_ALLOC(sHeaderSize + mChunkSize, "FlushPoolChunk"));
+				mNbChunks++;
+			}
+
+			chunk->mNext = mUsedChunks;
+			if(!mUsedChunks)
+				mUsedChunksTail = chunk;
+			mUsedChunks = chunk;
+			mNbUsedChunks++;
+
+			// the rest of the previous chunk of this thread is lost until the next clear
+			arena->mCurrent = reinterpret_cast<PxU8*>(chunk) + sHeaderSize;
+			arena->mEnd = arena->mCurrent + mChunkSize;
+
+			void* ptr = arena->allocate(size, alignment);
+			PX_ASSERT(ptr && (size_t(ptr)&(size_t(alignment)-1)) == 0);
+			return ptr;
+		}
+
+		PxMutex				mMutex;
+		SubArena*			mSubArenas[sMaxNbThreads];	// indexed by the thread index of the shared TLS slot
+		const PxU32			mTlsIndex;
+		SubArena*			mSharedArena;				// for the threads with an index beyond the table
+		PxU32				mEpoch;
+		Chunk*				mFreeChunks;
+		Chunk*				mUsedChunks;
+		Chunk*				mUsedChunksTail;
+		Chunk*				mLargeBlocks;
+		PxU32				mNbChunks;
+		PxU32				mNbUsedChunks;
+		const PxU32			mNbReservedChunks;
+		const PxU32			mChunkSize;
+		PxU64				mLargeBytes;
+		PxU64				mLastUsedBytes;
+		PxU64				mPeakUsedBytes;
 	};
 
 	
@@ -153,6 +153,7 @@ SET(PHYSX_PVD_HEADERS
 	${PHYSX_ROOT_DIR}/include/pvd/PxPvdSceneClient.h
 	${PHYSX_ROOT_DIR}/include/pvd/PxPvd.h
 	${PHYSX_ROOT_DIR}/include/pvd/PxPvdTransport.h
+	${PHYSX_ROOT_DIR}/include/pvd/PxPvdAsyncFileTransport.h
 )
 SOURCE_GROUP(include\\pvd FILES ${PHYSX_PVD_HEADERS})
 
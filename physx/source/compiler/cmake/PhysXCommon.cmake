@@ -49,6 +49,7 @@ SET(PHYSX_COMMON_SOURCE
 	${COMMON_SRC_DIR}/CmCollection.cpp
 	${COMMON_SRC_DIR}/CmConeLimitHelper.h
 	${COMMON_SRC_DIR}/CmFlushPool.h
+	${COMMON_SRC_DIR}/CmFlushPool.cpp
 	${COMMON_SRC_DIR}/CmIDPool.h
 	${COMMON_SRC_DIR}/CmMatrix34.h
 	${COMMON_SRC_DIR}/CmPool.h
@@ -183,6 +184,7 @@ SET(PHYSXCOMMON_GU_SOURCE
 	${GU_SOURCE_DIR}/src/GuCapsule.cpp
 	${GU_SOURCE_DIR}/src/GuCCTSweepTests.cpp	
 	${GU_SOURCE_DIR}/src/GuGeometryQuery.cpp
+	${GU_SOURCE_DIR}/src/GuGeometryQueryBatch.cpp
 	${GU_SOURCE_DIR}/src/GuInternal.cpp
 	${GU_SOURCE_DIR}/src/GuMeshFactory.cpp
 	${GU_SOURCE_DIR}/src/GuMetaData.cpp
@@ -228,10 +230,13 @@ SET(PHYSXCOMMON_GU_COMMON_SOURCE
 	${GU_SOURCE_DIR}/src/common/GuEdgeList.cpp
 	${GU_SOURCE_DIR}/src/common/GuSeparatingAxes.h
 	${GU_SOURCE_DIR}/src/common/GuSeparatingAxes.cpp
+	${GU_SOURCE_DIR}/src/common/GuSoAVec3.h
 	${GU_SOURCE_DIR}/src/common/GuQuantizer.h
 	${GU_SOURCE_DIR}/src/common/GuQuantizer.cpp
 	${GU_SOURCE_DIR}/src/common/GuMeshCleaner.h
 	${GU_SOURCE_DIR}/src/common/GuMeshCleaner.cpp
+	${GU_SOURCE_DIR}/src/common/GuCookingScratch.h
+	${GU_SOURCE_DIR}/src/common/GuCookingScratch.cpp
 	${GU_SOURCE_DIR}/src/common/GuVertexReducer.h
 	${GU_SOURCE_DIR}/src/common/GuVertexReducer.cpp
     ${GU_SOURCE_DIR}/src/common/GuMeshAnalysis.h
@@ -294,6 +299,7 @@ SET(PHYSXCOMMON_GU_DISTANCE_SOURCE
 	${GU_SOURCE_DIR}/src/distance/GuDistanceSegmentTriangle.cpp
 	${GU_SOURCE_DIR}/src/distance/GuDistancePointTetrahedron.cpp
 	${GU_SOURCE_DIR}/src/distance/GuDistancePointBox.h
+	${GU_SOURCE_DIR}/src/distance/GuDistancePointBatchSIMD.h
 	${GU_SOURCE_DIR}/src/distance/GuDistancePointSegment.h
 	${GU_SOURCE_DIR}/src/distance/GuDistancePointTriangle.h
 	${GU_SOURCE_DIR}/src/distance/GuDistancePointTriangleSIMD.h
@@ -331,12 +337,14 @@ SOURCE_GROUP(geomutils\\src\\gjk FILES ${PHYSXCOMMON_GU_GJK_SOURCE})
 
 SET(PHYSXCOMMON_GU_HF_SOURCE
 	${GU_SOURCE_DIR}/src/hf/GuHeightField.cpp
+	${GU_SOURCE_DIR}/src/hf/GuHeightFieldPyramid.cpp
 	${GU_SOURCE_DIR}/src/hf/GuHeightFieldUtil.cpp
 	${GU_SOURCE_DIR}/src/hf/GuOverlapTestsHF.cpp
 	${GU_SOURCE_DIR}/src/hf/GuSweepsHF.cpp
 	${GU_SOURCE_DIR}/src/hf/GuEntityReport.h
 	${GU_SOURCE_DIR}/src/hf/GuHeightField.h
 	${GU_SOURCE_DIR}/src/hf/GuHeightFieldData.h
+	${GU_SOURCE_DIR}/src/hf/GuHeightFieldPyramid.h
 	${GU_SOURCE_DIR}/src/hf/GuHeightFieldUtil.h
 )
 SOURCE_GROUP(geomutils\\src\\hf FILES ${PHYSXCOMMON_GU_HF_SOURCE})
@@ -354,6 +362,7 @@ SET(PHYSXCOMMON_GU_INTERSECTION_SOURCE
 	${GU_SOURCE_DIR}/src/intersection/GuIntersectionTriangleTriangle.cpp
 	${GU_SOURCE_DIR}/src/intersection/GuIntersectionCapsuleTriangle.h
 	${GU_SOURCE_DIR}/src/intersection/GuIntersectionEdgeEdge.h
+	${GU_SOURCE_DIR}/src/intersection/GuIntersectionBatchSIMD.h
 	${GU_SOURCE_DIR}/src/intersection/GuIntersectionRay.h
 	${GU_SOURCE_DIR}/src/intersection/GuIntersectionRayBox.h
 	${GU_SOURCE_DIR}/src/intersection/GuIntersectionRayBoxSIMD.h
@@ -372,6 +381,7 @@ SET(PXCOMMON_BVH4_FILES
 	${GU_SOURCE_DIR}/src/mesh/GuBV4_CapsuleSweepAA.cpp
 	${GU_SOURCE_DIR}/src/mesh/GuBV4_MeshMeshOverlap.cpp
 	${GU_SOURCE_DIR}/src/mesh/GuBV4_OBBSweep.cpp
+	${GU_SOURCE_DIR}/src/mesh/GuBV4_PointDistanceBatch.cpp
 	${GU_SOURCE_DIR}/src/mesh/GuBV4_Raycast.cpp
 	${GU_SOURCE_DIR}/src/mesh/GuBV4_SphereOverlap.cpp
 	${GU_SOURCE_DIR}/src/mesh/GuBV4_SphereSweep.cpp
@@ -431,6 +441,7 @@ SET(PHYSXCOMMON_GU_MESH_SOURCE
 	${GU_SOURCE_DIR}/src/mesh/GuTriangleCache.h
 	${GU_SOURCE_DIR}/src/mesh/GuTriangleMesh.h
 	${GU_SOURCE_DIR}/src/mesh/GuTriangleMeshBV4.h
+	${GU_SOURCE_DIR}/src/mesh/GuTriangleMeshInPlace.h
 	${GU_SOURCE_DIR}/src/mesh/GuTriangleMeshRTree.h
 	${GU_SOURCE_DIR}/src/mesh/GuTetrahedron.h
 	${GU_SOURCE_DIR}/src/mesh/GuTetrahedronMesh.h
@@ -512,6 +523,7 @@ SET(PHYSXCOMMON_GU_PRUNERS_SOURCE
 	${GU_SOURCE_DIR}/src/GuAABBTreeBounds.h
 	${GU_SOURCE_DIR}/src/GuAABBTreeNode.h
 	${GU_SOURCE_DIR}/src/GuAABBTreeBuildStats.h
+	${GU_SOURCE_DIR}/src/GuBuildTask.h
 	${GU_SOURCE_DIR}/src/GuAABBTreeQuery.h
 	${GU_SOURCE_DIR}/src/GuSqInternal.cpp
 	${GU_SOURCE_DIR}/src/GuIncrementalAABBTree.h
@@ -521,6 +533,8 @@ SET(PHYSXCOMMON_GU_PRUNERS_SOURCE
 	${GU_SOURCE_DIR}/src/GuBVH.cpp
 	${GU_SOURCE_DIR}/src/GuBVH.h
 	${GU_SOURCE_DIR}/src/GuBVHTestsSIMD.h
+	${GU_SOURCE_DIR}/src/GuWideBVH.cpp
+	${GU_SOURCE_DIR}/src/GuWideBVH.h
 	${GU_SOURCE_DIR}/src/GuIncrementalAABBPrunerCore.h
 	${GU_SOURCE_DIR}/src/GuIncrementalAABBPrunerCore.cpp
 	${GU_SOURCE_DIR}/src/GuIncrementalAABBPruner.h
@@ -537,6 +551,8 @@ SET(PHYSXCOMMON_GU_PRUNERS_SOURCE
 	${GU_SOURCE_DIR}/src/GuSecondaryPruner.cpp
 	${GU_SOURCE_DIR}/src/GuAABBPruner.h
 	${GU_SOURCE_DIR}/src/GuAABBPruner.cpp
+	${GU_SOURCE_DIR}/src/GuPagedPruner.h
+	${GU_SOURCE_DIR}/src/GuPagedPruner.cpp
 	${GU_SOURCE_DIR}/src/GuActorShapeMap.cpp
 	${GU_SOURCE_DIR}/src/GuCallbackAdapter.h
 	${GU_SOURCE_DIR}/src/GuQuerySystem.cpp
@@ -75,6 +75,8 @@ SET(PHYSX_EXTENSIONS_SOURCE
 	${LL_SOURCE_DIR}/ExtTetMakerExt.cpp
 	${LL_SOURCE_DIR}/ExtGjkQueryExt.cpp
 	${LL_SOURCE_DIR}/ExtCustomGeometryExt.cpp
+	${LL_SOURCE_DIR}/ExtTiledHeightField.cpp
+	${LL_SOURCE_DIR}/ExtSceneSnapshot.cpp
 )
 
 #TODO, create a propper define for whether GPU features are enabled or not!
@@ -180,12 +182,14 @@ SET(PHYSX_EXTENSIONS_HEADERS
 	${PHYSX_ROOT_DIR}/include/extensions/PxRigidBodyExt.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxSceneQueryExt.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxSceneQuerySystemExt.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxSceneSnapshot.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxCustomSceneQuerySystem.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxSerialization.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxShapeExt.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxSimpleFactory.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxSmoothNormals.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxSoftBodyExt.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxStreamingCollectionLoader.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxStringTableExt.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxTriangleMeshExt.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxTetrahedronMeshExt.h
@@ -285,6 +289,8 @@ SET(PHYSX_EXTENSIONS_SERIALIZATION_BINARY_SOURCE
 	${LL_SOURCE_DIR}/serialization/Binary/SnConvX_Output.cpp
 	${LL_SOURCE_DIR}/serialization/Binary/SnConvX_Union.cpp
 	${LL_SOURCE_DIR}/serialization/Binary/SnSerializationContext.cpp
+	${LL_SOURCE_DIR}/serialization/Binary/SnStreamingCollectionLoader.cpp
+	${LL_SOURCE_DIR}/serialization/Binary/SnBinaryDeserialization.h
 	${LL_SOURCE_DIR}/serialization/Binary/SnConvX.h
 	${LL_SOURCE_DIR}/serialization/Binary/SnConvX_Align.h
 	${LL_SOURCE_DIR}/serialization/Binary/SnConvX_Common.h
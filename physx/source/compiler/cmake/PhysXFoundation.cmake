@@ -90,8 +90,10 @@ SET(PHYSXFOUNDATION_HEADERS
 	${PHYSX_ROOT_DIR}/include/foundation/PxSync.h
 	${PHYSX_ROOT_DIR}/include/foundation/PxTempAllocator.h
 	${PHYSX_ROOT_DIR}/include/foundation/PxThread.h
+	${PHYSX_ROOT_DIR}/include/foundation/PxThreadCachingAllocator.h
 	${PHYSX_ROOT_DIR}/include/foundation/PxTransform.h
 	${PHYSX_ROOT_DIR}/include/foundation/PxTime.h
+	${PHYSX_ROOT_DIR}/include/foundation/PxTraceProfiler.h
 	${PHYSX_ROOT_DIR}/include/foundation/PxUnionCast.h
 	${PHYSX_ROOT_DIR}/include/foundation/PxUserAllocated.h
 	${PHYSX_ROOT_DIR}/include/foundation/PxUtilities.h
@@ -113,6 +115,9 @@ SET(PHYSXFOUNDATION_SOURCE
 	${LL_SOURCE_DIR}/FdAllocator.cpp
 	${LL_SOURCE_DIR}/FdString.cpp
 	${LL_SOURCE_DIR}/FdTempAllocator.cpp
+	${LL_SOURCE_DIR}/FdThreadCachingAllocator.cpp
+	${LL_SOURCE_DIR}/FdThreadCachingAllocator.h
+	${LL_SOURCE_DIR}/FdTraceProfiler.cpp
 	${LL_SOURCE_DIR}/FdAssert.cpp
 	${LL_SOURCE_DIR}/FdMathUtils.cpp
 	${LL_SOURCE_DIR}/FdFoundation.cpp
@@ -38,6 +38,7 @@ include(${PHYSX_ROOT_DIR}/${PROJECT_CMAKE_FILES_DIR}/${TARGET_BUILD_PLATFORM}/Ph
 SET(PHYSXPVDSDK_HEADERS
 	${PHYSX_ROOT_DIR}/include/pvd/PxPvd.h
 	${PHYSX_ROOT_DIR}/include/pvd/PxPvdTransport.h
+	${PHYSX_ROOT_DIR}/include/pvd/PxPvdAsyncFileTransport.h
 )
 SOURCE_GROUP(include FILES ${PHYSXPVDSDK_HEADERS})
 
@@ -68,7 +69,11 @@ SET(PHYSXPVDSDK_SOURCE
 	${LL_SOURCE_DIR}/src/PxProfileZoneManager.h
 	${LL_SOURCE_DIR}/src/PxProfileZoneManagerImpl.h
 	${LL_SOURCE_DIR}/src/PxPvd.cpp
+	${LL_SOURCE_DIR}/src/PxPvdAsyncFileTransport.cpp
+	${LL_SOURCE_DIR}/src/PxPvdAsyncFileTransport.h
 	${LL_SOURCE_DIR}/src/PxPvdBits.h
+	${LL_SOURCE_DIR}/src/PxPvdBlockCodec.cpp
+	${LL_SOURCE_DIR}/src/PxPvdBlockCodec.h
 	${LL_SOURCE_DIR}/src/PxPvdByteStreams.h
 	${LL_SOURCE_DIR}/src/PxPvdCommStreamEvents.h
 	${LL_SOURCE_DIR}/src/PxPvdCommStreamEventSink.h
@@ -49,25 +49,14 @@ Foundation::Foundation(PxErrorCallback& errc, PxAllocatorCallback& alloc)
 #endif
     mErrorMask(PxErrorCode::Enum(~0))
 , mErrorMutex("Foundation::mErrorMutex")
-, mTempAllocMutex("Foundation::mTempAllocMutex")
+, mTempAllocator(mBroadcastingAllocator)
 , mRefCount(0)
 {
 }
 
 Foundation::~Foundation()
 {
-	// deallocate temp buffer allocations
-	PxAllocator alloc;
-	for(PxU32 i = 0; i < mTempAllocFreeTable.size(); ++i)
-	{
-		for(PxTempAllocatorChunk* ptr = mTempAllocFreeTable[i]; ptr;)
-		{
-			PxTempAllocatorChunk* next = ptr->mNext;
-			alloc.deallocate(ptr);
-			ptr = next;
-		}
-	}
-	mTempAllocFreeTable.reset();
+	// temp buffer allocations are deallocated by mTempAllocator
 }
 
 Foundation& Foundation::getInstance()
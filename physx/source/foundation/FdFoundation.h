@@ -38,6 +38,7 @@
 #include "foundation/PxBroadcast.h"
 #include "foundation/PxTempAllocator.h"
 #include "foundation/PxMutex.h"
+#include "FdThreadCachingAllocator.h"
 
 #include <stdarg.h>
 
@@ -55,7 +56,6 @@ class PX_FOUNDATION_API Foundation : public PxFoundation, public PxUserAllocated
 
   public:
 	typedef PxMutexT<PxAllocator> Mutex;
-	typedef PxArray<PxTempAllocatorChunk*, PxAllocator> AllocFreeTable;
 
   public:
 	// factory
@@ -120,14 +120,10 @@ class PX_FOUNDATION_API Foundation : public PxFoundation, public PxUserAllocated
 		mReportAllocationNames = value;
 	}
 
-	PX_INLINE AllocFreeTable& getTempAllocFreeTable()
+	PX_INLINE ThreadCachingAllocator& getTempAllocator()
 	{
-		return mTempAllocFreeTable;
-	}
-	PX_INLINE Mutex& getTempAllocMutex()
-	{
-		return mTempAllocMutex;
-	}
+		return mTempAllocator;
+	} // Return the allocator behind PxTempAllocator
 	// End allocations
 
   private:
@@ -148,8 +144,7 @@ class PX_FOUNDATION_API Foundation : public PxFoundation, public PxUserAllocated
 	PxErrorCode::Enum mErrorMask;
 	Mutex mErrorMutex;
 
-	AllocFreeTable mTempAllocFreeTable;
-	Mutex mTempAllocMutex;
+	ThreadCachingAllocator mTempAllocator;
 
 	Mutex mListenerMutex;
 
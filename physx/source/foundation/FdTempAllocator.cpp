@@ -26,99 +26,22 @@
 // Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
 // Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
 
-#include "foundation/PxMath.h"
-#include "foundation/PxIntrinsics.h"
-#include "foundation/PxBitUtils.h"
-#include "foundation/PxArray.h"
-#include "foundation/PxMutex.h"
-#include "foundation/PxAtomic.h"
 #include "foundation/PxTempAllocator.h"
 #include "FdFoundation.h"
 
-#if PX_VC
-#pragma warning(disable : 4706) // assignment within conditional expression
-#endif
-
 namespace physx
 {
-namespace
-{
-typedef PxTempAllocatorChunk Chunk;
-typedef PxArray<Chunk*, PxAllocator> AllocFreeTable;
 
-PX_INLINE Foundation::AllocFreeTable& getFreeTable()
-{
-	return getFoundation().getTempAllocFreeTable();
-}
-PX_INLINE Foundation::Mutex& getMutex()
-{
-	return getFoundation().getTempAllocMutex();
-}
-
-const PxU32 sMinIndex = 8;  // 256B min
-const PxU32 sMaxIndex = 17; // 128kB max
-}
+// Chunks are cached per thread by the foundation's ThreadCachingAllocator, see FdThreadCachingAllocator.cpp
 
 void* PxTempAllocator::allocate(size_t size, const char* filename, PxI32 line)
 {
-	if(!size)
-		return 0;
-
-	PxU32 index = PxMax(PxHighestSetBit(PxU32(size) + sizeof(Chunk) - 1), sMinIndex);
-
-	Chunk* chunk = 0;
-	if(index < sMaxIndex)
-	{
-		Foundation::Mutex::ScopedLock lock(getMutex());
-
-		// find chunk up to 16x bigger than necessary
-		Chunk** it = getFreeTable().begin() + index - sMinIndex;
-		Chunk** end = PxMin(it + 3, getFreeTable().end());
-		while(it < end && !(*it))
-			++it;
-
-		if(it < end)
-		{
-			// pop top off freelist
-			chunk = *it;
-			*it = chunk->mNext;
-			index = PxU32(it - getFreeTable().begin() + sMinIndex);
-		}
-		else
-			// create new chunk
-			chunk = reinterpret_cast<Chunk*>(PxAllocator().allocate(size_t(2 << index), filename, line));
-	}
-	else
-	{
-		// too big for temp allocation, forward to base allocator
-		chunk = reinterpret_cast<Chunk*>(PxAllocator().allocate(size + sizeof(Chunk), filename, line));
-	}
-
-	chunk->mIndex = index;
-	void* ret = chunk + 1;
-	PX_ASSERT((size_t(ret) & 0xf) == 0); // SDK types require at minimum 16 byte allignment.
-	return ret;
+	return getFoundation().getTempAllocator().allocate(size, "", filename, line);
 }
 
 void PxTempAllocator::deallocate(void* ptr)
 {
-	if(!ptr)
-		return;
-
-	Chunk* chunk = reinterpret_cast<Chunk*>(ptr) - 1;
-	PxU32 index = chunk->mIndex;
-
-	if(index >= sMaxIndex)
-		return PxAllocator().deallocate(chunk);
-
-	Foundation::Mutex::ScopedLock lock(getMutex());
-
-	index -= sMinIndex;
-	if(getFreeTable().size() <= index)
-		getFreeTable().resize(index + 1);
-
-	chunk->mNext = getFreeTable()[index];
-	getFreeTable()[index] = chunk;
+	getFoundation().getTempAllocator().deallocate(ptr);
 }
 
 } // namespace physx
@@ -0,0 +1,490 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+
+
+#include "foundation/PxMath.h"
+#include "foundation/PxBitUtils.h"
+#include "foundation/PxMemory.h"
+#include "foundation/PxThread.h"
+#include "foundation/PxAtomic.h"
+#include "FdThreadCachingAllocator.h"
+#include "FdFoundation.h"
+
+using namespace physx;
+
+namespace
+{
+	typedef ThreadCachingAllocator::Chunk Chunk;
+
+	// Free chunks are linked through Chunk::mNext. The first chunk of a batch in the shared pool also links to the
+	// next batch, in its payload which is at least 16 bytes.
+	struct BatchHeader
+	{
+		Chunk*	mNextBatch;
+		PxU32	mNbChunks;
+	};
+
+	PX_FORCE_INLINE BatchHeader& getBatchHeader(Chunk* chunk)
+	{
+		return *reinterpret_cast<BatchHeader*>(chunk + 1);
+	}
+
+	PX_FORCE_INLINE size_t getChunkSize(PxU32 classIndex)
+	{
+		return size_t(2) << (classIndex + ThreadCachingAllocator::sMinIndex);
+	}
+
+	// Number of free chunks a thread keeps per size class, about 128kB worth of them. Half of them are moved to the
+	// shared pool when the bin is full.
+	PX_FORCE_INLINE PxU32 getBinCapacity(PxU32 classIndex)
+	{
+		return PxClamp(PxU32((128 * 1024) / getChunkSize(classIndex)), 2u, 64u);
+	}
+
+	// Beyond this, batches returned to the shared pool go back to the underlying allocator
+	const PxU32 sMaxNbPoolBatches = 32;
+}
+
+// Only touched by the owner thread, except for the counters which are read without synchronization by getStats().
+struct ThreadCachingAllocator::ThreadCache
+{
+	ThreadCache() :
+		mNext					(NULL),
+		mNbAllocations			(0),
+		mNbDeallocations		(0),
+		mNbThreadCacheHits		(0),
+		mNbSharedPoolTransfers	(0),
+		mNbSharedPoolContentions(0),
+		mNbBaseAllocations		(0),
+		mNbBaseDeallocations	(0),
+		mCachedBytes			(0),
+		mNbBudgetGrains			(0)
+	{
+		for(PxU32 i = 0; i < sNbClasses; ++i)
+		{
+			mBins[i] = NULL;
+			mNbChunks[i] = 0;
+		}
+	}
+
+	Chunk*			mBins[sNbClasses];
+	PxU32			mNbChunks[sNbClasses];
+	ThreadCache*	mNext;
+
+	PxU64			mNbAllocations;
+	PxU64			mNbDeallocations;
+	PxU64			mNbThreadCacheHits;
+	PxU64			mNbSharedPoolTransfers;
+	PxU64			mNbSharedPoolContentions;
+	PxU64			mNbBaseAllocations;
+	PxU64			mNbBaseDeallocations;
+	PxU64			mCachedBytes;
+	PxU32			mNbBudgetGrains;	// share of the budget taken by this thread, covers mCachedBytes
+};
+
+struct ThreadCachingAllocator::SharedPool
+{
+	SharedPool(const ThreadCachingBaseAllocator& alloc) : mMutex(alloc), mBatches(NULL), mNbBatches(0), mCachedBytes(0)
+	{
+	}
+
+	Mutex	mMutex;
+	Chunk*	mBatches;
+	PxU32	mNbBatches;
+	PxU64	mCachedBytes;
+};
+
+ThreadCachingAllocator::ThreadCachingAllocator(PxAllocatorCallback& base, PxU32 maxThreadCachedBytes) :
+	mBase				(base),
+	mTlsIndex			(PxTlsAlloc()),
+	mPools				(NULL),
+	mThreadCaches		(NULL),
+	mNbFreeBudgetGrains	(PxI32(maxThreadCachedBytes / sBudgetGrain)),
+	mThreadCachesMutex	(ThreadCachingBaseAllocator(base))
+{
+	mPools = reinterpret_cast<SharedPool*>(mBase.allocate(sizeof(SharedPool) * sNbClasses, "ThreadCachingAllocator", __FILE__, __LINE__));
+	for(PxU32 i = 0; i < sNbClasses; ++i)
+		PX_PLACEMENT_NEW(mPools + i, SharedPool)(ThreadCachingBaseAllocator(base));
+
+	PxMemZero(&mStatsBaseline, sizeof(mStatsBaseline));
+}
+
+ThreadCachingAllocator::~ThreadCachingAllocator()
+{
+	trim();
+
+	for(ThreadCache* cache = mThreadCaches; cache;)
+	{
+		for(PxU32 i = 0; i < sNbClasses; ++i)
+			freeChunks(cache->mBins[i]);
+
+		ThreadCache* next = cache->mNext;
+		cache->~ThreadCache();
+		mBase.deallocate(cache);
+		cache = next;
+	}
+
+	for(PxU32 i = 0; i < sNbClasses; ++i)
+		mPools[i].~SharedPool();
+	mBase.deallocate(mPools);
+
+	PxTlsFree(mTlsIndex);
+}
+
+void* ThreadCachingAllocator::allocate(size_t size, const char* typeName, const char* filename, int line)
+{
+	if(!size)
+		return NULL;
+
+	ThreadCache* cache = getThreadCache();
+
+	Chunk* chunk = NULL;
+	PxU32 index;
+	if(cache && size + sizeof(Chunk) - 1 < (size_t(1) << sMaxIndex))
+	{
+		index = PxMax(PxHighestSetBit(PxU32(size + sizeof(Chunk) - 1)), sMinIndex);
+		const PxU32 classIndex = index - sMinIndex;
+
+		bool hit = true;
+		if(!cache->mBins[classIndex])
+			hit = !popBatch(classIndex, *cache);
+
+		chunk = cache->mBins[classIndex];
+		if(chunk)
+		{
+			// pop top off the bin
+			cache->mBins[classIndex] = chunk->mNext;
+			cache->mNbChunks[classIndex]--;
+			cache->mCachedBytes -= getChunkSize(classIndex);
+			if(hit)
+				cache->mNbThreadCacheHits++;
+			returnBudget(*cache, 1);
+		}
+		else
+		{
+			chunk = reinterpret_cast<Chunk*>(mBase.allocate(getChunkSize(classIndex), typeName, filename, line));
+			cache->mNbBaseAllocations++;
+		}
+	}
+	else
+	{
+		// too big for the bins, forward to base allocator
+		index = sMaxIndex;
+		chunk = reinterpret_cast<Chunk*>(mBase.allocate(size + sizeof(Chunk), typeName, filename, line));
+		if(cache)
+			cache->mNbBaseAllocations++;
+	}
+
+	if(cache)
+		cache->mNbAllocations++;
+
+	if(!chunk)
+		return NULL;
+
+	chunk->mIndex = index;
+	void* ret = chunk + 1;
+	PX_ASSERT((size_t(ret) & 0xf) == 0); // SDK types require at minimum 16 byte allignment.
+	return ret;
+}
+
+void ThreadCachingAllocator::deallocate(void* ptr)
+{
+	if(!ptr)
+		return;
+
+	Chunk* chunk = reinterpret_cast<Chunk*>(ptr) - 1;
+	const PxU32 index = chunk->mIndex;
+
+	ThreadCache* cache = index < sMaxIndex ? getThreadCache() : reinterpret_cast<ThreadCache*>(PxTlsGet(mTlsIndex));
+	if(cache)
+		cache->mNbDeallocations++;
+
+	if(index >= sMaxIndex || !cache)
+	{
+		mBase.deallocate(chunk);
+		if(cache)
+			cache->mNbBaseDeallocations++;
+		return;
+	}
+
+	const PxU32 classIndex = index - sMinIndex;
+	if(cache->mNbChunks[classIndex] == getBinCapacity(classIndex))
+		pushBatch(classIndex, *cache);
+
+	if(!reserveBudget(*cache, getChunkSize(classIndex)))
+	{
+		mBase.deallocate(chunk);
+		cache->mNbBaseDeallocations++;
+		return;
+	}
+
+	chunk->mNext = cache->mBins[classIndex];
+	cache->mBins[classIndex] = chunk;
+	cache->mNbChunks[classIndex]++;
+	cache->mCachedBytes += getChunkSize(classIndex);
+}
+
+void ThreadCachingAllocator::release()
+{
+	PxAllocatorCallback& base = mBase;
+	this->~ThreadCachingAllocator();
+	base.deallocate(this);
+}
+
+// The bins of all threads are emptied, including those of threads which exited, so no other thread may use the allocator
+// meanwhile.
+void ThreadCachingAllocator::trim()
+{
+	{
+		Mutex::ScopedLock lock(mThreadCachesMutex);
+		for(ThreadCache* cache = mThreadCaches; cache; cache = cache->mNext)
+		{
+			for(PxU32 i = 0; i < sNbClasses; ++i)
+			{
+				freeChunks(cache->mBins[i]);
+				cache->mNbBaseDeallocations += cache->mNbChunks[i];
+				cache->mBins[i] = NULL;
+				cache->mNbChunks[i] = 0;
+			}
+			cache->mCachedBytes = 0;
+			returnBudget(*cache, 0);
+		}
+	}
+
+	for(PxU32 i = 0; i < sNbClasses; ++i)
+	{
+		SharedPool& pool = mPools[i];
+		Chunk* batches;
+		{
+			Mutex::ScopedLock lock(pool.mMutex);
+			batches = pool.mBatches;
+			pool.mBatches = NULL;
+			pool.mNbBatches = 0;
+			pool.mCachedBytes = 0;
+		}
+		while(batches)
+		{
+			Chunk* next = getBatchHeader(batches).mNextBatch;
+			freeChunks(batches);
+			batches = next;
+		}
+	}
+}
+
+void ThreadCachingAllocator::getStats(PxThreadCachingAllocatorStats& stats) const
+{
+	sumStats(stats);
+	stats.nbAllocations				-= mStatsBaseline.nbAllocations;
+	stats.nbDeallocations			-= mStatsBaseline.nbDeallocations;
+	stats.nbThreadCacheHits			-= mStatsBaseline.nbThreadCacheHits;
+	stats.nbSharedPoolTransfers		-= mStatsBaseline.nbSharedPoolTransfers;
+	stats.nbSharedPoolContentions	-= mStatsBaseline.nbSharedPoolContentions;
+	stats.nbBaseAllocations			-= mStatsBaseline.nbBaseAllocations;
+	stats.nbBaseDeallocations		-= mStatsBaseline.nbBaseDeallocations;
+}
+
+// The counters of other threads are not written here, they are rebased when read instead
+void ThreadCachingAllocator::resetStats()
+{
+	sumStats(mStatsBaseline);
+}
+
+void ThreadCachingAllocator::sumStats(PxThreadCachingAllocatorStats& stats) const
+{
+	PxMemZero(&stats, sizeof(stats));
+
+	Mutex::ScopedLock lock(mThreadCachesMutex);
+	for(const ThreadCache* cache = mThreadCaches; cache; cache = cache->mNext)
+	{
+		stats.nbAllocations				+= cache->mNbAllocations;
+		stats.nbDeallocations			+= cache->mNbDeallocations;
+		stats.nbThreadCacheHits			+= cache->mNbThreadCacheHits;
+		stats.nbSharedPoolTransfers		+= cache->mNbSharedPoolTransfers;
+		stats.nbSharedPoolContentions	+= cache->mNbSharedPoolContentions;
+		stats.nbBaseAllocations			+= cache->mNbBaseAllocations;
+		stats.nbBaseDeallocations		+= cache->mNbBaseDeallocations;
+		stats.nbCachedBytes				+= cache->mCachedBytes;
+		stats.nbThreads++;
+	}
+
+	for(PxU32 i = 0; i < sNbClasses; ++i)
+		stats.nbCachedBytes += mPools[i].mCachedBytes;
+}
+
+ThreadCachingAllocator::ThreadCache* ThreadCachingAllocator::getThreadCache()
+{
+	ThreadCache* cache = reinterpret_cast<ThreadCache*>(PxTlsGet(mTlsIndex));
+	return cache ? cache : createThreadCache();
+}
+
+ThreadCachingAllocator::ThreadCache* ThreadCachingAllocator::createThreadCache()
+{
+	void* memory = mBase.allocate(sizeof(ThreadCache), "ThreadCachingAllocator", __FILE__, __LINE__);
+	if(!memory)
+		return NULL;
+
+	ThreadCache* cache = PX_PLACEMENT_NEW(memory, ThreadCache)();
+	{
+		Mutex::ScopedLock lock(mThreadCachesMutex);
+		cache->mNext = mThreadCaches;
+		mThreadCaches = cache;
+	}
+	PxTlsSet(mTlsIndex, cache);
+	return cache;
+}
+
+void ThreadCachingAllocator::lockPool(SharedPool& pool, ThreadCache& cache)
+{
+	if(!pool.mMutex.trylock())
+	{
+		cache.mNbSharedPoolContentions++;
+		pool.mMutex.lock();
+	}
+}
+
+void ThreadCachingAllocator::pushBatch(PxU32 classIndex, ThreadCache& cache)
+{
+	// detach the top half of the bin
+	const PxU32 nbChunks = getBinCapacity(classIndex) / 2;
+	Chunk* first = cache.mBins[classIndex];
+	Chunk* last = first;
+	for(PxU32 i = 1; i < nbChunks; ++i)
+		last = last->mNext;
+	cache.mBins[classIndex] = last->mNext;
+	last->mNext = NULL;
+	cache.mNbChunks[classIndex] -= nbChunks;
+
+	const PxU64 nbBytes = PxU64(nbChunks) * getChunkSize(classIndex);
+	cache.mCachedBytes -= nbBytes;
+	cache.mNbSharedPoolTransfers++;
+	returnBudget(cache, 1);
+
+	BatchHeader& header = getBatchHeader(first);
+	header.mNbChunks = nbChunks;
+
+	SharedPool& pool = mPools[classIndex];
+	lockPool(pool, cache);
+	const bool keep = pool.mNbBatches < sMaxNbPoolBatches;
+	if(keep)
+	{
+		header.mNextBatch = pool.mBatches;
+		pool.mBatches = first;
+		pool.mNbBatches++;
+		pool.mCachedBytes += nbBytes;
+	}
+	pool.mMutex.unlock();
+
+	if(!keep)
+	{
+		freeChunks(first);
+		cache.mNbBaseDeallocations += nbChunks;
+	}
+}
+
+bool ThreadCachingAllocator::popBatch(PxU32 classIndex, ThreadCache& cache)
+{
+	PX_ASSERT(!cache.mBins[classIndex]);
+
+	SharedPool& pool = mPools[classIndex];
+	if(!pool.mBatches)	// unsynchronized peek, saves the lock when the pool is empty
+		return false;
+
+	// a batch never exceeds one grain
+	if(!reserveBudget(cache, sBudgetGrain))
+		return false;
+
+	lockPool(pool, cache);
+	Chunk* first = pool.mBatches;
+	PxU32 nbChunks = 0;
+	if(first)
+	{
+		nbChunks = getBatchHeader(first).mNbChunks;
+		pool.mBatches = getBatchHeader(first).mNextBatch;
+		pool.mNbBatches--;
+		pool.mCachedBytes -= PxU64(nbChunks) * getChunkSize(classIndex);
+	}
+	pool.mMutex.unlock();
+
+	if(!first)
+		return false;
+
+	cache.mBins[classIndex] = first;
+	cache.mNbChunks[classIndex] = nbChunks;
+	cache.mCachedBytes += PxU64(nbChunks) * getChunkSize(classIndex);
+	cache.mNbSharedPoolTransfers++;
+	return true;
+}
+
+void ThreadCachingAllocator::freeChunks(Chunk* chunks)
+{
+	while(chunks)
+	{
+		Chunk* next = chunks->mNext;
+		mBase.deallocate(chunks);
+		chunks = next;
+	}
+}
+
+// Makes sure the bins of the cache can take nbBytes more, taking one more grain from the shared budget if needed.
+// Fails when the budget is exhausted, then the caller returns the memory to the underlying allocator instead.
+bool ThreadCachingAllocator::reserveBudget(ThreadCache& cache, PxU64 nbBytes)
+{
+	PX_ASSERT(nbBytes <= sBudgetGrain);
+	if(cache.mCachedBytes + nbBytes <= PxU64(cache.mNbBudgetGrains) * sBudgetGrain)
+		return true;
+
+	if(PxAtomicDecrement(&mNbFreeBudgetGrains) < 0)
+	{
+		PxAtomicIncrement(&mNbFreeBudgetGrains);
+		return false;
+	}
+	cache.mNbBudgetGrains++;
+	return true;
+}
+
+// Gives the unused part of the cache's share back to the shared budget, except for nbKeptGrains grains so that a thread
+// allocating and freeing around a grain boundary does not touch the atomic each time.
+void ThreadCachingAllocator::returnBudget(ThreadCache& cache, PxU32 nbKeptGrains)
+{
+	const PxU32 nbUsedGrains = PxU32((cache.mCachedBytes + sBudgetGrain - 1) / sBudgetGrain);
+	if(cache.mNbBudgetGrains <= nbUsedGrains + nbKeptGrains)
+		return;
+
+	const PxU32 nbGrains = cache.mNbBudgetGrains - nbUsedGrains - nbKeptGrains;
+	cache.mNbBudgetGrains -= nbGrains;
+	PxAtomicAdd(&mNbFreeBudgetGrains, PxI32(nbGrains));
+}
+
+physx::PxThreadCachingAllocator* PxCreateThreadCachingAllocator(physx::PxAllocatorCallback& baseAllocator, physx::PxU32 maxThreadCachedBytes)
+{
+	void* memory = baseAllocator.allocate(sizeof(ThreadCachingAllocator), "ThreadCachingAllocator", __FILE__, __LINE__);
+	return memory ? PX_PLACEMENT_NEW(memory, ThreadCachingAllocator)(baseAllocator, maxThreadCachedBytes) : NULL;
+}
+
+void PxGetTempAllocatorStats(physx::PxThreadCachingAllocatorStats& stats)
+{
+	getFoundation().getTempAllocator().getStats(stats);
+}
@@ -0,0 +1,122 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+
+
+#ifndef FD_THREAD_CACHING_ALLOCATOR_H
+#define FD_THREAD_CACHING_ALLOCATOR_H
+
+#include "foundation/PxThreadCachingAllocator.h"
+#include "foundation/PxTempAllocator.h"
+#include "foundation/PxMutex.h"
+
+namespace physx
+{
+
+#if PX_VC
+#pragma warning(push)
+#pragma warning(disable : 4251) // class needs to have dll-interface to be used by clients of class
+#endif
+
+// Allocates the internal data of a ThreadCachingAllocator from its underlying allocator, since the allocator can be
+// created before the foundation.
+class ThreadCachingBaseAllocator
+{
+  public:
+	ThreadCachingBaseAllocator(PxAllocatorCallback& base) : mBase(&base)
+	{
+	}
+	void* allocate(size_t size, const char* file, int line)
+	{
+		return mBase->allocate(size, "ThreadCachingAllocator", file, line);
+	}
+	void deallocate(void* ptr)
+	{
+		if(ptr)
+			mBase->deallocate(ptr);
+	}
+
+  private:
+	PxAllocatorCallback* mBase;
+};
+
+class PX_FOUNDATION_API ThreadCachingAllocator : public PxThreadCachingAllocator
+{
+	PX_NOCOPY(ThreadCachingAllocator)
+
+  public:
+	typedef PxTempAllocatorChunk Chunk;
+	typedef PxMutexT<ThreadCachingBaseAllocator> Mutex;
+
+	static const PxU32 sMinIndex = 4;	// 32B min chunk
+	static const PxU32 sMaxIndex = 17;	// 128kB max chunk
+	static const PxU32 sNbClasses = sMaxIndex - sMinIndex;
+	static const PxU32 sBudgetGrain = 1 << sMaxIndex;	// unit of the thread bins budget, holds any chunk or batch
+
+	ThreadCachingAllocator(PxAllocatorCallback& base, PxU32 maxThreadCachedBytes = PX_THREAD_CACHING_ALLOCATOR_DEFAULT_MAX_THREAD_CACHED_BYTES);
+	virtual ~ThreadCachingAllocator();
+
+	// PxAllocatorCallback
+	virtual void* allocate(size_t size, const char* typeName, const char* filename, int line);
+	virtual void deallocate(void* ptr);
+	//~PxAllocatorCallback
+
+	// PxThreadCachingAllocator
+	virtual void release();
+	virtual void trim();
+	virtual void getStats(PxThreadCachingAllocatorStats& stats) const;
+	virtual void resetStats();
+	//~PxThreadCachingAllocator
+
+  private:
+	struct ThreadCache;
+	struct SharedPool;
+
+	ThreadCache* getThreadCache();
+	ThreadCache* createThreadCache();
+	void lockPool(SharedPool& pool, ThreadCache& cache);
+	void pushBatch(PxU32 classIndex, ThreadCache& cache);
+	bool popBatch(PxU32 classIndex, ThreadCache& cache);
+	void freeChunks(Chunk* chunks);
+	bool reserveBudget(ThreadCache& cache, PxU64 nbBytes);
+	void returnBudget(ThreadCache& cache, PxU32 nbKeptGrains);
+	void sumStats(PxThreadCachingAllocatorStats& stats) const;
+
+	PxAllocatorCallback& mBase;
+	const PxU32 mTlsIndex;
+	SharedPool* mPools;
+	ThreadCache* mThreadCaches;	// one entry per thread which ever allocated, their bins are bounded by the budget
+	volatile PxI32 mNbFreeBudgetGrains;	// budget left for the bins of all threads, in sBudgetGrain units
+	mutable Mutex mThreadCachesMutex;
+	PxThreadCachingAllocatorStats mStatsBaseline;
+};
+
+#if PX_VC
+#pragma warning(pop)
+#endif
+
+} // namespace physx
+
+#endif
@@ -0,0 +1,385 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+
+#include "foundation/PxTraceProfiler.h"
+#include "foundation/PxFoundation.h"
+#include "foundation/PxUserAllocated.h"
+#include "foundation/PxAllocator.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxMutex.h"
+#include "foundation/PxThread.h"
+#include "foundation/PxTime.h"
+#include "foundation/PxString.h"
+#include "foundation/PxMath.h"
+#include "foundation/PxBitUtils.h"
+#include "foundation/PxIntrinsics.h"
+#include "foundation/PxIO.h"
+
+#include <string.h>
+
+#if PX_INTEL_FAMILY
+	#if PX_VC
+		#include <intrin.h>
+	#else
+		#include <x86intrin.h>
+	#endif
+#endif
+
+using namespace physx;
+
+namespace
+{
+	// The time stamp counter is read directly on x86, the OS counters cost several times more than the rest of the
+	// recording. Ticks are converted to time when the trace is written, see TraceProfiler::calibrate().
+	PX_FORCE_INLINE PxU64 readTimeStamp()
+	{
+#if PX_INTEL_FAMILY
+		return __rdtsc();
+#else
+		return PxTime::getCurrentCounterValue();
+#endif
+	}
+
+	// Makes the event visible to the reader before the counter that publishes it.
+	PX_FORCE_INLINE void writeBarrier()
+	{
+#if PX_INTEL_FAMILY
+		// Stores are not reordered with other stores on x86, we just need to stop the compiler from doing it.
+	#if PX_VC
+		_ReadWriteBarrier();
+	#else
+		__asm__ __volatile__("" ::: "memory");
+	#endif
+#else
+		PxMemoryBarrier();
+#endif
+	}
+
+	PX_FORCE_INLINE void readBarrier()
+	{
+		writeBarrier();
+	}
+
+	enum EventType
+	{
+		eZONE_START,
+		eZONE_END,
+		eDETACHED_START,
+		eDETACHED_END
+	};
+
+	struct TraceEvent
+	{
+		const char*	mName;
+		PxU64		mTimeStamp;
+		PxU64		mContextId;
+		PxU32		mType;
+		PxU32		mPad;
+	};
+
+	// One per recording thread. Only the owner thread writes the events and the counter, the counter only ever grows
+	// (modulo wrapping) so the reader can tell which events are still valid.
+	struct ThreadBuffer : public PxUserAllocated
+	{
+		ThreadBuffer(PxU32 nbEvents, PxU32 index) :
+			mEvents		(PX_ALLOCATE(TraceEvent, nbEvents, "TraceEvent")),
+			mMask		(nbEvents - 1),
+			mNbWritten	(0),
+			mReadStart	(0),
+			mThreadId	(PxU64(PxThread::getId())),
+			mIndex		(index)
+		{
+		}
+
+		~ThreadBuffer()
+		{
+			PX_FREE(mEvents);
+		}
+
+		PX_FORCE_INLINE	void	record(const char* name, PxU64 contextId, EventType type)
+		{
+			const size_t nbWritten = mNbWritten;
+			TraceEvent& event = mEvents[nbWritten & mMask];
+			event.mName			= name;
+			event.mTimeStamp	= readTimeStamp();
+			event.mContextId	= contextId;
+			event.mType			= type;
+			writeBarrier();
+			mNbWritten = nbWritten + 1;
+		}
+
+		TraceEvent*		mEvents;
+		PxU32			mMask;
+		volatile size_t	mNbWritten;
+		size_t			mReadStart;	// Events before this one have been discarded by reset(). Only touched by the reader.
+		PxU64			mThreadId;
+		PxU32			mIndex;
+	};
+
+	class TraceProfiler : public PxTraceProfiler, public PxUserAllocated
+	{
+		PX_NOCOPY(TraceProfiler)
+	public:
+		TraceProfiler(PxU32 nbEventsPerThread) :
+			mNbEventsPerThread	(nbEventsPerThread),
+			mTlsIndex			(PxTlsAlloc()),
+			mStartTimeStamp		(readTimeStamp()),
+			mStartCounter		(PxTime::getCurrentCounterValue())
+		{
+		}
+
+		virtual ~TraceProfiler()
+		{
+			for(PxU32 i=0;i<mThreadBuffers.size();i++)
+				PX_DELETE(mThreadBuffers[i]);
+			PxTlsFree(mTlsIndex);
+		}
+
+		// PxProfilerCallback
+		virtual void* zoneStart(const char* eventName, bool detached, uint64_t contextId)
+		{
+			getThreadBuffer().record(eventName, contextId, detached ? eDETACHED_START : eZONE_START);
+			return NULL;
+		}
+
+		virtual void zoneEnd(void* /*profilerData*/, const char* eventName, bool detached, uint64_t contextId)
+		{
+			getThreadBuffer().record(eventName, contextId, detached ? eDETACHED_END : eZONE_END);
+		}
+		//~PxProfilerCallback
+
+		// PxTraceProfiler
+		virtual void release()
+		{
+			PX_DELETE_THIS;
+		}
+
+		virtual bool writeChromeTrace(PxOutputStream& stream);
+
+		virtual void reset()
+		{
+			PxMutex::ScopedLock lock(mMutex);
+			for(PxU32 i=0;i<mThreadBuffers.size();i++)
+			{
+				ThreadBuffer* buffer = mThreadBuffers[i];
+				readBarrier();
+				buffer->mReadStart = buffer->mNbWritten;
+			}
+		}
+
+		virtual PxU32 getNbThreads() const
+		{
+			PxMutex::ScopedLock lock(mMutex);
+			return mThreadBuffers.size();
+		}
+
+		virtual PxU32 getNbEventsPerThread() const
+		{
+			return mNbEventsPerThread;
+		}
+		//~PxTraceProfiler
+
+	private:
+		PX_FORCE_INLINE ThreadBuffer& getThreadBuffer()
+		{
+			ThreadBuffer* buffer = reinterpret_cast<ThreadBuffer*>(PxTlsGet(mTlsIndex));
+			if(!buffer)
+				buffer = createThreadBuffer();
+			return *buffer;
+		}
+
+		PX_NOINLINE ThreadBuffer* createThreadBuffer()
+		{
+			PxMutex::ScopedLock lock(mMutex);
+			ThreadBuffer* buffer = PX_NEW(ThreadBuffer)(mNbEventsPerThread, mThreadBuffers.size() + 1);
+			mThreadBuffers.pushBack(buffer);
+			PxTlsSet(mTlsIndex, buffer);
+			return buffer;
+		}
+
+		PxF64 calibrate() const;
+
+		const PxU32					mNbEventsPerThread;
+		const PxU32					mTlsIndex;
+		const PxU64					mStartTimeStamp;
+		const PxU64					mStartCounter;
+		mutable PxMutex				mMutex;
+		PxArray<ThreadBuffer*>		mThreadBuffers;
+	};
+
+	// Returns the number of time stamp ticks per microsecond
+	PxF64 TraceProfiler::calibrate() const
+	{
+		const PxCounterFrequencyToTensOfNanos& freq = PxTime::getBootCounterFrequency();
+#if PX_INTEL_FAMILY
+		// Measures the TSC frequency against the OS counter over the lifetime of the profiler, at least 10ms.
+		PxU64 timeStamp, counter;
+		PxF64 elapsedMicroseconds;
+		do
+		{
+			timeStamp = readTimeStamp();
+			counter = PxTime::getCurrentCounterValue();
+			elapsedMicroseconds = PxF64(freq.toTensOfNanos(counter - mStartCounter)) * 0.01;
+		} while(elapsedMicroseconds < 10000.0);
+		return PxF64(timeStamp - mStartTimeStamp) / elapsedMicroseconds;
+#else
+		return 100.0 * PxF64(freq.mDenominator) / PxF64(freq.mNumerator);
+#endif
+	}
+
+	class TraceWriter
+	{
+		PX_NOCOPY(TraceWriter)
+	public:
+		TraceWriter(PxOutputStream& stream) : mStream(stream), mNbEvents(0), mSuccess(true)
+		{
+		}
+
+		void	write(const char* text)
+		{
+			const PxU32 length = PxU32(strlen(text));
+			mSuccess &= mStream.write(text, length) == length;
+		}
+
+		void	writeEvent(const char* event)
+		{
+			write(mNbEvents++ ? ",\n" : "\n");
+			write(event);
+		}
+
+		bool	succeeded()	const	{ return mSuccess;	}
+
+	private:
+		PxOutputStream&	mStream;
+		PxU32			mNbEvents;
+		bool			mSuccess;
+	};
+
+	// Zone names are string literals from the SDK, but user zones could contain anything.
+	void escapeName(const char* name, char* dst, PxU32 dstSize)
+	{
+		PxU32 i = 0;
+		for(const char* c = name ? name : "(null)"; *c && i + 2 < dstSize; c++)
+		{
+			if(*c == '"' || *c == '\\')
+				dst[i++] = '\\';
+			dst[i++] = PxU8(*c) < 0x20 ? ' ' : *c;
+		}
+		dst[i] = 0;
+	}
+}
+
+bool TraceProfiler::writeChromeTrace(PxOutputStream& stream)
+{
+	const PxF64 ticksPerMicrosecond = calibrate();
+	const PxF64 microsecondsPerTick = 1.0 / ticksPerMicrosecond;
+
+	PxMutex::ScopedLock lock(mMutex);
+
+	TraceWriter writer(stream);
+	writer.write("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+
+	char line[512];
+	char name[256];
+	Pxsnprintf(line, sizeof(line), "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"PhysX\"}}");
+	writer.writeEvent(line);
+
+	PxArray<TraceEvent> events;
+	for(PxU32 i=0;i<mThreadBuffers.size();i++)
+	{
+		ThreadBuffer* buffer = mThreadBuffers[i];
+
+		Pxsnprintf(line, sizeof(line), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"Thread %u (0x%llx)\"}}",
+			buffer->mIndex, buffer->mIndex, static_cast<unsigned long long>(buffer->mThreadId));
+		writer.writeEvent(line);
+
+		// Copy the events out first, then drop those that the owner thread overwrote in the meantime. The owner thread
+		// can be writing event 'end' right now, before publishing it, in the slot of event 'end - capacity'. So at most
+		// capacity - 1 events can be read.
+		const size_t capacity = size_t(buffer->mMask) + 1;
+		const size_t end = buffer->mNbWritten;
+		readBarrier();
+		size_t start = buffer->mReadStart;
+		if(end - start >= capacity)
+			start = end + 1 - capacity;
+
+		events.clear();
+		events.reserve(PxU32(end - start));
+		for(size_t j=start;j!=end;j++)
+			events.pushBack(buffer->mEvents[j & buffer->mMask]);
+
+		readBarrier();
+		// Same here: event 'newEnd' can be in flight, so events before 'newEnd + 1 - capacity' are not reliable.
+		const size_t newEnd = buffer->mNbWritten;
+		const PxU32 nbOverwritten = newEnd + 1 - start > capacity ? PxU32(newEnd + 1 - capacity - start) : 0;
+
+		PxU32 depth = 0;
+		for(PxU32 j=PxMin(nbOverwritten, events.size());j<events.size();j++)
+		{
+			const TraceEvent& event = events[j];
+			// Skip the ends of the zones whose starts are gone
+			if(event.mType == eZONE_END)
+			{
+				if(!depth)
+					continue;
+				depth--;
+			}
+			else if(event.mType == eZONE_START)
+				depth++;
+
+			escapeName(event.mName, name, sizeof(name));
+			const PxF64 time = PxF64(PxI64(event.mTimeStamp - mStartTimeStamp)) * microsecondsPerTick;
+			switch(event.mType)
+			{
+				case eZONE_START:
+				case eZONE_END:
+					Pxsnprintf(line, sizeof(line), "{\"name\":\"%s\",\"cat\":\"PhysX\",\"ph\":\"%s\",\"ts\":%.3f,\"pid\":0,\"tid\":%u,\"args\":{\"contextId\":\"0x%llx\"}}",
+						name, event.mType == eZONE_START ? "B" : "E", time, buffer->mIndex, static_cast<unsigned long long>(event.mContextId));
+					break;
+				case eDETACHED_START:
+				case eDETACHED_END:
+					// Cross-thread zones are matched by name and context id
+					Pxsnprintf(line, sizeof(line), "{\"name\":\"%s\",\"cat\":\"PhysX\",\"ph\":\"%s\",\"id\":\"0x%llx\",\"ts\":%.3f,\"pid\":0,\"tid\":%u}",
+						name, event.mType == eDETACHED_START ? "b" : "e", static_cast<unsigned long long>(event.mContextId), time, buffer->mIndex);
+					break;
+			}
+			writer.writeEvent(line);
+		}
+	}
+
+	writer.write("\n]}\n");
+	return writer.succeeded();
+}
+
+physx::PxTraceProfiler* PxCreateTraceProfiler(physx::PxU32 nbEventsPerThread)
+{
+	if(!nbEventsPerThread || nbEventsPerThread > (1u<<28))
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, __FILE__, __LINE__, "PxCreateTraceProfiler: nbEventsPerThread must be between 1 and 2^28.");
+		return NULL;
+	}
+	return PX_NEW(TraceProfiler)(PxNextPowerOfTwo(PxMax(nbEventsPerThread, 64u) - 1));
+}
@@ -109,6 +109,8 @@ namespace physx
 			return createConvexMesh(params, desc, *getInsertionCallback());
 		}
 
+		PX_C_EXPORT PX_PHYSX_COMMON_API	bool cookConvexMeshes(const PxCookingParams& params, PxU32 nbMeshes, const PxConvexMeshDesc* descs, PxOutputStream* const* streams, PxConvexMeshCookingResult::Enum* conditions=NULL);
+
 		PX_C_EXPORT PX_PHYSX_COMMON_API	bool validateConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc);
 		PX_C_EXPORT PX_PHYSX_COMMON_API	bool computeHullPolygons(const PxCookingParams& params, const PxSimpleTriangleMesh& mesh, PxAllocatorCallback& inCallback, PxU32& nbVerts, PxVec3*& vertices,
 																PxU32& nbIndices, PxU32*& indices, PxU32& nbPolygons, PxHullPolygon*& hullPolygons);
@@ -117,6 +119,8 @@ namespace physx
 		PX_C_EXPORT PX_PHYSX_COMMON_API	bool validateTriangleMesh(const PxCookingParams& params, const PxTriangleMeshDesc& desc);
 		PX_C_EXPORT PX_PHYSX_COMMON_API	PxTriangleMesh* createTriangleMesh(const PxCookingParams& params, const PxTriangleMeshDesc& desc, PxInsertionCallback& insertionCallback, PxTriangleMeshCookingResult::Enum* condition=NULL);
 		PX_C_EXPORT PX_PHYSX_COMMON_API	bool cookTriangleMesh(const PxCookingParams& params, const PxTriangleMeshDesc& desc, PxOutputStream& stream, PxTriangleMeshCookingResult::Enum* condition=NULL);
+		PX_C_EXPORT PX_PHYSX_COMMON_API	bool cookTriangleMeshes(const PxCookingParams& params, PxU32 nbMeshes, const PxTriangleMeshDesc* descs, PxOutputStream* const* streams, PxTriangleMeshCookingResult::Enum* conditions=NULL);
+		PX_C_EXPORT PX_PHYSX_COMMON_API	bool cookTriangleMeshInPlace(const PxCookingParams& params, const PxTriangleMeshDesc& desc, PxOutputStream& stream, PxTriangleMeshCookingResult::Enum* condition=NULL);
 		
 		PX_FORCE_INLINE	PxTriangleMesh*	createTriangleMesh(const PxCookingParams& params, const PxTriangleMeshDesc& desc)
 		{
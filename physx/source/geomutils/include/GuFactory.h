@@ -30,18 +30,29 @@
 #define GU_FACTORY_H
 
 #include "foundation/PxSimpleTypes.h"
+#include "foundation/PxTransform.h"
 #include "common/PxPhysXCommonConfig.h"
 #include "GuPrunerTypedef.h"
 
 namespace physx
 {
+	class PxOutputStream;
+	class PxBounds3;
+
 namespace Gu
 {
 	class Pruner;
+	class PagedPruner;
+	struct PrunerPayload;
 
 	PX_C_EXPORT	PX_PHYSX_COMMON_API	Gu::Pruner*	createBucketPruner(PxU64 contextID);
-	PX_C_EXPORT	PX_PHYSX_COMMON_API	Gu::Pruner*	createAABBPruner(PxU64 contextID, bool dynamic, Gu::CompanionPrunerType type, Gu::BVHBuildStrategy buildStrategy, PxU32 nbObjectsPerNode);
+	PX_C_EXPORT	PX_PHYSX_COMMON_API	Gu::Pruner*	createAABBPruner(PxU64 contextID, bool dynamic, Gu::CompanionPrunerType type, Gu::BVHBuildStrategy buildStrategy, PxU32 nbObjectsPerNode, Gu::BVHNodeWidth nodeWidth);
 	PX_C_EXPORT	PX_PHYSX_COMMON_API	Gu::Pruner*	createIncrementalPruner(PxU64 contextID);
+	PX_C_EXPORT	PX_PHYSX_COMMON_API	Gu::PagedPruner*	createPagedPruner(PxU64 contextID);
+
+	// PT: builds the BVH for the objects of a world cell, and writes it to a stream for later use with PagedPruner::loadCell().
+	// Payloads are stored verbatim, so they should contain IDs rather than pointers.
+	PX_PHYSX_COMMON_API	bool	savePagedPrunerCell(PxOutputStream& stream, PxU32 nbObjects, const PxBounds3* bounds, const PrunerPayload* payloads, const PxTransform* transforms, Gu::BVHBuildStrategy buildStrategy, PxU32 nbObjectsPerNode);
 }
 }
 
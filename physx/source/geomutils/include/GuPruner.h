@@ -38,6 +38,8 @@ namespace physx
 {
 	class PxRenderOutput;
 	class PxBounds3;
+	class PxInputStream;
+	class PxPlane;
 
 namespace Gu
 {
@@ -156,6 +158,20 @@ namespace Gu
 		virtual	bool					overlap(const Gu::ShapeData& queryVolume, PrunerOverlapCallback&) const = 0;
 		virtual	bool					sweep(const Gu::ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback&) const = 0;
 
+		/**
+		\brief	Frustum / convex-volume culling query.
+
+		Reports all objects whose bounds are not fully outside one of the planes. Points P for which planes[i].distance(P)>0 are
+		outside the volume. This is a conservative test, i.e. some reported bounds may be outside the volume, close to its edges.
+
+		\param[in]	nbPlanes		Number of planes. Only 32 planes max are supported.
+		\param[in]	planes			Array of planes, in the same space as the pruner's objects
+		\param[in]	prunerCallback	Callback, called once per visible object
+
+		\return	false if the query has been aborted
+		*/
+		virtual	bool					cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& prunerCallback) const = 0;
+
 		/**
 		\brief	Retrieves the object's payload and data associated with the handle.
 
@@ -221,6 +237,59 @@ namespace Gu
 		 */
 		virtual bool					prepareBuild() = 0;	
 	};
+
+	typedef PxU32 PagedCellHandle;
+	static const PagedCellHandle INVALID_PAGED_CELL = 0xffffffff;
+
+	/**
+	*	Static pruner for very large worlds. The world is split into user-defined cells, each of them owning a pre-built BVH
+	*	(see savePagedPrunerCell()) that can be loaded and unloaded on demand. A top-level tree over the cell bounds
+	*	is used to find the cells touched by a query, and cells that are not currently loaded are skipped.
+	*
+	*	Objects are only added through cells: addObjects() / removeObjects() / updateObjects() are not supported.
+	*	The primIndex passed to the query callbacks is the index of the object within its cell.
+	*/
+	class PagedPruner : public Pruner
+	{
+		public:
+
+		/**
+		\brief	Registers a new (unloaded) cell. This is a constant-time operation, the top-level tree is rebuilt in the next commit().
+
+		\param[in]	bounds	World-space bounds of the cell. They must enclose the bounds of all objects in the cell.
+		\return	The cell handle, or INVALID_PAGED_CELL if allocation failed.
+		*/
+		virtual PagedCellHandle			addCell(const PxBounds3& bounds) = 0;
+
+		/**
+		\brief	Unloads and unregisters a cell. This is a constant-time operation, the top-level tree is rebuilt in the next commit().
+		*/
+		virtual bool					removeCell(PagedCellHandle cell) = 0;
+
+		/**
+		\brief	Loads cell data written by savePagedPrunerCell(). The data is copied to internal memory.
+
+		Loading and unloading cells does not touch the top-level tree, and does not require a commit().
+		*/
+		virtual bool					loadCell(PagedCellHandle cell, PxInputStream& stream) = 0;
+
+		/**
+		\brief	Loads cell data written by savePagedPrunerCell() without copying it (e.g. from a memory-mapped file).
+
+		The memory must be 8-bytes aligned and must remain valid and unchanged until the cell is unloaded. Only
+		data with the platform's endianness can be used this way.
+		*/
+		virtual bool					loadCell(PagedCellHandle cell, const void* data, PxU32 size) = 0;
+
+		/**
+		\brief	Unloads a cell. The cell remains registered and can be loaded again later.
+		*/
+		virtual void					unloadCell(PagedCellHandle cell) = 0;
+
+		virtual bool					isCellLoaded(PagedCellHandle cell)	const = 0;
+		virtual PxU32					getNbCells()						const = 0;
+		virtual PxU32					getNbLoadedCells()					const = 0;
+	};
 }
 }
 
@@ -58,6 +58,14 @@ namespace physx
 			BVH_SPLATTER_POINTS_SPLIT_GEOM_CENTER,
 			BVH_SAH
 		};
+
+		// Number of children per node in the tree used for queries. Wide trees are collapsed from the regular binary trees.
+		enum BVHNodeWidth
+		{
+			BVH_BINARY	= 2,
+			BVH_WIDE_4	= 4,
+			BVH_WIDE_8	= 8
+		};
 	}
 }
 
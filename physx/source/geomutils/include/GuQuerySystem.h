@@ -133,6 +133,7 @@ namespace Gu
 
 		PX_PHYSX_COMMON_API	void					raycast(const PxVec3& origin, const PxVec3& unitDir, float& inOutDistance, PrunerRaycastCallback& cb, const PrunerFilter* prunerFilter)			const;
 		PX_PHYSX_COMMON_API	void					overlap(const ShapeData& queryVolume, PrunerOverlapCallback& cb, const PrunerFilter* prunerFilter)												const;
+		PX_PHYSX_COMMON_API	void					cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& cb, const PrunerFilter* prunerFilter)										const;
 		PX_PHYSX_COMMON_API	void					sweep(const ShapeData& queryVolume, const PxVec3& unitDir, float& inOutDistance, PrunerRaycastCallback& cb, const PrunerFilter* prunerFilter)	const;
 
 							PxU32					startCustomBuildstep();
@@ -38,6 +38,11 @@
 #define SQ_DEBUG_VIZ_DYNAMIC_COLOR2	PxU32(PxDebugColor::eARGB_DARKRED)
 #define SQ_DEBUG_VIZ_COMPOUND_COLOR	PxU32(PxDebugColor::eARGB_MAGENTA)
 
+// PT: inflation of the bounds stored in the pruners, shared by the scene-level code and the pruners themselves
+//	#define SQ_PRUNER_EPSILON	0.01f
+	#define SQ_PRUNER_EPSILON	0.005f
+	#define SQ_PRUNER_INFLATION	(1.0f + SQ_PRUNER_EPSILON)	// pruner test shape inflation (not narrow phase shape)
+
 namespace physx
 {
 	class PxRenderOutput;
@@ -81,6 +86,7 @@ namespace physx
 	virtual	void					merge(const void* mergeParams);																																					\
 	virtual	bool					raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, Gu::PrunerRaycastCallback&)				const;														\
 	virtual	bool					overlap(const Gu::ShapeData& queryVolume, Gu::PrunerOverlapCallback&)												const;														\
+	virtual	bool					cull(PxU32 nbPlanes, const PxPlane* planes, Gu::PrunerOverlapCallback&)												const;														\
 	virtual	bool					sweep(const Gu::ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, Gu::PrunerRaycastCallback&)	const;														\
 	virtual	const PrunerPayload&	getPayloadData(PrunerHandle handle, PrunerPayloadData* data)														const	{ return mPool.getPayloadData(handle, data);	}	\
 	virtual	void					preallocate(PxU32 entries)																									{ mPool.preallocate(entries);					}	\
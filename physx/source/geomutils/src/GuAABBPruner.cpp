@@ -49,7 +49,7 @@ using namespace Cm;
 	#define SQ_PRUNER_EPSILON	0.005f
 	#define SQ_PRUNER_INFLATION	(1.0f + SQ_PRUNER_EPSILON)	// pruner test shape inflation (not narrow phase shape)
 
-AABBPruner::AABBPruner(bool incrementalRebuild, PxU64 contextID, CompanionPrunerType cpType, BVHBuildStrategy buildStrategy, PxU32 nbObjectsPerNode) :
+AABBPruner::AABBPruner(bool incrementalRebuild, PxU64 contextID, CompanionPrunerType cpType, BVHBuildStrategy buildStrategy, PxU32 nbObjectsPerNode, BVHNodeWidth nodeWidth) :
 	mAABBTree			(NULL),
 	mNewTree			(NULL),
 	mNbCachedBoxes		(0),
@@ -61,6 +61,7 @@ AABBPruner::AABBPruner(bool incrementalRebuild, PxU64 contextID, CompanionPruner
 	mAdaptiveRebuildTerm(0),
 	mNbObjectsPerNode	(nbObjectsPerNode),
 	mBuildStrategy		(buildStrategy),
+	mNodeWidth			(nodeWidth),
 	mPool				(contextID, TRANSFORM_CACHE_GLOBAL),
 	mIncrementalRebuild	(incrementalRebuild),
 	mUncommittedChanges	(false),
@@ -209,6 +210,33 @@ void AABBPruner::removeObjects(const PrunerHandle* handles, PxU32 count, PrunerP
 	}
 }
 
+// PT: dispatch queries to the wide tree when available, to the binary tree otherwise
+template<const bool tExactTest, typename Test>
+static PX_FORCE_INLINE bool overlapTree(const AABBTree& tree, const WideBVH& wideTree, const AABBTreeBounds& treeBounds, const PxBounds3& queryBounds, const Test& test, OverlapCallbackAdapter& pcb)
+{
+	if(wideTree.isValid())
+	{
+		if(wideTree.getWidth()==BVH_WIDE_8)
+			return WideBVHOverlap<8, true, tExactTest, Test, OverlapCallbackAdapter>()(treeBounds, tree.getNodes(), tree.getIndices(), wideTree, queryBounds, test, pcb);
+		else
+			return WideBVHOverlap<4, true, tExactTest, Test, OverlapCallbackAdapter>()(treeBounds, tree.getNodes(), tree.getIndices(), wideTree, queryBounds, test, pcb);
+	}
+	return AABBTreeOverlap<true, Test, AABBTree, BVHNode, OverlapCallbackAdapter>()(treeBounds, tree, test, pcb);
+}
+
+template<const bool tInflate>
+static PX_FORCE_INLINE bool raycastTree(const AABBTree& tree, const WideBVH& wideTree, const AABBTreeBounds& treeBounds, const PxVec3& origin, const PxVec3& unitDir, PxReal& maxDist, const PxVec3& inflation, RaycastCallbackAdapter& pcb)
+{
+	if(wideTree.isValid())
+	{
+		if(wideTree.getWidth()==BVH_WIDE_8)
+			return WideBVHRaycast<8, tInflate, true, RaycastCallbackAdapter>()(treeBounds, tree.getNodes(), tree.getIndices(), wideTree, origin, unitDir, maxDist, inflation, pcb);
+		else
+			return WideBVHRaycast<4, tInflate, true, RaycastCallbackAdapter>()(treeBounds, tree.getNodes(), tree.getIndices(), wideTree, origin, unitDir, maxDist, inflation, pcb);
+	}
+	return AABBTreeRaycast<tInflate, true, AABBTree, BVHNode, RaycastCallbackAdapter>()(treeBounds, tree, origin, unitDir, maxDist, inflation, pcb);
+}
+
 bool AABBPruner::overlap(const ShapeData& queryVolume, PrunerOverlapCallback& pcbArgName) const
 {
 	PX_ASSERT(!mUncommittedChanges);
@@ -226,12 +254,12 @@ bool AABBPruner::overlap(const ShapeData& queryVolume, PrunerOverlapCallback& pc
 				if(queryVolume.isOBB())
 				{	
 					const DefaultOBBAABBTest test(queryVolume);
-					again = AABBTreeOverlap<true, OBBAABBTest, AABBTree, BVHNode, OverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, test, pcb);
+					again = overlapTree<true, OBBAABBTest>(*mAABBTree, mWideTree, mPool.getCurrentAABBTreeBounds(), queryVolume.getPrunerInflatedWorldAABB(), test, pcb);
 				}
 				else
 				{
 					const DefaultAABBAABBTest test(queryVolume);
-					again = AABBTreeOverlap<true, AABBAABBTest, AABBTree, BVHNode, OverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, test, pcb);
+					again = overlapTree<false, AABBAABBTest>(*mAABBTree, mWideTree, mPool.getCurrentAABBTreeBounds(), queryVolume.getPrunerInflatedWorldAABB(), test, pcb);
 				}
 			}
 			break;
@@ -239,21 +267,21 @@ bool AABBPruner::overlap(const ShapeData& queryVolume, PrunerOverlapCallback& pc
 			case PxGeometryType::eCAPSULE:
 			{
 				const DefaultCapsuleAABBTest test(queryVolume, SQ_PRUNER_INFLATION);
-				again = AABBTreeOverlap<true, CapsuleAABBTest, AABBTree, BVHNode, OverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, test, pcb);
+				again = overlapTree<true, CapsuleAABBTest>(*mAABBTree, mWideTree, mPool.getCurrentAABBTreeBounds(), queryVolume.getPrunerInflatedWorldAABB(), test, pcb);
 			}
 			break;
 
 			case PxGeometryType::eSPHERE:
 			{
 				const DefaultSphereAABBTest test(queryVolume);
-				again = AABBTreeOverlap<true, SphereAABBTest, AABBTree, BVHNode, OverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, test, pcb);
+				again = overlapTree<true, SphereAABBTest>(*mAABBTree, mWideTree, mPool.getCurrentAABBTreeBounds(), queryVolume.getPrunerInflatedWorldAABB(), test, pcb);
 			}
 			break;
 
 			case PxGeometryType::eCONVEXMESH:
 			{
 				const DefaultOBBAABBTest test(queryVolume);
-				again = AABBTreeOverlap<true, OBBAABBTest, AABBTree, BVHNode, OverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, test, pcb);
+				again = overlapTree<true, OBBAABBTest>(*mAABBTree, mWideTree, mPool.getCurrentAABBTreeBounds(), queryVolume.getPrunerInflatedWorldAABB(), test, pcb);
 			}
 			break;
 		default:
@@ -267,6 +295,26 @@ bool AABBPruner::overlap(const ShapeData& queryVolume, PrunerOverlapCallback& pc
 	return again;
 }
 
+// PT: the wide tree isn't used here, since the culling traversal needs per-node clip masks
+bool AABBPruner::cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& pcbArgName) const
+{
+	PX_ASSERT(!mUncommittedChanges);
+
+	bool again = true;
+
+	if(mAABBTree)
+	{
+		OverlapCallbackAdapter pcb(pcbArgName, mPool);
+		const PlanesAABBTest test(nbPlanes, planes);
+		again = AABBTreeCull<true, AABBTree, BVHNode, OverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, test, pcb);
+	}
+
+	if(again && mIncrementalRebuild && mBucketPruner.getNbObjects())
+		again = mBucketPruner.cull(nbPlanes, planes, pcbArgName);
+
+	return again;
+}
+
 bool AABBPruner::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& pcbArgName) const
 {
 	PX_ASSERT(!mUncommittedChanges);
@@ -277,7 +325,7 @@ bool AABBPruner::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxRe
 	{
 		RaycastCallbackAdapter pcb(pcbArgName, mPool);
 		const PxBounds3& aabb = queryVolume.getPrunerInflatedWorldAABB();
-		again = AABBTreeRaycast<true, true, AABBTree, BVHNode, RaycastCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, aabb.getCenter(), unitDir, inOutDistance, aabb.getExtents(), pcb);
+		again = raycastTree<true>(*mAABBTree, mWideTree, mPool.getCurrentAABBTreeBounds(), aabb.getCenter(), unitDir, inOutDistance, aabb.getExtents(), pcb);
 	}
 
 	if(again && mIncrementalRebuild && mBucketPruner.getNbObjects())
@@ -295,7 +343,7 @@ bool AABBPruner::raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& in
 	if(mAABBTree)
 	{
 		RaycastCallbackAdapter pcb(pcbArgName, mPool);
-		again = AABBTreeRaycast<false, true, AABBTree, BVHNode, RaycastCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, origin, unitDir, inOutDistance, PxVec3(0.0f), pcb);
+		again = raycastTree<false>(*mAABBTree, mWideTree, mPool.getCurrentAABBTreeBounds(), origin, unitDir, inOutDistance, PxVec3(0.0f), pcb);
 	}
 		
 	if(again && mIncrementalRebuild && mBucketPruner.getNbObjects())
@@ -373,6 +421,7 @@ void AABBPruner::commit()
 			PX_PROFILE_ZONE("SceneQuery.prunerNewTreeSwitch", mPool.mContextID);
 
 			PX_DELETE(mAABBTree); // delete the old tree
+			mWideTree.release();
 			mCachedBoxes.release();
 			mProgress = BUILD_NOT_STARTED; // reset the build state to initial
 
@@ -445,6 +494,8 @@ void AABBPruner::commit()
 		}
 	}
 
+	updateWideTree();
+
 	updateBucketPruner();
 }
 
@@ -460,6 +511,9 @@ void AABBPruner::shiftOrigin(const PxVec3& shift)
 
 	if(mNewTree)
 		mNewTree->shiftOrigin(shift);
+
+	if(mAABBTree && mWideTree.isValid())
+		mWideTree.refit(mAABBTree->getNodes());
 }
 
 void AABBPruner::visualize(PxRenderOutput& out, PxU32 primaryColor, PxU32 secondaryColor) const
@@ -652,6 +706,7 @@ bool AABBPruner::fullRebuildAABBTree()
 
 	// Release possibly already existing tree
 	PX_DELETE(mAABBTree);
+	mWideTree.release();
 
 	// Don't bother building an AABB-tree if there isn't a single static object
 	const PxU32 nbObjects = mPool.getNbActiveObjects();
@@ -670,9 +725,25 @@ bool AABBPruner::fullRebuildAABBTree()
 	if(mIncrementalRebuild)
 		mTreeMap.initMap(PxMax(nbObjects, mNbCachedBoxes), *mAABBTree);
 
+	updateWideTree();
+
 	return Status;
 }
 
+// called at the end of commit(), and each time the topology of the current tree changes
+void AABBPruner::updateWideTree()
+{
+	if(mNodeWidth==BVH_BINARY || !mAABBTree)
+		return;
+
+	PX_PROFILE_ZONE("SceneQuery.prunerUpdateWideTree", mPool.mContextID);
+
+	if(mWideTree.isValid())
+		mWideTree.refit(mAABBTree->getNodes());
+	else
+		mWideTree.build(mAABBTree->getNodes(), mAABBTree->getNbNodes(), mNodeWidth);
+}
+
 // called in the end of commit(), but only if mIncrementalRebuild is true
 void AABBPruner::updateBucketPruner()
 {
@@ -696,6 +767,7 @@ void AABBPruner::release() // this can be called from purge()
 	mNodeAllocator.release();
 	PX_DELETE(mNewTree);
 	PX_DELETE(mAABBTree);
+	mWideTree.release();
 
 	mNbCachedBoxes = 0;
 	mProgress = BUILD_NOT_STARTED;
@@ -747,7 +819,11 @@ void AABBPruner::merge(const void* mergeParams)
 		if(!mIncrementalRebuild)
 		{
 			// merge tree directly
-			mAABBTree->mergeTree(aabbTreeMergeParams);		
+			mAABBTree->mergeTree(aabbTreeMergeParams);
+
+			// the topology changed, the wide tree must be collapsed again
+			mWideTree.release();
+			updateWideTree();
 		}
 		else
 		{
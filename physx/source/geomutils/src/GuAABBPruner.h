@@ -36,6 +36,7 @@
 #include "GuAABBTree.h"
 #include "GuAABBTreeUpdateMap.h"
 #include "GuAABBTreeBuildStats.h"
+#include "GuWideBVH.h"
 
 namespace physx
 {
@@ -126,7 +127,7 @@ namespace Gu
 	{
 												PX_NOCOPY(AABBPruner)
 		public:
-		PX_PHYSX_COMMON_API						AABBPruner(bool incrementalRebuild, PxU64 contextID, CompanionPrunerType cpType, BVHBuildStrategy buildStrategy=BVH_SPLATTER_POINTS, PxU32 nbObjectsPerNode=4); // true is equivalent to former dynamic pruner
+		PX_PHYSX_COMMON_API						AABBPruner(bool incrementalRebuild, PxU64 contextID, CompanionPrunerType cpType, BVHBuildStrategy buildStrategy=BVH_SPLATTER_POINTS, PxU32 nbObjectsPerNode=4, BVHNodeWidth nodeWidth=BVH_BINARY); // true is equivalent to former dynamic pruner
 		virtual									~AABBPruner();
 
 		// BasePruner
@@ -152,6 +153,7 @@ namespace Gu
 		PX_FORCE_INLINE	void					setAABBTree(AABBTree* tree)		{ mAABBTree = tree; }
 		PX_FORCE_INLINE	const AABBTree*			hasAABBTree()		const		{ return mAABBTree;	}
 		PX_FORCE_INLINE	BuildStatus				getBuildStatus()	const		{ return mProgress;	}
+		PX_FORCE_INLINE	const WideBVH&			getWideTree()		const		{ return mWideTree;	}
 				
 		// local functions
 //		private:
@@ -200,6 +202,11 @@ namespace Gu
 
 			const		PxU32					mNbObjectsPerNode;
 			const		BVHBuildStrategy		mBuildStrategy;
+			const		BVHNodeWidth			mNodeWidth;
+
+		// Optional wide version of mAABBTree used for queries, when mNodeWidth is not BVH_BINARY. It is released each time
+		// mAABBTree is replaced or its topology changes, and rebuilt or refit at the end of commit().
+						WideBVH					mWideTree;
 
 						PruningPool				mPool; // Pool of AABBs
 
@@ -255,6 +262,7 @@ namespace Gu
 						void					release();
 						void					refitUpdatedAndRemoved();
 						void					updateBucketPruner();
+						void					updateWideTree();
 	};
 
 }
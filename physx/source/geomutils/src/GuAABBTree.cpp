@@ -32,8 +32,10 @@
 #include "GuBounds.h"
 #include "GuAABBTreeNode.h"
 #include "GuSAH.h"
+#include "GuBuildTask.h"
 #include "foundation/PxMathUtils.h"
 #include "foundation/PxFPU.h"
+#include "foundation/PxSort.h"
 
 using namespace physx;
 using namespace Gu;
@@ -89,10 +91,10 @@ void NodeAllocator::release()
 	mTotalNbNodes = 0;
 }
 
-void NodeAllocator::init(PxU32 nbPrimitives, PxU32 limit)
+void NodeAllocator::init(PxU32 nbPrimitives, PxU32 limit, PxU32 maxNbInitialNodes)
 {
 	const PxU32 maxSize = nbPrimitives * 2 - 1;	// PT: max possible #nodes for a complete tree
-	const PxU32 estimatedFinalSize = maxSize <= 1024 ? maxSize : maxSize / limit;
+	const PxU32 estimatedFinalSize = PxMax<PxU32>(1, PxMin(maxNbInitialNodes, maxSize <= 1024 ? maxSize : maxSize / limit));
 	mPool = PX_NEW(AABBTreeBuildNode)[estimatedFinalSize];
 	PxMemZero(mPool, sizeof(AABBTreeBuildNode)*estimatedFinalSize);
 
@@ -129,6 +131,36 @@ AABBTreeBuildNode* NodeAllocator::getBiNode()
 	}
 }
 
+void NodeAllocator::reserve(PxU32 nbNodes)
+{
+	PX_ASSERT(!mSlabs.size());
+	AABBTreeBuildNode* pool = PX_NEW(AABBTreeBuildNode)[nbNodes];
+	PxMemZero(pool, sizeof(AABBTreeBuildNode)*nbNodes);
+
+	mSlabs.pushBack(Slab(pool, 0, nbNodes));
+	mCurrentSlabIndex = 0;
+}
+
+void NodeAllocator::merge(NodeAllocator& other)
+{
+	const PxU32 nbSlabs = other.mSlabs.size();
+	for(PxU32 i=0;i<nbSlabs;i++)
+	{
+		const Slab& s = other.mSlabs[i];
+		if(s.mNbUsedNodes)
+			mSlabs.pushBack(s);
+		else
+			PX_DELETE_ARRAY(other.mSlabs[i].mPool);
+	}
+	mCurrentSlabIndex = mSlabs.size() - 1;
+	mTotalNbNodes += other.mTotalNbNodes;
+
+	other.mSlabs.reset();
+	other.mCurrentSlabIndex = 0;
+	other.mTotalNbNodes = 0;
+	other.mPool = NULL;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 PxU32 Gu::reshuffle(PxU32 nb, PxU32* const PX_RESTRICT prims, const PxVec3* PX_RESTRICT centers, float splitValue, PxU32 axis)
@@ -365,7 +397,7 @@ void AABBTreeBuildNode::_buildHierarchySAH(const AABBTreeBuildParams& params, SA
 
 ///////////////////////////////////////////////////////////////////////////////
 
-static PxU32* initAABBTreeBuild(const AABBTreeBuildParams& params, NodeAllocator& nodeAllocator, BuildStats& stats)
+static PxU32* initAABBTreeBuild(const AABBTreeBuildParams& params, NodeAllocator& nodeAllocator, BuildStats& stats, PxU32 maxNbInitialNodes=0xffffffff)
 {
 	const PxU32 numPrimitives = params.mNbPrimitives;
 
@@ -382,7 +414,7 @@ static PxU32* initAABBTreeBuild(const AABBTreeBuildParams& params, NodeAllocator
 		indices[i] = i;
 
 	// Allocate a pool of nodes
-	nodeAllocator.init(numPrimitives, params.mLimit);
+	nodeAllocator.init(numPrimitives, params.mLimit, maxNbInitialNodes);
 
 	// Compute box centers only once and cache them
 	params.mCache = PX_ALLOCATE(PxVec3, (numPrimitives+1), "cache");
@@ -400,8 +432,150 @@ static PxU32* initAABBTreeBuild(const AABBTreeBuildParams& params, NodeAllocator
 	return indices;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+// Multi-threaded build
+
+// PT: the tree is built in two phases. The calling thread first subdivides the top of the tree, always splitting the
+// largest pending node, until there are enough independent subtrees to keep the workers busy. Each subtree then
+// covers a disjoint range of the indices array and is built by its own task, using its own node allocator, SAH
+// buffers and stats, so tasks never share any writable data. Nodes are subdivided with the same code as in the
+// single-threaded build, so the resulting hierarchy is the same, only the memory layout of the nodes differs.
+
+// PT: below this number of primitives we use the single-threaded code
+#define PARALLEL_BUILD_MIN_NB_PRIMS		4096
+// PT: nodes smaller than this are not subdivided further by the calling thread
+#define PARALLEL_BUILD_MIN_SUBTREE_SIZE	1024
+// PT: number of subtrees per worker thread. Using more subtrees than threads improves load balancing.
+#define PARALLEL_BUILD_SUBTREES_PER_WORKER	4
+
+namespace
+{
+	class SubtreeBuildTask : public BuildTask, public PxUserAllocated
+	{
+		public:
+		virtual	void	runInternal()
+		{
+			const PxU32 nbPrims = mRoot->mNbPrimitives;
+			const PxU32 maxSize = nbPrims * 2 - 1;
+			mAllocator.reserve(maxSize <= 1024 ? maxSize : maxSize / PxMax<PxU32>(1, mParams->mLimit));
+
+			if(mParams->mBuildStrategy==BVH_SAH)
+			{
+				SAH_Buffers buffers(nbPrims);
+				mRoot->_buildHierarchySAH(*mParams, buffers, mStats, mAllocator, mIndices);
+			}
+			else
+				mRoot->_buildHierarchy(*mParams, mStats, mAllocator, mIndices);
+		}
+
+		virtual	const char*	getName()	const	{ return "SubtreeBuildTask";	}
+
+		const AABBTreeBuildParams*	mParams;
+		AABBTreeBuildNode*			mRoot;
+		PxU32*						mIndices;
+		NodeAllocator				mAllocator;
+		BuildStats					mStats;
+	};
+
+	struct LargestSubtreeFirst
+	{
+		PX_FORCE_INLINE bool operator()(const AABBTreeBuildNode* a, const AABBTreeBuildNode* b) const
+		{
+			return a->mNbPrimitives > b->mNbPrimitives;
+		}
+	};
+}
+
+static PxU32* buildAABBTreeParallel(const AABBTreeBuildParams& params, NodeAllocator& nodeAllocator, BuildStats& stats, PxU32 nbWorkers)
+{
+	PxCpuDispatcher* dispatcher = params.mDispatcher;
+	const PxU32 maxNbSubtrees = nbWorkers * PARALLEL_BUILD_SUBTREES_PER_WORKER;
+
+	// PT: the main allocator only contains the top of the tree, the rest is allocated by the tasks
+	PxU32* indices = initAABBTreeBuild(params, nodeAllocator, stats, maxNbSubtrees*4 + 1);
+	if(!indices)
+		return NULL;
+
+	// Phase 1: subdivide the top of the tree on the calling thread. SAH splits of large nodes are themselves done in parallel.
+	PxArray<AABBTreeBuildNode*> subtrees;
+	subtrees.reserve(maxNbSubtrees + 2);
+	subtrees.pushBack(nodeAllocator.mPool);
+	{
+		SAH_Buffers* sah = params.mBuildStrategy==BVH_SAH ? PX_NEW(SAH_Buffers)(params.mNbPrimitives, dispatcher) : NULL;
+
+		while(subtrees.size() && subtrees.size()<maxNbSubtrees)
+		{
+			PxU32 largest = 0;
+			const PxU32 nbSubtrees = subtrees.size();
+			for(PxU32 i=1;i<nbSubtrees;i++)
+			{
+				if(subtrees[i]->mNbPrimitives > subtrees[largest]->mNbPrimitives)
+					largest = i;
+			}
+
+			AABBTreeBuildNode* node = subtrees[largest];
+			if(node->mNbPrimitives<PARALLEL_BUILD_MIN_SUBTREE_SIZE)
+				break;
+
+			subtrees.replaceWithLast(largest);
+
+			if(sah)
+				node->subdivideSAH(params, *sah, stats, nodeAllocator, indices);
+			else
+				node->subdivide(params, stats, nodeAllocator, indices);
+			stats.mTotalPrims += node->mNbPrimitives;
+
+			if(!node->isLeaf())
+			{
+				AABBTreeBuildNode* pos = const_cast<AABBTreeBuildNode*>(node->getPos());
+				subtrees.pushBack(pos);
+				subtrees.pushBack(pos + 1);
+			}
+		}
+		PX_DELETE(sah);
+	}
+
+	// Phase 2: build the remaining subtrees in parallel, largest ones first
+	const PxU32 nbSubtrees = subtrees.size();
+	if(nbSubtrees)
+	{
+		PxSort(subtrees.begin(), nbSubtrees, LargestSubtreeFirst());
+
+		SubtreeBuildTask* tasks = PX_NEW(SubtreeBuildTask)[nbSubtrees];
+		{
+			BuildTaskSync sync;
+			for(PxU32 i=0;i<nbSubtrees;i++)
+			{
+				tasks[i].mParams	= &params;
+				tasks[i].mRoot		= subtrees[i];
+				tasks[i].mIndices	= indices;
+				sync.submit(*dispatcher, tasks[i]);
+			}
+			sync.wait();
+		}
+
+		// Phase 3: gather all nodes & stats into the main allocator
+		for(PxU32 i=0;i<nbSubtrees;i++)
+		{
+			nodeAllocator.merge(tasks[i].mAllocator);
+			stats.increaseCount(tasks[i].mStats.getCount());
+			stats.mTotalPrims += tasks[i].mStats.mTotalPrims;
+		}
+		PX_DELETE_ARRAY(tasks);
+	}
+	return indices;
+}
+
 PxU32* Gu::buildAABBTree(const AABBTreeBuildParams& params, NodeAllocator& nodeAllocator, BuildStats& stats)
 {
+	if(params.mDispatcher && params.mNbPrimitives>=PARALLEL_BUILD_MIN_NB_PRIMS)
+	{
+		const PxU32 nbWorkers = params.mDispatcher->getWorkerCount();
+		if(nbWorkers>1)
+			return buildAABBTreeParallel(params, nodeAllocator, stats, nbWorkers);
+	}
+
 	// initialize the build first
 	PxU32* indices = initAABBTreeBuild(params, nodeAllocator, stats);
 	if(!indices)
@@ -419,11 +593,39 @@ PxU32* Gu::buildAABBTree(const AABBTreeBuildParams& params, NodeAllocator& nodeA
 	return indices;
 }
 
+namespace
+{
+	struct SlabRange
+	{
+		const AABBTreeBuildNode*	mStart;
+		const AABBTreeBuildNode*	mEnd;
+		PxU32						mNodeBase;
+
+		PX_FORCE_INLINE bool operator<(const SlabRange& other) const	{ return mStart < other.mStart;	}
+	};
+}
+
 void Gu::flattenTree(const NodeAllocator& nodeAllocator, BVHNode* dest, const PxU32* remap)
 {
 	// PT: gathers all build nodes allocated so far and flatten them to a linear destination array of smaller runtime nodes
 	PxU32 offset = 0;
 	const PxU32 nbSlabs = nodeAllocator.mSlabs.size();
+
+	// PT: sort slabs by address so that we can binary search the slab containing each child. Multi-threaded builds
+	// create one or more slabs per task so a linear search here would become noticeable.
+	PxArray<SlabRange> ranges(nbSlabs);
+	{
+		PxU32 nodeBase = 0;
+		for(PxU32 s=0;s<nbSlabs;s++)
+		{
+			const NodeAllocator::Slab& currentSlab = nodeAllocator.mSlabs[s];
+			ranges[s].mStart	= currentSlab.mPool;
+			ranges[s].mEnd		= currentSlab.mPool + currentSlab.mNbUsedNodes;
+			ranges[s].mNodeBase	= nodeBase;
+			nodeBase += currentSlab.mNbUsedNodes;
+		}
+		PxSort(ranges.begin(), nbSlabs);
+	}
 	for(PxU32 s=0;s<nbSlabs;s++)
 	{
 		const NodeAllocator::Slab& currentSlab = nodeAllocator.mSlabs[s];
@@ -445,19 +647,22 @@ void Gu::flattenTree(const NodeAllocator& nodeAllocator, BVHNode* dest, const Px
 			}
 			else
 			{
-				PX_ASSERT(pool[i].mPos);
-				PxU32 localNodeIndex = 0xffffffff;
-				PxU32 nodeBase = 0;
-				for(PxU32 j=0;j<nbSlabs;j++)
+				const AABBTreeBuildNode* pos = pool[i].mPos;
+				PX_ASSERT(pos);
+				PxU32 lo = 0;
+				PxU32 hi = nbSlabs;
+				while(hi-lo>1)
 				{
-					if(pool[i].mPos >= nodeAllocator.mSlabs[j].mPool && pool[i].mPos < nodeAllocator.mSlabs[j].mPool + nodeAllocator.mSlabs[j].mNbUsedNodes)
-					{
-						localNodeIndex = PxU32(pool[i].mPos - nodeAllocator.mSlabs[j].mPool);
-						break;
-					}
-					nodeBase += nodeAllocator.mSlabs[j].mNbUsedNodes;
+					const PxU32 mid = (lo + hi)>>1;
+					if(pos < ranges[mid].mStart)
+						hi = mid;
+					else
+						lo = mid;
 				}
-				const PxU32 nodeIndex = nodeBase + localNodeIndex;
+				const SlabRange& range = ranges[lo];
+				PX_ASSERT(pos >= range.mStart && pos < range.mEnd);
+				PX_UNUSED(range.mEnd);
+				const PxU32 nodeIndex = range.mNodeBase + PxU32(pos - range.mStart);
 				dest[offset].mData = nodeIndex << 1;
 			}
 			offset++;
@@ -38,6 +38,8 @@
 
 namespace physx
 {
+	class PxCpuDispatcher;
+
 namespace Gu
 {
 	struct BVHNode;
@@ -61,7 +63,8 @@ namespace Gu
 									mNbPrimitives	(nb_prims),
 									mBounds			(bounds),
 									mCache			(NULL),
-									mBuildStrategy	(bs)
+									mBuildStrategy	(bs),
+									mDispatcher		(NULL)
 								{
 								}
 								~AABBTreeBuildParams()
@@ -73,6 +76,7 @@ namespace Gu
 								{
 									mLimit = mNbPrimitives = 0;
 									mBounds = NULL;
+									mDispatcher = NULL;
 									PX_FREE(mCache);
 								}
 
@@ -81,6 +85,7 @@ namespace Gu
 		const AABBTreeBounds*	mBounds;		//!< Shortcut to an app-controlled array of AABBs.
 		mutable PxVec3*			mCache;			//!< Cache for AABB centers - managed by build code.
 		BVHBuildStrategy		mBuildStrategy;
+		PxCpuDispatcher*		mDispatcher;	//!< Optional dispatcher for multi-threaded builds. NULL to build on the calling thread.
 	};
 
 	//! AABB tree node used for building
@@ -128,9 +133,14 @@ namespace Gu
 									~NodeAllocator();
 
 		void						release();
-		void						init(PxU32 nbPrimitives, PxU32 limit);
+		void						init(PxU32 nbPrimitives, PxU32 limit, PxU32 maxNbInitialNodes=0xffffffff);
 		AABBTreeBuildNode*			getBiNode();
 
+		// PT: used by the parallel builder. Each build task allocates its nodes from its own allocator, which starts with an
+		// empty slab (no root node), and all allocators are merged into the main one before flattening the tree.
+		void						reserve(PxU32 nbNodes);
+		void						merge(NodeAllocator& other);
+
 		AABBTreeBuildNode*			mPool;
 
 		struct Slab
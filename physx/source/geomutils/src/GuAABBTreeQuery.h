@@ -129,6 +129,126 @@ namespace physx
 
 		//////////////////////////////////////////////////////////////////////////
 
+		// PT: reports all primitives below a node, without any test. Used by culling queries when a node is fully inside the volume.
+		template<const bool tHasIndices, typename Node, typename QueryCallback>
+		static bool dumpSubtree(const Node* const nodeBase, const Node* node0, const PxU32* indices, QueryCallback& visitor)
+		{
+			PxInlineArray<const Node*, RAW_TRAVERSAL_STACK_SIZE> stack;
+			stack.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
+			stack[0] = node0;
+			PxU32 stackIndex = 1;
+
+			while(stackIndex > 0)
+			{
+				const Node* node = stack[--stackIndex];
+				while(!node->isLeaf())
+				{
+					const Node* children = node->getPos(nodeBase);
+					node = children;
+					stack[stackIndex++] = children + 1;
+					if(stackIndex == stack.capacity())
+						stack.resizeUninitialized(stack.capacity() * 2);
+				}
+
+				PxU32 nbPrims = node->getNbPrimitives();
+				const PxU32* prims = tHasIndices ? node->getPrimitives(indices) : NULL;
+				while(nbPrims--)
+				{
+					const PxU32 primIndex = tHasIndices ? *prims++ : node->getPrimitiveIndex();
+					if(!visitor.invoke(primIndex))
+						return false;
+				}
+			}
+			return true;
+		}
+
+		// PT: frustum / convex-volume culling. Same as AABBTreeOverlap with a PlanesAABBTest, but each stack entry carries the clip
+		// mask of its parent, so that children only test the planes their parent straddled. Subtrees whose clip mask becomes null
+		// are fully inside the volume and reported as a whole, without further tests (the "containment tests" from Opcode).
+		template<const bool tHasIndices, typename Tree, typename Node, typename QueryCallback>
+		class AABBTreeCull
+		{
+		public:
+			bool operator()(const AABBTreeBounds& treeBounds, const Tree& tree, const PlanesAABBTest& test, QueryCallback& visitor)
+			{
+				const PxBounds3* bounds = treeBounds.getBounds();
+				const PxU32* indices = tree.getIndices();
+
+				struct Entry
+				{
+					const Node*	mNode;
+					PxU32		mClipMask;
+				};
+
+				PxInlineArray<Entry, RAW_TRAVERSAL_STACK_SIZE> stack;
+				stack.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
+				const Node* const nodeBase = tree.getNodes();
+				stack[0].mNode = nodeBase;
+				stack[0].mClipMask = test.mMask;
+				PxU32 stackIndex = 1;
+
+				while(stackIndex > 0)
+				{
+					const Entry& entry = stack[--stackIndex];
+					const Node* node = entry.mNode;
+					PxU32 clipMask = entry.mClipMask;
+
+					Vec3V center, extents;
+					node->getAABBCenterExtentsV(&center, &extents);
+					while(test.test(center, extents, clipMask, clipMask))
+					{
+						if(!clipMask)
+						{
+							if(!dumpSubtree<tHasIndices, Node>(nodeBase, node, indices, visitor))
+								return false;
+							break;
+						}
+
+						if(node->isLeaf())
+						{
+							PxU32 nbPrims = node->getNbPrimitives();
+							const bool doBoxTest = nbPrims > 1;
+							const PxU32* prims = tHasIndices ? node->getPrimitives(indices) : NULL;
+							while(nbPrims--)
+							{
+								const PxU32 primIndex = tHasIndices ? *prims++ : node->getPrimitiveIndex();
+								if(doBoxTest)
+								{
+									Vec4V center2, extents2;
+									getBoundsTimesTwo(center2, extents2, bounds, primIndex);
+
+									const FloatV halfV = FLoad(0.5f);
+									const Vec4V extents_ = V4Scale(extents2, halfV);
+									const Vec4V center_ = V4Scale(center2, halfV);
+
+									PxU32 primClipMask;
+									if(!test.test(Vec3V_From_Vec4V(center_), Vec3V_From_Vec4V(extents_), clipMask, primClipMask))
+										continue;
+								}
+
+								if(!visitor.invoke(primIndex))
+									return false;
+							}
+							break;
+						}
+
+						const Node* children = node->getPos(nodeBase);
+
+						node = children;
+						stack[stackIndex].mNode = children + 1;
+						stack[stackIndex].mClipMask = clipMask;
+						stackIndex++;
+						if(stackIndex == stack.capacity())
+							stack.resizeUninitialized(stack.capacity() * 2);
+						node->getAABBCenterExtentsV(&center, &extents);
+					}
+				}
+				return true;
+			}
+		};
+
+		//////////////////////////////////////////////////////////////////////////
+
 		template <const bool tInflate, const bool tHasIndices, typename Node, typename QueryCallback> // use inflate=true for sweeps, inflate=false for raycasts
 		static PX_FORCE_INLINE bool doLeafTest(	const Node* node, Gu::RayAABBTest& test, const PxBounds3* bounds, const PxU32* indices, PxReal& maxDist, QueryCallback& pcb)
 		{
@@ -46,7 +46,7 @@ using namespace Cm;
 
 // PT: these two functions moved from cooking
 
-bool BVHData::build(PxU32 nbBounds, const void* boundsData, PxU32 boundsStride, float enlargement, PxU32 nbPrimsPerLeaf, BVHBuildStrategy bs)
+bool BVHData::build(PxU32 nbBounds, const void* boundsData, PxU32 boundsStride, float enlargement, PxU32 nbPrimsPerLeaf, BVHBuildStrategy bs, BVHNodeWidth nodeWidth, PxCpuDispatcher* dispatcher)
 {
 	if(!nbBounds || !boundsData || boundsStride<sizeof(PxBounds3) || enlargement<0.0f || nbPrimsPerLeaf>=16)
 		return false;
@@ -68,7 +68,9 @@ bool BVHData::build(PxU32 nbBounds, const void* boundsData, PxU32 boundsStride,
 	// build the BVH
 	BuildStats stats;
 	NodeAllocator nodeAllocator;
-	mIndices = buildAABBTree(AABBTreeBuildParams(nbPrimsPerLeaf, nbBounds, &mBounds, bs), nodeAllocator, stats);
+	AABBTreeBuildParams params(nbPrimsPerLeaf, nbBounds, &mBounds, bs);
+	params.mDispatcher = dispatcher;
+	mIndices = buildAABBTree(params, nodeAllocator, stats);
 	if(!mIndices)
 		return false;
 
@@ -86,11 +88,15 @@ bool BVHData::build(PxU32 nbBounds, const void* boundsData, PxU32 boundsStride,
 	}
 	else
 		flattenTree(nodeAllocator, mNodes);
+
+	if(nodeWidth!=BVH_BINARY)
+		mWideTree.build(mNodes, mNbNodes, nodeWidth);
 	return true;
 }
 
 // A.B. move to load code
-#define PX_BVH_STRUCTURE_VERSION 1
+// PT: version 2 adds the node width. The wide tree itself is not serialized, it is collapsed again from the binary tree at load time.
+#define PX_BVH_STRUCTURE_VERSION 2
 
 bool BVHData::save(PxOutputStream& stream, bool endian) const
 {
@@ -122,6 +128,9 @@ bool BVHData::save(PxOutputStream& stream, bool endian) const
 		writeFloatBuffer(&mNodes[i].mBV.maximum.x, 3, endian, stream);
 	}
 
+	// write node width
+	writeDword(mWideTree.isValid() ? PxU32(mWideTree.getWidth()) : PxU32(BVH_BINARY), endian, stream);
+
 	return true;
 }
 
@@ -265,6 +274,14 @@ bool BVH::load(PxInputStream& stream)
 
 		readFloatBuffer(&mData.mNodes[i].mBV.minimum.x, 3 + 3, mismatch, stream);		
 	}
+
+	// read node width
+	if(version>=2)
+	{
+		const BVHNodeWidth nodeWidth = BVHNodeWidth(readDword(mismatch, stream));
+		if(nodeWidth!=BVH_BINARY)
+			mData.mWideTree.build(mData.mNodes, mData.mNbNodes, nodeWidth);
+	}
 	return true;
 }
 
@@ -343,13 +360,67 @@ namespace
 	};
 }
 
+// PT: dispatch queries to the wide tree when available, to the binary tree otherwise
+template<const bool tExactTest, typename Test, typename Callback>
+static PX_FORCE_INLINE bool overlapBVH(const BVHData& data, const PxBounds3& queryBounds, const Test& test, Callback& cb)
+{
+	const WideBVH& wideTree = data.mWideTree;
+	if(wideTree.isValid())
+	{
+		if(wideTree.getWidth()==BVH_WIDE_8)
+		{
+			if(data.mIndices)
+				return WideBVHOverlap<8, true, tExactTest, Test, Callback>()(data.mBounds, data.mNodes, data.mIndices, wideTree, queryBounds, test, cb);
+			else
+				return WideBVHOverlap<8, false, tExactTest, Test, Callback>()(data.mBounds, data.mNodes, data.mIndices, wideTree, queryBounds, test, cb);
+		}
+		else
+		{
+			if(data.mIndices)
+				return WideBVHOverlap<4, true, tExactTest, Test, Callback>()(data.mBounds, data.mNodes, data.mIndices, wideTree, queryBounds, test, cb);
+			else
+				return WideBVHOverlap<4, false, tExactTest, Test, Callback>()(data.mBounds, data.mNodes, data.mIndices, wideTree, queryBounds, test, cb);
+		}
+	}
+
+	if(data.mIndices)
+		return AABBTreeOverlap<true, Test, BVHTree, BVHNode, Callback>()(data.mBounds, BVHTree(data), test, cb);
+	else
+		return AABBTreeOverlap<false, Test, BVHTree, BVHNode, Callback>()(data.mBounds, BVHTree(data), test, cb);
+}
+
+template<const bool tInflate, typename Callback>
+static PX_FORCE_INLINE bool raycastBVH(const BVHData& data, const PxVec3& origin, const PxVec3& unitDir, PxReal& maxDist, const PxVec3& inflation, Callback& cb)
+{
+	const WideBVH& wideTree = data.mWideTree;
+	if(wideTree.isValid())
+	{
+		if(wideTree.getWidth()==BVH_WIDE_8)
+		{
+			if(data.mIndices)
+				return WideBVHRaycast<8, tInflate, true, Callback>()(data.mBounds, data.mNodes, data.mIndices, wideTree, origin, unitDir, maxDist, inflation, cb);
+			else
+				return WideBVHRaycast<8, tInflate, false, Callback>()(data.mBounds, data.mNodes, data.mIndices, wideTree, origin, unitDir, maxDist, inflation, cb);
+		}
+		else
+		{
+			if(data.mIndices)
+				return WideBVHRaycast<4, tInflate, true, Callback>()(data.mBounds, data.mNodes, data.mIndices, wideTree, origin, unitDir, maxDist, inflation, cb);
+			else
+				return WideBVHRaycast<4, tInflate, false, Callback>()(data.mBounds, data.mNodes, data.mIndices, wideTree, origin, unitDir, maxDist, inflation, cb);
+		}
+	}
+
+	if(data.mIndices)
+		return AABBTreeRaycast<tInflate, true, BVHTree, BVHNode, Callback>()(data.mBounds, BVHTree(data), origin, unitDir, maxDist, inflation, cb);
+	else
+		return AABBTreeRaycast<tInflate, false, BVHTree, BVHNode, Callback>()(data.mBounds, BVHTree(data), origin, unitDir, maxDist, inflation, cb);
+}
+
 PxU32 BVH::raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal maxDist, PxU32 maxHits, PxU32* PX_RESTRICT rayHits) const
 {
 	BVHCallback cbk(rayHits, maxHits);
-	if(mData.mIndices)
-		AABBTreeRaycast<false, true, BVHTree, BVHNode, BVHCallback>()(mData.mBounds, BVHTree(mData), origin, unitDir, maxDist, PxVec3(0.0f), cbk);
-	else
-		AABBTreeRaycast<false, false, BVHTree, BVHNode, BVHCallback>()(mData.mBounds, BVHTree(mData), origin, unitDir, maxDist, PxVec3(0.0f), cbk);
+	raycastBVH<false>(mData, origin, unitDir, maxDist, PxVec3(0.0f), cbk);
 
 	return cbk.mCurrentHitsCount;
 }
@@ -357,10 +428,7 @@ PxU32 BVH::raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal maxDist,
 PxU32 BVH::sweep(const PxBounds3& aabb, const PxVec3& unitDir, PxReal maxDist, PxU32 maxHits, PxU32* PX_RESTRICT sweepHits) const
 {
 	BVHCallback cbk(sweepHits, maxHits);
-	if(mData.mIndices)
-		AABBTreeRaycast<true, true, BVHTree, BVHNode, BVHCallback>()(mData.mBounds, BVHTree(mData), aabb.getCenter(), unitDir, maxDist, aabb.getExtents(), cbk);
-	else
-		AABBTreeRaycast<true, false, BVHTree, BVHNode, BVHCallback>()(mData.mBounds, BVHTree(mData), aabb.getCenter(), unitDir, maxDist, aabb.getExtents(), cbk);
+	raycastBVH<true>(mData, aabb.getCenter(), unitDir, maxDist, aabb.getExtents(), cbk);
 
 	return cbk.mCurrentHitsCount;
 }
@@ -369,10 +437,7 @@ PxU32 BVH::overlap(const PxBounds3& aabb, PxU32 maxHits, PxU32* PX_RESTRICT over
 {
 	BVHOverlapCallback cbk(overlapHits, maxHits);
 	const AABBAABBTest test(aabb);
-	if(mData.mIndices)
-		AABBTreeOverlap<true, AABBAABBTest, BVHTree, BVHNode, BVHOverlapCallback>()(mData.mBounds, BVHTree(mData), test, cbk);
-	else
-		AABBTreeOverlap<false, AABBAABBTest, BVHTree, BVHNode, BVHOverlapCallback>()(mData.mBounds, BVHTree(mData), test, cbk);
+	overlapBVH<false, AABBAABBTest>(mData, aabb, test, cbk);
 
 	return cbk.mCurrentHitsCount;
 }
@@ -402,10 +467,7 @@ bool BVH::raycast(const PxVec3& origin, const PxVec3& unitDir, float distance, R
 {
 	PX_SIMD_GUARD_CNDT(flags & PxGeometryQueryFlag::eSIMD_GUARD)
 	RaycastAdapter ra(cb);
-	if(mData.mIndices)
-		return AABBTreeRaycast<false, true, BVHTree, BVHNode, RaycastAdapter>()(mData.mBounds, BVHTree(mData), origin, unitDir, distance, PxVec3(0.0f), ra);
-	else
-		return AABBTreeRaycast<false, false, BVHTree, BVHNode, RaycastAdapter>()(mData.mBounds, BVHTree(mData), origin, unitDir, distance, PxVec3(0.0f), ra);
+	return raycastBVH<false>(mData, origin, unitDir, distance, PxVec3(0.0f), ra);
 }
 
 namespace
@@ -433,6 +495,7 @@ bool BVH::overlap(const ShapeData& queryVolume, OverlapCallback& cb, PxGeometryQ
 	PX_SIMD_GUARD_CNDT(flags & PxGeometryQueryFlag::eSIMD_GUARD)
 
 	OverlapAdapter oa(cb);
+	const PxBounds3& queryBounds = queryVolume.getPrunerInflatedWorldAABB();
 
 	switch(queryVolume.getType())
 	{
@@ -441,43 +504,28 @@ bool BVH::overlap(const ShapeData& queryVolume, OverlapCallback& cb, PxGeometryQ
 			if(queryVolume.isOBB())
 			{	
 				const DefaultOBBAABBTest test(queryVolume);
-				if(mData.mIndices)
-					return AABBTreeOverlap<true, OBBAABBTest, BVHTree, BVHNode, OverlapAdapter>()(mData.mBounds, BVHTree(mData), test, oa);
-				else
-					return AABBTreeOverlap<false, OBBAABBTest, BVHTree, BVHNode, OverlapAdapter>()(mData.mBounds, BVHTree(mData), test, oa);
+				return overlapBVH<true, OBBAABBTest>(mData, queryBounds, test, oa);
 			}
 			else
 			{
 				const DefaultAABBAABBTest test(queryVolume);
-				if(mData.mIndices)
-					return AABBTreeOverlap<true, AABBAABBTest, BVHTree, BVHNode, OverlapAdapter>()(mData.mBounds, BVHTree(mData), test, oa);
-				else
-					return AABBTreeOverlap<false, AABBAABBTest, BVHTree, BVHNode, OverlapAdapter>()(mData.mBounds, BVHTree(mData), test, oa);
+				return overlapBVH<false, AABBAABBTest>(mData, queryBounds, test, oa);
 			}
 		}
 		case PxGeometryType::eCAPSULE:
 		{
 			const DefaultCapsuleAABBTest test(queryVolume, 1.0f);
-			if(mData.mIndices)
-				return AABBTreeOverlap<true, CapsuleAABBTest, BVHTree, BVHNode, OverlapAdapter>()(mData.mBounds, BVHTree(mData), test, oa);
-			else
-				return AABBTreeOverlap<false, CapsuleAABBTest, BVHTree, BVHNode, OverlapAdapter>()(mData.mBounds, BVHTree(mData), test, oa);
+			return overlapBVH<true, CapsuleAABBTest>(mData, queryBounds, test, oa);
 		}
 		case PxGeometryType::eSPHERE:
 		{
 			const DefaultSphereAABBTest test(queryVolume);
-			if(mData.mIndices)
-				return AABBTreeOverlap<true, SphereAABBTest, BVHTree, BVHNode, OverlapAdapter>()(mData.mBounds, BVHTree(mData), test, oa);
-			else
-				return AABBTreeOverlap<false, SphereAABBTest, BVHTree, BVHNode, OverlapAdapter>()(mData.mBounds, BVHTree(mData), test, oa);
+			return overlapBVH<true, SphereAABBTest>(mData, queryBounds, test, oa);
 		}
 		case PxGeometryType::eCONVEXMESH:
 		{
 			const DefaultOBBAABBTest test(queryVolume);
-			if(mData.mIndices)
-				return AABBTreeOverlap<true, OBBAABBTest, BVHTree, BVHNode, OverlapAdapter>()(mData.mBounds, BVHTree(mData), test, oa);
-			else
-				return AABBTreeOverlap<false, OBBAABBTest, BVHTree, BVHNode, OverlapAdapter>()(mData.mBounds, BVHTree(mData), test, oa);
+			return overlapBVH<true, OBBAABBTest>(mData, queryBounds, test, oa);
 		}
 	default:
 		PX_ALWAYS_ASSERT_MESSAGE("unsupported overlap query volume geometry type");
@@ -497,10 +545,7 @@ bool BVH::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, float dista
 
 	const PxBounds3& aabb = queryVolume.getPrunerInflatedWorldAABB();
 	RaycastAdapter ra(cb);
-	if(mData.mIndices)
-		return AABBTreeRaycast<true, true, BVHTree, BVHNode, RaycastAdapter>()(mData.mBounds, BVHTree(mData), aabb.getCenter(), unitDir, distance, aabb.getExtents(), ra);
-	else
-		return AABBTreeRaycast<true, false, BVHTree, BVHNode, RaycastAdapter>()(mData.mBounds, BVHTree(mData), aabb.getCenter(), unitDir, distance, aabb.getExtents(), ra);
+	return raycastBVH<true>(mData, aabb.getCenter(), unitDir, distance, aabb.getExtents(), ra);
 }
 
 bool BVH::sweep(const PxGeometry& geom, const PxTransform& pose, const PxVec3& unitDir, float distance, RaycastCallback& cb, PxGeometryQueryFlags flags) const
@@ -509,197 +554,23 @@ bool BVH::sweep(const PxGeometry& geom, const PxTransform& pose, const PxVec3& u
 	return sweep(queryVolume, unitDir, distance, cb, flags);
 }
 
-namespace
-{
-	PX_FORCE_INLINE bool planesAABBOverlap(const PxVec3& m, const PxVec3& d, const PxPlane* p, PxU32& outClipMask, PxU32 inClipMask)
-	{
-		PxU32 mask = 1;
-		PxU32 tmpOutClipMask = 0;
-
-		while(mask<=inClipMask)
-		{
-			if(inClipMask & mask)
-			{               
-				const float NP = d.x*fabsf(p->n.x) + d.y*fabsf(p->n.y) + d.z*fabsf(p->n.z);
-				const float MP = m.x*p->n.x + m.y*p->n.y + m.z*p->n.z + p->d;
-
-				if(NP < MP)
-					return false;
-				if((-NP) < MP)
-					tmpOutClipMask |= mask;
-			}
-			mask+=mask;
-			p++;
-		}
-
-		outClipMask = tmpOutClipMask;
-		return true;
-	}
-
-	struct FrustumTest
-	{
-		FrustumTest(PxU32 nbPlanes, const PxPlane* planes) : mPlanes(planes), mMask((1<<nbPlanes)-1), mNbPlanes(nbPlanes), mOutClipMask(0)
-		{
-		}
-
-		PX_FORCE_INLINE PxIntBool operator()(const Vec3V boxCenter, const Vec3V boxExtents) const		
-		{
-			// PT: TODO: rewrite all this in SIMD
-			PxVec3 center, extents;
-			V3StoreU(boxCenter, center);
-			V3StoreU(boxExtents, extents);
-
-			if(!planesAABBOverlap(center, extents, mPlanes, mOutClipMask, mMask))
-				return PxIntFalse;
-
-			// PT: unfortunately the AABBTreeOverlap template doesn't support this case where we know we can
-			// immediately dump the rest of the tree (i.e. the old "containment tests" in Opcode). We might
-			// want to revisit this at some point.
-			//
-			// In fact it's worse than this: we lost the necessary data to make this quick, in "flattenTree"
-			// when going from AABBTreeBuildNodes to BVHNodes. The BVHNodes lost the primitive-related info
-			// for internal (non-leaf) nodes so we cannot just dump a list of primitives when an internal
-			// node is fully visible (like we did in Opcode 1.x). Best we can do is keep traversing the tree
-			// and skip VFC tests.
-			//if(!outClipMask)
-			
-			return PxIntTrue;
-		}
-
-		const PxPlane*	mPlanes;
-		const PxU32		mMask;
-		const PxU32		mNbPlanes;
-		mutable PxU32	mOutClipMask;
-
-		PX_NOCOPY(FrustumTest)
-	};
-}
-
-static bool dumpNode(OverlapAdapter& oa, const BVHNode* const nodeBase, const BVHNode* node0, const PxU32* indices)
-{
-	PxInlineArray<const BVHNode*, RAW_TRAVERSAL_STACK_SIZE> stack;
-	stack.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
-	stack[0] = node0;
-	PxU32 stackIndex = 1;
-
-	while(stackIndex > 0)
-	{
-		const BVHNode* node = stack[--stackIndex];
-
-		while(1)
-		{
-			if(node->isLeaf())
-			{
-				PxU32 nbPrims = node->getNbPrimitives();
-				const PxU32* prims = indices ? node->getPrimitives(indices) : NULL;
-				while(nbPrims--)
-				{
-					const PxU32 primIndex = indices ? *prims++ : node->getPrimitiveIndex();
-					if(!oa.invoke(primIndex))
-						return false;
-				}
-				break;
-			}
-			else
-			{
-				const BVHNode* children = node->getPos(nodeBase);
-				node = children;
-				stack[stackIndex++] = children + 1;
-				if(stackIndex == stack.capacity())
-					stack.resizeUninitialized(stack.capacity() * 2);
-			}
-		}
-	}
-	return true;
-}
-
 bool BVH::cull(PxU32 nbPlanes, const PxPlane* planes, OverlapCallback& cb, PxGeometryQueryFlags flags) const
 {
 	PX_SIMD_GUARD_CNDT(flags & PxGeometryQueryFlag::eSIMD_GUARD)
 
 	OverlapAdapter oa(cb);
-	const FrustumTest test(nbPlanes, planes);
+	const PlanesAABBTest test(nbPlanes, planes);
 
-	if(0)
-	{
-		// PT: this vanilla codepath is slower
-		if(mData.mIndices)
-			return AABBTreeOverlap<true, FrustumTest, BVHTree, BVHNode, OverlapAdapter>()(mData.mBounds, BVHTree(mData), test, oa);
-		else
-			return AABBTreeOverlap<false, FrustumTest, BVHTree, BVHNode, OverlapAdapter>()(mData.mBounds, BVHTree(mData), test, oa);
-	}
+	if(mData.mIndices)
+		return AABBTreeCull<true, BVHTree, BVHNode, OverlapAdapter>()(mData.mBounds, BVHTree(mData), test, oa);
 	else
-	{
-		const PxBounds3* bounds = mData.mBounds.getBounds();
-		const bool hasIndices = mData.mIndices!=NULL;
-
-		PxInlineArray<const BVHNode*, RAW_TRAVERSAL_STACK_SIZE> stack;
-		stack.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
-		const BVHNode* const nodeBase = mData.mNodes;
-		stack[0] = nodeBase;
-		PxU32 stackIndex = 1;
-
-		while(stackIndex > 0)
-		{
-			const BVHNode* node = stack[--stackIndex];
-			Vec3V center, extents;
-			node->getAABBCenterExtentsV(&center, &extents);
-			while(test(center, extents))
-			{
-				if(!test.mOutClipMask)
-				{
-					if(!dumpNode(oa, nodeBase, node, mData.mIndices))
-						return false;
-					break;
-				}
-				else
-				{
-					if(node->isLeaf())
-					{
-						PxU32 nbPrims = node->getNbPrimitives();
-						const bool doBoxTest = nbPrims > 1;
-						const PxU32* prims = hasIndices ? node->getPrimitives(mData.mIndices) : NULL;
-						while(nbPrims--)
-						{
-							const PxU32 primIndex = hasIndices ? *prims++ : node->getPrimitiveIndex();
-							if(doBoxTest)
-							{
-								Vec4V center2, extents2;
-								getBoundsTimesTwo(center2, extents2, bounds, primIndex);
-
-								const float half = 0.5f;
-								const FloatV halfV = FLoad(half);
-
-								const Vec4V extents_ = V4Scale(extents2, halfV);
-								const Vec4V center_ = V4Scale(center2, halfV);
-
-								if(!test(Vec3V_From_Vec4V(center_), Vec3V_From_Vec4V(extents_)))
-									continue;
-							}
-
-							if(!oa.invoke(primIndex))
-								return false;
-						}
-						break;
-					}
-
-					const BVHNode* children = node->getPos(nodeBase);
-
-					node = children;
-					stack[stackIndex++] = children + 1;
-					if(stackIndex == stack.capacity())
-						stack.resizeUninitialized(stack.capacity() * 2);
-					node->getAABBCenterExtentsV(&center, &extents);
-				}
-			}
-		}
-		return true;
-	}
+		return AABBTreeCull<false, BVHTree, BVHNode, OverlapAdapter>()(mData.mBounds, BVHTree(mData), test, oa);
 }
 
 void BVH::refit()
 {
 	mData.fullRefit(mData.mBounds.getBounds());
+	mData.mWideTree.refit(mData.mNodes);
 }
 
 bool BVH::updateBoundsInternal(PxU32 localIndex, const PxBounds3& newBounds)
@@ -736,6 +607,8 @@ bool BVH::updateBounds(PxU32 boundsIndex, const PxBounds3& newBounds)
 void BVH::partialRefit()
 {
 	mData.refitMarkedNodes(mData.mBounds.getBounds());
+	// PT: the wide tree doesn't track marked nodes, it is entirely refit. This is still a linear copy of the binary bounds.
+	mData.mWideTree.refit(mData.mNodes);
 }
 
 bool BVH::traverse(TraversalCallback& cb) const
@@ -40,6 +40,7 @@
 #include "foundation/PxUserAllocated.h"
 #include "GuAABBTreeBounds.h"
 #include "GuAABBTree.h"
+#include "GuWideBVH.h"
 
 namespace physx
 {
@@ -64,6 +65,7 @@ namespace Gu
 							mNodes		= other.mNodes;
 
 							mBounds.moveFrom(other.mBounds);
+							mWideTree.moveFrom(other.mWideTree);
 							other.mIndices = NULL;
 							other.mNodes = NULL;
 						}
@@ -80,10 +82,11 @@ namespace Gu
 							mNbIndices = 0;
 						}
 
-		PX_PHYSX_COMMON_API	bool	build(PxU32 nbBounds, const void* boundsData, PxU32 boundsStride, float enlargement, PxU32 numPrimsPerLeaf, BVHBuildStrategy bs);
+		PX_PHYSX_COMMON_API	bool	build(PxU32 nbBounds, const void* boundsData, PxU32 boundsStride, float enlargement, PxU32 numPrimsPerLeaf, BVHBuildStrategy bs, BVHNodeWidth nodeWidth, PxCpuDispatcher* dispatcher=NULL);
 		PX_PHYSX_COMMON_API	bool	save(PxOutputStream& stream, bool endian) const;
 
 		AABBTreeBounds	mBounds;
+		WideBVH			mWideTree;	//!< Optional wide version of the tree, used for queries
 	};
 
 	/**
@@ -35,6 +35,7 @@
 #include "geometry/PxSphereGeometry.h"
 #include "geometry/PxCapsuleGeometry.h"
 #include "foundation/PxVecMath.h"
+#include "foundation/PxPlane.h"
 
 namespace physx
 {
@@ -252,6 +253,107 @@ struct OBBAABBTests
 
 typedef OBBAABBTests<true> OBBAABBTest;
 
+#define GU_MAX_NB_CULLING_PLANES	32
+
+// PT: SIMD version of the old Opcode "planes-AABB" test used for frustum / convex-volume culling. Planes are stored
+// in SoA form, 4 planes per group, so that a single group test covers 4 planes at once. A plane is only tested if
+// its bit is set in the incoming clip mask. The outgoing clip mask contains the planes straddled by the box: if it
+// ends up null the box is fully inside the volume and its children don't need further tests.
+//
+// Points P for which n.P + d > 0 are outside the volume, same as in PxBVH::cull().
+struct PlanesAABBTest
+{
+	PlanesAABBTest(PxU32 nbPlanes, const PxPlane* planes)
+	{
+		PX_ASSERT(nbPlanes<=GU_MAX_NB_CULLING_PLANES);
+		if(nbPlanes>GU_MAX_NB_CULLING_PLANES)
+			nbPlanes = GU_MAX_NB_CULLING_PLANES;
+
+		mNbGroups = (nbPlanes+3)>>2;
+		mMask = nbPlanes==32 ? 0xffffffff : (1<<nbPlanes)-1;
+
+		for(PxU32 i=0;i<mNbGroups;i++)
+		{
+			// PT: unused lanes get a null normal and a negative distance. They can never reject a box, and they never
+			// appear in the clip masks either.
+			PX_ALIGN(16, PxF32 nx[4]);
+			PX_ALIGN(16, PxF32 ny[4]);
+			PX_ALIGN(16, PxF32 nz[4]);
+			PX_ALIGN(16, PxF32 d[4]);
+			for(PxU32 j=0;j<4;j++)
+			{
+				const PxU32 index = i*4+j;
+				if(index<nbPlanes)
+				{
+					nx[j] = planes[index].n.x;
+					ny[j] = planes[index].n.y;
+					nz[j] = planes[index].n.z;
+					d[j] = planes[index].d;
+				}
+				else
+				{
+					nx[j] = ny[j] = nz[j] = 0.0f;
+					d[j] = -1.0f;
+				}
+			}
+			mNx[i] = V4LoadA(nx);
+			mNy[i] = V4LoadA(ny);
+			mNz[i] = V4LoadA(nz);
+			mD[i] = V4LoadA(d);
+			mAbsNx[i] = V4Abs(mNx[i]);
+			mAbsNy[i] = V4Abs(mNy[i]);
+			mAbsNz[i] = V4Abs(mNz[i]);
+		}
+	}
+
+	// PT: returns false if the box is fully outside one of the active planes. Otherwise returns true and
+	// writes the planes straddled by the box to outClipMask.
+	PX_FORCE_INLINE bool test(const Vec3V center, const Vec3V extents, PxU32 inClipMask, PxU32& outClipMask) const
+	{
+		const Vec4V cx = V4Splat(V3GetX(center));
+		const Vec4V cy = V4Splat(V3GetY(center));
+		const Vec4V cz = V4Splat(V3GetZ(center));
+		const Vec4V ex = V4Splat(V3GetX(extents));
+		const Vec4V ey = V4Splat(V3GetY(extents));
+		const Vec4V ez = V4Splat(V3GetZ(extents));
+
+		PxU32 clipMask = 0;
+		for(PxU32 i=0;i<mNbGroups;i++)
+		{
+			const PxU32 groupMask = (inClipMask>>(i*4)) & 15;
+			if(!groupMask)
+				continue;
+
+			const Vec4V MP = V4MulAdd(mNx[i], cx, V4MulAdd(mNy[i], cy, V4MulAdd(mNz[i], cz, mD[i])));
+			const Vec4V NP = V4MulAdd(mAbsNx[i], ex, V4MulAdd(mAbsNy[i], ey, V4Mul(mAbsNz[i], ez)));
+
+			if(BGetBitMask(V4IsGrtr(MP, NP)) & groupMask)
+				return false;
+
+			clipMask |= (BGetBitMask(V4IsGrtr(MP, V4Neg(NP))) & groupMask)<<(i*4);
+		}
+		outClipMask = clipMask;
+		return true;
+	}
+
+	// PT: for compatibility with the regular overlap traversals
+	PX_FORCE_INLINE PxIntBool operator()(const Vec3V center, const Vec3V extents) const
+	{
+		PxU32 clipMask;
+		return PxIntBool(test(center, extents, mMask, clipMask));
+	}
+
+	Vec4V	mNx[GU_MAX_NB_CULLING_PLANES/4];
+	Vec4V	mNy[GU_MAX_NB_CULLING_PLANES/4];
+	Vec4V	mNz[GU_MAX_NB_CULLING_PLANES/4];
+	Vec4V	mD[GU_MAX_NB_CULLING_PLANES/4];
+	Vec4V	mAbsNx[GU_MAX_NB_CULLING_PLANES/4];
+	Vec4V	mAbsNy[GU_MAX_NB_CULLING_PLANES/4];
+	Vec4V	mAbsNz[GU_MAX_NB_CULLING_PLANES/4];
+	PxU32	mNbGroups;
+	PxU32	mMask;	// PT: initial clip mask, one bit per plane
+};
+
 }
 }
 #endif
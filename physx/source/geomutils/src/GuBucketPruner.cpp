@@ -32,6 +32,7 @@
 #include "GuInternal.h"
 #include "CmVisualization.h"
 #include "CmRadixSort.h"
+#include "GuBVHTestsSIMD.h"
 
 using namespace physx::aos;
 
@@ -2183,6 +2184,42 @@ bool BucketPrunerCore::overlap(const ShapeData& queryVolume, PrunerOverlapCallba
 
 ///////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+struct BucketPrunerPlanesAABBTest
+{
+	PX_FORCE_INLINE BucketPrunerPlanesAABBTest(const PlanesAABBTest& test) : mTest(test)	{}
+
+	PX_FORCE_INLINE PxIntBool operator()(const BucketBox& box) const
+	{
+		return mTest(V3LoadU(box.mCenter), V3LoadU(box.mExtents));
+	}
+
+	PX_FORCE_INLINE PxIntBool operator()(const PxBounds3& bounds) const
+	{
+		return mTest(V3LoadU(bounds.getCenter()), V3LoadU(bounds.getExtents()));
+	}
+
+	const PlanesAABBTest&	mTest;
+
+	PX_NOCOPY(BucketPrunerPlanesAABBTest)
+};
+}
+
+bool BucketPrunerCore::cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& pcb) const
+{
+	PX_ASSERT(!mDirty);
+
+	// PT: the culling volume can be unbounded so we cannot use its bounds to limit the search along the sorting axis
+	const PxBounds3 cullBox(PxVec3(-PX_MAX_BOUNDS_EXTENTS), PxVec3(PX_MAX_BOUNDS_EXTENTS));
+
+	const PlanesAABBTest planesTest(nbPlanes, planes);
+	const BucketPrunerOverlapTraversal<BucketPrunerPlanesAABBTest, false> overlap;
+	return overlap(*this, BucketPrunerPlanesAABBTest(planesTest), pcb, cullBox);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void BucketPrunerCore::getGlobalBounds(PxBounds3& bounds) const
 {
 	// PT: TODO: refactor with similar code above in the file
@@ -2391,6 +2428,14 @@ bool BucketPruner::overlap(const ShapeData& queryVolume, PrunerOverlapCallback&
 	return mCore.overlap(queryVolume, pcb);
 }
 
+bool BucketPruner::cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& pcb) const
+{
+	PX_ASSERT(!mCore.mDirty);
+	if(mCore.mDirty)
+		return true; // it may crash otherwise
+	return mCore.cull(nbPlanes, planes, pcb);
+}
+
 bool BucketPruner::raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& pcb) const
 {
 	PX_ASSERT(!mCore.mDirty);
@@ -0,0 +1,157 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef GU_BUILD_TASK_H
+#define GU_BUILD_TASK_H
+
+#include "foundation/PxAtomic.h"
+#include "foundation/PxSync.h"
+#include "foundation/PxFPU.h"
+#include "foundation/PxMath.h"
+#include "task/PxTask.h"
+#include "task/PxCpuDispatcher.h"
+
+namespace physx
+{
+namespace Gu
+{
+	class BuildTaskSync;
+
+	// PT: minimal task used by the multi-threaded tree builders. These builders also run outside of a scene (e.g. when
+	// cooking a PxBVH) so there is no PxTaskManager around: tasks are submitted directly to a PxCpuDispatcher and their
+	// completion is tracked by a BuildTaskSync object. Tasks are owned by the caller and must outlive BuildTaskSync::wait().
+	class BuildTask : public PxBaseTask
+	{
+		public:
+								BuildTask() : mBuildSync(NULL)	{}
+		virtual					~BuildTask()					{}
+
+		virtual	void			runInternal()	= 0;
+
+		// PxBaseTask
+		virtual	void			run()
+								{
+									PX_SIMD_GUARD
+									runInternal();
+								}
+		virtual	void			addReference()			{}
+		virtual	void			removeReference()		{}
+		virtual	int32_t			getReference()	const	{ return 1;	}
+		virtual	void			release();
+		//~PxBaseTask
+
+				BuildTaskSync*	mBuildSync;
+	};
+
+	class BuildTaskSync
+	{
+		public:
+		// PT: the counter starts at 1 for the submitting thread, so that tasks completing while others are still being
+		// submitted cannot signal the sync object too early.
+		PX_FORCE_INLINE			BuildTaskSync() : mNbPending(1)	{}
+
+		PX_FORCE_INLINE	void	submit(PxCpuDispatcher& dispatcher, BuildTask& task)
+								{
+									task.mBuildSync = this;
+									PxAtomicIncrement(&mNbPending);
+									dispatcher.submitTask(task);
+								}
+
+		// PT: waits until all submitted tasks have been released by the dispatcher. Must be called exactly once.
+		PX_FORCE_INLINE	void	wait()
+								{
+									if(PxAtomicDecrement(&mNbPending))
+										mSync.wait();
+								}
+
+		PX_FORCE_INLINE	void	taskDone()
+								{
+									if(!PxAtomicDecrement(&mNbPending))
+										mSync.set();
+								}
+		private:
+				PxSync			mSync;
+				volatile PxI32	mNbPending;
+	};
+
+	PX_FORCE_INLINE void BuildTask::release()
+	{
+		mBuildSync->taskDone();
+	}
+
+	template<class FuncT>
+	class RangeTask : public BuildTask
+	{
+		public:
+		virtual	void		runInternal()			{ (*mFunc)(mStart, mEnd);	}
+		virtual	const char*	getName()		const	{ return "RangeTask";		}
+
+				FuncT*		mFunc;
+				PxU32		mStart;
+				PxU32		mEnd;
+	};
+
+	#define GU_MAX_NB_RANGE_TASKS	64
+
+	// PT: calls func(start, end) on contiguous batches covering [0, nb), using the dispatcher's worker threads when there
+	// is enough work. Batches have at least minBatchSize elements and the calling thread processes the first one. Elements
+	// must be processed independently of each other, so that results do not depend on the number of threads.
+	template<class FuncT>
+	void runParallelRanges(PxCpuDispatcher* dispatcher, PxU32 nb, PxU32 minBatchSize, FuncT& func)
+	{
+		PxU32 nbBatches = 1;
+		if(dispatcher && dispatcher->getWorkerCount()>1)
+			nbBatches = PxMin(PxMin(nb/PxMax<PxU32>(minBatchSize, 1), dispatcher->getWorkerCount()*4), PxU32(GU_MAX_NB_RANGE_TASKS));
+
+		if(nbBatches<=1)
+		{
+			func(0, nb);
+			return;
+		}
+
+		const PxU32 batchSize = (nb + nbBatches - 1)/nbBatches;
+
+		RangeTask<FuncT> tasks[GU_MAX_NB_RANGE_TASKS];
+		BuildTaskSync sync;
+		for(PxU32 i=1;i<nbBatches;i++)
+		{
+			const PxU32 start = i*batchSize;
+			if(start>=nb)
+				break;
+			tasks[i].mFunc	= &func;
+			tasks[i].mStart	= start;
+			tasks[i].mEnd	= PxMin(start + batchSize, nb);
+			sync.submit(*dispatcher, tasks[i]);
+		}
+		func(0, batchSize);
+		sync.wait();
+	}
+}
+}
+
+#endif
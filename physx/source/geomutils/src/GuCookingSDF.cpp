@@ -167,12 +167,11 @@ namespace physx
 
 		PxReal narrowBandThickness = sdfDesc.narrowBandThicknessRelativeToSdfBoundsDiagonal * edges.magnitude();
 		PxReal subgridsMinSdfValue, subgridsMaxSdfValue;
-		PxArray<PxReal> denseSdf;
 		{		
 			PxArray<PxReal> sparseSdf;
-			Gu::SDFUsingWindingNumbersSparse(&mesh.m_positions[0], &mesh.m_indices[0], mesh.m_indices.size(), dx, dy, dz, 
+			Gu::SDFUsingWindingNumbersSparseNarrowBand(&mesh.m_positions[0], &mesh.m_indices[0], mesh.m_indices.size(), dx, dy, dz, 
 				meshLower, meshLower + PxVec3(static_cast<PxReal>(dx), static_cast<PxReal>(dy), static_cast<PxReal>(dz)) * spacing, narrowBandThickness, sdfDesc.subgridSize,
-				sdf, sdfSubgridsStartSlots, sparseSdf, denseSdf, subgridsMinSdfValue, subgridsMaxSdfValue, 16);
+				sdf, sdfSubgridsStartSlots, sparseSdf, subgridsMinSdfValue, subgridsMaxSdfValue, 16);
 
 			PxArray<PxReal> uncompressedSdfDataSubgrids;
 			Gu::convertSparseSDFTo3DTextureLayout(dx, dy, dz, sdfDesc.subgridSize, sdfSubgridsStartSlots.begin(), sparseSdf.begin(), sparseSdf.size(), uncompressedSdfDataSubgrids,
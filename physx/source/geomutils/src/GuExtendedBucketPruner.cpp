@@ -734,6 +734,49 @@ bool ExtendedBucketPruner::overlap(const ShapeData& queryVolume, PrunerOverlapCa
 	return again;
 }
 
+//////////////////////////////////////////////////////////////////////////
+// cull main tree callback
+struct MainTreeCullPrunerCallback
+{
+	MainTreeCullPrunerCallback(const PlanesAABBTest& test, PrunerOverlapCallback& prunerCallback, const PruningPool* pool, const MergedTree* mergedTrees)
+		: mTest(test), mPrunerCallback(prunerCallback), mPruningPool(pool), mMergedTrees(mergedTrees)
+	{
+	}
+
+	bool invoke(PxU32 primIndex)
+	{
+		const AABBTree* aabbTree = mMergedTrees[primIndex].mTree;
+		// cull the merged tree
+		OverlapCallbackAdapter pcb(mPrunerCallback, *mPruningPool);
+		return AABBTreeCull<true, AABBTree, BVHNode, OverlapCallbackAdapter>()(mPruningPool->getCurrentAABBTreeBounds(), *aabbTree, mTest, pcb);
+	}
+
+	PX_NOCOPY(MainTreeCullPrunerCallback)
+
+private:
+	const PlanesAABBTest&	mTest;
+	PrunerOverlapCallback&	mPrunerCallback;
+	const PruningPool*		mPruningPool;
+	const MergedTree*		mMergedTrees;
+};
+
+//////////////////////////////////////////////////////////////////////////
+// cull implementation
+bool ExtendedBucketPruner::cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& prunerCallback) const
+{
+	bool again = mCompanion ? mCompanion->cull(nbPlanes, planes, prunerCallback) : true;
+
+	if(again && mExtendedBucketPrunerMap.size())
+	{
+		const PlanesAABBTest test(nbPlanes, planes);
+		MainTreeCullPrunerCallback pcb(test, prunerCallback, mPruningPool, mMergedTrees);
+		// PT: the main tree has one merged tree per leaf, so we use the regular overlap traversal here and a proper cull inside each merged tree
+		again = AABBTreeOverlap<true, PlanesAABBTest, AABBTree, BVHNode, MainTreeCullPrunerCallback>()(mBounds, *mMainTree, test, pcb);
+	}
+
+	return again;
+}
+
 //////////////////////////////////////////////////////////////////////////
 // sweep implementation 
 bool ExtendedBucketPruner::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback) const
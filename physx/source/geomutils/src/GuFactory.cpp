@@ -30,6 +30,7 @@
 #include "GuAABBPruner.h"
 #include "GuBucketPruner.h"
 #include "GuIncrementalAABBPruner.h"
+#include "GuPagedPruner.h"
 
 using namespace physx;
 using namespace Gu;
@@ -39,9 +40,9 @@ Pruner* physx::Gu::createBucketPruner(PxU64 contextID)
 	return PX_NEW(BucketPruner)(contextID);
 }
 
-Pruner* physx::Gu::createAABBPruner(PxU64 contextID, bool dynamic, CompanionPrunerType cpType, BVHBuildStrategy buildStrategy, PxU32 nbObjectsPerNode)
+Pruner* physx::Gu::createAABBPruner(PxU64 contextID, bool dynamic, CompanionPrunerType cpType, BVHBuildStrategy buildStrategy, PxU32 nbObjectsPerNode, BVHNodeWidth nodeWidth)
 {
-	return PX_NEW(AABBPruner)(dynamic, contextID, cpType, buildStrategy, nbObjectsPerNode);
+	return PX_NEW(AABBPruner)(dynamic, contextID, cpType, buildStrategy, nbObjectsPerNode, nodeWidth);
 }
 
 Pruner* physx::Gu::createIncrementalPruner(PxU64 contextID)
@@ -49,3 +50,8 @@ Pruner* physx::Gu::createIncrementalPruner(PxU64 contextID)
 	return PX_NEW(IncrementalAABBPruner)(32, contextID);
 }
 
+
+PagedPruner* physx::Gu::createPagedPruner(PxU64 contextID)
+{
+	return PX_NEW(BVHPagedPruner)(contextID);
+}
@@ -328,13 +328,13 @@ PxBounds3 PxGeometryQuery::getWorldBounds(const PxGeometry& geom, const PxTransf
 
 extern GeomMTDFunc gGeomMTDMethodTable[][PxGeometryType::eGEOMETRY_COUNT];
 
-bool PxGeometryQuery::computePenetration(	PxVec3& mtd, PxF32& depth,
-											const PxGeometry& geom0, const PxTransform& pose0,
-											const PxGeometry& geom1, const PxTransform& pose1, PxGeometryQueryFlags queryFlags)
+static bool computePenetrationInternal(PxVec3& mtd, PxF32& depth, const PxGeometry& geom0, const PxTransform& pose0, const PxGeometry& geom1, const PxTransform& pose1, PxGjkQuery::Cache& cache)
 {
-	PX_SIMD_GUARD_CNDT(queryFlags & PxGeometryQueryFlag::eSIMD_GUARD)
-	PX_CHECK_AND_RETURN_VAL(pose0.isValid(), "PxGeometryQuery::computePenetration(): pose0 is not valid.", false);
-	PX_CHECK_AND_RETURN_VAL(pose1.isValid(), "PxGeometryQuery::computePenetration(): pose1 is not valid.", false);
+	// PT: the SAT-based MTD code for convex meshes can report small depths for objects that are a bit apart, so
+	// we confirm the overlap with GJK first. The cached and uncached versions both go through this test, to make
+	// sure they return the same results.
+	if(Gu::gjkSeparated(cache, geom0, pose0, geom1, pose1))
+		return false;
 
 	if(geom0.getType() > geom1.getType())
 	{
@@ -353,6 +353,30 @@ bool PxGeometryQuery::computePenetration(	PxVec3& mtd, PxF32& depth,
 	}
 }
 
+bool PxGeometryQuery::computePenetration(	PxVec3& mtd, PxF32& depth,
+											const PxGeometry& geom0, const PxTransform& pose0,
+											const PxGeometry& geom1, const PxTransform& pose1, PxGeometryQueryFlags queryFlags)
+{
+	PX_SIMD_GUARD_CNDT(queryFlags & PxGeometryQueryFlag::eSIMD_GUARD)
+	PX_CHECK_AND_RETURN_VAL(pose0.isValid(), "PxGeometryQuery::computePenetration(): pose0 is not valid.", false);
+	PX_CHECK_AND_RETURN_VAL(pose1.isValid(), "PxGeometryQuery::computePenetration(): pose1 is not valid.", false);
+
+	PxGjkQuery::Cache cache;
+	return computePenetrationInternal(mtd, depth, geom0, pose0, geom1, pose1, cache);
+}
+
+bool PxGeometryQuery::computePenetration(	PxVec3& mtd, PxF32& depth,
+											const PxGeometry& geom0, const PxTransform& pose0,
+											const PxGeometry& geom1, const PxTransform& pose1,
+											PxGjkQuery::Cache& cache, PxGeometryQueryFlags queryFlags)
+{
+	PX_SIMD_GUARD_CNDT(queryFlags & PxGeometryQueryFlag::eSIMD_GUARD)
+	PX_CHECK_AND_RETURN_VAL(pose0.isValid(), "PxGeometryQuery::computePenetration(): pose0 is not valid.", false);
+	PX_CHECK_AND_RETURN_VAL(pose1.isValid(), "PxGeometryQuery::computePenetration(): pose1 is not valid.", false);
+
+	return computePenetrationInternal(mtd, depth, geom0, pose0, geom1, pose1, cache);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 bool PxGeometryQuery::generateTriangleContacts(const PxGeometry& geom, const PxTransform& pose, const PxVec3 triangleVertices[3], PxU32 triangleIndex, PxReal contactDistance, PxReal meshContactMargin, PxReal toleranceLength, PxContactBuffer& contactBuffer)
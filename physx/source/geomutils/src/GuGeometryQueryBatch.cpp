@@ -0,0 +1,651 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "geometry/PxGeometryQuery.h"
+#include "geometry/PxSphereGeometry.h"
+#include "geometry/PxBoxGeometry.h"
+#include "geometry/PxCapsuleGeometry.h"
+#include "geometry/PxTriangleMeshGeometry.h"
+#include "geometry/PxMeshQuery.h"
+#include "foundation/PxFPU.h"
+#include "foundation/PxSIMDHelpers.h"
+
+#include "GuInternal.h"
+#include "GuOverlapTests.h"
+#include "GuRaycastTests.h"
+#include "GuBoxConversion.h"
+#include "GuMidphaseInterface.h"
+#include "GuSoAVec3.h"
+#include "GuIntersectionBatchSIMD.h"
+#include "GuDistancePointBatchSIMD.h"
+
+using namespace physx;
+using namespace Gu;
+using namespace aos;
+
+extern GeomOverlapTable gGeomOverlapMethodTable[];
+extern RaycastFunc gRaycastMap[PxGeometryType::eGEOMETRY_COUNT];
+
+// PT: batched versions of PxGeometryQuery functions. Queries against simple shapes are processed 4 at a time, one per
+// SIMD lane, using the SoA kernels from GuIntersectionBatchSIMD.h and GuDistancePointBatchSIMD.h. Other cases simply
+// loop over the regular code, with the function lookups done once per batch.
+
+///////////////////////////////////////////////////////////////////////////////
+
+static PX_FORCE_INLINE PxGeomRaycastHit& getHit(PxGeomRaycastHit* hits, PxU32 index, PxU32 stride)
+{
+	return *reinterpret_cast<PxGeomRaycastHit*>(reinterpret_cast<PxU8*>(hits) + index*stride);
+}
+
+static PX_FORCE_INLINE void setNoHit(PxGeomRaycastHit& hit)
+{
+	hit.distance	= PX_MAX_F32;
+	hit.faceIndex	= 0xffffffff;
+	hit.flags		= PxHitFlags(0);
+}
+
+static PxU32 raycastsSphere(PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, const PxSphereGeometry& sphereGeom, const PxTransform& pose,
+							PxReal maxDist, PxHitFlags hitFlags, PxGeomRaycastHit* rayHits, PxU32 stride)
+{
+	SoAVec3 center;
+	splatSoA(center, pose.p);
+	const Vec4V radius = V4Load(sphereGeom.radius);
+	const Vec4V maxDistV = V4Load(maxDist);
+
+	PxU32 nbHits = 0;
+	for(PxU32 i=0;i<nbRays;i+=4)
+	{
+		const PxU32 nb = PxMin<PxU32>(nbRays - i, 4);
+
+		SoAVec3 origin, dir;
+		loadSoA(origin, origins + i, nb);
+		loadSoA(dir, unitDirs + i, nb);
+
+		Vec4V distV;
+		SoAVec3 impacts;
+		const PxU32 mask = BGetBitMask(intersectRaySphereSoA(origin, dir, maxDistV, center, radius, distV, impacts));
+
+		PX_ALIGN(16, PxReal distances[4]);
+		V4StoreA(distV, distances);
+		PxVec3 positions[4];
+		storeSoA(positions, impacts, nb);
+
+		// PT: same output as raycast_sphere()
+		for(PxU32 j=0;j<nb;j++)
+		{
+			PxGeomRaycastHit& hit = getHit(rayHits, i+j, stride);
+			if(!(mask & (1<<j)))
+			{
+				setNoHit(hit);
+				continue;
+			}
+			nbHits++;
+
+			hit.distance	= distances[j];
+			hit.position	= positions[j];
+			hit.faceIndex	= 0xffffffff;
+			hit.u			= 0.0f;
+			hit.v			= 0.0f;
+
+			PxHitFlags outFlags = PxHitFlag::ePOSITION;
+			if(hitFlags & PxHitFlag::eNORMAL)
+			{
+				if(hit.distance == 0.0f)
+				{
+					hit.normal = -unitDirs[i+j];
+				}
+				else
+				{
+					hit.normal = hit.position - pose.p;
+					hit.normal.normalize();
+				}
+				outFlags |= PxHitFlag::eNORMAL;
+			}
+			else
+			{
+				hit.normal = PxVec3(0.0f);
+			}
+			hit.flags = outFlags;
+		}
+	}
+	return nbHits;
+}
+
+static PxU32 raycastsBox(	PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs, const PxBoxGeometry& boxGeom, const PxTransform& pose,
+							PxReal maxDist, PxHitFlags hitFlags, PxGeomRaycastHit* rayHits, PxU32 stride)
+{
+	Box box;
+	buildFrom(box, pose.p, boxGeom.halfExtents, pose.q);
+
+	SoAVec3 center, extents;
+	splatSoA(center, pose.p);
+	splatSoA(extents, boxGeom.halfExtents);
+	const Vec4V maxDistV = V4Load(maxDist);
+
+	PxU32 nbHits = 0;
+	for(PxU32 i=0;i<nbRays;i+=4)
+	{
+		const PxU32 nb = PxMin<PxU32>(nbRays - i, 4);
+
+		SoAVec3 origin, dir;
+		loadSoA(origin, origins + i, nb);
+		loadSoA(dir, unitDirs + i, nb);
+
+		// PT: move the rays to the box's local space
+		SoAVec3 localOrigin, localDir;
+		subSoA(localOrigin, origin, center);
+		rotateTransposeSoA(localOrigin, box.rot, localOrigin);
+		rotateTransposeSoA(localDir, box.rot, dir);
+
+		SoAVec3 localImpacts;
+		Vec4V tV;
+		BoolV planes[3];
+		const BoolV hitMask = rayAABBIntersect2SoA(extents, localOrigin, localDir, localImpacts, tV, planes);
+		const PxU32 mask = BGetBitMask(BAnd(hitMask, V4IsGrtrOrEq(maxDistV, tV)));
+
+		SoAVec3 impacts;
+		rotateSoA(impacts, box.rot, localImpacts);
+		impacts.x = V4Add(impacts.x, center.x);
+		impacts.y = V4Add(impacts.y, center.y);
+		impacts.z = V4Add(impacts.z, center.z);
+
+		PX_ALIGN(16, PxReal distances[4]);
+		V4StoreA(tV, distances);
+		PxVec3 positions[4], localPositions[4];
+		storeSoA(positions, impacts, nb);
+		storeSoA(localPositions, localImpacts, nb);
+		const PxU32 planeMasks[3] = { BGetBitMask(planes[0]), BGetBitMask(planes[1]), BGetBitMask(planes[2]) };
+
+		// PT: same output as raycast_box()
+		for(PxU32 j=0;j<nb;j++)
+		{
+			PxGeomRaycastHit& hit = getHit(rayHits, i+j, stride);
+			if(!(mask & (1<<j)))
+			{
+				setNoHit(hit);
+				continue;
+			}
+			nbHits++;
+
+			const PxReal t = distances[j];
+			hit.distance	= t;
+			hit.faceIndex	= 0xffffffff;
+			hit.u			= 0.0f;
+			hit.v			= 0.0f;
+
+			PxHitFlags outFlags = PxHitFlags(0);
+			if(hitFlags & PxHitFlag::ePOSITION)
+			{
+				outFlags |= PxHitFlag::ePOSITION;
+				hit.position = t!=0.0f ? positions[j] : origins[i+j];
+			}
+
+			if(hitFlags & PxHitFlag::eNORMAL)
+			{
+				outFlags |= PxHitFlag::eNORMAL;
+				if(t == 0.0f)
+				{
+					hit.normal = -unitDirs[i+j];
+				}
+				else
+				{
+					const PxU32 axis = (planeMasks[1] & (1<<j)) ? 1u : (planeMasks[2] & (1<<j)) ? 2u : 0u;
+					hit.normal = localPositions[j][axis] > 0.0f ? box.rot[axis] : -box.rot[axis];
+				}
+			}
+			else
+			{
+				hit.normal = PxVec3(0.0f);
+			}
+			hit.flags = outFlags;
+		}
+	}
+	return nbHits;
+}
+
+PxU32 PxGeometryQuery::raycasts(PxU32 nbRays, const PxVec3* origins, const PxVec3* unitDirs,
+								const PxGeometry& geom, const PxTransform& pose,
+								PxReal maxDist, PxHitFlags hitFlags, PxGeomRaycastHit* PX_RESTRICT rayHits, PxU32 stride,
+								PxGeometryQueryFlags queryFlags, PxRaycastThreadContext* threadContext)
+{
+	PX_SIMD_GUARD_CNDT(queryFlags & PxGeometryQueryFlag::eSIMD_GUARD)
+	PX_CHECK_AND_RETURN_VAL(pose.isValid(), "PxGeometryQuery::raycasts(): pose is not valid.", 0);
+	PX_CHECK_AND_RETURN_VAL(maxDist >= 0.0f, "PxGeometryQuery::raycasts(): maxDist is negative.", 0);
+	PX_CHECK_AND_RETURN_VAL(PxIsFinite(maxDist), "PxGeometryQuery::raycasts(): maxDist is not valid.", 0);
+#if PX_CHECKED
+	for(PxU32 i=0;i<nbRays;i++)
+	{
+		PX_CHECK_AND_RETURN_VAL(origins[i].isFinite(), "PxGeometryQuery::raycasts(): ray origin is not valid.", 0);
+		PX_CHECK_AND_RETURN_VAL(unitDirs[i].isFinite(), "PxGeometryQuery::raycasts(): ray direction is not valid.", 0);
+		PX_CHECK_AND_RETURN_VAL(PxAbs(unitDirs[i].magnitudeSquared()-1)<1e-4f, "PxGeometryQuery::raycasts(): ray direction must be unit vector.", 0);
+	}
+#endif
+	if(!nbRays)
+		return 0;
+
+	const PxGeometryType::Enum type = geom.getType();
+	if(type==PxGeometryType::eSPHERE)
+		return raycastsSphere(nbRays, origins, unitDirs, static_cast<const PxSphereGeometry&>(geom), pose, maxDist, hitFlags, rayHits, stride);
+
+	if(type==PxGeometryType::eBOX)
+		return raycastsBox(nbRays, origins, unitDirs, static_cast<const PxBoxGeometry&>(geom), pose, maxDist, hitFlags, rayHits, stride);
+
+	const RaycastFunc func = gRaycastMap[type];
+	PxU32 nbHits = 0;
+	for(PxU32 i=0;i<nbRays;i++)
+	{
+		PxGeomRaycastHit& hit = getHit(rayHits, i, stride);
+		if(func(geom, pose, origins[i], unitDirs[i], maxDist, hitFlags, 1, &hit, stride, threadContext))
+			nbHits++;
+		else
+			setNoHit(hit);
+	}
+	return nbHits;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// PT: loads the 'nb' (1 to 4) poses starting at 'poses' in SoA form. Unused lanes replicate the last pose.
+static PX_FORCE_INLINE void loadPosesSoA(SoAVec3& positions, Vec4V& qx, Vec4V& qy, Vec4V& qz, Vec4V& qw, const PxTransform* poses, PxU32 nb)
+{
+	loadSoA(positions, &poses->p, nb, sizeof(PxTransform));
+
+	Vec4V q0 = V4LoadU(&poses[0].q.x);
+	Vec4V q1 = nb>1 ? V4LoadU(&poses[1].q.x) : q0;
+	Vec4V q2 = nb>2 ? V4LoadU(&poses[2].q.x) : q1;
+	Vec4V q3 = nb>3 ? V4LoadU(&poses[3].q.x) : q2;
+	PX_TRANSPOSE_44(q0, q1, q2, q3, qx, qy, qz, qw);
+}
+
+static PX_FORCE_INLINE PxU32 storeOverlapResults(bool* results, PxU32 nb, const BoolV overlapMask)
+{
+	const PxU32 mask = BGetBitMask(overlapMask);
+	PxU32 nbOverlaps = 0;
+	for(PxU32 j=0;j<nb;j++)
+	{
+		const bool overlap = (mask & (1<<j))!=0;
+		results[j] = overlap;
+		nbOverlaps += PxU32(overlap);
+	}
+	return nbOverlaps;
+}
+
+// PT: see GeomOverlapCallback_SphereSphere
+static PxU32 overlapsSphereSphere(PxU32 nb, const PxSphereGeometry& sphereGeom0, const PxTransform* poses0, const PxSphereGeometry& sphereGeom1, const PxTransform& pose1, bool* results)
+{
+	SoAVec3 center1;
+	splatSoA(center1, pose1.p);
+	const PxReal r = sphereGeom0.radius + sphereGeom1.radius;
+	const Vec4V r2 = V4Load(r*r);
+
+	PxU32 nbOverlaps = 0;
+	for(PxU32 i=0;i<nb;i+=4)
+	{
+		const PxU32 nbInBatch = PxMin<PxU32>(nb - i, 4);
+
+		SoAVec3 center0, delta;
+		loadSoA(center0, &poses0[i].p, nbInBatch, sizeof(PxTransform));
+		subSoA(delta, center1, center0);
+
+		nbOverlaps += storeOverlapResults(results + i, nbInBatch, V4IsGrtrOrEq(r2, dotSoA(delta, delta)));
+	}
+	return nbOverlaps;
+}
+
+// PT: see GeomOverlapCallback_SphereCapsule
+static PxU32 overlapsSphereCapsule(PxU32 nb, const PxSphereGeometry& sphereGeom, const PxTransform* poses0, const PxCapsuleGeometry& capsuleGeom, const PxTransform& pose1, bool* results)
+{
+	const PxVec3 capsuleHalfHeightVector = getCapsuleHalfHeightVector(pose1, capsuleGeom);
+	const PxVec3 dir = -capsuleHalfHeightVector - capsuleHalfHeightVector;
+	SoAVec3 capsuleCenter;
+	splatSoA(capsuleCenter, pose1.p);
+	const PxReal r = sphereGeom.radius + capsuleGeom.radius;
+	const Vec4V r2 = V4Load(r*r);
+
+	PxU32 nbOverlaps = 0;
+	for(PxU32 i=0;i<nb;i+=4)
+	{
+		const PxU32 nbInBatch = PxMin<PxU32>(nb - i, 4);
+
+		SoAVec3 center0, localCenters;
+		loadSoA(center0, &poses0[i].p, nbInBatch, sizeof(PxTransform));
+		subSoA(localCenters, center0, capsuleCenter);
+
+		Vec4V param;
+		const Vec4V sqDist = distancePointSegmentSquaredSoA(capsuleHalfHeightVector, dir, localCenters, param);
+		nbOverlaps += storeOverlapResults(results + i, nbInBatch, V4IsGrtrOrEq(r2, sqDist));
+	}
+	return nbOverlaps;
+}
+
+// PT: see GeomOverlapCallback_SphereBox / intersectSphereBox
+static PxU32 overlapsSphereBox(PxU32 nb, const PxSphereGeometry& sphereGeom, const PxTransform* poses0, const PxBoxGeometry& boxGeom, const PxTransform& pose1, bool* results)
+{
+	Box obb;
+	buildFrom(obb, pose1.p, boxGeom.halfExtents, pose1.q);
+
+	SoAVec3 boxCenter;
+	splatSoA(boxCenter, obb.center);
+	const Vec4V r2 = V4Load(sphereGeom.radius * sphereGeom.radius);
+	const Vec4V zero = V4Zero();
+
+	PxU32 nbOverlaps = 0;
+	for(PxU32 i=0;i<nb;i+=4)
+	{
+		const PxU32 nbInBatch = PxMin<PxU32>(nb - i, 4);
+
+		SoAVec3 center0, delta, dRot;
+		loadSoA(center0, &poses0[i].p, nbInBatch, sizeof(PxTransform));
+		subSoA(delta, center0, boxCenter);
+		rotateTransposeSoA(dRot, obb.rot, delta);
+
+		// PT: clip delta to the box. The returned distance is only used to detect the clipped lanes.
+		SoAVec3 clipped;
+		const BoolV outside = V4IsGrtr(distancePointBoxSquaredSoA(dRot, obb.extents, clipped), zero);
+
+		SoAVec3 clippedDelta, clippedVec;
+		rotateSoA(clippedDelta, obb.rot, clipped);
+		subSoA(clippedVec, delta, clippedDelta);
+		const BoolV disjoint = BAnd(outside, V4IsGrtr(dotSoA(clippedVec, clippedVec), r2));
+
+		nbOverlaps += storeOverlapResults(results + i, nbInBatch, BNot(disjoint));
+	}
+	return nbOverlaps;
+}
+
+// PT: see GeomOverlapCallback_BoxBox
+static PxU32 overlapsBoxBox(PxU32 nb, const PxBoxGeometry& boxGeom0, const PxTransform* poses0, const PxBoxGeometry& boxGeom1, const PxTransform& pose1, bool* results)
+{
+	const PxMat33Padded rot1(pose1.q);
+
+	PxU32 nbOverlaps = 0;
+	for(PxU32 i=0;i<nb;i+=4)
+	{
+		const PxU32 nbInBatch = PxMin<PxU32>(nb - i, 4);
+
+		SoAVec3 center0;
+		Vec4V qx, qy, qz, qw;
+		loadPosesSoA(center0, qx, qy, qz, qw, poses0 + i, nbInBatch);
+
+		SoAVec3 rot0[3];
+		quatToMat33SoA(rot0, qx, qy, qz, qw);
+
+		nbOverlaps += storeOverlapResults(results + i, nbInBatch, intersectOBBOBBSoA(boxGeom0.halfExtents, center0, rot0, boxGeom1.halfExtents, pose1.p, rot1));
+	}
+	return nbOverlaps;
+}
+
+PxU32 PxGeometryQuery::overlaps(PxU32 nb, const PxGeometry& geom0, const PxTransform* poses0,
+								const PxGeometry& geom1, const PxTransform& pose1, bool* results,
+								PxGeometryQueryFlags queryFlags, PxOverlapThreadContext* threadContext)
+{
+	PX_SIMD_GUARD_CNDT(queryFlags & PxGeometryQueryFlag::eSIMD_GUARD)
+	PX_CHECK_AND_RETURN_VAL(pose1.isValid(), "PxGeometryQuery::overlaps(): pose1 is not valid.", 0);
+#if PX_CHECKED
+	for(PxU32 i=0;i<nb;i++)
+		PX_CHECK_AND_RETURN_VAL(poses0[i].isValid(), "PxGeometryQuery::overlaps(): poses0 contains an invalid pose.", 0);
+#endif
+	if(!nb)
+		return 0;
+
+	const PxGeometryType::Enum type0 = geom0.getType();
+	const PxGeometryType::Enum type1 = geom1.getType();
+	if(type0==PxGeometryType::eSPHERE)
+	{
+		const PxSphereGeometry& sphereGeom = static_cast<const PxSphereGeometry&>(geom0);
+		if(type1==PxGeometryType::eSPHERE)
+			return overlapsSphereSphere(nb, sphereGeom, poses0, static_cast<const PxSphereGeometry&>(geom1), pose1, results);
+		if(type1==PxGeometryType::eCAPSULE)
+			return overlapsSphereCapsule(nb, sphereGeom, poses0, static_cast<const PxCapsuleGeometry&>(geom1), pose1, results);
+		if(type1==PxGeometryType::eBOX)
+			return overlapsSphereBox(nb, sphereGeom, poses0, static_cast<const PxBoxGeometry&>(geom1), pose1, results);
+	}
+	else if(type0==PxGeometryType::eBOX && type1==PxGeometryType::eBOX)
+		return overlapsBoxBox(nb, static_cast<const PxBoxGeometry&>(geom0), poses0, static_cast<const PxBoxGeometry&>(geom1), pose1, results);
+
+	// PT: generic case, see Gu::overlap()
+	PxU32 nbOverlaps = 0;
+	if(type0 > type1)
+	{
+		const GeomOverlapFunc overlapFunc = gGeomOverlapMethodTable[type1][type0];
+		PX_ASSERT(overlapFunc);
+		for(PxU32 i=0;i<nb;i++)
+		{
+			results[i] = overlapFunc(geom1, pose1, geom0, poses0[i], NULL, threadContext);
+			nbOverlaps += PxU32(results[i]);
+		}
+	}
+	else
+	{
+		const GeomOverlapFunc overlapFunc = gGeomOverlapMethodTable[type0][type1];
+		PX_ASSERT(overlapFunc);
+		for(PxU32 i=0;i<nb;i++)
+		{
+			results[i] = overlapFunc(geom0, poses0[i], geom1, pose1, NULL, threadContext);
+			nbOverlaps += PxU32(results[i]);
+		}
+	}
+	return nbOverlaps;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// PT: writes the closest points of the lanes whose distance is not zero, like the scalar code does
+static PX_FORCE_INLINE void storeClosestPoints(PxVec3* closestPoints, PxU32 nb, const SoAVec3& points, const Vec4V sqDistances)
+{
+	const PxU32 mask = BGetBitMask(V4IsGrtr(sqDistances, V4Zero()));
+	PxVec3 tmp[4];
+	storeSoA(tmp, points, nb);
+	for(PxU32 j=0;j<nb;j++)
+	{
+		if(mask & (1<<j))
+			closestPoints[j] = tmp[j];
+	}
+}
+
+static PX_FORCE_INLINE void storeDistances(PxReal* sqDistances, PxU32 nb, const Vec4V sqDistancesV)
+{
+	PX_ALIGN(16, PxReal tmp[4]);
+	V4StoreA(sqDistancesV, tmp);
+	for(PxU32 j=0;j<nb;j++)
+		sqDistances[j] = tmp[j];
+}
+
+// PT: see the eSPHERE case in PxGeometryQuery::pointDistance()
+static void pointDistancesSphere(PxU32 nbPoints, const PxVec3* points, const PxSphereGeometry& sphereGeom, const PxTransform& pose, PxReal* sqDistances, PxVec3* closestPoints)
+{
+	SoAVec3 center;
+	splatSoA(center, pose.p);
+	const Vec4V r = V4Load(sphereGeom.radius);
+	const Vec4V zero = V4Zero();
+
+	for(PxU32 i=0;i<nbPoints;i+=4)
+	{
+		const PxU32 nb = PxMin<PxU32>(nbPoints - i, 4);
+
+		SoAVec3 p, delta;
+		loadSoA(p, points + i, nb);
+		subSoA(delta, p, center);
+
+		const Vec4V d = V4Sqrt(dotSoA(delta, delta));
+		const BoolV inside = V4IsGrtrOrEq(r, d);
+		const Vec4V dr = V4Sub(d, r);
+		const Vec4V sqDist = V4Sel(inside, zero, V4Mul(dr, dr));
+		storeDistances(sqDistances + i, nb, sqDist);
+
+		if(closestPoints)
+		{
+			const Vec4V invD = V4Recip(V4Sel(inside, V4One(), d));
+			SoAVec3 n, cp;
+			n.x = V4Mul(delta.x, invD);
+			n.y = V4Mul(delta.y, invD);
+			n.z = V4Mul(delta.z, invD);
+			addScaledSoA(cp, center, n, r);
+			storeClosestPoints(closestPoints + i, nb, cp, sqDist);
+		}
+	}
+}
+
+// PT: see the eCAPSULE case in PxGeometryQuery::pointDistance()
+static void pointDistancesCapsule(PxU32 nbPoints, const PxVec3* points, const PxCapsuleGeometry& capsGeom, const PxTransform& pose, PxReal* sqDistances, PxVec3* closestPoints)
+{
+	Capsule capsule;
+	getCapsule(capsule, capsGeom, pose);
+	const PxVec3 dir = capsule.p1 - capsule.p0;
+	const Vec4V r = V4Load(capsGeom.radius);
+	const Vec4V r2 = V4Load(capsGeom.radius * capsGeom.radius);
+	const Vec4V zero = V4Zero();
+
+	for(PxU32 i=0;i<nbPoints;i+=4)
+	{
+		const PxU32 nb = PxMin<PxU32>(nbPoints - i, 4);
+
+		SoAVec3 p;
+		loadSoA(p, points + i, nb);
+
+		Vec4V param;
+		const Vec4V segSqDist = distancePointSegmentSquaredSoA(capsule.p0, dir, p, param);
+		const BoolV inside = V4IsGrtrOrEq(r2, segSqDist);
+		const Vec4V d = V4Sqrt(segSqDist);
+		const Vec4V dr = V4Sub(d, r);
+		const Vec4V sqDist = V4Sel(inside, zero, V4Mul(dr, dr));
+		storeDistances(sqDistances + i, nb, sqDist);
+
+		if(closestPoints)
+		{
+			SoAVec3 p0, dirV, cp, delta;
+			splatSoA(p0, capsule.p0);
+			splatSoA(dirV, dir);
+			addScaledSoA(cp, p0, dirV, param);
+			subSoA(delta, p, cp);
+			const Vec4V invLength = V4Recip(V4Sel(inside, V4One(), V4Sqrt(dotSoA(delta, delta))));
+			delta.x = V4Mul(delta.x, invLength);
+			delta.y = V4Mul(delta.y, invLength);
+			delta.z = V4Mul(delta.z, invLength);
+			addScaledSoA(cp, cp, delta, r);
+			storeClosestPoints(closestPoints + i, nb, cp, sqDist);
+		}
+	}
+}
+
+// PT: see the eBOX case in PxGeometryQuery::pointDistance()
+static void pointDistancesBox(PxU32 nbPoints, const PxVec3* points, const PxBoxGeometry& boxGeom, const PxTransform& pose, PxReal* sqDistances, PxVec3* closestPoints)
+{
+	Box obb;
+	buildFrom(obb, pose.p, boxGeom.halfExtents, pose.q);
+
+	SoAVec3 center;
+	splatSoA(center, obb.center);
+
+	for(PxU32 i=0;i<nbPoints;i+=4)
+	{
+		const PxU32 nb = PxMin<PxU32>(nbPoints - i, 4);
+
+		SoAVec3 p, localPoints;
+		loadSoA(p, points + i, nb);
+		subSoA(localPoints, p, center);
+		rotateTransposeSoA(localPoints, obb.rot, localPoints);
+
+		SoAVec3 boxParam;
+		const Vec4V sqDist = distancePointBoxSquaredSoA(localPoints, obb.extents, boxParam);
+		storeDistances(sqDistances + i, nb, sqDist);
+
+		if(closestPoints)
+		{
+			SoAVec3 cp;
+			rotateSoA(cp, obb.rot, boxParam);
+			cp.x = V4Add(cp.x, center.x);
+			cp.y = V4Add(cp.y, center.y);
+			cp.z = V4Add(cp.z, center.z);
+			storeClosestPoints(closestPoints + i, nb, cp, sqDist);
+		}
+	}
+}
+
+// PT: loops over the regular single-point function
+static void pointDistancesGeneric(	PxU32 nbPoints, const PxVec3* points, const PxGeometry& geom, const PxTransform& pose,
+									PxReal* sqDistances, PxVec3* closestPoints, PxU32* closestIndices, PxGeometryQueryFlags queryFlags)
+{
+	// PT: the SIMD guard, if any, is already active
+	const PxGeometryQueryFlags flags = queryFlags & ~PxGeometryQueryFlag::eSIMD_GUARD;
+	for(PxU32 i=0;i<nbPoints;i++)
+		sqDistances[i] = PxGeometryQuery::pointDistance(points[i], geom, pose, closestPoints ? closestPoints + i : NULL, closestIndices ? closestIndices + i : NULL, flags);
+}
+
+// PT: uses the multi-point midphase, see PxMeshQuery::pointDistances()
+static void pointDistancesMesh(	PxU32 nbPoints, const PxVec3* points, const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose,
+								PxReal* sqDistances, PxVec3* closestPoints, PxU32* closestIndices, PxGeometryQueryFlags queryFlags)
+{
+	const TriangleMesh* mesh = static_cast<const TriangleMesh*>(meshGeom.triangleMesh);
+	// PT: the multi-point midphase reports world-space distances, which only match pointDistance() for identity scales
+	if(mesh->getConcreteType()!=PxConcreteType::eTRIANGLE_MESH_BVH34 || !meshGeom.scale.isIdentity())
+	{
+		pointDistancesGeneric(nbPoints, points, meshGeom, pose, sqDistances, closestPoints, closestIndices, queryFlags);
+		return;
+	}
+
+	PxMeshClosestPoint* results = PX_ALLOCATE(PxMeshClosestPoint, nbPoints, "PxMeshClosestPoint");
+	Midphase::pointMeshDistances(mesh, meshGeom, pose, nbPoints, points, PX_MAX_F32, results, NULL);
+	for(PxU32 i=0;i<nbPoints;i++)
+	{
+		sqDistances[i] = results[i].distance * results[i].distance;
+		if(closestPoints)
+			closestPoints[i] = results[i].position;
+		if(closestIndices)
+			closestIndices[i] = results[i].faceIndex;
+	}
+	PX_FREE(results);
+}
+
+void PxGeometryQuery::pointDistances(	PxU32 nbPoints, const PxVec3* points, const PxGeometry& geom, const PxTransform& pose,
+										PxReal* sqDistances, PxVec3* closestPoints, PxU32* closestIndices, PxGeometryQueryFlags queryFlags)
+{
+	PX_SIMD_GUARD_CNDT(queryFlags & PxGeometryQueryFlag::eSIMD_GUARD)
+	PX_CHECK_AND_RETURN(pose.isValid(), "PxGeometryQuery::pointDistances(): pose is not valid.");
+	if(!nbPoints)
+		return;
+
+	switch(geom.getType())
+	{
+		case PxGeometryType::eSPHERE:
+			pointDistancesSphere(nbPoints, points, static_cast<const PxSphereGeometry&>(geom), pose, sqDistances, closestPoints);
+			break;
+		case PxGeometryType::eCAPSULE:
+			pointDistancesCapsule(nbPoints, points, static_cast<const PxCapsuleGeometry&>(geom), pose, sqDistances, closestPoints);
+			break;
+		case PxGeometryType::eBOX:
+			pointDistancesBox(nbPoints, points, static_cast<const PxBoxGeometry&>(geom), pose, sqDistances, closestPoints);
+			break;
+		case PxGeometryType::eTRIANGLEMESH:
+			pointDistancesMesh(nbPoints, points, static_cast<const PxTriangleMeshGeometry&>(geom), pose, sqDistances, closestPoints, closestIndices, queryFlags);
+			break;
+		default:
+			pointDistancesGeneric(nbPoints, points, geom, pose, sqDistances, closestPoints, closestIndices, queryFlags);
+			break;
+	}
+}
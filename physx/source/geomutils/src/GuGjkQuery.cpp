@@ -27,6 +27,10 @@
 // Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
 
 #include "geometry/PxGjkQuery.h"
+#include "geometry/PxSphereGeometry.h"
+#include "geometry/PxCapsuleGeometry.h"
+#include "geometry/PxBoxGeometry.h"
+#include "geometry/PxConvexMeshGeometry.h"
 
 #include "GuInternal.h"
 #include "GuOverlapTests.h"
@@ -49,6 +53,7 @@ using namespace Gu;
 #include "GuGJKPenetration.h"
 #include "GuGJKRaycast.h"
 #include "GuEPA.h"
+#include "GuVecConvexHull.h"
 #include "geomutils/PxContactBuffer.h"
 
 using namespace aos;
@@ -70,15 +75,19 @@ static PX_SUPPORT_INLINE PxReal FloatV_To_PxReal(const FloatV& a)
 struct CustomConvexV : ConvexV
 {
 	const PxGjkQuery::Support* s;
+	const PxVec3* warmStartPoints;	// PT: simplex vertices from a PxGjkQuery::Cache, in local space
 	PxReal supportScale;
 
-	CustomConvexV(const PxGjkQuery::Support& _s) : ConvexV(Gu::ConvexType::eCUSTOM), s(&_s), supportScale(1.0f)
+	CustomConvexV(const PxGjkQuery::Support& _s) : ConvexV(Gu::ConvexType::eCUSTOM), s(&_s), warmStartPoints(NULL), supportScale(1.0f)
 	{
 		setMinMargin(FLoad(0.001f));
 		setSweepMargin(FLoad(0.001f));
 	}
-	PX_SUPPORT_INLINE Vec3V supportPoint(const PxI32 /*index*/) const
+	// PT: only used to warm-start GJK, in which case 'index' is the index of a cached simplex vertex
+	PX_SUPPORT_INLINE Vec3V supportPoint(const PxI32 index) const
 	{
+		if(warmStartPoints)
+			return V3LoadU(warmStartPoints[index]);
 		return supportLocal(V3LoadU(PxVec3(1, 0, 0)));
 	}
 	PX_SUPPORT_INLINE Vec3V supportLocal(const Vec3V& dir) const
@@ -103,20 +112,75 @@ struct CustomConvexV : ConvexV
 	}
 };
 
-bool PxGjkQuery::proximityInfo(const Support& a, const Support& b, const PxTransform& poseA, const PxTransform& poseB, PxReal contactDistance, PxReal toleranceLength, PxVec3& pointA, PxVec3& pointB, PxVec3& separatingAxis, PxReal& separation)
+// PT: runs gjkPenetration(), optionally warm-started with the simplex stored in the cache. The cache is then updated with
+// the new simplex, except when GJK degenerated: the retry uses slightly shrunk shapes, whose simplex is not worth caching.
+static GjkStatus gjkPenetrationCached(CustomConvexV& supportA, CustomConvexV& supportB, const PxMatTransformV& aToB, const FloatV contactDist,
+	PxGjkQuery::Cache* cache, Vec3V* aPoints, Vec3V* bPoints, PxU8& size, GjkOutput& output)
+{
+	const RelativeConvex<CustomConvexV> convexA(supportA, aToB);
+	const LocalConvex<CustomConvexV> convexB(supportB);
+	const Vec3V initialSearchDir = aToB.p;
+	const PxReal degenerateScale = 0.001f;
+
+	// PT: cached vertices are local to each shape, so they are still points of the Minkowski difference after the shapes
+	// moved. The indices are the indices of the cached vertices, see CustomConvexV::supportPoint().
+	PxU8 aIndices[4] = { 0, 1, 2, 3 };
+	PxU8 bIndices[4] = { 0, 1, 2, 3 };
+	size = 0;
+	if(cache && cache->size)
+	{
+		supportA.warmStartPoints = cache->pointsA;
+		supportB.warmStartPoints = cache->pointsB;
+		size = PxU8(cache->size);
+	}
+
+	GjkStatus status = gjkPenetration(convexA, convexB, initialSearchDir, contactDist, true, aIndices, bIndices, aPoints, bPoints, size, output);
+	if(supportA.warmStartPoints)
+	{
+		supportA.warmStartPoints = supportB.warmStartPoints = NULL;
+
+		// PT: a stale simplex can make GJK degenerate where a cold start would not. Retry from scratch before shrinking the
+		// shapes, otherwise we would return different results than the uncached queries.
+		if(status == GJK_DEGENERATE)
+		{
+			size = 0;
+			status = gjkPenetration(convexA, convexB, initialSearchDir, contactDist, true, aIndices, bIndices, aPoints, bPoints, size, output);
+		}
+	}
+
+	if (status == GJK_DEGENERATE)
+	{
+		supportA.supportScale = supportB.supportScale = 1.0f - degenerateScale;
+		size = 0;
+		status = gjkPenetration(convexA, convexB, initialSearchDir, contactDist, true, aIndices, bIndices, aPoints, bPoints, size, output);
+		supportA.supportScale = supportB.supportScale = 1.0f;
+		if(cache)
+			cache->size = 0;
+	}
+	else if(cache)
+	{
+		for(PxU32 i=0;i<size;i++)
+		{
+			V3StoreU(aToB.transformInv(aPoints[i]), cache->pointsA[i]);
+			V3StoreU(bPoints[i], cache->pointsB[i]);
+		}
+		cache->size = size;
+	}
+	return status;
+}
+
+static bool proximityInfoInternal(const PxGjkQuery::Support& a, const PxGjkQuery::Support& b, const PxTransform& poseA, const PxTransform& poseB, PxReal contactDistance, PxReal toleranceLength, PxVec3& pointA, PxVec3& pointB, PxVec3& separatingAxis, PxReal& separation, PxGjkQuery::Cache* cache)
 {
 	const PxTransformV transf0 = loadTransformU(poseA);
 	const PxTransformV transf1 = loadTransformU(poseB);
 	const PxTransformV curRTrans(transf1.transformInv(transf0));
 	const PxMatTransformV aToB(curRTrans);
-	const PxReal degenerateScale = 0.001f;
 
 	CustomConvexV supportA(a);
 	CustomConvexV supportB(b);
 	const RelativeConvex<CustomConvexV> convexA(supportA, aToB);
 	const LocalConvex<CustomConvexV> convexB(supportB);
 
-	Vec3V initialSearchDir = aToB.p;
 	FloatV contactDist = FLoad((a.getMargin() + b.getMargin()) + contactDistance);
 
 	Vec3V aPoints[4];
@@ -124,14 +188,7 @@ bool PxGjkQuery::proximityInfo(const Support& a, const Support& b, const PxTrans
 	PxU8 size = 0;
 	GjkOutput output;
 
-	GjkStatus status = gjkPenetration(convexA, convexB, initialSearchDir, contactDist, true, aPoints, bPoints, size, output);
-
-	if (status == GJK_DEGENERATE)
-	{
-		supportA.supportScale = supportB.supportScale = 1.0f - degenerateScale;
-		status = gjkPenetration(convexA, convexB, initialSearchDir, contactDist, true, aPoints, bPoints, size, output);
-		supportA.supportScale = supportB.supportScale = 1.0f;
-	}
+	GjkStatus status = gjkPenetrationCached(supportA, supportB, aToB, contactDist, cache, aPoints, bPoints, size, output);
 
 	if (status == GJK_CONTACT || status == GJK_DEGENERATE)
 	{
@@ -159,6 +216,33 @@ bool PxGjkQuery::proximityInfo(const Support& a, const Support& b, const PxTrans
 	return false;
 }
 
+bool PxGjkQuery::proximityInfo(const Support& a, const Support& b, const PxTransform& poseA, const PxTransform& poseB, PxReal contactDistance, PxReal toleranceLength, PxVec3& pointA, PxVec3& pointB, PxVec3& separatingAxis, PxReal& separation)
+{
+	return proximityInfoInternal(a, b, poseA, poseB, contactDistance, toleranceLength, pointA, pointB, separatingAxis, separation, NULL);
+}
+
+bool PxGjkQuery::proximityInfo(const Support& a, const Support& b, const PxTransform& poseA, const PxTransform& poseB, PxReal contactDistance, PxReal toleranceLength, PxVec3& pointA, PxVec3& pointB, PxVec3& separatingAxis, PxReal& separation, Cache& cache)
+{
+	return proximityInfoInternal(a, b, poseA, poseB, contactDistance, toleranceLength, pointA, pointB, separatingAxis, separation, &cache);
+}
+
+PxU32 PxGjkQuery::proximityInfos(PxU32 nbPairs, const Pair* pairs, PxReal contactDistance, PxReal toleranceLength, ProximityInfo* results, Cache* caches)
+{
+	// PT: the support functions are user callbacks, evaluated one pair at a time anyway, and the scalar GJK typically converges in
+	// a couple of iterations (or a single one when warm-started), so we simply run the regular code for each pair.
+	PxU32 nbHits = 0;
+	for(PxU32 i=0;i<nbPairs;i++)
+	{
+		const Pair& pair = pairs[i];
+		ProximityInfo& result = results[i];
+		result.hit = proximityInfoInternal(*pair.a, *pair.b, pair.poseA, pair.poseB, contactDistance, toleranceLength,
+			result.pointA, result.pointB, result.separatingAxis, result.separation, caches ? caches + i : NULL);
+		if(result.hit)
+			nbHits++;
+	}
+	return nbHits;
+}
+
 struct PointConvexV : ConvexV
 {
 	Vec3V zero;
@@ -245,6 +329,30 @@ bool PxGjkQuery::overlap(const Support& a, const Support& b, const PxTransform&
 	return status == GJK_CLOSE || status == GJK_CONTACT;
 }
 
+bool PxGjkQuery::overlap(const Support& a, const Support& b, const PxTransform& poseA, const PxTransform& poseB, Cache& cache)
+{
+	const PxTransformV transf0 = loadTransformU(poseA);
+	const PxTransformV transf1 = loadTransformU(poseB);
+	const PxTransformV curRTrans(transf1.transformInv(transf0));
+	const PxMatTransformV aToB(curRTrans);
+
+	CustomConvexV supportA(a);
+	CustomConvexV supportB(b);
+
+	const FloatV contactDist = FLoad(a.getMargin() + b.getMargin());
+	Vec3V aPoints[4];
+	Vec3V bPoints[4];
+	PxU8 size = 0;
+	GjkOutput output;
+	const GjkStatus status = gjkPenetrationCached(supportA, supportB, aToB, contactDist, &cache, aPoints, bPoints, size, output);
+
+	// PT: for degenerate cases, output.penDep is the distance between the cores
+	if(status == GJK_DEGENERATE)
+		return FAllGrtrOrEq(contactDist, output.penDep) != 0;
+
+	return status != GJK_NON_INTERSECT;
+}
+
 bool PxGjkQuery::sweep(const Support& a, const Support& b, const PxTransform& poseA, const PxTransform& poseB, const PxVec3& unitDir, PxReal maxDist, PxReal& t, PxVec3& n, PxVec3& p)
 {
 	const PxTransformV transf0 = loadTransformU(poseA);
@@ -275,3 +383,89 @@ bool PxGjkQuery::sweep(const Support& a, const Support& b, const PxTransform& po
 	return false;
 }
 
+namespace
+{
+	// PT: support mappings of the convex geometries, for the warm-started separation test in computePenetration(). Spheres
+	// and capsules are a point and a segment with a margin. Boxes and convex meshes have no margin.
+	class GeomSupport : public PxGjkQuery::Support
+	{
+	public:
+		GeomSupport(const PxGeometry& geom) : mType(geom.getType()), mMargin(0.0f)
+		{
+			switch(mType)
+			{
+				case PxGeometryType::eSPHERE:
+					mMargin = static_cast<const PxSphereGeometry&>(geom).radius;
+					mExtents = PxVec3(0.0f);
+					break;
+				case PxGeometryType::eCAPSULE:
+				{
+					const PxCapsuleGeometry& capsuleGeom = static_cast<const PxCapsuleGeometry&>(geom);
+					mMargin = capsuleGeom.radius;
+					mExtents = PxVec3(capsuleGeom.halfHeight, 0.0f, 0.0f);
+				}
+				break;
+				case PxGeometryType::eBOX:
+					mExtents = static_cast<const PxBoxGeometry&>(geom).halfExtents;
+					break;
+				case PxGeometryType::eCONVEXMESH:
+					PX_PLACEMENT_NEW(&mHull, ConvexHullV)(geom);
+					break;
+				default:
+					PX_ASSERT(0);
+			}
+		}
+
+		virtual PxReal getMargin() const
+		{
+			return mMargin;
+		}
+
+		virtual PxVec3 supportLocal(const PxVec3& dir) const
+		{
+			if(mType == PxGeometryType::eCONVEXMESH)
+				return Vec3V_To_PxVec3(mHull.supportLocal(V3LoadU(dir)));
+
+			return PxVec3(PxSign2(dir.x) * mExtents.x, PxSign2(dir.y) * mExtents.y, PxSign2(dir.z) * mExtents.z);
+		}
+
+		ConvexHullV				mHull;
+		PxVec3					mExtents;
+		PxGeometryType::Enum	mType;
+		PxReal					mMargin;
+	};
+
+	PX_FORCE_INLINE bool isConvexGeom(PxGeometryType::Enum type)
+	{
+		return type == PxGeometryType::eSPHERE || type == PxGeometryType::eCAPSULE || type == PxGeometryType::eBOX || type == PxGeometryType::eCONVEXMESH;
+	}
+}
+
+bool Gu::gjkSeparated(PxGjkQuery::Cache& cache, const PxGeometry& geom0, const PxTransform& pose0, const PxGeometry& geom1, const PxTransform& pose1)
+{
+	// PT: the MTD functions for pairs of primitives are cheaper than GJK, so we only do this for convex meshes
+	const PxGeometryType::Enum type0 = geom0.getType();
+	const PxGeometryType::Enum type1 = geom1.getType();
+	if(!isConvexGeom(type0) || !isConvexGeom(type1))
+		return false;
+	if(type0 != PxGeometryType::eCONVEXMESH && type1 != PxGeometryType::eCONVEXMESH)
+		return false;
+
+	const GeomSupport a(geom0);
+	const GeomSupport b(geom1);
+
+	const PxTransformV transf0 = loadTransformU(pose0);
+	const PxTransformV transf1 = loadTransformU(pose1);
+	const PxTransformV curRTrans(transf1.transformInv(transf0));
+	const PxMatTransformV aToB(curRTrans);
+
+	CustomConvexV supportA(a);
+	CustomConvexV supportB(b);
+
+	const FloatV contactDist = FLoad(a.getMargin() + b.getMargin());
+	Vec3V aPoints[4];
+	Vec3V bPoints[4];
+	PxU8 size = 0;
+	GjkOutput output;
+	return gjkPenetrationCached(supportA, supportB, aToB, contactDist, &cache, aPoints, bPoints, size, output) == GJK_NON_INTERSECT;
+}
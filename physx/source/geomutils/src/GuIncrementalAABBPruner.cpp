@@ -253,6 +253,20 @@ bool IncrementalAABBPruner::overlap(const ShapeData& queryVolume, PrunerOverlapC
 	return again;
 }
 
+bool IncrementalAABBPruner::cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& pcbArgName) const
+{
+	bool again = true;
+
+	if(mAABBTree && mAABBTree->getNodes())
+	{
+		OverlapCallbackAdapter pcb(pcbArgName, mPool);
+		const PlanesAABBTest test(nbPlanes, planes);
+		again = AABBTreeCull<true, IncrementalAABBTree, IncrementalAABBTreeNode, OverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, test, pcb);
+	}
+
+	return again;
+}
+
 bool IncrementalAABBPruner::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& pcbArgName) const
 {
 	bool again = true;
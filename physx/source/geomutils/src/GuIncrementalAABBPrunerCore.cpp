@@ -43,10 +43,6 @@ using namespace Gu;
 
 #define PARANOIA_CHECKS 0
 
-// PT: TODO: this is copied from SqBounds.h, should be either moved to Gu and shared or passed as a user parameter
-	#define SQ_PRUNER_EPSILON	0.005f
-	#define SQ_PRUNER_INFLATION	(1.0f + SQ_PRUNER_EPSILON)	// pruner test shape inflation (not narrow phase shape)
-
 IncrementalAABBPrunerCore::IncrementalAABBPrunerCore(const PruningPool* pool) :
 	mCurrentTree	(1),
 	mLastTree		(0),
@@ -318,6 +314,22 @@ bool IncrementalAABBPrunerCore::overlap(const ShapeData& queryVolume, PrunerOver
 	return again;
 }
 
+bool IncrementalAABBPrunerCore::cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& pcbArgName) const
+{
+	bool again = true;
+	OverlapCallbackAdapter pcb(pcbArgName, *mPool);
+
+	const PlanesAABBTest test(nbPlanes, planes);
+	for(PxU32 i = 0; i < NUM_TREES; i++)
+	{
+		const CoreTree& tree = mAABBTree[i];
+		if(tree.tree && tree.tree->getNodes() && again)
+			again = AABBTreeCull<true, IncrementalAABBTree, IncrementalAABBTreeNode, OverlapCallbackAdapter>()(mPool->getCurrentAABBTreeBounds(), *tree.tree, test, pcb);
+	}
+
+	return again;
+}
+
 bool IncrementalAABBPrunerCore::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& pcbArgName) const
 {
 	bool again = true;
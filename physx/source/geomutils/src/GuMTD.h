@@ -31,6 +31,7 @@
 
 #include "foundation/PxVec3.h"
 #include "geometry/PxGeometry.h"
+#include "geometry/PxGjkQuery.h"
 
 namespace physx
 {
@@ -55,6 +56,10 @@ namespace Gu
 	// \note		depenetration vector D is equal to mtd * depth. It should be applied to the 1st object, to get out of the 2nd object.
 	typedef bool (*GeomMTDFunc)	(GU_MTD_FUNC_PARAMS);
 
+	// PT: warm-started GJK separation test for PxGeometryQuery::computePenetration(), implemented in GuGjkQuery.cpp.
+	// Returns true if the objects are separated. Returns false if they overlap, or if the pair of geometries is not supported.
+	bool gjkSeparated(PxGjkQuery::Cache& cache, const PxGeometry& geom0, const PxTransform& pose0, const PxGeometry& geom1, const PxTransform& pose1);
+
 	PX_FORCE_INLINE PxF32 manualNormalize(PxVec3& mtd, const PxVec3& normal, PxReal lenSq)
 	{
 		const PxF32 len = PxSqrt(lenSq);
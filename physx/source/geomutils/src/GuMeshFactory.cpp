@@ -31,6 +31,8 @@
 #include "GuMeshFactory.h"
 #include "GuTriangleMeshBV4.h"
 #include "GuTriangleMeshRTree.h"
+#include "GuTriangleMeshInPlace.h"
+#include "GuBV4_Common.h"
 #include "GuTetrahedronMesh.h"
 #include "GuConvexMesh.h"
 #include "GuBVH.h"
@@ -501,6 +503,217 @@ PxTriangleMesh* MeshFactory::createTriangleMesh(PxInputStream& desc)
 	return m;
 }
 
+static bool checkInPlaceArray(const InPlaceTriangleMeshHeader& header, PxU32 offset, PxU64 sizeInBytes)
+{
+	if(!offset)
+		return true;
+	if(offset<sizeof(InPlaceTriangleMeshHeader) || (offset & (GU_IN_PLACE_MESH_ALIGNMENT-1)))
+		return false;
+	return PxU64(offset) + sizeInBytes <= PxU64(header.mTotalSize);
+}
+
+template<class IndexT>
+static bool checkInPlaceIndices(const IndexT* indices, PxU32 nbIndices, PxU32 nbVerts)
+{
+	for(PxU32 i=0;i<nbIndices;i++)
+	{
+		if(indices[i]>=nbVerts)
+			return false;
+	}
+	return true;
+}
+
+// PT: the BV4 traversal code follows node links and primitive indices without checks, so we make sure once here that they
+// stay within the image. This uses the same encoding as the queries (see GuBV4_Slabs_SwizzledNoOrder.h). The cooker always
+// stores children after their parent, which rules out cycles, and we also limit the number of visited nodes and the depth
+// of the tree so that shared subtrees cannot make this too slow, and deep trees cannot overflow the queries' stacks.
+template<class SwizzledNodeT>
+static bool checkInPlaceBV4Tree(const void* treeNodes, PxU32 nbNodes, PxU32 initData, PxU32 nbTris)
+{
+	if(!nbNodes)
+		return true;	// PT: no tree, the queries test all triangles
+
+	// PT: each swizzled node uses the space of 4 packed nodes
+	if(nbNodes & 3)
+		return false;
+
+	const PxU32 maxDepth = (GU_BV4_STACK_SIZE - 1)/3;
+	PxU32 nbVisitsLeft = nbNodes/4;
+
+	struct Entry
+	{
+		PxU32	mData;
+		PxU32	mMinOffset;
+		PxU32	mDepth;
+	};
+	Entry stack[GU_BV4_STACK_SIZE];
+	stack[0].mData		= initData;
+	stack[0].mMinOffset	= 0;
+	stack[0].mDepth		= 1;
+	PxU32 nb = 1;
+
+	const SwizzledNodeT* nodes = reinterpret_cast<const SwizzledNodeT*>(treeNodes);
+	do
+	{
+		const Entry entry = stack[--nb];
+		const PxU32 offset = getChildOffset(entry.mData);
+		if((offset & 3) || offset<entry.mMinOffset || PxU64(offset) + 4 > PxU64(nbNodes) || !nbVisitsLeft--)
+			return false;
+
+		const SwizzledNodeT& node = nodes[offset/4];
+		const PxU32 nodeType = getChildType(entry.mData);
+		const PxU32 nbChildren = nodeType>1 ? 4 : nodeType+2;
+		for(PxU32 i=0;i<nbChildren;i++)
+		{
+			if(node.isLeaf(i))
+			{
+				PxU32 primIndex = node.getPrimitive(i);
+				const PxU32 nbPrims = (primIndex & 15);
+				primIndex >>= 4;
+				if(!nbPrims || PxU64(primIndex) + nbPrims > PxU64(nbTris))
+					return false;
+			}
+			else
+			{
+				if(entry.mDepth==maxDepth || nb==GU_BV4_STACK_SIZE)
+					return false;
+				stack[nb].mData			= node.getChildData(i);
+				stack[nb].mMinOffset	= offset + 4;
+				stack[nb].mDepth		= entry.mDepth + 1;
+				nb++;
+			}
+		}
+	}while(nb);
+	return true;
+}
+
+// PT: sets up 'data' so that all its arrays point into the image. Nothing is allocated or copied here.
+static bool loadInPlaceMeshData(BV4TriangleData& data, const void* memory, PxU32 size)
+{
+	if(!memory || (size_t(memory) & (GU_IN_PLACE_MESH_ALIGNMENT-1)))
+		return outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "Loading in-place triangle mesh failed: memory must be 16-byte aligned.");
+
+	if(size<sizeof(InPlaceTriangleMeshHeader))
+		return outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "Loading in-place triangle mesh failed: invalid image size.");
+
+	const InPlaceTriangleMeshHeader& header = *reinterpret_cast<const InPlaceTriangleMeshHeader*>(memory);
+	if(header.mTag!=computeInPlaceMeshTag())
+		return outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "Loading in-place triangle mesh failed: invalid tag or platform mismatch.");
+
+	if(header.mVersion!=GU_IN_PLACE_MESH_VERSION)
+		return outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "Loading in-place triangle mesh failed: unsupported version. Please recook the mesh.");
+
+	const PxU64 nbTris = header.mNbTriangles;
+	const PxU64 indexSize = (header.mFlags & PxTriangleMeshFlag::e16_BIT_INDICES) ? sizeof(PxU16) : sizeof(PxU32);
+	const PxU64 nodeSize = header.mQuantized ? sizeof(BVDataPackedQ) : sizeof(BVDataPackedNQ);
+	if(header.mTotalSize>size || !header.mVerticesOffset || !header.mTrianglesOffset || !header.mNodesOffset
+		|| !checkInPlaceArray(header, header.mVerticesOffset, (PxU64(header.mNbVertices)+1)*sizeof(PxVec3))
+		|| !checkInPlaceArray(header, header.mTrianglesOffset, nbTris*3*indexSize)
+		|| !checkInPlaceArray(header, header.mExtraTrigDataOffset, nbTris*sizeof(PxU8))
+		|| !checkInPlaceArray(header, header.mMaterialIndicesOffset, nbTris*sizeof(PxU16))
+		|| !checkInPlaceArray(header, header.mFaceRemapOffset, nbTris*sizeof(PxU32))
+		|| !checkInPlaceArray(header, header.mAdjacenciesOffset, nbTris*3*sizeof(PxU32))
+		|| !checkInPlaceArray(header, header.mNodesOffset, PxU64(header.mNbNodes)*nodeSize))
+		return outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "Loading in-place triangle mesh failed: corrupted image.");
+
+	// PT: the queries trust the triangle indices and the tree, so we check them before 'data' references the image
+	{
+		const PxU8* base = reinterpret_cast<const PxU8*>(memory);
+		const PxU32 nbIndices = header.mNbTriangles*3;
+		if((header.mFlags & PxTriangleMeshFlag::e16_BIT_INDICES) ?	!checkInPlaceIndices(reinterpret_cast<const PxU16*>(base + header.mTrianglesOffset), nbIndices, header.mNbVertices)
+																:	!checkInPlaceIndices(reinterpret_cast<const PxU32*>(base + header.mTrianglesOffset), nbIndices, header.mNbVertices))
+			return outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "Loading in-place triangle mesh failed: triangle indices out of range.");
+
+		const void* nodes = base + header.mNodesOffset;
+		if(header.mQuantized ?	!checkInPlaceBV4Tree<BVDataSwizzledQ>(nodes, header.mNbNodes, header.mInitData, header.mNbTriangles)
+							:	!checkInPlaceBV4Tree<BVDataSwizzledNQ>(nodes, header.mNbNodes, header.mInitData, header.mNbTriangles))
+			return outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "Loading in-place triangle mesh failed: corrupted BV4 tree.");
+	}
+
+	// PT: the mesh never writes to these arrays, except through the explicit modification functions
+	// (getVerticesForModification, refitBVH). The const_casts below are safe as long as these are not used.
+	PxU8* base = const_cast<PxU8*>(reinterpret_cast<const PxU8*>(memory));
+	struct Local
+	{
+		static PX_FORCE_INLINE void* getArray(PxU8* base_, PxU32 offset)
+		{
+			return offset ? base_ + offset : NULL;
+		}
+	};
+
+	data.mNbVertices		= header.mNbVertices;
+	data.mNbTriangles		= header.mNbTriangles;
+	data.mFlags				= PxU8(header.mFlags);
+	data.mGeomEpsilon		= header.mGeomEpsilon;
+	data.mAABB.minimum		= header.mAABBMin;
+	data.mAABB.maximum		= header.mAABBMax;
+	data.mMass				= header.mMass;
+	data.mInertia			= header.mInertia;
+	data.mLocalCenterOfMass	= header.mLocalCenterOfMass;
+	data.mVertices			= reinterpret_cast<PxVec3*>(Local::getArray(base, header.mVerticesOffset));
+	data.mTriangles			= Local::getArray(base, header.mTrianglesOffset);
+	data.mExtraTrigData		= reinterpret_cast<PxU8*>(Local::getArray(base, header.mExtraTrigDataOffset));
+	data.mMaterialIndices	= reinterpret_cast<PxU16*>(Local::getArray(base, header.mMaterialIndicesOffset));
+	data.mFaceRemap			= reinterpret_cast<PxU32*>(Local::getArray(base, header.mFaceRemapOffset));
+	data.mAdjacencies		= reinterpret_cast<PxU32*>(Local::getArray(base, header.mAdjacenciesOffset));
+
+	data.mMeshInterface.setNbTriangles(data.mNbTriangles);
+	data.mMeshInterface.setNbVertices(data.mNbVertices);
+	if(data.has16BitIndices())
+		data.mMeshInterface.setPointers(NULL, reinterpret_cast<IndTri16*>(data.mTriangles), data.mVertices);
+	else
+		data.mMeshInterface.setPointers(reinterpret_cast<IndTri32*>(data.mTriangles), NULL, data.mVertices);
+
+	BV4Tree& tree = data.mBV4Tree;
+	tree.mMeshInterface						= &data.mMeshInterface;
+	tree.mLocalBounds.mCenter				= header.mLocalBoundsCenter;
+	tree.mLocalBounds.mExtentsMagnitude		= header.mLocalBoundsExtentsMagnitude;
+	tree.mNbNodes							= header.mNbNodes;
+	tree.mNodes								= Local::getArray(base, header.mNodesOffset);
+	tree.mInitData							= header.mInitData;
+	tree.mCenterOrMinCoeff					= header.mCenterOrMinCoeff;
+	tree.mExtentsOrMaxCoeff					= header.mExtentsOrMaxCoeff;
+	tree.mQuantized							= header.mQuantized!=0;
+	tree.mUserAllocated						= true;
+	return true;
+}
+
+namespace
+{
+	// PT: the mesh object itself is owned (eOWNS_MEMORY must stay set so that it gets deleted), but its arrays
+	// live in the user's memory. We reset the pointers before ~TriangleMesh runs so that they are not freed.
+	// The BV4 nodes are already covered by BV4Tree::mUserAllocated.
+	class InPlaceBV4TriangleMesh : public BV4TriangleMesh
+	{
+		public:
+							InPlaceBV4TriangleMesh(MeshFactory* factory, BV4TriangleData& data) : BV4TriangleMesh(factory, data)	{}
+		virtual				~InPlaceBV4TriangleMesh()
+							{
+								mVertices			= NULL;
+								mTriangles			= NULL;
+								mExtraTrigData		= NULL;
+								mMaterialIndices	= NULL;
+								mFaceRemap			= NULL;
+								mAdjacencies		= NULL;
+							}
+	};
+}
+
+PxTriangleMesh* MeshFactory::createTriangleMeshInPlace(const void* memory, PxU32 size)
+{
+	BV4TriangleData data;
+	if(!loadInPlaceMeshData(data, memory, size))
+		return NULL;
+
+	InPlaceBV4TriangleMesh* np;
+	PX_NEW_SERIALIZED(np, InPlaceBV4TriangleMesh)(this, data);
+	if(!np)
+		return NULL;
+
+	addTriangleMesh(np);
+	return np;
+}
+
 bool MeshFactory::removeTriangleMesh(PxTriangleMesh& m)
 {
 	TriangleMesh* gu = static_cast<TriangleMesh*>(&m);
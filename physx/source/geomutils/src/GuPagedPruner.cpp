@@ -0,0 +1,766 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#include "common/PxProfileZone.h"
+#include "foundation/PxIO.h"
+#include "foundation/PxMemory.h"
+#include "GuPagedPruner.h"
+#include "GuAABBTreeQuery.h"
+#include "GuAABBTreeNode.h"
+#include "GuAABBTreeBuildStats.h"
+#include "GuQuery.h"
+#include "GuFactory.h"
+#include "CmVisualization.h"
+
+using namespace physx;
+using namespace Gu;
+using namespace Cm;
+
+#define PAGED_CELL_MAGIC	PxU32(('P'<<24)|('C'<<16)|('E'<<8)|'L')
+#define PAGED_CELL_VERSION	1
+#define PAGED_CELL_MAX_DATA_SIZE	(PxU64(1)<<30)	// PT: upper bound for a single cell, rejects nonsensical headers before allocating
+
+namespace
+{
+	// PT: adapters between the cell data and the generic traversal templates
+	struct CellTree
+	{
+		PX_FORCE_INLINE	CellTree(const PagedCell& cell) : mNodes(cell.mNodes), mIndices(cell.mIndices)	{}
+
+		PX_FORCE_INLINE	const BVHNode*	getNodes()		const	{ return mNodes;	}
+		PX_FORCE_INLINE	const PxU32*	getIndices()	const	{ return mIndices;	}
+
+		const BVHNode*	mNodes;
+		const PxU32*	mIndices;
+	};
+
+	// PT: the bounds are used in-place and not owned by this object. They are followed by the tree nodes in
+	// the cell data so the V4 loads done by the traversal code are safe.
+	class CellBounds : public AABBTreeBounds
+	{
+		public:
+		PX_FORCE_INLINE	CellBounds(const PagedCell& cell)	{ setBounds(const_cast<PxBounds3*>(cell.mObjectBounds));	}
+	};
+
+	struct CellRaycastAdapter
+	{
+		PX_FORCE_INLINE	CellRaycastAdapter(PrunerRaycastCallback& pcb, const PagedCell& cell) : mCallback(pcb), mCell(cell)	{}
+
+		PX_FORCE_INLINE bool	invoke(PxReal& distance, PxU32 primIndex)
+		{
+			return mCallback.invoke(distance, primIndex, mCell.mPayloads, mCell.mTransforms);
+		}
+
+		PrunerRaycastCallback&	mCallback;
+		const PagedCell&		mCell;
+		PX_NOCOPY(CellRaycastAdapter)
+	};
+
+	struct CellOverlapAdapter
+	{
+		PX_FORCE_INLINE	CellOverlapAdapter(PrunerOverlapCallback& pcb, const PagedCell& cell) : mCallback(pcb), mCell(cell)	{}
+
+		PX_FORCE_INLINE bool	invoke(PxU32 primIndex)
+		{
+			return mCallback.invoke(primIndex, mCell.mPayloads, mCell.mTransforms);
+		}
+
+		PrunerOverlapCallback&	mCallback;
+		const PagedCell&		mCell;
+		PX_NOCOPY(CellOverlapAdapter)
+	};
+
+	// PT: invoked for each cell touched by a raycast or sweep in the top-level tree. Cells that are not loaded are skipped.
+	template<const bool tInflate>
+	struct TopLevelRaycastAdapter
+	{
+		PX_FORCE_INLINE	TopLevelRaycastAdapter(PrunerRaycastCallback& pcb, const PagedCell* cells, const PxU32* remap, const PxVec3& origin, const PxVec3& unitDir, const PxVec3& inflation) :
+			mCallback(pcb), mCells(cells), mRemap(remap), mOrigin(origin), mUnitDir(unitDir), mInflation(inflation)	{}
+
+		PX_FORCE_INLINE bool	invoke(PxReal& distance, PxU32 primIndex)
+		{
+			const PagedCell& cell = mCells[mRemap[primIndex]];
+			if(!cell.mLoaded)
+				return true;
+
+			CellRaycastAdapter pcb(mCallback, cell);
+			return AABBTreeRaycast<tInflate, true, CellTree, BVHNode, CellRaycastAdapter>()(CellBounds(cell), CellTree(cell), mOrigin, mUnitDir, distance, mInflation, pcb);
+		}
+
+		PrunerRaycastCallback&	mCallback;
+		const PagedCell*		mCells;
+		const PxU32*			mRemap;
+		const PxVec3			mOrigin;
+		const PxVec3			mUnitDir;
+		const PxVec3			mInflation;
+		PX_NOCOPY(TopLevelRaycastAdapter)
+	};
+
+	template<typename Test>
+	struct TopLevelOverlapAdapter
+	{
+		PX_FORCE_INLINE	TopLevelOverlapAdapter(PrunerOverlapCallback& pcb, const PagedCell* cells, const PxU32* remap, const Test& test) :
+			mCallback(pcb), mCells(cells), mRemap(remap), mTest(test)	{}
+
+		PX_FORCE_INLINE bool	invoke(PxU32 primIndex)
+		{
+			const PagedCell& cell = mCells[mRemap[primIndex]];
+			if(!cell.mLoaded)
+				return true;
+
+			CellOverlapAdapter pcb(mCallback, cell);
+			return AABBTreeOverlap<true, Test, CellTree, BVHNode, CellOverlapAdapter>()(CellBounds(cell), CellTree(cell), mTest, pcb);
+		}
+
+		PrunerOverlapCallback&	mCallback;
+		const PagedCell*		mCells;
+		const PxU32*			mRemap;
+		const Test&				mTest;
+		PX_NOCOPY(TopLevelOverlapAdapter)
+	};
+
+	struct TopLevelCullAdapter
+	{
+		PX_FORCE_INLINE	TopLevelCullAdapter(PrunerOverlapCallback& pcb, const PagedCell* cells, const PxU32* remap, const PlanesAABBTest& test) :
+			mCallback(pcb), mCells(cells), mRemap(remap), mTest(test)	{}
+
+		PX_FORCE_INLINE bool	invoke(PxU32 primIndex)
+		{
+			const PagedCell& cell = mCells[mRemap[primIndex]];
+			if(!cell.mLoaded)
+				return true;
+
+			CellOverlapAdapter pcb(mCallback, cell);
+			return AABBTreeCull<true, CellTree, BVHNode, CellOverlapAdapter>()(CellBounds(cell), CellTree(cell), mTest, pcb);
+		}
+
+		PrunerOverlapCallback&	mCallback;
+		const PagedCell*		mCells;
+		const PxU32*			mRemap;
+		const PlanesAABBTest&	mTest;
+		PX_NOCOPY(TopLevelCullAdapter)
+	};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+BVHPagedPruner::BVHPagedPruner(PxU64 contextID) :
+	mCells			("BVHPagedPruner::mCells"),
+	mFreeCells		("BVHPagedPruner::mFreeCells"),
+	mCellRemap		("BVHPagedPruner::mCellRemap"),
+	mOriginShift	(PxVec3(0.0f)),
+	mContextID		(contextID),
+	mNbCells		(0),
+	mNbLoadedCells	(0),
+	mCellsDirty		(false)
+{
+}
+
+BVHPagedPruner::~BVHPagedPruner()
+{
+	purge();
+}
+
+bool BVHPagedPruner::validCell(PagedCellHandle cell) const
+{
+	return cell<mCells.size() && mCells[cell].mUsed;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+PagedCellHandle BVHPagedPruner::addCell(const PxBounds3& bounds)
+{
+	PxU32 index;
+	if(mFreeCells.size())
+	{
+		index = mFreeCells.popBack();
+	}
+	else
+	{
+		index = mCells.size();
+		mCells.insert();
+	}
+
+	PagedCell& cell = mCells[index];
+	PxMemZero(&cell, sizeof(PagedCell));
+	cell.mBounds	= bounds;
+	cell.mUsed		= true;
+
+	mNbCells++;
+	mCellsDirty = true;
+	return index;
+}
+
+bool BVHPagedPruner::removeCell(PagedCellHandle index)
+{
+	if(!validCell(index))
+		return false;
+
+	PagedCell& cell = mCells[index];
+	if(cell.mLoaded)
+		unloadCell(index);
+
+	cell.mUsed = false;
+	mFreeCells.pushBack(index);
+
+	mNbCells--;
+	mCellsDirty = true;
+	return true;
+}
+
+// PT: the cell data comes from user files so we check the header before trusting any of the sizes it contains
+static bool validateCellHeader(const PagedCellHeader& header, PxU32& dataSize)
+{
+	if(header.mMagic!=PAGED_CELL_MAGIC || header.mVersion!=PAGED_CELL_VERSION)
+		return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "BVHPagedPruner::loadCell: invalid cell data, or endianness mismatch.");
+
+	if(header.mPayloadSize!=sizeof(PrunerPayload))
+		return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "BVHPagedPruner::loadCell: cell data has been written on an incompatible platform.");
+
+	// PT: computed in 64-bit so that huge counts cannot wrap around to a small size
+	const PxU64 size =	PxU64(sizeof(PagedCellHeader))
+					+	PxU64(header.mNbObjects)*(sizeof(PrunerPayload) + sizeof(PxTransform) + sizeof(PxBounds3))
+					+	PxU64(header.mNbNodes)*sizeof(BVHNode)
+					+	PxU64(header.mNbIndices)*sizeof(PxU32);
+
+	if(!header.mNbObjects || !header.mNbNodes || !header.mNbIndices || size>PAGED_CELL_MAX_DATA_SIZE)
+		return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "BVHPagedPruner::loadCell: invalid cell data.");
+
+	dataSize = PxU32(size);
+	return true;
+}
+
+// PT: the traversal code follows node links and primitive indices without checks, so we make sure once here that they
+// stay within the cell. Children are always stored after their parent, which also rules out cycles.
+static bool validateCellTree(const PagedCell& cell)
+{
+	for(PxU32 i=0;i<cell.mNbNodes;i++)
+	{
+		const BVHNode& node = cell.mNodes[i];
+		if(node.isLeaf())
+		{
+			const PxU32 start = node.getPrimitiveIndex();
+			const PxU32 nb = node.getNbPrimitives();
+			if(!nb || start>cell.mNbIndices || nb>cell.mNbIndices-start)
+				return false;
+		}
+		else
+		{
+			const PxU32 pos = node.getPosIndex();
+			if(pos<=i || pos>=cell.mNbNodes-1)
+				return false;
+		}
+	}
+
+	for(PxU32 i=0;i<cell.mNbIndices;i++)
+	{
+		if(cell.mIndices[i]>=cell.mNbObjects)
+			return false;
+	}
+	return true;
+}
+
+bool BVHPagedPruner::setupCell(PagedCell& cell, const void* data, PxU32 size, void* ownedMemory)
+{
+	if(size<sizeof(PagedCellHeader))
+		return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "BVHPagedPruner::loadCell: invalid cell data.");
+
+	const PagedCellHeader* header = reinterpret_cast<const PagedCellHeader*>(data);
+	PxU32 dataSize;
+	if(!validateCellHeader(*header, dataSize))
+		return false;
+
+	if(dataSize>size)
+		return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "BVHPagedPruner::loadCell: truncated cell data.");
+
+	PagedCell tmp = cell;
+	tmp.mNbObjects	= header->mNbObjects;
+	tmp.mNbNodes	= header->mNbNodes;
+	tmp.mNbIndices	= header->mNbIndices;
+
+	const PxU8* ptr = reinterpret_cast<const PxU8*>(header + 1);
+	tmp.mPayloads		= reinterpret_cast<const PrunerPayload*>(ptr);	ptr += sizeof(PrunerPayload)*tmp.mNbObjects;
+	tmp.mTransforms		= reinterpret_cast<const PxTransform*>(ptr);	ptr += sizeof(PxTransform)*tmp.mNbObjects;
+	tmp.mObjectBounds	= reinterpret_cast<const PxBounds3*>(ptr);		ptr += sizeof(PxBounds3)*tmp.mNbObjects;
+	tmp.mNodes			= reinterpret_cast<const BVHNode*>(ptr);		ptr += sizeof(BVHNode)*tmp.mNbNodes;
+	tmp.mIndices		= reinterpret_cast<const PxU32*>(ptr);
+
+	if(!validateCellTree(tmp))
+		return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "BVHPagedPruner::loadCell: corrupt cell tree.");
+
+	cell = tmp;
+	cell.mMemory		= ownedMemory;
+	cell.mLoaded		= true;
+	mNbLoadedCells++;
+
+	// PT: data written before the last origin shift must be moved to the new origin
+	if(!mOriginShift.isZero())
+	{
+		if(!makeCellDataOwned(cell))
+		{
+			releaseCellData(cell);
+			mNbLoadedCells--;
+			return PxGetFoundation().error(PxErrorCode::eOUT_OF_MEMORY, PX_FL, "BVHPagedPruner::loadCell: cannot allocate cell data.");
+		}
+		shiftCellData(cell, mOriginShift);
+	}
+	return true;
+}
+
+bool BVHPagedPruner::loadCell(PagedCellHandle index, PxInputStream& stream)
+{
+	PX_PROFILE_ZONE("SceneQuery.pagedPrunerLoadCell", mContextID);
+
+	if(!validCell(index))
+		return false;
+
+	PagedCell& cell = mCells[index];
+	if(cell.mLoaded)
+		unloadCell(index);
+
+	PagedCellHeader header;
+	if(stream.read(&header, sizeof(PagedCellHeader))!=sizeof(PagedCellHeader))
+		return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "BVHPagedPruner::loadCell: invalid cell data.");
+
+	PxU32 size;
+	if(!validateCellHeader(header, size))
+		return false;
+
+	void* memory = PX_ALLOC(size, "BVHPagedPruner cell");
+	if(!memory)
+		return PxGetFoundation().error(PxErrorCode::eOUT_OF_MEMORY, PX_FL, "BVHPagedPruner::loadCell: cannot allocate cell data.");
+
+	PxMemCopy(memory, &header, sizeof(PagedCellHeader));
+	const PxU32 remaining = size - sizeof(PagedCellHeader);
+	if(stream.read(reinterpret_cast<PxU8*>(memory) + sizeof(PagedCellHeader), remaining)!=remaining)
+	{
+		PX_FREE(memory);
+		return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "BVHPagedPruner::loadCell: failed to read cell data.");
+	}
+
+	if(!setupCell(cell, memory, size, memory))
+	{
+		PX_FREE(memory);
+		return false;
+	}
+	return true;
+}
+
+bool BVHPagedPruner::loadCell(PagedCellHandle index, const void* data, PxU32 size)
+{
+	PX_PROFILE_ZONE("SceneQuery.pagedPrunerLoadCell", mContextID);
+
+	if(!validCell(index) || !data)
+		return false;
+
+	if(size_t(data) & 7)
+		return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "BVHPagedPruner::loadCell: in-place cell data must be 8-bytes aligned.");
+
+	if(mCells[index].mLoaded)
+		unloadCell(index);
+
+	return setupCell(mCells[index], data, size, NULL);
+}
+
+void BVHPagedPruner::releaseCellData(PagedCell& cell)
+{
+	PX_FREE(cell.mMemory);
+	cell.mPayloads		= NULL;
+	cell.mTransforms	= NULL;
+	cell.mObjectBounds	= NULL;
+	cell.mNodes			= NULL;
+	cell.mIndices		= NULL;
+	cell.mNbObjects		= 0;
+	cell.mNbNodes		= 0;
+	cell.mNbIndices		= 0;
+	cell.mLoaded		= false;
+}
+
+void BVHPagedPruner::unloadCell(PagedCellHandle index)
+{
+	if(!validCell(index) || !mCells[index].mLoaded)
+		return;
+
+	releaseCellData(mCells[index]);
+	mNbLoadedCells--;
+}
+
+bool BVHPagedPruner::isCellLoaded(PagedCellHandle index) const
+{
+	return validCell(index) && mCells[index].mLoaded;
+}
+
+// PT: in-place data is read-only, so we switch to an internal copy before modifying it
+bool BVHPagedPruner::makeCellDataOwned(PagedCell& cell)
+{
+	if(cell.mMemory)
+		return true;
+
+	const PxU32 size = cell.getDataSize();
+	void* memory = PX_ALLOC(size, "BVHPagedPruner cell");
+	if(!memory)
+		return false;
+	const PxU8* src = reinterpret_cast<const PxU8*>(cell.mPayloads) - sizeof(PagedCellHeader);
+	PxMemCopy(memory, src, size);
+
+	PxU8* dst = reinterpret_cast<PxU8*>(memory);
+	cell.mPayloads		= reinterpret_cast<const PrunerPayload*>(dst + (reinterpret_cast<const PxU8*>(cell.mPayloads) - src));
+	cell.mTransforms	= reinterpret_cast<const PxTransform*>(dst + (reinterpret_cast<const PxU8*>(cell.mTransforms) - src));
+	cell.mObjectBounds	= reinterpret_cast<const PxBounds3*>(dst + (reinterpret_cast<const PxU8*>(cell.mObjectBounds) - src));
+	cell.mNodes			= reinterpret_cast<const BVHNode*>(dst + (reinterpret_cast<const PxU8*>(cell.mNodes) - src));
+	cell.mIndices		= reinterpret_cast<const PxU32*>(dst + (reinterpret_cast<const PxU8*>(cell.mIndices) - src));
+	cell.mMemory		= memory;
+	return true;
+}
+
+void BVHPagedPruner::shiftCellData(PagedCell& cell, const PxVec3& shift)
+{
+	PX_ASSERT(cell.mMemory);
+
+	PxTransform* transforms = const_cast<PxTransform*>(cell.mTransforms);
+	PxBounds3* bounds = const_cast<PxBounds3*>(cell.mObjectBounds);
+	for(PxU32 i=0;i<cell.mNbObjects;i++)
+	{
+		transforms[i].p -= shift;
+		bounds[i].minimum -= shift;
+		bounds[i].maximum -= shift;
+	}
+
+	BVHNode* nodes = const_cast<BVHNode*>(cell.mNodes);
+	for(PxU32 i=0;i<cell.mNbNodes;i++)
+	{
+		nodes[i].mBV.minimum -= shift;
+		nodes[i].mBV.maximum -= shift;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool BVHPagedPruner::addObjects(PrunerHandle* results, const PxBounds3*, const PrunerPayload*, const PxTransform*, PxU32 count, bool)
+{
+	for(PxU32 i=0;i<count;i++)
+		results[i] = INVALID_PRUNERHANDLE;
+
+	if(!count)
+		return true;
+
+	return PxGetFoundation().error(PxErrorCode::eINVALID_OPERATION, PX_FL, "BVHPagedPruner::addObjects: objects must be added through cells.");
+}
+
+void BVHPagedPruner::removeObjects(const PrunerHandle*, PxU32 count, PrunerPayloadRemovalCallback*)
+{
+	if(count)
+		PxGetFoundation().error(PxErrorCode::eINVALID_OPERATION, PX_FL, "BVHPagedPruner::removeObjects: objects must be removed through cells.");
+}
+
+void BVHPagedPruner::updateObjects(const PrunerHandle*, PxU32 count, float, const PxU32*, const PxBounds3*, const PxTransform32*)
+{
+	if(count)
+		PxGetFoundation().error(PxErrorCode::eINVALID_OPERATION, PX_FL, "BVHPagedPruner::updateObjects: objects in cells are static.");
+}
+
+const PrunerPayload& BVHPagedPruner::getPayloadData(PrunerHandle, PrunerPayloadData* data) const
+{
+	PX_ALWAYS_ASSERT_MESSAGE("BVHPagedPruner::getPayloadData: objects in cells do not have handles");
+	if(data)
+	{
+		data->mBounds = NULL;
+		data->mTransform = NULL;
+	}
+	static const PrunerPayload invalidPayload = { { 0, 0 } };
+	return invalidPayload;
+}
+
+bool BVHPagedPruner::setTransform(PrunerHandle, const PxTransform&)
+{
+	return false;
+}
+
+void BVHPagedPruner::preallocate(PxU32 nbEntries)
+{
+	mCells.reserve(nbEntries);
+}
+
+void BVHPagedPruner::merge(const void*)
+{
+	// PT: pruning structures are not supported, objects are added through cells
+}
+
+void BVHPagedPruner::purge()
+{
+	const PxU32 nbCells = mCells.size();
+	for(PxU32 i=0;i<nbCells;i++)
+		releaseCellData(mCells[i]);
+
+	mCells.reset();
+	mFreeCells.reset();
+	mCellRemap.reset();
+	mCellTree.release();
+	mCellTreeBounds.release();
+	mNbCells = 0;
+	mNbLoadedCells = 0;
+	mCellsDirty = false;
+}
+
+void BVHPagedPruner::commit()
+{
+	if(!mCellsDirty)
+		return;
+
+	PX_PROFILE_ZONE("SceneQuery.pagedPrunerCommit", mContextID);
+
+	mCellsDirty = false;
+	mCellTree.release();
+	mCellRemap.clear();
+
+	if(!mNbCells)
+		return;
+
+	mCellRemap.reserve(mNbCells);
+	mCellTreeBounds.init(mNbCells);
+	PxBounds3* dst = mCellTreeBounds.getBounds();
+
+	const PxU32 nbCells = mCells.size();
+	for(PxU32 i=0;i<nbCells;i++)
+	{
+		if(!mCells[i].mUsed)
+			continue;
+
+		*dst++ = mCells[i].mBounds;
+		mCellRemap.pushBack(i);
+	}
+	PX_ASSERT(mCellRemap.size()==mNbCells);
+
+	// PT: the top-level tree only contains a few cells, so we use one cell per leaf and skip the leaf-level box tests
+	NodeAllocator nodeAllocator;
+	const AABBTreeBuildParams params(1, mNbCells, &mCellTreeBounds, BVH_SPLATTER_POINTS);
+	mCellTree.build(params, nodeAllocator);
+}
+
+void BVHPagedPruner::shiftOrigin(const PxVec3& shift)
+{
+	const PxU32 nbCells = mCells.size();
+	for(PxU32 i=0;i<nbCells;i++)
+	{
+		PagedCell& cell = mCells[i];
+		if(!cell.mUsed)
+			continue;
+
+		cell.mBounds.minimum -= shift;
+		cell.mBounds.maximum -= shift;
+
+		if(cell.mLoaded)
+		{
+			if(makeCellDataOwned(cell))
+			{
+				shiftCellData(cell, shift);
+			}
+			else
+			{
+				PxGetFoundation().error(PxErrorCode::eOUT_OF_MEMORY, PX_FL, "BVHPagedPruner::shiftOrigin: cannot allocate cell data, cell has been unloaded.");
+				releaseCellData(cell);
+				mNbLoadedCells--;
+			}
+		}
+	}
+
+	if(mCellTree.getNodes())
+	{
+		mCellTree.shiftOrigin(shift);
+
+		PxBounds3* bounds = mCellTreeBounds.getBounds();
+		const PxU32 nbBounds = mCellRemap.size();
+		for(PxU32 i=0;i<nbBounds;i++)
+		{
+			bounds[i].minimum -= shift;
+			bounds[i].maximum -= shift;
+		}
+	}
+
+	mOriginShift += shift;
+}
+
+void BVHPagedPruner::getGlobalBounds(PxBounds3& bounds) const
+{
+	PX_ASSERT(!mCellsDirty);
+
+	if(mCellTree.getNodes())
+		bounds = mCellTree.getNodes()->mBV;
+	else
+		bounds.setEmpty();
+}
+
+void BVHPagedPruner::visualize(PxRenderOutput& out, PxU32 primaryColor, PxU32 secondaryColor) const
+{
+	out << PxTransform(PxIdentity);
+
+	const PxU32 nbCells = mCells.size();
+	for(PxU32 i=0;i<nbCells;i++)
+	{
+		const PagedCell& cell = mCells[i];
+		if(!cell.mUsed)
+			continue;
+
+		out << (cell.mLoaded ? primaryColor : secondaryColor);
+		renderOutputDebugBox(out, cell.mBounds);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+template<const bool tInflate>
+static PX_FORCE_INLINE bool raycastCells(const AABBTree& cellTree, const AABBTreeBounds& cellBounds, const PagedCell* cells, const PxU32* remap, const PxVec3& origin, const PxVec3& unitDir, PxReal& maxDist, const PxVec3& inflation, PrunerRaycastCallback& pcb)
+{
+	TopLevelRaycastAdapter<tInflate> adapter(pcb, cells, remap, origin, unitDir, inflation);
+	return AABBTreeRaycast<tInflate, true, AABBTree, BVHNode, TopLevelRaycastAdapter<tInflate> >()(cellBounds, cellTree, origin, unitDir, maxDist, inflation, adapter);
+}
+
+template<typename Test>
+static PX_FORCE_INLINE bool overlapCells(const AABBTree& cellTree, const AABBTreeBounds& cellBounds, const PagedCell* cells, const PxU32* remap, const Test& test, PrunerOverlapCallback& pcb)
+{
+	TopLevelOverlapAdapter<Test> adapter(pcb, cells, remap, test);
+	return AABBTreeOverlap<true, Test, AABBTree, BVHNode, TopLevelOverlapAdapter<Test> >()(cellBounds, cellTree, test, adapter);
+}
+
+bool BVHPagedPruner::raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& pcb) const
+{
+	PX_ASSERT(!mCellsDirty);
+
+	if(!mNbLoadedCells || !mCellTree.getNodes())
+		return true;
+
+	return raycastCells<false>(mCellTree, mCellTreeBounds, mCells.begin(), mCellRemap.begin(), origin, unitDir, inOutDistance, PxVec3(0.0f), pcb);
+}
+
+bool BVHPagedPruner::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& pcb) const
+{
+	PX_ASSERT(!mCellsDirty);
+
+	if(!mNbLoadedCells || !mCellTree.getNodes())
+		return true;
+
+	const PxBounds3& aabb = queryVolume.getPrunerInflatedWorldAABB();
+	return raycastCells<true>(mCellTree, mCellTreeBounds, mCells.begin(), mCellRemap.begin(), aabb.getCenter(), unitDir, inOutDistance, aabb.getExtents(), pcb);
+}
+
+bool BVHPagedPruner::overlap(const ShapeData& queryVolume, PrunerOverlapCallback& pcb) const
+{
+	PX_ASSERT(!mCellsDirty);
+
+	if(!mNbLoadedCells || !mCellTree.getNodes())
+		return true;
+
+	const PagedCell* cells = mCells.begin();
+	const PxU32* remap = mCellRemap.begin();
+
+	switch(queryVolume.getType())
+	{
+		case PxGeometryType::eBOX:
+		{
+			if(queryVolume.isOBB())
+			{
+				const DefaultOBBAABBTest test(queryVolume);
+				return overlapCells<OBBAABBTest>(mCellTree, mCellTreeBounds, cells, remap, test, pcb);
+			}
+			else
+			{
+				const DefaultAABBAABBTest test(queryVolume);
+				return overlapCells<AABBAABBTest>(mCellTree, mCellTreeBounds, cells, remap, test, pcb);
+			}
+		}
+
+		case PxGeometryType::eCAPSULE:
+		{
+			const DefaultCapsuleAABBTest test(queryVolume, SQ_PRUNER_INFLATION);
+			return overlapCells<CapsuleAABBTest>(mCellTree, mCellTreeBounds, cells, remap, test, pcb);
+		}
+
+		case PxGeometryType::eSPHERE:
+		{
+			const DefaultSphereAABBTest test(queryVolume);
+			return overlapCells<SphereAABBTest>(mCellTree, mCellTreeBounds, cells, remap, test, pcb);
+		}
+
+		case PxGeometryType::eCONVEXMESH:
+		{
+			const DefaultOBBAABBTest test(queryVolume);
+			return overlapCells<OBBAABBTest>(mCellTree, mCellTreeBounds, cells, remap, test, pcb);
+		}
+
+		default:
+			PX_ALWAYS_ASSERT_MESSAGE("unsupported overlap query volume geometry type");
+	}
+	return true;
+}
+
+bool BVHPagedPruner::cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& pcb) const
+{
+	PX_ASSERT(!mCellsDirty);
+
+	if(!mNbLoadedCells || !mCellTree.getNodes())
+		return true;
+
+	// PT: the top-level tree has one cell per leaf so a regular overlap traversal is enough there
+	const PlanesAABBTest test(nbPlanes, planes);
+	TopLevelCullAdapter adapter(pcb, mCells.begin(), mCellRemap.begin(), test);
+	return AABBTreeOverlap<true, PlanesAABBTest, AABBTree, BVHNode, TopLevelCullAdapter>()(mCellTreeBounds, mCellTree, test, adapter);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool physx::Gu::savePagedPrunerCell(PxOutputStream& stream, PxU32 nbObjects, const PxBounds3* bounds, const PrunerPayload* payloads, const PxTransform* transforms, BVHBuildStrategy buildStrategy, PxU32 nbObjectsPerNode)
+{
+	if(!nbObjects || !bounds || !payloads || !transforms || !nbObjectsPerNode || nbObjectsPerNode>=16)
+		return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "savePagedPrunerCell: invalid parameters.");
+
+	AABBTreeBounds treeBounds;
+	treeBounds.init(nbObjects, bounds);
+
+	AABBTree tree;
+	NodeAllocator nodeAllocator;
+	const AABBTreeBuildParams params(nbObjectsPerNode, nbObjects, &treeBounds, buildStrategy);
+	if(!tree.build(params, nodeAllocator))
+		return false;
+
+	PagedCellHeader header;
+	PxMemZero(&header, sizeof(PagedCellHeader));
+	header.mMagic		= PAGED_CELL_MAGIC;
+	header.mVersion		= PAGED_CELL_VERSION;
+	header.mPayloadSize	= sizeof(PrunerPayload);
+	header.mNbObjects	= nbObjects;
+	header.mNbNodes		= tree.getNbNodes();
+	header.mNbIndices	= nbObjects;
+
+	stream.write(&header, sizeof(PagedCellHeader));
+	stream.write(payloads, sizeof(PrunerPayload)*nbObjects);
+	stream.write(transforms, sizeof(PxTransform)*nbObjects);
+	stream.write(bounds, sizeof(PxBounds3)*nbObjects);
+	stream.write(tree.getNodes(), sizeof(BVHNode)*tree.getNbNodes());
+	stream.write(tree.getIndices(), sizeof(PxU32)*nbObjects);
+	return true;
+}
@@ -0,0 +1,142 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#ifndef GU_PAGED_PRUNER_H
+#define GU_PAGED_PRUNER_H
+
+#include "foundation/PxArray.h"
+#include "GuPruner.h"
+#include "GuAABBTree.h"
+#include "GuAABBTreeBounds.h"
+#include "GuAABBTreeNode.h"
+#include "GuSqInternal.h"
+
+namespace physx
+{
+namespace Gu
+{
+	// PT: header of serialized cells. The arrays follow in this order: payloads, transforms, bounds, nodes, indices.
+	// Payloads come first so that they are naturally aligned when the data is used in-place.
+	struct PagedCellHeader
+	{
+		PxU32	mMagic;
+		PxU32	mVersion;
+		PxU32	mPayloadSize;	// sizeof(PrunerPayload) on the platform that wrote the data
+		PxU32	mNbObjects;
+		PxU32	mNbNodes;
+		PxU32	mNbIndices;
+		PxU32	mPadding[2];
+	};
+	PX_COMPILE_TIME_ASSERT(sizeof(PagedCellHeader)==32);
+
+	struct PagedCell
+	{
+		PxBounds3				mBounds;		// Cell bounds, as registered by the user
+		void*					mMemory;		// Internal copy of the cell data, NULL for in-place (zero-copy) data
+		const PrunerPayload*	mPayloads;
+		const PxTransform*		mTransforms;
+		const PxBounds3*		mObjectBounds;
+		const BVHNode*			mNodes;
+		const PxU32*			mIndices;
+		PxU32					mNbObjects;
+		PxU32					mNbNodes;
+		PxU32					mNbIndices;
+		bool					mUsed;
+		bool					mLoaded;
+
+		PX_FORCE_INLINE	PxU32	getDataSize()	const
+		{
+			return sizeof(PagedCellHeader) + mNbObjects*(sizeof(PrunerPayload) + sizeof(PxTransform) + sizeof(PxBounds3)) + mNbNodes*sizeof(BVHNode) + mNbIndices*sizeof(PxU32);
+		}
+	};
+
+	class BVHPagedPruner : public PagedPruner
+	{
+												PX_NOCOPY(BVHPagedPruner)
+		public:
+		PX_PHYSX_COMMON_API						BVHPagedPruner(PxU64 contextID);
+		virtual									~BVHPagedPruner();
+
+		// BasePruner
+												DECLARE_BASE_PRUNER_API
+		//~BasePruner
+
+		// Pruner
+		virtual			bool					addObjects(PrunerHandle* results, const PxBounds3* bounds, const PrunerPayload* data, const PxTransform* transforms, PxU32 count, bool hasPruningStructure);
+		virtual			void					removeObjects(const PrunerHandle* handles, PxU32 count, PrunerPayloadRemovalCallback* removalCallback);
+		virtual			void					updateObjects(const PrunerHandle* handles, PxU32 count, float inflation, const PxU32* boundsIndices, const PxBounds3* newBounds, const PxTransform32* newTransforms);
+		virtual			void					purge();
+		virtual			void					commit();
+		virtual			void					merge(const void* mergeParams);
+		virtual			bool					raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback&)				const;
+		virtual			bool					overlap(const ShapeData& queryVolume, PrunerOverlapCallback&)													const;
+		virtual			bool					cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback&)												const;
+		virtual			bool					sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback&)	const;
+		virtual			const PrunerPayload&	getPayloadData(PrunerHandle handle, PrunerPayloadData* data)												const;
+		virtual			void					preallocate(PxU32 nbEntries);
+		virtual			bool					setTransform(PrunerHandle handle, const PxTransform& transform);
+		virtual			void					getGlobalBounds(PxBounds3&)																					const;
+		//~Pruner
+
+		// PagedPruner
+		virtual			PagedCellHandle			addCell(const PxBounds3& bounds);
+		virtual			bool					removeCell(PagedCellHandle cell);
+		virtual			bool					loadCell(PagedCellHandle cell, PxInputStream& stream);
+		virtual			bool					loadCell(PagedCellHandle cell, const void* data, PxU32 size);
+		virtual			void					unloadCell(PagedCellHandle cell);
+		virtual			bool					isCellLoaded(PagedCellHandle cell)	const;
+		virtual			PxU32					getNbCells()						const	{ return mNbCells;			}
+		virtual			PxU32					getNbLoadedCells()					const	{ return mNbLoadedCells;	}
+		//~PagedPruner
+
+		// direct access for test code
+		PX_FORCE_INLINE	const PagedCell*		getCells()			const	{ return mCells.begin();	}
+		PX_FORCE_INLINE	const AABBTree&			getCellTree()		const	{ return mCellTree;			}
+
+		private:
+						PxArray<PagedCell>	mCells;
+						PxArray<PxU32>		mFreeCells;
+						PxArray<PxU32>		mCellRemap;		// Top-level tree primitive index => cell index
+						AABBTree			mCellTree;		// Top-level tree over the bounds of all registered cells
+						AABBTreeBounds		mCellTreeBounds;
+						PxVec3				mOriginShift;	// Accumulated origin shift, applied to cells loaded later
+						PxU64				mContextID;
+						PxU32				mNbCells;
+						PxU32				mNbLoadedCells;
+						bool				mCellsDirty;
+
+						bool				validCell(PagedCellHandle cell)	const;
+						bool				setupCell(PagedCell& cell, const void* data, PxU32 size, void* ownedMemory);
+						void				releaseCellData(PagedCell& cell);
+						bool				makeCellDataOwned(PagedCell& cell);
+						void				shiftCellData(PagedCell& cell, const PxVec3& shift);
+	};
+}
+}
+
+#endif
@@ -699,6 +699,32 @@ namespace
 		PX_NOCOPY(LocalOverlapCB)
 	};
 
+	struct LocalCullCB : PxBVH::OverlapCallback
+	{
+		LocalCullCB(const PxArray<QuerySystem::PrunerExt*>& pruners, const PrunerFilter* prunerFilter, PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& cb) :
+			mPrunerExt(pruners), mPrunerFilter(prunerFilter), mNbPlanes(nbPlanes), mPlanes(planes), mCB(cb)	{}
+
+		virtual bool	reportHit(PxU32 boundsIndex)
+		{
+			QuerySystem::PrunerExt* pe = mPrunerExt[boundsIndex];	// Can be NULL if the pruner has been removed
+			if(pe && (!mPrunerFilter || mPrunerFilter->processPruner(boundsIndex)))
+			{
+				Pruner* pruner = pe->mPruner;
+				if(!pruner->cull(mNbPlanes, mPlanes, mCB))
+					return false;
+			}
+			return true;
+		}
+
+		const PxArray<QuerySystem::PrunerExt*>&	mPrunerExt;
+		const PrunerFilter*						mPrunerFilter;
+		const PxU32								mNbPlanes;
+		const PxPlane*							mPlanes;
+		PrunerOverlapCallback&					mCB;
+
+		PX_NOCOPY(LocalCullCB)
+	};
+
 	struct LocalSweepCB : PxBVH::RaycastCallback
 	{
 		LocalSweepCB(const PxArray<QuerySystem::PrunerExt*>& pruners, const PrunerFilter* prunerFilter, const ShapeData& queryVolume, const PxVec3& unitDir, PrunerRaycastCallback& cb) :
@@ -778,6 +804,32 @@ void QuerySystem::overlap(const ShapeData& queryVolume, PrunerOverlapCallback& c
 	}
 }
 
+void QuerySystem::cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& cb, const PrunerFilter* prunerFilter) const
+{
+	if(mTreeOfPruners)
+	{
+		LocalCullCB localCB(mPrunerExt, prunerFilter, nbPlanes, planes, cb);
+		mTreeOfPruners->cull(nbPlanes, planes, localCB, PxGeometryQueryFlag::Enum(0));
+	}
+	else
+	{
+		const PxU32 nb = mPrunerExt.size();
+		for(PxU32 i=0;i<nb;i++)
+		{
+			PrunerExt* pe = mPrunerExt[i];	// Can be NULL if the pruner has been removed
+			if(!pe)
+				continue;
+
+			if(!prunerFilter || prunerFilter->processPruner(i))
+			{
+				Pruner* pruner = pe->mPruner;
+				if(!pruner->cull(nbPlanes, planes, cb))
+					return;
+			}
+		}
+	}
+}
+
 void QuerySystem::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, float& inOutDistance, PrunerRaycastCallback& cb, const PrunerFilter* prunerFilter) const
 {
 	if(mTreeOfPruners)
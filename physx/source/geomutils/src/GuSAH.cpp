@@ -30,6 +30,7 @@
 #include "foundation/PxAllocator.h"
 #include "foundation/PxMemory.h"
 #include "GuSAH.h"
+#include "GuBuildTask.h"
 
 using namespace physx;
 using namespace Gu;
@@ -40,11 +41,15 @@ static PX_FORCE_INLINE float getSurfaceArea(const PxBounds3& bounds)
 	return 2.0f * (e.x * e.y + e.x * e.z + e.y * e.z);
 }
 
-SAH_Buffers::SAH_Buffers(PxU32 nb_prims)
+// PT: below this number of primitives it is not worth sweeping the axes in parallel
+#define SAH_PARALLEL_SWEEP_LIMIT	4096
+
+SAH_Buffers::SAH_Buffers(PxU32 nb_prims, PxCpuDispatcher* dispatcher) : mDispatcher(dispatcher)
 {
-	mKeys = PX_ALLOCATE(float, nb_prims, "temp");
-	mCumulativeLower = PX_ALLOCATE(float, nb_prims, "temp");
-	mCumulativeUpper = PX_ALLOCATE(float, nb_prims, "temp");
+	const PxU32 nbAxes = dispatcher ? 3 : 1;
+	mKeys = PX_ALLOCATE(float, nb_prims*nbAxes, "temp");
+	mCumulativeLower = PX_ALLOCATE(float, nb_prims*nbAxes, "temp");
+	mCumulativeUpper = PX_ALLOCATE(float, nb_prims*nbAxes, "temp");
 	mNb = nb_prims;
 }
 
@@ -55,111 +60,74 @@ SAH_Buffers::~SAH_Buffers()
 	PX_FREE(mCumulativeUpper);
 }
 
-bool SAH_Buffers::split(PxU32& leftCount, PxU32 nb, const PxU32* PX_RESTRICT prims, const PxBounds3* PX_RESTRICT boxes, const PxVec3* PX_RESTRICT centers)
+bool SAH_Buffers::sweepAxis(PxU32 axis, float& bestCost, PxU32& bestIndex, PxU32 nb, const PxU32* PX_RESTRICT prims, const PxBounds3* PX_RESTRICT boxes, const PxVec3* PX_RESTRICT centers,
+							float* PX_RESTRICT keys, float* PX_RESTRICT cumulativeLower, float* PX_RESTRICT cumulativeUpper)
 {
-    PxU32 bestAxis = 0;
-    PxU32 bestIndex = 0;
-    float bestCost = PX_MAX_F32;
+	bool found = false;
 
-	PX_ASSERT(nb<=mNb);
-	for(PxU32 axis=0;axis<3;axis++)
+	const PxU32* sorted;
 	{
-		const PxU32* sorted;
+		for(PxU32 i=0;i<nb;i++)
 		{
-			float* keys = mKeys;
-			for(PxU32 i=0;i<nb;i++)
-			{
-				const PxU32 index = prims[i];
-				const float center = centers[index][axis];
-				keys[i] = center;
-			}
-
-			sorted = mSorters[axis].Sort(keys, nb).GetRanks();
+			const PxU32 index = prims[i];
+			const float center = centers[index][axis];
+			keys[i] = center;
 		}
 
-		float* cumulativeLower = mCumulativeLower;
-		float* cumulativeUpper = mCumulativeUpper;
-
-/*		if(0)
-		{
-			PxBounds3 bbox = PxBounds3::empty();
-
-			for(PxU32 i=0; i<nb; i++)
-			{
-				bbox.include(bboxes[references[axis][i]]);
-				bbox.include(boxes[prims[nb-sortedIndex-1]]);
-			}
-
-			
-			for (size_t i = end - 1; i > begin; --i) {
-			bbox.extend(bboxes[references[axis][i]]);
-			costs[axis][i] = bbox.half_area() * (end - i);
-			}
-			bbox = BoundingBox<Scalar>::empty();
-			auto best_split = std::pair<Scalar, size_t>(std::numeric_limits<Scalar>::max(), end);
-			for (size_t i = begin; i < end - 1; ++i) {
-			bbox.extend(bboxes[references[axis][i]]);
-			auto cost = bbox.half_area() * (i + 1 - begin) + costs[axis][i + 1];
-			if (cost < best_split.first)
-			best_split = std::make_pair(cost, i + 1);
-			}
-			return best_split;
-		}*/
+		// PT: don't let the sorter reuse the ranks from its previous call (temporal coherence). Equal keys would otherwise be
+		// ordered according to whichever node was processed before with the same number of primitives, and the resulting
+		// tree would depend on the build order (e.g. single- vs multi-threaded builds).
+		mSorters[axis].invalidateRanks();
+		sorted = mSorters[axis].Sort(keys, nb).GetRanks();
+	}
 
-		if(1)
-		{
-			// two passes over data to calculate upper and lower bounds
-			PxBounds3 lower = PxBounds3::empty();
-			PxBounds3 upper = PxBounds3::empty();
-//				lower.minimum = lower.maximum = PxVec3(0.0f);
-//				upper.minimum = upper.maximum = PxVec3(0.0f);
+	// two passes over data to calculate upper and lower bounds
+	PxBounds3 lower = PxBounds3::empty();
+	PxBounds3 upper = PxBounds3::empty();
 
 #if PX_ENABLE_ASSERTS
-			float prevLowerCenter = -PX_MAX_F32;
-			float prevUpperCenter = PX_MAX_F32;
+	float prevLowerCenter = -PX_MAX_F32;
+	float prevUpperCenter = PX_MAX_F32;
 #endif
-			for(PxU32 i=0; i<nb; ++i)
-			{
-				const PxU32 lowSortedIndex = sorted[i];
-				const PxU32 highSortedIndex = sorted[nb-i-1];
+	for(PxU32 i=0; i<nb; ++i)
+	{
+		const PxU32 lowSortedIndex = sorted[i];
+		const PxU32 highSortedIndex = sorted[nb-i-1];
 
-				//lower.Union(m_faceBounds[faces[i]]);
-					PX_ASSERT(centers[prims[lowSortedIndex]][axis]>=prevLowerCenter);
-					lower.include(boxes[prims[lowSortedIndex]]);
+		PX_ASSERT(centers[prims[lowSortedIndex]][axis]>=prevLowerCenter);
+		lower.include(boxes[prims[lowSortedIndex]]);
 #if PX_ENABLE_ASSERTS
-					prevLowerCenter = centers[prims[lowSortedIndex]][axis];
+		prevLowerCenter = centers[prims[lowSortedIndex]][axis];
 #endif
-				//upper.Union(m_faceBounds[faces[numFaces - i - 1]]);
-					PX_ASSERT(centers[prims[highSortedIndex]][axis]<=prevUpperCenter);
-					upper.include(boxes[prims[highSortedIndex]]);
+		PX_ASSERT(centers[prims[highSortedIndex]][axis]<=prevUpperCenter);
+		upper.include(boxes[prims[highSortedIndex]]);
 #if PX_ENABLE_ASSERTS
-					prevUpperCenter = centers[prims[highSortedIndex]][axis];
+		prevUpperCenter = centers[prims[highSortedIndex]][axis];
 #endif
 
-				cumulativeLower[i] = getSurfaceArea(lower);
-				cumulativeUpper[nb - i - 1] = getSurfaceArea(upper);
-			}
+		cumulativeLower[i] = getSurfaceArea(lower);
+		cumulativeUpper[nb - i - 1] = getSurfaceArea(upper);
+	}
 
-//			const float invTotalSA = 1.0f / cumulativeUpper[0];
+	// test all split positions
+	for (PxU32 i = 0; i < nb - 1; ++i)
+	{
+		const float pBelow = cumulativeLower[i];
+		const float pAbove = cumulativeUpper[i];
 
-			// test all split positions
-			for (PxU32 i = 0; i < nb - 1; ++i)
-			{
-				const float pBelow = cumulativeLower[i];// * invTotalSA;
-				const float pAbove = cumulativeUpper[i];// * invTotalSA;
-
-//				const float cost = 0.125f + (pBelow * i + pAbove * float(nb - i));
-				const float cost = (pBelow * i + pAbove * float(nb - i));
-				if(cost <= bestCost)
-				{
-					bestCost = cost;
-					bestIndex = i;
-					bestAxis = axis;
-				}
-			}
+		const float cost = (pBelow * i + pAbove * float(nb - i));
+		if(cost <= bestCost)
+		{
+			bestCost = cost;
+			bestIndex = i;
+			found = true;
 		}
 	}
+	return found;
+}
 
+bool SAH_Buffers::applySplit(PxU32& leftCount, PxU32 bestAxis, PxU32 bestIndex, PxU32 nb, const PxU32* PX_RESTRICT prims)
+{
 	leftCount = bestIndex + 1;
 
 	if(leftCount==1 || leftCount==nb)
@@ -168,14 +136,6 @@ bool SAH_Buffers::split(PxU32& leftCount, PxU32 nb, const PxU32* PX_RESTRICT pri
 		return false;
 	}
 
-/*
-    // re-sort by best axis
-    FaceSorter predicate(&m_vertices[0], &m_indices[0], m_numFaces * 3, bestAxis);
-    std::sort(faces, faces + numFaces, predicate);
-
-    return bestIndex + 1;
-*/
-
 	{
 		PxU32* tmp = reinterpret_cast<PxU32*>(mKeys);
 		PxMemCopy(tmp, prims, nb*sizeof(PxU32));
@@ -190,3 +150,84 @@ bool SAH_Buffers::split(PxU32& leftCount, PxU32 nb, const PxU32* PX_RESTRICT pri
 	return true;
 }
 
+namespace
+{
+	class SAHSweepTask : public BuildTask
+	{
+		public:
+		virtual	void	runInternal()
+		{
+			mBestCost = PX_MAX_F32;
+			mBestIndex = 0;
+			const PxU32 offset = mAxis*mBuffers->mNb;
+			mFound = mBuffers->sweepAxis(mAxis, mBestCost, mBestIndex, mNb, mPrims, mBoxes, mCenters,
+				mBuffers->mKeys + offset, mBuffers->mCumulativeLower + offset, mBuffers->mCumulativeUpper + offset);
+		}
+
+		virtual	const char*	getName()	const	{ return "SAHSweepTask";	}
+
+		SAH_Buffers*		mBuffers;
+		const PxU32*		mPrims;
+		const PxBounds3*	mBoxes;
+		const PxVec3*		mCenters;
+		PxU32				mNb;
+		PxU32				mAxis;
+		// Results
+		float				mBestCost;
+		PxU32				mBestIndex;
+		bool				mFound;
+	};
+}
+
+bool SAH_Buffers::split(PxU32& leftCount, PxU32 nb, const PxU32* PX_RESTRICT prims, const PxBounds3* PX_RESTRICT boxes, const PxVec3* PX_RESTRICT centers)
+{
+	PxU32 bestAxis = 0;
+	PxU32 bestIndex = 0;
+	float bestCost = PX_MAX_F32;
+
+	PX_ASSERT(nb<=mNb);
+	if(mDispatcher && nb>=SAH_PARALLEL_SWEEP_LIMIT)
+	{
+		// PT: sweep Y and Z in tasks while the calling thread sweeps X. The results are then merged in the same order
+		// (and with the same tie-breaking rule) as in the serial loop below, so both versions select the same split.
+		BuildTaskSync sync;
+		SAHSweepTask tasks[3];
+		for(PxU32 axis=1;axis<3;axis++)
+		{
+			SAHSweepTask& task = tasks[axis];
+			task.mBuffers	= this;
+			task.mPrims		= prims;
+			task.mBoxes		= boxes;
+			task.mCenters	= centers;
+			task.mNb		= nb;
+			task.mAxis		= axis;
+			sync.submit(*mDispatcher, task);
+		}
+
+		tasks[0].mBestCost = PX_MAX_F32;
+		tasks[0].mBestIndex = 0;
+		tasks[0].mFound = sweepAxis(0, tasks[0].mBestCost, tasks[0].mBestIndex, nb, prims, boxes, centers, mKeys, mCumulativeLower, mCumulativeUpper);
+
+		sync.wait();
+
+		for(PxU32 axis=0;axis<3;axis++)
+		{
+			if(tasks[axis].mFound && tasks[axis].mBestCost<=bestCost)
+			{
+				bestCost = tasks[axis].mBestCost;
+				bestIndex = tasks[axis].mBestIndex;
+				bestAxis = axis;
+			}
+		}
+	}
+	else
+	{
+		for(PxU32 axis=0;axis<3;axis++)
+		{
+			if(sweepAxis(axis, bestCost, bestIndex, nb, prims, boxes, centers, mKeys, mCumulativeLower, mCumulativeUpper))
+				bestAxis = axis;
+		}
+	}
+
+	return applySplit(leftCount, bestAxis, bestIndex, nb, prims);
+}
@@ -34,23 +34,36 @@
 */
 
 #include "foundation/PxBounds3.h"
+#include "foundation/PxUserAllocated.h"
 #include "CmRadixSort.h"
 
 namespace physx
 {
+	class PxCpuDispatcher;
+
 namespace Gu
 {
-	struct SAH_Buffers
+	struct SAH_Buffers : public PxUserAllocated
 	{
-								SAH_Buffers(PxU32 nb_prims);
+		// PT: when a dispatcher is given, large nodes sweep the three axes in parallel. This needs one set of key &
+		// cumulative buffers per axis so the buffers are three times larger in that case.
+								SAH_Buffers(PxU32 nb_prims, PxCpuDispatcher* dispatcher=NULL);
 								~SAH_Buffers();
 
 		bool					split(PxU32& leftCount, PxU32 nb, const PxU32* PX_RESTRICT prims, const PxBounds3* PX_RESTRICT boxes, const PxVec3* PX_RESTRICT centers);
 
+		// PT: the two halves of split(), exposed for the parallel builder. Each axis only touches its own sorter, so the three
+		// sweeps can run concurrently as long as they use distinct key/cumulative buffers. sweepAxis returns true if it found
+		// a split cheaper than (or equal to) the input bestCost, in which case bestCost & bestIndex are updated.
+		bool					sweepAxis(PxU32 axis, float& bestCost, PxU32& bestIndex, PxU32 nb, const PxU32* PX_RESTRICT prims, const PxBounds3* PX_RESTRICT boxes, const PxVec3* PX_RESTRICT centers,
+											float* PX_RESTRICT keys, float* PX_RESTRICT cumulativeLower, float* PX_RESTRICT cumulativeUpper);
+		bool					applySplit(PxU32& leftCount, PxU32 bestAxis, PxU32 bestIndex, PxU32 nb, const PxU32* PX_RESTRICT prims);
+
 		Cm::RadixSortBuffered	mSorters[3];
 		float*					mKeys;
 		float*					mCumulativeLower;
 		float*					mCumulativeUpper;
+		PxCpuDispatcher*		mDispatcher;
 		PxU32					mNb;
 	};
 }
@@ -1368,6 +1368,348 @@ namespace Gu
 	}
 	
 
+	//Data shared by the threads of the narrow band sparse sdf builder. The first pass computes the coarse samples, one row of
+	//samples along x per work item. The second pass computes the fine samples of the subgrid blocks that may overlap the narrow band.
+	struct SparseSDFCalculationData
+	{
+		const PxVec3* vertices;
+		const PxU32* indices;
+		const Gu::BVHNode* tree;
+		const PxHashMap<PxU32, Gu::ClusterApproximation>* clusters;
+		PxVec3 minExtents;
+		PxVec3 delta;
+		PxU32 cellsPerSubgrid;
+		PxU32 w;
+		PxU32 h;
+		PxReal* sdfCoarse;
+		const PxU32* candidateBlocks;
+		PxReal* candidateData;
+		PxI32 batchSize;
+		PxI32 end;
+		PxI32* progress;
+		bool coarsePass;
+	};
+
+	//Computes the signed distance of a sample. The closest point query is warm-started with the triangle found for the previous sample.
+	//The sign is copied from a neighbor sample if no surface lies between the two, i.e. if the neighbor is further away from the surface
+	//than from the sample, or if the segment between them does not intersect the mesh. Otherwise the winding number decides.
+	PX_FORCE_INLINE PxReal computeSignedDistance(const SparseSDFCalculationData& d, LineSegmentTrimeshIntersectionTraversalController& intersector, const PxVec3& queryPoint, PxI32& lastTriangle,
+		const PxReal* neighbor, const PxVec3& neighborPoint)
+	{
+		ClosestDistanceToTrimeshTraversalController cd(d.indices, d.vertices, const_cast<Gu::BVHNode*>(d.tree), queryPoint);
+		if (lastTriangle != -1)
+		{
+			const PxU32* tri = &d.indices[3 * lastTriangle];
+			PxReal s, t;
+			const PxVec3 closest = Gu::closestPtPointTriangle(queryPoint, d.vertices[tri[0]], d.vertices[tri[1]], d.vertices[tri[2]], s, t);
+			cd.setClosestStart((closest - queryPoint).magnitudeSquared(), lastTriangle, closest);
+		}
+		Gu::traverseBVH(d.tree, cd);
+		lastTriangle = cd.getClosestTriId();
+
+		const PxReal distance = (cd.closestPoint() - queryPoint).magnitude();
+
+		bool sameSignAsNeighbor = false;
+		if (neighbor)
+		{
+			if (PxAbs(*neighbor) > (neighborPoint - queryPoint).magnitude())
+				sameSignAsNeighbor = true;
+			else
+			{
+				intersector.reset(neighborPoint, queryPoint);
+				Gu::traverseBVH(d.tree, intersector);
+				sameSignAsNeighbor = !intersector.intersectionDetected();
+			}
+		}
+
+		bool inside;
+		if (sameSignAsNeighbor)
+			inside = *neighbor < 0.0f;
+		else
+			inside = Gu::computeWindingNumber(d.tree, queryPoint, *d.clusters, d.indices, d.vertices) > 0.5f;
+
+		return inside ? -distance : distance;
+	}
+
+	PX_FORCE_INLINE PxVec3 getSamplePoint(const SparseSDFCalculationData& d, PxU32 x, PxU32 y, PxU32 z)
+	{
+		return d.minExtents + PxVec3(x * d.delta.x, y * d.delta.y, z * d.delta.z);
+	}
+
+	void computeCoarseRow(const SparseSDFCalculationData& d, LineSegmentTrimeshIntersectionTraversalController& intersector, PxU32 row, PxI32& lastTriangle)
+	{
+		PxU32 y, z;
+		idToXY(row, d.h + 1, y, z);
+
+		const PxU32 s = d.cellsPerSubgrid;
+		PxReal* sdf = &d.sdfCoarse[idx(0, y, z, d.w, d.h)];
+		for (PxU32 x = 0; x <= d.w; ++x)
+		{
+			const PxVec3 p = getSamplePoint(d, x * s, y * s, z * s);
+			sdf[x] = computeSignedDistance(d, intersector, p, lastTriangle, x > 0 ? &sdf[x - 1] : NULL, getSamplePoint(d, (x - 1) * s, y * s, z * s));
+		}
+	}
+
+	void computeCandidateBlock(const SparseSDFCalculationData& d, LineSegmentTrimeshIntersectionTraversalController& intersector, PxU32 candidate, PxI32& lastTriangle)
+	{
+		const PxU32 s = d.cellsPerSubgrid;
+		PxU32 xBlock, yBlock, zBlock;
+		idToXYZ(d.candidateBlocks[candidate], d.w, d.h, xBlock, yBlock, zBlock);
+
+		PxReal* sdf = &d.candidateData[candidate * (s + 1) * (s + 1) * (s + 1)];
+		for (PxU32 zLocal = 0; zLocal <= s; ++zLocal)
+		{
+			for (PxU32 yLocal = 0; yLocal <= s; ++yLocal)
+			{
+				for (PxU32 xLocal = 0; xLocal <= s; ++xLocal)
+				{
+					PxReal& value = sdf[idx(xLocal, yLocal, zLocal, s, s)];
+
+					//The block corners are the coarse samples, reuse them so that both grids agree exactly
+					if ((xLocal == 0 || xLocal == s) && (yLocal == 0 || yLocal == s) && (zLocal == 0 || zLocal == s))
+					{
+						value = d.sdfCoarse[idx(xBlock + xLocal / s, yBlock + yLocal / s, zBlock + zLocal / s, d.w, d.h)];
+						continue;
+					}
+
+					const PxU32 x = xBlock * s + xLocal;
+					const PxU32 y = yBlock * s + yLocal;
+					const PxU32 z = zBlock * s + zLocal;
+
+					const PxReal* neighbor;
+					PxVec3 neighborPoint;
+					if (xLocal > 0)
+					{
+						neighbor = &sdf[idx(xLocal - 1, yLocal, zLocal, s, s)];
+						neighborPoint = getSamplePoint(d, x - 1, y, z);
+					}
+					else if (yLocal > 0)
+					{
+						neighbor = &sdf[idx(xLocal, yLocal - 1, zLocal, s, s)];
+						neighborPoint = getSamplePoint(d, x, y - 1, z);
+					}
+					else
+					{
+						neighbor = &sdf[idx(xLocal, yLocal, zLocal - 1, s, s)];
+						neighborPoint = getSamplePoint(d, x, y, z - 1);
+					}
+					value = computeSignedDistance(d, intersector, getSamplePoint(d, x, y, z), lastTriangle, neighbor, neighborPoint);
+				}
+			}
+		}
+	}
+
+	void* computeSparseSDFThreadJob(void* data)
+	{
+		SparseSDFCalculationData& d = *reinterpret_cast<SparseSDFCalculationData*>(data);
+
+		PxI32 lastTriangle = -1;
+		LineSegmentTrimeshIntersectionTraversalController intersector(d.indices, d.vertices, PxVec3(0.0f), PxVec3(0.0f));
+
+		PxI32 start = physx::PxAtomicAdd(d.progress, d.batchSize) - d.batchSize;
+		while (start < d.end)
+		{
+			const PxI32 end = PxMin(d.end, start + d.batchSize);
+			for (PxI32 id = start; id < end; ++id)
+			{
+				if (d.coarsePass)
+					computeCoarseRow(d, intersector, id, lastTriangle);
+				else
+					computeCandidateBlock(d, intersector, id, lastTriangle);
+			}
+			start = physx::PxAtomicAdd(d.progress, d.batchSize) - d.batchSize;
+		}
+		return NULL;
+	}
+
+	void runSparseSDFThreadJobs(PxArray<SparseSDFCalculationData>& perThreadData)
+	{
+		if (perThreadData.size() == 1)
+		{
+			computeSparseSDFThreadJob(&perThreadData[0]);
+			return;
+		}
+
+		PxArray<PxThread*> threads;
+		for (PxU32 i = 0; i < perThreadData.size(); ++i)
+		{
+			threads.pushBack(PX_NEW(PxThread)(computeSparseSDFThreadJob, &perThreadData[i], "thread"));
+			threads[i]->start();
+		}
+
+		for (PxU32 i = 0; i < threads.size(); ++i)
+		{
+			threads[i]->waitForQuit();
+		}
+
+		for (PxU32 i = 0; i < threads.size(); ++i)
+		{
+			threads[i]->~PxThreadT();
+			PX_FREE(threads[i]);
+		}
+	}
+
+	void SDFUsingWindingNumbersSparseNarrowBand(const PxVec3* vertices, const PxU32* indices, PxU32 numTriangleIndices, PxU32 width, PxU32 height, PxU32 depth,
+		const PxVec3& minExtents, const PxVec3& maxExtents, PxReal narrowBandThickness, PxU32 cellsPerSubgrid,
+		PxArray<PxReal>& sdfCoarse, PxArray<PxU32>& sdfFineStartSlots, PxArray<PxReal>& subgridData,
+		PxReal& subgridsMinSdfValue, PxReal& subgridsMaxSdfValue, PxU32 numThreads)
+	{
+		PX_ASSERT(width % cellsPerSubgrid == 0);
+		PX_ASSERT(height % cellsPerSubgrid == 0);
+		PX_ASSERT(depth % cellsPerSubgrid == 0);
+
+		//Meshes with holes need the sdf repair pass, which operates on the dense grid
+		if (!MeshAnalyzer::checkMeshWatertightness(reinterpret_cast<const Triangle*>(indices), numTriangleIndices / 3))
+		{
+			PxArray<PxReal> denseSdf;
+			SDFUsingWindingNumbersSparse(vertices, indices, numTriangleIndices, width, height, depth, minExtents, maxExtents, narrowBandThickness, cellsPerSubgrid,
+				sdfCoarse, sdfFineStartSlots, subgridData, denseSdf, subgridsMinSdfValue, subgridsMaxSdfValue, numThreads);
+			return;
+		}
+
+		const PxVec3 extents(maxExtents - minExtents);
+		const PxVec3 delta(extents.x / width, extents.y / height, extents.z / depth);
+
+		const PxU32 w = width / cellsPerSubgrid;
+		const PxU32 h = height / cellsPerSubgrid;
+		const PxU32 d = depth / cellsPerSubgrid;
+		const PxU32 valuesPerSubgrid = (cellsPerSubgrid + 1) * (cellsPerSubgrid + 1) * (cellsPerSubgrid + 1);
+
+		PxArray<Gu::BVHNode> tree;
+		buildTree(indices, numTriangleIndices / 3, vertices, tree);
+
+		PxHashMap<PxU32, Gu::ClusterApproximation> clusters;
+		Gu::precomputeClusterInformation(tree.begin(), indices, numTriangleIndices / 3, vertices, clusters);
+
+		numThreads = PxMax(numThreads, 1u);
+		PxI32 progress = 0;
+
+		PxArray<SparseSDFCalculationData> perThreadData;
+		perThreadData.resize(numThreads);
+		for (PxU32 i = 0; i < numThreads; ++i)
+		{
+			SparseSDFCalculationData& data = perThreadData[i];
+			data.vertices = vertices;
+			data.indices = indices;
+			data.tree = tree.begin();
+			data.clusters = &clusters;
+			data.minExtents = minExtents;
+			data.delta = delta;
+			data.cellsPerSubgrid = cellsPerSubgrid;
+			data.w = w;
+			data.h = h;
+			data.sdfCoarse = NULL;
+			data.candidateBlocks = NULL;
+			data.candidateData = NULL;
+			data.batchSize = 4;
+			data.end = 0;
+			data.progress = &progress;
+			data.coarsePass = true;
+		}
+
+		//Pass 1: exact coarse samples
+		sdfCoarse.clear();
+		sdfCoarse.resize((w + 1) * (h + 1) * (d + 1));
+		for (PxU32 i = 0; i < numThreads; ++i)
+		{
+			perThreadData[i].sdfCoarse = sdfCoarse.begin();
+			perThreadData[i].end = (h + 1) * (d + 1);
+		}
+		runSparseSDFThreadJobs(perThreadData);
+
+		//Select the blocks that may overlap the narrow band. The sdf changes by at most the distance between two points, so every
+		//sample of a block is at least as far from the surface as the furthest corner minus the block diagonal, and as the closest
+		//corner minus half the block diagonal.
+		const PxReal blockDiagonal = (delta * PxReal(cellsPerSubgrid)).magnitude();
+		PxArray<PxU32> candidateBlocks;
+		for (PxU32 zBlock = 0; zBlock < d; ++zBlock)
+			for (PxU32 yBlock = 0; yBlock < h; ++yBlock)
+				for (PxU32 xBlock = 0; xBlock < w; ++xBlock)
+				{
+					PxReal minAbsValue = FLT_MAX;
+					PxReal maxAbsValue = 0.0f;
+					PxU32 nbNegative = 0;
+					for (PxU32 corner = 0; corner < 8; ++corner)
+					{
+						const PxReal v = sdfCoarse[idx(xBlock + (corner & 1), yBlock + ((corner >> 1) & 1), zBlock + (corner >> 2), w, h)];
+						minAbsValue = PxMin(minAbsValue, PxAbs(v));
+						maxAbsValue = PxMax(maxAbsValue, PxAbs(v));
+						if (v < 0.0f)
+							++nbNegative;
+					}
+
+					const PxReal lowerBound = PxMax(maxAbsValue - blockDiagonal, minAbsValue - 0.5f * blockDiagonal);
+					if ((nbNegative == 0 || nbNegative == 8) && lowerBound > narrowBandThickness)
+						continue;
+
+					candidateBlocks.pushBack(idxCompact(xBlock, yBlock, zBlock, w, h));
+				}
+
+		//Pass 2: exact fine samples of the candidate blocks
+		PxArray<PxReal> candidateData;
+		candidateData.resize(candidateBlocks.size() * valuesPerSubgrid);
+		progress = 0;
+		for (PxU32 i = 0; i < numThreads; ++i)
+		{
+			perThreadData[i].candidateBlocks = candidateBlocks.begin();
+			perThreadData[i].candidateData = candidateData.begin();
+			perThreadData[i].batchSize = 1;
+			perThreadData[i].end = candidateBlocks.size();
+			perThreadData[i].coarsePass = false;
+		}
+		if (candidateBlocks.size())
+			runSparseSDFThreadJobs(perThreadData);
+
+		//Same subgrid selection as SDFUsingWindingNumbersSparse, restricted to the candidate blocks
+		sdfFineStartSlots.clear();
+		sdfFineStartSlots.resize(w * h * d, 0xFFFFFFFF);
+		subgridData.clear();
+
+		Interval narrowBandInterval(-narrowBandThickness, narrowBandThickness);
+		DenseSDF<PxReal> coarseEval(w, h, d, sdfCoarse.begin());
+		const PxReal s = 1.0f / cellsPerSubgrid;
+		const PxReal errorThreshold = 1e-6f * extents.magnitude();
+
+		subgridsMaxSdfValue = -FLT_MAX;
+		subgridsMinSdfValue = FLT_MAX;
+		PxU32 subgridIndexer = 0;
+		for (PxU32 i = 0; i < candidateBlocks.size(); ++i)
+		{
+			PxU32 xBlock, yBlock, zBlock;
+			idToXYZ(candidateBlocks[i], w, h, xBlock, yBlock, zBlock);
+
+			const PxReal* sdfFine = &candidateData[i * valuesPerSubgrid];
+
+			Interval inverval;
+			PxReal maxAbsError = 0.0f;
+			for (PxU32 zLocal = 0; zLocal <= cellsPerSubgrid; ++zLocal)
+				for (PxU32 yLocal = 0; yLocal <= cellsPerSubgrid; ++yLocal)
+					for (PxU32 xLocal = 0; xLocal <= cellsPerSubgrid; ++xLocal)
+					{
+						const PxReal sdfValue = sdfFine[idx(xLocal, yLocal, zLocal, cellsPerSubgrid, cellsPerSubgrid)];
+						inverval.max = PxMax(inverval.max, sdfValue);
+						inverval.min = PxMin(inverval.min, sdfValue);
+
+						maxAbsError = PxMax(maxAbsError, PxAbs(sdfValue - coarseEval.sampleSDFDirect(PxVec3(xBlock + xLocal * s, yBlock + yLocal * s, zBlock + zLocal * s))));
+					}
+
+			if (!narrowBandInterval.overlaps(inverval) || maxAbsError < errorThreshold)
+				continue;
+
+			subgridsMaxSdfValue = PxMax(subgridsMaxSdfValue, inverval.max);
+			subgridsMinSdfValue = PxMin(subgridsMinSdfValue, inverval.min);
+
+			//For debugging
+			if (cellsPerSubgrid == 1)
+				continue;
+
+			for (PxU32 j = 0; j < valuesPerSubgrid; ++j)
+				subgridData.pushBack(sdfFine[j]);
+			sdfFineStartSlots[candidateBlocks[i]] = subgridIndexer;
+			++subgridIndexer;
+		}
+	}
+
 	PX_FORCE_INLINE void decodeTriple(PxU32 id, PxU32& x, PxU32& y, PxU32& z)
 	{
 		x = id & 0x000003FF;
@@ -1832,6 +2174,154 @@ namespace Gu
 			}
 		}
 	}
+
+	//Trilinear interpolation of the 8 samples of a cell, stored in the order corners[x + 2*y + 4*z]. The z interpolation is done
+	//on 4 lanes at once, then the 4 results are blended with the bilinear weights. The gradient is expressed in cell units.
+	static PX_FORCE_INLINE PxReal trilerpSIMD(const PxReal* PX_RESTRICT corners, PxReal tx, PxReal ty, PxReal tz, PxVec3* gradient)
+	{
+		using namespace aos;
+		const Vec4V c0 = V4LoadU(corners);
+		const Vec4V c1 = V4LoadU(corners + 4);
+		const Vec4V dz = V4Sub(c1, c0);
+		const Vec4V cz = V4ScaleAdd(dz, FLoad(tz), c0);
+
+		const PxReal ux = 1.0f - tx;
+		const PxReal uy = 1.0f - ty;
+		const Vec4V weights = V4LoadXYZW(ux * uy, tx * uy, ux * ty, tx * ty);
+
+		PxReal result;
+		FStore(V4Dot(cz, weights), &result);
+
+		if (gradient)
+		{
+			FStore(V4Dot(cz, V4LoadXYZW(-uy, uy, -ty, ty)), &gradient->x);
+			FStore(V4Dot(cz, V4LoadXYZW(-ux, -tx, ux, tx)), &gradient->y);
+			FStore(V4Dot(dz, weights), &gradient->z);
+		}
+		return result;
+	}
+
+	//Splits a grid coordinate in [0, nbCells] into a cell index and the position inside the cell
+	static PX_FORCE_INLINE void getCell(PxReal coord, PxU32 nbCells, PxU32& cell, PxReal& t)
+	{
+		cell = PxMin(PxU32(coord), nbCells - 1);
+		t = coord - PxReal(cell);
+	}
+
+	static PX_FORCE_INLINE PxReal sampleSDFInternal(const Gu::SDF& sdf, const PxVec3& localPos, PxVec3* gradient)
+	{
+		//Dense sdfs store their samples at the cell centers, sparse sdfs at the cell corners
+		const PxU32 subgridSize = sdf.mSubgridSize;
+		const PxU32 nbCellsX = subgridSize ? sdf.mDims.x : sdf.mDims.x - 1;
+		const PxU32 nbCellsY = subgridSize ? sdf.mDims.y : sdf.mDims.y - 1;
+		const PxU32 nbCellsZ = subgridSize ? sdf.mDims.z : sdf.mDims.z - 1;
+		PX_ASSERT(nbCellsX && nbCellsY && nbCellsZ);
+
+		const PxVec3 lower = subgridSize ? sdf.mMeshLower : sdf.mMeshLower + PxVec3(0.5f * sdf.mSpacing);
+		const PxVec3 upper = lower + PxVec3(PxReal(nbCellsX), PxReal(nbCellsY), PxReal(nbCellsZ)) * sdf.mSpacing;
+		const PxVec3 clamped = localPos.maximum(lower).minimum(upper);
+		const PxVec3 coords = (clamped - lower) * (1.0f / sdf.mSpacing);
+
+		PxReal corners[8];
+		PxReal tx, ty, tz;
+		PxReal cellSize = sdf.mSpacing;
+		if (!subgridSize)
+		{
+			PxU32 x, y, z;
+			getCell(coords.x, nbCellsX, x, tx);
+			getCell(coords.y, nbCellsY, y, ty);
+			getCell(coords.z, nbCellsZ, z, tz);
+			for (PxU32 i = 0; i < 8; ++i)
+				corners[i] = sdf.mSdf[idxCompact(x + (i & 1), y + ((i >> 1) & 1), z + (i >> 2), sdf.mDims.x, sdf.mDims.y)];
+		}
+		else
+		{
+			const PxU32 nbX = sdf.mDims.x / subgridSize;
+			const PxU32 nbY = sdf.mDims.y / subgridSize;
+			const PxU32 nbZ = sdf.mDims.z / subgridSize;
+			const PxReal s = PxReal(subgridSize);
+
+			PxU32 xBlock, yBlock, zBlock;
+			PxReal xLocal, yLocal, zLocal;
+			getCell(coords.x / s, nbX, xBlock, xLocal);
+			getCell(coords.y / s, nbY, yBlock, yLocal);
+			getCell(coords.z / s, nbZ, zBlock, zLocal);
+
+			const PxU32 startSlot = sdf.mSubgridStartSlots[idxCompact(xBlock, yBlock, zBlock, nbX, nbY)];
+			if (startSlot == 0xFFFFFFFFu)
+			{
+				//No subgrid, interpolate the coarse grid
+				for (PxU32 i = 0; i < 8; ++i)
+					corners[i] = sdf.mSdf[idx(xBlock + (i & 1), yBlock + ((i >> 1) & 1), zBlock + (i >> 2), nbX, nbY)];
+				tx = xLocal;
+				ty = yLocal;
+				tz = zLocal;
+				cellSize *= s;
+			}
+			else
+			{
+				PxU32 x, y, z;
+				getCell(xLocal * s, subgridSize, x, tx);
+				getCell(yLocal * s, subgridSize, y, ty);
+				getCell(zLocal * s, subgridSize, z, tz);
+
+				PxU32 xBase, yBase, zBase;
+				decodeTriple(startSlot, xBase, yBase, zBase);
+				x += xBase * (subgridSize + 1);
+				y += yBase * (subgridSize + 1);
+				z += zBase * (subgridSize + 1);
+
+				const PxU32 w = sdf.mSdfSubgrids3DTexBlockDim.x * (subgridSize + 1);
+				const PxU32 h = sdf.mSdfSubgrids3DTexBlockDim.y * (subgridSize + 1);
+				for (PxU32 i = 0; i < 8; ++i)
+				{
+					const PxU32 index = idxCompact(x + (i & 1), y + ((i >> 1) & 1), z + (i >> 2), w, h);
+					corners[i] = decode(&sdf.mSubgridSdf[sdf.mBytesPerSparsePixel * index], sdf.mBytesPerSparsePixel, sdf.mSubgridsMinSdfValue, sdf.mSubgridsMaxSdfValue);
+				}
+			}
+		}
+
+		PxReal distance = trilerpSIMD(corners, tx, ty, tz, gradient);
+		if (gradient)
+			*gradient *= 1.0f / cellSize;
+
+		//Points outside of the bounds get the distance to the bounds added. Along the clamped axes, the gradient is the one of that distance.
+		const PxVec3 offset = localPos - clamped;
+		const PxReal outsideDistanceSquared = offset.magnitudeSquared();
+		if (outsideDistanceSquared > 0.0f)
+		{
+			const PxReal outsideDistance = PxSqrt(outsideDistanceSquared);
+			distance += outsideDistance;
+			if (gradient)
+			{
+				for (PxU32 i = 0; i < 3; ++i)
+				{
+					if (offset[i] != 0.0f)
+						(*gradient)[i] = offset[i] / outsideDistance;
+				}
+			}
+		}
+		return distance;
+	}
+
+	PxReal sampleSDF(const Gu::SDF& sdf, const PxVec3& localPos, PxVec3* gradient)
+	{
+		return sampleSDFInternal(sdf, localPos, gradient);
+	}
+
+	void sampleSDFs(const Gu::SDF& sdf, PxU32 nbPoints, const PxVec3* localPoints, PxReal* distances, PxVec3* gradients)
+	{
+		if (gradients)
+		{
+			for (PxU32 i = 0; i < nbPoints; ++i)
+				distances[i] = sampleSDFInternal(sdf, localPoints[i], &gradients[i]);
+		}
+		else
+		{
+			for (PxU32 i = 0; i < nbPoints; ++i)
+				distances[i] = sampleSDFInternal(sdf, localPoints[i], NULL);
+		}
+	}
 }
 
 }
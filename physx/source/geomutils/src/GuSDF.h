@@ -233,6 +233,34 @@ namespace physx
 			PxReal& subgridsMinSdfValue, PxReal& subgridsMaxSdfValue, PxU32 numThreads = 1);
 	
 
+		/**
+		\brief Same as SDFUsingWindingNumbersSparse, but only evaluates the samples that are needed for the sparse format instead of
+		computing the full dense sdf first. The coarse samples are computed first. Then only the subgrid blocks that can overlap the
+		narrow band are evaluated at full resolution. Meshes that are not watertight fall back to SDFUsingWindingNumbersSparse,
+		because their distances are repaired on the dense grid.
+
+		\param[in] vertices The triangle mesh's vertices
+		\param[in] indices The triangle mesh's indices
+		\param[in] numTriangleIndices The number of indices
+		\param[in] width The number of grid points along the x direction
+		\param[in] height The number of grid points along the y direction
+		\param[in] depth The number of grid points along the z direction
+		\param[in] minExtents The grid's lower corner, the box formed by minExtent and maxExtent must include all vertices
+		\param[in] maxExtents The grid's upper corner, the box formed by minExtent and maxExtent must include all vertices
+		\param[in] narrowBandThickness The thickness of the narrow band
+		\param[in] cellsPerSubgrid The number of cells in a sparse subgrid block (full block has mSubgridSize^3 cells and (mSubgridSize+1)^3 samples)
+		\param[out] sdfCoarse The coarse sdf as a dense 3d array of lower resolution (resulution is (with/cellsPerSubgrid+1, height/cellsPerSubgrid+1, depth/cellsPerSubgrid+1))
+		\param[out] sdfFineStartSlots The start slot indices of the subgrid blocks. If a subgrid block is empty, the start slot will be 0xFFFFFFFF
+		\param[out] subgridData The array containing subgrid data blocks
+		\param[out] subgridsMinSdfValue The minimum value over all subgrid blocks. Used if normalized textures are used which is the case for 8 and 16bit formats
+		\param[out] subgridsMaxSdfValue	The maximum value over all subgrid blocks. Used if normalized textures are used which is the case for 8 and 16bit formats
+		\param[in] numThreads The number of cpu threads to use during the computation
+		*/
+		PX_PHYSX_COMMON_API void SDFUsingWindingNumbersSparseNarrowBand(const PxVec3* vertices, const PxU32* indices, PxU32 numTriangleIndices, PxU32 width, PxU32 height, PxU32 depth,
+			const PxVec3& minExtents, const PxVec3& maxExtents, PxReal narrowBandThickness, PxU32 cellsPerSubgrid,
+			PxArray<PxReal>& sdfCoarse, PxArray<PxU32>& sdfFineStartSlots, PxArray<PxReal>& subgridData,
+			PxReal& subgridsMinSdfValue, PxReal& subgridsMaxSdfValue, PxU32 numThreads = 1);
+
 		/**
 		\brief Converts a sparse grid sdf to a format that can be used to create a 3d texture. 3d textures support very efficient 
 		trilinear interpolation on the GPU which is very important during sdf evaluation.
@@ -261,6 +289,28 @@ namespace physx
 		\param[out] isosurfaceTriangleIndices The triangles of the extracted isosurface
 		*/
 		PX_PHYSX_COMMON_API void extractIsosurfaceFromSDF(const Gu::SDF& sdf, PxArray<PxVec3>& isosurfaceVertices, PxArray<PxU32>& isosurfaceTriangleIndices);
+
+		/**
+		\brief Samples a dense or sparse signed distance field with trilinear interpolation. Points outside of the sdf bounds are
+		clamped to the bounds, and their distance to the bounds is added to the result.
+
+		\param[in] sdf The signed distance function
+		\param[in] localPos The sample position, in the sdf's space (i.e. the mesh's vertex space)
+		\param[out] gradient Optional gradient of the interpolated field at the sample position
+		\return The interpolated signed distance
+		*/
+		PX_PHYSX_COMMON_API PxReal sampleSDF(const Gu::SDF& sdf, const PxVec3& localPos, PxVec3* gradient = NULL);
+
+		/**
+		\brief Batched version of sampleSDF.
+
+		\param[in] sdf The signed distance function
+		\param[in] nbPoints The number of sample positions
+		\param[in] localPoints The sample positions, in the sdf's space
+		\param[out] distances The interpolated signed distances, one per point
+		\param[out] gradients Optional gradients of the interpolated field, one per point
+		*/
+		PX_PHYSX_COMMON_API void sampleSDFs(const Gu::SDF& sdf, PxU32 nbPoints, const PxVec3* localPoints, PxReal* distances, PxVec3* gradients = NULL);
 	}
 }
 
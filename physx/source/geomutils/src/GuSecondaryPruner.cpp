@@ -89,6 +89,12 @@ class CompanionPrunerBucket : public CompanionPruner
 							return mPrunerCore.overlap(queryVolume, prunerCallback);
 						return true;
 					}
+	virtual	bool	cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& prunerCallback)	const
+					{
+						if(mPrunerCore.getNbObjects())
+							return mPrunerCore.cull(nbPlanes, planes, prunerCallback);
+						return true;
+					}
 	virtual	bool	sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback)	const
 					{
 						if(mPrunerCore.getNbObjects())
@@ -155,6 +161,12 @@ class CompanionPrunerIncremental : public CompanionPruner
 							return mPrunerCore.overlap(queryVolume, prunerCallback);
 						return true;
 					}
+	virtual	bool	cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& prunerCallback)	const
+					{
+						if(mPrunerCore.getNbObjects())
+							return mPrunerCore.cull(nbPlanes, planes, prunerCallback);
+						return true;
+					}
 	virtual	bool	sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback)	const
 					{
 						if(mPrunerCore.getNbObjects())
@@ -211,6 +223,7 @@ class CompanionPrunerAABBTree : public CompanionPruner
 	virtual			void					visualize(PxRenderOutput& out, PxU32 color)	const;
 	virtual			bool					raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback)	const;
 	virtual			bool					overlap(const ShapeData& queryVolume, PrunerOverlapCallback& prunerCallback)	const;
+	virtual			bool					cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& prunerCallback)	const;
 	virtual			bool					sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback)	const;
 	virtual			void					getGlobalBounds(PxBounds3& bounds)	const;
 
@@ -866,10 +879,6 @@ bool CompanionPrunerAABBTree::raycast(const PxVec3& origin, const PxVec3& unitDi
 	return true;
 }
 
-// PT: TODO: this is copied from SqBounds.h, should be either moved to Gu and shared or passed as a user parameter
-	#define SQ_PRUNER_EPSILON	0.005f
-	#define SQ_PRUNER_INFLATION	(1.0f + SQ_PRUNER_EPSILON)	// pruner test shape inflation (not narrow phase shape)
-
 bool CompanionPrunerAABBTree::overlap(const ShapeData& queryVolume, PrunerOverlapCallback& prunerCallback) const
 {
 	PX_UNUSED(queryVolume);
@@ -978,6 +987,28 @@ bool CompanionPrunerAABBTree::overlap(const ShapeData& queryVolume, PrunerOverla
 	return true;
 }
 
+bool CompanionPrunerAABBTree::cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& prunerCallback) const
+{
+	PX_ASSERT(!mDirtyFlags);
+
+	const PlanesAABBTest test(nbPlanes, planes);
+
+#ifdef USE_MAVERICK_NODE
+	{
+		MaverickOverlapAdapter ra(mMaverick, prunerCallback);
+		if(!doOverlapLeafTest<true, PlanesAABBTest, MaverickNode, MaverickOverlapAdapter>(test, &mMaverick, mMaverick.mFreeBounds, NULL, ra))
+			return false;
+	}
+#endif
+
+	if(mBVH)
+	{
+		OverlapAdapter ra(*this, prunerCallback, mLastValidTimestamp);
+		return AABBTreeCull<true, BVHTree, BVHNode, OverlapAdapter>()(mBVH->getData().mBounds, BVHTree(mBVH->getData()), test, ra);
+	}
+	return true;
+}
+
 bool CompanionPrunerAABBTree::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback) const
 {
 	PX_UNUSED(queryVolume);
@@ -59,6 +59,7 @@ namespace Gu
 		virtual	void	visualize(PxRenderOutput& out, PxU32 color)																											const	= 0;
 		virtual	bool	raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback)									const	= 0;
 		virtual	bool	overlap(const ShapeData& queryVolume, PrunerOverlapCallback& prunerCallback)																		const	= 0;
+		virtual	bool	cull(PxU32 nbPlanes, const PxPlane* planes, PrunerOverlapCallback& prunerCallback)																	const	= 0;
 		virtual	bool	sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& prunerCallback)							const	= 0;
 		virtual	void	getGlobalBounds(PxBounds3&)																															const	= 0;
 	};
@@ -0,0 +1,280 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#include "GuWideBVH.h"
+#include "GuAABBTreeNode.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxMemory.h"
+
+using namespace physx;
+using namespace Gu;
+
+WideBVH::WideBVH() : mNodes(NULL), mSourceNodes(NULL), mNbNodes(0), mWidth(BVH_BINARY)
+{
+}
+
+WideBVH::~WideBVH()
+{
+	release();
+}
+
+void WideBVH::release()
+{
+	PX_FREE(mNodes);
+	PX_FREE(mSourceNodes);
+	mNbNodes = 0;
+	mWidth = BVH_BINARY;
+}
+
+void WideBVH::moveFrom(WideBVH& other)
+{
+	release();
+	mNodes			= other.mNodes;
+	mSourceNodes	= other.mSourceNodes;
+	mNbNodes		= other.mNbNodes;
+	mWidth			= other.mWidth;
+	other.mNodes		= NULL;
+	other.mSourceNodes	= NULL;
+	other.mNbNodes		= 0;
+	other.mWidth		= BVH_BINARY;
+}
+
+static PX_FORCE_INLINE float getSurfaceArea(const PxBounds3& bounds)
+{
+	const PxVec3 d = bounds.maximum - bounds.minimum;
+	return d.x*d.y + d.y*d.z + d.z*d.x;
+}
+
+template<PxU32 N>
+static void setLane(WideBVHNode<N>& node, PxU32 lane, const PxBounds3& bounds, PxU32 data)
+{
+	node.mMinX[lane] = bounds.minimum.x;
+	node.mMinY[lane] = bounds.minimum.y;
+	node.mMinZ[lane] = bounds.minimum.z;
+	node.mMaxX[lane] = bounds.maximum.x;
+	node.mMaxY[lane] = bounds.maximum.y;
+	node.mMaxZ[lane] = bounds.maximum.z;
+	node.mData[lane] = data;
+}
+
+template<PxU32 N>
+bool WideBVH::buildT(const BVHNode* nodes, PxU32 nbNodes)
+{
+	// PT: each wide node consumes at least one internal binary node, and a full binary tree with K nodes has (K-1)/2 internal nodes.
+	// We allocate for the worst case and shrink the buffers at the end.
+	const PxU32 maxNbWideNodes = PxMax<PxU32>(1, (nbNodes-1)/2);
+
+	WideBVHNode<N>* wideNodes = PX_ALLOCATE(WideBVHNode<N>, maxNbWideNodes, "Wide BVH nodes");
+	PxU32* sourceNodes = PX_ALLOCATE(PxU32, maxNbWideNodes*N, "Wide BVH source nodes");
+	if(!wideNodes || !sourceNodes)
+	{
+		PX_FREE(wideNodes);
+		PX_FREE(sourceNodes);
+		return false;
+	}
+
+	PxBounds3 emptyBounds;
+	emptyBounds.setEmpty();
+
+	struct WorkItem
+	{
+		PxU32	mWideIndex;
+		PxU32	mBinaryIndex;
+	};
+	PxArray<WorkItem> workStack;
+
+	PxU32 nbWideNodes = 1;
+
+	// PT: special case for trees made of a single leaf node
+	if(nodes[0].isLeaf())
+	{
+		for(PxU32 j=0;j<N;j++)
+		{
+			setLane(wideNodes[0], j, emptyBounds, WIDE_BVH_EMPTY_LANE);
+			sourceNodes[j] = WIDE_BVH_EMPTY_LANE;
+		}
+		setLane(wideNodes[0], 0, nodes[0].mBV, 1);
+		sourceNodes[0] = 0;
+	}
+	else
+	{
+		WorkItem root;
+		root.mWideIndex = 0;
+		root.mBinaryIndex = 0;
+		workStack.pushBack(root);
+	}
+
+	while(workStack.size())
+	{
+		const WorkItem item = workStack.popBack();
+
+		// PT: start with the two children of the binary node, then repeatedly open the internal child with the
+		// largest surface area until all lanes are used or only leaves remain.
+		PxU32 children[N];
+		PxU32 nbChildren = 2;
+		children[0] = nodes[item.mBinaryIndex].getPosIndex();
+		children[1] = nodes[item.mBinaryIndex].getNegIndex();
+
+		while(nbChildren<N)
+		{
+			PxU32 bestChild = 0xffffffff;
+			float bestArea = -1.0f;
+			for(PxU32 j=0;j<nbChildren;j++)
+			{
+				const BVHNode& child = nodes[children[j]];
+				if(child.isLeaf())
+					continue;
+
+				const float area = getSurfaceArea(child.mBV);
+				if(area>bestArea)
+				{
+					bestArea = area;
+					bestChild = j;
+				}
+			}
+			if(bestChild==0xffffffff)
+				break;
+
+			const BVHNode& opened = nodes[children[bestChild]];
+			children[bestChild] = opened.getPosIndex();
+			children[nbChildren++] = opened.getNegIndex();
+		}
+
+		WideBVHNode<N>& wideNode = wideNodes[item.mWideIndex];
+		PxU32* source = sourceNodes + item.mWideIndex*N;
+		for(PxU32 j=0;j<N;j++)
+		{
+			if(j>=nbChildren)
+			{
+				setLane(wideNode, j, emptyBounds, WIDE_BVH_EMPTY_LANE);
+				source[j] = WIDE_BVH_EMPTY_LANE;
+				continue;
+			}
+
+			const PxU32 childIndex = children[j];
+			const BVHNode& child = nodes[childIndex];
+			source[j] = childIndex;
+			if(child.isLeaf())
+			{
+				setLane(wideNode, j, child.mBV, (childIndex<<1)|1);
+			}
+			else
+			{
+				PX_ASSERT(nbWideNodes<maxNbWideNodes);
+				const PxU32 wideIndex = nbWideNodes++;
+				setLane(wideNode, j, child.mBV, wideIndex<<1);
+
+				WorkItem childItem;
+				childItem.mWideIndex = wideIndex;
+				childItem.mBinaryIndex = childIndex;
+				workStack.pushBack(childItem);
+			}
+		}
+	}
+
+	if(nbWideNodes!=maxNbWideNodes)
+	{
+		// PT: shrinking is only an optimization, we keep the oversized buffers if it fails
+		WideBVHNode<N>* shrunkNodes = PX_ALLOCATE(WideBVHNode<N>, nbWideNodes, "Wide BVH nodes");
+		PxU32* shrunkSourceNodes = PX_ALLOCATE(PxU32, nbWideNodes*N, "Wide BVH source nodes");
+		if(shrunkNodes && shrunkSourceNodes)
+		{
+			PxMemCopy(shrunkNodes, wideNodes, sizeof(WideBVHNode<N>)*nbWideNodes);
+			PxMemCopy(shrunkSourceNodes, sourceNodes, sizeof(PxU32)*nbWideNodes*N);
+			PX_FREE(wideNodes);
+			PX_FREE(sourceNodes);
+			wideNodes = shrunkNodes;
+			sourceNodes = shrunkSourceNodes;
+		}
+		else
+		{
+			PX_FREE(shrunkNodes);
+			PX_FREE(shrunkSourceNodes);
+		}
+	}
+
+	mNodes = wideNodes;
+	mSourceNodes = sourceNodes;
+	mNbNodes = nbWideNodes;
+	return true;
+}
+
+bool WideBVH::build(const BVHNode* nodes, PxU32 nbNodes, BVHNodeWidth width)
+{
+	release();
+
+	if(!nodes || !nbNodes)
+		return false;
+
+	bool status = false;
+	if(width==BVH_WIDE_4)
+		status = buildT<4>(nodes, nbNodes);
+	else if(width==BVH_WIDE_8)
+		status = buildT<8>(nodes, nbNodes);
+
+	if(status)
+		mWidth = width;
+	return status;
+}
+
+template<PxU32 N>
+void WideBVH::refitT(const BVHNode* nodes)
+{
+	WideBVHNode<N>* PX_RESTRICT wideNodes = reinterpret_cast<WideBVHNode<N>*>(mNodes);
+	const PxU32* PX_RESTRICT source = mSourceNodes;
+	const PxU32 nbNodes = mNbNodes;
+	for(PxU32 i=0;i<nbNodes;i++)
+	{
+		WideBVHNode<N>& wideNode = wideNodes[i];
+		for(PxU32 j=0;j<N;j++)
+		{
+			const PxU32 sourceIndex = *source++;
+			if(sourceIndex==WIDE_BVH_EMPTY_LANE)
+				continue;
+
+			const PxBounds3& bounds = nodes[sourceIndex].mBV;
+			wideNode.mMinX[j] = bounds.minimum.x;
+			wideNode.mMinY[j] = bounds.minimum.y;
+			wideNode.mMinZ[j] = bounds.minimum.z;
+			wideNode.mMaxX[j] = bounds.maximum.x;
+			wideNode.mMaxY[j] = bounds.maximum.y;
+			wideNode.mMaxZ[j] = bounds.maximum.z;
+		}
+	}
+}
+
+void WideBVH::refit(const BVHNode* nodes)
+{
+	if(!mNodes)
+		return;
+
+	if(mWidth==BVH_WIDE_4)
+		refitT<4>(nodes);
+	else if(mWidth==BVH_WIDE_8)
+		refitT<8>(nodes);
+}
@@ -0,0 +1,327 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#ifndef GU_WIDE_BVH_H
+#define GU_WIDE_BVH_H
+
+#include "foundation/PxUserAllocated.h"
+#include "foundation/PxInlineArray.h"
+#include "foundation/PxBitUtils.h"
+#include "common/PxPhysXCommonConfig.h"
+#include "GuPrunerTypedef.h"
+#include "GuAABBTreeQuery.h"
+
+namespace physx
+{
+namespace Gu
+{
+	// PT: N-wide node, SoA layout. Lanes are tested 4 at a time with SIMD, so N must be a multiple of 4.
+	// Unused lanes have inverted (empty) bounds and an invalid data value.
+	template<PxU32 N>
+	PX_ALIGN_PREFIX(16)
+	struct WideBVHNode
+	{
+		float	mMinX[N];
+		float	mMinY[N];
+		float	mMinZ[N];
+		float	mMaxX[N];
+		float	mMaxY[N];
+		float	mMaxZ[N];
+		PxU32	mData[N];	// 31 bits wide node index or binary leaf node index | 1 bit leaf, 0xffffffff for empty lanes
+
+		PX_FORCE_INLINE	static	PxU32	isLeaf(PxU32 data)		{ return data & 1;	}
+		PX_FORCE_INLINE	static	PxU32	getIndex(PxU32 data)	{ return data >> 1;	}
+	}
+	PX_ALIGN_SUFFIX(16);
+
+	typedef WideBVHNode<4>	WideBVHNode4;
+	typedef WideBVHNode<8>	WideBVHNode8;
+
+	static const PxU32 WIDE_BVH_EMPTY_LANE = 0xffffffff;
+
+	// PT: a wide BVH is a collapsed version of a regular binary BVH (BVHNode array). The binary tree remains the reference
+	// data structure: it is the one that gets built, refit, serialized, merged, etc. The wide tree is derived from it and
+	// only used to speed up queries. Each lane of the wide tree remembers the binary node it has been created from, so
+	// refitting the wide tree is a simple linear copy of the binary bounds. Leaf lanes directly reference binary leaf nodes,
+	// so the leaf-level code (primitive indices, runtime primitive counts) is shared with the binary traversal.
+	class WideBVH : public PxUserAllocated
+	{
+		public:
+		PX_PHYSX_COMMON_API					WideBVH();
+		PX_PHYSX_COMMON_API					~WideBVH();
+
+		// Collapses a binary tree into a wide tree. The binary tree is not modified, and must remain valid as long as the wide tree is used.
+		// Returns false if the width is not supported (i.e. not BVH_WIDE_4 or BVH_WIDE_8), in which case no wide tree is built.
+		PX_PHYSX_COMMON_API	bool			build(const BVHNode* nodes, PxU32 nbNodes, BVHNodeWidth width);
+		// Updates wide bounds after the source binary tree has been refit. The tree topology must not have changed.
+		PX_PHYSX_COMMON_API	void			refit(const BVHNode* nodes);
+		PX_PHYSX_COMMON_API	void			release();
+
+		// Moves data from another tree, which is left empty.
+							void			moveFrom(WideBVH& other);
+
+		PX_FORCE_INLINE		PxU32			getNbNodes()	const	{ return mNbNodes;	}
+		PX_FORCE_INLINE		BVHNodeWidth	getWidth()		const	{ return mWidth;	}
+		PX_FORCE_INLINE		bool			isValid()		const	{ return mNodes!=NULL;	}
+
+		template<PxU32 N>
+		PX_FORCE_INLINE		const WideBVHNode<N>*	getNodes()	const	{ PX_ASSERT(PxU32(mWidth)==N); return reinterpret_cast<const WideBVHNode<N>*>(mNodes);	}
+
+		private:
+							void*			mNodes;			//!< Wide nodes (WideBVHNode4 or WideBVHNode8 depending on mWidth)
+							PxU32*			mSourceNodes;	//!< Binary node index for each lane of each wide node, used for refit
+							PxU32			mNbNodes;		//!< Number of wide nodes
+							BVHNodeWidth	mWidth;
+
+							template<PxU32 N>
+							bool			buildT(const BVHNode* nodes, PxU32 nbNodes);
+							template<PxU32 N>
+							void			refitT(const BVHNode* nodes);
+
+							PX_NOCOPY(WideBVH)
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+
+	// PT: tests N lanes of a wide node against a query AABB (expressed as min/max) and returns a bitmask of overlapping lanes.
+	template<PxU32 N>
+	static PX_FORCE_INLINE PxU32 wideNodeOverlapMask(const WideBVHNode<N>& node,
+		const Vec4V qMinX, const Vec4V qMinY, const Vec4V qMinZ, const Vec4V qMaxX, const Vec4V qMaxY, const Vec4V qMaxZ)
+	{
+		PxU32 mask = 0;
+		for(PxU32 i=0;i<N;i+=4)
+		{
+			const BoolV bx = BAnd(V4IsGrtrOrEq(qMaxX, V4LoadA(node.mMinX + i)), V4IsGrtrOrEq(V4LoadA(node.mMaxX + i), qMinX));
+			const BoolV by = BAnd(V4IsGrtrOrEq(qMaxY, V4LoadA(node.mMinY + i)), V4IsGrtrOrEq(V4LoadA(node.mMaxY + i), qMinY));
+			const BoolV bz = BAnd(V4IsGrtrOrEq(qMaxZ, V4LoadA(node.mMinZ + i)), V4IsGrtrOrEq(V4LoadA(node.mMaxZ + i), qMinZ));
+			mask |= BGetBitMask(BAnd(BAnd(bx, by), bz))<<i;
+		}
+		return mask;
+	}
+
+	template<PxU32 N>
+	static PX_FORCE_INLINE void getWideLaneCenterExtents(const WideBVHNode<N>& node, PxU32 lane, Vec3V& center, Vec3V& extents)
+	{
+		const Vec3V minV = V3LoadU(PxVec3(node.mMinX[lane], node.mMinY[lane], node.mMinZ[lane]));
+		const Vec3V maxV = V3LoadU(PxVec3(node.mMaxX[lane], node.mMaxY[lane], node.mMaxZ[lane]));
+		const FloatV halfV = FLoad(0.5f);
+		center = V3Scale(V3Add(maxV, minV), halfV);
+		extents = V3Scale(V3Sub(maxV, minV), halfV);
+	}
+
+	// PT: overlap traversal for wide trees.
+	//
+	// The query AABB must enclose the query volume. It is used for the SIMD culling of all lanes at once. When tExactTest is
+	// true, the regular (scalar) test is then performed on surviving lanes, which gives the exact same culling as the binary
+	// traversal. For AABB queries the SIMD test is already exact, so tExactTest can be false.
+	template<PxU32 N, const bool tHasIndices, const bool tExactTest, typename Test, typename QueryCallback>
+	class WideBVHOverlap
+	{
+	public:
+		bool operator()(const AABBTreeBounds& treeBounds, const BVHNode* binaryNodes, const PxU32* indices, const WideBVH& wideTree, const PxBounds3& queryBounds, const Test& test, QueryCallback& visitor)
+		{
+			const PxBounds3* bounds = treeBounds.getBounds();
+			const WideBVHNode<N>* PX_RESTRICT wideNodes = wideTree.getNodes<N>();
+
+			const Vec4V qMinX = V4Load(queryBounds.minimum.x);
+			const Vec4V qMinY = V4Load(queryBounds.minimum.y);
+			const Vec4V qMinZ = V4Load(queryBounds.minimum.z);
+			const Vec4V qMaxX = V4Load(queryBounds.maximum.x);
+			const Vec4V qMaxY = V4Load(queryBounds.maximum.y);
+			const Vec4V qMaxZ = V4Load(queryBounds.maximum.z);
+
+			PxInlineArray<PxU32, RAW_TRAVERSAL_STACK_SIZE> stack;
+			stack.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
+			stack[0] = 0;
+			PxU32 stackIndex = 1;
+
+			while(stackIndex > 0)
+			{
+				const WideBVHNode<N>& node = wideNodes[stack[--stackIndex]];
+
+				PxU32 mask = wideNodeOverlapMask<N>(node, qMinX, qMinY, qMinZ, qMaxX, qMaxY, qMaxZ);
+				while(mask)
+				{
+					const PxU32 lane = PxLowestSetBit(mask);
+					mask &= mask - 1;
+
+					const PxU32 data = node.mData[lane];
+					if(data==WIDE_BVH_EMPTY_LANE)
+						continue;
+
+					if(tExactTest)
+					{
+						Vec3V center, extents;
+						getWideLaneCenterExtents<N>(node, lane, center, extents);
+						if(!test(center, extents))
+							continue;
+					}
+
+					if(WideBVHNode<N>::isLeaf(data))
+					{
+						if(!doOverlapLeafTest<tHasIndices, Test, BVHNode>(test, binaryNodes + WideBVHNode<N>::getIndex(data), bounds, indices, visitor))
+							return false;
+					}
+					else
+					{
+						stack[stackIndex++] = WideBVHNode<N>::getIndex(data);
+						if(stackIndex == stack.capacity())
+							stack.resizeUninitialized(stack.capacity() * 2);
+					}
+				}
+			}
+			return true;
+		}
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+
+	struct WideBVHRayStackEntry
+	{
+		PxU32	mData;	// Same encoding as WideBVHNode::mData
+		float	mDist;	// Entry distance along the ray, used to skip entries beyond the current closest hit
+	};
+
+	// PT: raycast/sweep traversal for wide trees. Lanes are tested 4 at a time with a slab test, the surviving lanes are
+	// sorted by entry distance and pushed on the stack so that the closest ones are visited first. Sweeps are treated as
+	// raycasts against boxes inflated by the sweep extents, like in the binary version.
+	template<PxU32 N, const bool tInflate, const bool tHasIndices, typename QueryCallback> // use inflate=true for sweeps, inflate=false for raycasts
+	class WideBVHRaycast
+	{
+	public:
+		bool operator()(
+			const AABBTreeBounds& treeBounds, const BVHNode* binaryNodes, const PxU32* indices, const WideBVH& wideTree,
+			const PxVec3& origin, const PxVec3& unitDir, PxReal& maxDist, const PxVec3& inflation,
+			QueryCallback& pcb)
+		{
+			const PxBounds3* bounds = treeBounds.getBounds();
+			const WideBVHNode<N>* PX_RESTRICT wideNodes = wideTree.getNodes<N>();
+
+			// PT: the leaf-level code is shared with the binary traversal, it needs the regular (scaled) ray-box test
+			Gu::RayAABBTest test(origin*2.0f, unitDir*2.0f, maxDist, inflation*2.0f);
+
+			// PT: avoid infinite/NaN values in the slab test for axis-aligned rays
+			PxVec3 invDir;
+			for(PxU32 i=0;i<3;i++)
+			{
+				const float d = unitDir[i];
+				const float safeD = PxAbs(d) < 1e-20f ? (d<0.0f ? -1e-20f : 1e-20f) : d;
+				invDir[i] = 1.0f / safeD;
+			}
+
+			const Vec4V oX = V4Load(origin.x);
+			const Vec4V oY = V4Load(origin.y);
+			const Vec4V oZ = V4Load(origin.z);
+			const Vec4V idX = V4Load(invDir.x);
+			const Vec4V idY = V4Load(invDir.y);
+			const Vec4V idZ = V4Load(invDir.z);
+			const Vec4V infX = V4Load(tInflate ? inflation.x : 0.0f);
+			const Vec4V infY = V4Load(tInflate ? inflation.y : 0.0f);
+			const Vec4V infZ = V4Load(tInflate ? inflation.z : 0.0f);
+			const Vec4V zero = V4Zero();
+
+			PxInlineArray<WideBVHRayStackEntry, RAW_TRAVERSAL_STACK_SIZE> stack;
+			stack.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
+			stack[0].mData = 0;
+			stack[0].mDist = 0.0f;
+			PxU32 stackIndex = 1;
+
+			PX_ALIGN(16, float tNear[N]);
+
+			while(stackIndex--)
+			{
+				const WideBVHRayStackEntry entry = stack[stackIndex];
+				if(entry.mDist > maxDist)
+					continue;
+
+				if(WideBVHNode<N>::isLeaf(entry.mData))
+				{
+					if(!doLeafTest<tInflate, tHasIndices, BVHNode>(binaryNodes + WideBVHNode<N>::getIndex(entry.mData), test, bounds, indices, maxDist, pcb))
+						return false;
+					continue;
+				}
+
+				const WideBVHNode<N>& node = wideNodes[WideBVHNode<N>::getIndex(entry.mData)];
+
+				const Vec4V maxDistV = V4Load(maxDist);
+				PxU32 mask = 0;
+				for(PxU32 i=0;i<N;i+=4)
+				{
+					const Vec4V tx0 = V4Mul(V4Sub(V4Sub(V4LoadA(node.mMinX + i), infX), oX), idX);
+					const Vec4V tx1 = V4Mul(V4Sub(V4Add(V4LoadA(node.mMaxX + i), infX), oX), idX);
+					const Vec4V ty0 = V4Mul(V4Sub(V4Sub(V4LoadA(node.mMinY + i), infY), oY), idY);
+					const Vec4V ty1 = V4Mul(V4Sub(V4Add(V4LoadA(node.mMaxY + i), infY), oY), idY);
+					const Vec4V tz0 = V4Mul(V4Sub(V4Sub(V4LoadA(node.mMinZ + i), infZ), oZ), idZ);
+					const Vec4V tz1 = V4Mul(V4Sub(V4Add(V4LoadA(node.mMaxZ + i), infZ), oZ), idZ);
+
+					const Vec4V tMin = V4Max(V4Max(V4Min(tx0, tx1), V4Min(ty0, ty1)), V4Max(V4Min(tz0, tz1), zero));
+					const Vec4V tMax = V4Min(V4Min(V4Max(tx0, tx1), V4Max(ty0, ty1)), V4Min(V4Max(tz0, tz1), maxDistV));
+
+					V4StoreA(tMin, tNear + i);
+					mask |= BGetBitMask(V4IsGrtrOrEq(tMax, tMin))<<i;
+				}
+
+				// PT: gather surviving lanes sorted by decreasing entry distance, so that the closest one ends up on top of the stack
+				PxU32 nbHits = 0;
+				PxU32 hitLanes[N];
+				while(mask)
+				{
+					const PxU32 lane = PxLowestSetBit(mask);
+					mask &= mask - 1;
+					if(node.mData[lane]==WIDE_BVH_EMPTY_LANE)
+						continue;
+
+					const float dist = tNear[lane];
+					PxU32 j = nbHits++;
+					while(j && tNear[hitLanes[j-1]] < dist)
+					{
+						hitLanes[j] = hitLanes[j-1];
+						j--;
+					}
+					hitLanes[j] = lane;
+				}
+
+				if(stackIndex + nbHits >= stack.capacity())
+					stack.resizeUninitialized(stack.capacity() * 2);
+
+				for(PxU32 j=0;j<nbHits;j++)
+				{
+					const PxU32 lane = hitLanes[j];
+					stack[stackIndex].mData = node.mData[lane];
+					stack[stackIndex].mDist = tNear[lane];
+					stackIndex++;
+				}
+			}
+			return true;
+		}
+	};
+
+} // namespace Gu
+}
+
+#endif // GU_WIDE_BVH_H
@@ -0,0 +1,113 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "GuCookingScratch.h"
+#include "foundation/PxMath.h"
+
+using namespace physx;
+using namespace Gu;
+
+CookingScratch::CookingScratch(PxU32 chunkSize) : mCurrentChunk(0), mChunkSize(chunkSize)
+{
+}
+
+CookingScratch::~CookingScratch()
+{
+	release();
+}
+
+void CookingScratch::release()
+{
+	const PxU32 nbChunks = mChunks.size();
+	for(PxU32 i=0;i<nbChunks;i++)
+		PX_FREE(mChunks[i].mMemory);
+	mChunks.reset();
+	mCurrentChunk = 0;
+}
+
+void* CookingScratch::alloc(size_t size)
+{
+	size = (size + 15) & ~size_t(15);
+
+	// PT: try the current chunk first, then the remaining ones. Chunks before mCurrentChunk are considered full.
+	const PxU32 nbChunks = mChunks.size();
+	while(mCurrentChunk<nbChunks)
+	{
+		Chunk& chunk = mChunks[mCurrentChunk];
+		if(chunk.mUsed + size <= chunk.mSize)
+		{
+			void* memory = chunk.mMemory + chunk.mUsed;
+			chunk.mUsed += size;
+			return memory;
+		}
+		mCurrentChunk++;
+	}
+
+	Chunk chunk;
+	chunk.mSize = PxMax<size_t>(size, mChunkSize);
+	chunk.mMemory = reinterpret_cast<PxU8*>(PX_ALLOC(chunk.mSize, "CookingScratch"));
+	if(!chunk.mMemory)
+		return NULL;
+	chunk.mUsed = size;
+	mChunks.pushBack(chunk);
+	mCurrentChunk = mChunks.size() - 1;
+	return chunk.mMemory;
+}
+
+void CookingScratch::reset()
+{
+	const PxU32 nbChunks = mChunks.size();
+	if(nbChunks>1)
+	{
+		// PT: the last item did not fit in a single chunk. Replace all chunks with a single large one, so that the
+		// next items of similar size are served from one contiguous block.
+		const size_t capacity = getCapacity();
+		release();
+
+		Chunk chunk;
+		chunk.mSize = capacity;
+		chunk.mMemory = reinterpret_cast<PxU8*>(PX_ALLOC(capacity, "CookingScratch"));
+		chunk.mUsed = 0;
+		if(chunk.mMemory)
+			mChunks.pushBack(chunk);
+	}
+	else if(nbChunks)
+	{
+		mChunks[0].mUsed = 0;
+	}
+	mCurrentChunk = 0;
+}
+
+size_t CookingScratch::getCapacity() const
+{
+	size_t capacity = 0;
+	const PxU32 nbChunks = mChunks.size();
+	for(PxU32 i=0;i<nbChunks;i++)
+		capacity += mChunks[i].mSize;
+	return capacity;
+}
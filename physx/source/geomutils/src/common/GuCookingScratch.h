@@ -0,0 +1,152 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef GU_COOKING_SCRATCH_H
+#define GU_COOKING_SCRATCH_H
+
+#include "foundation/PxArray.h"
+#include "foundation/PxUserAllocated.h"
+#include "GuBuildTask.h"
+
+namespace physx
+{
+namespace Gu
+{
+	// PT: linear scratch arena used by the convex cooking code for temporary buffers. Cooking thousands of small convexes
+	// otherwise spends a lot of time allocating and freeing the same quickhull & hull builder buffers over and over. A
+	// scratch object is owned by one thread at a time and reset between cooked items: freeing individual allocations is
+	// a no-op, and all memory is reclaimed at once by reset(), which keeps the chunks around for the next item.
+	//
+	// Allocations from the arena must not outlive the cooked item, i.e. they cannot end up in the cooked mesh itself.
+	class CookingScratch : public PxUserAllocated
+	{
+		PX_NOCOPY(CookingScratch)
+		public:
+						CookingScratch(PxU32 chunkSize = 64*1024);
+						~CookingScratch();
+
+		// returns 16-bytes aligned memory, valid until the next reset() call
+				void*	alloc(size_t size);
+
+		// rewinds the arena. Chunks are kept, and merged into a single one when the previous item overflowed the first chunk.
+				void	reset();
+
+				void	release();
+
+				size_t	getCapacity()	const;
+		private:
+		struct Chunk
+		{
+			PxU8*	mMemory;
+			size_t	mSize;
+			size_t	mUsed;
+		};
+				PxArray<Chunk>	mChunks;
+				PxU32			mCurrentChunk;
+				PxU32			mChunkSize;
+	};
+
+	// PT: helpers for code that can run with or without a scratch arena. Memory allocated with a given scratch pointer
+	// must be freed with the same scratch pointer.
+	PX_FORCE_INLINE void* scratchAlloc(CookingScratch* scratch, size_t size, const char* name)
+	{
+		return scratch ? scratch->alloc(size) : PX_ALLOC(size, name);
+	}
+
+	template<class T>
+	PX_FORCE_INLINE T* scratchAllocate(CookingScratch* scratch, PxU32 count, const char* name)
+	{
+		return reinterpret_cast<T*>(scratchAlloc(scratch, count*sizeof(T), name));
+	}
+
+	template<class T>
+	PX_FORCE_INLINE void scratchFree(CookingScratch* scratch, T*& ptr)
+	{
+		if(!scratch)
+		{
+			PX_FREE(ptr);
+		}
+		ptr = NULL;
+	}
+
+	// PT: task used by runCookingBatch(). Each task owns a scratch arena and cooks items pulled from a shared counter,
+	// resetting the arena after each of them.
+	template<class CookerT>
+	class CookingBatchTask : public BuildTask
+	{
+		public:
+		virtual	void			runInternal()
+								{
+									CookingScratch scratch;
+									PxU32 index;
+									while((index = PxU32(PxAtomicIncrement(mNextItem) - 1)) < mNbItems)
+									{
+										(*mCooker)(index, scratch);
+										scratch.reset();
+									}
+								}
+		virtual	const char*		getName()	const	{ return "CookingBatchTask";	}
+
+				CookerT*		mCooker;
+				volatile PxI32*	mNextItem;
+				PxU32			mNbItems;
+	};
+
+	// PT: cooks a batch of independent items on the calling thread and on the dispatcher's worker threads (if any). Items
+	// are distributed dynamically since their cost can vary a lot. CookerT must provide a thread-safe
+	// "void operator()(PxU32 index, CookingScratch& scratch)" function cooking item 'index' with the given arena.
+	template<class CookerT>
+	void runCookingBatch(PxCpuDispatcher* dispatcher, PxU32 nbItems, CookerT& cooker)
+	{
+		if(!nbItems)
+			return;
+
+		volatile PxI32 nextItem = 0;
+
+		PxU32 nbTasks = 0;
+		if(dispatcher)
+			nbTasks = PxMin(PxMin(dispatcher->getWorkerCount(), nbItems-1), PxU32(GU_MAX_NB_RANGE_TASKS));
+
+		CookingBatchTask<CookerT> tasks[GU_MAX_NB_RANGE_TASKS+1];
+		for(PxU32 i=0;i<=nbTasks;i++)
+		{
+			tasks[i].mCooker	= &cooker;
+			tasks[i].mNextItem	= &nextItem;
+			tasks[i].mNbItems	= nbItems;
+		}
+
+		BuildTaskSync sync;
+		for(PxU32 i=1;i<=nbTasks;i++)
+			sync.submit(*dispatcher, tasks[i]);
+		tasks[0].runInternal();
+		sync.wait();
+	}
+}
+}
+
+#endif
@@ -31,6 +31,8 @@
 #include "foundation/PxAllocator.h"
 #include "foundation/PxBitUtils.h"
 #include "GuMeshCleaner.h"
+#include "GuBuildTask.h"
+#include "GuCookingScratch.h"
 
 using namespace physx;
 using namespace Gu;
@@ -70,28 +72,105 @@ static PX_FORCE_INLINE PxU32 getHashValue(const Indices& v)
 	return c;
 }
 
-MeshCleaner::MeshCleaner(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, const PxU32* srcIndices, PxF32 meshWeldTolerance)
+// PT: batches smaller than this are not worth a task
+#define MESH_CLEANER_MIN_BATCH_SIZE	4096
+
+namespace
+{
+	struct SnapToGrid
+	{
+		SnapToGrid(const PxVec3* srcVerts, PxVec3* cleanVerts, PxU32* vertexIndices, PxF32 weldTolerance) :
+			mSrcVerts(srcVerts), mCleanVerts(cleanVerts), mVertexIndices(vertexIndices), mWeldTolerance(weldTolerance)	{}
+
+		void	operator()(PxU32 start, PxU32 end)
+		{
+			const PxVec3* PX_RESTRICT srcVerts = mSrcVerts;
+			PxVec3* PX_RESTRICT cleanVerts = mCleanVerts;
+			const PxF32 weldTolerance = mWeldTolerance;
+			for(PxU32 i=start; i<end; i++)
+			{
+				mVertexIndices[i] = i;
+				cleanVerts[i] = PxVec3(	PxFloor(srcVerts[i].x*weldTolerance + 0.5f),
+										PxFloor(srcVerts[i].y*weldTolerance + 0.5f),
+										PxFloor(srcVerts[i].z*weldTolerance + 0.5f));
+			}
+		}
+
+		const PxVec3*	mSrcVerts;
+		PxVec3*			mCleanVerts;
+		PxU32*			mVertexIndices;
+		const PxF32		mWeldTolerance;
+		PX_NOCOPY(SnapToGrid)
+	};
+
+	// PT: remaps the vertex references of each triangle and flags out invalid & degenerate triangles. Triangles are
+	// processed independently and written to their own slot, the compaction is done afterwards by the caller.
+	struct RemapTriangles
+	{
+		RemapTriangles(PxU32 nbVerts, const PxVec3* srcVerts, const PxU32* srcIndices, const PxU32* remapVerts, PxU32* indices, PxU32* remapTriangles) :
+			mNbVerts(nbVerts), mSrcVerts(srcVerts), mSrcIndices(srcIndices), mRemapVerts(remapVerts), mIndices(indices), mRemapTriangles(remapTriangles)	{}
+
+		void	operator()(PxU32 start, PxU32 end)
+		{
+			const PxU32 nbVerts = mNbVerts;
+			const PxVec3* PX_RESTRICT srcVerts = mSrcVerts;
+			const PxU32* PX_RESTRICT remapVerts = mRemapVerts;
+			for(PxU32 i=start;i<end;i++)
+			{
+				mRemapTriangles[i] = PX_INVALID_U32;
+
+				PxU32 vref0 = mSrcIndices[i*3+0];
+				PxU32 vref1 = mSrcIndices[i*3+1];
+				PxU32 vref2 = mSrcIndices[i*3+2];
+				if(vref0>=nbVerts || vref1>=nbVerts || vref2>=nbVerts)
+					continue;
+
+				// PT: you can still get zero-area faces when the 3 vertices are perfectly aligned
+				const PxVec3& p0 = srcVerts[vref0];
+				const PxVec3& p1 = srcVerts[vref1];
+				const PxVec3& p2 = srcVerts[vref2];
+				const float area2 = ((p0 - p1).cross(p0 - p2)).magnitudeSquared();
+				if(area2==0.0f)
+					continue;
+
+				vref0 = remapVerts[vref0];
+				vref1 = remapVerts[vref1];
+				vref2 = remapVerts[vref2];
+				if(vref0==vref1 || vref1==vref2 || vref2==vref0)
+					continue;
+
+				mIndices[i*3+0] = vref0;
+				mIndices[i*3+1] = vref1;
+				mIndices[i*3+2] = vref2;
+				mRemapTriangles[i] = i;
+			}
+		}
+
+		const PxU32		mNbVerts;
+		const PxVec3*	mSrcVerts;
+		const PxU32*	mSrcIndices;
+		const PxU32*	mRemapVerts;
+		PxU32*			mIndices;
+		PxU32*			mRemapTriangles;
+		PX_NOCOPY(RemapTriangles)
+	};
+}
+
+MeshCleaner::MeshCleaner(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, const PxU32* srcIndices, PxF32 meshWeldTolerance, PxCpuDispatcher* dispatcher, CookingScratch* scratch) : mScratch(scratch)
 {
-	PxVec3* cleanVerts = PX_ALLOCATE(PxVec3, nbVerts, "MeshCleaner");
+	PxVec3* cleanVerts = scratchAllocate<PxVec3>(scratch, nbVerts, "MeshCleaner");
 	PX_ASSERT(cleanVerts);
 
-	PxU32* indices = PX_ALLOCATE(PxU32, (nbTris*3), "MeshCleaner");
+	PxU32* indices = scratchAllocate<PxU32>(scratch, nbTris*3, "MeshCleaner");
 
-	PxU32* remapTriangles = PX_ALLOCATE(PxU32, nbTris, "MeshCleaner");
+	PxU32* remapTriangles = scratchAllocate<PxU32>(scratch, nbTris, "MeshCleaner");
 
 	PxU32* vertexIndices = NULL;
 	if(meshWeldTolerance!=0.0f)
 	{
-		vertexIndices = PX_ALLOCATE(PxU32, nbVerts, "MeshCleaner");
-		const PxF32 weldTolerance = 1.0f / meshWeldTolerance;
-		// snap to grid
-		for(PxU32 i=0; i<nbVerts; i++)
-		{
-			vertexIndices[i] = i;
-			cleanVerts[i] = PxVec3(	PxFloor(srcVerts[i].x*weldTolerance + 0.5f),
-									PxFloor(srcVerts[i].y*weldTolerance + 0.5f),
-									PxFloor(srcVerts[i].z*weldTolerance + 0.5f));
-		}
+		vertexIndices = scratchAllocate<PxU32>(scratch, nbVerts, "MeshCleaner");
+		SnapToGrid snap(srcVerts, cleanVerts, vertexIndices, 1.0f / meshWeldTolerance);
+		runParallelRanges(dispatcher, nbVerts, MESH_CLEANER_MIN_BATCH_SIZE, snap);
 	}
 	else
 	{
@@ -101,12 +180,12 @@ MeshCleaner::MeshCleaner(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, co
 	const PxU32 maxNbElems = PxMax(nbTris, nbVerts);
 	const PxU32 hashSize = PxNextPowerOfTwo(maxNbElems);
 	const PxU32 hashMask = hashSize-1;
-	PxU32* hashTable = PX_ALLOCATE(PxU32, (hashSize + maxNbElems), "MeshCleaner");
+	PxU32* hashTable = scratchAllocate<PxU32>(scratch, hashSize + maxNbElems, "MeshCleaner");
 	PX_ASSERT(hashTable);
 	PxMemSet(hashTable, 0xff, hashSize * sizeof(PxU32));
 	PxU32* const next = hashTable + hashSize;
 
-	PxU32* remapVerts = PX_ALLOCATE(PxU32, nbVerts, "MeshCleaner");
+	PxU32* remapVerts = scratchAllocate<PxU32>(scratch, nbVerts, "MeshCleaner");
 	PxMemSet(remapVerts, 0xff, nbVerts * sizeof(PxU32));
 
 	for(PxU32 i=0;i<nbTris*3;i++)
@@ -141,36 +220,25 @@ MeshCleaner::MeshCleaner(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, co
 		else remapVerts[i] = offset;
 	}
 
+	{
+		RemapTriangles remapTris(nbVerts, srcVerts, srcIndices, remapVerts, indices, remapTriangles);
+		runParallelRanges(dispatcher, nbTris, MESH_CLEANER_MIN_BATCH_SIZE, remapTris);
+	}
+	scratchFree(scratch, remapVerts);
+
+	// PT: compact the remaining triangles in place, preserving their order
 	PxU32 nbCleanedTris = 0;
 	for(PxU32 i=0;i<nbTris;i++)
 	{
-		PxU32 vref0 = *srcIndices++;
-		PxU32 vref1 = *srcIndices++;
-		PxU32 vref2 = *srcIndices++;
-		if(vref0>=nbVerts || vref1>=nbVerts || vref2>=nbVerts)
-			continue;
-
-		// PT: you can still get zero-area faces when the 3 vertices are perfectly aligned
-		const PxVec3& p0 = srcVerts[vref0];
-		const PxVec3& p1 = srcVerts[vref1];
-		const PxVec3& p2 = srcVerts[vref2];
-		const float area2 = ((p0 - p1).cross(p0 - p2)).magnitudeSquared();
-		if(area2==0.0f)
-			continue;
-
-		vref0 = remapVerts[vref0];
-		vref1 = remapVerts[vref1];
-		vref2 = remapVerts[vref2];
-		if(vref0==vref1 || vref1==vref2 || vref2==vref0)
+		if(remapTriangles[i]==PX_INVALID_U32)
 			continue;
 
-		indices[nbCleanedTris*3+0] = vref0;
-		indices[nbCleanedTris*3+1] = vref1;
-		indices[nbCleanedTris*3+2] = vref2;
+		indices[nbCleanedTris*3+0] = indices[i*3+0];
+		indices[nbCleanedTris*3+1] = indices[i*3+1];
+		indices[nbCleanedTris*3+2] = indices[i*3+2];
 		remapTriangles[nbCleanedTris] = i;
 		nbCleanedTris++;
 	}
-	PX_FREE(remapVerts);
 
 	PxU32 nbToGo = nbCleanedTris;
 	nbCleanedTris = 0;
@@ -199,13 +267,13 @@ MeshCleaner::MeshCleaner(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, co
 			hashTable[hashValue] = nbCleanedTris++;
 		}
 	}
-	PX_FREE(hashTable);
+	scratchFree(scratch, hashTable);
 
 	if(vertexIndices)
 	{
 		for(PxU32 i=0;i<nbCleanedVerts;i++)
 			cleanVerts[i] = srcVerts[vertexIndices[i]];
-		PX_FREE(vertexIndices);
+		scratchFree(scratch, vertexIndices);
 	}
 	mNbVerts	= nbCleanedVerts;
 	mNbTris		= nbCleanedTris;
@@ -213,7 +281,7 @@ MeshCleaner::MeshCleaner(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, co
 	mIndices	= indices;
 	if(idtRemap)
 	{
-		PX_FREE(remapTriangles);
+		scratchFree(scratch, remapTriangles);
 		mRemap	= NULL;
 	}
 	else
@@ -224,7 +292,7 @@ MeshCleaner::MeshCleaner(PxU32 nbVerts, const PxVec3* srcVerts, PxU32 nbTris, co
 
 MeshCleaner::~MeshCleaner()
 {
-	PX_FREE(mRemap);
-	PX_FREE(mIndices);
-	PX_FREE(mVerts);
+	scratchFree(mScratch, mRemap);
+	scratchFree(mScratch, mIndices);
+	scratchFree(mScratch, mVerts);
 }
@@ -34,12 +34,19 @@
 
 namespace physx
 {
+class PxCpuDispatcher;
+
 namespace Gu
 {
+	class CookingScratch;
+
 	class MeshCleaner
 	{
 		public:
-			MeshCleaner(PxU32 nbVerts, const PxVec3* verts, PxU32 nbTris, const PxU32* indices, PxF32 meshWeldTolerance);
+			// PT: the optional dispatcher is used to process vertices & triangles in parallel. The output does not depend on it.
+			// The optional scratch arena is used for all buffers, including the output ones, which are then only valid until
+			// the arena is reset.
+			MeshCleaner(PxU32 nbVerts, const PxVec3* verts, PxU32 nbTris, const PxU32* indices, PxF32 meshWeldTolerance, PxCpuDispatcher* dispatcher=NULL, CookingScratch* scratch=NULL);
 			~MeshCleaner();
 
 			PxU32	mNbVerts;
@@ -47,6 +54,7 @@ namespace Gu
 			PxVec3*	mVerts;
 			PxU32*	mIndices;
 			PxU32*	mRemap;
+			CookingScratch*	mScratch;
 	};
 }
 }
@@ -0,0 +1,144 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef GU_SOA_VEC3_H
+#define GU_SOA_VEC3_H
+
+#include "foundation/PxVec3.h"
+#include "foundation/PxMat33.h"
+#include "foundation/PxVecMath.h"
+
+namespace physx
+{
+namespace Gu
+{
+	// PT: 4 vectors in SoA form. Used by batched queries, which process one query per SIMD lane.
+	struct SoAVec3
+	{
+		aos::Vec4V	x;
+		aos::Vec4V	y;
+		aos::Vec4V	z;
+	};
+
+	// PT: operations are done in the same order as their PxVec3 counterparts, so that results match the scalar code.
+	PX_FORCE_INLINE aos::Vec4V dotSoA(const SoAVec3& a, const SoAVec3& b)
+	{
+		using namespace aos;
+		return V4Add(V4Add(V4Mul(a.x, b.x), V4Mul(a.y, b.y)), V4Mul(a.z, b.z));
+	}
+
+	PX_FORCE_INLINE void subSoA(SoAVec3& out, const SoAVec3& a, const SoAVec3& b)
+	{
+		using namespace aos;
+		out.x = V4Sub(a.x, b.x);
+		out.y = V4Sub(a.y, b.y);
+		out.z = V4Sub(a.z, b.z);
+	}
+
+	// PT: out = a + b*s
+	PX_FORCE_INLINE void addScaledSoA(SoAVec3& out, const SoAVec3& a, const SoAVec3& b, const aos::Vec4V s)
+	{
+		using namespace aos;
+		out.x = V4Add(a.x, V4Mul(b.x, s));
+		out.y = V4Add(a.y, V4Mul(b.y, s));
+		out.z = V4Add(a.z, V4Mul(b.z, s));
+	}
+
+	PX_FORCE_INLINE void splatSoA(SoAVec3& out, const PxVec3& v)
+	{
+		using namespace aos;
+		out.x = V4Load(v.x);
+		out.y = V4Load(v.y);
+		out.z = V4Load(v.z);
+	}
+
+	// PT: rotates 4 vectors by the same matrix
+	PX_FORCE_INLINE void rotateSoA(SoAVec3& out, const PxMat33& m, const SoAVec3& v)
+	{
+		using namespace aos;
+		const Vec4V x = V4Add(V4Add(V4Mul(V4Load(m.column0.x), v.x), V4Mul(V4Load(m.column1.x), v.y)), V4Mul(V4Load(m.column2.x), v.z));
+		const Vec4V y = V4Add(V4Add(V4Mul(V4Load(m.column0.y), v.x), V4Mul(V4Load(m.column1.y), v.y)), V4Mul(V4Load(m.column2.y), v.z));
+		const Vec4V z = V4Add(V4Add(V4Mul(V4Load(m.column0.z), v.x), V4Mul(V4Load(m.column1.z), v.y)), V4Mul(V4Load(m.column2.z), v.z));
+		out.x = x;
+		out.y = y;
+		out.z = z;
+	}
+
+	// PT: same as rotateSoA with the transposed matrix, i.e. dot products with the matrix columns
+	PX_FORCE_INLINE void rotateTransposeSoA(SoAVec3& out, const PxMat33& m, const SoAVec3& v)
+	{
+		using namespace aos;
+		const Vec4V x = V4Add(V4Add(V4Mul(V4Load(m.column0.x), v.x), V4Mul(V4Load(m.column0.y), v.y)), V4Mul(V4Load(m.column0.z), v.z));
+		const Vec4V y = V4Add(V4Add(V4Mul(V4Load(m.column1.x), v.x), V4Mul(V4Load(m.column1.y), v.y)), V4Mul(V4Load(m.column1.z), v.z));
+		const Vec4V z = V4Add(V4Add(V4Mul(V4Load(m.column2.x), v.x), V4Mul(V4Load(m.column2.y), v.y)), V4Mul(V4Load(m.column2.z), v.z));
+		out.x = x;
+		out.y = y;
+		out.z = z;
+	}
+
+	// PT: loads 'nb' (1 to 4) vectors from a strided AoS array and transposes them. Unused lanes replicate the last vector.
+	// The last vector is loaded without reading past its end, so this is safe to use at the end of user arrays.
+	PX_FORCE_INLINE void loadSoA(SoAVec3& out, const PxVec3* PX_RESTRICT src, PxU32 nb, PxU32 stride = sizeof(PxVec3))
+	{
+		using namespace aos;
+		PX_ASSERT(nb && nb<=4);
+		const PxU8* PX_RESTRICT bytes = reinterpret_cast<const PxU8*>(src);
+		const PxVec3& last = *reinterpret_cast<const PxVec3*>(bytes + (nb-1)*stride);
+		const Vec4V lastV = V4LoadXYZW(last.x, last.y, last.z, 0.0f);
+		Vec4V v0 = nb>1 ? V4LoadU(&reinterpret_cast<const PxVec3*>(bytes)->x) : lastV;
+		Vec4V v1 = nb>2 ? V4LoadU(&reinterpret_cast<const PxVec3*>(bytes + stride)->x) : nb>1 ? lastV : v0;
+		Vec4V v2 = nb>3 ? V4LoadU(&reinterpret_cast<const PxVec3*>(bytes + stride*2)->x) : nb>2 ? lastV : v1;
+		Vec4V v3 = lastV;
+		PX_TRANSPOSE_44_34(v0, v1, v2, v3, out.x, out.y, out.z);
+	}
+
+	// PT: writes the first 'nb' (1 to 4) vectors to a strided AoS array
+	PX_FORCE_INLINE void storeSoA(PxVec3* PX_RESTRICT dst, const SoAVec3& v, PxU32 nb, PxU32 stride = sizeof(PxVec3))
+	{
+		using namespace aos;
+		PX_ALIGN(16, PxF32 x[4]);
+		PX_ALIGN(16, PxF32 y[4]);
+		PX_ALIGN(16, PxF32 z[4]);
+		V4StoreA(v.x, x);
+		V4StoreA(v.y, y);
+		V4StoreA(v.z, z);
+		PxU8* PX_RESTRICT bytes = reinterpret_cast<PxU8*>(dst);
+		for(PxU32 i=0;i<nb;i++)
+		{
+			PxVec3& d = *reinterpret_cast<PxVec3*>(bytes + i*stride);
+			d.x = x[i];
+			d.y = y[i];
+			d.z = z[i];
+		}
+	}
+
+} // namespace Gu
+
+}
+
+#endif
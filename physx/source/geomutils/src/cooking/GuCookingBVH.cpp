@@ -55,7 +55,15 @@ static bool buildBVH(const PxBVHDesc& desc, BVHData& data, const char* errorMess
 	else //if(desc.buildStrategy==PxBVHBuildStrategy::eSAH)
 		bs = BVH_SAH;
 
-	return data.build(desc.bounds.count, desc.bounds.data, desc.bounds.stride, desc.enlargement, desc.numPrimsPerLeaf, bs);
+	BVHNodeWidth nw;
+	if(desc.nodeWidth==PxBVHNodeWidth::eWIDE_4)
+		nw = BVH_WIDE_4;
+	else if(desc.nodeWidth==PxBVHNodeWidth::eWIDE_8)
+		nw = BVH_WIDE_8;
+	else //if(desc.nodeWidth==PxBVHNodeWidth::eBINARY)
+		nw = BVH_BINARY;
+
+	return data.build(desc.bounds.count, desc.bounds.data, desc.bounds.stride, desc.enlargement, desc.numPrimsPerLeaf, bs, nw, desc.dispatcher);
 }
 
 bool immediateCooking::cookBVH(const PxBVHDesc& desc, PxOutputStream& stream)
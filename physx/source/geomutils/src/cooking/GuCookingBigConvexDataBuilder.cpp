@@ -40,6 +40,7 @@
 #include "GuCookingBigConvexDataBuilder.h"
 
 #include "GuCookingConvexHullBuilder.h"
+#include "GuCookingScratch.h"
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -50,7 +51,7 @@ using namespace aos;
 static const PxU32 gSupportVersion = 0;
 static const PxU32 gVersion = 0;
 
-BigConvexDataBuilder::BigConvexDataBuilder(const Gu::ConvexHullData* hull, BigConvexData* gm, const PxVec3* hullVerts) : mHullVerts(hullVerts)
+BigConvexDataBuilder::BigConvexDataBuilder(const Gu::ConvexHullData* hull, BigConvexData* gm, const PxVec3* hullVerts, Gu::CookingScratch* scratch) : mHullVerts(hullVerts), mScratch(scratch)
 {
 	mSVM = gm;
 	mHull = hull;
@@ -338,7 +339,7 @@ bool BigConvexDataBuilder::saveValencies(PxOutputStream& stream, bool platformMi
 	writeDword(mSVM->mData.mNbAdjVerts, platformMismatch, stream);
 
 	{
-		PxU16* temp = PX_ALLOCATE(PxU16, mSVM->mData.mNbVerts, "tmp");
+		PxU16* temp = Gu::scratchAllocate<PxU16>(mScratch, mSVM->mData.mNbVerts, "tmp");
 		for(PxU32 i=0;i<mSVM->mData.mNbVerts;i++)
 			temp[i] = mSVM->mData.mValencies[i].mCount;
 
@@ -346,7 +347,7 @@ bool BigConvexDataBuilder::saveValencies(PxOutputStream& stream, bool platformMi
 		writeDword(maxIndex, platformMismatch, stream);
 		Cm::StoreIndices(PxTo16(maxIndex), mSVM->mData.mNbVerts, temp, stream, platformMismatch);
 
-		PX_FREE(temp);
+		Gu::scratchFree(mScratch, temp);
 	}
 	stream.write(mSVM->mData.mAdjacentVerts, mSVM->mData.mNbAdjVerts);
 
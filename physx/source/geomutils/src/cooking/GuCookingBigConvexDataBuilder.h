@@ -36,11 +36,15 @@ namespace physx
 {
 	class BigConvexData;
 	class ConvexHullBuilder;
+	namespace Gu
+	{
+		class CookingScratch;
+	}
 
 	class BigConvexDataBuilder : public PxUserAllocated
 	{
 		public:
-									BigConvexDataBuilder(const Gu::ConvexHullData* hull, BigConvexData* gm, const PxVec3* hullVerts);
+									BigConvexDataBuilder(const Gu::ConvexHullData* hull, BigConvexData* gm, const PxVec3* hullVerts, Gu::CookingScratch* scratch = NULL);
 									~BigConvexDataBuilder();
 	// Support vertex map
 				bool				precompute(PxU32 subdiv);				
@@ -62,6 +66,7 @@ namespace physx
 		const Gu::ConvexHullData*	mHull;
 		BigConvexData*				mSVM;
 		const	PxVec3*				mHullVerts;
+		Gu::CookingScratch*			mScratch;
 
 	};
 
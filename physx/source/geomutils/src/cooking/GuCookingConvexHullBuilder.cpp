@@ -35,6 +35,7 @@
 #include "GuMeshCleaner.h"
 #include "GuCookingConvexHullBuilder.h"
 #include "GuCookingConvexHullLib.h"
+#include "GuCookingScratch.h"
 #include "foundation/PxArray.h"
 #include "foundation/PxVecMath.h"
 #include "CmRadixSort.h"
@@ -60,7 +61,7 @@ PX_IMPLEMENT_OUTPUT_ERROR
 ///////////////////////////////////////////////////////////////////////////////
 
 // default constructor 
-ConvexHullBuilder::ConvexHullBuilder(ConvexHullData* hull, const bool buildGRBData) : 
+ConvexHullBuilder::ConvexHullBuilder(ConvexHullData* hull, const bool buildGRBData, CookingScratch* scratch) : 
 	mHullDataHullVertices		(NULL),
 	mHullDataPolygons			(NULL),
 	mHullDataVertexData8		(NULL),
@@ -69,6 +70,7 @@ ConvexHullBuilder::ConvexHullBuilder(ConvexHullData* hull, const bool buildGRBDa
 	mEdgeData16					(NULL),
 	mEdges						(NULL),
 	mHull						(hull),
+	mScratch					(scratch),
 	mBuildGRBData				(buildGRBData)
 {
 }
@@ -533,7 +535,7 @@ bool ConvexHullBuilder::createEdgeList(bool doValidation, PxU32 nbEdges)
 	PX_FREE(mHullDataFacesByEdges8);
 	mHullDataFacesByEdges8 = PX_ALLOCATE(PxU8, nbEdgesUnshared, "mHullDataFacesByEdges8");
 
-	PxU32* tempBuffer = PX_ALLOCATE(PxU32, nbEdgesUnshared*8, "tmp");	// Temp storage
+	PxU32* tempBuffer = scratchAllocate<PxU32>(mScratch, nbEdgesUnshared*8, "tmp");	// Temp storage
 	PxU32* bufferAdd = tempBuffer;
 	PxU32*	PX_RESTRICT vRefs0		= tempBuffer; tempBuffer += nbEdgesUnshared;
 	PxU32*	PX_RESTRICT vRefs1		= tempBuffer; tempBuffer += nbEdgesUnshared;
@@ -545,7 +547,7 @@ bool ConvexHullBuilder::createEdgeList(bool doValidation, PxU32 nbEdges)
 	PxU32*	edgeData = tempBuffer; tempBuffer += nbEdgesUnshared;	
 
 	// TODO avoroshilov: use the same "tempBuffer"
-	bool* flippedVRefs = PX_ALLOCATE(bool, nbEdgesUnshared, "tmp");	// Temp storage
+	bool* flippedVRefs = scratchAllocate<bool>(mScratch, nbEdgesUnshared, "tmp");	// Temp storage
 
 	PxU32* run0 = vRefs0;
 	PxU32* run1 = vRefs1;
@@ -680,7 +682,7 @@ bool ConvexHullBuilder::createEdgeList(bool doValidation, PxU32 nbEdges)
 		for (PxU32 i = 0; i < nbEdgesUnshared; i++)	edgeData[i] = edgeIndex[sorted[i]];
 
 		const PxU16 nbToGo = PxU16(mHull->mNbEdges);
-		EdgeDescData* edgeToTriangles = PX_ALLOCATE(EdgeDescData, nbToGo, "edgeToTriangles");
+		EdgeDescData* edgeToTriangles = scratchAllocate<EdgeDescData>(mScratch, nbToGo, "edgeToTriangles");
 		PxMemZero(edgeToTriangles, sizeof(EdgeDescData)*nbToGo);
 
 		PxU32* data = edgeData;
@@ -695,14 +697,14 @@ bool ConvexHullBuilder::createEdgeList(bool doValidation, PxU32 nbEdges)
 			if (edgeToTriangles[i].Count != 2)
 				return outputError<PxErrorCode::eINTERNAL_ERROR>(__LINE__, "Cooking::cookConvexMesh: non-manifold mesh cannot be used, invalid mesh!");
 		}
-		PX_FREE(edgeToTriangles);
+		scratchFree(mScratch, edgeToTriangles);
 	}
 
 	// TODO avoroshilov: use the same "tempBuffer"
-	PX_FREE(flippedVRefs);
+	scratchFree(mScratch, flippedVRefs);
 
 	// ### free temp ram
-	PX_FREE(bufferAdd);
+	scratchFree(mScratch, bufferAdd);
 
 	return true;
 }
@@ -41,6 +41,7 @@ namespace physx
 
 	namespace Gu
 	{
+		class CookingScratch;
 		struct EdgeDescData;
 		struct ConvexHullData;
 	} // namespace Gu
@@ -48,7 +49,7 @@ namespace physx
 	class ConvexHullBuilder : public PxUserAllocated
 	{
 		public:
-												ConvexHullBuilder(Gu::ConvexHullData* hull, const bool buildGRBData);
+												ConvexHullBuilder(Gu::ConvexHullData* hull, const bool buildGRBData, Gu::CookingScratch* scratch = NULL);
 												~ConvexHullBuilder();
 
 					bool						init(PxU32 nbVerts, const PxVec3* verts, const PxU32* indices, const PxU32 nbIndices, const PxU32 nbPolygons, 
@@ -78,6 +79,7 @@ namespace physx
 					PxU16*						mEdges;			//!< Edge to vertex mapping
 
 					Gu::ConvexHullData*			mHull;
+					Gu::CookingScratch*			mScratch;		//!< Optional arena for temporary buffers
 					bool						mBuildGRBData;
 	};
 }
@@ -27,6 +27,7 @@
 // Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
 
 #include "GuCookingConvexHullLib.h"
+#include "GuCookingScratch.h"
 #include "GuQuantizer.h"
 #include "foundation/PxAllocator.h"
 #include "foundation/PxBounds3.h"
@@ -131,7 +132,7 @@ namespace local
 bool ConvexHullLib::shiftAndcleanupVertices(PxU32 svcount, const PxVec3* svertices, PxU32 stride,
 	PxU32& vcount, PxVec3* vertices)
 {
-	mShiftedVerts = PX_ALLOCATE(PxVec3, svcount, "PxVec3");
+	mShiftedVerts = scratchAllocate<PxVec3>(mScratch, svcount, "PxVec3");
 	const char* vtx = reinterpret_cast<const char *> (svertices);
 	PxBounds3 bounds;
 	bounds.setEmpty();
@@ -239,7 +240,7 @@ void ConvexHullLib::swapLargestFace(PxConvexMeshDesc& desc)
 		return;
 
 	const PxU32* indices = reinterpret_cast<const PxU32*>(desc.indices.data);
-	mSwappedIndices = PX_ALLOCATE(PxU32, desc.indices.count, "PxU32");
+	mSwappedIndices = scratchAllocate<PxU32>(mScratch, desc.indices.count, "PxU32");
 
 	PxHullPolygon replacedPolygon = polygons[0];
 	PxHullPolygon largestPolygon = polygons[largestFace];
@@ -280,6 +281,6 @@ void ConvexHullLib::swapLargestFace(PxConvexMeshDesc& desc)
 
 ConvexHullLib::~ConvexHullLib()
 {
-	PX_FREE(mSwappedIndices);
-	PX_FREE(mShiftedVerts);
+	scratchFree(mScratch, mSwappedIndices);
+	scratchFree(mScratch, mShiftedVerts);
 }
@@ -34,6 +34,11 @@
 
 namespace physx
 {	
+	namespace Gu
+	{
+		class CookingScratch;
+	}
+
 	//////////////////////////////////////////////////////////////////////////
 	// base class for the convex hull libraries - inflation based and quickhull
 	class ConvexHullLib
@@ -41,9 +46,9 @@ namespace physx
 		PX_NOCOPY(ConvexHullLib)
 	public:
 		// functions
-		ConvexHullLib(const PxConvexMeshDesc& desc, const PxCookingParams& params)
+		ConvexHullLib(const PxConvexMeshDesc& desc, const PxCookingParams& params, Gu::CookingScratch* scratch = NULL)
 			: mConvexMeshDesc(desc), mCookingParams(params), mSwappedIndices(NULL),
-			mShiftedVerts(NULL)
+			mShiftedVerts(NULL), mScratch(scratch)
 		{
 		}
 
@@ -86,6 +91,7 @@ namespace physx
 		PxU32*					mSwappedIndices;
 		PxVec3					mOriginShift;
 		PxVec3*					mShiftedVerts;
+		Gu::CookingScratch*		mScratch;			// optional arena for temporary buffers, see GuCookingScratch.h
 	};
 }
 
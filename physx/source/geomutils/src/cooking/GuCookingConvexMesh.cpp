@@ -30,6 +30,7 @@
 #include "GuCookingConvexMeshBuilder.h"
 #include "GuCookingQuickHullConvexHullLib.h"
 #include "GuConvexMesh.h"
+#include "GuCookingScratch.h"
 #include "foundation/PxAlloca.h"
 #include "foundation/PxFPU.h"
 #include "common/PxInsertionCallback.h"
@@ -119,7 +120,7 @@ static bool cookConvexMeshInternal(const PxCookingParams& params, const PxConvex
 	return true;
 }
 
-static ConvexHullLib* createHullLib(PxConvexMeshDesc& desc, const PxCookingParams& params)
+static ConvexHullLib* createHullLib(PxConvexMeshDesc& desc, const PxCookingParams& params, CookingScratch* scratch)
 {	
 	if(desc.flags & PxConvexFlag::eCOMPUTE_CONVEX)
 	{			
@@ -133,20 +134,20 @@ static ConvexHullLib* createHullLib(PxConvexMeshDesc& desc, const PxCookingParam
 			desc.polygonLimit = PxMin(desc.polygonLimit, gpuMaxFacesLimit);
 		}
 
-		return PX_NEW(QuickHullConvexHullLib) (desc, params);
+		return PX_NEW(QuickHullConvexHullLib) (desc, params, scratch);
 	}
 	return NULL;
 }
 
-bool immediateCooking::cookConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc_, PxOutputStream& stream, PxConvexMeshCookingResult::Enum* condition)
+static bool cookConvexMeshWithScratch(const PxCookingParams& params, const PxConvexMeshDesc& desc_, PxOutputStream& stream, PxConvexMeshCookingResult::Enum* condition, CookingScratch* scratch)
 {	
 	PX_FPU_GUARD;
 
 	// choose cooking library if needed
     PxConvexMeshDesc desc = desc_;
-	ConvexHullLib* hullLib = createHullLib(desc, params);
+	ConvexHullLib* hullLib = createHullLib(desc, params, scratch);
 
-	ConvexMeshBuilder meshBuilder(params.buildGPUData);
+	ConvexMeshBuilder meshBuilder(params.buildGPUData, scratch);
 	if(!cookConvexMeshInternal(params, desc, meshBuilder, hullLib, condition))
 	{
 		PX_DELETE(hullLib);
@@ -154,7 +155,7 @@ bool immediateCooking::cookConvexMesh(const PxCookingParams& params, const PxCon
 	}
 
 	// save the cooked results into stream
-	if(!meshBuilder.save(stream, platformMismatch()))
+	if(!meshBuilder.save(stream, immediateCooking::platformMismatch()))
 	{		
 		if(condition)
 			*condition = PxConvexMeshCookingResult::eFAILURE;
@@ -167,13 +168,55 @@ bool immediateCooking::cookConvexMesh(const PxCookingParams& params, const PxCon
 	return true;
 }
 
+bool immediateCooking::cookConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxOutputStream& stream, PxConvexMeshCookingResult::Enum* condition)
+{
+	return cookConvexMeshWithScratch(params, desc, stream, condition, NULL);
+}
+
+namespace
+{
+	struct ConvexMeshBatchCooker
+	{
+		ConvexMeshBatchCooker(const PxCookingParams& params, const PxConvexMeshDesc* descs, PxOutputStream* const* streams, PxConvexMeshCookingResult::Enum* conditions) :
+			mParams(params), mDescs(descs), mStreams(streams), mConditions(conditions), mNbFailures(0)	{}
+
+		void operator()(PxU32 index, CookingScratch& scratch)
+		{
+			PxConvexMeshCookingResult::Enum condition = PxConvexMeshCookingResult::eFAILURE;
+			if(!cookConvexMeshWithScratch(mParams, mDescs[index], *mStreams[index], &condition, &scratch))
+				PxAtomicIncrement(&mNbFailures);
+			if(mConditions)
+				mConditions[index] = condition;
+		}
+
+		const PxCookingParams&						mParams;
+		const PxConvexMeshDesc*						mDescs;
+		PxOutputStream* const*						mStreams;
+		PxConvexMeshCookingResult::Enum*			mConditions;
+		volatile PxI32								mNbFailures;
+
+		PX_NOCOPY(ConvexMeshBatchCooker)
+	};
+}
+
+bool immediateCooking::cookConvexMeshes(const PxCookingParams& params, PxU32 nbMeshes, const PxConvexMeshDesc* descs, PxOutputStream* const* streams, PxConvexMeshCookingResult::Enum* conditions)
+{
+	// PT: items are distributed over the dispatcher's threads, so each of them is cooked single-threaded
+	PxCookingParams itemParams = params;
+	itemParams.dispatcher = NULL;
+
+	ConvexMeshBatchCooker cooker(itemParams, descs, streams, conditions);
+	runCookingBatch(params.dispatcher, nbMeshes, cooker);
+	return cooker.mNbFailures==0;
+}
+
 PxConvexMesh* immediateCooking::createConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc_, PxInsertionCallback& insertionCallback, PxConvexMeshCookingResult::Enum* condition)
 {
 	PX_FPU_GUARD;
 
 	// choose cooking library if needed
 	PxConvexMeshDesc desc = desc_;
-	ConvexHullLib* hullLib = createHullLib(desc, params);
+	ConvexHullLib* hullLib = createHullLib(desc, params, NULL);
 
 	// cook the mesh
 	ConvexMeshBuilder meshBuilder(params.buildGPUData);
@@ -49,7 +49,7 @@ PX_IMPLEMENT_OUTPUT_ERROR
 
 ///////////////////////////////////////////////////////////////////////////////
 
-ConvexMeshBuilder::ConvexMeshBuilder(const bool buildGRBData) : hullBuilder(&mHullData, buildGRBData), mSdfData(NULL), mBigConvexData(NULL), mMass(0.0f), mInertia(PxIdentity)
+ConvexMeshBuilder::ConvexMeshBuilder(const bool buildGRBData, CookingScratch* scratch) : hullBuilder(&mHullData, buildGRBData, scratch), mSdfData(NULL), mBigConvexData(NULL), mMass(0.0f), mInertia(PxIdentity)
 {
 }
 
@@ -130,7 +130,7 @@ bool ConvexMeshBuilder::save(PxOutputStream& stream, bool platformMismatch) cons
 	if(mBigConvexData)
 	{
 		writeFloat(1.0f, platformMismatch, stream);		//gauss map flag true
-		BigConvexDataBuilder SVMB(&mHullData, mBigConvexData, hullBuilder.mHullDataHullVertices);
+		BigConvexDataBuilder SVMB(&mHullData, mBigConvexData, hullBuilder.mHullDataHullVertices, hullBuilder.mScratch);
 		SVMB.save(stream, platformMismatch);
 	}
 	else
@@ -411,7 +411,7 @@ bool ConvexMeshBuilder::computeGaussMaps()
 
 	PX_DELETE(mBigConvexData);	
 	PX_NEW_SERIALIZED(mBigConvexData,BigConvexData);	
-	BigConvexDataBuilder SVMB(&mHullData, mBigConvexData, hullBuilder.mHullDataHullVertices);
+	BigConvexDataBuilder SVMB(&mHullData, mBigConvexData, hullBuilder.mHullDataHullVertices, hullBuilder.mScratch);
 	// valencies we need to compute first, they are needed for min/max precompute	
 	SVMB.computeValencies(hullBuilder);
 	SVMB.precompute(density);
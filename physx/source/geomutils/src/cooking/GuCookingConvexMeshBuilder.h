@@ -48,7 +48,7 @@ namespace physx
 	class ConvexMeshBuilder
 	{
 	public:
-									ConvexMeshBuilder(const bool buildGRBData);
+									ConvexMeshBuilder(const bool buildGRBData, Gu::CookingScratch* scratch = NULL);
 									~ConvexMeshBuilder();
 
 				// loads the computed or given convex hull from descriptor. 
@@ -36,6 +36,7 @@
 #include "foundation/PxArray.h"
 
 #include "GuCookingConvexPolygonsBuilder.h"
+#include "GuCookingScratch.h"
 
 using namespace physx;
 using namespace Gu;
@@ -314,11 +315,11 @@ static bool TestUnifiedNormals(PxU32 nbVerts, const PxVec3* verts, PxU32 nbFaces
 
 //////////////////////////////////////////////////////////////////////////
 // clean the mesh
-static bool CleanFaces(PxU32& nbFaces, IndexedTriangle32* faces, PxU32& nbVerts, PxVec3* verts)
+static bool CleanFaces(PxU32& nbFaces, IndexedTriangle32* faces, PxU32& nbVerts, PxVec3* verts, CookingScratch* scratch)
 {
 	// Brute force mesh cleaning.
 	// PT: I added this back on Feb-18-05 because it fixes bugs with hulls from QHull.	
-	MeshCleaner cleaner(nbVerts, verts, nbFaces, faces->mRef, 0.0f);
+	MeshCleaner cleaner(nbVerts, verts, nbFaces, faces->mRef, 0.0f, NULL, scratch);
 	if (!cleaner.mNbTris)
 		return false;
 
@@ -974,8 +975,8 @@ static bool extractHullPolygons(PxU32& nb_polygons, PxArray<PxU32>& polygon_data
 
 //////////////////////////////////////////////////////////////////////////
 
-ConvexPolygonsBuilder::ConvexPolygonsBuilder(ConvexHullData* hull, const bool buildGRBData)
-	: ConvexHullBuilder(hull, buildGRBData), mNbHullFaces(0), mFaces(NULL)
+ConvexPolygonsBuilder::ConvexPolygonsBuilder(ConvexHullData* hull, const bool buildGRBData, CookingScratch* scratch)
+	: ConvexHullBuilder(hull, buildGRBData, scratch), mNbHullFaces(0), mFaces(NULL)
 {
 }
 
@@ -1020,7 +1021,7 @@ bool ConvexPolygonsBuilder::computeHullPolygons(const PxU32& nbVerts,const PxVec
 
 	// We don't trust the user at all... So, clean the hull.
 	PxU32 nbHullVerts = mHull->mNbHullVertices;
-	CleanFaces(mNbHullFaces, hullAsIndexedTriangle, nbHullVerts, mHullDataHullVertices);
+	CleanFaces(mNbHullFaces, hullAsIndexedTriangle, nbHullVerts, mHullDataHullVertices, mScratch);
 	PX_ASSERT(nbHullVerts<256);
 	mHull->mNbHullVertices = PxTo8(nbHullVerts);
 
@@ -1061,8 +1062,8 @@ bool ConvexPolygonsBuilder::createPolygonData()
 	if(rendundantVertices.size() > 0)
 	{
 		numReducedHullDataVertices = PxTo8(mHull->mNbHullVertices - rendundantVertices.size());
-		reducedHullDataHullVertices = PX_ALLOCATE(PxVec3, numReducedHullDataVertices, "Reduced vertices hull data");
-		PxU8* remapTable = PX_ALLOCATE(PxU8, mHull->mNbHullVertices, "remapTable");
+		reducedHullDataHullVertices = scratchAllocate<PxVec3>(mScratch, numReducedHullDataVertices, "Reduced vertices hull data");
+		PxU8* remapTable = scratchAllocate<PxU8>(mScratch, mHull->mNbHullVertices, "remapTable");
 
 		PxU8 currentIndex = 0;
 		for (PxU8 i = 0; i < mHull->mNbHullVertices; i++)
@@ -1095,7 +1096,7 @@ bool ConvexPolygonsBuilder::createPolygonData()
 			data += nbVerts;
 		}
 
-		PX_FREE(remapTable);
+		scratchFree(mScratch, remapTable);
 	}
 
 	if(nbPolygons>255)
@@ -1186,7 +1187,7 @@ bool ConvexPolygonsBuilder::createPolygonData()
 	if(reducedHullDataHullVertices != mHullDataHullVertices)
 	{
 		PxMemCopy(mHullDataHullVertices,reducedHullDataHullVertices,sizeof(PxVec3)*numReducedHullDataVertices);
-		PX_FREE(reducedHullDataHullVertices);
+		scratchFree(mScratch, reducedHullDataHullVertices);
 
 		mHull->mNbHullVertices = numReducedHullDataVertices;
 	}
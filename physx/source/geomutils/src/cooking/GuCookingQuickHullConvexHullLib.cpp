@@ -28,6 +28,7 @@
 
 #include "GuCookingQuickHullConvexHullLib.h"
 #include "GuCookingConvexHullUtils.h"
+#include "GuCookingScratch.h"
 
 #include "foundation/PxAllocator.h"
 #include "foundation/PxUserAllocated.h"
@@ -60,24 +61,25 @@ namespace local
 	class MemBlock
 	{
 	public:
-		MemBlock(PxU32 preallocateSize)
-			: mPreallocateSize(preallocateSize), mCurrentBlock(0), mCurrentIndex(0)
+		MemBlock(PxU32 preallocateSize, Gu::CookingScratch* scratch = NULL)
+			: mPreallocateSize(preallocateSize), mCurrentBlock(0), mCurrentIndex(0), mScratch(scratch)
 		{
 			PX_ASSERT(preallocateSize);
-			T* block = PX_ALLOCATE(T, preallocateSize, "Quickhull MemBlock");
+			T* block = Gu::scratchAllocate<T>(mScratch, preallocateSize, "Quickhull MemBlock");
 			mBlocks.pushBack(block);
 		}
 
 		MemBlock()
-			: mPreallocateSize(0), mCurrentBlock(0), mCurrentIndex(0)
+			: mPreallocateSize(0), mCurrentBlock(0), mCurrentIndex(0), mScratch(NULL)
 		{
 		}
 
-		void init(PxU32 preallocateSize)
+		void init(PxU32 preallocateSize, Gu::CookingScratch* scratch)
 		{
 			PX_ASSERT(preallocateSize);
 			mPreallocateSize = preallocateSize;
-			T* block = PX_ALLOCATE(T, preallocateSize, "Quickhull MemBlock");
+			mScratch = scratch;
+			T* block = Gu::scratchAllocate<T>(mScratch, preallocateSize, "Quickhull MemBlock");
 			if(useIndexing)
 			{
 				for (PxU32 i = 0; i < mPreallocateSize; i++)
@@ -93,7 +95,7 @@ namespace local
 		{
 			for (PxU32 i = 0; i < mBlocks.size(); i++)
 			{
-				PX_FREE(mBlocks[i]);
+				Gu::scratchFree(mScratch, mBlocks[i]);
 			}
 			mBlocks.clear();
 		}
@@ -102,14 +104,14 @@ namespace local
 		{
 			for (PxU32 i = 0; i < mBlocks.size(); i++)
 			{
-				PX_FREE(mBlocks[i]);
+				Gu::scratchFree(mScratch, mBlocks[i]);
 			}
 			mBlocks.clear();
 
 			mCurrentBlock = 0;
 			mCurrentIndex = 0;
 
-			init(mPreallocateSize);
+			init(mPreallocateSize, mScratch);
 		}
 
 		T* getItem(PxU32 index)
@@ -131,7 +133,7 @@ namespace local
 			}
 			else
 			{
-				T* block = PX_ALLOCATE(T, mPreallocateSize, "Quickhull MemBlock");
+				T* block = Gu::scratchAllocate<T>(mScratch, mPreallocateSize, "Quickhull MemBlock");
 				mCurrentBlock++;
 				if (useIndexing)
 				{
@@ -151,6 +153,7 @@ namespace local
 		PxU32			mPreallocateSize;
 		PxU32			mCurrentBlock;
 		PxU32			mCurrentIndex;
+		Gu::CookingScratch*	mScratch;
 		PxArray<T*>	mBlocks;
 	};
 
@@ -373,7 +376,7 @@ namespace local
 		PX_NOCOPY(QuickHull)
 	public:
 
-		QuickHull(const PxCookingParams& params, const PxConvexMeshDesc& desc);
+		QuickHull(const PxCookingParams& params, const PxConvexMeshDesc& desc, Gu::CookingScratch* scratch);
 
 		~QuickHull();
 
@@ -462,6 +465,7 @@ namespace local
 
 		const PxCookingParams&	mCookingParams;		// cooking params
 		const PxConvexMeshDesc& mConvexDesc;		// convex desc
+		Gu::CookingScratch*		mScratch;			// optional arena for the preallocated buffers
 
 		PxVec3					mInteriorPoint;		// interior point for int/ext tests
 
@@ -691,8 +695,8 @@ namespace local
 
 	//////////////////////////////////////////////////////////////////////////
 
-	QuickHull::QuickHull(const PxCookingParams& params, const PxConvexMeshDesc& desc)
-		: mCookingParams(params), mConvexDesc(desc), mOutputNumVertices(0), mTerminalVertex(0xFFFFFFFF), mVerticesList(NULL), mNumHullFaces(0), mPrecomputedMinMax(false),
+	QuickHull::QuickHull(const PxCookingParams& params, const PxConvexMeshDesc& desc, Gu::CookingScratch* scratch)
+		: mCookingParams(params), mConvexDesc(desc), mScratch(scratch), mOutputNumVertices(0), mTerminalVertex(0xFFFFFFFF), mVerticesList(NULL), mNumHullFaces(0), mPrecomputedMinMax(false),
 		mTolerance(-1.0f), mPlaneTolerance(-1.0f)
 	{
 	}
@@ -727,15 +731,15 @@ namespace local
 
 		// max num vertices = numVertices
 		mMaxVertices = PxMax(PxU32(8), numVertices); // 8 is min, since we can expand to AABB during the clean vertices phase
-		mVerticesList = PX_ALLOCATE(QuickHullVertex, mMaxVertices, "QuickHullVertex");
+		mVerticesList = Gu::scratchAllocate<QuickHullVertex>(mScratch, mMaxVertices, "QuickHullVertex");
 
 		// estimate the max half edges
 		PxU32 maxHalfEdges = (3 * mMaxVertices - 6) * 3;
-		mFreeHalfEdges.init(maxHalfEdges);
+		mFreeHalfEdges.init(maxHalfEdges, mScratch);
 
 		// estimate the max faces
 		PxU32 maxFaces = (2 * mMaxVertices - 4);
-		mFreeFaces.init(maxFaces*2);
+		mFreeFaces.init(maxFaces*2, mScratch);
 
 		mHullFaces.reserve(maxFaces);
 		mUnclaimedPoints.reserve(numVertices);
@@ -750,7 +754,7 @@ namespace local
 	// release internal buffers
 	void QuickHull::releaseHull()
 	{
-		PX_FREE(mVerticesList);
+		Gu::scratchFree(mScratch, mVerticesList);
 		mHullFaces.clear();
 	}
 
@@ -1789,10 +1793,10 @@ namespace local
 
 //////////////////////////////////////////////////////////////////////////
 
-QuickHullConvexHullLib::QuickHullConvexHullLib(const PxConvexMeshDesc& desc, const PxCookingParams& params)
-	: ConvexHullLib(desc, params),mQuickHull(NULL), mCropedConvexHull(NULL), mOutMemoryBuffer(NULL), mFaceTranslateTable(NULL)
+QuickHullConvexHullLib::QuickHullConvexHullLib(const PxConvexMeshDesc& desc, const PxCookingParams& params, Gu::CookingScratch* scratch)
+	: ConvexHullLib(desc, params, scratch),mQuickHull(NULL), mCropedConvexHull(NULL), mOutMemoryBuffer(NULL), mFaceTranslateTable(NULL)
 {
-	mQuickHull = PX_NEW(local::QuickHull)(params, desc);
+	mQuickHull = PX_NEW(local::QuickHull)(params, desc, scratch);
 	mQuickHull->preallocate(desc.points.count);
 }
 
@@ -1805,7 +1809,7 @@ QuickHullConvexHullLib::~QuickHullConvexHullLib()
 
 	PX_DELETE(mCropedConvexHull);
 
-	PX_FREE(mOutMemoryBuffer);
+	Gu::scratchFree(mScratch, mOutMemoryBuffer);
 	mFaceTranslateTable = NULL;  // memory is a part of mOutMemoryBuffer
 }
 
@@ -1825,7 +1829,7 @@ PxConvexMeshCookingResult::Enum QuickHullConvexHullLib::createConvexHull()
 	if ( vcount < 8 ) 
 		vcount = 8;
 
-	PxVec3* outvsource  = PX_ALLOCATE(PxVec3, vcount, "PxVec3");
+	PxVec3* outvsource  = Gu::scratchAllocate<PxVec3>(mScratch, vcount, "PxVec3");
 	PxU32 outvcount;
 
 	// cleanup the vertices first
@@ -1834,7 +1838,7 @@ PxConvexMeshCookingResult::Enum QuickHullConvexHullLib::createConvexHull()
 		if(!shiftAndcleanupVertices(mConvexMeshDesc.points.count, reinterpret_cast<const PxVec3*> (mConvexMeshDesc.points.data), mConvexMeshDesc.points.stride,
 			outvcount, outvsource))
 		{
-			PX_FREE(outvsource);
+			Gu::scratchFree(mScratch, outvsource);
 			return res;
 		}
 	}
@@ -1843,7 +1847,7 @@ PxConvexMeshCookingResult::Enum QuickHullConvexHullLib::createConvexHull()
 		if(!cleanupVertices(mConvexMeshDesc.points.count, reinterpret_cast<const PxVec3*> (mConvexMeshDesc.points.data), mConvexMeshDesc.points.stride,
 			outvcount, outvsource))
 		{
-			PX_FREE(outvsource);
+			Gu::scratchFree(mScratch, outvsource);
 			return res;
 		}
 	}
@@ -1910,7 +1914,7 @@ PxConvexMeshCookingResult::Enum QuickHullConvexHullLib::createConvexHull()
 		}
 	}
 
-	PX_FREE(outvsource);
+	Gu::scratchFree(mScratch, outvsource);
 	return res;
 }
 
@@ -2147,7 +2151,7 @@ PxConvexMeshCookingResult::Enum QuickHullConvexHullLib::expandHull()
 	}
 
 	// construct again the hull from the new points
-	local::QuickHull* newHull = PX_NEW(local::QuickHull)(mQuickHull->mCookingParams, mQuickHull->mConvexDesc);		
+	local::QuickHull* newHull = PX_NEW(local::QuickHull)(mQuickHull->mCookingParams, mQuickHull->mConvexDesc, mScratch);		
 	newHull->preallocate(expandPoints.size());
 	newHull->parseInputVertices(vertices,expandPoints.size());
 
@@ -2218,7 +2222,7 @@ PxConvexMeshCookingResult::Enum QuickHullConvexHullLib::expandHullOBB()
 	computeOBBFromConvex(convexDesc, sides, obbTransform);
 
 	// free the memory used for the convex mesh desc
-	PX_FREE(mOutMemoryBuffer);
+	Gu::scratchFree(mScratch, mOutMemoryBuffer);
 	mFaceTranslateTable = NULL;
 
 	// crop the OBB
@@ -2380,7 +2384,7 @@ void QuickHullConvexHullLib::fillConvexMeshDescFromQuickHull(PxConvexMeshDesc& d
 	const PxU32 faceTranslationTableSize = sizeof(PxU16)*numFacesOut;
 	const PxU32 translationTableSize = sizeof(PxU32)*mQuickHull->mNumVertices;
 	const PxU32 bufferMemorySize = indicesBufferSize + verticesBufferSize + facesBufferSize + faceTranslationTableSize + translationTableSize;
-	mOutMemoryBuffer = reinterpret_cast<PxU8*>(PX_ALLOC(bufferMemorySize, "ConvexMeshDesc"));
+	mOutMemoryBuffer = reinterpret_cast<PxU8*>(Gu::scratchAlloc(mScratch, bufferMemorySize, "ConvexMeshDesc"));
 
 	PxU32* indices = reinterpret_cast<PxU32*> (mOutMemoryBuffer);
 	PxVec3* vertices = reinterpret_cast<PxVec3*> (mOutMemoryBuffer + indicesBufferSize);
@@ -2497,7 +2501,7 @@ void QuickHullConvexHullLib::fillConvexMeshDescFromCroppedHull(PxConvexMeshDesc&
 	const PxU32 facesBufferSize = sizeof(PxHullPolygon)*numPolygons;
 	const PxU32 verticesBufferSize = sizeof(PxVec3)*(numVertices + 1); // allocate additional vec3 for V4 safe load in VolumeInteration
 	const PxU32 bufferMemorySize = indicesBufferSize + verticesBufferSize + facesBufferSize;
-	mOutMemoryBuffer = reinterpret_cast<PxU8*>(PX_ALLOC(bufferMemorySize, "ConvexMeshDesc"));
+	mOutMemoryBuffer = reinterpret_cast<PxU8*>(Gu::scratchAlloc(mScratch, bufferMemorySize, "ConvexMeshDesc"));
 
 	// parse the hullOut and fill the result with vertices and polygons
 	PxU32* indicesOut = reinterpret_cast<PxU32*> (mOutMemoryBuffer);	
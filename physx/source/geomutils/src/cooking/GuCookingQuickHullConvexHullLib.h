@@ -54,7 +54,7 @@ namespace physx
 	public:
 
 		// functions
-		QuickHullConvexHullLib(const PxConvexMeshDesc& desc, const PxCookingParams& params);
+		QuickHullConvexHullLib(const PxConvexMeshDesc& desc, const PxCookingParams& params, Gu::CookingScratch* scratch = NULL);
 
 		~QuickHullConvexHullLib();
 
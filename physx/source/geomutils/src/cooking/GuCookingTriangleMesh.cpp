@@ -47,6 +47,9 @@
 #include "GuCookingVolumeIntegration.h"
 #include "GuCookingSDF.h"
 #include "GuMeshAnalysis.h"
+#include "GuBuildTask.h"
+#include "GuCookingScratch.h"
+#include "GuTriangleMeshInPlace.h"
 
 using namespace physx;
 using namespace Gu;
@@ -58,9 +61,10 @@ PX_IMPLEMENT_OUTPUT_ERROR
 
 ///////////////////////////////////////////////////////////////////////////////
 
-TriangleMeshBuilder::TriangleMeshBuilder(TriangleMeshData& m, const PxCookingParams& params) :
+TriangleMeshBuilder::TriangleMeshBuilder(TriangleMeshData& m, const PxCookingParams& params, CookingScratch* scratch) :
 	mEdgeList	(NULL),
 	mParams		(params),
+	mScratch	(scratch),
 	mMeshData	(m)
 {
 }
@@ -118,7 +122,7 @@ bool TriangleMeshBuilder::cleanMesh(bool validate, PxTriangleMeshCookingResult::
 		else
 			meshWeldTolerance = mParams.meshWeldTolerance;
 	}
-	MeshCleaner cleaner(mMeshData.mNbVertices, mMeshData.mVertices, mMeshData.mNbTriangles, reinterpret_cast<const PxU32*>(mMeshData.mTriangles), meshWeldTolerance);
+	MeshCleaner cleaner(mMeshData.mNbVertices, mMeshData.mVertices, mMeshData.mNbTriangles, reinterpret_cast<const PxU32*>(mMeshData.mTriangles), meshWeldTolerance, mParams.dispatcher, mScratch);
 	if(!cleaner.mNbTris)
 		return false;
 
@@ -206,7 +210,7 @@ bool TriangleMeshBuilder::cleanMesh(bool validate, PxTriangleMeshCookingResult::
 	return true;
 }
 
-static EdgeList* createEdgeList(const TriangleMeshData& meshData)
+static EdgeList* createEdgeList(const TriangleMeshData& meshData, PxCpuDispatcher* dispatcher)
 {
 	EDGELISTCREATE create;
 	create.NbFaces		= meshData.mNbTriangles;
@@ -223,6 +227,7 @@ static EdgeList* createEdgeList(const TriangleMeshData& meshData)
 	create.FacesToEdges	= true;
 	create.EdgesToFaces	= true;
 	create.Verts		= meshData.mVertices;
+	create.Dispatcher	= dispatcher;
 	//create.Epsilon = 0.1f;
 	//	create.Epsilon		= convexEdgeThreshold;
 	EdgeList* edgeList = PX_NEW(EdgeList);
@@ -233,6 +238,76 @@ static EdgeList* createEdgeList(const TriangleMeshData& meshData)
 	return edgeList;
 }
 
+// PT: batches smaller than this are not worth a task
+#define SHARED_EDGE_DATA_MIN_BATCH_SIZE	8192
+
+namespace
+{
+	// PT: each triangle only writes its own flags
+	struct CopyActiveEdgeFlags
+	{
+		CopyActiveEdgeFlags(const EdgeList& edgeList, PxU8* extraTrigData) : mEdgeList(edgeList), mExtraTrigData(extraTrigData)	{}
+
+		void	operator()(PxU32 start, PxU32 end)
+		{
+			for(PxU32 i=start;i<end;i++)
+			{
+				const EdgeTriangleData& ET = mEdgeList.getEdgeTriangle(i);
+				// Replicate flags
+				if(EdgeTriangleAC::HasActiveEdge01(ET))
+					mExtraTrigData[i] |= ETD_CONVEX_EDGE_01;
+				if(EdgeTriangleAC::HasActiveEdge12(ET))
+					mExtraTrigData[i] |= ETD_CONVEX_EDGE_12;
+				if(EdgeTriangleAC::HasActiveEdge20(ET))
+					mExtraTrigData[i] |= ETD_CONVEX_EDGE_20;
+			}
+		}
+
+		const EdgeList&	mEdgeList;
+		PxU8*			mExtraTrigData;
+		PX_NOCOPY(CopyActiveEdgeFlags)
+	};
+
+	// PT: each edge writes the adjacency slot of its (up to) two triangles. A triangle slot is only referenced by
+	// one edge so edges can be processed in any order.
+	struct ComputeAdjacencies
+	{
+		ComputeAdjacencies(const EdgeList& edgeList, const IndexedTriangle32* trigs, TriangleMeshData& meshData) : mEdgeList(edgeList), mTrigs(trigs), mMeshData(meshData)	{}
+
+		void	operator()(PxU32 start, PxU32 end)
+		{
+			const EdgeDescData* ED = mEdgeList.getEdgeToTriangles();
+			const EdgeData* Edges = mEdgeList.getEdges();
+			const PxU32* FBE = mEdgeList.getFacesByEdges();
+
+			for(PxU32 i=start;i<end;i++)
+			{
+				// Get number of triangles sharing current edge
+				if(ED[i].Count > 1)
+				{
+					const PxU32 FaceIndex0 = FBE[ED[i].Offset+0];
+					const PxU32 FaceIndex1 = FBE[ED[i].Offset+1];
+
+					const EdgeData& edgeData = Edges[i];
+					const IndexedTriangle32& T0 = mTrigs[FaceIndex0];
+					const IndexedTriangle32& T1 = mTrigs[FaceIndex1];
+
+					const PxU32 offset0 = T0.findEdgeCCW(edgeData.Ref0,edgeData.Ref1);				
+					const PxU32 offset1 = T1.findEdgeCCW(edgeData.Ref0,edgeData.Ref1);
+
+					mMeshData.setTriangleAdjacency(FaceIndex0, FaceIndex1, offset0);
+					mMeshData.setTriangleAdjacency(FaceIndex1, FaceIndex0, offset1);
+				}
+			}
+		}
+
+		const EdgeList&				mEdgeList;
+		const IndexedTriangle32*	mTrigs;
+		TriangleMeshData&			mMeshData;
+		PX_NOCOPY(ComputeAdjacencies)
+	};
+}
+
 void TriangleMeshBuilder::createSharedEdgeData(bool buildAdjacencies, bool buildActiveEdges)
 {
 	GU_PROFILE_ZONE("createSharedEdgeData")
@@ -261,24 +336,15 @@ void TriangleMeshBuilder::createSharedEdgeData(bool buildAdjacencies, bool build
 
 	const IndexedTriangle32* trigs = reinterpret_cast<const IndexedTriangle32*>(mMeshData.mTriangles);
 
-	mEdgeList = createEdgeList(mMeshData);
+	mEdgeList = createEdgeList(mMeshData, mParams.dispatcher);
 
 	if(mEdgeList)
 	{
 		PX_ASSERT(mEdgeList->getNbFaces()==mMeshData.mNbTriangles);
 		if(mEdgeList->getNbFaces()==mMeshData.mNbTriangles)
 		{
-			for(PxU32 i=0;i<mEdgeList->getNbFaces();i++)
-			{
-				const EdgeTriangleData& ET = mEdgeList->getEdgeTriangle(i);
-				// Replicate flags
-				if(EdgeTriangleAC::HasActiveEdge01(ET))
-					mMeshData.mExtraTrigData[i] |= ETD_CONVEX_EDGE_01;
-				if(EdgeTriangleAC::HasActiveEdge12(ET))
-					mMeshData.mExtraTrigData[i] |= ETD_CONVEX_EDGE_12;
-				if(EdgeTriangleAC::HasActiveEdge20(ET))
-					mMeshData.mExtraTrigData[i] |= ETD_CONVEX_EDGE_20;
-			}
+			CopyActiveEdgeFlags copyFlags(*mEdgeList, mMeshData.mExtraTrigData);
+			runParallelRanges(mParams.dispatcher, mEdgeList->getNbFaces(), SHARED_EDGE_DATA_MIN_BATCH_SIZE, copyFlags);
 		}
 	}
 
@@ -288,34 +354,11 @@ void TriangleMeshBuilder::createSharedEdgeData(bool buildAdjacencies, bool build
 		mMeshData.mAdjacencies = PX_ALLOCATE(PxU32, nTrigs*3, "mAdjacencies");
 		memset(mMeshData.mAdjacencies, 0xFFFFffff, sizeof(PxU32)*nTrigs*3);		
 
-		PxU32 NbEdges = mEdgeList->getNbEdges();
-		const EdgeDescData* ED = mEdgeList->getEdgeToTriangles();
-		const EdgeData* Edges = mEdgeList->getEdges();
-		const PxU32* FBE = mEdgeList->getFacesByEdges();
-
-		while(NbEdges--)
-		{
-			// Get number of triangles sharing current edge
-			const PxU32 Count = ED->Count;
-			
-			if(Count > 1)
-			{
-				const PxU32 FaceIndex0 = FBE[ED->Offset+0];
-				const PxU32 FaceIndex1 = FBE[ED->Offset+1];
+		// PT: degenerate triangles can make two edges target the same adjacency slot, so we only go wide on cleaned meshes
+		PxCpuDispatcher* dispatcher = (mParams.meshPreprocessParams & PxMeshPreprocessingFlag::eDISABLE_CLEAN_MESH) ? NULL : mParams.dispatcher;
 
-				const EdgeData& edgeData = *Edges;
-				const IndexedTriangle32& T0 = trigs[FaceIndex0];
-				const IndexedTriangle32& T1 = trigs[FaceIndex1];
-
-				const PxU32 offset0 = T0.findEdgeCCW(edgeData.Ref0,edgeData.Ref1);				
-				const PxU32 offset1 = T1.findEdgeCCW(edgeData.Ref0,edgeData.Ref1);
-
-				mMeshData.setTriangleAdjacency(FaceIndex0, FaceIndex1, offset0);
-				mMeshData.setTriangleAdjacency(FaceIndex1, FaceIndex0, offset1);
-			}
-			ED++;
-			Edges++;
-		}
+		ComputeAdjacencies computeAdjacencies(*mEdgeList, trigs, mMeshData);
+		runParallelRanges(dispatcher, mEdgeList->getNbEdges(), SHARED_EDGE_DATA_MIN_BATCH_SIZE, computeAdjacencies);
 	}
 
 #if PX_DEBUG
@@ -985,7 +1028,7 @@ void TriangleMeshBuilder::checkMeshIndicesSize()
 
 ///////////////////////////////////////////////////////////////////////////////
 
-BV4TriangleMeshBuilder::BV4TriangleMeshBuilder(const PxCookingParams& params) : TriangleMeshBuilder(mData, params)
+BV4TriangleMeshBuilder::BV4TriangleMeshBuilder(const PxCookingParams& params, CookingScratch* scratch) : TriangleMeshBuilder(mData, params, scratch)
 {
 }
 
@@ -1034,7 +1077,7 @@ void BV4TriangleMeshBuilder::createMidPhaseStructure()
 		gubs = BV4_SAH;
 	else if(strategy==PxBVH34BuildStrategy::eFAST)
 		gubs = BV4_SPLATTER_POINTS;
-	if(!BuildBV4Ex(mData.mBV4Tree, mData.mMeshInterface, gBoxEpsilon, nbTrisPerLeaf, quantized, gubs))
+	if(!BuildBV4Ex(mData.mBV4Tree, mData.mMeshInterface, gBoxEpsilon, nbTrisPerLeaf, quantized, gubs, mParams.dispatcher))
 	{
 		outputError<PxErrorCode::eINTERNAL_ERROR>(__LINE__, "BV4 tree failed to build.");
 		return;
@@ -1214,7 +1257,7 @@ void BV32TriangleMeshBuilder::saveMidPhaseStructure(BV32Tree* bv32Tree, PxOutput
 
 ///////////////////////////////////////////////////////////////////////////////
 
-RTreeTriangleMeshBuilder::RTreeTriangleMeshBuilder(const PxCookingParams& params) : TriangleMeshBuilder(mData, params)
+RTreeTriangleMeshBuilder::RTreeTriangleMeshBuilder(const PxCookingParams& params, CookingScratch* scratch) : TriangleMeshBuilder(mData, params, scratch)
 {
 }
 
@@ -1370,7 +1413,7 @@ PxTriangleMesh* immediateCooking::createTriangleMesh(const PxCookingParams& para
 
 ///////////////////////////////////////////////////////////////////////////////
 
-bool immediateCooking::cookTriangleMesh(const PxCookingParams& params, const PxTriangleMeshDesc& desc, PxOutputStream& stream, PxTriangleMeshCookingResult::Enum* condition)
+static bool cookTriangleMeshWithScratch(const PxCookingParams& params, const PxTriangleMeshDesc& desc, PxOutputStream& stream, PxTriangleMeshCookingResult::Enum* condition, CookingScratch* scratch)
 {
 	struct Local
 	{
@@ -1391,15 +1434,184 @@ bool immediateCooking::cookTriangleMesh(const PxCookingParams& params, const PxT
 
 	if(params.midphaseDesc.getType() == PxMeshMidPhase::eBVH33)
 	{
-		RTreeTriangleMeshBuilder builder(params);
+		RTreeTriangleMeshBuilder builder(params, scratch);
 		return Local::cookTriangleMesh(params, builder, desc, stream, condition);
 	}
 	else
 	{
-		BV4TriangleMeshBuilder builder(params);
+		BV4TriangleMeshBuilder builder(params, scratch);
 		return Local::cookTriangleMesh(params, builder, desc, stream, condition);
 	}
 }
 
+bool immediateCooking::cookTriangleMesh(const PxCookingParams& params, const PxTriangleMeshDesc& desc, PxOutputStream& stream, PxTriangleMeshCookingResult::Enum* condition)
+{
+	return cookTriangleMeshWithScratch(params, desc, stream, condition, NULL);
+}
+
+namespace
+{
+	struct TriangleMeshBatchCooker
+	{
+		TriangleMeshBatchCooker(const PxCookingParams& params, const PxTriangleMeshDesc* descs, PxOutputStream* const* streams, PxTriangleMeshCookingResult::Enum* conditions) :
+			mParams(params), mDescs(descs), mStreams(streams), mConditions(conditions), mNbFailures(0)	{}
+
+		void operator()(PxU32 index, CookingScratch& scratch)
+		{
+			PxTriangleMeshCookingResult::Enum condition = PxTriangleMeshCookingResult::eFAILURE;
+			if(!cookTriangleMeshWithScratch(mParams, mDescs[index], *mStreams[index], &condition, &scratch))
+			{
+				PxAtomicIncrement(&mNbFailures);
+				if(condition == PxTriangleMeshCookingResult::eSUCCESS)
+					condition = PxTriangleMeshCookingResult::eFAILURE;
+			}
+			if(mConditions)
+				mConditions[index] = condition;
+		}
+
+		const PxCookingParams&						mParams;
+		const PxTriangleMeshDesc*					mDescs;
+		PxOutputStream* const*						mStreams;
+		PxTriangleMeshCookingResult::Enum*			mConditions;
+		volatile PxI32								mNbFailures;
+
+		PX_NOCOPY(TriangleMeshBatchCooker)
+	};
+}
+
+bool immediateCooking::cookTriangleMeshes(const PxCookingParams& params, PxU32 nbMeshes, const PxTriangleMeshDesc* descs, PxOutputStream* const* streams, PxTriangleMeshCookingResult::Enum* conditions)
+{
+	// PT: items are distributed over the dispatcher's threads, so each of them is cooked single-threaded
+	PxCookingParams itemParams = params;
+	itemParams.dispatcher = NULL;
+
+	TriangleMeshBatchCooker cooker(itemParams, descs, streams, conditions);
+	runCookingBatch(params.dispatcher, nbMeshes, cooker);
+	return cooker.mNbFailures==0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void writeInPlaceArray(PxOutputStream& stream, PxU32& currentOffset, PxU32 offset, const void* data, PxU32 size)
+{
+	if(!offset)
+		return;
+
+	static const PxU8 padding[GU_IN_PLACE_MESH_ALIGNMENT] = {};
+	PX_ASSERT(offset>=currentOffset && offset-currentOffset<GU_IN_PLACE_MESH_ALIGNMENT);
+	if(offset!=currentOffset)
+		stream.write(padding, offset - currentOffset);
+	stream.write(data, size);
+	currentOffset = offset + size;
+}
+
+bool BV4TriangleMeshBuilder::saveInPlace(PxOutputStream& stream) const
+{
+	const BV4TriangleData& data = mData;
+	const BV4Tree& tree = data.mBV4Tree;
+
+	const PxU32 nbTris = data.mNbTriangles;
+	const PxU32 verticesSize = sizeof(PxVec3)*data.mNbVertices;
+	const PxU32 trianglesSize = nbTris*3*(data.has16BitIndices() ? sizeof(PxU16) : sizeof(PxU32));
+	const PxU32 extraTrigDataSize = data.mExtraTrigData ? nbTris*sizeof(PxU8) : 0;
+	const PxU32 materialIndicesSize = data.mMaterialIndices ? nbTris*sizeof(PxU16) : 0;
+	const PxU32 faceRemapSize = data.mFaceRemap ? nbTris*sizeof(PxU32) : 0;
+	const PxU32 adjacenciesSize = data.mAdjacencies ? nbTris*3*sizeof(PxU32) : 0;
+	const PxU32 nodesSize = tree.mNbNodes*(tree.mQuantized ? sizeof(BVDataPackedQ) : sizeof(BVDataPackedNQ));
+
+	InPlaceTriangleMeshHeader header;
+	PxMemZero(&header, sizeof(InPlaceTriangleMeshHeader));
+	header.mTag							= computeInPlaceMeshTag();
+	header.mVersion						= GU_IN_PLACE_MESH_VERSION;
+	// PT: same flags as after loading the regular cooked format, where allocating the adjacencies sets the flag
+	header.mFlags						= data.mAdjacencies ? PxU32(data.mFlags | PxTriangleMeshFlag::eADJACENCY_INFO) : PxU32(data.mFlags);
+	header.mNbVertices					= data.mNbVertices;
+	header.mNbTriangles					= nbTris;
+	header.mNbNodes						= tree.mNbNodes;
+	header.mInitData					= tree.mInitData;
+	header.mAABBMin						= data.mAABB.minimum;
+	header.mGeomEpsilon					= data.mGeomEpsilon;
+	header.mAABBMax						= data.mAABB.maximum;
+	header.mQuantized					= tree.mQuantized ? 1 : 0;
+	header.mLocalBoundsCenter			= tree.mLocalBounds.mCenter;
+	header.mLocalBoundsExtentsMagnitude	= tree.mLocalBounds.mExtentsMagnitude;
+	header.mCenterOrMinCoeff			= tree.mCenterOrMinCoeff;
+	header.mExtentsOrMaxCoeff			= tree.mExtentsOrMaxCoeff;
+	header.mInertia						= data.mInertia;
+	header.mLocalCenterOfMass			= data.mLocalCenterOfMass;
+	header.mMass						= data.mMass;
+
+	// PT: compute the layout. Vertices get an extra padding vertex so that V4 loads of the last one are safe,
+	// and the total size is padded as well so that V4 loads at the end of the last array are safe too.
+	PxU32 offset = sizeof(InPlaceTriangleMeshHeader);
+	struct Local
+	{
+		static PxU32 reserve(PxU32& offset_, PxU32 size)
+		{
+			if(!size)
+				return 0;
+			const PxU32 start = alignInPlaceMeshOffset(offset_);
+			offset_ = start + size;
+			return start;
+		}
+	};
+	header.mVerticesOffset			= Local::reserve(offset, verticesSize + sizeof(PxVec3));
+	header.mTrianglesOffset			= Local::reserve(offset, trianglesSize);
+	header.mExtraTrigDataOffset		= Local::reserve(offset, extraTrigDataSize);
+	header.mMaterialIndicesOffset	= Local::reserve(offset, materialIndicesSize);
+	header.mFaceRemapOffset			= Local::reserve(offset, faceRemapSize);
+	header.mAdjacenciesOffset		= Local::reserve(offset, adjacenciesSize);
+	header.mNodesOffset				= Local::reserve(offset, nodesSize);
+	header.mTotalSize				= alignInPlaceMeshOffset(offset + sizeof(PxU32));
+
+	if(!header.mTrianglesOffset || !header.mNodesOffset)
+		return false;
+
+	stream.write(&header, sizeof(InPlaceTriangleMeshHeader));
+
+	PxU32 currentOffset = sizeof(InPlaceTriangleMeshHeader);
+	const PxVec3 paddingVertex(0.0f);
+	writeInPlaceArray(stream, currentOffset, header.mVerticesOffset, data.mVertices, verticesSize);
+	writeInPlaceArray(stream, currentOffset, currentOffset, &paddingVertex, sizeof(PxVec3));
+	writeInPlaceArray(stream, currentOffset, header.mTrianglesOffset, data.mTriangles, trianglesSize);
+	writeInPlaceArray(stream, currentOffset, header.mExtraTrigDataOffset, data.mExtraTrigData, extraTrigDataSize);
+	writeInPlaceArray(stream, currentOffset, header.mMaterialIndicesOffset, data.mMaterialIndices, materialIndicesSize);
+	writeInPlaceArray(stream, currentOffset, header.mFaceRemapOffset, data.mFaceRemap, faceRemapSize);
+	writeInPlaceArray(stream, currentOffset, header.mAdjacenciesOffset, data.mAdjacencies, adjacenciesSize);
+	writeInPlaceArray(stream, currentOffset, header.mNodesOffset, tree.mNodes, nodesSize);
+
+	static const PxU8 padding[GU_IN_PLACE_MESH_ALIGNMENT*2] = {};
+	PX_ASSERT(header.mTotalSize-currentOffset<=sizeof(padding));
+	stream.write(padding, header.mTotalSize - currentOffset);
+	return true;
+}
+
+bool immediateCooking::cookTriangleMeshInPlace(const PxCookingParams& params, const PxTriangleMeshDesc& desc, PxOutputStream& stream, PxTriangleMeshCookingResult::Enum* condition)
+{
+	if(condition)
+		*condition = PxTriangleMeshCookingResult::eFAILURE;
+
+	if(params.midphaseDesc.getType() != PxMeshMidPhase::eBVH34)
+		return outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "PxCookTriangleMeshInPlace: only BVH34 meshes are supported.");
+
+	if(params.buildGPUData || desc.sdfDesc)
+		return outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "PxCookTriangleMeshInPlace: GPU data and SDFs are not supported.");
+
+	// cooking code does lots of float bitwise reinterpretation that generates exceptions
+	PX_FPU_GUARD;
+
+	BV4TriangleMeshBuilder builder(params);
+	if(condition)
+		*condition = PxTriangleMeshCookingResult::eSUCCESS;
+	if(!builder.loadFromDesc(desc, condition, false))
+		return false;
+
+	// PT: same as for runtime-inserted meshes, the image stores the final index format
+	if(!(params.meshPreprocessParams & PxMeshPreprocessingFlag::eFORCE_32BIT_INDICES))
+		builder.checkMeshIndicesSize();
+
+	return builder.saveInPlace(stream);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -37,12 +37,13 @@ namespace physx
 	namespace Gu
 	{
 		class EdgeList;
+		class CookingScratch;
 	}
 
 	class TriangleMeshBuilder
 	{
 		public:
-											TriangleMeshBuilder(Gu::TriangleMeshData& mesh, const PxCookingParams& params);
+											TriangleMeshBuilder(Gu::TriangleMeshData& mesh, const PxCookingParams& params, Gu::CookingScratch* scratch = NULL);
 		virtual								~TriangleMeshBuilder();
 
 		virtual	PxMeshMidPhase::Enum		getMidphaseID()									const	= 0;
@@ -82,13 +83,14 @@ namespace physx
 				TriangleMeshBuilder& operator=(const TriangleMeshBuilder&);
 				Gu::EdgeList*				mEdgeList;
 				const PxCookingParams&		mParams;
+				Gu::CookingScratch*			mScratch;	// optional arena for temporary buffers
 				Gu::TriangleMeshData&		mMeshData;
 	};
 
 	class RTreeTriangleMeshBuilder : public TriangleMeshBuilder
 	{
 		public:
-											RTreeTriangleMeshBuilder(const PxCookingParams& params);
+											RTreeTriangleMeshBuilder(const PxCookingParams& params, Gu::CookingScratch* scratch = NULL);
 		virtual								~RTreeTriangleMeshBuilder();
 
 		virtual	PxMeshMidPhase::Enum		getMidphaseID()	const	{ return PxMeshMidPhase::eBVH33;	}
@@ -101,7 +103,7 @@ namespace physx
 	class BV4TriangleMeshBuilder : public TriangleMeshBuilder
 	{
 		public:
-											BV4TriangleMeshBuilder(const PxCookingParams& params);
+											BV4TriangleMeshBuilder(const PxCookingParams& params, Gu::CookingScratch* scratch = NULL);
 		virtual								~BV4TriangleMeshBuilder();
 
 		virtual	PxMeshMidPhase::Enum		getMidphaseID()	const	{ return PxMeshMidPhase::eBVH34;	}
@@ -109,6 +111,9 @@ namespace physx
 		virtual	void						saveMidPhaseStructure(PxOutputStream& stream, bool mismatch)	const;
 		virtual	void						onMeshIndexFormatChange();
 
+				// Saves the mesh as an in-place image (see GuTriangleMeshInPlace.h)
+				bool						saveInPlace(PxOutputStream& stream)	const;
+
 				Gu::BV4TriangleData			mData;
 	};
 
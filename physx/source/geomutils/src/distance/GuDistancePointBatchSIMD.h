@@ -0,0 +1,97 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef GU_DISTANCE_POINT_BATCH_SIMD_H
+#define GU_DISTANCE_POINT_BATCH_SIMD_H
+
+#include "GuSoAVec3.h"
+
+namespace physx
+{
+namespace Gu
+{
+	// PT: SoA version of distancePointBoxSquared(), for 4 points already expressed in the box's local space.
+	// Returns the squared distances and writes the closest points (in local space) to 'closest'.
+	PX_FORCE_INLINE aos::Vec4V distancePointBoxSquaredSoA(const SoAVec3& localPoints, const PxVec3& boxExtent, SoAVec3& closest)
+	{
+		using namespace aos;
+		const Vec4V* PX_RESTRICT p = &localPoints.x;
+		Vec4V* PX_RESTRICT c = &closest.x;
+
+		Vec4V sqrDistance = V4Zero();
+		for(PxU32 ax=0; ax<3; ax++)
+		{
+			const Vec4V e = V4Load(boxExtent[ax]);
+			const Vec4V minusE = V4Neg(e);
+			const BoolV below = V4IsGrtr(minusE, p[ax]);
+			const BoolV above = V4IsGrtr(p[ax], e);
+			const Vec4V delta = V4Sel(below, V4Add(p[ax], e), V4Sel(above, V4Sub(p[ax], e), V4Zero()));
+			sqrDistance = V4Add(sqrDistance, V4Mul(delta, delta));
+			c[ax] = V4Sel(below, minusE, V4Sel(above, e, p[ax]));
+		}
+		return sqrDistance;
+	}
+
+	// PT: SoA version of distancePointSegmentSquaredInternal(), for 4 points against the same segment (dir = p1 - p0).
+	// Returns the squared distances and the segment parameters of the closest points.
+	PX_FORCE_INLINE aos::Vec4V distancePointSegmentSquaredSoA(const PxVec3& p0, const PxVec3& dir, const SoAVec3& points, aos::Vec4V& param)
+	{
+		using namespace aos;
+		const Vec4V zero = V4Zero();
+		const Vec4V one = V4One();
+
+		SoAVec3 p0V, dirV;
+		splatSoA(p0V, p0);
+		splatSoA(dirV, dir);
+
+		SoAVec3 diff;
+		subSoA(diff, points, p0V);
+		const Vec4V fT = dotSoA(diff, dirV);
+		const Vec4V sqrLen = V4Load(dir.magnitudeSquared());
+
+		const BoolV before = V4IsGrtrOrEq(zero, fT);
+		const BoolV after = BAnd(BNot(before), V4IsGrtrOrEq(fT, sqrLen));
+		const BoolV middle = BNot(BOr(before, after));
+
+		// PT: sqrLen can only be zero for lanes where 'middle' is false, but we still avoid the division by zero
+		const Vec4V t = V4Sel(before, zero, V4Sel(after, one, V4Div(fT, V4Sel(middle, sqrLen, one))));
+
+		SoAVec3 d;
+		d.x = V4Sel(before, diff.x, V4Sub(diff.x, V4Mul(t, dirV.x)));
+		d.y = V4Sel(before, diff.y, V4Sub(diff.y, V4Mul(t, dirV.y)));
+		d.z = V4Sel(before, diff.z, V4Sub(diff.z, V4Mul(t, dirV.z)));
+
+		param = t;
+		return dotSoA(d, d);
+	}
+
+} // namespace Gu
+
+}
+
+#endif
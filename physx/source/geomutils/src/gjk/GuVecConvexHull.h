@@ -96,6 +96,115 @@ namespace Gu
 	}
 
 
+	// PT: loads 4 hull vertices and transposes them. This is safe because of the way vertex memory is allocated in ConvexHullData:
+	// reading the 32 bits after any hull vertex is fine.
+	PX_FORCE_INLINE void loadHullVerticesSoA(const PxVec3& p0, const PxVec3& p1, const PxVec3& p2, const PxVec3& p3, aos::Vec4V& x, aos::Vec4V& y, aos::Vec4V& z)
+	{
+		using namespace aos;
+		Vec4V v0 = V4LoadU(&p0.x);
+		Vec4V v1 = V4LoadU(&p1.x);
+		Vec4V v2 = V4LoadU(&p2.x);
+		Vec4V v3 = V4LoadU(&p3.x);
+		PX_TRANSPOSE_44_34(v0, v1, v2, v3, x, y, z);
+	}
+
+	// PT: dot products of 4 vertices in SoA form with a splatted direction, in the same order as PxVec3::dot()
+	PX_FORCE_INLINE aos::Vec4V dotHullVerticesSoA(const PxVec3* PX_RESTRICT verts, PxU32 i0, PxU32 i1, PxU32 i2, PxU32 i3, const aos::Vec4V dirX, const aos::Vec4V dirY, const aos::Vec4V dirZ)
+	{
+		using namespace aos;
+		Vec4V x, y, z;
+		loadHullVerticesSoA(verts[i0], verts[i1], verts[i2], verts[i3], x, y, z);
+		return V4Add(V4Add(V4Mul(x, dirX), V4Mul(y, dirY)), V4Mul(z, dirZ));
+	}
+
+	// PT: SIMD version of the brute-force support mapping, testing 8 vertices per iteration with two independent sets of
+	// 4 lanes. Dot products are computed in the same order as PxVec3::dot() and ties are resolved in favor of the smallest
+	// index, so this returns the same vertex as the scalar loop.
+	PX_FORCE_INLINE PxU32 bruteForceSupportVertexIndex(const PxVec3* PX_RESTRICT verts, PxU32 numVerts, const aos::Vec3VArg dir)
+	{
+		using namespace aos;
+		PX_ASSERT(numVerts);
+		const PxU32 last = numVerts - 1;
+
+		const Vec4V dirX = V4Splat(V3GetX(dir));
+		const Vec4V dirY = V4Splat(V3GetY(dir));
+		const Vec4V dirZ = V4Splat(V3GetZ(dir));
+		const Vec4V eight = V4Load(8.0f);
+
+		// PT: indices are stored as floats, which is exact for the 255 vertices of a hull
+		Vec4V indices0 = V4LoadXYZW(0.0f, 1.0f, 2.0f, 3.0f);
+		Vec4V indices1 = V4LoadXYZW(4.0f, 5.0f, 6.0f, 7.0f);
+		Vec4V bestIndices0 = V4Zero();
+		Vec4V bestIndices1 = V4Zero();
+		Vec4V best0 = V4Load(-PX_MAX_F32);
+		Vec4V best1 = best0;
+
+		PxU32 i = 0;
+		for(; i+8<=numVerts; i+=8)
+		{
+			const Vec4V dots0 = dotHullVerticesSoA(verts, i, i+1, i+2, i+3, dirX, dirY, dirZ);
+			const Vec4V dots1 = dotHullVerticesSoA(verts, i+4, i+5, i+6, i+7, dirX, dirY, dirZ);
+			const BoolV better0 = V4IsGrtr(dots0, best0);
+			const BoolV better1 = V4IsGrtr(dots1, best1);
+			best0 = V4Sel(better0, dots0, best0);
+			best1 = V4Sel(better1, dots1, best1);
+			bestIndices0 = V4Sel(better0, indices0, bestIndices0);
+			bestIndices1 = V4Sel(better1, indices1, bestIndices1);
+			indices0 = V4Add(indices0, eight);
+			indices1 = V4Add(indices1, eight);
+		}
+		// PT: remaining vertices, replicating the last one in unused lanes
+		for(; i<numVerts; i+=4)
+		{
+			const Vec4V dots0 = dotHullVerticesSoA(verts, i, PxMin(i+1, last), PxMin(i+2, last), PxMin(i+3, last), dirX, dirY, dirZ);
+			const BoolV better0 = V4IsGrtr(dots0, best0);
+			best0 = V4Sel(better0, dots0, best0);
+			bestIndices0 = V4Sel(better0, indices0, bestIndices0);
+			indices0 = V4Add(indices0, V4Load(4.0f));
+		}
+
+		// PT: smallest index among the lanes holding the max dot product
+		const Vec4V maxDot = V4Splat(V4ExtractMax(V4Max(best0, best1)));
+		const Vec4V noIndex = V4Load(PX_MAX_F32);
+		const Vec4V candidates0 = V4Sel(V4IsEq(best0, maxDot), bestIndices0, noIndex);
+		const Vec4V candidates1 = V4Sel(V4IsEq(best1, maxDot), bestIndices1, noIndex);
+		PxF32 bestIndex;
+		FStore(V4ExtractMin(V4Min(candidates0, candidates1)), &bestIndex);
+		// PT: no lane matches if the dot products are not comparable (e.g. NaN direction). Fall back to vertex 0 like the
+		// scalar loop did, and never cast noIndex to an integer.
+		return bestIndex <= PxF32(last) ? PxU32(bestIndex) : 0;
+	}
+
+	// PT: SIMD version of the brute-force min/max projection of hull vertices on 'dir'
+	PX_FORCE_INLINE void bruteForceSupportMinMax(const PxVec3* PX_RESTRICT verts, PxU32 numVerts, const aos::Vec3VArg dir, aos::FloatV& min, aos::FloatV& max)
+	{
+		using namespace aos;
+		PX_ASSERT(numVerts);
+		const PxU32 last = numVerts - 1;
+
+		const Vec4V dirX = V4Splat(V3GetX(dir));
+		const Vec4V dirY = V4Splat(V3GetY(dir));
+		const Vec4V dirZ = V4Splat(V3GetZ(dir));
+
+		Vec4V maxV = V4Load(-PX_MAX_F32);
+		Vec4V minV = V4Load(PX_MAX_F32);
+		PxU32 i = 0;
+		for(; i+4<=numVerts; i+=4)
+		{
+			const Vec4V dots = dotHullVerticesSoA(verts, i, i+1, i+2, i+3, dirX, dirY, dirZ);
+			maxV = V4Max(maxV, dots);
+			minV = V4Min(minV, dots);
+		}
+		if(i<numVerts)
+		{
+			const Vec4V dots = dotHullVerticesSoA(verts, i, PxMin(i+1, last), PxMin(i+2, last), last, dirX, dirY, dirZ);
+			maxV = V4Max(maxV, dots);
+			minV = V4Min(minV, dots);
+		}
+		max = V4ExtractMax(maxV);
+		min = V4ExtractMin(minV);
+	}
+
 	PX_SUPPORT_FORCE_INLINE aos::Mat33V ConstructSkewMatrix(const aos::Vec3VArg scale, const aos::QuatVArg rotation) 
 	{
 		using namespace aos;
@@ -378,24 +487,7 @@ namespace Gu
 
 		PX_SUPPORT_INLINE PxU32 bruteForceSearch(const aos::Vec3VArg _dir)const 
 		{
-			using namespace aos;
-			//brute force
-			PxVec3 dir;
-			V3StoreU(_dir, dir);
-
-			PxReal max = verts[0].dot(dir);
-			PxU32 maxIndex = 0;
-
-			for (PxU32 i = 1; i < numVerts; ++i)
-			{
-				const PxReal dist = verts[i].dot(dir);
-				if (dist > max)
-				{
-					max = dist;
-					maxIndex = i;
-				}
-			}
-			return maxIndex;
+			return bruteForceSupportVertexIndex(verts, numVerts, _dir);
 		}
 
 		//points are in vertex space, _dir in vertex space
@@ -411,23 +503,7 @@ namespace Gu
 		//dir is in the vertex space
 		PX_SUPPORT_INLINE void bruteForceSearchMinMax(const aos::Vec3VArg _dir, aos::FloatV& min, aos::FloatV& max)const 
 		{
-			using namespace aos;
-
-			//brute force
-			PxVec3 dir;
-			V3StoreU(_dir, dir);
-			//get the support point from the orignal margin
-			PxReal _max = verts[0].dot(dir);
-			PxReal _min = _max;
-
-			for(PxU32 i = 1; i < numVerts; ++i)
-			{ 
-				const PxReal dist = verts[i].dot(dir);
-				_max = PxMax(dist, _max);
-				_min = PxMin(dist, _min);
-			}
-			min = FLoad(_min);
-			max = FLoad(_max);
+			bruteForceSupportMinMax(verts, numVerts, _dir, min, max);
 		}
 
 		//This function is used in the full contact manifold generation code, points are in vertex space.
@@ -27,6 +27,7 @@
 // Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
 
 #include "GuHeightField.h"
+#include "GuHeightFieldPyramid.h"
 #include "GuMeshFactory.h"
 #include "CmSerialize.h"
 #include "foundation/PxBitMap.h"
@@ -44,6 +45,7 @@ HeightField::HeightField(MeshFactory* factory)
 , mMinHeight	(0.0f)
 , mMaxHeight	(0.0f)
 , mModifyCount	(0)
+, mPyramid		(NULL)
 , mMeshFactory	(factory)
 {
 	mData.format				= PxHeightFieldFormat::eS16_TM;
@@ -63,10 +65,13 @@ HeightField::HeightField(MeshFactory* factory, HeightFieldData& data)
 , mMinHeight	(0.0f)
 , mMaxHeight	(0.0f)
 , mModifyCount	(0)
+, mPyramid		(NULL)
 , mMeshFactory	(factory)
 {
 	mData = data;
 	data.samples = NULL; // set to null so that we don't release the memory
+
+	buildPyramid();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -94,6 +99,10 @@ void HeightField::exportExtraData(PxSerializationContext& stream)
 void HeightField::importExtraData(PxDeserializationContext& context)
 {
 	mData.samples = context.readExtraData<PxHeightFieldSample, PX_SERIAL_ALIGN>(mData.rows * mData.columns);
+
+	// PT: the pyramid is not serialized, it is cheap enough to rebuild
+	mPyramid = NULL;
+	buildPyramid();
 }
 
 HeightField* HeightField::createObject(PxU8*& address, PxDeserializationContext& context)
@@ -180,6 +189,9 @@ bool HeightField::modifySamples(PxI32 startCol, PxI32 startRow, const PxHeightFi
 	mMinHeight = minHeight;
 	mMaxHeight = maxHeight;
 
+	if(mPyramid && PxU32(PxMax(startRow, 0))<hiRow && PxU32(PxMax(startCol, 0))<hiCol)
+		mPyramid->update(*this, PxU32(PxMax(startRow, 0)), PxU32(PxMax(startCol, 0)), hiRow-1, hiCol-1);
+
 	// update local space aabb
 	CenterExtents& bounds = mData.mAABB;
 	bounds.mCenter.y = (maxHeight + minHeight)*0.5f;
@@ -259,6 +271,8 @@ bool HeightField::load(PxInputStream& stream)
 			}
 	}
 
+	buildPyramid();
+
 	return true;
 }
 
@@ -396,6 +410,20 @@ void HeightField::releaseMemory()
 	{
 		PX_FREE(mData.samples);
 	}
+
+	// PT: the pyramid is always allocated at runtime, even for deserialized heightfields
+	PX_DELETE(mPyramid);
+}
+
+void HeightField::buildPyramid()
+{
+	PX_DELETE(mPyramid);
+	if(!(mData.flags & PxHeightFieldFlag::eMIN_MAX_PYRAMID) || !mData.samples)
+		return;
+
+	mPyramid = PX_NEW(HeightFieldPyramid);
+	if(!mPyramid->build(*this))
+		PX_DELETE(mPyramid);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -50,6 +50,7 @@ class PxHeightFieldDesc;
 namespace Gu
 {
 class MeshFactory;
+class HeightFieldPyramid;
 class HeightField : public PxHeightField, public PxUserAllocated
 {
 //= ATTENTION! =====================================================================================
@@ -230,6 +231,10 @@ public:
 						PX_FORCE_INLINE	PxReal						getMaxHeight()					const	{ return mMaxHeight; }
 
 						PX_FORCE_INLINE	const Gu::HeightFieldData&	getData()						const	{ return mData; }
+
+																	// PT: optional min/max pyramid, only available with PxHeightFieldFlag::eMIN_MAX_PYRAMID
+						PX_FORCE_INLINE	const HeightFieldPyramid*	getPyramid()					const	{ return mPyramid; }
+										void						buildPyramid();
 	
 	PX_CUDA_CALLABLE	PX_FORCE_INLINE	void						getTriangleVertices(PxU32 triangleIndex, PxU32 row, PxU32 column, PxVec3& v0, PxVec3& v1, PxVec3& v2) const;
 
@@ -256,6 +261,7 @@ public:
 										PxReal						mMinHeight;
 										PxReal						mMaxHeight;
 										PxU32						mModifyCount;
+										HeightFieldPyramid*			mPyramid;
 
 										void						releaseMemory();
 						virtual										~HeightField();
@@ -0,0 +1,186 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "GuHeightFieldPyramid.h"
+#include "GuHeightField.h"
+
+using namespace physx;
+using namespace Gu;
+
+HeightFieldPyramid::HeightFieldPyramid() : mNodes(NULL), mNbNodes(0), mNbLevels(0)
+{
+}
+
+HeightFieldPyramid::~HeightFieldPyramid()
+{
+	PX_FREE(mNodes);
+}
+
+static PX_FORCE_INLINE bool isHoleCell(const HeightField& hf, PxU32 vertexIndex)
+{
+	return hf.getMaterialIndex0(vertexIndex)==PxHeightFieldMaterial::eHOLE && hf.getMaterialIndex1(vertexIndex)==PxHeightFieldMaterial::eHOLE;
+}
+
+void HeightFieldPyramid::computeLeaf(const HeightField& hf, PxU32 row, PxU32 column)
+{
+	const PxU32 nbColumns = hf.getNbColumnsFast();
+	const PxU32 startRow = row<<HF_PYRAMID_LEAF_SHIFT;
+	const PxU32 startColumn = column<<HF_PYRAMID_LEAF_SHIFT;
+	const PxU32 endRow = PxMin(startRow + (1<<HF_PYRAMID_LEAF_SHIFT), hf.getNbRowsFast()-1);
+	const PxU32 endColumn = PxMin(startColumn + (1<<HF_PYRAMID_LEAF_SHIFT), nbColumns-1);
+
+	PxI16 minHeight = PX_MAX_I16;
+	PxI16 maxHeight = PX_MIN_I16;
+	for(PxU32 i=startRow;i<endRow;i++)
+	{
+		for(PxU32 j=startColumn;j<endColumn;j++)
+		{
+			// PT: cells whose two triangles are holes cannot be hit, so they don't contribute to the bounds
+			const PxU32 vertexIndex = i*nbColumns + j;
+			if(isHoleCell(hf, vertexIndex))
+				continue;
+
+			const PxI16 h0 = hf.getSample(vertexIndex).height;
+			const PxI16 h1 = hf.getSample(vertexIndex + 1).height;
+			const PxI16 h2 = hf.getSample(vertexIndex + nbColumns).height;
+			const PxI16 h3 = hf.getSample(vertexIndex + nbColumns + 1).height;
+			minHeight = PxMin(minHeight, PxMin(PxMin(h0, h1), PxMin(h2, h3)));
+			maxHeight = PxMax(maxHeight, PxMax(PxMax(h0, h1), PxMax(h2, h3)));
+		}
+	}
+
+	HeightFieldPyramidNode& node = mNodes[mOffsets[0] + row*mNbColumns[0] + column];
+	node.mMin = minHeight;
+	node.mMax = maxHeight;
+}
+
+void HeightFieldPyramid::computeParent(PxU32 level, PxU32 row, PxU32 column)
+{
+	PX_ASSERT(level);
+	const PxU32 childLevel = level - 1;
+	const HeightFieldPyramidNode* children = mNodes + mOffsets[childLevel];
+	const PxU32 nbChildRows = mNbRows[childLevel];
+	const PxU32 nbChildColumns = mNbColumns[childLevel];
+
+	PxI16 minHeight = PX_MAX_I16;
+	PxI16 maxHeight = PX_MIN_I16;
+	const PxU32 endRow = PxMin(row*2 + 2, nbChildRows);
+	const PxU32 endColumn = PxMin(column*2 + 2, nbChildColumns);
+	for(PxU32 i=row*2;i<endRow;i++)
+	{
+		for(PxU32 j=column*2;j<endColumn;j++)
+		{
+			// PT: empty children have mMin>mMax so they don't change the result
+			const HeightFieldPyramidNode& child = children[i*nbChildColumns + j];
+			minHeight = PxMin(minHeight, child.mMin);
+			maxHeight = PxMax(maxHeight, child.mMax);
+		}
+	}
+
+	HeightFieldPyramidNode& node = mNodes[mOffsets[level] + row*mNbColumns[level] + column];
+	node.mMin = minHeight;
+	node.mMax = maxHeight;
+}
+
+bool HeightFieldPyramid::build(const HeightField& hf)
+{
+	PX_FREE(mNodes);
+	mNbNodes = 0;
+	mNbLevels = 0;
+
+	const PxU32 nbCellRows = hf.getNbRowsFast() - 1;
+	const PxU32 nbCellColumns = hf.getNbColumnsFast() - 1;
+	if(!nbCellRows || !nbCellColumns)
+		return false;
+
+	PxU32 nbRows = (nbCellRows + (1<<HF_PYRAMID_LEAF_SHIFT) - 1)>>HF_PYRAMID_LEAF_SHIFT;
+	PxU32 nbColumns = (nbCellColumns + (1<<HF_PYRAMID_LEAF_SHIFT) - 1)>>HF_PYRAMID_LEAF_SHIFT;
+	while(1)
+	{
+		PX_ASSERT(mNbLevels<HF_PYRAMID_MAX_LEVELS);
+		mOffsets[mNbLevels] = mNbNodes;
+		mNbRows[mNbLevels] = nbRows;
+		mNbColumns[mNbLevels] = nbColumns;
+		mNbNodes += nbRows*nbColumns;
+		mNbLevels++;
+		if(nbRows==1 && nbColumns==1)
+			break;
+		nbRows = (nbRows+1)/2;
+		nbColumns = (nbColumns+1)/2;
+	}
+
+	mNodes = PX_ALLOCATE(HeightFieldPyramidNode, mNbNodes, "HeightFieldPyramidNode");
+	if(!mNodes)
+	{
+		mNbNodes = 0;
+		mNbLevels = 0;
+		return false;
+	}
+
+	for(PxU32 i=0;i<mNbRows[0];i++)
+		for(PxU32 j=0;j<mNbColumns[0];j++)
+			computeLeaf(hf, i, j);
+
+	for(PxU32 level=1;level<mNbLevels;level++)
+		for(PxU32 i=0;i<mNbRows[level];i++)
+			for(PxU32 j=0;j<mNbColumns[level];j++)
+				computeParent(level, i, j);
+
+	return true;
+}
+
+void HeightFieldPyramid::update(const HeightField& hf, PxU32 minRow, PxU32 minColumn, PxU32 maxRow, PxU32 maxColumn)
+{
+	if(!mNodes)
+		return;
+
+	// PT: cell (i,j) uses samples (i,j) to (i+1,j+1), so modified samples touch cells from (minRow-1, minColumn-1) to (maxRow, maxColumn)
+	const PxU32 lastCellRow = hf.getNbRowsFast() - 2;
+	const PxU32 lastCellColumn = hf.getNbColumnsFast() - 2;
+	PxU32 startRow = (minRow ? minRow - 1 : 0)>>HF_PYRAMID_LEAF_SHIFT;
+	PxU32 startColumn = (minColumn ? minColumn - 1 : 0)>>HF_PYRAMID_LEAF_SHIFT;
+	PxU32 endRow = PxMin(maxRow, lastCellRow)>>HF_PYRAMID_LEAF_SHIFT;
+	PxU32 endColumn = PxMin(maxColumn, lastCellColumn)>>HF_PYRAMID_LEAF_SHIFT;
+	if(startRow>endRow || startColumn>endColumn)
+		return;
+
+	for(PxU32 i=startRow;i<=endRow;i++)
+		for(PxU32 j=startColumn;j<=endColumn;j++)
+			computeLeaf(hf, i, j);
+
+	for(PxU32 level=1;level<mNbLevels;level++)
+	{
+		startRow >>= 1;
+		startColumn >>= 1;
+		endRow >>= 1;
+		endColumn >>= 1;
+		for(PxU32 i=startRow;i<=endRow;i++)
+			for(PxU32 j=startColumn;j<=endColumn;j++)
+				computeParent(level, i, j);
+	}
+}
@@ -0,0 +1,117 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef GU_HEIGHTFIELD_PYRAMID_H
+#define GU_HEIGHTFIELD_PYRAMID_H
+
+#include "foundation/PxUserAllocated.h"
+#include "foundation/PxVec3.h"
+#include "foundation/PxBasicTemplates.h"
+
+// PT: leaf nodes of the pyramid cover 4x4 cells. Smaller leaves would let queries skip more cells, at the cost of more
+// memory and a deeper traversal. The regular cell-by-cell traversal takes over within leaves.
+#define HF_PYRAMID_LEAF_SHIFT	2
+#define HF_PYRAMID_MAX_LEVELS	32
+
+namespace physx
+{
+namespace Gu
+{
+	class HeightField;
+
+	// PT: heights are stored unscaled, like in the samples. An empty node (mMin>mMax) only contains hole cells.
+	struct HeightFieldPyramidNode
+	{
+		PxI16	mMin;
+		PxI16	mMax;
+
+		PX_FORCE_INLINE	bool	isEmpty()	const	{ return mMin>mMax;	}
+	};
+
+	// PT: a min/max quadtree over the cells of a heightfield. Level 0 contains the leaves, each level halves the number
+	// of nodes in each direction, and the last level contains a single node covering the whole heightfield.
+	class HeightFieldPyramid : public PxUserAllocated
+	{
+		public:
+													HeightFieldPyramid();
+													~HeightFieldPyramid();
+
+						bool						build(const HeightField& hf);
+
+						// PT: updates the nodes covering cells that use the given samples (inclusive sample range)
+						void						update(const HeightField& hf, PxU32 minRow, PxU32 minColumn, PxU32 maxRow, PxU32 maxColumn);
+
+		PX_FORCE_INLINE	PxU32						getNbLevels()					const	{ return mNbLevels;						}
+		PX_FORCE_INLINE	PxU32						getNbRows(PxU32 level)			const	{ return mNbRows[level];				}
+		PX_FORCE_INLINE	PxU32						getNbColumns(PxU32 level)		const	{ return mNbColumns[level];				}
+		PX_FORCE_INLINE	PxU32						getBlockShift(PxU32 level)		const	{ return HF_PYRAMID_LEAF_SHIFT + level;	}
+		PX_FORCE_INLINE	const HeightFieldPyramidNode*	getLevel(PxU32 level)		const	{ return mNodes + mOffsets[level];		}
+		PX_FORCE_INLINE	PxU32						getMemoryUsage()				const	{ return mNbNodes*sizeof(HeightFieldPyramidNode);	}
+
+		private:
+						HeightFieldPyramidNode*		mNodes;
+						PxU32						mNbNodes;
+						PxU32						mNbLevels;
+						PxU32						mOffsets[HF_PYRAMID_MAX_LEVELS];
+						PxU32						mNbRows[HF_PYRAMID_MAX_LEVELS];
+						PxU32						mNbColumns[HF_PYRAMID_MAX_LEVELS];
+
+						void						computeLeaf(const HeightField& hf, PxU32 row, PxU32 column);
+						void						computeParent(PxU32 level, PxU32 row, PxU32 column);
+	};
+
+	// PT: clips a segment against a box. The segment is defined as origin + t*dir, and [t0, t1] is the incoming interval.
+	// Returns false if the clipped interval is empty.
+	PX_FORCE_INLINE bool clipSegmentToBox(const PxVec3& origin, const PxVec3& dir, const PxVec3& oneOverDir, const PxVec3& boxMin, const PxVec3& boxMax, PxReal& t0, PxReal& t1)
+	{
+		for(PxU32 axis=0;axis<3;axis++)
+		{
+			if(dir[axis]==0.0f)
+			{
+				if(origin[axis]<boxMin[axis] || origin[axis]>boxMax[axis])
+					return false;
+				continue;
+			}
+
+			PxReal tNear = (boxMin[axis] - origin[axis]) * oneOverDir[axis];
+			PxReal tFar = (boxMax[axis] - origin[axis]) * oneOverDir[axis];
+			if(tNear>tFar)
+				PxSwap(tNear, tFar);
+			t0 = PxMax(t0, tNear);
+			t1 = PxMin(t1, tFar);
+			if(t0>t1)
+				return false;
+		}
+		return true;
+	}
+
+} // namespace Gu
+
+}
+
+#endif
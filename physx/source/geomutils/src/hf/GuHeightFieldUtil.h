@@ -35,6 +35,7 @@
 #include "foundation/PxSIMDHelpers.h"
 
 #include "GuHeightField.h"
+#include "GuHeightFieldPyramid.h"
 #include "../intersection/GuIntersectionRayTriangle.h"
 #include "../intersection/GuIntersectionRayBox.h"
 
@@ -479,10 +480,23 @@ namespace Gu
 		template<class T, bool useUnderFaceCallback, bool overlap>
 		PX_INLINE void traceSegment(const PxVec3& aP0, const PxVec3& rayDir, const float rayLength , T* aCallback, const PxBounds3& hfLocalBounds, bool backfaceCull,
 			const PxVec3* overlapObjectExtent = NULL) const
+		{
+			// PT: the pyramid cannot be used with underFaceHit callbacks, since they need all the cells below the segment
+			const HeightFieldPyramid* pyramid = mHeightField->getPyramid();
+			if(pyramid && !useUnderFaceCallback)
+				tracePyramid<T, overlap>(*pyramid, aP0, rayDir, rayLength, aCallback, hfLocalBounds, backfaceCull, overlapObjectExtent);
+			else
+				traceCells<T, useUnderFaceCallback, overlap>(aP0, rayDir, rayLength, aCallback, hfLocalBounds, backfaceCull, overlapObjectExtent);
+		}
+
+		// PT: visits the cells along the segment one by one. Same parameters as traceSegment, returns false if the callback aborted the traversal.
+		template<class T, bool useUnderFaceCallback, bool overlap>
+		PX_INLINE bool traceCells(const PxVec3& aP0, const PxVec3& rayDir, const float rayLength , T* aCallback, const PxBounds3& hfLocalBounds, bool backfaceCull,
+			const PxVec3* overlapObjectExtent = NULL) const
 		{			
 			PxF32 tnear, tfar;
 			if(!Gu::intersectRayAABB2(hfLocalBounds.minimum, hfLocalBounds.maximum, aP0, rayDir, rayLength, tnear, tfar)) 
-				return;
+				return true;
 
 			const PxVec3 p0 = aP0 + rayDir * tnear;
 			const PxVec3 p1 = aP0 + rayDir * tfar;
@@ -617,13 +631,13 @@ namespace Gu
 					{
 						// initial overlap and setup
 						if(!overlapTraceSegment.init(ui,vi,nbVi,step_ui,step_vi,aCallback))
-							return;
+							return false;
 					}
 					else
 					{
 						// overlap step
 						if(!overlapTraceSegment.step(ui,vi))
-							return;
+							return false;
 					}
 				}
 				else
@@ -708,24 +722,24 @@ namespace Gu
 						{
 							const PxVec3 hitPoint((auhP0.x + duhvNormalized.x*triT0) * rowScale, auhP0.y + duhvNormalized.y * triT0, (auhP0.z + duhvNormalized.z*triT0) * columnScale);
 							if(!aCallback->faceHit(*this, hitPoint, cellIndex*2, triU0, triV0))
-								return;
+								return false;
 							if(hit1) // possible to hit both triangles in a cell with eMESH_MULTIPLE
 							{
 								PxVec3 hitPoint1((auhP0.x + duhvNormalized.x*triT1) * rowScale, auhP0.y  + duhvNormalized.y * triT1, (auhP0.z + duhvNormalized.z*triT1) * columnScale);
 								if(!aCallback->faceHit(*this, hitPoint1, cellIndex*2 + 1, triU1, triV1))
-									return;
+									return false;
 							}
 						}
 						else if(hit1 && triT1 <= triT0)
 						{
 							PxVec3 hitPoint((auhP0.x + duhvNormalized.x*triT1) * rowScale, auhP0.y  + duhvNormalized.y * triT1, (auhP0.z + duhvNormalized.z*triT1) * columnScale);
 							if(!aCallback->faceHit(*this, hitPoint, cellIndex*2 + 1, triU1, triV1))
-								return;
+								return false;
 							if(hit0) // possible to hit both triangles in a cell with eMESH_MULTIPLE
 							{
 								PxVec3 hitPoint1((auhP0.x + duhvNormalized.x*triT0) * rowScale, auhP0.y  + duhvNormalized.y * triT0, (auhP0.z + duhvNormalized.z*triT0) * columnScale);
 								if(!aCallback->faceHit(*this, hitPoint1, cellIndex*2, triU0, triV0))
-									return;
+									return false;
 							}
 						}
 					}
@@ -781,7 +795,7 @@ namespace Gu
 
 						if(!isHole0 && !aCallback->underFaceHit(*this, triNormals[dotPrevGtz], crossedEdge,
 								uprev * rowScale, vprev * columnScale, COMPUTE_H_FROM_T(tPrev), triIndex0))
-							return;
+							return false;
 
 						if(triIndex1 != triIndex0 && !isHole1) // if triIndex0 != triIndex1 that means we cross the triangle edge
 						{
@@ -795,7 +809,7 @@ namespace Gu
 								const PxF32 tw = (wnu*(wpu-u0)+wnv*(wpv-v0)) / denom;
 								if(!aCallback->underFaceHit(*this, triNormals[dotNextGtz], p10s-p01s,
 										(u0+tw*du) * rowScale, (v0+tw*dv) * columnScale, COMPUTE_H_FROM_T(tw), triIndex1))
-									return;
+									return false;
 							}
 						}
 					}
@@ -827,8 +841,169 @@ namespace Gu
 			// since min(tu,tv) is the END of the active interval we need to check if PREVIOUS min(tu,tv) was past interval end
 			// since we update tMinUV in the beginning of the loop, at this point it stores the min(last tu,last tv)
 			while (tMinUV < tEnd);
+			return true;
 			#undef COMPUTE_H_FROM_T
 		}
+
+		// PT: walks the min/max pyramid front-to-back to find the parts of the segment that can touch the heightfield, and only runs
+		// the cell-by-cell traversal on these parts. Nodes are tested as boxes in cell space, inflated by the swept object's extent
+		// for overlap traces. Parts separated by a few cells are merged to limit the number of traceCells calls.
+		template<class T, bool overlap>
+		PX_INLINE void tracePyramid(const HeightFieldPyramid& pyramid, const PxVec3& aP0, const PxVec3& rayDir, const float rayLength, T* aCallback,
+			const PxBounds3& hfLocalBounds, bool backfaceCull, const PxVec3* overlapObjectExtent) const
+		{
+			// PT: segment in cell space (row, height, column), parameterized by t in [0, 1]
+			const PxVec3 origin(aP0.x*mOneOverRowScale, aP0.y, aP0.z*mOneOverColumnScale);
+			const PxVec3 dir(rayDir.x*rayLength*mOneOverRowScale, rayDir.y*rayLength, rayDir.z*rayLength*mOneOverColumnScale);
+
+			// PT: short segments only visit a handful of cells, the pyramid would not save anything
+			const PxReal lengthInCells = PxSqrt(dir.x*dir.x + dir.z*dir.z);
+			if(lengthInCells < PxReal(4<<HF_PYRAMID_LEAF_SHIFT))
+			{
+				traceCells<T, false, overlap>(aP0, rayDir, rayLength, aCallback, hfLocalBounds, backfaceCull, overlapObjectExtent);
+				return;
+			}
+
+			const PxVec3 oneOverDir(dir.x!=0.0f ? 1.0f/dir.x : 0.0f, dir.y!=0.0f ? 1.0f/dir.y : 0.0f, dir.z!=0.0f ? 1.0f/dir.z : 0.0f);
+			const PxReal heightScale = mHfGeom->heightScale;
+
+			// PT: nodes are padded to account for the epsilons of the cell traversal and the float precision of large heights
+			const PxU32 topLevel = pyramid.getNbLevels() - 1;
+			const HeightFieldPyramidNode& root = pyramid.getLevel(topLevel)[0];
+			if(root.isEmpty())
+				return;
+			const PxReal maxAbsHeight = PxMax(PxAbs(PxReal(root.mMin)), PxAbs(PxReal(root.mMax))) * heightScale;
+			PxVec3 inflation(1e-3f, 1e-3f + maxAbsHeight*1e-5f, 1e-3f);
+			PxReal mergeCells = 2.0f;
+			if(overlap)
+			{
+				const PxVec3 cellExtent(overlapObjectExtent->x*PxAbs(mOneOverRowScale), overlapObjectExtent->y, overlapObjectExtent->z*PxAbs(mOneOverColumnScale));
+				inflation += cellExtent;
+				// PT: each traceCells call starts by visiting the whole rectangle covered by the swept object, so we merge more aggressively
+				mergeCells += 2.0f*PxMax(cellExtent.x, cellExtent.z);
+			}
+			const PxReal oneCell = 1.0f/lengthInCells;
+			const PxReal mergeGap = mergeCells*oneCell;
+
+			struct StackEntry
+			{
+				PxU32	mLevel;
+				PxU32	mRow;
+				PxU32	mColumn;
+				PxReal	mT0;
+				PxReal	mT1;
+			};
+			StackEntry stack[HF_PYRAMID_MAX_LEVELS*4];
+			PxU32 nbEntries = 0;
+
+			{
+				const PxReal maxCoord = PxReal(1<<pyramid.getBlockShift(topLevel));
+				const PxVec3 boxMin(-inflation.x, PxReal(root.mMin)*heightScale - inflation.y, -inflation.z);
+				const PxVec3 boxMax(maxCoord + inflation.x, PxReal(root.mMax)*heightScale + inflation.y, maxCoord + inflation.z);
+				PxReal t0 = 0.0f, t1 = 1.0f;
+				if(!clipSegmentToBox(origin, dir, oneOverDir, boxMin, boxMax, t0, t1))
+					return;
+				StackEntry& entry = stack[nbEntries++];
+				entry.mLevel	= topLevel;
+				entry.mRow		= 0;
+				entry.mColumn	= 0;
+				entry.mT0		= t0;
+				entry.mT1		= t1;
+			}
+
+			PxReal pendingStart = 0.0f, pendingEnd = -1.0f;	// PT: empty when pendingEnd<pendingStart
+			PxReal tracedEnd = 0.0f;
+
+			// PT: traces the pending part, slightly enlarged to make sure the cell traversal does not miss cells at its ends
+			#define FLUSH_PENDING																										\
+			{																															\
+				const PxReal margin = oneCell + (pendingEnd - pendingStart)*1e-3f;														\
+				const PxReal start = PxMax(pendingStart - margin, tracedEnd);															\
+				const PxReal end = PxMin(pendingEnd + margin, 1.0f);																	\
+				if(end>start)																											\
+				{																														\
+					tracedEnd = end;																									\
+					if(!traceCells<T, false, overlap>(aP0 + rayDir*(rayLength*start), rayDir, rayLength*(end-start), aCallback,			\
+						hfLocalBounds, backfaceCull, overlapObjectExtent))																\
+						return;																											\
+				}																														\
+			}
+
+			while(nbEntries)
+			{
+				const StackEntry entry = stack[--nbEntries];
+				if(!entry.mLevel)
+				{
+					// PT: leaf reached, queue its part of the segment
+					if(pendingEnd<pendingStart)
+					{
+						pendingStart = entry.mT0;
+						pendingEnd = entry.mT1;
+					}
+					else if(entry.mT0 <= pendingEnd + mergeGap)
+					{
+						pendingStart = PxMin(pendingStart, entry.mT0);
+						pendingEnd = PxMax(pendingEnd, entry.mT1);
+					}
+					else
+					{
+						FLUSH_PENDING
+						pendingStart = entry.mT0;
+						pendingEnd = entry.mT1;
+					}
+					continue;
+				}
+
+				const PxU32 childLevel = entry.mLevel - 1;
+				const HeightFieldPyramidNode* nodes = pyramid.getLevel(childLevel);
+				const PxU32 nbRows = pyramid.getNbRows(childLevel);
+				const PxU32 nbColumns = pyramid.getNbColumns(childLevel);
+				const PxU32 shift = pyramid.getBlockShift(childLevel);
+				const PxReal blockSize = PxReal(1<<shift);
+
+				StackEntry children[4];
+				PxU32 nbChildren = 0;
+				const PxU32 endRow = PxMin(entry.mRow*2 + 2, nbRows);
+				const PxU32 endColumn = PxMin(entry.mColumn*2 + 2, nbColumns);
+				for(PxU32 i=entry.mRow*2;i<endRow;i++)
+				{
+					for(PxU32 j=entry.mColumn*2;j<endColumn;j++)
+					{
+						const HeightFieldPyramidNode& node = nodes[i*nbColumns + j];
+						if(node.isEmpty())
+							continue;
+
+						const PxVec3 boxMin(PxReal(i<<shift) - inflation.x, PxReal(node.mMin)*heightScale - inflation.y, PxReal(j<<shift) - inflation.z);
+						const PxVec3 boxMax(boxMin.x + blockSize + 2.0f*inflation.x, PxReal(node.mMax)*heightScale + inflation.y, boxMin.z + blockSize + 2.0f*inflation.z);
+						PxReal t0 = entry.mT0, t1 = entry.mT1;
+						if(!clipSegmentToBox(origin, dir, oneOverDir, boxMin, boxMax, t0, t1))
+							continue;
+
+						// PT: insertion sort, farthest first, so that the closest child ends up on top of the stack
+						PxU32 k = nbChildren++;
+						while(k && children[k-1].mT0<t0)
+						{
+							children[k] = children[k-1];
+							k--;
+						}
+						children[k].mLevel	= childLevel;
+						children[k].mRow	= i;
+						children[k].mColumn	= j;
+						children[k].mT0		= t0;
+						children[k].mT1		= t1;
+					}
+				}
+
+				PX_ASSERT(nbEntries + nbChildren <= HF_PYRAMID_MAX_LEVELS*4);
+				for(PxU32 k=0;k<nbChildren;k++)
+					stack[nbEntries++] = children[k];
+			}
+
+			if(pendingEnd>=pendingStart)
+				FLUSH_PENDING
+
+			#undef FLUSH_PENDING
+		}
 	};
 
 } // namespace Gu
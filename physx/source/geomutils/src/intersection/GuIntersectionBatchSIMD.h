@@ -0,0 +1,258 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef GU_INTERSECTION_BATCH_SIMD_H
+#define GU_INTERSECTION_BATCH_SIMD_H
+
+#include "GuSoAVec3.h"
+#include "GuIntersectionRay.h"
+
+namespace physx
+{
+namespace Gu
+{
+	// PT: SoA versions of some intersection tests, processing 4 queries at once against the same shape. They follow the
+	// scalar code closely (same algorithms, same operation order) so that batched and single queries give the same results.
+
+	// PT: SoA version of intersectRaySphere(). Returns the hit mask, distances and impact points.
+	PX_FORCE_INLINE aos::BoolV intersectRaySphereSoA(const SoAVec3& origin, const SoAVec3& dir, const aos::Vec4V maxDist,
+													const SoAVec3& center, const aos::Vec4V radius, aos::Vec4V& dist, SoAVec3& hitPos)
+	{
+		using namespace aos;
+		const Vec4V zero = V4Zero();
+
+		// PT: move the ray origin closer to the sphere, see intersectRaySphere()
+		SoAVec3 x;
+		subSoA(x, origin, center);
+		const Vec4V l = V4Max(V4Sub(V4Sub(V4Sqrt(dotSoA(x, x)), radius), V4Load(GU_RAY_SURFACE_OFFSET)), zero);
+
+		SoAVec3 o;
+		addScaledSoA(o, origin, dir, l);
+		const Vec4V length = V4Sub(maxDist, l);
+
+		// PT: then same as intersectRaySphereBasic()
+		SoAVec3 offset;
+		subSoA(offset, center, o);
+		const Vec4V rayDist = dotSoA(dir, offset);
+		const Vec4V off2 = dotSoA(offset, offset);
+		const Vec4V rad2 = V4Mul(radius, radius);
+		const BoolV inside = V4IsGrtrOrEq(rad2, off2);
+
+		const Vec4V d = V4Sub(rad2, V4Sub(off2, V4Mul(rayDist, rayDist)));
+		const Vec4V basicDist = V4Sub(rayDist, V4Sqrt(V4Max(d, zero)));
+
+		const BoolV outsideHit = BAnd(BAnd(V4IsGrtr(rayDist, zero), V4IsGrtrOrEq(radius, V4Sub(rayDist, length))),
+										BAnd(V4IsGrtrOrEq(d, zero), V4IsGrtrOrEq(length, basicDist)));
+
+		SoAVec3 impact;
+		addScaledSoA(impact, o, dir, basicDist);
+		hitPos.x = V4Sel(inside, o.x, impact.x);
+		hitPos.y = V4Sel(inside, o.y, impact.y);
+		hitPos.z = V4Sel(inside, o.z, impact.z);
+		dist = V4Add(V4Sel(inside, zero, basicDist), l);
+		return BOr(inside, outsideHit);
+	}
+
+	// PT: SoA version of rayAABBIntersect2(), for a box centered on the origin. Returns the hit mask, distances, impact
+	// points and a mask per axis telling which plane has been hit. All plane masks are false when the origin is inside.
+	PX_FORCE_INLINE aos::BoolV rayAABBIntersect2SoA(const SoAVec3& extents, const SoAVec3& origin, const SoAVec3& dir,
+													SoAVec3& coord, aos::Vec4V& t, aos::BoolV planes[3])
+	{
+		using namespace aos;
+		const Vec4V zero = V4Zero();
+		const Vec4V minusOne = V4Neg(V4One());
+
+		const Vec4V* PX_RESTRICT e = &extents.x;
+		const Vec4V* PX_RESTRICT o = &origin.x;
+		const Vec4V* PX_RESTRICT d = &dir.x;
+		Vec4V* PX_RESTRICT c = &coord.x;
+
+		// Find candidate planes.
+		Vec4V maxT[3];
+		BoolV outside = BFFFF();
+		for(PxU32 i=0;i<3;i++)
+		{
+			const Vec4V minusE = V4Neg(e[i]);
+			const BoolV below = V4IsGrtr(minusE, o[i]);
+			const BoolV above = V4IsGrtr(o[i], e[i]);
+			const BoolV out = BOr(below, above);
+			c[i] = V4Sel(below, minusE, e[i]);
+
+			// Calculate T distances to candidate planes
+			const BoolV zeroDir = V4IsEq(d[i], zero);
+			const Vec4V safeDir = V4Sel(zeroDir, V4One(), d[i]);
+			maxT[i] = V4Sel(BAnd(out, BNot(zeroDir)), V4Div(V4Sub(c[i], o[i]), safeDir), minusOne);
+			outside = BOr(outside, out);
+		}
+
+		// Get largest of the maxT's for final choice of intersection
+		const BoolV isY = V4IsGrtr(maxT[1], maxT[0]);
+		const Vec4V bestXY = V4Sel(isY, maxT[1], maxT[0]);
+		planes[2] = V4IsGrtr(maxT[2], bestXY);
+		planes[1] = BAnd(isY, BNot(planes[2]));
+		planes[0] = BNot(BOr(planes[1], planes[2]));
+		const Vec4V best = V4Sel(planes[2], maxT[2], bestXY);
+
+		// Check final candidate actually inside box
+		BoolV miss = V4IsGrtr(zero, best);
+		for(PxU32 i=0;i<3;i++)
+		{
+			const Vec4V coordI = V4Add(o[i], V4Mul(best, d[i]));
+			const BoolV outOfBox = BOr(V4IsGrtr(V4Neg(e[i]), coordI), V4IsGrtr(coordI, e[i]));
+			miss = BOr(miss, BAnd(outOfBox, BNot(planes[i])));
+			c[i] = V4Sel(planes[i], c[i], coordI);
+		}
+
+		// Ray origin inside bounding box
+		const BoolV inside = BNot(outside);
+		for(PxU32 i=0;i<3;i++)
+		{
+			c[i] = V4Sel(inside, o[i], c[i]);
+			planes[i] = BAnd(planes[i], outside);
+		}
+		t = V4Sel(inside, zero, best);
+		return BOr(inside, BNot(miss));
+	}
+
+	// PT: computes the rotation matrices of 4 quaternions given in SoA form, same as the PxMat33(const PxQuat&) constructor
+	PX_FORCE_INLINE void quatToMat33SoA(SoAVec3 columns[3], const aos::Vec4V qx, const aos::Vec4V qy, const aos::Vec4V qz, const aos::Vec4V qw)
+	{
+		using namespace aos;
+		const Vec4V one = V4One();
+		const Vec4V x2 = V4Add(qx, qx);
+		const Vec4V y2 = V4Add(qy, qy);
+		const Vec4V z2 = V4Add(qz, qz);
+
+		const Vec4V xx = V4Mul(x2, qx);
+		const Vec4V yy = V4Mul(y2, qy);
+		const Vec4V zz = V4Mul(z2, qz);
+
+		const Vec4V xy = V4Mul(x2, qy);
+		const Vec4V xz = V4Mul(x2, qz);
+		const Vec4V xw = V4Mul(x2, qw);
+
+		const Vec4V yz = V4Mul(y2, qz);
+		const Vec4V yw = V4Mul(y2, qw);
+		const Vec4V zw = V4Mul(z2, qw);
+
+		columns[0].x = V4Sub(V4Sub(one, yy), zz);
+		columns[0].y = V4Add(xy, zw);
+		columns[0].z = V4Sub(xz, yw);
+
+		columns[1].x = V4Sub(xy, zw);
+		columns[1].y = V4Sub(V4Sub(one, xx), zz);
+		columns[1].z = V4Add(yz, xw);
+
+		columns[2].x = V4Add(xz, yw);
+		columns[2].y = V4Sub(yz, xw);
+		columns[2].z = V4Sub(V4Sub(one, xx), yy);
+	}
+
+	// PT: SoA version of intersectOBBOBB() with full_test=true. Box 0 is different for each lane (centers c0 and
+	// rotation columns r0, shared extents e0), box 1 is the same for all lanes. Returns the overlap mask.
+	PX_FORCE_INLINE aos::BoolV intersectOBBOBBSoA(	const PxVec3& e0, const SoAVec3& c0, const SoAVec3 r0[3],
+													const PxVec3& e1, const PxVec3& c1, const PxMat33& r1)
+	{
+		using namespace aos;
+
+		// Translation, in parent frame
+		SoAVec3 c1V;
+		splatSoA(c1V, c1);
+		SoAVec3 v;
+		subSoA(v, c1V, c0);
+
+		// Translation, in A's frame
+		const Vec4V T[3] = { dotSoA(v, r0[0]), dotSoA(v, r0[1]), dotSoA(v, r0[2]) };
+
+		// B's basis with respect to A's local frame
+		Vec4V R[3][3];
+		Vec4V FR[3][3];
+		const Vec4V eps = V4Load(1e-6f);
+		for(PxU32 k=0;k<3;k++)
+		{
+			SoAVec3 r1k;
+			splatSoA(r1k, r1[k]);
+			for(PxU32 i=0;i<3;i++)
+			{
+				R[i][k] = dotSoA(r0[i], r1k);
+				FR[i][k] = V4Add(eps, V4Abs(R[i][k]));	// Precompute fabs matrix
+			}
+		}
+
+		const Vec4V E0[3] = { V4Load(e0.x), V4Load(e0.y), V4Load(e0.z) };
+		const Vec4V E1[3] = { V4Load(e1.x), V4Load(e1.y), V4Load(e1.z) };
+
+		BoolV separated = BFFFF();
+
+		// A's basis vectors
+		for(PxU32 i=0;i<3;i++)
+		{
+			const Vec4V ra = E0[i];
+			const Vec4V rb = V4Add(V4Add(V4Mul(E1[0], FR[i][0]), V4Mul(E1[1], FR[i][1])), V4Mul(E1[2], FR[i][2]));
+			const Vec4V t = V4Abs(T[i]);
+			separated = BOr(separated, V4IsGrtr(t, V4Add(ra, rb)));
+		}
+
+		// B's basis vectors
+		for(PxU32 k=0;k<3;k++)
+		{
+			const Vec4V ra = V4Add(V4Add(V4Mul(E0[0], FR[0][k]), V4Mul(E0[1], FR[1][k])), V4Mul(E0[2], FR[2][k]));
+			const Vec4V rb = E1[k];
+			const Vec4V t = V4Abs(V4Add(V4Add(V4Mul(T[0], R[0][k]), V4Mul(T[1], R[1][k])), V4Mul(T[2], R[2][k])));
+			separated = BOr(separated, V4IsGrtr(t, V4Add(ra, rb)));
+		}
+
+		// 9 cross products, L = Ai x Bk
+		for(PxU32 i=0;i<3;i++)
+		{
+			const PxU32 i1 = (i+1)%3;
+			const PxU32 i2 = (i+2)%3;
+			// PT: the scalar code lists the two remaining axes in increasing order
+			const PxU32 ia = PxMin(i1, i2);
+			const PxU32 ib = PxMax(i1, i2);
+			for(PxU32 k=0;k<3;k++)
+			{
+				const PxU32 k1 = (k+1)%3;
+				const PxU32 k2 = (k+2)%3;
+				const PxU32 ka = PxMin(k1, k2);
+				const PxU32 kb = PxMax(k1, k2);
+
+				const Vec4V ra = V4Add(V4Mul(E0[ia], FR[ib][k]), V4Mul(E0[ib], FR[ia][k]));
+				const Vec4V rb = V4Add(V4Mul(E1[ka], FR[i][kb]), V4Mul(E1[kb], FR[i][ka]));
+				const Vec4V t = V4Abs(V4Sub(V4Mul(T[i2], R[i1][k]), V4Mul(T[i1], R[i2][k])));
+				separated = BOr(separated, V4IsGrtr(t, V4Add(ra, rb)));
+			}
+		}
+		return BNot(separated);
+	}
+
+} // namespace Gu
+
+}
+
+#endif
@@ -34,6 +34,9 @@
 #include "GuBounds.h"
 #include "GuBV4Build.h"
 #include "GuBV4.h"
+#include "GuBuildTask.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxSort.h"
 #include <stdio.h>
 
 using namespace physx;
@@ -325,24 +328,203 @@ static void local_BuildHierarchy_SAH(AABBTreeNode* PX_RESTRICT node, BuildStats&
 	}
 }
 
-bool BV4_AABBTree::buildFromMesh(SourceMeshBase& mesh, PxU32 limit, BV4_BuildStrategy strategy)
+// PT: multi-threaded version of the hierarchy build. The calling thread subdivides the top of the tree, always splitting the
+// largest pending node, until there are enough independent subtrees to keep the workers busy. Each subtree is then built by
+// its own task. A subtree with N primitives needs at most 2*N-2 nodes below its root, so each task gets its own disjoint range
+// of the linear node pool and tasks never share any writable data. Nodes are subdivided with the same code as in the single-
+// threaded build, so the hierarchy is the same. Only the position of the nodes in the pool differs, and the BV4 conversion
+// never uses it: it only follows the node pointers.
+
+// PT: below this number of primitives we use the single-threaded code
+#define BV4_PARALLEL_BUILD_MIN_NB_PRIMS			4096
+// PT: nodes smaller than this are not subdivided further by the calling thread
+#define BV4_PARALLEL_BUILD_MIN_SUBTREE_SIZE		1024
+// PT: number of subtrees per worker thread. Using more subtrees than threads improves load balancing.
+#define BV4_PARALLEL_BUILD_SUBTREES_PER_WORKER	4
+
+namespace
+{
+	class BV4SubtreeBuildTask : public BuildTask
+	{
+		public:
+		virtual	void	runInternal()
+		{
+			// PT: the subtree's root has been allocated by the calling thread, its descendants start at mNodeBase
+			BuildStats stats;
+			const BuildParams params(mBoxes, mCenters, mNodeBase, mLimit, mMesh);
+			if(mUseSAH)
+			{
+				SAH_Buffers buffers(mRoot->mNbPrimitives);
+				local_BuildHierarchy_SAH(mRoot, stats, params, buffers);
+			}
+			else
+				local_BuildHierarchy(mRoot, stats, params);
+			mNbNodes = stats.getCount();
+		}
+
+		virtual	const char*	getName()	const	{ return "BV4SubtreeBuildTask";	}
+
+		const PxBounds3*	mBoxes;
+		const PxVec3*		mCenters;
+		const SourceMesh*	mMesh;
+		AABBTreeNode*		mRoot;
+		AABBTreeNode*		mNodeBase;
+		PxU32				mLimit;
+		PxU32				mNbNodes;
+		bool				mUseSAH;
+	};
+
+	struct LargestBV4SubtreeFirst
+	{
+		PX_FORCE_INLINE bool operator()(const AABBTreeNode* a, const AABBTreeNode* b) const
+		{
+			return a->mNbPrimitives > b->mNbPrimitives;
+		}
+	};
+
+	struct ComputePrimitiveBoxes
+	{
+		ComputePrimitiveBoxes(SourceMeshBase& mesh, PxBounds3* boxes, PxVec3* centers) : mMesh(mesh), mBoxes(boxes), mCenters(centers)	{}
+
+		void	operator()(PxU32 start, PxU32 end)
+		{
+			const FloatV halfV = FLoad(0.5f);
+			for(PxU32 i=start;i<end;i++)
+			{
+				Vec4V minV, maxV;
+				mMesh.getPrimitiveBox(i, minV, maxV);
+
+				// PT: no V4StoreU_Safe here, it would write into the first element of the next batch owned by another thread
+				V3StoreU(Vec3V_From_Vec4V(minV), mBoxes[i].minimum);
+				V3StoreU(Vec3V_From_Vec4V(maxV), mBoxes[i].maximum);
+
+				const Vec4V centerV = V4Scale(V4Add(maxV, minV), halfV);
+				V3StoreU(Vec3V_From_Vec4V(centerV), mCenters[i]);
+			}
+		}
+
+		SourceMeshBase&	mMesh;
+		PxBounds3*		mBoxes;
+		PxVec3*			mCenters;
+		PX_NOCOPY(ComputePrimitiveBoxes)
+	};
+}
+
+static PxU32 buildHierarchyParallel(AABBTreeNode* pool, PxU32 nbBoxes, const PxBounds3* boxes, const PxVec3* centers, PxU32 limit, const SourceMesh* triMesh, bool useSAH, PxCpuDispatcher& dispatcher, PxU32 nbWorkers)
+{
+	const PxU32 maxNbSubtrees = nbWorkers * BV4_PARALLEL_BUILD_SUBTREES_PER_WORKER;
+
+	BuildStats stats;
+	stats.setCount(1);
+
+	// Phase 1: subdivide the top of the tree on the calling thread
+	PxArray<AABBTreeNode*> subtrees;
+	subtrees.reserve(maxNbSubtrees + 2);
+	subtrees.pushBack(pool);
+	{
+		const BuildParams params(boxes, centers, pool, limit, triMesh);
+		SAH_Buffers* sah = useSAH ? PX_NEW(SAH_Buffers)(nbBoxes, &dispatcher) : NULL;
+
+		while(subtrees.size() && subtrees.size()<maxNbSubtrees)
+		{
+			PxU32 largest = 0;
+			const PxU32 nbSubtrees = subtrees.size();
+			for(PxU32 i=1;i<nbSubtrees;i++)
+			{
+				if(subtrees[i]->mNbPrimitives > subtrees[largest]->mNbPrimitives)
+					largest = i;
+			}
+
+			AABBTreeNode* node = subtrees[largest];
+			if(node->mNbPrimitives<BV4_PARALLEL_BUILD_MIN_SUBTREE_SIZE)
+				break;
+
+			subtrees.replaceWithLast(largest);
+
+			const bool split = sah ? local_Subdivide_SAH(node, stats, params, *sah) : local_Subdivide(node, stats, params);
+			if(split)
+			{
+				AABBTreeNode* pos = const_cast<AABBTreeNode*>(node->getPos());
+				subtrees.pushBack(pos);
+				subtrees.pushBack(pos + 1);
+			}
+		}
+		PX_DELETE(sah);
+	}
+
+	// Phase 2: build the remaining subtrees in parallel, largest ones first
+	PxU32 nbNodes = stats.getCount();
+	const PxU32 nbSubtrees = subtrees.size();
+	if(nbSubtrees)
+	{
+		PxSort(subtrees.begin(), nbSubtrees, LargestBV4SubtreeFirst());
+
+		BV4SubtreeBuildTask* tasks = PX_ALLOCATE(BV4SubtreeBuildTask, nbSubtrees, "BV4SubtreeBuildTask");
+		{
+			BuildTaskSync sync;
+			PxU32 offset = nbNodes;
+			for(PxU32 i=0;i<nbSubtrees;i++)
+			{
+				BV4SubtreeBuildTask* task = PX_PLACEMENT_NEW(tasks + i, BV4SubtreeBuildTask);
+				task->mBoxes	= boxes;
+				task->mCenters	= centers;
+				task->mMesh		= triMesh;
+				task->mRoot		= subtrees[i];
+				task->mNodeBase	= pool + offset;
+				task->mLimit	= limit;
+				task->mNbNodes	= 0;
+				task->mUseSAH	= useSAH;
+				offset += subtrees[i]->mNbPrimitives*2 - 2;
+				PX_ASSERT(offset <= nbBoxes*2 - 1);
+				sync.submit(dispatcher, *task);
+			}
+			sync.wait();
+		}
+
+		for(PxU32 i=0;i<nbSubtrees;i++)
+		{
+			nbNodes += tasks[i].mNbNodes;
+			tasks[i].~BV4SubtreeBuildTask();
+		}
+		PX_FREE(tasks);
+	}
+	return nbNodes;
+}
+
+bool BV4_AABBTree::buildFromMesh(SourceMeshBase& mesh, PxU32 limit, BV4_BuildStrategy strategy, PxCpuDispatcher* dispatcher)
 {
 	const PxU32 nbBoxes = mesh.getNbPrimitives();
 	if(!nbBoxes)
 		return false;
+
+	if(strategy!=BV4_SPLATTER_POINTS && strategy!=BV4_SPLATTER_POINTS_SPLIT_GEOM_CENTER && strategy!=BV4_SAH)
+		return false;
+
+	PxU32 nbWorkers = 0;
+	if(dispatcher && nbBoxes>=BV4_PARALLEL_BUILD_MIN_NB_PRIMS)
+		nbWorkers = dispatcher->getWorkerCount();
+
 	PxBounds3* boxes = PX_ALLOCATE(PxBounds3, (nbBoxes + 1), "BV4");	// PT: +1 to safely V4Load/V4Store the last element
 	PxVec3* centers = PX_ALLOCATE(PxVec3, (nbBoxes + 1), "BV4");		// PT: +1 to safely V4Load/V4Store the last element
-	const FloatV halfV = FLoad(0.5f);
-	for (PxU32 i = 0; i<nbBoxes; i++)
+	if(nbWorkers>1)
+	{
+		ComputePrimitiveBoxes computeBoxes(mesh, boxes, centers);
+		runParallelRanges(dispatcher, nbBoxes, BV4_PARALLEL_BUILD_MIN_SUBTREE_SIZE, computeBoxes);
+	}
+	else
 	{
-		Vec4V minV, maxV;
-		mesh.getPrimitiveBox(i, minV, maxV);
+		const FloatV halfV = FLoad(0.5f);
+		for (PxU32 i = 0; i<nbBoxes; i++)
+		{
+			Vec4V minV, maxV;
+			mesh.getPrimitiveBox(i, minV, maxV);
 
-		V4StoreU_Safe(minV, &boxes[i].minimum.x);	// PT: safe because 'maximum' follows 'minimum'
-		V4StoreU_Safe(maxV, &boxes[i].maximum.x);	// PT: safe because we allocated one more box
+			V4StoreU_Safe(minV, &boxes[i].minimum.x);	// PT: safe because 'maximum' follows 'minimum'
+			V4StoreU_Safe(maxV, &boxes[i].maximum.x);	// PT: safe because we allocated one more box
 
-		const Vec4V centerV = V4Scale(V4Add(maxV, minV), halfV);
-		V4StoreU_Safe(centerV, &centers[i].x);	// PT: safe because we allocated one more PxVec3
+			const Vec4V centerV = V4Scale(V4Add(maxV, minV), halfV);
+			V4StoreU_Safe(centerV, &centers[i].x);	// PT: safe because we allocated one more PxVec3
+		}
 	}
 
 	{
@@ -368,28 +550,32 @@ bool BV4_AABBTree::buildFromMesh(SourceMeshBase& mesh, PxU32 limit, BV4_BuildStr
 		mPool->mNodePrimitives = mIndices;
 		mPool->mNbPrimitives = nbBoxes;
 
-		// Build the hierarchy
-		if(strategy==BV4_SPLATTER_POINTS||strategy==BV4_SPLATTER_POINTS_SPLIT_GEOM_CENTER)
+		// PT: not sure what the equivalent would be for tet-meshes here
+		SourceMesh* triMesh = NULL;
+		if(strategy==BV4_SPLATTER_POINTS_SPLIT_GEOM_CENTER)
 		{
-			// PT: not sure what the equivalent would be for tet-meshes here
-			SourceMesh* triMesh = NULL;
-			if(strategy==BV4_SPLATTER_POINTS_SPLIT_GEOM_CENTER)
-			{
-				if(mesh.getMeshType()==SourceMeshBase::TRI_MESH)
-					triMesh = static_cast<SourceMesh*>(&mesh);
-			}
-			local_BuildHierarchy(mPool, Stats, BuildParams(boxes, centers, mPool, limit, triMesh));
+			if(mesh.getMeshType()==SourceMeshBase::TRI_MESH)
+				triMesh = static_cast<SourceMesh*>(&mesh);
 		}
-		else if(strategy==BV4_SAH)
+
+		// Build the hierarchy
+		if(nbWorkers>1)
 		{
-			SAH_Buffers sah(nbBoxes);
-			local_BuildHierarchy_SAH(mPool, Stats, BuildParams(boxes, centers, mPool, limit, NULL), sah);
+			mTotalNbNodes = buildHierarchyParallel(mPool, nbBoxes, boxes, centers, limit, triMesh, strategy==BV4_SAH, *dispatcher, nbWorkers);
 		}
 		else
-			return false;
+		{
+			if(strategy==BV4_SAH)
+			{
+				SAH_Buffers sah(nbBoxes);
+				local_BuildHierarchy_SAH(mPool, Stats, BuildParams(boxes, centers, mPool, limit, NULL), sah);
+			}
+			else
+				local_BuildHierarchy(mPool, Stats, BuildParams(boxes, centers, mPool, limit, triMesh));
 
-		// Get back total number of nodes
-		mTotalNbNodes = Stats.getCount();
+			// Get back total number of nodes
+			mTotalNbNodes = Stats.getCount();
+		}
 	}
 
 	PX_FREE(centers);
@@ -1779,7 +1965,7 @@ static bool gReorderCallback(const AABBTreeNode* current, PxU32 /*depth*/, void*
 	return true;
 }
 
-bool physx::Gu::BuildBV4Ex(BV4Tree& tree, SourceMeshBase& mesh, float epsilon, PxU32 nbPrimitivePerLeaf, bool quantized, BV4_BuildStrategy strategy)
+bool physx::Gu::BuildBV4Ex(BV4Tree& tree, SourceMeshBase& mesh, float epsilon, PxU32 nbPrimitivePerLeaf, bool quantized, BV4_BuildStrategy strategy, PxCpuDispatcher* dispatcher)
 {
 	//either number of triangle or number of tetrahedron
 	const PxU32 nbPrimitives = mesh.getNbPrimitives();
@@ -1787,7 +1973,7 @@ bool physx::Gu::BuildBV4Ex(BV4Tree& tree, SourceMeshBase& mesh, float epsilon, P
 	BV4_AABBTree Source;
 	{
 		GU_PROFILE_ZONE("..BuildBV4Ex_buildFromMesh")
-		if(!Source.buildFromMesh(mesh, nbPrimitivePerLeaf, strategy))
+		if(!Source.buildFromMesh(mesh, nbPrimitivePerLeaf, strategy, dispatcher))
 			return false;
 	}
 
@@ -0,0 +1,288 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "GuBV4.h"
+using namespace physx;
+using namespace Gu;
+
+#include "foundation/PxVecMath.h"
+#include "foundation/PxBitUtils.h"
+using namespace physx::aos;
+
+#include "GuBV4_Common.h"
+#include "GuDistancePointTriangle.h"
+
+#if PX_VC
+#pragma warning ( disable : 4324 )
+#endif
+
+#ifdef GU_BV4_USE_SLABS
+	#include "GuBV4_Slabs.h"
+#endif
+
+// Multi-point distance query
+// PT: this is the batched version of BV4_PointDistance. A whole cluster of nearby points traverses the tree at once.
+// Each stack entry carries the mask of points that still need the node, i.e. the points whose current closest
+// distance is larger than their distance to the node's box. The points are stored in SoA form so that these masks
+// are computed for 4 points at a time.
+
+#define BV4_MAX_NB_CLUSTER_POINTS	32
+
+namespace
+{
+struct PointClusterParams
+{
+	const IndTri32*	PX_RESTRICT	mTris32;
+	const IndTri16*	PX_RESTRICT	mTris16;
+	const PxVec3*	PX_RESTRICT	mVerts;
+
+	BV4_ALIGN16(PxVec3p	mCenterOrMinCoeff_PaddedAligned);
+	BV4_ALIGN16(PxVec3p	mExtentsOrMaxCoeff_PaddedAligned);
+
+	BV4_ALIGN16(float	mX[BV4_MAX_NB_CLUSTER_POINTS]);
+	BV4_ALIGN16(float	mY[BV4_MAX_NB_CLUSTER_POINTS]);
+	BV4_ALIGN16(float	mZ[BV4_MAX_NB_CLUSTER_POINTS]);
+	BV4_ALIGN16(float	mSqDists[BV4_MAX_NB_CLUSTER_POINTS]);
+	BV4_ALIGN16(PxVec3p	mCenter);
+
+	PxU32*	PX_RESTRICT	mIndices;
+	PxVec3*	PX_RESTRICT	mClosestPts;
+};
+
+// PT: returns the subset of 'pointMask' made of points whose current closest distance is not larger than their distance to the box
+static PX_FORCE_INLINE PxU32 getPointMask(const PointClusterParams* PX_RESTRICT params, const Vec4V boxMin, const Vec4V boxMax, PxU32 pointMask)
+{
+	const Vec4V minX = V4SplatElement<0>(boxMin);
+	const Vec4V minY = V4SplatElement<1>(boxMin);
+	const Vec4V minZ = V4SplatElement<2>(boxMin);
+	const Vec4V maxX = V4SplatElement<0>(boxMax);
+	const Vec4V maxY = V4SplatElement<1>(boxMax);
+	const Vec4V maxZ = V4SplatElement<2>(boxMax);
+
+	PxU32 mask = 0;
+	PxU32 groups = pointMask;
+	while(groups)
+	{
+		const PxU32 offset = PxLowestSetBit(groups) & ~3;
+		groups &= ~(15u<<offset);
+
+		const Vec4V px = V4LoadA(params->mX + offset);
+		const Vec4V py = V4LoadA(params->mY + offset);
+		const Vec4V pz = V4LoadA(params->mZ + offset);
+		const Vec4V dx = V4Sub(px, V4Clamp(px, minX, maxX));
+		const Vec4V dy = V4Sub(py, V4Clamp(py, minY, maxY));
+		const Vec4V dz = V4Sub(pz, V4Clamp(pz, minZ, maxZ));
+		const Vec4V d2 = V4MulAdd(dx, dx, V4MulAdd(dy, dy, V4Mul(dz, dz)));
+		mask |= BGetBitMask(V4IsGrtrOrEq(V4LoadA(params->mSqDists + offset), d2))<<offset;
+	}
+	return mask & pointMask;
+}
+
+static void testLeaf(PointClusterParams* PX_RESTRICT params, PxU32 primIndex, PxU32 pointMask)
+{
+	PxU32 nbToGo = getNbPrimitives(primIndex);
+	do
+	{
+		PxU32 VRef0, VRef1, VRef2;
+		getVertexReferences(VRef0, VRef1, VRef2, primIndex, params->mTris32, params->mTris16);
+
+		const PxVec3& p0 = params->mVerts[VRef0];
+		const PxVec3& p1 = params->mVerts[VRef1];
+		const PxVec3& p2 = params->mVerts[VRef2];
+
+		const PxVec3 edge10 = p1 - p0;
+		const PxVec3 edge20 = p2 - p0;
+
+		PxU32 mask = pointMask;
+		while(mask)
+		{
+			const PxU32 j = PxLowestSetBit(mask);
+			mask &= mask - 1;
+
+			const PxVec3 point(params->mX[j], params->mY[j], params->mZ[j]);
+			const PxVec3 cp = closestPtPointTriangle2(point, p0, p1, p2, edge10, edge20);
+			const float sqrDist = (cp - point).magnitudeSquared();
+			if(sqrDist <= params->mSqDists[j])
+			{
+				params->mSqDists[j] = sqrDist;
+				params->mIndices[j] = primIndex;
+				params->mClosestPts[j] = cp;
+			}
+		}
+
+		primIndex++;
+	}while(nbToGo--);
+}
+
+// PT: squared distance from the cluster's center to the box, used to sort the nodes
+static PX_FORCE_INLINE float getCenterSqDist(const PointClusterParams* PX_RESTRICT params, const Vec4V boxMin, const Vec4V boxMax)
+{
+	const Vec4V center = V4LoadA(&params->mCenter.x);
+	const Vec4V d = V4Sub(center, V4Clamp(center, boxMin, boxMax));
+	float sqDist;
+	FStore(V3Dot(Vec3V_From_Vec4V(d), Vec3V_From_Vec4V(d)), &sqDist);
+	return sqDist;
+}
+
+template<class NodeT>
+static PX_FORCE_INLINE void getNodeBox(Vec4V& minV, Vec4V& maxV, const NodeT* PX_RESTRICT node, PxU32 i, const PointClusterParams* PX_RESTRICT params);
+
+template<>
+PX_FORCE_INLINE void getNodeBox<BVDataSwizzledQ>(Vec4V& boxMin, Vec4V& boxMax, const BVDataSwizzledQ* PX_RESTRICT node, PxU32 i, const PointClusterParams* PX_RESTRICT params)
+{
+	OPC_SLABS_GET_MIN_MAX(i)
+	boxMin = minV;
+	boxMax = maxV;
+}
+
+template<>
+PX_FORCE_INLINE void getNodeBox<BVDataSwizzledNQ>(Vec4V& boxMin, Vec4V& boxMax, const BVDataSwizzledNQ* PX_RESTRICT node, PxU32 i, const PointClusterParams* PX_RESTRICT)
+{
+	boxMin = V4LoadXYZW(node->mMinX[i], node->mMinY[i], node->mMinZ[i], 0.0f);
+	boxMax = V4LoadXYZW(node->mMaxX[i], node->mMaxY[i], node->mMaxZ[i], 0.0f);
+}
+
+template<class NodeT, class PackedNodeT>
+static void processCluster(const PackedNodeT* PX_RESTRICT root, PxU32 initData, PointClusterParams* PX_RESTRICT params, PxU32 pointMask)
+{
+	PxU32 nb=1;
+	PxU32 stack[GU_BV4_STACK_SIZE];
+	PxU32 stackMasks[GU_BV4_STACK_SIZE];
+	stack[0] = initData;
+	stackMasks[0] = pointMask;
+
+	do
+	{
+		nb--;
+		const PxU32 childData = stack[nb];
+		const PxU32 parentMask = stackMasks[nb];
+
+		const NodeT* PX_RESTRICT tn = reinterpret_cast<const NodeT*>(root + getChildOffset(childData));
+		const PxU32 nbChildren = getChildType(childData) + 2;
+
+		PxU32 nbMore = 0;
+		PxU32 next[4];
+		PxU32 nextMasks[4];
+		float nextDists[4];
+		for(PxU32 i=0;i<nbChildren;i++)
+		{
+			Vec4V boxMin, boxMax;
+			getNodeBox<NodeT>(boxMin, boxMax, tn, i, params);
+
+			// PT: the parent's mask may be out of date since the closest distances keep shrinking
+			const PxU32 mask = getPointMask(params, boxMin, boxMax, parentMask);
+			if(!mask)
+				continue;
+
+			if(tn->isLeaf(i))
+			{
+				testLeaf(params, tn->getPrimitive(i), mask);
+			}
+			else
+			{
+				// PT: nodes closest to the cluster are visited first, to shrink the closest distances as fast as possible.
+				// The stack is LIFO so they are pushed last.
+				const float dist = getCenterSqDist(params, boxMin, boxMax);
+				PxU32 j = nbMore++;
+				while(j && nextDists[j-1] < dist)
+				{
+					next[j] = next[j-1];
+					nextMasks[j] = nextMasks[j-1];
+					nextDists[j] = nextDists[j-1];
+					j--;
+				}
+				next[j] = tn->getChildData(i);
+				nextMasks[j] = mask;
+				nextDists[j] = dist;
+			}
+		}
+
+		for(PxU32 i=0;i<nbMore;i++)
+		{
+			PX_ASSERT(nb<GU_BV4_STACK_SIZE);
+			stack[nb] = next[i];
+			stackMasks[nb] = nextMasks[i];
+			nb++;
+		}
+	}while(nb);
+}
+}
+
+// PT: computes the closest triangles of 'nbPoints' points (at most 32) in vertex space. Points without any triangle
+// within maxDist get index 0xffffffff.
+void BV4_PointDistances(PxU32 nbPoints, const PxVec3p* points, const BV4Tree& tree, float maxDist, PxU32* indices, float* sqDists, PxVec3* closestPts)
+{
+	PX_ASSERT(nbPoints && nbPoints<=BV4_MAX_NB_CLUSTER_POINTS);
+	const SourceMesh* PX_RESTRICT mesh = static_cast<SourceMesh*>(tree.mMeshInterface);
+
+	const float limit = sqrtf(sqrtf(PX_MAX_F32));
+	if(maxDist>limit)
+		maxDist = limit;
+	const float maxSqDist = maxDist*maxDist;
+
+	PointClusterParams Params;
+	setupMeshPointersAndQuantizedCoeffs(&Params, mesh, &tree);
+	Params.mIndices		= indices;
+	Params.mClosestPts	= closestPts;
+
+	// PT: unused lanes replicate the last point so that SIMD tests remain valid. They are masked out anyway.
+	for(PxU32 j=0;j<BV4_MAX_NB_CLUSTER_POINTS;j++)
+	{
+		const PxVec3p& p = points[PxMin(j, nbPoints-1)];
+		Params.mX[j] = p.x;
+		Params.mY[j] = p.y;
+		Params.mZ[j] = p.z;
+		Params.mSqDists[j] = maxSqDist;
+	}
+	PxVec3 center(0.0f);
+	for(PxU32 j=0;j<nbPoints;j++)
+	{
+		indices[j] = 0xffffffff;
+		center += points[j];
+	}
+	Params.mCenter = center/float(nbPoints);
+
+	const PxU32 pointMask = nbPoints==BV4_MAX_NB_CLUSTER_POINTS ? 0xffffffff : (1u<<nbPoints)-1;
+
+	if(tree.mNodes)
+	{
+		if(tree.mQuantized)
+			processCluster<BVDataSwizzledQ>(reinterpret_cast<const BVDataPackedQ*>(tree.mNodes), tree.mInitData, &Params, pointMask);
+		else
+			processCluster<BVDataSwizzledNQ>(reinterpret_cast<const BVDataPackedNQ*>(tree.mNodes), tree.mInitData, &Params, pointMask);
+	}
+	else
+	{
+		const PxU32 nbTris = mesh->getNbTriangles();
+		PX_ASSERT(nbTris<16);
+		testLeaf(&Params, nbTris, pointMask);
+	}
+
+	for(PxU32 j=0;j<nbPoints;j++)
+		sqDists[j] = Params.mSqDists[j];
+}
@@ -39,6 +39,7 @@
 #include "CmScaling.h"
 #include "GuSweepTests.h"
 #include "GuMidphaseInterface.h"
+#include "GuSDF.h"
 #include "foundation/PxFPU.h"
 
 using namespace physx;
@@ -196,6 +197,85 @@ bool physx::PxMeshQuery::findOverlapTriangleMesh(	PxReportCallback<PxGeomIndexPa
 
 ///////////////////////////////////////////////////////////////////////////////
 
+PxU32 physx::PxMeshQuery::pointDistances(	const PxTriangleMeshGeometry& meshGeom, const PxTransform& meshPose,
+											PxU32 nbPoints, const PxVec3* points, PxReal maxDist, PxMeshClosestPoint* results,
+											PxCpuDispatcher* dispatcher, PxGeometryQueryFlags queryFlags)
+{
+	PX_SIMD_GUARD_CNDT(queryFlags & PxGeometryQueryFlag::eSIMD_GUARD)
+	PX_CHECK_AND_RETURN_VAL(meshPose.isValid(), "PxMeshQuery::pointDistances(): pose is not valid.", 0);
+	PX_CHECK_AND_RETURN_VAL(maxDist >= 0.0f, "PxMeshQuery::pointDistances(): maxDist is negative.", 0);
+	if(!nbPoints)
+		return 0;
+
+	return Midphase::pointMeshDistances(static_cast<const TriangleMesh*>(meshGeom.triangleMesh), meshGeom, meshPose, nbPoints, points, maxDist, results, dispatcher);
+}
+
+bool physx::PxMeshQuery::sdfDistances(	const PxTriangleMeshGeometry& meshGeom, const PxTransform& meshPose,
+										PxU32 nbPoints, const PxVec3* points, PxReal* distances, PxVec3* normals, PxGeometryQueryFlags queryFlags)
+{
+	PX_SIMD_GUARD_CNDT(queryFlags & PxGeometryQueryFlag::eSIMD_GUARD)
+	PX_CHECK_AND_RETURN_VAL(meshPose.isValid(), "PxMeshQuery::sdfDistances(): pose is not valid.", false);
+
+	const TriangleMesh* mesh = static_cast<const TriangleMesh*>(meshGeom.triangleMesh);
+	const SDF& sdf = mesh->getSdfDataFast();
+	if(!sdf.mSdf)
+		return false;
+
+	// PT: the SDF lives in vertex space. For scaled meshes the distance is rescaled along the gradient, using the
+	// inverse-transpose of the scale matrix to transform the gradient.
+	const bool idtScale = meshGeom.scale.isIdentity();
+	const PxMat34 world2vertexSkew = meshGeom.scale.getInverse() * meshPose.getInverse();
+	const PxMat33 normalTransform = meshGeom.scale.getInverse().toMat33().getTranspose();
+
+	const PxU32 batchSize = 256;
+	PxVec3 localPoints[batchSize];
+	PxVec3 gradients[batchSize];
+	const bool needsGradients = normals || !idtScale;
+
+	for(PxU32 offset=0; offset<nbPoints; offset+=batchSize)
+	{
+		const PxU32 nb = PxMin(batchSize, nbPoints - offset);
+		if(idtScale)
+		{
+			for(PxU32 i=0;i<nb;i++)
+				localPoints[i] = meshPose.transformInv(points[offset+i]);
+		}
+		else
+		{
+			for(PxU32 i=0;i<nb;i++)
+				localPoints[i] = world2vertexSkew.transform(points[offset+i]);
+		}
+
+		Gu::sampleSDFs(sdf, nb, localPoints, distances + offset, needsGradients ? gradients : NULL);
+
+		if(!needsGradients)
+			continue;
+
+		for(PxU32 i=0;i<nb;i++)
+		{
+			PxVec3 n = gradients[i];
+			const PxReal m = n.normalize();
+			if(m==0.0f)
+			{
+				if(normals)
+					normals[offset+i] = PxVec3(0.0f);
+				continue;
+			}
+
+			if(!idtScale)
+			{
+				n = normalTransform.transform(n);
+				const PxReal invScale = n.normalize();
+				distances[offset+i] /= invScale;
+			}
+
+			if(normals)
+				normals[offset+i] = meshPose.q.rotate(n);
+		}
+	}
+	return true;
+}
+
 PxU32 physx::PxMeshQuery::findOverlapHeightField(	const PxGeometry& geom, const PxTransform& geomPose,
 													const PxHeightFieldGeometry& hfGeom, const PxTransform& hfPose,
 													PxU32* results, PxU32 maxResults, PxU32 startIndex, bool& overflow, PxGeometryQueryFlags queryFlags)
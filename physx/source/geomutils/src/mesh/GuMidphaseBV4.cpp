@@ -1055,6 +1055,166 @@ void Gu::pointMeshDistance_BV4(const TriangleMesh* mesh, const PxTriangleMeshGeo
 
 
 
+#include "GuBuildTask.h"
+#include "GuDistancePointTriangle.h"
+#include "CmRadixSort.h"
+
+void BV4_PointDistances(PxU32 nbPoints, const PxVec3p* points, const BV4Tree& tree, float maxDist, PxU32* indices, float* sqDists, PxVec3* closestPts);
+
+#define GU_BV4_POINT_CLUSTER_SIZE	32
+
+// PT: spreads the 10 lower bits of x so that there are two zero bits between each of them
+static PX_FORCE_INLINE PxU32 expandMortonBits(PxU32 x)
+{
+	x = (x | (x << 16)) & 0x030000FF;
+	x = (x | (x <<  8)) & 0x0300F00F;
+	x = (x | (x <<  4)) & 0x030C30C3;
+	x = (x | (x <<  2)) & 0x09249249;
+	return x;
+}
+
+namespace
+{
+	struct PointClustersFunc
+	{
+		const BV4Tree*	mTree;
+		const PxVec3p*	mPoints;
+		PxU32*			mIndices;
+		float*			mSqDists;
+		PxVec3*			mClosestPts;
+		PxU32			mNbPoints;
+		float			mMaxDist;
+
+		void operator()(PxU32 start, PxU32 end)
+		{
+			for(PxU32 i=start;i<end;i++)
+			{
+				const PxU32 offset = i*GU_BV4_POINT_CLUSTER_SIZE;
+				const PxU32 nb = PxMin<PxU32>(mNbPoints - offset, GU_BV4_POINT_CLUSTER_SIZE);
+				BV4_PointDistances(nb, mPoints + offset, *mTree, mMaxDist, mIndices + offset, mSqDists + offset, mClosestPts + offset);
+			}
+		}
+	};
+}
+
+PxU32 Gu::pointMeshDistances_BV4(const TriangleMesh* mesh, const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose, PxU32 nbPoints, const PxVec3* points, float maxDist
+	, PxMeshClosestPoint* results, PxCpuDispatcher* dispatcher)
+{
+	PX_ASSERT(mesh->getConcreteType()==PxConcreteType::eTRIANGLE_MESH_BVH34);
+	const BV4TriangleMesh* meshData = static_cast<const BV4TriangleMesh*>(mesh);
+	const BV4Tree& tree = meshData->getBV4Tree();
+
+	PxVec3p* localPoints = PX_ALLOCATE(PxVec3p, nbPoints*2, "PxVec3p");
+	PxVec3p* sortedPoints = localPoints + nbPoints;
+	PxU32* keys = PX_ALLOCATE(PxU32, nbPoints*2, "PxU32");
+	PxU32* indices = keys + nbPoints;
+	float* sqDists = PX_ALLOCATE(float, nbPoints, "float");
+	PxVec3* closestPts = PX_ALLOCATE(PxVec3, nbPoints, "PxVec3");
+
+	// PT: move the points to vertex space, same as pointMeshDistance_BV4
+	const bool idtScale = meshGeom.scale.isIdentity();
+	float localMaxDist = maxDist;
+	if(idtScale)
+	{
+		for(PxU32 i=0;i<nbPoints;i++)
+			localPoints[i] = PxVec3p(pose.transformInv(points[i]));
+	}
+	else
+	{
+		const PxMat34 world2vertexSkew = meshGeom.scale.getInverse() * pose.getInverse();
+		for(PxU32 i=0;i<nbPoints;i++)
+			localPoints[i] = PxVec3p(world2vertexSkew.transform(points[i]));
+
+		// PT: conservative max distance in vertex space. Results are filtered again in world space below.
+		const PxVec3& s = meshGeom.scale.scale;
+		const float minScale = PxMin(PxAbs(s.x), PxMin(PxAbs(s.y), PxAbs(s.z)));
+		if(localMaxDist < PX_MAX_F32 && minScale > 0.0f)
+			localMaxDist /= minScale;
+	}
+
+	// PT: sort the points along a Morton curve so that consecutive points are close to each other, then group them in
+	// clusters that traverse the tree together.
+	{
+		PxBounds3 bounds = PxBounds3::empty();
+		for(PxU32 i=0;i<nbPoints;i++)
+			bounds.include(localPoints[i]);
+
+		const PxVec3 extents = bounds.maximum - bounds.minimum;
+		const PxVec3 coeff(	extents.x > 0.0f ? 1023.0f/extents.x : 0.0f,
+							extents.y > 0.0f ? 1023.0f/extents.y : 0.0f,
+							extents.z > 0.0f ? 1023.0f/extents.z : 0.0f);
+		for(PxU32 i=0;i<nbPoints;i++)
+		{
+			const PxVec3 p = (localPoints[i] - bounds.minimum).multiply(coeff);
+			keys[i] = (expandMortonBits(PxU32(p.x))<<2) | (expandMortonBits(PxU32(p.y))<<1) | expandMortonBits(PxU32(p.z));
+		}
+	}
+
+	Cm::RadixSortBuffered sorter;
+	const PxU32* ranks = sorter.Sort(keys, nbPoints, Cm::RADIX_UNSIGNED).GetRanks();
+	for(PxU32 i=0;i<nbPoints;i++)
+		sortedPoints[i] = localPoints[ranks[i]];
+
+	{
+		PointClustersFunc func;
+		func.mTree			= &tree;
+		func.mPoints		= sortedPoints;
+		func.mIndices		= indices;
+		func.mSqDists		= sqDists;
+		func.mClosestPts	= closestPts;
+		func.mNbPoints		= nbPoints;
+		func.mMaxDist		= localMaxDist;
+
+		const PxU32 nbClusters = (nbPoints + GU_BV4_POINT_CLUSTER_SIZE - 1)/GU_BV4_POINT_CLUSTER_SIZE;
+		runParallelRanges(dispatcher, nbClusters, 16, func);
+	}
+
+	const SourceMesh* PX_RESTRICT sourceMesh = static_cast<SourceMesh*>(tree.mMeshInterface);
+	const PxVec3* PX_RESTRICT verts = sourceMesh->getVerts();
+	PxU32 nbFound = 0;
+	for(PxU32 i=0;i<nbPoints;i++)
+	{
+		const PxU32 pointIndex = ranks[i];
+		PxMeshClosestPoint& result = results[pointIndex];
+		result.faceIndex = indices[i];
+		if(result.faceIndex != 0xffffffff)
+		{
+			PxU32 VRef0, VRef1, VRef2;
+			getVertexReferences(VRef0, VRef1, VRef2, result.faceIndex, sourceMesh->getTris32(), sourceMesh->getTris16());
+			closestPtPointTriangle(sortedPoints[i], verts[VRef0], verts[VRef1], verts[VRef2], result.u, result.v);
+
+			if(idtScale)
+			{
+				result.position = pose.transform(closestPts[i]);
+				result.distance = PxSqrt(sqDists[i]);
+			}
+			else
+			{
+				result.position = pose.transform(meshGeom.scale.transform(closestPts[i]));
+				result.distance = (result.position - points[pointIndex]).magnitude();
+			}
+
+			if(result.distance <= maxDist)
+			{
+				nbFound++;
+				continue;
+			}
+			result.faceIndex = 0xffffffff;
+		}
+		result.position = points[pointIndex];
+		result.distance = PX_MAX_F32;
+		result.u = 0.0f;
+		result.v = 0.0f;
+	}
+
+	PX_FREE(closestPts);
+	PX_FREE(sqDists);
+	PX_FREE(keys);
+	PX_FREE(localPoints);
+	return nbFound;
+}
+
+
 bool BV4_OverlapMeshVsMesh(PxReportCallback<PxGeomIndexPair>& callback, const BV4Tree& tree0, const BV4Tree& tree1, const PxMat44* mat0to1, const PxMat44* mat1to0, PxMeshMeshQueryFlags meshMeshFlags);
 
 bool BV4_OverlapMeshVsMesh(PxReportCallback<PxGeomIndexPair>& callback, const BV4Tree& tree0, const BV4Tree& tree1, const PxMat44* mat0to1, const PxMat44* mat1to0,
@@ -149,6 +149,7 @@ namespace Gu
 									PxGeomSweepHit& sweepHit, PxHitFlags hitFlags, const PxReal inflation);
 	PX_PHYSX_COMMON_API void sweepConvex_MeshGeom_RTREE(const TriangleMesh* mesh, const Gu::Box& hullBox, const PxVec3& localDir, const PxReal distance, SweepConvexMeshHitCallback& callback, bool anyHit);
 	PX_PHYSX_COMMON_API	void pointMeshDistance_RTREE(const TriangleMesh* mesh, const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose, const PxVec3& point, float maxDist, PxU32& index, float& dist, PxVec3& closestPt);
+	PX_PHYSX_COMMON_API	PxU32 pointMeshDistances_RTREE(const TriangleMesh* mesh, const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose, PxU32 nbPoints, const PxVec3* points, float maxDist, PxMeshClosestPoint* results, PxCpuDispatcher* dispatcher);
 
 	// BV4 forward declarations
 	PX_PHYSX_COMMON_API PxU32 raycast_triangleMesh_BV4(	const TriangleMesh* mesh, const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose,
@@ -167,6 +168,7 @@ namespace Gu
 								PxGeomSweepHit& sweepHit, PxHitFlags hitFlags, const PxReal inflation);
 	PX_PHYSX_COMMON_API void sweepConvex_MeshGeom_BV4(const TriangleMesh* mesh, const Gu::Box& hullBox, const PxVec3& localDir, const PxReal distance, SweepConvexMeshHitCallback& callback, bool anyHit);
 	PX_PHYSX_COMMON_API	void pointMeshDistance_BV4(const TriangleMesh* mesh, const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose, const PxVec3& point, float maxDist, PxU32& index, float& dist, PxVec3& closestPt);
+	PX_PHYSX_COMMON_API	PxU32 pointMeshDistances_BV4(const TriangleMesh* mesh, const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose, PxU32 nbPoints, const PxVec3* points, float maxDist, PxMeshClosestPoint* results, PxCpuDispatcher* dispatcher);
 	PX_PHYSX_COMMON_API bool intersectMeshVsMesh_BV4(PxReportCallback<PxGeomIndexPair>& callback, const TriangleMesh& triMesh0, const TriangleMesh& triMesh1, const PxTransform& meshPose0, const PxTransform& meshPose1, const PxMeshScale& meshScale0, const PxMeshScale& meshScale1, PxMeshMeshQueryFlags meshMeshFlags);
 
 	typedef PxU32 (*MidphaseRaycastFunction)(	const TriangleMesh* mesh, const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose,
@@ -186,6 +188,7 @@ namespace Gu
 													PxGeomSweepHit& sweepHit, PxHitFlags hitFlags, const PxReal inflation);
 	typedef void (*MidphaseConvexSweepFunction)(	const TriangleMesh* mesh, const Gu::Box& hullBox, const PxVec3& localDir, const PxReal distance, SweepConvexMeshHitCallback& callback, bool anyHit);
 	typedef void (*MidphasePointMeshFunction)(const TriangleMesh* mesh, const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose, const PxVec3& point, float maxDist, PxU32& index, float& dist, PxVec3& closestPt);
+	typedef PxU32 (*MidphasePointsMeshFunction)(const TriangleMesh* mesh, const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose, PxU32 nbPoints, const PxVec3* points, float maxDist, PxMeshClosestPoint* results, PxCpuDispatcher* dispatcher);
 
 	static const MidphaseRaycastFunction	gMidphaseRaycastTable[PxMeshMidPhase::eLAST] =
 	{
@@ -241,6 +244,12 @@ namespace Gu
 		pointMeshDistance_BV4,
 	};
 
+	static const MidphasePointsMeshFunction gMidphasePointsMeshTable[PxMeshMidPhase::eLAST] =
+	{
+		pointMeshDistances_RTREE,
+		pointMeshDistances_BV4,
+	};
+
 namespace Midphase
 {
 	// \param[in]	mesh			triangle mesh to raycast against
@@ -372,6 +381,13 @@ namespace Midphase
 		const PxU32 index = PxU32(mesh->getConcreteType() - PxConcreteType::eTRIANGLE_MESH_BVH33);
 		gMidphasePointMeshTable[index](mesh, meshGeom, pose, point, maxDist, closestIndex, dist, closestPt);
 	}
+
+	PX_FORCE_INLINE PxU32 pointMeshDistances(const TriangleMesh* mesh, const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose, PxU32 nbPoints, const PxVec3* points, float maxDist
+											, PxMeshClosestPoint* results, PxCpuDispatcher* dispatcher)
+	{
+		const PxU32 index = PxU32(mesh->getConcreteType() - PxConcreteType::eTRIANGLE_MESH_BVH33);
+		return gMidphasePointsMeshTable[index](mesh, meshGeom, pose, nbPoints, points, maxDist, results, dispatcher);
+	}
 }
 }
 }
@@ -915,7 +915,232 @@ void physx::Gu::sweepConvex_MeshGeom_RTREE(const TriangleMesh* mesh, const Box&
 	MeshRayCollider::collideOBB(querySweptBox, true, meshData, callback);
 }
 
-void physx::Gu::pointMeshDistance_RTREE(const TriangleMesh*, const PxTriangleMeshGeometry&, const PxTransform&, const PxVec3&, float, PxU32&, float&, PxVec3&)
+#include "GuDistancePointTriangle.h"
+#include "GuBuildTask.h"
+
+namespace
+{
+// PT: collects the closest triangle among the leaves touched by an AABB query
+struct PointDistanceRTreeCallback : RTree::Callback
+{
+	PointDistanceRTreeCallback(const RTreeTriangleMesh* mesh, const PxVec3& point, float maxSqDist) :
+		mTris(mesh->getTrianglesFast()), mVerts(mesh->getVerticesFast()), mPoint(point), mClosestPt(point),
+		mSqDist(maxSqDist), mIndex(0xffffffff), mHas16BitIndices(mesh->has16BitIndices()!=0)
+	{
+	}
+
+	virtual bool processResults(PxU32 nbTouched, PxU32* touched)
+	{
+		for(PxU32 leaf=0; leaf<nbTouched; leaf++)
+		{
+			LeafTriangles currentLeaf;
+			currentLeaf.Data = touched[leaf];
+			const PxU32 nbLeafTris = currentLeaf.GetNbTriangles();
+			const PxU32 baseLeafTriIndex = currentLeaf.GetTriangleIndex();
+
+			for(PxU32 i=0; i<nbLeafTris; i++)
+			{
+				const PxU32 triangleIndex = baseLeafTriIndex+i;
+				PxU32 i0, i1, i2;
+				if(mHas16BitIndices)
+				{
+					const PxU16* tri = reinterpret_cast<const PxU16*>(mTris) + triangleIndex*3;
+					i0 = tri[0]; i1 = tri[1]; i2 = tri[2];
+				}
+				else
+				{
+					const PxU32* tri = reinterpret_cast<const PxU32*>(mTris) + triangleIndex*3;
+					i0 = tri[0]; i1 = tri[1]; i2 = tri[2];
+				}
+
+				const PxVec3& p0 = mVerts[i0];
+				const PxVec3& p1 = mVerts[i1];
+				const PxVec3& p2 = mVerts[i2];
+				const PxVec3 cp = closestPtPointTriangle2(mPoint, p0, p1, p2, p1 - p0, p2 - p0);
+				const float sqDist = (cp - mPoint).magnitudeSquared();
+				if(sqDist <= mSqDist)
+				{
+					mClosestPt = cp;
+					mSqDist = sqDist;
+					mIndex = triangleIndex;
+				}
+			}
+		}
+		return true;
+	}
+
+	const void*		mTris;
+	const PxVec3*	mVerts;
+	const PxVec3	mPoint;
+	PxVec3			mClosestPt;
+	float			mSqDist;
+	PxU32			mIndex;
+	const bool		mHas16BitIndices;
+
+	PX_NOCOPY(PointDistanceRTreeCallback)
+};
+}
+
+// PT: the RTree cannot shrink the query volume during traversal, so we query boxes of increasing size around the point
+// instead. Once the closest triangle found so far is within the box radius, no other triangle can be closer.
+static void pointMeshDistanceLocal_RTREE(const RTreeTriangleMesh* mesh, const PxVec3& point, float maxDist, PxU32& index, float& dist, PxVec3& cp)
+{
+	// PT: same limit as BV4_PointDistance, to keep squared distances finite
+	const float limit = sqrtf(sqrtf(PX_MAX_F32));
+	if(maxDist>limit)
+		maxDist = limit;
+
+	// PT: all triangles are within the mesh bounds, so the farthest corner of the bounds is an upper bound for the search radius
+	const CenterExtents& bounds = mesh->getLocalBoundsFast();
+	const PxVec3 localPoint = point - bounds.mCenter;
+	const PxVec3 absPoint(PxAbs(localPoint.x), PxAbs(localPoint.y), PxAbs(localPoint.z));
+	const float maxRadius = PxMin(maxDist, (absPoint + bounds.mExtents).magnitude());
+
+	// PT: start from the distance to the bounds plus a small fraction of their size
+	const PxVec3 outside = (absPoint - bounds.mExtents).maximum(PxVec3(0.0f));
+	float radius = PxMin(outside.magnitude() + bounds.mExtents.magnitude()*(1.0f/16.0f), maxRadius);
+
+	PointDistanceRTreeCallback callback(mesh, point, maxDist*maxDist);
+
+	const PxU32 maxResults = RTREE_N; // maxResults=rtree page size for more efficient early out
+	PxU32 buf[maxResults];
+	for(;;)
+	{
+		const PxVec3 extents(radius);
+		mesh->getRTree().traverseAABB(point - extents, point + extents, maxResults, buf, &callback);
+
+		if(callback.mSqDist <= radius*radius || radius >= maxRadius)
+			break;
+
+		// PT: radius is only zero when maxRadius is zero, in which case we already exited the loop
+		radius = PxMin(radius*2.0f, maxRadius);
+	}
+
+	index = callback.mIndex;
+	dist = sqrtf(callback.mSqDist);
+	cp = callback.mClosestPt;
+}
+
+void physx::Gu::pointMeshDistance_RTREE(const TriangleMesh* mesh, const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose, const PxVec3& point, float maxDist
+	, PxU32& index, float& dist, PxVec3& closestPt)
 {
-	PxGetFoundation().error(PxErrorCode::eINVALID_OPERATION, PX_FL, "Point-mesh distance query not supported for BVH33. Please use a BVH34 mesh.\n");
+	PX_ASSERT(mesh->getConcreteType()==PxConcreteType::eTRIANGLE_MESH_BVH33);
+	const RTreeTriangleMesh* meshData = static_cast<const RTreeTriangleMesh*>(mesh);
+
+	// PT: same as pointMeshDistance_BV4
+	if(meshGeom.scale.isIdentity())
+	{
+		PxVec3 cp;
+		pointMeshDistanceLocal_RTREE(meshData, pose.transformInv(point), maxDist, index, dist, cp);
+		closestPt = pose.transform(cp);
+	}
+	else
+	{
+		// Scaling: transform the point to vertex space
+		const PxMat34 world2vertexSkew = meshGeom.scale.getInverse() * pose.getInverse();
+		PxVec3 cp;
+		pointMeshDistanceLocal_RTREE(meshData, world2vertexSkew.transform(point), maxDist, index, dist, cp);
+		closestPt = pose.transform(meshGeom.scale.transform(cp));
+	}
+}
+
+namespace
+{
+	// PT: BVH33 meshes have no multi-point traversal, we just run the single-point query for each point
+	struct PointDistancesRTreeFunc
+	{
+		const RTreeTriangleMesh*		mMesh;
+		const PxTriangleMeshGeometry*	mMeshGeom;
+		const PxTransform*				mPose;
+		const PxVec3*					mPoints;
+		PxMeshClosestPoint*				mResults;
+		float							mMaxDist;
+
+		void operator()(PxU32 start, PxU32 end)
+		{
+			const PxMeshScale& scale = mMeshGeom->scale;
+			const bool idtScale = scale.isIdentity();
+			const PxMat34 world2vertexSkew = scale.getInverse() * mPose->getInverse();
+
+			// PT: conservative max distance in vertex space, same as pointMeshDistances_BV4. Results are filtered again in world space below.
+			float localMaxDist = mMaxDist;
+			if(!idtScale)
+			{
+				const float minScale = PxMin(PxAbs(scale.scale.x), PxMin(PxAbs(scale.scale.y), PxAbs(scale.scale.z)));
+				if(localMaxDist < PX_MAX_F32 && minScale > 0.0f)
+					localMaxDist /= minScale;
+			}
+
+			const void* tris = mMesh->getTrianglesFast();
+			const PxVec3* verts = mMesh->getVerticesFast();
+			const bool has16BitIndices = mMesh->has16BitIndices()!=0;
+
+			for(PxU32 i=start;i<end;i++)
+			{
+				const PxVec3 localPoint = idtScale ? mPose->transformInv(mPoints[i]) : world2vertexSkew.transform(mPoints[i]);
+
+				PxMeshClosestPoint& result = mResults[i];
+				float dist;
+				PxVec3 cp;
+				pointMeshDistanceLocal_RTREE(mMesh, localPoint, localMaxDist, result.faceIndex, dist, cp);
+				if(result.faceIndex != 0xffffffff)
+				{
+					PxU32 i0, i1, i2;
+					if(has16BitIndices)
+					{
+						const PxU16* tri = reinterpret_cast<const PxU16*>(tris) + result.faceIndex*3;
+						i0 = tri[0]; i1 = tri[1]; i2 = tri[2];
+					}
+					else
+					{
+						const PxU32* tri = reinterpret_cast<const PxU32*>(tris) + result.faceIndex*3;
+						i0 = tri[0]; i1 = tri[1]; i2 = tri[2];
+					}
+					closestPtPointTriangle(localPoint, verts[i0], verts[i1], verts[i2], result.u, result.v);
+
+					if(idtScale)
+					{
+						result.position = mPose->transform(cp);
+						result.distance = dist;
+					}
+					else
+					{
+						result.position = mPose->transform(scale.transform(cp));
+						result.distance = (result.position - mPoints[i]).magnitude();
+					}
+
+					if(result.distance <= mMaxDist)
+						continue;
+					result.faceIndex = 0xffffffff;
+				}
+				result.position = mPoints[i];
+				result.distance = PX_MAX_F32;
+				result.u = 0.0f;
+				result.v = 0.0f;
+			}
+		}
+	};
+}
+
+PxU32 physx::Gu::pointMeshDistances_RTREE(const TriangleMesh* mesh, const PxTriangleMeshGeometry& meshGeom, const PxTransform& pose, PxU32 nbPoints, const PxVec3* points, float maxDist
+	, PxMeshClosestPoint* results, PxCpuDispatcher* dispatcher)
+{
+	PX_ASSERT(mesh->getConcreteType()==PxConcreteType::eTRIANGLE_MESH_BVH33);
+
+	PointDistancesRTreeFunc func;
+	func.mMesh		= static_cast<const RTreeTriangleMesh*>(mesh);
+	func.mMeshGeom	= &meshGeom;
+	func.mPose		= &pose;
+	func.mPoints	= points;
+	func.mResults	= results;
+	func.mMaxDist	= maxDist;
+	runParallelRanges(dispatcher, nbPoints, 64, func);
+
+	PxU32 nbFound = 0;
+	for(PxU32 i=0;i<nbPoints;i++)
+	{
+		if(results[i].faceIndex != 0xffffffff)
+			nbFound++;
+	}
+	return nbFound;
 }
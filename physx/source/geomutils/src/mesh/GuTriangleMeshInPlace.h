@@ -0,0 +1,105 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef GU_TRIANGLE_MESH_IN_PLACE_H
+#define GU_TRIANGLE_MESH_IN_PLACE_H
+
+#include "foundation/PxSimpleTypes.h"
+#include "foundation/PxVec3.h"
+#include "foundation/PxMat33.h"
+
+namespace physx
+{
+namespace Gu {
+
+// PT: "in-place" cooked triangle meshes. Contrary to the regular cooked format (see PX_MESH_VERSION), which is a compact
+// stream that gets decoded into freshly allocated buffers, this format is a direct image of the runtime BVH34 mesh data.
+// Each array starts on a GU_IN_PLACE_MESH_ALIGNMENT boundary relative to the start of the image, so a file mapped at an
+// aligned address (e.g. mmap'ed, or loaded into a 16-byte aligned buffer) can be used directly by the runtime mesh
+// without any copy. The image is stored in the native endianness of the cooking platform and is rejected otherwise.
+
+#define GU_IN_PLACE_MESH_VERSION	1
+#define GU_IN_PLACE_MESH_ALIGNMENT	16
+
+	PX_FORCE_INLINE PxU32 computeInPlaceMeshTag()
+	{
+		return PxU32('I')|(PxU32('P')<<8)|(PxU32('T')<<16)|(PxU32('M')<<24);
+	}
+
+	PX_FORCE_INLINE PxU32 alignInPlaceMeshOffset(PxU32 offset)
+	{
+		return (offset + GU_IN_PLACE_MESH_ALIGNMENT - 1) & ~(GU_IN_PLACE_MESH_ALIGNMENT - 1);
+	}
+
+	// PT: all offsets are relative to the start of the image. A zero offset means the array is not present.
+	struct InPlaceTriangleMeshHeader
+	{
+		PxU32	mTag;					// computeInPlaceMeshTag()
+		PxU32	mVersion;				// GU_IN_PLACE_MESH_VERSION
+		PxU32	mTotalSize;				// size of the whole image in bytes, including this header
+		PxU32	mFlags;					// PxTriangleMeshFlags
+
+		PxU32	mNbVertices;
+		PxU32	mNbTriangles;
+		PxU32	mNbNodes;				// BV4 nodes
+		PxU32	mInitData;				// BV4 tree init data
+
+		PxVec3	mAABBMin;
+		PxReal	mGeomEpsilon;
+		PxVec3	mAABBMax;
+		PxU32	mQuantized;				// 1 for quantized BV4 trees
+
+		PxVec3	mLocalBoundsCenter;		// BV4 local bounds
+		PxReal	mLocalBoundsExtentsMagnitude;
+		PxVec3	mCenterOrMinCoeff;		// BV4 dequantization coeffs
+		PxU32	mPadding0;
+		PxVec3	mExtentsOrMaxCoeff;
+		PxU32	mPadding1;
+
+		PxMat33	mInertia;
+		PxVec3	mLocalCenterOfMass;
+		PxReal	mMass;
+		PxU32	mPadding2[3];
+
+		PxU32	mVerticesOffset;		// mNbVertices+1 PxVec3, the extra one makes V4 loads of the last vertex safe
+		PxU32	mTrianglesOffset;		// mNbTriangles*3 PxU16 or PxU32 depending on PxTriangleMeshFlag::e16_BIT_INDICES
+		PxU32	mExtraTrigDataOffset;	// mNbTriangles PxU8
+		PxU32	mMaterialIndicesOffset;	// mNbTriangles PxU16
+		PxU32	mFaceRemapOffset;		// mNbTriangles PxU32
+		PxU32	mAdjacenciesOffset;		// mNbTriangles*3 PxU32
+		PxU32	mNodesOffset;			// mNbNodes BVDataPackedQ or BVDataPackedNQ depending on mQuantized
+		PxU32	mPadding3;
+	};
+
+	PX_COMPILE_TIME_ASSERT((sizeof(InPlaceTriangleMeshHeader) & (GU_IN_PLACE_MESH_ALIGNMENT-1))==0);
+
+} // namespace Gu
+
+}
+
+#endif
@@ -31,7 +31,12 @@
 
 #include "foundation/PxAssert.h"
 #include "foundation/PxMemory.h"
+#include "foundation/PxAtomic.h"
+#include "foundation/PxAlignedMalloc.h"
+#include "foundation/PxThread.h"
+#include "foundation/PxTime.h"
 #include "geometry/PxGeometry.h"
+#include "PxSimulationStatistics.h"
 
 namespace physx
 {
@@ -45,13 +50,110 @@ Context handling
 /* Context handling, types                                              */
 /************************************************************************/
 
+/*!
+Description: timings of the simulation phases recorded by one thread. Only that thread writes to it during a step. Aligned
+to a cache line so that the threads never write to the same line.
+*/
+PX_ALIGN_PREFIX(64)
+struct PxvSimThreadTimers
+{
+	PxU64	mFirstStart[PxSimulationStatistics::ePHASE_COUNT];	// counter value when the phase first ran on this thread, 0 if it did not
+	PxU64	mLastEnd[PxSimulationStatistics::ePHASE_COUNT];
+	PxU64	mTime[PxSimulationStatistics::ePHASE_COUNT];
+	PxU32	mNbTasks[PxSimulationStatistics::ePHASE_COUNT];
+	PxU64	mCurrentStart;		// start of the current zone, or of the end of its last nested zone
+	PxU32	mCurrentPhase;
+	PxU32	mDepth;				// number of nested zones currently open
+
+	PX_FORCE_INLINE void stopCurrent(PxU64 time)
+	{
+		const PxU32 phase = mCurrentPhase;
+		if(!mFirstStart[phase])
+			mFirstStart[phase] = mCurrentStart;
+		mLastEnd[phase] = time;
+		mTime[phase] += time - mCurrentStart;
+	}
+}
+PX_ALIGN_SUFFIX(64);
+
+/*!
+Description: per-thread timings of the simulation phases. Threads get a slot the first time they record a zone, and keep it
+for the lifetime of the context. That way the zones never write to memory shared with other threads. The slot index of each
+thread is cached in thread local storage, like NpScene does for its read/write depth.
+*/
+struct PxvSimTimers
+{
+	PxvSimTimers() :
+		mThreads	(reinterpret_cast<PxvSimThreadTimers*>(PxAlignedAllocator<64>().allocate(sizeof(PxvSimThreadTimers) * PxSimulationStatistics::eMAX_NB_WORKERS, PX_FL))),
+		mTlsIndex	(PxTlsAlloc()),
+		mNbThreads	(0),
+		mStepStart	(0),
+		mStepEnd	(0)
+	{
+		PxMemZero(mThreads, sizeof(PxvSimThreadTimers) * PxSimulationStatistics::eMAX_NB_WORKERS);
+	}
+
+	~PxvSimTimers()
+	{
+		PxTlsFree(mTlsIndex);
+		PxAlignedAllocator<64>().deallocate(mThreads);
+	}
+
+	// Called before the tasks of a simulation step are spawned, and when no zone is open.
+	void startStep()
+	{
+		PxMemZero(mThreads, sizeof(PxvSimThreadTimers) * getNbThreads());
+		mStepStart = mStepEnd = PxTime::getCurrentCounterValue();
+	}
+
+	void endStep()
+	{
+		mStepEnd = PxTime::getCurrentCounterValue();
+	}
+
+	PX_FORCE_INLINE PxU32 getNbThreads() const
+	{
+		return PxMin(PxU32(mNbThreads), PxU32(PxSimulationStatistics::eMAX_NB_WORKERS));
+	}
+
+	// Returns NULL for the threads beyond eMAX_NB_WORKERS
+	PX_FORCE_INLINE PxvSimThreadTimers* getThreadTimers()
+	{
+		// The TLS value is the slot index + 1, so that 0 means no slot yet
+		const size_t slot = PxTlsGetValue(mTlsIndex);
+		if(slot)
+			return mThreads + slot - 1;
+		return claimThreadTimers();
+	}
+
+	PxvSimThreadTimers* claimThreadTimers()
+	{
+		if(getNbThreads() == PxSimulationStatistics::eMAX_NB_WORKERS)
+			return NULL;
+
+		const PxU32 index = PxU32(PxAtomicIncrement(&mNbThreads) - 1);
+		if(index >= PxSimulationStatistics::eMAX_NB_WORKERS)
+			return NULL;
+		PxTlsSetValue(mTlsIndex, size_t(index) + 1);
+		return mThreads + index;
+	}
+
+	PxvSimThreadTimers*	mThreads;	// eMAX_NB_WORKERS slots
+	const PxU32			mTlsIndex;
+	volatile PxI32		mNbThreads;
+	PxU64				mStepStart;
+	PxU64				mStepEnd;
+
+	PX_NOCOPY(PxvSimTimers)
+};
+
 /*!
 Description: contains statistics for the simulation.
 */
 struct PxvSimStats
 {
 	PxvSimStats() { clearAll(); }
-	void clearAll() { PxMemZero(this, sizeof(PxvSimStats)); }		// set counters to zero
+	void clearAll() { PxMemZero(this, PX_OFFSET_OF(PxvSimStats, mTimers)); }		// set counters to zero, the timers are kept
 
 	PX_FORCE_INLINE void incCCDPairs(PxGeometryType::Enum g0, PxGeometryType::Enum g1)
 	{
@@ -104,8 +206,60 @@ struct PxvSimStats
 	PxU32	mNbLostTouches;
 
 	PxU32	mNbPartitions;
+
+	// Must stay last, clearAll() does not touch it. See PxvSimTimers::startStep()
+	PxvSimTimers	mTimers;
+};
+
+/*!
+Description: times a task of the simulation and counts it in a phase of PxSimulationStatistics. Zones can be nested: the
+time spent in the inner zone is counted in the inner zone's phase only, and the inner zone only counts as a task if its
+phase differs from the outer one.
+*/
+class PxvSimPhaseZone
+{
+public:
+	PX_FORCE_INLINE PxvSimPhaseZone(PxvSimStats* simStats, PxSimulationStatistics::PhaseType phase) :
+		mThread(simStats ? simStats->mTimers.getThreadTimers() : NULL)
+	{
+		if(!mThread)
+			return;
+
+		const PxU64 time = PxTime::getCurrentCounterValue();
+		if(mThread->mDepth)
+			mThread->stopCurrent(time);
+		if(!mThread->mDepth || mThread->mCurrentPhase != PxU32(phase))
+			mThread->mNbTasks[phase]++;
+
+		mOuterPhase = mThread->mCurrentPhase;
+		mThread->mCurrentPhase = phase;
+		mThread->mCurrentStart = time;
+		mThread->mDepth++;
+	}
+
+	PX_FORCE_INLINE ~PxvSimPhaseZone()
+	{
+		if(!mThread)
+			return;
+
+		const PxU64 time = PxTime::getCurrentCounterValue();
+		mThread->stopCurrent(time);
+		mThread->mCurrentPhase = mOuterPhase;
+		mThread->mCurrentStart = time;
+		mThread->mDepth--;
+	}
+
+private:
+	PxvSimThreadTimers*	mThread;
+	PxU32				mOuterPhase;
 };
 
+#if PX_ENABLE_SIM_STATS
+	#define PXV_SIM_PHASE_ZONE(simStats, phase)	physx::PxvSimPhaseZone PX_CONCAT(_simPhaseZone, __LINE__)(simStats, physx::PxSimulationStatistics::phase)
+#else
+	#define PXV_SIM_PHASE_ZONE(simStats, phase)
+#endif
+
 }
 
 #endif
@@ -35,19 +35,28 @@
 #include "foundation/PxArray.h"
 #include "foundation/PxAllocator.h"
 #include "foundation/PxUserAllocated.h"
+#include "PxSimulationStatistics.h"
 
 namespace physx
 {
+// Stack allocator over the scratch block of a simulation step. It also records how much scratch memory each user asked
+// for during the step, whether or not it fitted in the block, so that the block can be sized from the statistics.
 class PxcScratchAllocator : public PxUserAllocated
 {
 	PX_NOCOPY(PxcScratchAllocator)
 public:
-	PxcScratchAllocator() : mStack("PxcScratchAllocator"), mStart(NULL), mSize(0)
+	typedef PxSimulationStatistics::ScratchUsageType	Usage;
+
+	PxcScratchAllocator() : mStack("PxcScratchAllocator"), mStart(NULL), mSize(0), mCurrentTotalBytes(0), mAllocAllBaseBytes(0), mPeakTotalBytes(0), mHeapFallbackBytes(0)
 	{
 		mStack.reserve(64);
-		mStack.pushBack(0);
+		mStack.pushBack(StackEntry(NULL, 0, PxSimulationStatistics::eSCRATCH_OTHER));
+
+		for(PxU32 i=0;i<PxSimulationStatistics::eSCRATCH_USAGE_COUNT;i++)
+			mCurrentBytes[i] = mPeakBytes[i] = 0;
 	}
 
+	// Called at the start of each simulation step. This also starts a new measurement of the peak usage.
 	void setBlock(void* addr, PxU32 size)
 	{
 		PX_ASSERT(!(size&15));
@@ -61,42 +70,73 @@ public:
 
 		mStart = reinterpret_cast<PxU8*>(addr);
 		mSize = size;
-		mStack.pushBack(mStart + size);
+		mStack.pushBack(StackEntry(mStart + size, 0, PxSimulationStatistics::eSCRATCH_OTHER));
+
+		for(PxU32 i=0;i<PxSimulationStatistics::eSCRATCH_USAGE_COUNT;i++)
+			mPeakBytes[i] = mCurrentBytes[i];
+		mPeakTotalBytes = mCurrentTotalBytes;
+		mHeapFallbackBytes = 0;
 	}
 
+	// Takes all the remaining scratch memory. The caller reports how much of it was actually needed with
+	// reportAllocAllUsage() before releasing it.
 	void* allocAll(PxU32& size)
 	{
 		PxMutex::ScopedLock lock(mLock);
 		PX_ASSERT(mStack.size()>0);
-		size = PxU32(mStack.back()-mStart);
+		size = PxU32(mStack.back().mAddr-mStart);
+		mAllocAllBaseBytes = mCurrentTotalBytes;
 
 		if(size==0)
 			return NULL;
 
-		mStack.pushBack(mStart);
+		mStack.pushBack(StackEntry(mStart, 0, PxSimulationStatistics::eSCRATCH_OTHER));
 		return mStart;
 	}
 
-	void* alloc(PxU32 requestedSize, bool fallBackToHeap = false)
+	// Records the amount of memory a user needed while it held the memory returned by allocAll(), whether it came from
+	// that memory or not.
+	void reportAllocAllUsage(Usage usage, PxU32 size)
+	{
+		PxMutex::ScopedLock lock(mLock);
+		mPeakBytes[usage] = PxMax(mPeakBytes[usage], mCurrentBytes[usage] + size);
+		mPeakTotalBytes = PxMax(mPeakTotalBytes, mAllocAllBaseBytes + size);
+	}
+
+	void* alloc(PxU32 requestedSize, bool fallBackToHeap = false, Usage usage = PxSimulationStatistics::eSCRATCH_OTHER)
 	{
 		requestedSize = (requestedSize+15)&~15;
 
 		PxMutex::ScopedLock lock(mLock);
 		PX_ASSERT(mStack.size()>=1);
 
-		PxU8* top = mStack.back();
+		PxU8* top = mStack.back().mAddr;
 
 		if(top - mStart >= ptrdiff_t(requestedSize))
 		{
 			PxU8* addr = top - requestedSize;
-			mStack.pushBack(addr);
+			mStack.pushBack(StackEntry(addr, requestedSize, usage));
+			addUsage(usage, requestedSize);
 			return addr;
 		}
 
 		if(!fallBackToHeap)
+		{
+			// the request still counts towards the size the block should have
+			mPeakTotalBytes = PxMax(mPeakTotalBytes, mCurrentTotalBytes + requestedSize);
+			return NULL;
+		}
+
+		// the size and user of heap allocations are kept in a header, for free()
+		HeapHeader* header = reinterpret_cast<HeapHeader*>(PX_ALLOC(sizeof(HeapHeader) + requestedSize, "Scratch Block Fallback"));
+		if(!header)
 			return NULL;
 
-		return PX_ALLOC(requestedSize, "Scratch Block Fallback");
+		header->mSize = requestedSize;
+		header->mUsage = usage;
+		addUsage(usage, requestedSize);
+		mHeapFallbackBytes += requestedSize;
+		return header + 1;
 	}
 
 	void free(void* addr)
@@ -104,7 +144,12 @@ public:
 		PX_ASSERT(addr!=NULL);
 		if(!isScratchAddr(addr))
 		{
-			PX_FREE(addr);
+			HeapHeader* header = reinterpret_cast<HeapHeader*>(addr) - 1;
+			{
+				PxMutex::ScopedLock lock(mLock);
+				removeUsage(Usage(header->mUsage), header->mSize);
+			}
+			PX_FREE(header);
 			return;
 		}
 
@@ -112,10 +157,11 @@ public:
 		PX_ASSERT(mStack.size()>1);
 
 		PxU32 i=mStack.size()-1;		
-		while(mStack[i]<addr)
+		while(mStack[i].mAddr<addr)
 			i--;
 
-		PX_ASSERT(mStack[i]==addr);
+		PX_ASSERT(mStack[i].mAddr==addr);
+		removeUsage(Usage(mStack[i].mUsage), mStack[i].mSize);
 		mStack.remove(i);
 	}
 
@@ -125,11 +171,54 @@ public:
 		return a>= mStart && a<mStart+mSize;
 	}
 
+	// Peak usage since the last call to setBlock(), i.e. during the current or last simulation step
+	PX_FORCE_INLINE	PxU32	getPeakBytes(Usage usage)	const	{ return mPeakBytes[usage];	}
+	PX_FORCE_INLINE	PxU32	getPeakTotalBytes()			const	{ return mPeakTotalBytes;	}
+	PX_FORCE_INLINE	PxU32	getHeapFallbackBytes()		const	{ return mHeapFallbackBytes;	}
+
 private:
+	struct StackEntry
+	{
+		StackEntry(PxU8* addr, PxU32 size, Usage usage) : mAddr(addr), mSize(size), mUsage(usage)	{}
+
+		PxU8*	mAddr;
+		PxU32	mSize;
+		PxU32	mUsage;
+	};
+
+	// 16 bytes to keep the heap allocations 16-byte aligned
+	struct HeapHeader
+	{
+		PxU32	mSize;
+		PxU32	mUsage;
+		PxU32	mPad[2];
+	};
+
+	PX_FORCE_INLINE void addUsage(Usage usage, PxU32 size)
+	{
+		mCurrentBytes[usage] += size;
+		mCurrentTotalBytes += size;
+		mPeakBytes[usage] = PxMax(mPeakBytes[usage], mCurrentBytes[usage]);
+		mPeakTotalBytes = PxMax(mPeakTotalBytes, mCurrentTotalBytes);
+	}
+
+	PX_FORCE_INLINE void removeUsage(Usage usage, PxU32 size)
+	{
+		PX_ASSERT(mCurrentBytes[usage]>=size);
+		mCurrentBytes[usage] -= size;
+		mCurrentTotalBytes -= size;
+	}
+
 	PxMutex				mLock;
-	PxArray<PxU8*>		mStack;
+	PxArray<StackEntry>	mStack;
 	PxU8*				mStart;
 	PxU32				mSize;
+	PxU32				mCurrentBytes[PxSimulationStatistics::eSCRATCH_USAGE_COUNT];
+	PxU32				mPeakBytes[PxSimulationStatistics::eSCRATCH_USAGE_COUNT];
+	PxU32				mCurrentTotalBytes;
+	PxU32				mAllocAllBaseBytes;
+	PxU32				mPeakTotalBytes;
+	PxU32				mHeapFallbackBytes;
 };
 
 }
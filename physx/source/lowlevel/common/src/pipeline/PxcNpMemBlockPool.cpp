@@ -147,6 +147,7 @@ void PxcNpMemBlockPool::releaseConstraintMemory()
 {
 	PxMutex::ScopedLock lock(mLock);
 
+	mScratchAllocator.reportAllocAllUsage(PxSimulationStatistics::eSCRATCH_SOLVER, mPeakConstraintAllocations*PxcNpMemBlock::SIZE);
 	mPeakConstraintAllocations = mConstraintAllocations = 0;
 	
 	while(mConstraints.size())
@@ -940,14 +940,16 @@ class PxsCCDSweepTask : public Cm::Task
 	PxsCCDPair**	mPairs;
 	PxU32			mNumPairs;
 	PxReal			mCCDThreshold;
+	PxvSimStats&	mSimStats;
 public:
-	PxsCCDSweepTask(PxU64 contextID, PxsCCDPair** pairs, PxU32 nPairs, PxReal ccdThreshold) :
-		Cm::Task(contextID), mPairs(pairs), mNumPairs(nPairs), mCCDThreshold(ccdThreshold)
+	PxsCCDSweepTask(PxU64 contextID, PxsCCDPair** pairs, PxU32 nPairs, PxReal ccdThreshold, PxvSimStats& simStats) :
+		Cm::Task(contextID), mPairs(pairs), mNumPairs(nPairs), mCCDThreshold(ccdThreshold), mSimStats(simStats)
 	{
 	}
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mSimStats, eCCD);
 		for (PxU32 j = 0; j < mNumPairs; j++)
 		{
 			PxsCCDPair& pair = *mPairs[j];
@@ -1010,6 +1012,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mContext->getSimStats(), eCCD);
 		PxI32 sweepTotalHits = 0;
 
 		PxcNpThreadContext* threadContext = mContext->getNpThreadContext();
@@ -1827,7 +1830,7 @@ void PxsCCDContext::updateCCD(PxReal dt, PxBaseTask* continuation, IG::IslandSim
 		const PxU32 batchEnd = PxMin(nPairs, batchBegin + mCCDPairsPerBatch);
 		PX_ASSERT(batchEnd >= batchBegin);
 		PxsCCDSweepTask* task = PX_PLACEMENT_NEW(ptr, PxsCCDSweepTask)(mContext->getContextId(), mCCDPtrPairs.begin() + batchBegin, batchEnd - batchBegin,
-			mCCDThreshold);
+			mCCDThreshold, mContext->getSimStats());
 		task->setContinuation(*mContext->mTaskManager, &mPostCCDSweepTask);
 		task->removeReference();
 	}
@@ -1839,6 +1842,7 @@ void PxsCCDContext::updateCCD(PxReal dt, PxBaseTask* continuation, IG::IslandSim
 
 void PxsCCDContext::postCCDSweep(PxBaseTask* continuation)
 {
+	PXV_SIM_PHASE_ZONE(&mContext->getSimStats(), eCCD);
 	// --------------------------------------------------------------------------------------
 	// batch up the islands and send them over to worker threads
 	PxU32 firstIslandPair = 0;
@@ -1887,6 +1891,7 @@ static PX_FORCE_INLINE bool shouldCreateContactReports(const PxsRigidCore* rigid
 
 void PxsCCDContext::postCCDAdvance(PxBaseTask* /*continuation*/)
 {	
+	PXV_SIM_PHASE_ZONE(&mContext->getSimStats(), eCCD);
 	// --------------------------------------------------------------------------------------
 	// contact notifications: update touch status (multi-threading this section would probably slow it down but might be worth a try)
 	PxU32 countLost = 0, countFound = 0, countRetouch = 0;
@@ -2031,6 +2036,7 @@ void PxsCCDContext::postCCDAdvance(PxBaseTask* /*continuation*/)
 
 void PxsCCDContext::postCCDDepenetrate(PxBaseTask* /*continuation*/)
 {
+	PXV_SIM_PHASE_ZONE(&mContext->getSimStats(), eCCD);
 	// --------------------------------------------------------------------------------------
 	// reset mOverlappingShapes array for all bodies
 	// we do it each pass because this set can change due to movement as well as new objects
@@ -478,6 +478,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mContext->getSimStats(), eNARROW_PHASE);
 		PX_PROFILE_ZONE("Sim.narrowPhase", mContext->getContextId());
 
 		PxcNpThreadContext* PX_RESTRICT threadContext = mContext->getNpThreadContext(); 
@@ -37,6 +37,7 @@ namespace physx
 {
 	class PxcScratchAllocator;
 	class PxBaseTask;
+	struct PxvSimStats;
 
 namespace Bp
 {
@@ -98,6 +99,7 @@ struct BroadPhasePair
 class BroadPhase : public BroadPhaseBase
 {
 public:
+					BroadPhase() : mSimStats(NULL)	{}
 
 	/**
 	\brief Instantiate a BroadPhase instance.
@@ -205,6 +207,15 @@ public:
 	*/
 	virtual bool	isValid(const BroadPhaseUpdateData& updateData) const = 0;
 #endif
+
+	/**
+	\brief Sets the statistics the broadphase tasks record their timings into. NULL (the default) disables the timings.
+	*/
+	PX_FORCE_INLINE	void			setSimStats(PxvSimStats* simStats)	{ mSimStats = simStats;	}
+	PX_FORCE_INLINE	PxvSimStats*	getSimStats()				const	{ return mSimStats;		}
+
+protected:
+	PxvSimStats*	mSimStats;
 };
 
 } //namespace Bp
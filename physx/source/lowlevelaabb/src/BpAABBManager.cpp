@@ -38,6 +38,7 @@
 #include "BpBroadPhaseMBPCommon.h"
 #include "BpBroadPhase.h"
 #include "BpBroadPhaseShared.h"
+#include "PxvSimStats.h"
 #include "foundation/PxSort.h"
 #include "foundation/PxVecMath.h"
 #include "GuInternal.h"
@@ -1317,6 +1318,7 @@ void AABBManager::handleOriginShift()
 
 void AggregateBoundsComputationTask::runInternal()
 {
+	PXV_SIM_PHASE_ZONE(mManager->getBroadPhase()->getSimStats(), eBROAD_PHASE);
 	const BoundsArray& boundArray = mManager->getBoundsArray();
 	const float* contactDistances = mManager->getContactDistances();
 
@@ -1338,6 +1340,7 @@ void AggregateBoundsComputationTask::runInternal()
 
 void PreBpUpdateTask::runInternal()
 {
+	PXV_SIM_PHASE_ZONE(mManager->getBroadPhase()->getSimStats(), eBROAD_PHASE);
 	mManager->preBpUpdate_CPU(mNumCpuTasks);
 }
 
@@ -1929,6 +1932,7 @@ public:
 
 	void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(mManager->getBroadPhase()->getSimStats(), eBROAD_PHASE);
 		BpCacheData* data = mManager->getBpCacheData();
 
 		setCache(*data);
@@ -2002,6 +2006,7 @@ public:
 
 	void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(mManager->getBroadPhase()->getSimStats(), eBROAD_PHASE);
 		BpCacheData* data = mManager->getBpCacheData();
 		setCache(*data);
 		PX_PROFILE_ZONE("ProcessSelfCollisionPairs", mContextID);
@@ -2144,6 +2149,7 @@ void AABBManager::reallocateChangedAABBMgActorHandleMap(const PxU32 size)
 
 void PostBroadPhaseStage2Task::runInternal()
 {
+	PXV_SIM_PHASE_ZONE(mManager.getBroadPhase()->getSimStats(), eBROAD_PHASE);
 	mManager.postBpStage2(mCont, *mFlushPool);
 }
 
@@ -34,6 +34,7 @@
 #include "BpBroadPhaseShared.h"
 #include "foundation/PxVecMath.h"
 #include "PxcScratchAllocator.h"
+#include "PxvSimStats.h"
 #include "common/PxProfileZone.h"
 #include "CmRadixSort.h"
 #include "CmUtils.h"
@@ -382,7 +383,7 @@ namespace internalABP
 void* ABP_MM::frameAlloc(PxU32 size)
 {
 	if(mScratchAllocator)
-		return mScratchAllocator->alloc(size, true);
+		return mScratchAllocator->alloc(size, true, PxSimulationStatistics::eSCRATCH_BROAD_PHASE);
 	return PX_ALLOC(size, "frameAlloc");
 }
 
@@ -1804,6 +1805,7 @@ static PX_FORCE_INLINE void outputPair(PairManagerMT& pairManager, PxU32 index0,
 	public:
 							ABP_CompleteBoxPruningTask() :
 								mStartTask(NULL),
+								mSimStats(NULL),
 								mType(0),
 								mID(0)
 							{
@@ -1817,6 +1819,7 @@ static PX_FORCE_INLINE void outputPair(PairManagerMT& pairManager, PxU32 index0,
 		virtual void run()	PX_OVERRIDE;
 
 		ABP_CompleteBoxPruningStartTask*	mStartTask;
+		PxvSimStats*			mSimStats;
 
 		PxU16					mType;
 		PxU16					mID;
@@ -1889,6 +1892,7 @@ static PX_FORCE_INLINE void outputPair(PairManagerMT& pairManager, PxU32 index0,
 		const SIMD_AABB_YZ4*			mListYZ;
 		const ABP_Index*				mInputRemap;
 		ABP_PairManager*				mPairManager;
+		PxvSimStats*					mSimStats;
 
 		PxU32*							mRemap;
 		SIMD_AABB_X4*					mBoxListXBuffer;
@@ -1931,6 +1935,9 @@ static PX_FORCE_INLINE void outputPair(PairManagerMT& pairManager, PxU32 index0,
 						void					setTransientData(const PxBounds3* bounds, const PxReal* contactDistance);
 
 						void					Region_prepareOverlaps();
+#ifdef ABP_MT2
+						void					setSimStats(PxvSimStats* simStats);
+#endif
 
 						ABP_MM					mMM;
 						BoxManager				mSBM;
@@ -2742,6 +2749,7 @@ static void CompleteBoxPruning_Recursive(
 #ifdef ABP_MT2
 void ABP_CompleteBoxPruningTask::run()
 {
+	PXV_SIM_PHASE_ZONE(mSimStats, eBROAD_PHASE);
 //	printf("Running ABP_CompleteBoxPruningTask\n");
 
 	//printf("ABP_Task_%d - thread ID %d\n", mID, PxU32(PxThread::getId()));
@@ -2784,6 +2792,7 @@ ABP_CompleteBoxPruningStartTask::ABP_CompleteBoxPruningStartTask() :
 	mListYZ			(NULL),
 	mInputRemap		(NULL),
 	mPairManager	(NULL),
+	mSimStats		(NULL),
 	mRemap			(NULL),
 	mBoxListXBuffer	(NULL),
 	mBoxListYZBuffer(NULL),
@@ -2826,6 +2835,7 @@ void ABP_CompleteBoxPruningStartTask::setup(
 
 void ABP_CompleteBoxPruningStartTask::run()
 {
+	PXV_SIM_PHASE_ZONE(mSimStats, eBROAD_PHASE);
 //	printf("Running ABP_CompleteBoxPruningStartTask\n");
 
 	const SIMD_AABB_X4* PX_RESTRICT listX = mListX;
@@ -3587,6 +3597,22 @@ ABP::ABP(PxU64 contextID) :
 #endif
 }
 
+#ifdef ABP_MT2
+void ABP::setSimStats(PxvSimStats* simStats)
+{
+	mCompleteBoxPruningTask0.mSimStats = simStats;
+	mCompleteBoxPruningTask1.mSimStats = simStats;
+	for(PxU32 k=0; k<9; k++)
+	{
+		mCompleteBoxPruningTask0.mTasks[k].mSimStats = simStats;
+		mCompleteBoxPruningTask1.mTasks[k].mSimStats = simStats;
+	}
+
+	for(PxU32 k=0; k<NB_BIP_TASKS; k++)
+		mBipTasks[k].mSimStats = simStats;
+}
+#endif
+
 ABP::~ABP()
 {
 	reset();
@@ -4013,6 +4039,9 @@ void BroadPhaseABP::update(PxcScratchAllocator* scratchAllocator, const BroadPha
 
 		mABP->mMM.mScratchAllocator = scratchAllocator;
 		mABP->setTransientData(updateData.getAABBs(), updateData.getContactDistance());
+#ifdef ABP_MT2
+		mABP->setSimStats(mSimStats);
+#endif
 
 		const PxU32 newCapacity = updateData.getCapacity();
 		mABP->mShared.checkResize(newCapacity);
@@ -4085,6 +4114,7 @@ void BroadPhaseABP::update(PxcScratchAllocator* scratchAllocator, const BroadPha
 void ABP_InternalTask::run()
 {
 	PX_SIMD_GUARD
+	PXV_SIM_PHASE_ZONE(mBP->getSimStats(), eBROAD_PHASE);
 
 	internalABP::ABP* abp = mBP->mABP;
 
@@ -30,6 +30,7 @@
 #include "common/PxProfileZone.h"
 #include "CmRadixSort.h"
 #include "PxcScratchAllocator.h"
+#include "PxvSimStats.h"
 #include "PxSceneDesc.h"
 #include "BpBroadPhaseSap.h"
 #include "BpBroadPhaseSapAux.h"
@@ -218,23 +219,23 @@ void BroadPhaseSap::resizeBuffers()
 {
 	const PxU32 defaultPairsCapacity = mDefaultPairsCapacity;
 
-	mCreatedPairsArray = reinterpret_cast<BroadPhasePair*>(mScratchAllocator->alloc(sizeof(BroadPhasePair)*defaultPairsCapacity, true));
+	mCreatedPairsArray = reinterpret_cast<BroadPhasePair*>(mScratchAllocator->alloc(sizeof(BroadPhasePair)*defaultPairsCapacity, true, PxSimulationStatistics::eSCRATCH_BROAD_PHASE));
 	mCreatedPairsCapacity = defaultPairsCapacity;
 	mCreatedPairsSize = 0;
 
-	mDeletedPairsArray = reinterpret_cast<BroadPhasePair*>(mScratchAllocator->alloc(sizeof(BroadPhasePair)*defaultPairsCapacity, true));
+	mDeletedPairsArray = reinterpret_cast<BroadPhasePair*>(mScratchAllocator->alloc(sizeof(BroadPhasePair)*defaultPairsCapacity, true, PxSimulationStatistics::eSCRATCH_BROAD_PHASE));
 	mDeletedPairsCapacity = defaultPairsCapacity;
 	mDeletedPairsSize = 0;
 
-	mData = reinterpret_cast<BpHandle*>(mScratchAllocator->alloc(sizeof(BpHandle)*defaultPairsCapacity, true));
+	mData = reinterpret_cast<BpHandle*>(mScratchAllocator->alloc(sizeof(BpHandle)*defaultPairsCapacity, true, PxSimulationStatistics::eSCRATCH_BROAD_PHASE));
 	mDataCapacity = defaultPairsCapacity;
 	mDataSize = 0;
 
-	mBatchUpdateTasks[0].setPairs(reinterpret_cast<BroadPhasePair*>(mScratchAllocator->alloc(sizeof(BroadPhasePair)*defaultPairsCapacity, true)), defaultPairsCapacity);
+	mBatchUpdateTasks[0].setPairs(reinterpret_cast<BroadPhasePair*>(mScratchAllocator->alloc(sizeof(BroadPhasePair)*defaultPairsCapacity, true, PxSimulationStatistics::eSCRATCH_BROAD_PHASE)), defaultPairsCapacity);
 	mBatchUpdateTasks[0].setNumPairs(0);
-	mBatchUpdateTasks[1].setPairs(reinterpret_cast<BroadPhasePair*>(mScratchAllocator->alloc(sizeof(BroadPhasePair)*defaultPairsCapacity, true)), defaultPairsCapacity);
+	mBatchUpdateTasks[1].setPairs(reinterpret_cast<BroadPhasePair*>(mScratchAllocator->alloc(sizeof(BroadPhasePair)*defaultPairsCapacity, true, PxSimulationStatistics::eSCRATCH_BROAD_PHASE)), defaultPairsCapacity);
 	mBatchUpdateTasks[1].setNumPairs(0);
-	mBatchUpdateTasks[2].setPairs(reinterpret_cast<BroadPhasePair*>(mScratchAllocator->alloc(sizeof(BroadPhasePair)*defaultPairsCapacity, true)), defaultPairsCapacity);
+	mBatchUpdateTasks[2].setPairs(reinterpret_cast<BroadPhasePair*>(mScratchAllocator->alloc(sizeof(BroadPhasePair)*defaultPairsCapacity, true, PxSimulationStatistics::eSCRATCH_BROAD_PHASE)), defaultPairsCapacity);
 	mBatchUpdateTasks[2].setNumPairs(0);
 }
 
@@ -686,6 +687,7 @@ void BroadPhaseSap::postUpdate()
 
 void BroadPhaseBatchUpdateWorkTask::runInternal()
 {
+	PXV_SIM_PHASE_ZONE(mSap->getSimStats(), eBROAD_PHASE);
 	mPairsSize=0;
 	mSap->batchUpdate(mAxis, mPairs, mPairsSize, mPairsCapacity);
 }
@@ -1139,7 +1141,7 @@ static BroadPhasePair* resizeBroadPhasePairArray(const PxU32 oldMaxNb, const PxU
 	PX_ASSERT(newMaxNb > oldMaxNb);
 	PX_ASSERT(newMaxNb > 0);
 	PX_ASSERT(0==((newMaxNb*sizeof(BroadPhasePair)) & 15)); 
-	BroadPhasePair* newElements = reinterpret_cast<BroadPhasePair*>(scratchAllocator->alloc(sizeof(BroadPhasePair)*newMaxNb, true));
+	BroadPhasePair* newElements = reinterpret_cast<BroadPhasePair*>(scratchAllocator->alloc(sizeof(BroadPhasePair)*newMaxNb, true, PxSimulationStatistics::eSCRATCH_BROAD_PHASE));
 	PX_ASSERT(0==(uintptr_t(newElements) & 0x0f));
 	PxMemCopy(newElements, elements, oldMaxNb*sizeof(BroadPhasePair));
 	scratchAllocator->free(elements);
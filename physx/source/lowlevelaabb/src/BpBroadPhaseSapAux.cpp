@@ -496,7 +496,7 @@ void ComputeCreatedDeletedPairsLists
 				// No need to call "ClearInArray" in this case, since the pair will get removed anyway
 				if(numDeletedPairs==maxNumDeletedPairs)
 				{
-					BroadPhasePair* newDeletedPairsList = reinterpret_cast<BroadPhasePair*>(scratchAllocator->alloc(sizeof(BroadPhasePair)*2*maxNumDeletedPairs, true));
+					BroadPhasePair* newDeletedPairsList = reinterpret_cast<BroadPhasePair*>(scratchAllocator->alloc(sizeof(BroadPhasePair)*2*maxNumDeletedPairs, true, PxSimulationStatistics::eSCRATCH_BROAD_PHASE));
 					PxMemCopy(newDeletedPairsList, deletedPairsList, sizeof(BroadPhasePair)*maxNumDeletedPairs);
 					scratchAllocator->free(deletedPairsList);
 					deletedPairsList = newDeletedPairsList;
@@ -520,7 +520,7 @@ void ComputeCreatedDeletedPairsLists
 				{
 					if(numCreatedPairs==maxNumCreatedPairs)
 					{
-						BroadPhasePair* newCreatedPairsList = reinterpret_cast<BroadPhasePair*>(scratchAllocator->alloc(sizeof(BroadPhasePair)*2*maxNumCreatedPairs, true));
+						BroadPhasePair* newCreatedPairsList = reinterpret_cast<BroadPhasePair*>(scratchAllocator->alloc(sizeof(BroadPhasePair)*2*maxNumCreatedPairs, true, PxSimulationStatistics::eSCRATCH_BROAD_PHASE));
 						PxMemCopy(newCreatedPairsList, createdPairsList, sizeof(BroadPhasePair)*maxNumCreatedPairs);
 						scratchAllocator->free(createdPairsList);
 						createdPairsList = newCreatedPairsList;
@@ -549,7 +549,7 @@ void ComputeCreatedDeletedPairsLists
 
 			if(numActualDeletedPairs==maxNumDeletedPairs)
 			{
-				BroadPhasePair* newDeletedPairsList = reinterpret_cast<BroadPhasePair*>(scratchAllocator->alloc(sizeof(BroadPhasePair)*2*maxNumDeletedPairs, true));
+				BroadPhasePair* newDeletedPairsList = reinterpret_cast<BroadPhasePair*>(scratchAllocator->alloc(sizeof(BroadPhasePair)*2*maxNumDeletedPairs, true, PxSimulationStatistics::eSCRATCH_BROAD_PHASE));
 				PxMemCopy(newDeletedPairsList, deletedPairsList, sizeof(BroadPhasePair)*maxNumDeletedPairs);
 				scratchAllocator->free(deletedPairsList);
 				deletedPairsList = newDeletedPairsList;
@@ -614,7 +614,7 @@ void ComputeCreatedDeletedPairsLists
 
 void DataArray::Resize(PxcScratchAllocator* scratchAllocator)
 {
-	BpHandle* newDataArray = reinterpret_cast<BpHandle*>(scratchAllocator->alloc(sizeof(BpHandle)*mCapacity*2, true));
+	BpHandle* newDataArray = reinterpret_cast<BpHandle*>(scratchAllocator->alloc(sizeof(BpHandle)*mCapacity*2, true, PxSimulationStatistics::eSCRATCH_BROAD_PHASE));
 	PxMemCopy(newDataArray, mData, mCapacity*sizeof(BpHandle));
 	scratchAllocator->free(mData);
 	mData = newDataArray;
@@ -436,6 +436,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mContext.getSimStats(), eSOLVER);
 		solveParallel(mContext, mParams, mIslandSim);
 	}
 
@@ -580,6 +581,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mContext.getSimStats(), eINTEGRATION);
 		PX_PROFILE_ZONE("ConstraintPostProcess", mContext.getContextId());
 		PxU32 endIndex = mStartIndex + mStride;
 
@@ -713,6 +715,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mDynamicsContext.getSimStats(), eINTEGRATION);
 		mDynamicsContext.getThresholdStream().forceSize_Unsafe(PxU32(mDynamicsContext.mThresholdStreamOut));
 		createForceChangeThresholdStream();
 	}
@@ -760,6 +763,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mContext.getSimStats(), eSOLVER_SETUP);
 		ThreadContext& threadContext = *mContext.getThreadContext();
 
 		threadContext.mConstraintBlockStream.reset(); //Clear in case there's some left-over memory in this context, for which the block has already been freed 
@@ -1377,6 +1381,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mContext.getSimStats(), eSOLVER_SETUP);
 		startTasks();
 		integrate();
 		setupDescTask();
@@ -1420,6 +1425,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mContext.getSimStats(), eSOLVER_SETUP);
 		PX_PROFILE_ZONE("PartitionConstraints", mContext.getContextId());
 		ThreadContext& mThreadContext = *mIslandContext.mThreadContext;
 
@@ -1505,6 +1511,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mContext.getSimStats(), eSOLVER);
 		ThreadContext& mThreadContext = *mIslandContext.mThreadContext;
 
 		PxSolverConstraintDesc* contactDescBegin = mThreadContext.orderedContactConstraints;
@@ -1877,6 +1884,7 @@ public:
 
 	virtual void runInternal()
 	{		
+		PXV_SIM_PHASE_ZONE(&mContext.getSimStats(), eINTEGRATION);
 		PX_PROFILE_ZONE("Dynamics.endTask", getContextId());
 		ThreadContext& mThreadContext = *mIslandContext.mThreadContext;
 #if PX_ENABLE_SIM_STATS
@@ -2061,6 +2069,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mContext.getSimStats(), eSOLVER_SETUP);
 		mContext.updatePostKinematic(mSimpleIslandManager, mCont, mLostTouchTask, mMaxArticulationLinks);
 		//Allow lost touch task to run once all tasks have be scheduled
 		mLostTouchTask->removeReference();
@@ -2465,6 +2474,7 @@ static void preIntegrationParallel(
 
 void PxsPreIntegrateTask::runInternal()
 {
+	PXV_SIM_PHASE_ZONE(&mContext.getSimStats(), eSOLVER_SETUP);
 	{
 		PX_PROFILE_ZONE("PreIntegration", mContext.getContextId());
 		preIntegrationParallel(mDt, mBodyArray + mStartIndex, mOriginalBodyArray + mStartIndex, mNodeIndexArray + mStartIndex, mNumToIntegrate,
@@ -2887,6 +2897,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mDynamicsContext.getSimStats(), eSOLVER_SETUP);
 		createFinalizeContacts_Parallel(mSolverBodyData, mThreadContext, mDynamicsContext, mStartIndex, mEndIndex, mOutputs);
 	}
 
@@ -2937,6 +2948,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mDynamicsContext.getSimStats(), eSOLVER_SETUP);
 		const PxReal correlationDist = mDynamicsContext.getCorrelationDistance();
 		const PxReal bounceThreshold = mDynamicsContext.getBounceThreshold();
 		const PxReal frictionOffsetThreshold = mDynamicsContext.getFrictionOffsetThreshold();
@@ -2977,6 +2989,7 @@ public:
 
 void PxsSolverCreateFinalizeConstraintsTask::runInternal()
 {
+	PXV_SIM_PHASE_ZONE(&mContext.getSimStats(), eSOLVER_SETUP);
 	PX_PROFILE_ZONE("CreateConstraints", mContext.getContextId());
 	ThreadContext& mThreadContext = *mIslandContext.mThreadContext;
 	PxU32 descCount = mThreadContext.mNumDifferentBodyConstraints;
@@ -604,6 +604,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mContext.getSimStats(), eSOLVER_SETUP);
 		mContext.updatePostKinematic(mSimpleIslandManager, mCont, mLostTouchTask, mMaxArticulationLinks);
 		//Allow lost touch task to run once all tasks have be scheduled
 		mLostTouchTask->removeReference();
@@ -1779,6 +1780,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mContext.getSimStats(), eSOLVER);
 		PxU32 maxLinks = 0;
 		for (PxU32 i = 0; i < mNbDescs; i++)
 		{
@@ -1907,6 +1909,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mContext.getSimStats(), eSOLVER_SETUP);
 		mContext.setupDescs(mIslandContext, mObjects, mBodyRemapTable, mSolverBodyOffset, mOutputs);
 		mIslandContext.mArticulationOffset = mIslandContext.mThreadContext->contactDescArraySize;
 	}
@@ -1946,6 +1949,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mContext.getSimStats(), eSOLVER_SETUP);
 		PxU32 posIters = 0;
 		PxU32 velIters = 0;
 		mContext.preIntegrateBodies(mBodyArray, mOriginalBodyArray, mSolverBodyVelPool, mSolverBodyTxInertia, mSolverBodyDataPool2, mNodeIndexArray, mBodyCount, mGravity, mDt, posIters, velIters, 0);
@@ -1990,6 +1994,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mContext.getSimStats(), eSOLVER_SETUP);
 		const PxU32 BodiesPerTask = 512;
 
 		if (mBodyCount <= BodiesPerTask)
@@ -2047,6 +2052,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mContext.getSimStats(), eSOLVER_SETUP);
 		PxReal dt = mContext.getDt();
 
 		//ML: TGS can't work well with high velocity iteration counts, so we should limit the velocity iteration counts to be DY_MAX_ITERATION_COUNT. However,
@@ -2094,6 +2100,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mContext.getSimStats(), eSOLVER_SETUP);
 		PxU32 posIters = 0, velIters = 0;
 		mContext.setupArticulations(mIslandContext, mGravity, mDt, posIters, velIters, mCont);
 
@@ -2123,6 +2130,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mContext.getSimStats(), eSOLVER_SETUP);
 		mContext.setupArticulationInternalConstraints(mIslandContext, mDt, mIslandContext.mInvStepDt);
 	}
 };
@@ -2161,6 +2169,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mContext.getSimStats(), eSOLVER_SETUP);
 		ThreadContext* tempContext = mContext.getThreadContext();
 		tempContext->mConstraintBlockStream.reset();
 		mContext.createSolverConstraints(mContactDescPtr, mHeaders, mNbHeaders, mOutputs, mIslandThreadContext, *tempContext, mStepDt, mTotalDt, mInvStepDt,
@@ -2194,6 +2203,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mDynamicsContext.getSimStats(), eSOLVER_SETUP);
 		const PxReal correlationDist = mDynamicsContext.getCorrelationDistance();
 		const PxReal bounceThreshold = mDynamicsContext.getBounceThreshold();
 		const PxReal frictionOffsetThreshold = mDynamicsContext.getFrictionOffsetThreshold();
@@ -2267,6 +2277,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mContext.getSimStats(), eSOLVER_SETUP);
 		Dy::ThreadContext& threadContext = *mIslandContext.mThreadContext;
 		const PxU32 nbBatches = threadContext.numContactConstraintBatches;
 		PxConstraintBatchHeader* hdr = mIslandContext.mObjects.constraintBatchHeaders;
@@ -2331,6 +2342,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mContext.getSimStats(), eSOLVER_SETUP);
 	
 		ArticulationSolverDesc* artics = mThreadContext.getArticulations().begin();
 
@@ -2475,6 +2487,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mContext.getSimStats(), eSOLVER);
 		mContext.iterativeSolveIslandParallel(mObjects, mCounts, mThreadContext, mIslandContext.mStepDt, mIslandContext.mPosIters, mIslandContext.mVelIters,
 			&mIslandContext.mSharedSolverIndex, &mIslandContext.mSharedRigidBodyIndex, &mIslandContext.mSharedArticulationIndex,
 			&mIslandContext.mSolvedCount, &mIslandContext.mRigidBodyIntegratedCount, &mIslandContext.mArticulationIntegratedCount,
@@ -2506,6 +2519,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mContext.getSimStats(), eSOLVER);
 
 		PxU32 j = 0, i = 0;
 
@@ -2681,6 +2695,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mContext.getSimStats(), eINTEGRATION);
 		mContext.endIsland(mThreadContext);
 	}
 };
@@ -2708,6 +2723,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mContext.getSimStats(), eINTEGRATION);
 		mContext.finishSolveIsland(mThreadContext, mObjects, mCounts, mIslandManager, mCont);
 	}
 };
@@ -3249,6 +3265,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mContext.getSimStats(), eINTEGRATION);
 		mContext.copyBackBodies(mObjects, mVels, mTxInertias, mSolverBodyDatas, mInvDt, mIslandSim, mStartIdx, mEndIdx);
 	}
 };
@@ -3275,6 +3292,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mContext.getSimStats(), eINTEGRATION);
 		mContext.updateArticulations(mThreadContext, mStartIdx, mEndIdx, mDt);
 	}
 };
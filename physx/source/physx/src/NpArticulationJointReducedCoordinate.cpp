@@ -51,8 +51,8 @@ namespace physx
 		context.translatePxBase(mParent);
 		context.translatePxBase(mChild);
 		mCore.setRoot(this);
-		NpArticulationReducedCoordinate* articulation = static_cast<NpArticulationReducedCoordinate*>(&mParent->getRoot());
-		mCore.setArticulation(&articulation->getCore());
+		// PT: the articulation core is set by NpArticulationReducedCoordinate::resolveReferences(). The parent link
+		// might not have been deserialized yet, so we cannot use its root here.
 	}
 
 	//~PX_SERIALIZATION
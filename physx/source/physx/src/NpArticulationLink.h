@@ -130,6 +130,7 @@ public:
 	PX_INLINE	const NpArticulationLink*					getParent()	const	{ return mParent; }
 
 	PX_INLINE	void						setInboundJoint(PxArticulationJointReducedCoordinate& joint) { mInboundJoint = &joint; }
+	PX_INLINE	PxArticulationJointReducedCoordinate*		getInboundJointInternal()	const	{ return mInboundJoint; }
 			
 	void 									setGlobalPoseInternal(const PxTransform& pose, bool autowake);
 	void									setLLIndex(const PxU32 index) { mLLIndex = index; }
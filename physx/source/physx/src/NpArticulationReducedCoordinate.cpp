@@ -804,6 +804,11 @@ void NpArticulationReducedCoordinate::resolveReferences(PxDeserializationContext
 	{
 		NpArticulationLink*& link = mArticulationLinks[i];
 		context.translatePxBase(link);
+
+		// links and their inbound joints are required by the articulation, so they have been deserialized already
+		NpArticulationJointReducedCoordinate* joint = static_cast<NpArticulationJointReducedCoordinate*>(link->getInboundJointInternal());
+		if(joint)
+			joint->getCore().setArticulation(&mCore);
 	}
 
 	const PxU32 nbSensors = mSensors.size();
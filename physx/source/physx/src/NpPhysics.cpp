@@ -161,7 +161,7 @@ NpPhysics::NpPhysics(const PxTolerancesScale& scale, const PxvOffsetTable& pxvOf
 			NpOmniPvd* npOmniPvd = static_cast<NpOmniPvd*>(mOmniPvd);
 			NpOmniPvd::incRefCount();
 			npOmniPvd->mPhysXSampler = mOmniPvdSampler; // Dirty hack to do startSampling from PxOmniPvd
-			mOmniPvdSampler->setOmniPvdWriter(omniPvd->getWriter());
+			mOmniPvdSampler->setOmniPvdWriter(omniPvd->getWriter(), npOmniPvd->supportsBulkAttributes());
 		}
 	}
 #else
@@ -1450,6 +1450,11 @@ PxTriangleMesh* NpPhysics::createTriangleMesh(PxInputStream& stream)
 	return NpFactory::getInstance().createTriangleMesh(stream);
 }
 
+PxTriangleMesh* NpPhysics::createTriangleMeshInPlace(const void* memory, PxU32 size)
+{
+	return NpFactory::getInstance().createTriangleMeshInPlace(memory, size);
+}
+
 PxU32 NpPhysics::getNbTriangleMeshes() const
 {
 	return NpFactory::getInstance().getNbTriangleMeshes();
@@ -1557,7 +1562,7 @@ PxParticleRigidBuffer* NpPhysics::createParticleRigidBuffer(PxU32 maxParticles,
 
 ///////////////////////////////////////////////////////////////////////////////
 
-PxPruningStructure* NpPhysics::createPruningStructure(PxRigidActor*const* actors, PxU32 nbActors)
+static PxPruningStructure* createPruningStructureInternal(PxRigidActor*const* actors, PxU32 nbActors, PxCpuDispatcher* dispatcher)
 {
 	PX_SIMD_GUARD;
 
@@ -1565,13 +1570,23 @@ PxPruningStructure* NpPhysics::createPruningStructure(PxRigidActor*const* actors
 	PX_ASSERT(nbActors > 0);
 
 	Sq::PruningStructure* ps = PX_NEW(Sq::PruningStructure)();	
-	if(!ps->build(actors, nbActors))
+	if(!ps->build(actors, nbActors, dispatcher))
 	{
 		PX_DELETE(ps);		
 	}
 	return ps;
 }
 
+PxPruningStructure* NpPhysics::createPruningStructure(PxRigidActor*const* actors, PxU32 nbActors)
+{
+	return createPruningStructureInternal(actors, nbActors, NULL);
+}
+
+PxPruningStructure* NpPhysics::createPruningStructure(PxRigidActor*const* actors, PxU32 nbActors, PxCpuDispatcher& dispatcher)
+{
+	return createPruningStructureInternal(actors, nbActors, &dispatcher);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 #if PX_SUPPORT_GPU_PHYSX
@@ -189,6 +189,7 @@ public:
 	virtual		PxU32						getCustomMaterials(PxCustomMaterial** userBuffer, PxU32 bufferSize, PxU32 startIndex = 0) const	PX_OVERRIDE;
 
 	virtual		PxTriangleMesh*				createTriangleMesh(PxInputStream&)	PX_OVERRIDE;
+	virtual		PxTriangleMesh*				createTriangleMeshInPlace(const void* memory, PxU32 size)	PX_OVERRIDE;
 	virtual		PxU32						getNbTriangleMeshes()	const	PX_OVERRIDE;
 	virtual		PxU32						getTriangleMeshes(PxTriangleMesh** userBuffer, PxU32 bufferSize, PxU32 startIndex=0)	const	PX_OVERRIDE;
 
@@ -224,6 +225,7 @@ public:
 #endif
 
 	virtual		PxPruningStructure*			createPruningStructure(PxRigidActor*const* actors, PxU32 nbActors)	PX_OVERRIDE;
+	virtual		PxPruningStructure*			createPruningStructure(PxRigidActor*const* actors, PxU32 nbActors, PxCpuDispatcher& dispatcher)	PX_OVERRIDE;
 
 	virtual		const PxTolerancesScale&	getTolerancesScale() const	PX_OVERRIDE;
 
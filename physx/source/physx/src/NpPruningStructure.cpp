@@ -120,7 +120,7 @@ static void getShapeBounds(PxRigidActor* actor, bool dynamic, PxBounds3* bounds,
 }
 
 //////////////////////////////////////////////////////////////////////////
-bool PruningStructure::build(PxRigidActor*const* actors, PxU32 nbActors)
+bool PruningStructure::build(PxRigidActor*const* actors, PxU32 nbActors, PxCpuDispatcher* dispatcher)
 {
 	PX_ASSERT(actors);
 	PX_ASSERT(nbActors > 0);
@@ -226,7 +226,9 @@ bool PruningStructure::build(PxRigidActor*const* actors, PxU32 nbActors)
 		{
 			// create the AABB tree
 			NodeAllocator nodeAllocator;
-			bool status = aabbTrees[i].build(AABBTreeBuildParams(PS_NB_OBJECTS_PER_NODE, numShapes[i], &bounds[i]), nodeAllocator);
+			AABBTreeBuildParams params(PS_NB_OBJECTS_PER_NODE, numShapes[i], &bounds[i]);
+			params.mDispatcher = dispatcher;
+			bool status = aabbTrees[i].build(params, nodeAllocator);
 
 			PX_UNUSED(status);
 			PX_ASSERT(status);
@@ -38,6 +38,8 @@
 
 namespace physx
 {
+	class PxCpuDispatcher;
+
 	namespace Sq
 	{
 		class PruningStructure : public PxPruningStructure, public PxUserAllocated
@@ -65,7 +67,7 @@ namespace physx
 													PruningStructure();
 			virtual									~PruningStructure();
 
-							bool					build(PxRigidActor*const* actors, PxU32 nbActors);			
+							bool					build(PxRigidActor*const* actors, PxU32 nbActors, PxCpuDispatcher* dispatcher);			
 
 			PX_FORCE_INLINE	PxU32					getNbActors()				const	{ return mNbActors;	}
 			PX_FORCE_INLINE	PxActor*const*			getActors()					const	{ return mActors;	}
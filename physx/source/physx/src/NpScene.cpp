@@ -3009,6 +3009,8 @@ bool NpScene::simulateOrCollide(PxReal elapsedTime, PxBaseTask* completionTask,
 		PX_CHECK_AND_RETURN_VAL((size_t(scratchBlock)&15) == 0, "PxScene::simulate: scratch block must be 16-byte aligned!", false);
 	
 		PX_CHECK_AND_RETURN_VAL((scratchBlockSize&16383) == 0, "PxScene::simulate: scratch block size must be a multiple of 16K", false);
+
+		mScene.getLowLevelContext()->getSimStats().mTimers.startStep();
 	
 #if PX_SUPPORT_PVD		
 		//signal the frame is starting.	
@@ -4851,5 +4853,7 @@ void NpScene::createInOmniPVD(const PxSceneDesc& desc)
 	OMNI_PVD_SET(scene, gpuMaxNumStaticPartitions, static_cast<PxScene&>(*this), desc.gpuMaxNumStaticPartitions)
 	OMNI_PVD_SET(scene, gpuComputeVersion, static_cast<PxScene&>(*this), desc.gpuComputeVersion)
 	OMNI_PVD_SET(scene, contactPairSlabSize, static_cast<PxScene&>(*this), desc.contactPairSlabSize)
+	OMNI_PVD_SET(scene, taskPoolChunkSize, static_cast<PxScene&>(*this), desc.taskPoolChunkSize)
+	OMNI_PVD_SET(scene, taskPoolSize, static_cast<PxScene&>(*this), desc.taskPoolSize)
 	OMNI_PVD_SET(scene, tolerancesScale, static_cast<PxScene&>(*this), desc.getTolerancesScale())
 }
@@ -358,6 +358,12 @@ class NpScene : public NpSceneAccessor, public PxUserAllocated
 														PxOverlapCallback& hitCall, 
 														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
 														const PxQueryCache* cache, PxGeometryQueryFlags flags) const;
+
+	virtual			bool							cull(
+														PxU32 nbPlanes, const PxPlane* planes,	// Culling volume
+														PxOverlapCallback& hitCall,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags) const;
 	//~PxSceneQuerySystemBase
 
 	// PxSceneSQSystem
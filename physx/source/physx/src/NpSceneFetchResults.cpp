@@ -45,6 +45,7 @@
 #include "ScArticulationTendonSim.h"
 #include "CmCollection.h"
 #include "PxsSimulationController.h"
+#include "PxsContext.h"
 #include "common/PxProfileZone.h"
 #include "BpBroadPhase.h"
 #include "BpAABBManagerBase.h"
@@ -156,7 +157,10 @@ void NpScene::fetchResultsPostContactCallbacks()
 {
 	mScene.postCallbacksPreSync();
 
-	syncSQ();
+	{
+		PXV_SIM_PHASE_ZONE(&mScene.getLowLevelContext()->getSimStats(), eSCENE_QUERY_UPDATE);
+		syncSQ();
+	}
 
 #if PX_SUPPORT_PVD
 	mScenePvdClient.updateSceneQueries();
@@ -233,6 +237,7 @@ bool NpScene::fetchResults(bool block, PxU32* errorState)
 		// PT: TODO: why do we want to show it in the cross thread view?
 		PX_PROFILE_START_CROSSTHREAD("Basic.fetchResults", getContextId());
 		PX_PROFILE_ZONE("Sim.fetchResults", getContextId());
+		PXV_SIM_PHASE_ZONE(&mScene.getLowLevelContext()->getSimStats(), eFETCH_RESULTS);
 
 		fetchResultsPreContactCallbacks();
 
@@ -256,112 +261,7 @@ bool NpScene::fetchResults(bool block, PxU32* errorState)
 		if (omniPvdSampler && omniPvdSampler->isSampling())
 		{
 			//send all xforms updated by the sim:
-			PxU32 nActiveActors;
-			PxActor ** activeActors = mScene.getActiveActors(nActiveActors);
-			while (nActiveActors--)
-			{
-				PxActor * a = *activeActors++;
-				if ((a->getType() == PxActorType::eRIGID_STATIC) || (a->getType() == PxActorType::eRIGID_DYNAMIC))
-				{
-					PxRigidActor* ra = static_cast<PxRigidActor*>(a);
-					PxTransform t = ra->getGlobalPose();
-					OMNI_PVD_SET(actor, translation, *a, t.p)
-					OMNI_PVD_SET(actor, rotation, *a, t.q)
-
-					if (a->getType() == PxActorType::eRIGID_DYNAMIC)
-					{
-						PxRigidDynamic* rdyn = static_cast<PxRigidDynamic*>(a);
-						
-						const PxVec3 linVel = rdyn->getLinearVelocity();
-						OMNI_PVD_SET(actor, linearVelocity, *a, linVel)
-
-						const PxVec3 angVel = rdyn->getAngularVelocity();
-						OMNI_PVD_SET(actor, angularVelocity, *a, angVel)
-
-						const PxRigidBodyFlags rFlags = rdyn->getRigidBodyFlags();
-						OMNI_PVD_SET(actor, rigidBodyFlags, *a, rFlags)
-					}
-					
-				}
-				else if (a->getType() == PxActorType::eARTICULATION_LINK)
-				{
-					PxArticulationLink* pxArticulationParentLink = 0;
-					PxArticulationLink* pxArticulationLink = static_cast<PxArticulationLink*>(a);
-					PxArticulationJointReducedCoordinate* pxArticulationJoint = pxArticulationLink->getInboundJoint();
-					if (pxArticulationJoint)
-					{
-						pxArticulationParentLink = &(pxArticulationJoint->getParentArticulationLink());
-
-						PxArticulationJointReducedCoordinate & jcord = *pxArticulationJoint;
-						PxReal vals[6];
-						for (PxU32 ax = 0; ax < 6; ++ax)
-							vals[ax] = jcord.getJointPosition(static_cast<PxArticulationAxis::Enum>(ax));
-						OMNI_PVD_SETB(articulationjoint, jointPosition, jcord, vals, sizeof(vals));
-						for (PxU32 ax = 0; ax < 6; ++ax)
-							vals[ax] = jcord.getJointVelocity(static_cast<PxArticulationAxis::Enum>(ax));
-						OMNI_PVD_SETB(articulationjoint, jointVelocity, jcord, vals, sizeof(vals));
-					}
-
-					physx::PxTransform TArtLinkLocal;
-					if (pxArticulationParentLink)
-					{
-						// TGlobal = TFatherGlobal * TLocal
-						// Inv(TFatherGlobal)* TGlobal = Inv(TFatherGlobal)*TFatherGlobal * TLocal
-						// Inv(TFatherGlobal)* TGlobal = TLocal
-						// TLocal = Inv(TFatherGlobal) * TGlobal
-						//physx::PxTransform TParentGlobal = pxArticulationParentLink->getGlobalPose();
-						physx::PxTransform TParentGlobalInv = pxArticulationParentLink->getGlobalPose().getInverse();
-						physx::PxTransform TArtLinkGlobal = pxArticulationLink->getGlobalPose();
-						TArtLinkLocal = TParentGlobalInv * TArtLinkGlobal;
-					}
-					else {
-						TArtLinkLocal = pxArticulationLink->getGlobalPose();
-						OMNI_PVD_SET(articulation, worldBounds, pxArticulationLink->getArticulation(), pxArticulationLink->getArticulation().getWorldBounds());
-					}
-					OMNI_PVD_SET(actor, translation, *a, TArtLinkLocal.p)
-					OMNI_PVD_SET(actor, rotation, *a, TArtLinkLocal.q)
-					
-					const PxVec3 linVel = pxArticulationLink->getLinearVelocity();
-					OMNI_PVD_SET(actor, linearVelocity, *a, linVel)
-
-					const PxVec3 angVel = pxArticulationLink->getAngularVelocity();
-					OMNI_PVD_SET(actor, angularVelocity, *a, angVel)
-
-					const PxRigidBodyFlags rFlags = pxArticulationLink->getRigidBodyFlags();
-					OMNI_PVD_SET(actor, rigidBodyFlags, *a, rFlags)
-				}
-
-				const PxBounds3 worldBounds = a->getWorldBounds();
-				OMNI_PVD_SET(actor, worldBounds, *a, worldBounds)
-
-				// update active actors' joints
-				const PxRigidActor* ra = a->is<PxRigidActor>();
-				if (ra)
-				{
-					static const PxU32 MAX_CONSTRAINTS = 32;
-					PxConstraint* constraints[MAX_CONSTRAINTS];
-					PxU32 index = 0;
-					while (true)
-					{
-						PxU32 count = ra->getConstraints(constraints, MAX_CONSTRAINTS, index);
-						for (PxU32 i = 0; i < count; ++i)
-						{
-							const NpConstraint& c = static_cast<const NpConstraint&>(*constraints[i]);
-							PxRigidActor *ra0, *ra1; c.getActors(ra0, ra1);
-							bool ra0static = !ra0 || !!ra0->is<PxRigidStatic>(), ra1static = !ra1 || !!ra1->is<PxRigidStatic>();
-							// this check is to not update a joint twice
-							if ((ra == ra0 && (ra1static || ra0 > ra1)) || (ra == ra1 && (ra0static || ra1 > ra0)))
-								c.getCore().getPxConnector()->updateOmniPvdProperties();
-						}
-						if (count == MAX_CONSTRAINTS)
-						{
-							index += MAX_CONSTRAINTS;
-							continue;
-						}
-						break;
-					}
-				}
-			}
+			omniPvdSampler->streamActiveActors(this);
 
 			// send contacts info
 			omniPvdSampler->streamSceneContacts(this);
@@ -372,6 +272,8 @@ bool NpScene::fetchResults(bool block, PxU32* errorState)
 #endif
 	}
 
+	mScene.getLowLevelContext()->getSimStats().mTimers.endStep();
+
 #if PX_SUPPORT_PVD
 	{
 		PX_SIMD_GUARD;
@@ -395,6 +297,7 @@ bool NpScene::fetchResultsStart(const PxContactPairHeader*& contactPairs, PxU32&
 	// we use cross thread profile here, to show the event in cross thread view
 	PX_PROFILE_START_CROSSTHREAD("Basic.fetchResults", getContextId());
 	PX_PROFILE_ZONE("Sim.fetchResultsStart", getContextId());
+	PXV_SIM_PHASE_ZONE(&mScene.getLowLevelContext()->getSimStats(), eFETCH_RESULTS);
 
 	fetchResultsPreContactCallbacks();
 
@@ -470,6 +373,7 @@ void NpScene::fetchResultsFinish(PxU32* errorState)
 		PX_SIMD_GUARD;
 		PX_PROFILE_STOP_CROSSTHREAD("Basic.processCallbacks", getContextId());
 		PX_PROFILE_ZONE("Basic.fetchResultsFinish", getContextId());
+		PXV_SIM_PHASE_ZONE(&mScene.getLowLevelContext()->getSimStats(), eFETCH_RESULTS);
 
 		mBetweenFetchResults = false;
 		NP_WRITE_CHECK(this);
@@ -490,6 +394,8 @@ void NpScene::fetchResultsFinish(PxU32* errorState)
 #endif
 	}
 
+	mScene.getLowLevelContext()->getSimStats().mTimers.endStep();
+
 #if PX_SUPPORT_PVD
 	mScenePvdClient.frameEnd();
 #endif
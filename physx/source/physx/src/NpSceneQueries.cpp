@@ -402,6 +402,14 @@ namespace
 			return mQueries._overlap( geometry, transform, hitCall, filterData, filterCall, cache, flags);
 		}
 
+		virtual		bool				cull(	PxU32 nbPlanes, const PxPlane* planes,
+												PxOverlapCallback& hitCall,
+												const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+												PxGeometryQueryFlags flags) const
+		{
+			return mQueries._cull(nbPlanes, planes, hitCall, filterData, filterCall, flags);
+		}
+
 		virtual	PxSQPrunerHandle		getHandle(const PxRigidActor& actor, const PxShape& shape, PxU32& prunerIndex)	const
 		{
 			const NpActor& npActor = NpActor::getFromPxActor(actor);
@@ -460,7 +468,18 @@ static BVHBuildStrategy getBuildStrategy(PxBVHBuildStrategy::Enum bs)
 	return BVH_SPLATTER_POINTS;
 }
 
-static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDynamicTreeSecondaryPruner::Enum secondaryType, PxBVHBuildStrategy::Enum buildStrategy, PxU32 nbObjectsPerNode)
+static BVHNodeWidth getNodeWidth(PxBVHNodeWidth::Enum nw)
+{
+	switch(nw)
+	{
+		case PxBVHNodeWidth::eBINARY:	return BVH_BINARY;
+		case PxBVHNodeWidth::eWIDE_4:	return BVH_WIDE_4;
+		case PxBVHNodeWidth::eWIDE_8:	return BVH_WIDE_8;
+	}
+	return BVH_BINARY;
+}
+
+static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDynamicTreeSecondaryPruner::Enum secondaryType, PxBVHBuildStrategy::Enum buildStrategy, PxU32 nbObjectsPerNode, PxBVHNodeWidth::Enum nodeWidth)
 {
 	// PT: to force testing the bucket pruner
 //	return createBucketPruner(contextID);
@@ -468,13 +487,14 @@ static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDyna
 
 	const CompanionPrunerType cpType = getCompanionType(secondaryType);
 	const BVHBuildStrategy bs = getBuildStrategy(buildStrategy);
+	const BVHNodeWidth nw = getNodeWidth(nodeWidth);
 
 	Pruner* pruner = NULL;
 	switch(type)
 	{
 		case PxPruningStructureType::eNONE:					{ pruner = createBucketPruner(contextID);										break;	}
-		case PxPruningStructureType::eDYNAMIC_AABB_TREE:	{ pruner = createAABBPruner(contextID, true, cpType, bs, nbObjectsPerNode);		break;	}
-		case PxPruningStructureType::eSTATIC_AABB_TREE:		{ pruner = createAABBPruner(contextID, false, cpType, bs, nbObjectsPerNode);	break;	}
+		case PxPruningStructureType::eDYNAMIC_AABB_TREE:	{ pruner = createAABBPruner(contextID, true, cpType, bs, nbObjectsPerNode, nw);		break;	}
+		case PxPruningStructureType::eSTATIC_AABB_TREE:		{ pruner = createAABBPruner(contextID, false, cpType, bs, nbObjectsPerNode, nw);	break;	}
 		// PT: for tests
 		case PxPruningStructureType::eLAST:					{ pruner = createIncrementalPruner(contextID);									break;	}
 //		case PxPruningStructureType::eLAST:					break;
@@ -491,8 +511,8 @@ static PxSceneQuerySystem* getPxSQ(const PxSceneDesc& desc, PVDCapture* pvd, PxU
 	}
 	else
 	{
-		Pruner* staticPruner = create(desc.staticStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.staticBVHBuildStrategy, desc.staticNbObjectsPerNode);
-		Pruner* dynamicPruner = create(desc.dynamicStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.dynamicBVHBuildStrategy, desc.dynamicNbObjectsPerNode);
+		Pruner* staticPruner = create(desc.staticStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.staticBVHBuildStrategy, desc.staticNbObjectsPerNode, desc.staticBVHNodeWidth);
+		Pruner* dynamicPruner = create(desc.dynamicStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.dynamicBVHBuildStrategy, desc.dynamicNbObjectsPerNode, desc.dynamicBVHNodeWidth);
 		return PX_NEW(InternalPxSQ)(desc, pvd, contextID, staticPruner, dynamicPruner);
 	}
 }
@@ -553,6 +573,14 @@ bool NpScene::overlap(
 	return mNpSQ.mSQ->overlap(geometry, pose, hits, filterData, filterCall, cache, flags);
 }
 
+bool NpScene::cull(
+	PxU32 nbPlanes, const PxPlane* planes, PxOverlapCallback& hits,
+	const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall, PxGeometryQueryFlags flags) const
+{
+	NP_READ_CHECK(this);
+	return mNpSQ.mSQ->cull(nbPlanes, planes, hits, filterData, filterCall, flags);
+}
+
 bool NpScene::sweep(
 	const PxGeometry& geometry, const PxTransform& pose, const PxVec3& unitDir, const PxReal distance,
 	PxHitCallback<PxSweepHit>& hits, PxHitFlags hitFlags, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
@@ -679,6 +679,8 @@ void PvdMetaDataBinding::sendAllProperties(PvdDataStream& inStream, const PxScen
 //		PxU32 GpuComputeVersion;
 //		PxReal BroadPhaseInflation;
 //		PxU32 ContactPairSlabSize;
+//		PxU32 TaskPoolChunkSize;
+//		PxU32 TaskPoolSize;
 	}
 
 	PxSceneDescGeneratedValues theValues(&theDesc);
@@ -176,6 +176,15 @@ namespace physx
 #endif
 	}
 
+	bool NpOmniPvd::supportsBulkAttributes() const
+	{
+#if PX_SUPPORT_OMNI_PVD
+		return mLoader && mLoader->supportsBulkAttributes();
+#else
+		return false;
+#endif
+	}
+
 	bool NpOmniPvd::startSampling()
 	{
 #if PX_SUPPORT_OMNI_PVD
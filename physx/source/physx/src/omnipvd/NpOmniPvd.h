@@ -53,6 +53,7 @@ public:
 	bool initOmniPvd();
 	OmniPvdWriter* getWriter();
 	OmniPvdFileWriteStream* getFileWriteStream();
+	bool supportsBulkAttributes() const;
 	bool startSampling();
 	
 	OmniPvdLoader* mLoader;
@@ -45,6 +45,8 @@
 #include "foundation/PxAllocator.h"
 #include "ScInteraction.h"
 #include "NpArticulationJointReducedCoordinate.h"
+#include "NpConstraint.h"
+#include "foundation/PxArray.h"
 
 #include <stdio.h>
 
@@ -62,13 +64,92 @@ public:
 	~OmniPvdStreamContainer();
 	bool initOmniPvd();
 	void registerClasses();
-	void setOmniPvdWriter(OmniPvdWriter* omniPvdWriter);
+	void setOmniPvdWriter(OmniPvdWriter* omniPvdWriter, bool supportsBulkAttributes);
 
 	OmniPvdWriter* mWriter;
+	bool mSupportsBulkAttributes;
 	physx::PxMutex mMutex;
 	bool mClassesRegistered;
 };
 
+// Attributes written for every active actor at the end of each simulation step. They are batched into one bulk
+// command per attribute, and a value is only sent again once it differs from the last one sent for the object.
+enum OmniPvdBulkAttributeEnum
+{
+	eOmniPvdBulkTranslation,
+	eOmniPvdBulkRotation,
+	eOmniPvdBulkLinearVelocity,
+	eOmniPvdBulkAngularVelocity,
+	eOmniPvdBulkRigidBodyFlags,
+	eOmniPvdBulkWorldBounds,
+	eOmniPvdBulkJointPosition,
+	eOmniPvdBulkJointVelocity,
+	eOmniPvdBulkCount
+};
+
+class OmniPvdBulkAttribute
+{
+public:
+	static const physx::PxU32 MAX_NB_BYTES = 24;
+	struct Value
+	{
+		physx::PxU8 mBytes[MAX_NB_BYTES];
+	};
+
+	OmniPvdBulkAttribute() : mHandle(0), mNbBytes(0) {}
+
+	void setup(OmniPvdAttributeHandle handle, physx::PxU32 nbBytes)
+	{
+		PX_ASSERT(nbBytes <= MAX_NB_BYTES);
+		mHandle = handle;
+		mNbBytes = nbBytes;
+		mObjects.clear();
+		mData.clear();
+		mLastSent.clear();
+	}
+
+	void add(OmniPvdObjectHandle object, const void* value)
+	{
+		PX_ASSERT(mNbBytes);
+		const physx::PxHashMap<OmniPvdObjectHandle, Value>::Entry* entry = mLastSent.find(object);
+		if (entry && !memcmp(entry->second.mBytes, value, mNbBytes))
+		{
+			return;
+		}
+		physx::PxMemCopy(mLastSent[object].mBytes, value, mNbBytes);
+		mObjects.pushBack(object);
+		const physx::PxU32 offset = mData.size();
+		mData.resizeUninitialized(offset + mNbBytes);
+		physx::PxMemCopy(mData.begin() + offset, value, mNbBytes);
+	}
+
+	void send(OmniPvdWriter* writer, bool supportsBulkAttributes)
+	{
+		if (mObjects.size())
+		{
+			if (supportsBulkAttributes)
+			{
+				writer->setBulkAttributeShallow(UNNECESSARY_SCENE_HANDLE, mHandle, mObjects.begin(), mObjects.size(), mData.begin(), mNbBytes);
+			}
+			else
+			{
+				for (physx::PxU32 i = 0; i < mObjects.size(); i++)
+				{
+					writer->setAttributeShallow(UNNECESSARY_SCENE_HANDLE, mObjects[i], mHandle, mData.begin() + i * mNbBytes, mNbBytes);
+				}
+			}
+			mObjects.clear();
+			mData.clear();
+		}
+	}
+
+	OmniPvdAttributeHandle mHandle;
+	physx::PxU32 mNbBytes;
+	physx::PxArray<OmniPvdObjectHandle> mObjects;
+	physx::PxArray<physx::PxU8> mData;
+	physx::PxHashMap<OmniPvdObjectHandle, Value> mLastSent;
+};
+
 class OmniPvdSamplerInternals : public physx::PxUserAllocated
 {
 public:
@@ -82,6 +163,12 @@ physx::PxHashMap<physx::NpScene*, OmniPvdPxScene*> mSampledScenes;
 
 physx::PxMutex mSharedGeomsMutex;
 physx::PxHashMap<const void*, OmniPvdSharedMeshEnum> mSharedMeshesMap;
+
+void setupBulkAttributes();
+void invalidateBulkAttribute(OmniPvdAttributeHandle attributeHandle, OmniPvdObjectHandle objectHandle);
+void invalidateBulkAttributes(OmniPvdObjectHandle objectHandle);
+physx::PxMutex mBulkAttributesMutex;
+OmniPvdBulkAttribute mBulkAttributes[eOmniPvdBulkCount];
 };
 OmniPvdSamplerInternals * samplerInternals = NULL;
 
@@ -104,6 +191,7 @@ OmniPvdStreamContainer::OmniPvdStreamContainer()
 {
 	physx::PxMutex::ScopedLock myLock(mMutex);
 	mWriter = NULL;
+	mSupportsBulkAttributes = false;
 	mClassesRegistered = false;
 }
 
@@ -111,9 +199,10 @@ OmniPvdStreamContainer::~OmniPvdStreamContainer()
 {
 }
 
-void OmniPvdStreamContainer::setOmniPvdWriter(OmniPvdWriter* omniPvdWriter)
+void OmniPvdStreamContainer::setOmniPvdWriter(OmniPvdWriter* omniPvdWriter, bool supportsBulkAttributes)
 {
 	mWriter = omniPvdWriter;
+	mSupportsBulkAttributes = supportsBulkAttributes;
 }
 
 bool OmniPvdStreamContainer::initOmniPvd()
@@ -847,6 +936,7 @@ void OmniPvdPxSampler::startSampling()
 	}
 	if (samplerInternals->mPvdStream.initOmniPvd())
 	{
+		samplerInternals->setupBulkAttributes();
 		samplerInternals->mIsSampling = true;
 	}
 }
@@ -858,9 +948,9 @@ bool OmniPvdPxSampler::isSampling()
 	return samplerInternals->mIsSampling;
 }
 
-void OmniPvdPxSampler::setOmniPvdWriter(OmniPvdWriter* omniPvdWriter)
+void OmniPvdPxSampler::setOmniPvdWriter(OmniPvdWriter* omniPvdWriter, bool supportsBulkAttributes)
 {
-	samplerInternals->mPvdStream.setOmniPvdWriter(omniPvdWriter);
+	samplerInternals->mPvdStream.setOmniPvdWriter(omniPvdWriter, supportsBulkAttributes);
 }
 
 void createGeometry(const physx::PxGeometry & pxGeom)
@@ -953,6 +1043,162 @@ void destroyGeometry(const physx::PxGeometry & pxGeom)
 	}
 }
 
+void OmniPvdSamplerInternals::setupBulkAttributes()
+{
+	physx::PxMutex::ScopedLock myLock(mBulkAttributesMutex);
+	mBulkAttributes[eOmniPvdBulkTranslation].setup(OmniPvdPxSampler::attributeHandle_actor_translation, sizeof(PxVec3));
+	mBulkAttributes[eOmniPvdBulkRotation].setup(OmniPvdPxSampler::attributeHandle_actor_rotation, sizeof(PxQuat));
+	mBulkAttributes[eOmniPvdBulkLinearVelocity].setup(OmniPvdPxSampler::attributeHandle_actor_linearVelocity, sizeof(PxVec3));
+	mBulkAttributes[eOmniPvdBulkAngularVelocity].setup(OmniPvdPxSampler::attributeHandle_actor_angularVelocity, sizeof(PxVec3));
+	mBulkAttributes[eOmniPvdBulkRigidBodyFlags].setup(OmniPvdPxSampler::attributeHandle_actor_rigidBodyFlags, sizeof(PxRigidBodyFlags));
+	mBulkAttributes[eOmniPvdBulkWorldBounds].setup(OmniPvdPxSampler::attributeHandle_actor_worldBounds, sizeof(PxBounds3));
+	mBulkAttributes[eOmniPvdBulkJointPosition].setup(OmniPvdPxSampler::attributeHandle_articulationjoint_jointPosition, sizeof(PxReal) * 6);
+	mBulkAttributes[eOmniPvdBulkJointVelocity].setup(OmniPvdPxSampler::attributeHandle_articulationjoint_jointVelocity, sizeof(PxReal) * 6);
+}
+
+// A value sent outside of the bulk commands, e.g. by a user call, makes the last value sent in bulk stale
+void OmniPvdSamplerInternals::invalidateBulkAttribute(OmniPvdAttributeHandle attributeHandle, OmniPvdObjectHandle objectHandle)
+{
+	for (PxU32 i = 0; i < eOmniPvdBulkCount; i++)
+	{
+		if (mBulkAttributes[i].mHandle && (mBulkAttributes[i].mHandle == attributeHandle))
+		{
+			physx::PxMutex::ScopedLock myLock(mBulkAttributesMutex);
+			mBulkAttributes[i].mLastSent.erase(objectHandle);
+			return;
+		}
+	}
+}
+
+// Object handles are addresses, so a destroyed object's handle can be reused by a new object
+void OmniPvdSamplerInternals::invalidateBulkAttributes(OmniPvdObjectHandle objectHandle)
+{
+	physx::PxMutex::ScopedLock myLock(mBulkAttributesMutex);
+	for (PxU32 i = 0; i < eOmniPvdBulkCount; i++)
+	{
+		mBulkAttributes[i].mLastSent.erase(objectHandle);
+	}
+}
+
+void OmniPvdPxSampler::streamActiveActors(physx::NpScene* scene)
+{
+	if (!isSampling()) return;
+	physx::PxMutex::ScopedLock myLock(samplerInternals->mBulkAttributesMutex);
+	OmniPvdBulkAttribute* bulk = samplerInternals->mBulkAttributes;
+
+	//send all xforms updated by the sim:
+	PxU32 nActiveActors;
+	PxActor ** activeActors = scene->getScScene().getActiveActors(nActiveActors);
+	while (nActiveActors--)
+	{
+		PxActor * a = *activeActors++;
+		const OmniPvdObjectHandle objectHandle = OmniPvdObjectHandle(a);
+		if ((a->getType() == PxActorType::eRIGID_STATIC) || (a->getType() == PxActorType::eRIGID_DYNAMIC))
+		{
+			PxRigidActor* ra = static_cast<PxRigidActor*>(a);
+			PxTransform t = ra->getGlobalPose();
+			bulk[eOmniPvdBulkTranslation].add(objectHandle, &t.p);
+			bulk[eOmniPvdBulkRotation].add(objectHandle, &t.q);
+
+			if (a->getType() == PxActorType::eRIGID_DYNAMIC)
+			{
+				PxRigidDynamic* rdyn = static_cast<PxRigidDynamic*>(a);
+
+				const PxVec3 linVel = rdyn->getLinearVelocity();
+				bulk[eOmniPvdBulkLinearVelocity].add(objectHandle, &linVel);
+
+				const PxVec3 angVel = rdyn->getAngularVelocity();
+				bulk[eOmniPvdBulkAngularVelocity].add(objectHandle, &angVel);
+
+				const PxRigidBodyFlags rFlags = rdyn->getRigidBodyFlags();
+				bulk[eOmniPvdBulkRigidBodyFlags].add(objectHandle, &rFlags);
+			}
+		}
+		else if (a->getType() == PxActorType::eARTICULATION_LINK)
+		{
+			PxArticulationLink* pxArticulationParentLink = 0;
+			PxArticulationLink* pxArticulationLink = static_cast<PxArticulationLink*>(a);
+			PxArticulationJointReducedCoordinate* pxArticulationJoint = pxArticulationLink->getInboundJoint();
+			if (pxArticulationJoint)
+			{
+				pxArticulationParentLink = &(pxArticulationJoint->getParentArticulationLink());
+
+				const PxArticulationJointReducedCoordinate& jcord = *pxArticulationJoint;
+				const OmniPvdObjectHandle jointHandle = OmniPvdObjectHandle(&jcord);
+				PxReal vals[6];
+				for (PxU32 ax = 0; ax < 6; ++ax)
+					vals[ax] = jcord.getJointPosition(static_cast<PxArticulationAxis::Enum>(ax));
+				bulk[eOmniPvdBulkJointPosition].add(jointHandle, vals);
+				for (PxU32 ax = 0; ax < 6; ++ax)
+					vals[ax] = jcord.getJointVelocity(static_cast<PxArticulationAxis::Enum>(ax));
+				bulk[eOmniPvdBulkJointVelocity].add(jointHandle, vals);
+			}
+
+			physx::PxTransform TArtLinkLocal;
+			if (pxArticulationParentLink)
+			{
+				// TLocal = Inv(TFatherGlobal) * TGlobal
+				physx::PxTransform TParentGlobalInv = pxArticulationParentLink->getGlobalPose().getInverse();
+				physx::PxTransform TArtLinkGlobal = pxArticulationLink->getGlobalPose();
+				TArtLinkLocal = TParentGlobalInv * TArtLinkGlobal;
+			}
+			else {
+				TArtLinkLocal = pxArticulationLink->getGlobalPose();
+				OMNI_PVD_SET(articulation, worldBounds, pxArticulationLink->getArticulation(), pxArticulationLink->getArticulation().getWorldBounds());
+			}
+			bulk[eOmniPvdBulkTranslation].add(objectHandle, &TArtLinkLocal.p);
+			bulk[eOmniPvdBulkRotation].add(objectHandle, &TArtLinkLocal.q);
+
+			const PxVec3 linVel = pxArticulationLink->getLinearVelocity();
+			bulk[eOmniPvdBulkLinearVelocity].add(objectHandle, &linVel);
+
+			const PxVec3 angVel = pxArticulationLink->getAngularVelocity();
+			bulk[eOmniPvdBulkAngularVelocity].add(objectHandle, &angVel);
+
+			const PxRigidBodyFlags rFlags = pxArticulationLink->getRigidBodyFlags();
+			bulk[eOmniPvdBulkRigidBodyFlags].add(objectHandle, &rFlags);
+		}
+
+		const PxBounds3 worldBounds = a->getWorldBounds();
+		bulk[eOmniPvdBulkWorldBounds].add(objectHandle, &worldBounds);
+
+		// update active actors' joints
+		const PxRigidActor* ra = a->is<PxRigidActor>();
+		if (ra)
+		{
+			static const PxU32 MAX_CONSTRAINTS = 32;
+			PxConstraint* constraints[MAX_CONSTRAINTS];
+			PxU32 index = 0;
+			while (true)
+			{
+				PxU32 count = ra->getConstraints(constraints, MAX_CONSTRAINTS, index);
+				for (PxU32 i = 0; i < count; ++i)
+				{
+					const NpConstraint& c = static_cast<const NpConstraint&>(*constraints[i]);
+					PxRigidActor *ra0, *ra1; c.getActors(ra0, ra1);
+					bool ra0static = !ra0 || !!ra0->is<PxRigidStatic>(), ra1static = !ra1 || !!ra1->is<PxRigidStatic>();
+					// this check is to not update a joint twice
+					if ((ra == ra0 && (ra1static || ra0 > ra1)) || (ra == ra1 && (ra0static || ra1 > ra0)))
+						c.getCore().getPxConnector()->updateOmniPvdProperties();
+				}
+				if (count == MAX_CONSTRAINTS)
+				{
+					index += MAX_CONSTRAINTS;
+					continue;
+				}
+				break;
+			}
+		}
+	}
+
+	OmniPvdWriter* writer = samplerInternals->mPvdStream.mWriter;
+	const bool supportsBulkAttributes = samplerInternals->mPvdStream.mSupportsBulkAttributes;
+	for (PxU32 i = 0; i < eOmniPvdBulkCount; i++)
+	{
+		bulk[i].send(writer, supportsBulkAttributes);
+	}
+}
+
 void OmniPvdPxSampler::sampleScene(physx::NpScene* scene)
 {
 	{
@@ -1182,16 +1428,19 @@ template <typename ClassType> void OmniPvdPxSampler::createObject(OmniPvdClassHa
 
 template <typename ClassType> void OmniPvdPxSampler::destroyObject(ClassType const & objectId)
 {
+	samplerInternals->invalidateBulkAttributes(OmniPvdObjectHandle(&objectId));
 	samplerInternals->mPvdStream.mWriter->destroyObject(UNNECESSARY_SCENE_HANDLE, OmniPvdObjectHandle(&objectId));
 }
 
 template <typename ClassType, typename AttributeType> void OmniPvdPxSampler::setAttribute(OmniPvdAttributeHandle ah, const ClassType & objectId, const AttributeType & value)
 {
+	samplerInternals->invalidateBulkAttribute(ah, OmniPvdObjectHandle(&objectId));
 	samplerInternals->mPvdStream.mWriter->setAttributeShallow(UNNECESSARY_SCENE_HANDLE, OmniPvdObjectHandle(&objectId), ah, (const unsigned char*)&value, sizeof(AttributeType));
 }
 
 template <typename ClassType, typename AttributeType> void OmniPvdPxSampler::setAttributeBytes(OmniPvdAttributeHandle ah, ClassType const & objectId, const AttributeType * value, unsigned nBytes)
 {
+	samplerInternals->invalidateBulkAttribute(ah, OmniPvdObjectHandle(&objectId));
 	samplerInternals->mPvdStream.mWriter->setAttributeShallow(UNNECESSARY_SCENE_HANDLE, OmniPvdObjectHandle(&objectId), ah, (const unsigned char*)value, nBytes);
 }
 
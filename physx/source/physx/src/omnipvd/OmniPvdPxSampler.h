@@ -120,8 +120,11 @@ public:
 	//enables sampling: 
 	void startSampling();
 	bool isSampling();
-	//sets destination: 
-	void setOmniPvdWriter(OmniPvdWriter* omniPvdWriter);	
+	//sets destination, supportsBulkAttributes is false for runtimes without OmniPvdWriter::setBulkAttributeShallow():
+	void setOmniPvdWriter(OmniPvdWriter* omniPvdWriter, bool supportsBulkAttributes);
+
+	// writes the state of the actors updated by the simulation to the stream, batched per attribute and skipping unchanged values
+	void streamActiveActors(physx::NpScene* scene);
 
 	// writes all contacts to the stream
 	void streamSceneContacts(physx::NpScene* scene);
@@ -243,6 +243,8 @@ OMNI_PVD_ATTRIBUTE		(scene,		gpuMaxNumPartitions,	PxScene,	PxU32,	OmniPvdDataTyp
 OMNI_PVD_ATTRIBUTE		(scene,		gpuMaxNumStaticPartitions,PxScene,	PxU32,	OmniPvdDataTypeEnum::eUINT32, 1)
 OMNI_PVD_ATTRIBUTE		(scene,		gpuComputeVersion,		PxScene,	PxU32,	OmniPvdDataTypeEnum::eUINT32, 1)
 OMNI_PVD_ATTRIBUTE		(scene,		contactPairSlabSize,	PxScene,	PxU32,	OmniPvdDataTypeEnum::eUINT32, 1)
+OMNI_PVD_ATTRIBUTE		(scene,		taskPoolChunkSize,		PxScene,	PxU32,	OmniPvdDataTypeEnum::eUINT32, 1)
+OMNI_PVD_ATTRIBUTE		(scene,		taskPoolSize,			PxScene,	PxU32,	OmniPvdDataTypeEnum::eUINT32, 1)
 OMNI_PVD_ATTRIBUTE		(scene,		tolerancesScale,		PxScene,	PxTolerancesScale,	OmniPvdDataTypeEnum::eFLOAT32, 2)
 //OMNI_PVD_SET(scene, sceneQuerySystem, PxScene, npScene->getSQAPI())//needs class
 
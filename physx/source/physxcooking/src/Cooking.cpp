@@ -265,6 +265,11 @@ bool PxCookConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& des
 	return immediateCooking::cookConvexMesh(params, desc, stream, condition);
 }
 
+bool PxCookConvexMeshes(const PxCookingParams& params, PxU32 nbMeshes, const PxConvexMeshDesc* descs, PxOutputStream* const* streams, PxConvexMeshCookingResult::Enum* conditions)
+{
+	return immediateCooking::cookConvexMeshes(params, nbMeshes, descs, streams, conditions);
+}
+
 PxConvexMesh* PxCreateConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxInsertionCallback& insertionCallback, PxConvexMeshCookingResult::Enum* condition)
 {
 	return immediateCooking::createConvexMesh(params, desc, insertionCallback, condition);
@@ -295,6 +300,16 @@ bool PxCookTriangleMesh(const PxCookingParams& params, const PxTriangleMeshDesc&
 	return immediateCooking::cookTriangleMesh(params, desc, stream, condition);
 }
 
+bool PxCookTriangleMeshes(const PxCookingParams& params, PxU32 nbMeshes, const PxTriangleMeshDesc* descs, PxOutputStream* const* streams, PxTriangleMeshCookingResult::Enum* conditions)
+{
+	return immediateCooking::cookTriangleMeshes(params, nbMeshes, descs, streams, conditions);
+}
+
+bool PxCookTriangleMeshInPlace(const PxCookingParams& params, const PxTriangleMeshDesc& desc, PxOutputStream& stream, PxTriangleMeshCookingResult::Enum* condition)
+{
+	return immediateCooking::cookTriangleMeshInPlace(params, desc, stream, condition);
+}
+
 bool PxCookTetrahedronMesh(const PxCookingParams& params, const PxTetrahedronMeshDesc& meshDesc, PxOutputStream& stream)
 {
 	return immediateCooking::cookTetrahedronMesh(params, meshDesc, stream);
@@ -62,6 +62,8 @@ void PxCollectionExt::releaseObjects(PxCollection& collection, bool releaseExclu
 				releasableObjects.pushBack(first);
 				releasableObjects[0] = s;
 			}
+			else
+				releasableObjects.pushBack(s);
 		}
 		else
 		{
@@ -78,20 +78,32 @@ static BVHBuildStrategy getBuildStrategy(PxBVHBuildStrategy::Enum bs)
 	return BVH_SPLATTER_POINTS;
 }
 
-static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDynamicTreeSecondaryPruner::Enum secondaryType, PxBVHBuildStrategy::Enum buildStrategy, PxU32 nbObjectsPerNode)
+static BVHNodeWidth getNodeWidth(PxBVHNodeWidth::Enum nw)
+{
+	switch(nw)
+	{
+		case PxBVHNodeWidth::eBINARY:	return BVH_BINARY;
+		case PxBVHNodeWidth::eWIDE_4:	return BVH_WIDE_4;
+		case PxBVHNodeWidth::eWIDE_8:	return BVH_WIDE_8;
+	}
+	return BVH_BINARY;
+}
+
+static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDynamicTreeSecondaryPruner::Enum secondaryType, PxBVHBuildStrategy::Enum buildStrategy, PxU32 nbObjectsPerNode, PxBVHNodeWidth::Enum nodeWidth)
 {
 //	if(0)
 //		return createIncrementalPruner(contextID);
 
 	const CompanionPrunerType cpType = getCompanionType(secondaryType);
 	const BVHBuildStrategy bs = getBuildStrategy(buildStrategy);
+	const BVHNodeWidth nw = getNodeWidth(nodeWidth);
 
 	Pruner* pruner = NULL;
 	switch(type)
 	{
 		case PxPruningStructureType::eNONE:					{ pruner = createBucketPruner(contextID);										break;	}
-		case PxPruningStructureType::eDYNAMIC_AABB_TREE:	{ pruner = createAABBPruner(contextID, true, cpType, bs, nbObjectsPerNode);		break;	}
-		case PxPruningStructureType::eSTATIC_AABB_TREE:		{ pruner = createAABBPruner(contextID, false, cpType, bs, nbObjectsPerNode);	break;	}
+		case PxPruningStructureType::eDYNAMIC_AABB_TREE:	{ pruner = createAABBPruner(contextID, true, cpType, bs, nbObjectsPerNode, nw);		break;	}
+		case PxPruningStructureType::eSTATIC_AABB_TREE:		{ pruner = createAABBPruner(contextID, false, cpType, bs, nbObjectsPerNode, nw);	break;	}
 		case PxPruningStructureType::eLAST:					break;
 	}
 	return pruner;
@@ -247,6 +259,10 @@ namespace
 														PxOverlapCallback& hitCall, 
 														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
 														const PxQueryCache* cache, PxGeometryQueryFlags flags)	const;
+		virtual	bool							cull(	PxU32 nbPlanes, const PxPlane* planes,
+														PxOverlapCallback& hitCall,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags)	const;
 		virtual	PxSQPrunerHandle				getHandle(const PxRigidActor& actor, const PxShape& shape, PxU32& prunerIndex)	const;
 		virtual	void							sync(PxU32 prunerIndex, const PxSQPrunerHandle* handles, const PxU32* indices, const PxBounds3* bounds,
 													const PxTransform32* transforms, PxU32 count, const PxBitMap& ignoredIndices);
@@ -457,6 +473,14 @@ bool CustomPxSQ::overlap(	const PxGeometry& geometry, const PxTransform& transfo
 	return mQueries._overlap( geometry, transform, hitCall, filterData, filterCall, cache, flags);
 }
 
+bool CustomPxSQ::cull(	PxU32 nbPlanes, const PxPlane* planes,
+						PxOverlapCallback& hitCall,
+						const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+						PxGeometryQueryFlags flags) const
+{
+	return mQueries._cull(nbPlanes, planes, hitCall, filterData, filterCall, flags);
+}
+
 PxSQPrunerHandle CustomPxSQ::getHandle(const PxRigidActor& actor, const PxShape& shape, PxU32& prunerIndex) const
 {
 	const PxU32 actorIndex = actor.getInternalActorIndex();
@@ -477,7 +501,7 @@ void CustomPxSQ::sync(PxU32 prunerIndex, const PxSQPrunerHandle* handles, const
 
 PxU32 CustomPxSQ::addPruner(PxPruningStructureType::Enum primaryType, PxDynamicTreeSecondaryPruner::Enum secondaryType, PxU32 preallocated)
 {
-	Pruner* pruner = create(primaryType, mQueries.getContextId(), secondaryType, PxBVHBuildStrategy::eFAST, 4);
+	Pruner* pruner = create(primaryType, mQueries.getContextId(), secondaryType, PxBVHBuildStrategy::eFAST, 4, PxBVHNodeWidth::eBINARY);
 	return mQueries.mSQManager.addPruner(pruner, preallocated);
 }
 
@@ -0,0 +1,650 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "extensions/PxSceneSnapshot.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxHashMap.h"
+#include "foundation/PxMemory.h"
+#include "foundation/PxUserAllocated.h"
+#include "PxScene.h"
+#include "PxRigidDynamic.h"
+#include "PxArticulationReducedCoordinate.h"
+
+using namespace physx;
+
+namespace
+{
+	// Parts of an actor's state, written to a snapshot record when they changed
+	enum StateField
+	{
+		eFIELD_POSE				= (1<<0),
+		eFIELD_LINEAR_VELOCITY	= (1<<1),
+		eFIELD_ANGULAR_VELOCITY	= (1<<2),
+		eFIELD_SLEEP			= (1<<3),
+		eFIELD_JOINT_POSITIONS	= (1<<4),
+		eFIELD_JOINT_VELOCITIES	= (1<<5),
+
+		eFIELD_POSE_ONLY		= eFIELD_POSE,
+		eFIELD_RIGID_DYNAMIC	= eFIELD_POSE|eFIELD_LINEAR_VELOCITY|eFIELD_ANGULAR_VELOCITY|eFIELD_SLEEP,
+		eFIELD_ARTICULATION		= eFIELD_RIGID_DYNAMIC|eFIELD_JOINT_POSITIONS|eFIELD_JOINT_VELOCITIES
+	};
+
+	// Layout of an actor's state, in PxReal units. Joint positions and velocities follow for articulations.
+	const PxU32 gPoseOffset				= 0;
+	const PxU32 gLinearVelocityOffset	= 7;
+	const PxU32 gAngularVelocityOffset	= 10;
+	const PxU32 gSleepOffset			= 13;	// Wake counter, or a negative value for sleeping actors
+	const PxU32 gJointOffset			= 14;
+	const PxU32 gNbFields				= 6;
+
+	const PxU32 gSnapshotMagic			= PxU32('P')|(PxU32('X')<<8)|(PxU32('S')<<16)|(PxU32('S')<<24);
+	const PxU32 gSnapshotVersion		= 1;
+	const PxU32 gNoBaseline				= 0xffffffff;
+
+	struct SnapshotHeader
+	{
+		PxU32	mMagic;
+		PxU32	mVersion;
+		PxU32	mId;
+		PxU32	mBaseId;		// Id of the baseline a delta snapshot applies to, gNoBaseline for full snapshots
+		PxU32	mNbRecords;
+	};
+
+	// Followed by the values of the fields, in field order
+	struct RecordHeader
+	{
+		PxU32	mSlot;
+		PxU16	mGeneration;
+		PxU8	mFields;
+		PxU8	mNbDofs;
+	};
+
+	PX_FORCE_INLINE void getFieldRange(PxU32 field, PxU32 nbDofs, PxU32& offset, PxU32& nbValues)
+	{
+		switch(field)
+		{
+			case eFIELD_POSE:				offset = gPoseOffset;				nbValues = 7;		break;
+			case eFIELD_LINEAR_VELOCITY:	offset = gLinearVelocityOffset;		nbValues = 3;		break;
+			case eFIELD_ANGULAR_VELOCITY:	offset = gAngularVelocityOffset;	nbValues = 3;		break;
+			case eFIELD_SLEEP:				offset = gSleepOffset;				nbValues = 1;		break;
+			case eFIELD_JOINT_POSITIONS:	offset = gJointOffset;				nbValues = nbDofs;	break;
+			default:						offset = gJointOffset + nbDofs;		nbValues = nbDofs;	break;
+		}
+	}
+
+	PX_FORCE_INLINE PxU32 getNbValues(PxU32 fields, PxU32 nbDofs)
+	{
+		PxU32 nbValues = 0;
+		for(PxU32 i=0;i<gNbFields;i++)
+		{
+			if(fields & (1<<i))
+			{
+				PxU32 offset, nb;
+				getFieldRange(1<<i, nbDofs, offset, nb);
+				nbValues += nb;
+			}
+		}
+		return nbValues;
+	}
+
+	// Bitwise comparison, so that restoring a snapshot reproduces the captured values exactly
+	PX_FORCE_INLINE bool isEqual(const PxReal* a, const PxReal* b, PxU32 nbValues)
+	{
+		const PxU32* ia = reinterpret_cast<const PxU32*>(a);
+		const PxU32* ib = reinterpret_cast<const PxU32*>(b);
+		for(PxU32 i=0;i<nbValues;i++)
+		{
+			if(ia[i] != ib[i])
+				return false;
+		}
+		return true;
+	}
+
+	PX_FORCE_INLINE bool isSimulatedDynamic(const PxRigidDynamic& body)
+	{
+		return !(body.getRigidBodyFlags() & PxRigidBodyFlag::eKINEMATIC) && !(body.getActorFlags() & PxActorFlag::eDISABLE_SIMULATION);
+	}
+
+	struct Slot
+	{
+		PxRigidDynamic*						mBody;			// Either mBody or mArticulation is set for live slots
+		PxArticulationReducedCoordinate*	mArticulation;
+		PxArticulationCache*				mCache;
+		PxU32								mOffset;		// State offset in the baseline
+		PxU32								mCapacity;		// Number of state values reserved at mOffset
+		PxU32								mLastSeen;		// Last slot update that found the actor in the scene
+		PxU16								mGeneration;	// Incremented each time the slot is freed
+		PxU8								mNbDofs;
+		PxU8								mNbLinks;		// Link count of the articulation the cache was created for
+		bool								mNew;			// The baseline does not contain the actor's state yet
+
+		PX_FORCE_INLINE	bool	isLive()	const	{ return mBody || mArticulation;	}
+	};
+
+	class SceneSnapshotContext : public PxSceneSnapshotContext, public PxUserAllocated
+	{
+		public:
+									SceneSnapshotContext(PxScene& scene);
+		virtual						~SceneSnapshotContext();
+
+		// PxSceneSnapshotContext
+		virtual	void				release()	PX_OVERRIDE;
+		virtual	PxU32				capture(void* buffer, PxU32 bufferSize, bool fullSnapshot)	PX_OVERRIDE;
+		virtual	bool				restore(const void* buffer, PxU32 size)	PX_OVERRIDE;
+		virtual	PxU32				getMaxSnapshotSize()	const	PX_OVERRIDE;
+		virtual	PxScene&			getScene()	const	PX_OVERRIDE	{ return mScene;	}
+		//~PxSceneSnapshotContext
+
+		private:
+				void				updateSlots();
+				void				addSlot(PxRigidDynamic* body, PxArticulationReducedCoordinate* articulation);
+				void				freeSlot(PxU32 index);
+				PxU32				readState(const Slot& slot, PxReal* state);
+				void				applyState(Slot& slot, PxU32 fields);
+
+				PxScene&			mScene;
+				PxArray<Slot>		mSlots;
+				PxArray<PxU32>		mFreeSlots;
+				PxHashMap<const void*, PxU32>	mSlotMap;	// Actor or articulation to slot index
+				PxArray<PxReal>		mBaseline;
+				PxArray<PxReal>		mCurrent;	// Scratch state of capture(), parallel to mBaseline
+				PxArray<PxActor*>	mActorBuffer;
+				PxArray<PxArticulationReducedCoordinate*>	mArticulationBuffer;
+				PxU32				mUpdateStamp;
+				PxU32				mBaselineId;
+				PxU32				mNextId;
+	};
+}
+
+SceneSnapshotContext::SceneSnapshotContext(PxScene& scene) :
+	mScene		(scene),
+	mUpdateStamp(0),
+	mBaselineId	(0),
+	mNextId		(1)
+{
+}
+
+SceneSnapshotContext::~SceneSnapshotContext()
+{
+	for(PxU32 i=0;i<mSlots.size();i++)
+	{
+		if(mSlots[i].mCache)
+			mSlots[i].mCache->release();
+	}
+}
+
+void SceneSnapshotContext::release()
+{
+	PX_DELETE_THIS;
+}
+
+void SceneSnapshotContext::addSlot(PxRigidDynamic* body, PxArticulationReducedCoordinate* articulation)
+{
+	const PxU32 nbDofs = articulation ? articulation->getDofs() : 0;
+	const PxU32 nbValues = gJointOffset + nbDofs*2;
+
+	// reuse a free slot with enough room for the state, or append a new one
+	PxU32 index = 0xffffffff;
+	for(PxU32 i=mFreeSlots.size();i--;)
+	{
+		if(mSlots[mFreeSlots[i]].mCapacity >= nbValues)
+		{
+			index = mFreeSlots[i];
+			mFreeSlots.replaceWithLast(i);
+			break;
+		}
+	}
+
+	if(index == 0xffffffff)
+	{
+		index = mSlots.size();
+		Slot& slot = mSlots.insert();
+		slot.mOffset = mBaseline.size();
+		slot.mCapacity = nbValues;
+		slot.mGeneration = 0;
+		// PxArray::resize() does not grow geometrically
+		const PxU32 size = mBaseline.size() + nbValues;
+		if(size > mBaseline.capacity())
+		{
+			mBaseline.reserve(PxMax(size, mBaseline.capacity()*2));
+			mCurrent.reserve(mBaseline.capacity());
+		}
+		mBaseline.resize(size);
+		mCurrent.resize(size);
+	}
+
+	Slot& slot = mSlots[index];
+	slot.mBody = body;
+	slot.mArticulation = articulation;
+	slot.mCache = articulation ? articulation->createCache() : NULL;
+	slot.mLastSeen = mUpdateStamp;
+	slot.mNbDofs = PxU8(nbDofs);
+	slot.mNbLinks = PxU8(articulation ? articulation->getNbLinks() : 0);
+	slot.mNew = true;
+
+	mSlotMap.insert(body ? static_cast<const void*>(body) : static_cast<const void*>(articulation), index);
+}
+
+void SceneSnapshotContext::freeSlot(PxU32 index)
+{
+	Slot& slot = mSlots[index];
+	mSlotMap.erase(slot.mBody ? static_cast<const void*>(slot.mBody) : static_cast<const void*>(slot.mArticulation));
+
+	// the articulation is gone, and so is the simulation data the cache refers to
+	if(slot.mCache)
+		slot.mCache->release();
+
+	slot.mBody = NULL;
+	slot.mArticulation = NULL;
+	slot.mCache = NULL;
+	slot.mGeneration++;
+	mFreeSlots.pushBack(index);
+}
+
+// Tracks the actors added to the scene since the last update, and frees the slots of removed ones.
+void SceneSnapshotContext::updateSlots()
+{
+	mUpdateStamp++;
+
+	const PxU32 nbActors = mScene.getNbActors(PxActorTypeFlag::eRIGID_DYNAMIC);
+	mActorBuffer.resizeUninitialized(nbActors);
+	mScene.getActors(PxActorTypeFlag::eRIGID_DYNAMIC, mActorBuffer.begin(), nbActors);
+
+	const PxU32 nbArticulations = mScene.getNbArticulations();
+	mArticulationBuffer.resizeUninitialized(nbArticulations);
+	mScene.getArticulations(mArticulationBuffer.begin(), nbArticulations);
+
+	for(PxU32 i=0;i<nbActors;i++)
+	{
+		PxRigidDynamic* body = static_cast<PxRigidDynamic*>(mActorBuffer[i]);
+		const PxHashMap<const void*, PxU32>::Entry* entry = mSlotMap.find(body);
+		if(entry)
+			mSlots[entry->second].mLastSeen = mUpdateStamp;
+		else
+			addSlot(body, NULL);
+	}
+
+	for(PxU32 i=0;i<nbArticulations;i++)
+	{
+		PxArticulationReducedCoordinate* articulation = mArticulationBuffer[i];
+		const PxHashMap<const void*, PxU32>::Entry* entry = mSlotMap.find(articulation);
+		if(entry)
+		{
+			const PxU32 index = entry->second;
+			Slot& slot = mSlots[index];
+			if(slot.mNbDofs == articulation->getDofs() && slot.mNbLinks == articulation->getNbLinks())
+			{
+				slot.mLastSeen = mUpdateStamp;
+				continue;
+			}
+
+			// the articulation has been removed, changed and re-added, or a new one lives at the address of a removed one.
+			// Either way the slot's cache and state layout do not match it anymore.
+			freeSlot(index);
+		}
+		addSlot(NULL, articulation);
+	}
+
+	if(mSlotMap.size() != nbActors + nbArticulations)
+	{
+		for(PxU32 i=0;i<mSlots.size();i++)
+		{
+			if(mSlots[i].isLive() && mSlots[i].mLastSeen != mUpdateStamp)
+				freeSlot(i);
+		}
+	}
+}
+
+// Reads the state of the slot's actor, and returns the fields that are valid for it.
+PxU32 SceneSnapshotContext::readState(const Slot& slot, PxReal* state)
+{
+	PxTransform pose;
+	PxVec3 linearVelocity(0.0f), angularVelocity(0.0f);
+	PxReal wakeCounter = 0.0f;
+	PxU32 fields;
+
+	if(slot.mBody)
+	{
+		const PxRigidDynamic& body = *slot.mBody;
+		pose = body.getGlobalPose();
+		if(isSimulatedDynamic(body))
+		{
+			linearVelocity = body.getLinearVelocity();
+			angularVelocity = body.getAngularVelocity();
+			wakeCounter = body.isSleeping() ? -1.0f : body.getWakeCounter();
+			fields = eFIELD_RIGID_DYNAMIC;
+		}
+		else
+			fields = eFIELD_POSE_ONLY;
+	}
+	else
+	{
+		const PxArticulationReducedCoordinate& articulation = *slot.mArticulation;
+		PxArticulationCache& cache = *slot.mCache;
+		articulation.copyInternalStateToCache(cache, PxArticulationCacheFlag::eROOT_TRANSFORM|PxArticulationCacheFlag::eROOT_VELOCITIES|PxArticulationCacheFlag::ePOSITION|PxArticulationCacheFlag::eVELOCITY);
+		pose = cache.rootLinkData->transform;
+		linearVelocity = cache.rootLinkData->worldLinVel;
+		angularVelocity = cache.rootLinkData->worldAngVel;
+		wakeCounter = articulation.isSleeping() ? -1.0f : articulation.getWakeCounter();
+
+		const PxU32 nbDofs = slot.mNbDofs;
+		if(nbDofs)
+		{
+			PxMemCopy(state + gJointOffset, cache.jointPosition, sizeof(PxReal)*nbDofs);
+			PxMemCopy(state + gJointOffset + nbDofs, cache.jointVelocity, sizeof(PxReal)*nbDofs);
+			fields = eFIELD_ARTICULATION;
+		}
+		else
+			fields = eFIELD_RIGID_DYNAMIC;
+	}
+
+	PxMemCopy(state + gPoseOffset, &pose, sizeof(PxReal)*7);
+	PxMemCopy(state + gLinearVelocityOffset, &linearVelocity, sizeof(PxReal)*3);
+	PxMemCopy(state + gAngularVelocityOffset, &angularVelocity, sizeof(PxReal)*3);
+	state[gSleepOffset] = wakeCounter;
+	return fields;
+}
+
+// Applies the given fields of the slot's baseline state to its actor. The sleep state goes first, so that setting the
+// pose and velocities does not wake the actor up.
+void SceneSnapshotContext::applyState(Slot& slot, PxU32 fields)
+{
+	const PxReal* state = mBaseline.begin() + slot.mOffset;
+	PxTransform pose;
+	PxVec3 linearVelocity, angularVelocity;
+	PxMemCopy(&pose, state + gPoseOffset, sizeof(PxReal)*7);
+	PxMemCopy(&linearVelocity, state + gLinearVelocityOffset, sizeof(PxReal)*3);
+	PxMemCopy(&angularVelocity, state + gAngularVelocityOffset, sizeof(PxReal)*3);
+	const PxReal wakeCounter = state[gSleepOffset];
+
+	if(slot.mBody)
+	{
+		PxRigidDynamic& body = *slot.mBody;
+		const bool simulated = isSimulatedDynamic(body);
+
+		if(simulated && (fields & eFIELD_SLEEP))
+		{
+			if(wakeCounter < 0.0f)
+				body.putToSleep();
+			else
+			{
+				if(body.isSleeping())
+					body.wakeUp();
+				body.setWakeCounter(wakeCounter);
+			}
+		}
+
+		if(fields & eFIELD_POSE)
+			body.setGlobalPose(pose, false);
+
+		if(simulated)
+		{
+			if(fields & eFIELD_LINEAR_VELOCITY)
+				body.setLinearVelocity(linearVelocity, false);
+			if(fields & eFIELD_ANGULAR_VELOCITY)
+				body.setAngularVelocity(angularVelocity, false);
+		}
+	}
+	else
+	{
+		PxArticulationReducedCoordinate& articulation = *slot.mArticulation;
+
+		if(fields & eFIELD_SLEEP)
+		{
+			if(wakeCounter < 0.0f)
+				articulation.putToSleep();
+			else
+			{
+				if(articulation.isSleeping())
+					articulation.wakeUp();
+				articulation.setWakeCounter(wakeCounter);
+			}
+		}
+
+		// the cache is filled from the baseline, so that fields sharing a cache flag are written together
+		PxArticulationCache& cache = *slot.mCache;
+		PxArticulationCacheFlags flags;
+		if(fields & eFIELD_POSE)
+		{
+			cache.rootLinkData->transform = pose;
+			flags |= PxArticulationCacheFlag::eROOT_TRANSFORM;
+		}
+		if(fields & (eFIELD_LINEAR_VELOCITY|eFIELD_ANGULAR_VELOCITY))
+		{
+			cache.rootLinkData->worldLinVel = linearVelocity;
+			cache.rootLinkData->worldAngVel = angularVelocity;
+			flags |= PxArticulationCacheFlag::eROOT_VELOCITIES;
+		}
+
+		const PxU32 nbDofs = slot.mNbDofs;
+		if(fields & eFIELD_JOINT_POSITIONS)
+		{
+			PxMemCopy(cache.jointPosition, state + gJointOffset, sizeof(PxReal)*nbDofs);
+			flags |= PxArticulationCacheFlag::ePOSITION;
+		}
+		if(fields & eFIELD_JOINT_VELOCITIES)
+		{
+			PxMemCopy(cache.jointVelocity, state + gJointOffset + nbDofs, sizeof(PxReal)*nbDofs);
+			flags |= PxArticulationCacheFlag::eVELOCITY;
+		}
+
+		if(flags)
+			articulation.applyCache(cache, flags, false);
+	}
+}
+
+PxU32 SceneSnapshotContext::capture(void* buffer, PxU32 bufferSize, bool fullSnapshot)
+{
+	PX_CHECK_AND_RETURN_VAL(buffer && !(size_t(buffer) & 3), "PxSceneSnapshotContext::capture: buffer must be a valid, 4-byte aligned pointer.", 0);
+
+	if(bufferSize < sizeof(SnapshotHeader))
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxSceneSnapshotContext::capture: buffer is too small.");
+		return 0;
+	}
+
+	updateSlots();
+
+	PxU8* dst = reinterpret_cast<PxU8*>(buffer);
+	PxU32 size = sizeof(SnapshotHeader);
+	PxU32 nbRecords = 0;
+
+	const PxU32 nbSlots = mSlots.size();
+	for(PxU32 i=0;i<nbSlots;i++)
+	{
+		const Slot& slot = mSlots[i];
+		if(!slot.isLive())
+			continue;
+
+		PxReal* current = mCurrent.begin() + slot.mOffset;
+		const PxReal* baseline = mBaseline.begin() + slot.mOffset;
+		const PxU32 nbDofs = slot.mNbDofs;
+
+		PxU32 fields = readState(slot, current);
+		if(!fullSnapshot && !slot.mNew)
+		{
+			for(PxU32 j=0;j<gNbFields;j++)
+			{
+				PxU32 offset, nbValues;
+				getFieldRange(1<<j, nbDofs, offset, nbValues);
+				if((fields & (1<<j)) && isEqual(current + offset, baseline + offset, nbValues))
+					fields &= ~(1<<j);
+			}
+		}
+
+		if(!fields)
+			continue;
+
+		const PxU32 recordSize = sizeof(RecordHeader) + sizeof(PxReal)*getNbValues(fields, nbDofs);
+		if(recordSize > bufferSize - size)
+		{
+			PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxSceneSnapshotContext::capture: buffer is too small, see getMaxSnapshotSize().");
+			return 0;
+		}
+
+		RecordHeader* record = reinterpret_cast<RecordHeader*>(dst + size);
+		record->mSlot = i;
+		record->mGeneration = slot.mGeneration;
+		record->mFields = PxU8(fields);
+		record->mNbDofs = PxU8(nbDofs);
+
+		PxReal* values = reinterpret_cast<PxReal*>(record + 1);
+		for(PxU32 j=0;j<gNbFields;j++)
+		{
+			if(fields & (1<<j))
+			{
+				PxU32 offset, nbValues;
+				getFieldRange(1<<j, nbDofs, offset, nbValues);
+				PxMemCopy(values, current + offset, sizeof(PxReal)*nbValues);
+				values += nbValues;
+			}
+		}
+
+		size += recordSize;
+		nbRecords++;
+	}
+
+	SnapshotHeader* header = reinterpret_cast<SnapshotHeader*>(dst);
+	header->mMagic = gSnapshotMagic;
+	header->mVersion = gSnapshotVersion;
+	header->mId = mNextId++;
+	header->mBaseId = fullSnapshot ? gNoBaseline : mBaselineId;
+	header->mNbRecords = nbRecords;
+
+	// the state of all live slots has been read, so the scratch state is the new baseline
+	mBaseline.swap(mCurrent);
+	for(PxU32 i=0;i<nbSlots;i++)
+		mSlots[i].mNew = false;
+	mBaselineId = header->mId;
+
+	return size;
+}
+
+bool SceneSnapshotContext::restore(const void* buffer, PxU32 size)
+{
+	PX_CHECK_AND_RETURN_VAL(buffer && !(size_t(buffer) & 3), "PxSceneSnapshotContext::restore: buffer must be a valid, 4-byte aligned pointer.", false);
+
+	const PxU8* src = reinterpret_cast<const PxU8*>(buffer);
+	const SnapshotHeader* header = reinterpret_cast<const SnapshotHeader*>(src);
+	if(size < sizeof(SnapshotHeader) || header->mMagic != gSnapshotMagic || header->mVersion != gSnapshotVersion)
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxSceneSnapshotContext::restore: invalid snapshot.");
+		return false;
+	}
+
+	if(header->mBaseId != gNoBaseline && header->mBaseId != mBaselineId)
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_OPERATION, PX_FL, "PxSceneSnapshotContext::restore: delta snapshot does not apply to the current baseline.");
+		return false;
+	}
+
+	// check all records before touching the scene
+	PxU32 offset = sizeof(SnapshotHeader);
+	for(PxU32 i=0;i<header->mNbRecords;i++)
+	{
+		const RecordHeader* record = reinterpret_cast<const RecordHeader*>(src + offset);
+		if(sizeof(RecordHeader) > size - offset || (record->mFields & ~eFIELD_ARTICULATION))
+		{
+			offset = 0xffffffff;
+			break;
+		}
+
+		const PxU32 recordSize = sizeof(RecordHeader) + sizeof(PxReal)*getNbValues(record->mFields, record->mNbDofs);
+		if(recordSize > size - offset)
+		{
+			offset = 0xffffffff;
+			break;
+		}
+		offset += recordSize;
+	}
+
+	if(offset != size)
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxSceneSnapshotContext::restore: invalid snapshot.");
+		return false;
+	}
+
+	// actors removed since the last update must not be accessed
+	updateSlots();
+
+	offset = sizeof(SnapshotHeader);
+	for(PxU32 i=0;i<header->mNbRecords;i++)
+	{
+		const RecordHeader* record = reinterpret_cast<const RecordHeader*>(src + offset);
+		const PxU32 fields = record->mFields;
+		const PxU32 nbDofs = record->mNbDofs;
+		offset += sizeof(RecordHeader) + sizeof(PxReal)*getNbValues(fields, nbDofs);
+
+		// skip actors that have been removed from the scene since the capture
+		if(record->mSlot >= mSlots.size())
+			continue;
+		Slot& slot = mSlots[record->mSlot];
+		if(!slot.isLive() || slot.mGeneration != record->mGeneration || slot.mNbDofs != nbDofs)
+			continue;
+
+		PxReal* state = mBaseline.begin() + slot.mOffset;
+		const PxReal* values = reinterpret_cast<const PxReal*>(record + 1);
+		for(PxU32 j=0;j<gNbFields;j++)
+		{
+			if(fields & (1<<j))
+			{
+				PxU32 fieldOffset, nbValues;
+				getFieldRange(1<<j, nbDofs, fieldOffset, nbValues);
+				PxMemCopy(state + fieldOffset, values, sizeof(PxReal)*nbValues);
+				values += nbValues;
+			}
+		}
+
+		applyState(slot, fields);
+	}
+
+	mBaselineId = header->mId;
+	return true;
+}
+
+PxU32 SceneSnapshotContext::getMaxSnapshotSize() const
+{
+	PxU32 nbValues = mScene.getNbActors(PxActorTypeFlag::eRIGID_DYNAMIC) * gJointOffset;
+	PxU32 nbRecords = mScene.getNbActors(PxActorTypeFlag::eRIGID_DYNAMIC);
+
+	const PxU32 nbArticulations = mScene.getNbArticulations();
+	for(PxU32 i=0;i<nbArticulations;i++)
+	{
+		PxArticulationReducedCoordinate* articulation;
+		mScene.getArticulations(&articulation, 1, i);
+		nbValues += gJointOffset + articulation->getDofs()*2;
+	}
+	nbRecords += nbArticulations;
+
+	return sizeof(SnapshotHeader) + nbRecords*sizeof(RecordHeader) + nbValues*sizeof(PxReal);
+}
+
+PxSceneSnapshotContext* physx::PxCreateSceneSnapshotContext(PxScene& scene)
+{
+	return PX_NEW(SceneSnapshotContext)(scene);
+}
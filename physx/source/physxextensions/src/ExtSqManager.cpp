@@ -83,6 +83,9 @@ PxU32 ExtPrunerManager::addPruner(Pruner* pruner, PxU32 preallocated)
 	if(preallocated)
 		pe->preallocate(preallocated);
 	mPrunerExt.pushBack(pe);
+
+	const PrunerStamp stamp = { 0, 0 };
+	mPrunerStamps.pushBack(stamp);
 	return index;
 }
 
@@ -136,6 +139,10 @@ PrunerHandle ExtPrunerManager::addPrunerShape(const PrunerPayload& payload, PxU3
 		PX_ASSERT(prunerIndex<mPrunerExt.size());
 		PX_ASSERT(mPrunerExt[prunerIndex]->pruner());
 		mPrunerExt[prunerIndex]->pruner()->addObjects(&handle, &bounds, &payload, &transform, 1, hasPruningStructure);
+
+		invalidatePrunerTimestamp(prunerIndex);
+		if(dynamic)
+			mPrunerStamps[prunerIndex].mNbDynamicObjects++;
 		//mPrunerExt[prunerIndex].growDirtyList(handle);
 	}
 	else
@@ -167,6 +174,13 @@ void ExtPrunerManager::removePrunerShape(PxU32 prunerIndex, bool dynamic, Pruner
 
 		mPrunerExt[prunerIndex]->removeFromDirtyList(shapeHandle);
 		mPrunerExt[prunerIndex]->pruner()->removeObjects(&shapeHandle, 1, removalCallback);
+
+		invalidatePrunerTimestamp(prunerIndex);
+		if(dynamic)
+		{
+			PX_ASSERT(mPrunerStamps[prunerIndex].mNbDynamicObjects);
+			mPrunerStamps[prunerIndex].mNbDynamicObjects--;
+		}
 	}
 	else
 	{
@@ -195,6 +209,7 @@ void ExtPrunerManager::markForUpdate(PxU32 prunerIndex, bool dynamic, PrunerComp
 
 		// PT: TODO: at this point do we still need a dirty list? we could just update the bounds directly?
 		mPrunerExt[prunerIndex]->addToDirtyList(shapeHandle, dynamic, transform);
+		invalidatePrunerTimestamp(prunerIndex);
 	}
 	else
 		mCompoundPrunerExt.addToDirtyList(compoundId, shapeHandle, transform);
@@ -422,9 +437,13 @@ void ExtPrunerManager::shiftOrigin(const PxVec3& shift)
 		Pruner* pruner = pe->pruner();
 		if(pruner)
 			pruner->shiftOrigin(shift);
+		invalidatePrunerTimestamp(i);
 	}
 
 	mCompoundPrunerExt.pruner()->shiftOrigin(shift);
+
+	// PT: static objects moved, so data captured by users for static objects (e.g. query candidate caches) is now invalid
+	invalidateStaticTimestamp();
 }
 
 void ExtPrunerManager::addCompoundShape(const PxBVH& pxbvh, PrunerCompoundId compoundId, const PxTransform& compoundTransform, PrunerHandle* prunerHandle, const PrunerPayload* payloads, const PxTransform* transforms, bool isDynamic)
@@ -468,6 +487,8 @@ void ExtPrunerManager::sync(PxU32 prunerIndex, const PrunerHandle* handles, cons
 	if(!pruner)
 		return;
 
+	invalidatePrunerTimestamp(prunerIndex);
+
 	PxU32 startIndex = 0;
 	PxU32 numIndices = count;
 
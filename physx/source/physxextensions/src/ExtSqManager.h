@@ -105,6 +105,11 @@ namespace Sq
 		PX_FORCE_INLINE const Adapter&					getAdapter()			const	{ return mAdapter;			}
 		PX_FORCE_INLINE	const Gu::BVH*					getTreeOfPruners()		const	{ return mTreeOfPruners;	}
 
+		// PT: per-pruner timestamps for query candidate caches. The timestamp of a pruner changes each time its content changes.
+		// Only pruners without dynamic objects are worth caching, since the others are modified all the time.
+		PX_FORCE_INLINE PxU32							getPrunerTimestamp(PxU32 index)		const	{ return mPrunerStamps[index].mTimestamp;				}
+		PX_FORCE_INLINE bool							hasDynamicObjects(PxU32 index)		const	{ return mPrunerStamps[index].mNbDynamicObjects!=0;	}
+
 						PxU32							startCustomBuildstep();
 						void							customBuildstep(PxU32 index);
 						void							finishCustomBuildstep();
@@ -113,6 +118,13 @@ namespace Sq
 	private:
 						const Adapter&					mAdapter;
 						PxArray<PrunerExt*>				mPrunerExt;
+
+						struct PrunerStamp
+						{
+							PxU32	mTimestamp;
+							PxU32	mNbDynamicObjects;
+						};
+						PxArray<PrunerStamp>			mPrunerStamps;
 						CompoundPrunerExt				mCompoundPrunerExt;
 
 						Gu::BVH*						mTreeOfPruners;
@@ -130,6 +142,7 @@ namespace Sq
 
 						void							flushShapes();
 		PX_FORCE_INLINE void							invalidateStaticTimestamp()		{ mStaticTimestamp++;		}
+		PX_FORCE_INLINE void							invalidatePrunerTimestamp(PxU32 index)	{ mPrunerStamps[index].mTimestamp++;	}
 
 						PX_NOCOPY(ExtPrunerManager)
 	};
@@ -789,6 +789,130 @@ static PX_FORCE_INLINE bool prunerFilter(const ExtQueryAdapter& adapter, PxU32 p
 	// so instead we call a user-provided callback to validate processing each pruner.
 	return adapter.processPruner(prunerIndex, context, filterData, filterCall);
 }
+
+// PT: query candidate cache support, similar to the code in SqQuery.cpp. There is no hardcoded static pruner here, so
+// instead we cache the pruners that do not contain dynamic objects. The pruner mask is stored in the cache, so only the
+// first 32 pruners can be cached.
+#define EXT_MAX_NB_CACHED_PRUNERS	32
+
+static PX_FORCE_INLINE bool isCachedPruner(PxU32 cachedPruners, PxU32 prunerIndex)
+{
+	return prunerIndex<EXT_MAX_NB_CACHED_PRUNERS && (cachedPruners & (1u<<prunerIndex));
+}
+
+// PT: returns the pruners that can be cached for a query, and a timestamp that changes whenever one of them is modified.
+// Pruner timestamps only ever increase, so their sum is a valid timestamp for a given set of pruners.
+static PxU32 computeCachedPruners(const ExtPrunerManager& manager, const ExtQueryAdapter& adapter, const PxQueryThreadContext* context, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall, PxU32& timestamp)
+{
+	PxU32 cachedPruners = 0;
+	timestamp = 0;
+
+	const PxU32 nbPruners = PxMin(manager.getNbPruners(), PxU32(EXT_MAX_NB_CACHED_PRUNERS));
+	for(PxU32 i=0;i<nbPruners;i++)
+	{
+		if(manager.getPruner(i) && !manager.hasDynamicObjects(i) && prunerFilter(adapter, i, context, filterData, filterCall))
+		{
+			cachedPruners |= 1u<<i;
+			timestamp += manager.getPrunerTimestamp(i);
+		}
+	}
+	return cachedPruners;
+}
+
+namespace
+{
+	// PT: captures the candidates for a query candidate cache
+	struct CandidateCaptureCallback : public PrunerOverlapCallback
+	{
+		CandidateCaptureCallback(PxQueryCandidateCache& cache) : mCache(cache), mNbCandidates(0), mOverflow(false)	{}
+
+		virtual bool	invoke(PxU32 primIndex, const PrunerPayload* payloads, const PxTransform* transforms)
+		{
+			if(mNbCandidates==mCache.maxNbCandidates)
+			{
+				mOverflow = true;
+				return false;
+			}
+
+			PxQueryCandidate& candidate = mCache.candidates[mNbCandidates++];
+			candidate.payload[0] = payloads[primIndex].data[0];
+			candidate.payload[1] = payloads[primIndex].data[1];
+			candidate.pose = transforms[primIndex];
+			return true;
+		}
+
+		PxQueryCandidateCache&	mCache;
+		PxU32					mNbCandidates;
+		bool					mOverflow;
+
+		PX_NOCOPY(CandidateCaptureCallback)
+	};
+}
+
+PX_COMPILE_TIME_ASSERT(sizeof(PrunerPayload)==sizeof(PxQueryCandidate::payload));
+
+// PT: returns true if the cached candidates can replace the traversal of 'cachedPruners' for a query whose pruner-level
+// bounds are 'queryBounds'. New candidates are captured when the query volume left the cached volume, or when the set
+// of cached pruners or their content changed since the last capture.
+static bool useCandidateCache(PxQueryCandidateCache& cache, const void* owner, const ExtPrunerManager& manager, PxU32 cachedPruners, PxU32 timestamp, const PxBounds3& queryBounds)
+{
+	if(!cachedPruners)
+	{
+		cache.nbMisses++;
+		return false;
+	}
+
+	if(cache.owner==owner && cache.prunerMask==cachedPruners && cache.timestamp==timestamp && queryBounds.isInside(cache.cachedBounds))
+	{
+		// PT: if the last capture overflowed the buffer we don't retry for the same volume, it would overflow again
+		if(cache.nbCandidates==0xffffffff)
+		{
+			cache.nbMisses++;
+			return false;
+		}
+		cache.nbHits++;
+		return true;
+	}
+
+	cache.nbMisses++;
+	if(!cache.candidates || !cache.maxNbCandidates)
+		return false;
+
+	const PxBounds3 cachedBounds(queryBounds.minimum - PxVec3(cache.tolerance), queryBounds.maximum + PxVec3(cache.tolerance));
+
+	const PxBoxGeometry boxGeom(cachedBounds.getExtents());
+	const ShapeData sd(boxGeom, PxTransform(cachedBounds.getCenter()), 0.0f);
+	CandidateCaptureCallback cb(cache);
+	for(PxU32 i=0;i<EXT_MAX_NB_CACHED_PRUNERS && !cb.mOverflow;i++)
+	{
+		if(isCachedPruner(cachedPruners, i))
+			manager.getPruner(i)->overlap(sd, cb);
+	}
+
+	cache.cachedBounds	= cachedBounds;
+	cache.owner			= owner;
+	cache.prunerMask	= cachedPruners;
+	cache.timestamp		= timestamp;
+	cache.nbCandidates	= cb.mOverflow ? 0xffffffff : cb.mNbCandidates;
+	return !cb.mOverflow;
+}
+
+// PT: runs the narrow-phase tests against the cached candidates, in place of the cached pruners' traversals
+template<typename HitType>
+static bool doQueryVsCandidates(const PxQueryCandidateCache& cache, ExtMultiQueryCallback<HitType>& pcb)
+{
+	const PxU32 nbCandidates = cache.nbCandidates;
+	for(PxU32 i=0;i<nbCandidates;i++)
+	{
+		const PxQueryCandidate& candidate = cache.candidates[i];
+		const PrunerPayload* payload = reinterpret_cast<const PrunerPayload*>(candidate.payload);
+
+		const bool again = HitTypeSupport<HitType>::IsOverlap ? pcb.invoke(0, payload, &candidate.pose) : pcb.invoke(pcb.mShrunkDistance, 0, payload, &candidate.pose);
+		if(!again)
+			return false;
+	}
+	return true;
+}
 //~#MODIFIED
 
 // PT: the following local callbacks are for the "tree of pruners"
@@ -801,7 +925,8 @@ struct LocalBaseCallback
 		mAdapter	(adapter),
 		mHits		(hits),
 		mFilterData	(filterData),
-		mFilterCall	(filterCall)
+		mFilterCall	(filterCall),
+		mCachedPruners	(0)
 	{}
 
 	ExtMultiQueryCallback<HitType>&	mPCB;
@@ -810,10 +935,11 @@ struct LocalBaseCallback
 	PxHitCallback<HitType>&			mHits;
 	const PxQueryFilterData&		mFilterData;
 	PxQueryFilterCallback*			mFilterCall;
+	PxU32							mCachedPruners;	// Pruners already processed through a query candidate cache
 
 	PX_FORCE_INLINE	const Pruner* filtering(PxU32 prunerIndex)
 	{
-		if(!prunerFilter(mAdapter, prunerIndex, &mHits, mFilterData, mFilterCall))
+		if(isCachedPruner(mCachedPruners, prunerIndex) || !prunerFilter(mAdapter, prunerIndex, &mHits, mFilterData, mFilterCall))
 			return NULL;
 
 		return mSQManager.getPruner(prunerIndex);
@@ -921,7 +1047,7 @@ bool ExtSceneQueries::multiQuery(
 			"NpSceneQueries multiQuery input check: zero-length sweep only valid without the PxHitFlag::eASSUME_NO_INITIAL_OVERLAP flag", 0);
 	}
 
-	PX_CHECK_MSG(!cache || (cache && cache->shape && cache->actor), "Raycast cache specified but shape or actor pointer is NULL!");
+	PX_CHECK_MSG(!cache || cache->candidates || (cache->shape && cache->actor), "Raycast cache specified but shape or actor pointer is NULL!");
 	PrunerCompoundId cachedCompoundId = INVALID_COMPOUND_ID;
 	// PT: this is similar to the code in the SqRefFinder so we could share that code maybe. But here we later retrieve the payload from the PrunerData,
 	// i.e. we basically go back to the same pointers we started from. I suppose it's to make sure they get properly invalidated when an object is deleted etc,
@@ -930,7 +1056,8 @@ bool ExtSceneQueries::multiQuery(
 	// how can this work anyway? if the actor has been deleted the lookup won't work either => doc says it's up to users to manage that....
 	const ExtQueryAdapter& adapter = static_cast<const ExtQueryAdapter&>(mSQManager.getAdapter());
 	PxU32 prunerIndex = 0xffffffff;
-	const PrunerHandle cacheData = cache ? adapter.findPrunerHandle(*cache, cachedCompoundId, prunerIndex) : INVALID_PRUNERHANDLE;
+	const PrunerHandle cacheData = (cache && cache->shape && cache->actor) ? adapter.findPrunerHandle(*cache, cachedCompoundId, prunerIndex) : INVALID_PRUNERHANDLE;
+	PxQueryCandidateCache* candidateCache = (cache && HitTypeSupport<HitType>::IsRaycast == 0) ? cache->candidates : NULL;
 
 	// this function is logically const for the SDK user, as flushUpdates() will not have an API-visible effect on this object
 	// internally however, flushUpdates() changes the states of the Pruners in mSQManager
@@ -1011,9 +1138,27 @@ bool ExtSceneQueries::multiQuery(
 
 		// #MODIFIED
 		bool again = true;
+		PxU32 cachedPruners = 0;
+		if(candidateCache)
+		{
+			PxU32 timestamp;
+			const PxU32 candidates = computeCachedPruners(mSQManager, adapter, &hits, filterData, filterCall, timestamp);
+			if(useCandidateCache(*candidateCache, this, mSQManager, candidates, timestamp, sd.getPrunerInflatedWorldAABB()))
+			{
+				cachedPruners = candidates;
+				again = doQueryVsCandidates(*candidateCache, pcb);
+				if(!again)
+				{
+					cbr.again = again; // update the status to avoid duplicate processTouches()
+					return hits.hasAnyHits();
+				}
+			}
+		}
+
 		if(treeOfPruners)
 		{
 			LocalOverlapCallback<HitType> prunerOverlapCB(sd, pcb, mSQManager, adapter, hits, filterData, filterCall);
+			prunerOverlapCB.mCachedPruners = cachedPruners;
 			again = treeOfPruners->overlap(*input.geometry, *input.pose, prunerOverlapCB, PxGeometryQueryFlag::Enum(0));
 			if(!again)
 			{
@@ -1025,7 +1170,7 @@ bool ExtSceneQueries::multiQuery(
 		{
 			for(PxU32 i=0;i<nbPruners;i++)
 			{
-				if(prunerFilter(adapter, i, &hits, filterData, filterCall))
+				if(!isCachedPruner(cachedPruners, i) && prunerFilter(adapter, i, &hits, filterData, filterCall))
 				{
 					const Pruner* pruner = mSQManager.getPruner(i);
 					again = pruner->overlap(sd, pcb);
@@ -1056,9 +1201,32 @@ bool ExtSceneQueries::multiQuery(
 
 		// #MODIFIED
 		bool again = true;
+		PxU32 cachedPruners = 0;
+		if(candidateCache)
+		{
+			const PxBounds3& startBounds = sd.getPrunerInflatedWorldAABB();
+			const PxVec3 motion = input.getDir() * pcb.mShrunkDistance;
+			PxBounds3 sweptBounds = startBounds;
+			sweptBounds.include(PxBounds3(startBounds.minimum + motion, startBounds.maximum + motion));
+
+			PxU32 timestamp;
+			const PxU32 candidates = computeCachedPruners(mSQManager, adapter, &hits, filterData, filterCall, timestamp);
+			if(useCandidateCache(*candidateCache, this, mSQManager, candidates, timestamp, sweptBounds))
+			{
+				cachedPruners = candidates;
+				again = doQueryVsCandidates(*candidateCache, pcb);
+				if(!again)
+				{
+					cbr.again = again; // update the status to avoid duplicate processTouches()
+					return hits.hasAnyHits();
+				}
+			}
+		}
+
 		if(treeOfPruners)
 		{
 			LocalSweepCallback<HitType> prunerSweepCB(sd, input.getDir(), pcb, mSQManager, adapter, hits, filterData, filterCall);
+			prunerSweepCB.mCachedPruners = cachedPruners;
 			again = treeOfPruners->sweep(*input.geometry, *input.pose, input.getDir(), pcb.mShrunkDistance, prunerSweepCB, PxGeometryQueryFlag::Enum(0));
 			if(!again)
 			{
@@ -1070,7 +1238,7 @@ bool ExtSceneQueries::multiQuery(
 		{
 			for(PxU32 i=0;i<nbPruners;i++)
 			{
-				if(prunerFilter(adapter, i, &hits, filterData, filterCall))
+				if(!isCachedPruner(cachedPruners, i) && prunerFilter(adapter, i, &hits, filterData, filterCall))
 				{
 					const Pruner* pruner = mSQManager.getPruner(i);
 					again = pruner->sweep(sd, input.getDir(), pcb.mShrunkDistance, pcb);
@@ -1127,6 +1295,171 @@ bool ExtSceneQueries::_overlap(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+	// PT: same as Sq::SceneQueries::_cull(): no narrow-phase tests, objects whose bounds are not culled by the planes are
+	// reported as touches (or as the blocking hit without a touch buffer), after the regular pre- and post-filtering.
+	struct ExtCullQueryCallback : public PrunerOverlapCallback, public CompoundPrunerOverlapCallback
+	{
+		ExtCullQueryCallback(const ExtQueryAdapter& adapter, PxOverlapCallback& hitCall, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall) :
+			mAdapter	(adapter),
+			mHitCall	(hitCall),
+			mFilterData	(filterData),
+			mFilterCall	(filterCall),
+			mAnyHit		((filterData.flags & PxQueryFlag::eANY_HIT) == PxQueryFlag::eANY_HIT),
+			mNoBlock	(filterData.flags & PxQueryFlag::eNO_BLOCK),
+			mAborted	(false)
+		{
+		}
+
+		bool	_invoke(const PrunerPayload& payload)
+		{
+			PxActorShape actorShape;
+			mAdapter.getActorShape(payload, actorShape);
+
+			PxQueryHitType::Enum hitType = mHitCall.maxNbTouches ? PxQueryHitType::eTOUCH : PxQueryHitType::eBLOCK;
+
+			PxHitFlags unusedHitFlags;
+			if(!applyAllPreFiltersSQ(mAdapter, payload, actorShape, hitType, mFilterData.flags, mFilterData, mFilterCall, unusedHitFlags))
+				return true;
+
+			PxOverlapHit hit;
+			hit.actor = actorShape.actor;
+			hit.shape = actorShape.shape;
+			hit.faceIndex = 0xffffffff;
+
+			if(mFilterCall && (mFilterData.flags & PxQueryFlag::ePOSTFILTER))
+				hitType = mFilterCall->postFilter(mFilterData.data, hit, hit.shape, hit.actor);
+
+			if(hitType == PxQueryHitType::eNONE)
+				return true;
+
+			if(mAnyHit)
+			{
+				mHitCall.block = hit;
+				mHitCall.hasBlock = true;
+				return false;
+			}
+
+			if(mNoBlock)
+				hitType = PxQueryHitType::eTOUCH;
+
+			if(hitType == PxQueryHitType::eBLOCK)
+			{
+				mHitCall.block = hit;
+				mHitCall.hasBlock = true;
+				return true;
+			}
+
+			if(!mHitCall.maxNbTouches)
+				return true;
+
+			if(mHitCall.nbTouches == mHitCall.maxNbTouches)
+			{
+				if(!mHitCall.processTouches(mHitCall.touches, mHitCall.nbTouches))
+				{
+					mAborted = true;
+					return false;
+				}
+				mHitCall.nbTouches = 0;
+			}
+			mHitCall.touches[mHitCall.nbTouches++] = hit;
+			return true;
+		}
+
+		virtual bool	invoke(PxU32 primIndex, const PrunerPayload* payloads, const PxTransform*)
+		{
+			return _invoke(payloads[primIndex]);
+		}
+
+		virtual bool	invoke(PxU32 primIndex, const PrunerPayload* payloads, const PxTransform*, const PxTransform*)
+		{
+			return _invoke(payloads[primIndex]);
+		}
+
+		const ExtQueryAdapter&		mAdapter;
+		PxOverlapCallback&			mHitCall;
+		const PxQueryFilterData&	mFilterData;
+		PxQueryFilterCallback*		mFilterCall;
+		const bool					mAnyHit;
+		const bool					mNoBlock;
+		bool						mAborted;
+
+		PX_NOCOPY(ExtCullQueryCallback)
+	};
+
+	// PT: "tree of pruners" callback for culling queries
+	struct LocalCullCallback : PxBVH::OverlapCallback
+	{
+		LocalCullCallback(PxU32 nbPlanes, const PxPlane* planes, ExtCullQueryCallback& pcb, const Sq::ExtPrunerManager& manager, PxOverlapCallback& hits) :
+			mNbPlanes(nbPlanes), mPlanes(planes), mPCB(pcb), mSQManager(manager), mHits(hits)	{}
+
+		virtual bool	reportHit(PxU32 boundsIndex)
+		{
+			if(!prunerFilter(mPCB.mAdapter, boundsIndex, &mHits, mPCB.mFilterData, mPCB.mFilterCall))
+				return true;
+			return mSQManager.getPruner(boundsIndex)->cull(mNbPlanes, mPlanes, mPCB);
+		}
+
+		const PxU32					mNbPlanes;
+		const PxPlane*				mPlanes;
+		ExtCullQueryCallback&		mPCB;
+		const Sq::ExtPrunerManager&	mSQManager;
+		PxOverlapCallback&			mHits;
+
+		PX_NOCOPY(LocalCullCallback)
+	};
+}
+
+bool ExtSceneQueries::_cull(
+	PxU32 nbPlanes, const PxPlane* planes, PxOverlapCallback& hits,
+	const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall, PxGeometryQueryFlags flags) const
+{
+	PX_PROFILE_ZONE("SceneQuery.cull", getContextId());
+	PX_SIMD_GUARD_CNDT(flags & PxGeometryQueryFlag::eSIMD_GUARD)
+
+	PX_CHECK_AND_RETURN_VAL(planes || !nbPlanes, "PxSceneQuerySystem::cull(): planes pointer is NULL.", false);
+	PX_CHECK_AND_RETURN_VAL(nbPlanes <= 32, "PxSceneQuerySystem::cull(): only 32 planes max are supported.", false);
+	PX_CHECK_AND_RETURN_VAL(hits.maxNbTouches > 0 || (filterData.flags & PxQueryFlag::eANY_HIT), "PxSceneQuerySystem::cull() calls without eANY_HIT flag require a touch hit buffer for return results.", false);
+
+	// see multiQuery() for the const_cast
+	const_cast<ExtSceneQueries*>(this)->mSQManager.flushUpdates();
+
+	ExtIssueCallbacksOnReturn<PxOverlapHit> cbr(hits); // destructor will execute callbacks on return from this function
+	hits.hasBlock = false;
+	hits.nbTouches = 0;
+
+	const ExtQueryAdapter& adapter = static_cast<const ExtQueryAdapter&>(mSQManager.getAdapter());
+	ExtCullQueryCallback pcb(adapter, hits, filterData, filterCall);
+
+	bool again = true;
+	const BVH* treeOfPruners = mSQManager.getTreeOfPruners();
+	if(treeOfPruners)
+	{
+		LocalCullCallback prunerCullCB(nbPlanes, planes, pcb, mSQManager, hits);
+		again = treeOfPruners->cull(nbPlanes, planes, prunerCullCB, PxGeometryQueryFlag::Enum(0));
+	}
+	else
+	{
+		const PxU32 nbPruners = mSQManager.getNbPruners();
+		for(PxU32 i=0;i<nbPruners && again;i++)
+		{
+			if(prunerFilter(adapter, i, &hits, filterData, filterCall))
+				again = mSQManager.getPruner(i)->cull(nbPlanes, planes, pcb);
+		}
+	}
+
+	const CompoundPruner* compoundPruner = mSQManager.getCompoundPruner();
+	if(again && compoundPruner)
+		again = compoundPruner->cull(nbPlanes, planes, pcb, convertFlags(filterData.flags));
+
+	// PT: only skip the final processTouches() call if the user callback stopped the query
+	cbr.again = !pcb.mAborted;
+	return hits.hasAnyHits();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 bool ExtSceneQueries::_sweep(
 	const PxGeometry& geometry, const PxTransform& pose, const PxVec3& unitDir, const PxReal distance,
 	PxHitCallback<PxSweepHit>& hits, PxHitFlags hitFlags, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
@@ -0,0 +1,436 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "extensions/PxTiledHeightField.h"
+#include "extensions/PxRigidActorExt.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxUserAllocated.h"
+#include "geometry/PxHeightField.h"
+#include "geometry/PxHeightFieldDesc.h"
+#include "geometry/PxHeightFieldGeometry.h"
+#include "geometry/PxGeometryQuery.h"
+#include "cooking/PxCooking.h"
+#include "PxPhysics.h"
+#include "PxScene.h"
+#include "PxRigidStatic.h"
+
+using namespace physx;
+
+namespace
+{
+	struct Tile
+	{
+		PxRigidStatic*	mActor;
+		PxShape*		mShape;
+		PxHeightField*	mHeightField;
+		bool			mDirty;		// Samples changed since the last flushModifications() call
+		bool			mModified;	// Samples changed since the tile was loaded
+		PxU32			mFailedUpdate;	// Last updateStreaming() call in which the source could not provide the tile
+	};
+
+	class TiledHeightField : public PxTiledHeightField, public PxUserAllocated
+	{
+		public:
+									TiledHeightField(PxPhysics& physics, PxScene& scene, const PxTiledHeightFieldDesc& desc);
+		virtual						~TiledHeightField();
+
+		// PxTiledHeightField
+		virtual	void				release()	PX_OVERRIDE;
+		virtual	bool				loadTile(PxU32 tileRow, PxU32 tileColumn)	PX_OVERRIDE;
+		virtual	void				evictTile(PxU32 tileRow, PxU32 tileColumn)	PX_OVERRIDE;
+		virtual	bool				isTileLoaded(PxU32 tileRow, PxU32 tileColumn)	const	PX_OVERRIDE;
+		virtual	PxU32				getNbLoadedTiles()	const	PX_OVERRIDE	{ return mNbLoadedTiles;	}
+		virtual	PxU32				updateStreaming(const PxVec3& center, PxReal loadRadius)	PX_OVERRIDE;
+		virtual	PxU32				modifySamples(PxU32 startRow, PxU32 startColumn, PxU32 nbRows, PxU32 nbColumns, const PxHeightFieldSample* samples)	PX_OVERRIDE;
+		virtual	PxU32				flushModifications()	PX_OVERRIDE;
+		virtual	bool				getTileBounds(PxU32 tileRow, PxU32 tileColumn, PxBounds3& bounds)	const	PX_OVERRIDE;
+		virtual	PxRigidStatic*		getTileActor(PxU32 tileRow, PxU32 tileColumn)	const	PX_OVERRIDE;
+		virtual	PxHeightField*		getTileHeightField(PxU32 tileRow, PxU32 tileColumn)	const	PX_OVERRIDE;
+		virtual	const PxTiledHeightFieldDesc&	getDesc()	const	PX_OVERRIDE	{ return mDesc;	}
+		//~PxTiledHeightField
+
+		private:
+				PxPhysics&					mPhysics;
+				PxScene&					mScene;
+				PxTiledHeightFieldDesc		mDesc;
+				PxArray<PxMaterial*>		mMaterials;
+				PxArray<Tile>				mTiles;
+				PxArray<PxHeightFieldSample>	mTileSamples;	// Scratch buffer for one tile
+				PxArray<PxU32>				mDirtyTiles;
+				PxU32						mNbLoadedTiles;
+				PxU32						mUpdateCount;
+
+		PX_FORCE_INLINE	PxU32				getTileIndex(PxU32 tileRow, PxU32 tileColumn)	const
+											{
+												PX_ASSERT(tileRow<mDesc.nbTileRows && tileColumn<mDesc.nbTileColumns);
+												return tileRow * mDesc.nbTileColumns + tileColumn;
+											}
+
+		PX_FORCE_INLINE	bool				isValidTile(PxU32 tileRow, PxU32 tileColumn)	const
+											{
+												return tileRow<mDesc.nbTileRows && tileColumn<mDesc.nbTileColumns;
+											}
+
+		PX_FORCE_INLINE	PxHeightFieldGeometry	getTileGeometry(const Tile& tile)	const
+											{
+												return PxHeightFieldGeometry(tile.mHeightField, PxMeshGeometryFlags(), mDesc.heightScale, mDesc.rowScale, mDesc.columnScale);
+											}
+
+						PxTransform			getTilePose(PxU32 tileRow, PxU32 tileColumn)	const;
+						PxReal				getTileSquareDistance(PxU32 tileRow, PxU32 tileColumn, PxReal localX, PxReal localZ)	const;
+	};
+}
+
+TiledHeightField::TiledHeightField(PxPhysics& physics, PxScene& scene, const PxTiledHeightFieldDesc& desc) :
+	mPhysics		(physics),
+	mScene			(scene),
+	mDesc			(desc),
+	mNbLoadedTiles	(0),
+	mUpdateCount	(0)
+{
+	// Copy the materials so that the user's array does not need to outlive the tiled heightfield
+	mMaterials.resize(desc.nbMaterials);
+	for(PxU32 i=0;i<desc.nbMaterials;i++)
+		mMaterials[i] = desc.materials[i];
+	mDesc.materials = mMaterials.begin();
+
+	const PxU32 nbTiles = desc.nbTileRows * desc.nbTileColumns;
+	mTiles.resize(nbTiles);
+	for(PxU32 i=0;i<nbTiles;i++)
+	{
+		Tile& tile = mTiles[i];
+		tile.mActor			= NULL;
+		tile.mShape			= NULL;
+		tile.mHeightField	= NULL;
+		tile.mDirty			= false;
+		tile.mModified		= false;
+		tile.mFailedUpdate	= 0;
+	}
+
+	const PxU32 nbTileSamples = (desc.tileSize + 1) * (desc.tileSize + 1);
+	mTileSamples.resize(nbTileSamples);
+}
+
+TiledHeightField::~TiledHeightField()
+{
+}
+
+void TiledHeightField::release()
+{
+	for(PxU32 i=0;i<mDesc.nbTileRows;i++)
+		for(PxU32 j=0;j<mDesc.nbTileColumns;j++)
+			evictTile(i, j);
+
+	PX_DELETE_THIS;
+}
+
+PxTransform TiledHeightField::getTilePose(PxU32 tileRow, PxU32 tileColumn) const
+{
+	// Heightfield rows go along the local x axis, columns along the local z axis
+	const PxVec3 offset(PxReal(tileRow * mDesc.tileSize) * mDesc.rowScale, 0.0f, PxReal(tileColumn * mDesc.tileSize) * mDesc.columnScale);
+	return mDesc.pose * PxTransform(offset);
+}
+
+PxReal TiledHeightField::getTileSquareDistance(PxU32 tileRow, PxU32 tileColumn, PxReal localX, PxReal localZ) const
+{
+	const PxReal tileSizeX = PxReal(mDesc.tileSize) * mDesc.rowScale;
+	const PxReal tileSizeZ = PxReal(mDesc.tileSize) * mDesc.columnScale;
+	const PxReal minX = PxReal(tileRow) * tileSizeX;
+	const PxReal minZ = PxReal(tileColumn) * tileSizeZ;
+	const PxReal dx = PxMax(PxMax(minX - localX, localX - (minX + tileSizeX)), 0.0f);
+	const PxReal dz = PxMax(PxMax(minZ - localZ, localZ - (minZ + tileSizeZ)), 0.0f);
+	return dx*dx + dz*dz;
+}
+
+bool TiledHeightField::loadTile(PxU32 tileRow, PxU32 tileColumn)
+{
+	PX_CHECK_AND_RETURN_VAL(isValidTile(tileRow, tileColumn), "PxTiledHeightField::loadTile: invalid tile coordinates", false);
+
+	Tile& tile = mTiles[getTileIndex(tileRow, tileColumn)];
+	if(tile.mActor)
+		return true;
+
+	if(!mDesc.source->loadTile(tileRow, tileColumn, mTileSamples.begin()))
+		return false;
+
+	PxHeightFieldDesc hfDesc;
+	hfDesc.format				= PxHeightFieldFormat::eS16_TM;
+	hfDesc.nbRows				= mDesc.tileSize + 1;
+	hfDesc.nbColumns			= mDesc.tileSize + 1;
+	hfDesc.samples.data			= mTileSamples.begin();
+	hfDesc.samples.stride		= sizeof(PxHeightFieldSample);
+	hfDesc.flags				= mDesc.heightFieldFlags;
+
+	PxHeightField* heightField = PxCreateHeightField(hfDesc, mPhysics.getPhysicsInsertionCallback());
+	if(!heightField)
+		return false;
+
+	PxRigidStatic* actor = mPhysics.createRigidStatic(getTilePose(tileRow, tileColumn));
+	if(!actor)
+	{
+		heightField->release();
+		return false;
+	}
+
+	tile.mHeightField = heightField;
+	PxShape* shape = PxRigidActorExt::createExclusiveShape(*actor, getTileGeometry(tile), mDesc.materials, mDesc.nbMaterials, mDesc.shapeFlags);
+	if(!shape)
+	{
+		actor->release();
+		heightField->release();
+		tile.mHeightField = NULL;
+		return false;
+	}
+
+	mScene.addActor(*actor);
+
+	tile.mActor		= actor;
+	tile.mShape		= shape;
+	tile.mDirty		= false;
+	tile.mModified	= false;
+	mNbLoadedTiles++;
+	return true;
+}
+
+void TiledHeightField::evictTile(PxU32 tileRow, PxU32 tileColumn)
+{
+	PX_CHECK_AND_RETURN(isValidTile(tileRow, tileColumn), "PxTiledHeightField::evictTile: invalid tile coordinates");
+
+	Tile& tile = mTiles[getTileIndex(tileRow, tileColumn)];
+	if(!tile.mActor)
+		return;
+
+	if(tile.mModified)
+	{
+		tile.mHeightField->saveCells(mTileSamples.begin(), mTileSamples.size() * sizeof(PxHeightFieldSample));
+		mDesc.source->storeTile(tileRow, tileColumn, mTileSamples.begin());
+	}
+
+	// The dirty list is only walked in flushModifications(), which skips evicted tiles
+	tile.mActor->release();
+	tile.mHeightField->release();
+	tile.mActor			= NULL;
+	tile.mShape			= NULL;
+	tile.mHeightField	= NULL;
+	tile.mModified		= false;
+	PX_ASSERT(mNbLoadedTiles);
+	mNbLoadedTiles--;
+}
+
+bool TiledHeightField::isTileLoaded(PxU32 tileRow, PxU32 tileColumn) const
+{
+	if(!isValidTile(tileRow, tileColumn))
+		return false;
+	return mTiles[getTileIndex(tileRow, tileColumn)].mActor != NULL;
+}
+
+PxU32 TiledHeightField::updateStreaming(const PxVec3& center, PxReal loadRadius)
+{
+	const PxVec3 localCenter = mDesc.pose.transformInv(center);
+	const PxReal loadRadius2 = loadRadius * loadRadius;
+	const PxReal evictionRadius = loadRadius * mDesc.evictionRadiusScale;
+	const PxReal evictionRadius2 = evictionRadius * evictionRadius;
+
+	// Evict distant tiles first, to free memory before loading new ones
+	for(PxU32 i=0;i<mDesc.nbTileRows;i++)
+	{
+		for(PxU32 j=0;j<mDesc.nbTileColumns;j++)
+		{
+			if(mTiles[getTileIndex(i, j)].mActor && getTileSquareDistance(i, j, localCenter.x, localCenter.z) > evictionRadius2)
+				evictTile(i, j);
+		}
+	}
+
+	// Only visit tiles overlapping the loading radius
+	const PxReal tileSizeX = PxReal(mDesc.tileSize) * mDesc.rowScale;
+	const PxReal tileSizeZ = PxReal(mDesc.tileSize) * mDesc.columnScale;
+	const PxReal minX = (localCenter.x - loadRadius) / tileSizeX;
+	const PxReal maxX = (localCenter.x + loadRadius) / tileSizeX;
+	const PxReal minZ = (localCenter.z - loadRadius) / tileSizeZ;
+	const PxReal maxZ = (localCenter.z + loadRadius) / tileSizeZ;
+	if(maxX<0.0f || maxZ<0.0f || minX>=PxReal(mDesc.nbTileRows) || minZ>=PxReal(mDesc.nbTileColumns))
+		return 0;
+
+	const PxU32 startRow	= minX>0.0f ? PxU32(minX) : 0;
+	const PxU32 startColumn	= minZ>0.0f ? PxU32(minZ) : 0;
+	const PxU32 endRow		= PxMin(PxU32(maxX), mDesc.nbTileRows-1);
+	const PxU32 endColumn	= PxMin(PxU32(maxZ), mDesc.nbTileColumns-1);
+
+	const PxU32 updateIndex = ++mUpdateCount;
+
+	PxU32 nbLoaded = 0;
+	for(PxU32 nbAttempts=0; nbAttempts<mDesc.maxLoadsPerUpdate; nbAttempts++)
+	{
+		// Load the closest missing tile. The number of tiles in the loading radius is small so a linear search is fine.
+		PxReal bestDistance2 = PX_MAX_REAL;
+		PxU32 bestRow = 0xffffffff;
+		PxU32 bestColumn = 0xffffffff;
+		for(PxU32 i=startRow;i<=endRow;i++)
+		{
+			for(PxU32 j=startColumn;j<=endColumn;j++)
+			{
+				const Tile& tile = mTiles[getTileIndex(i, j)];
+				if(tile.mActor || tile.mFailedUpdate==updateIndex)
+					continue;
+
+				const PxReal d2 = getTileSquareDistance(i, j, localCenter.x, localCenter.z);
+				if(d2<=loadRadius2 && d2<bestDistance2)
+				{
+					bestDistance2 = d2;
+					bestRow = i;
+					bestColumn = j;
+				}
+			}
+		}
+
+		if(bestRow==0xffffffff)
+			break;
+
+		// Tiles that the source cannot provide count against the per-update budget, and are retried in the next call
+		if(loadTile(bestRow, bestColumn))
+			nbLoaded++;
+		else
+			mTiles[getTileIndex(bestRow, bestColumn)].mFailedUpdate = updateIndex;
+	}
+	return nbLoaded;
+}
+
+PxU32 TiledHeightField::modifySamples(PxU32 startRow, PxU32 startColumn, PxU32 nbRows, PxU32 nbColumns, const PxHeightFieldSample* samples)
+{
+	if(!nbRows || !nbColumns)
+		return 0;
+	PX_CHECK_AND_RETURN_VAL(samples, "PxTiledHeightField::modifySamples: samples is NULL", 0);
+
+	const PxU32 tileSize = mDesc.tileSize;
+	const PxU32 endRow = startRow + nbRows - 1;
+	const PxU32 endColumn = startColumn + nbColumns - 1;
+
+	// Samples on tile borders belong to two (or four) tiles, so the range of touched tiles starts one tile earlier when needed.
+	const PxU32 firstTileRow	= startRow ? (startRow - 1) / tileSize : 0;
+	const PxU32 firstTileColumn	= startColumn ? (startColumn - 1) / tileSize : 0;
+	const PxU32 lastTileRow		= PxMin(endRow / tileSize, mDesc.nbTileRows - 1);
+	const PxU32 lastTileColumn	= PxMin(endColumn / tileSize, mDesc.nbTileColumns - 1);
+
+	// The heightfield's modifySamples() clips the source rectangle against the tile, so we can pass the whole user
+	// rectangle with a tile-relative (possibly negative) offset.
+	PxHeightFieldDesc subfieldDesc;
+	subfieldDesc.format			= PxHeightFieldFormat::eS16_TM;
+	subfieldDesc.nbRows			= nbRows;
+	subfieldDesc.nbColumns		= nbColumns;
+	subfieldDesc.samples.data	= samples;
+	subfieldDesc.samples.stride	= sizeof(PxHeightFieldSample);
+
+	PxU32 nbTouched = 0;
+	for(PxU32 i=firstTileRow;i<=lastTileRow;i++)
+	{
+		const PxU32 tileStartRow = i * tileSize;
+		if(endRow<tileStartRow || startRow>tileStartRow + tileSize)
+			continue;
+
+		for(PxU32 j=firstTileColumn;j<=lastTileColumn;j++)
+		{
+			const PxU32 tileStartColumn = j * tileSize;
+			if(endColumn<tileStartColumn || startColumn>tileStartColumn + tileSize)
+				continue;
+
+			const PxU32 tileIndex = getTileIndex(i, j);
+			Tile& tile = mTiles[tileIndex];
+			if(!tile.mActor)
+				continue;
+
+			// Bounds are not shrunk here, flushModifications() recomputes them once per tile
+			tile.mHeightField->modifySamples(PxI32(startColumn) - PxI32(tileStartColumn), PxI32(startRow) - PxI32(tileStartRow), subfieldDesc, false);
+
+			if(!tile.mDirty)
+			{
+				tile.mDirty = true;
+				mDirtyTiles.pushBack(tileIndex);
+			}
+			tile.mModified = true;
+			nbTouched++;
+		}
+	}
+	return nbTouched;
+}
+
+PxU32 TiledHeightField::flushModifications()
+{
+	// An empty modification with shrinkBounds=true recomputes the exact height range of a tile
+	PxHeightFieldDesc emptyDesc;
+	emptyDesc.format	= PxHeightFieldFormat::eS16_TM;
+	emptyDesc.nbRows	= 0;
+	emptyDesc.nbColumns	= 0;
+
+	PxU32 nbUpdated = 0;
+	const PxU32 nbDirty = mDirtyTiles.size();
+	for(PxU32 i=0;i<nbDirty;i++)
+	{
+		Tile& tile = mTiles[mDirtyTiles[i]];
+		if(!tile.mDirty)
+			continue;
+		tile.mDirty = false;
+
+		// The tile might have been evicted since it was modified
+		if(!tile.mActor)
+			continue;
+
+		tile.mHeightField->modifySamples(0, 0, emptyDesc, true);
+
+		// Setting the geometry again refreshes the shape's bounds in the broadphase and scene-query structures
+		tile.mShape->setGeometry(getTileGeometry(tile));
+		nbUpdated++;
+	}
+	mDirtyTiles.clear();
+	return nbUpdated;
+}
+
+bool TiledHeightField::getTileBounds(PxU32 tileRow, PxU32 tileColumn, PxBounds3& bounds) const
+{
+	if(!isTileLoaded(tileRow, tileColumn))
+		return false;
+
+	const Tile& tile = mTiles[getTileIndex(tileRow, tileColumn)];
+	PxGeometryQuery::computeGeomBounds(bounds, getTileGeometry(tile), getTilePose(tileRow, tileColumn));
+	return true;
+}
+
+PxRigidStatic* TiledHeightField::getTileActor(PxU32 tileRow, PxU32 tileColumn) const
+{
+	return isValidTile(tileRow, tileColumn) ? mTiles[getTileIndex(tileRow, tileColumn)].mActor : NULL;
+}
+
+PxHeightField* TiledHeightField::getTileHeightField(PxU32 tileRow, PxU32 tileColumn) const
+{
+	return isValidTile(tileRow, tileColumn) ? mTiles[getTileIndex(tileRow, tileColumn)].mHeightField : NULL;
+}
+
+PxTiledHeightField* physx::PxCreateTiledHeightField(PxPhysics& physics, PxScene& scene, const PxTiledHeightFieldDesc& desc)
+{
+	PX_CHECK_AND_RETURN_NULL(desc.isValid(), "PxCreateTiledHeightField: invalid descriptor");
+	return PX_NEW(TiledHeightField)(physics, scene, desc);
+}
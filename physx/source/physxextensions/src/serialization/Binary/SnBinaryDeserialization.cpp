@@ -35,11 +35,12 @@
 #include "PxPhysicsSerialization.h"
 
 #include "SnFile.h"
-#include "SnSerializationContext.h"
+#include "SnBinaryDeserialization.h"
 #include "SnConvX_Align.h"
 #include "serialization/SnSerializationRegistry.h"
 #include "serialization/SnSerialUtils.h"
 #include "CmCollection.h"
+#include "GuBuildTask.h"
 
 using namespace physx;
 using namespace Sn;
@@ -143,161 +144,335 @@ namespace
 		}
 		return true;
 	}
-	
+
+	// Creates the objects of a single level. Each batch of objects uses its own deserialization context, positioned
+	// on the extra data of each object using the object load table.
+	class CreateObjectsFunc
+	{
+	public:
+		CreateObjectsFunc(const SerializationRegistry& sn, const PxU32* objectIndices, const ManifestEntry* manifestTable, const ObjectLoadEntry* objectLoadTable,
+			const ImportReference* importReferences, PxU8* addressObjectData, PxU8* addressExtraData,
+			const InternalPtrRefMap& internalPtrReferencesMap, const InternalHandle16RefMap& internalHandle16ReferencesMap, const Cm::Collection* externalRefs,
+			PxBase** instances) :
+			mSn(sn), mObjectIndices(objectIndices), mManifestTable(manifestTable), mObjectLoadTable(objectLoadTable), mImportReferences(importReferences),
+			mAddressObjectData(addressObjectData), mAddressExtraData(addressExtraData), mInternalPtrReferencesMap(internalPtrReferencesMap),
+			mInternalHandle16ReferencesMap(internalHandle16ReferencesMap), mExternalRefs(externalRefs), mInstances(instances)
+		{
+		}
+
+		void operator()(PxU32 start, PxU32 end)
+		{
+			DeserializationContext context(mManifestTable, mImportReferences, mAddressObjectData, mInternalPtrReferencesMap, mInternalHandle16ReferencesMap, mExternalRefs, mAddressExtraData);
+			for(PxU32 i=start;i<end;i++)
+			{
+				const PxU32 objectIndex = mObjectIndices[i];
+				PxU8* address = mAddressObjectData + mManifestTable[objectIndex].offset;
+				context.setExtraDataAddress(mAddressExtraData + mObjectLoadTable[objectIndex].extraDataOffset);
+
+				const PxType classType = reinterpret_cast<PxBase*>(address)->getConcreteType();
+				const PxSerializer* serializer = mSn.getSerializer(classType);
+				PX_ASSERT(serializer);
+
+				mInstances[objectIndex] = serializer->createObject(address, context);
+				if(!mInstances[objectIndex])
+					PxGetFoundation().error(physx::PxErrorCode::eINVALID_PARAMETER, __FILE__, __LINE__, 
+						"Cannot create class instance for concrete type %d.", classType);
+			}
+		}
+
+	private:
+		const SerializationRegistry&	mSn;
+		const PxU32*					mObjectIndices;
+		const ManifestEntry*			mManifestTable;
+		const ObjectLoadEntry*			mObjectLoadTable;
+		const ImportReference*			mImportReferences;
+		PxU8*							mAddressObjectData;
+		PxU8*							mAddressExtraData;
+		const InternalPtrRefMap&		mInternalPtrReferencesMap;
+		const InternalHandle16RefMap&	mInternalHandle16ReferencesMap;
+		const Cm::Collection*			mExternalRefs;
+		PxBase**						mInstances;
+
+		CreateObjectsFunc& operator=(const CreateObjectsFunc&);
+	};
+
+	// Objects of a level only depend on objects of lower levels, so levels are created one after the other and the
+	// objects within a level are distributed over the dispatcher's worker threads.
+	bool createObjectsInParallel(PxCpuDispatcher* dispatcher, const SerializationRegistry& sn, PxU32 nbObjects, const ManifestEntry* manifestTable, const ObjectLoadEntry* objectLoadTable,
+		const ImportReference* importReferences, PxU8* addressObjectData, PxU8* addressExtraData,
+		const InternalPtrRefMap& internalPtrReferencesMap, const InternalHandle16RefMap& internalHandle16ReferencesMap, const Cm::Collection* externalRefs,
+		PxBase** instances)
+	{
+		// counting sort of the objects by level, keeping the serialized order within each level
+		PxU32 nbLevels = 0;
+		for(PxU32 i=0;i<nbObjects;i++)
+			nbLevels = PxMax(nbLevels, objectLoadTable[i].level + 1);
+
+		PxArray<PxU32> levelStarts(nbLevels + 1, 0);
+		for(PxU32 i=0;i<nbObjects;i++)
+			levelStarts[objectLoadTable[i].level + 1]++;
+		for(PxU32 i=0;i<nbLevels;i++)
+			levelStarts[i + 1] += levelStarts[i];
+
+		PxArray<PxU32> objectIndices(nbObjects);
+		{
+			PxArray<PxU32> offsets(levelStarts);
+			for(PxU32 i=0;i<nbObjects;i++)
+				objectIndices[offsets[objectLoadTable[i].level]++] = i;
+		}
+
+		for(PxU32 i=0;i<nbLevels;i++)
+		{
+			CreateObjectsFunc func(sn, objectIndices.begin() + levelStarts[i], manifestTable, objectLoadTable, importReferences, addressObjectData, addressExtraData,
+				internalPtrReferencesMap, internalHandle16ReferencesMap, externalRefs, instances);
+			Gu::runParallelRanges(dispatcher, levelStarts[i + 1] - levelStarts[i], 256, func);
+		}
+
+		for(PxU32 i=0;i<nbObjects;i++)
+		{
+			if(!instances[i])
+				return false;
+		}
+		return true;
+	}
+}
+
+BinaryCollectionLoader::BinaryCollectionLoader() :
+	mSn						(NULL),
+	mExternalRefs			(NULL),
+	mCollection				(NULL),
+	mContext				(NULL),
+	mManifestTable			(NULL),
+	mImportReferences		(NULL),
+	mExportReferences		(NULL),
+	mObjectLoadTable		(NULL),
+	mNbObjects				(0),
+	mNbExportReferences		(0),
+	mNbObjectLoadEntries	(0),
+	mNbCreatedObjects		(0),
+	mInternalPtrReferences			(NULL),
+	mInternalHandle16References		(NULL),
+	mNbInternalPtrReferences		(0),
+	mNbInternalHandle16References	(0),
+	mNbMappedReferences				(0),
+	mAddressObjectData		(NULL),
+	mAddressExtraData		(NULL),
+	mAddress				(NULL)
+{
+}
+
+BinaryCollectionLoader::~BinaryCollectionLoader()
+{
+	PX_DELETE(mContext);
+	if(mCollection)
+		mCollection->release();
 }
 
-PxCollection* PxSerialization::createCollectionFromBinary(void* memBlock, PxSerializationRegistry& sr, const PxCollection* pxExternalRefs)
+bool BinaryCollectionLoader::begin(void* memBlock, SerializationRegistry& sn, const Cm::Collection* externalRefs)
 {
+	PX_ASSERT(!mCollection);
 #if PX_CHECKED
 	if(size_t(memBlock) & (PX_SERIAL_FILE_ALIGN-1))
 	{
 		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, __FILE__, __LINE__, "Buffer must be 128-bytes aligned.");
-		return NULL;
+		return false;
 	}
 #endif
 	PxU8* address = reinterpret_cast<PxU8*>(memBlock);
-	const Cm::Collection* externalRefs = static_cast<const Cm::Collection*>(pxExternalRefs);
 			
 	if (!readHeader(address))
 	{
-		return NULL;
+		return false;
 	}
 
-	ManifestEntry* manifestTable;
-	PxU32 nbObjectsInCollection;
 	PxU32 objectDataEndOffset;
 
 	// read number of objects in collection
 	address = alignPtr(address);
-	nbObjectsInCollection = read32(address);
+	mNbObjects = read32(address);
 
 	// read manifest (PxU32 offset, PxConcreteType type)
 	{
 		address = alignPtr(address);
 		PxU32 nbManifestEntries = read32(address);
 		PX_ASSERT(*reinterpret_cast<PxU32*>(address) == 0); //first offset is always 0
-		manifestTable = (nbManifestEntries > 0) ? reinterpret_cast<ManifestEntry*>(address) : NULL;
+		mManifestTable = (nbManifestEntries > 0) ? reinterpret_cast<ManifestEntry*>(address) : NULL;
 		address += nbManifestEntries*sizeof(ManifestEntry);
 		objectDataEndOffset = read32(address);
 	}
 
-	ImportReference* importReferences;
 	PxU32 nbImportReferences;
 	// read import references
 	{
 		address = alignPtr(address);
 		nbImportReferences = read32(address);
-		importReferences = (nbImportReferences > 0) ? reinterpret_cast<ImportReference*>(address) : NULL;
+		mImportReferences = (nbImportReferences > 0) ? reinterpret_cast<ImportReference*>(address) : NULL;
 		address += nbImportReferences*sizeof(ImportReference);
 	}
 
-	if (!checkImportReferences(importReferences, nbImportReferences, externalRefs))
+	if (!checkImportReferences(mImportReferences, nbImportReferences, externalRefs))
 	{
-		return NULL;
+		return false;
 	}
 
-	ExportReference* exportReferences;
-	PxU32 nbExportReferences;
 	// read export references
 	{
 		address = alignPtr(address);
-		nbExportReferences = read32(address);
-		exportReferences = (nbExportReferences > 0) ? reinterpret_cast<ExportReference*>(address) : NULL;
-		address += nbExportReferences*sizeof(ExportReference);
+		mNbExportReferences = read32(address);
+		mExportReferences = (mNbExportReferences > 0) ? reinterpret_cast<ExportReference*>(address) : NULL;
+		address += mNbExportReferences*sizeof(ExportReference);
 	}
 
 	// read internal references arrays
-	PxU32 nbInternalPtrReferences = 0;
-	PxU32 nbInternalHandle16References = 0;
-	InternalReferencePtr* internalPtrReferences = NULL;
-	InternalReferenceHandle16* internalHandle16References = NULL;
 	{
 		address = alignPtr(address);
 
-		nbInternalPtrReferences = read32(address);
-		internalPtrReferences = (nbInternalPtrReferences > 0) ? reinterpret_cast<InternalReferencePtr*>(address) : NULL;
-		address += nbInternalPtrReferences*sizeof(InternalReferencePtr);
+		mNbInternalPtrReferences = read32(address);
+		mInternalPtrReferences = (mNbInternalPtrReferences > 0) ? reinterpret_cast<InternalReferencePtr*>(address) : NULL;
+		address += mNbInternalPtrReferences*sizeof(InternalReferencePtr);
 
-		nbInternalHandle16References = read32(address);
-		internalHandle16References = (nbInternalHandle16References > 0) ? reinterpret_cast<InternalReferenceHandle16*>(address) : NULL;
-		address += nbInternalHandle16References*sizeof(InternalReferenceHandle16);
+		mNbInternalHandle16References = read32(address);
+		mInternalHandle16References = (mNbInternalHandle16References > 0) ? reinterpret_cast<InternalReferenceHandle16*>(address) : NULL;
+		address += mNbInternalHandle16References*sizeof(InternalReferenceHandle16);
 	}
 
-	// create internal references map
-	InternalPtrRefMap internalPtrReferencesMap(nbInternalPtrReferences*2);
+	// read object load table
 	{
-		//create hash (we should load the hashes directly from memory)
-		for (PxU32 i = 0; i < nbInternalPtrReferences; i++)
-		{
-			const InternalReferencePtr& ref = internalPtrReferences[i];
-			internalPtrReferencesMap.insertUnique(ref.reference, SerialObjectIndex(ref.objIndex));
-		}
+		address = alignPtr(address);
+		mNbObjectLoadEntries = read32(address);
+		mObjectLoadTable = (mNbObjectLoadEntries > 0) ? reinterpret_cast<ObjectLoadEntry*>(address) : NULL;
+		address += mNbObjectLoadEntries*sizeof(ObjectLoadEntry);
 	}
-	InternalHandle16RefMap internalHandle16ReferencesMap(nbInternalHandle16References*2);
+
+	// internal references maps are filled by mapInternalReferences()
+	mInternalPtrReferencesMap.reserve(mNbInternalPtrReferences*2);
+	mInternalHandle16ReferencesMap.reserve(mNbInternalHandle16References*2);
+
+	mSn = &sn;
+	mExternalRefs = externalRefs;
+	mCollection = static_cast<Cm::Collection*>(PxCreateCollection());
+	PX_ASSERT(mCollection);
+	mCollection->mObjects.reserve(mNbObjects*2);
+	if(mNbExportReferences > 0)
+	    mCollection->mIds.reserve(mNbExportReferences*2);
+
+	mAddressObjectData = alignPtr(address);
+	mAddressExtraData = alignPtr(mAddressObjectData + objectDataEndOffset);
+	mAddress = mAddressObjectData;
+
+	mContext = PX_NEW(DeserializationContext)(mManifestTable, mImportReferences, mAddressObjectData, mInternalPtrReferencesMap, mInternalHandle16ReferencesMap, mExternalRefs, mAddressExtraData);
+	return true;
+}
+
+void BinaryCollectionLoader::mapInternalReferences(PxU32 maxNbReferences)
+{
+	//create hash (we should load the hashes directly from memory)
+	while(maxNbReferences && mNbMappedReferences < mNbInternalPtrReferences)
 	{
-		for (PxU32 i=0;i<nbInternalHandle16References;i++)
-		{
-			const InternalReferenceHandle16& ref = internalHandle16References[i];
-			internalHandle16ReferencesMap.insertUnique(ref.reference, SerialObjectIndex(ref.objIndex));
-		}
+		const InternalReferencePtr& ref = mInternalPtrReferences[mNbMappedReferences++];
+		mInternalPtrReferencesMap.insertUnique(ref.reference, SerialObjectIndex(ref.objIndex));
+		maxNbReferences--;
 	}
 
-	SerializationRegistry& sn = static_cast<SerializationRegistry&>(sr);
-	Cm::Collection* collection = static_cast<Cm::Collection*>(PxCreateCollection());
-	PX_ASSERT(collection);
-	collection->mObjects.reserve(nbObjectsInCollection*2);
-	if(nbExportReferences > 0)
-	    collection->mIds.reserve(nbExportReferences*2);
+	while(maxNbReferences && !areInternalReferencesMapped())
+	{
+		const InternalReferenceHandle16& ref = mInternalHandle16References[mNbMappedReferences++ - mNbInternalPtrReferences];
+		mInternalHandle16ReferencesMap.insertUnique(ref.reference, SerialObjectIndex(ref.objIndex));
+		maxNbReferences--;
+	}
+}
 
-	PxU8* addressObjectData = alignPtr(address);
-	PxU8* addressExtraData = alignPtr(addressObjectData + objectDataEndOffset);
+bool BinaryCollectionLoader::createObjects(PxU32 maxNbObjects)
+{
+	PX_ASSERT(mCollection && areInternalReferencesMapped());
 
-	DeserializationContext context(manifestTable, importReferences, addressObjectData, internalPtrReferencesMap, internalHandle16ReferencesMap, externalRefs, addressExtraData);
-	
 	// iterate over memory containing PxBase objects, create the instances, resolve the addresses, import the external data, add to collection.
+	PxU32 nbObjects = PxMin(maxNbObjects, mNbObjects - mNbCreatedObjects);
+
+	while(nbObjects--)
 	{
-		PxU32 nbObjects = nbObjectsInCollection;
+		mAddress = alignPtr(mAddress);
+		mContext->alignExtraData();
+
+		// read PxBase header with type and get corresponding serializer.
+		PxBase* header = reinterpret_cast<PxBase*>(mAddress);
+		const PxType classType = header->getConcreteType();
+		const PxSerializer* serializer = mSn->getSerializer(classType);
+		PX_ASSERT(serializer);
 
-		while(nbObjects--)
+		PxBase* instance = serializer->createObject(mAddress, *mContext);
+		if (!instance)
 		{
-			address = alignPtr(address);
-			context.alignExtraData();
+			PxGetFoundation().error(physx::PxErrorCode::eINVALID_PARAMETER, __FILE__, __LINE__, 
+				"Cannot create class instance for concrete type %d.", classType);
+			return false;
+		}
 
-			// read PxBase header with type and get corresponding serializer.
-			PxBase* header = reinterpret_cast<PxBase*>(address);
-			const PxType classType = header->getConcreteType();
-			const PxSerializer* serializer = sn.getSerializer(classType);
-			PX_ASSERT(serializer);
+		mCollection->internalAdd(instance);
+		mNbCreatedObjects++;
+	}
+	return true;
+}
 
-			PxBase* instance = serializer->createObject(address, context);
-			if (!instance)
-			{
-				PxGetFoundation().error(physx::PxErrorCode::eINVALID_PARAMETER, __FILE__, __LINE__, 
-					"Cannot create class instance for concrete type %d.", classType);
-				collection->release();
-				return NULL;
-			}
+bool BinaryCollectionLoader::createObjectsInParallel(PxCpuDispatcher& dispatcher)
+{
+	PX_ASSERT(mCollection && areInternalReferencesMapped() && canCreateObjectsInParallel());
 
-			collection->internalAdd(instance);
-		}
+	// create the instances on multiple threads and add them to the collection in serialized order
+	PxArray<PxBase*> instances(mNbObjects, NULL);
+	const bool status = ::createObjectsInParallel(&dispatcher, *mSn, mNbObjects, mManifestTable, mObjectLoadTable, mImportReferences, mAddressObjectData, mAddressExtraData,
+		mInternalPtrReferencesMap, mInternalHandle16ReferencesMap, mExternalRefs, instances.begin());
+
+	for(PxU32 i=0;i<mNbObjects;i++)
+	{
+		if(instances[i])
+			mCollection->internalAdd(instances[i]);
 	}
+	mNbCreatedObjects = mCollection->internalGetNbObjects();
+	return status;
+}
 
-	PX_ASSERT(nbObjectsInCollection == collection->internalGetNbObjects());
+Cm::Collection* BinaryCollectionLoader::finish(bool registerObjects)
+{
+	PX_ASSERT(mNbObjects == mCollection->internalGetNbObjects());
 	
 	// update new collection with export references
 	{
-		PX_ASSERT(addressObjectData != NULL);
-		for (PxU32 i=0;i<nbExportReferences;i++)
+		PX_ASSERT(mAddressObjectData != NULL);
+		for (PxU32 i=0;i<mNbExportReferences;i++)
 		{
 			bool isExternal;
-			PxU32 manifestIndex = exportReferences[i].objIndex.getIndex(isExternal);
+			PxU32 manifestIndex = mExportReferences[i].objIndex.getIndex(isExternal);
 			PX_ASSERT(!isExternal);
-			PxBase* obj = reinterpret_cast<PxBase*>(addressObjectData + manifestTable[manifestIndex].offset);
-			collection->mIds.insertUnique(exportReferences[i].id, obj);
-			collection->mObjects[obj] = exportReferences[i].id;
+			PxBase* obj = reinterpret_cast<PxBase*>(mAddressObjectData + mManifestTable[manifestIndex].offset);
+			mCollection->mIds.insertUnique(mExportReferences[i].id, obj);
+			mCollection->mObjects[obj] = mExportReferences[i].id;
 		}
 	}
 
-	PxAddCollectionToPhysics(*collection);
+	if(registerObjects)
+		PxAddCollectionToPhysics(*mCollection);
+
+	Cm::Collection* collection = mCollection;
+	mCollection = NULL;
 	return collection;
 }
+
+PxCollection* PxSerialization::createCollectionFromBinary(void* memBlock, PxSerializationRegistry& sr, const PxCollection* pxExternalRefs, PxCpuDispatcher* dispatcher)
+{
+	BinaryCollectionLoader loader;
+	if(!loader.begin(memBlock, static_cast<SerializationRegistry&>(sr), static_cast<const Cm::Collection*>(pxExternalRefs)))
+		return NULL;
+
+	loader.mapInternalReferences(0xffffffff);
+
+	// with a dispatcher, create the instances on multiple threads. Otherwise (or for data without object load table) create them serially.
+	bool status;
+	if(dispatcher && dispatcher->getWorkerCount() > 1 && loader.canCreateObjectsInParallel())
+		status = loader.createObjectsInParallel(*dispatcher);
+	else
+		status = loader.createObjects(loader.getNbObjects());
+
+	// the loader releases its collection on failure
+	return status ? loader.finish(true) : NULL;
+}
@@ -0,0 +1,104 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef SN_BINARY_DESERIALIZATION_H
+#define SN_BINARY_DESERIALIZATION_H
+
+#include "SnSerializationContext.h"
+
+namespace physx
+{
+class PxCpuDispatcher;
+
+namespace Sn
+{
+	class SerializationRegistry;
+
+	// Deserializes a binary collection in place. The objects can be created in several steps, so that streaming loaders
+	// can spread the work over multiple frames. PxSerialization::createCollectionFromBinary creates them all at once.
+	class BinaryCollectionLoader : public PxUserAllocated
+	{
+		PX_NOCOPY(BinaryCollectionLoader)
+	public:
+								BinaryCollectionLoader();
+								~BinaryCollectionLoader();
+
+		// Reads the header and reference tables of the memory block and creates an empty collection.
+		bool					begin(void* memBlock, SerializationRegistry& sn, const Cm::Collection* externalRefs);
+
+		// Adds up to maxNbReferences internal references to the reference maps. Objects can only be created once all of them are mapped.
+		void					mapInternalReferences(PxU32 maxNbReferences);
+		bool					areInternalReferencesMapped()	const	{ return mNbMappedReferences == mNbInternalPtrReferences + mNbInternalHandle16References;	}
+
+		// Creates up to maxNbObjects objects in serialized order and adds them to the collection.
+		bool					createObjects(PxU32 maxNbObjects);
+
+		// Creates all objects using the dispatcher's worker threads. Requires canCreateObjectsInParallel().
+		bool					createObjectsInParallel(PxCpuDispatcher& dispatcher);
+		bool					canCreateObjectsInParallel()	const	{ return mNbObjectLoadEntries == mNbObjects && !mNbCreatedObjects;	}
+
+		// Adds the export references to the collection and optionally registers all objects with PxPhysics.
+		// The collection is owned by the caller afterwards.
+		Cm::Collection*			finish(bool registerObjects);
+
+		PX_FORCE_INLINE	PxU32			getNbObjects()			const	{ return mNbObjects;			}
+		PX_FORCE_INLINE	PxU32			getNbCreatedObjects()	const	{ return mNbCreatedObjects;		}
+		PX_FORCE_INLINE	Cm::Collection*	getCollection()			const	{ return mCollection;			}
+
+	private:
+		SerializationRegistry*		mSn;
+		const Cm::Collection*		mExternalRefs;
+		Cm::Collection*				mCollection;
+		DeserializationContext*		mContext;
+
+		const ManifestEntry*		mManifestTable;
+		const ImportReference*		mImportReferences;
+		ExportReference*			mExportReferences;
+		const ObjectLoadEntry*		mObjectLoadTable;
+		PxU32						mNbObjects;
+		PxU32						mNbExportReferences;
+		PxU32						mNbObjectLoadEntries;
+		PxU32						mNbCreatedObjects;
+
+		const InternalReferencePtr*			mInternalPtrReferences;
+		const InternalReferenceHandle16*	mInternalHandle16References;
+		PxU32						mNbInternalPtrReferences;
+		PxU32						mNbInternalHandle16References;
+		PxU32						mNbMappedReferences;
+
+		PxU8*						mAddressObjectData;
+		PxU8*						mAddressExtraData;
+		PxU8*						mAddress;	// next object to create in serialized order
+
+		InternalPtrRefMap			mInternalPtrReferencesMap;
+		InternalHandle16RefMap		mInternalHandle16ReferencesMap;
+	};
+}
+}
+
+#endif
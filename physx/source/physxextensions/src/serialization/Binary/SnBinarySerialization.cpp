@@ -51,6 +51,7 @@ using namespace Sn;
 //// import references
 //// export references
 //// internal references
+//// object load table
 //// object data
 //// extra data
 //------------------------------------------------------------------------------------
@@ -113,6 +114,18 @@ using namespace Sn;
 //
 //
 //------------------------------------------------------------------------------------
+//// object load table:
+//// one entry per collected object, or no entry at all
+//// extra data offsets are relative to the extra data memory block
+//// levels order objects so that required objects have a smaller level
+//// used to deserialize objects of the same level on multiple threads
+//------------------------------------------------------------------------------------
+// alignment
+// PxU32 size
+// (PxU32 extraDataOffset, PxU32 level)*size
+//
+//
+//------------------------------------------------------------------------------------
 //// object data:
 //// serialized PxBase derived class instances
 //// each object size depends on specific class
@@ -143,9 +156,9 @@ namespace
 	{
 	public:
 
-		PX_INLINE OutputStreamWriter(PxOutputStream& stream) 
+		PX_INLINE OutputStreamWriter(PxOutputStream& stream, PxU32 startOffset = 0) 
 		:	mStream(stream)
-		,	mCount(0)
+		,	mCount(startOffset)
 		{}
 
 		PX_INLINE	PxU32	write(const void* src, PxU32 offset)		
@@ -216,6 +229,42 @@ namespace
 		bool mExportNames;
 	};
 
+	// Discards data, used to measure the extra data of each object before writing it
+	class NullOutputStream : public PxOutputStream
+	{
+	public:
+		virtual	PxU32	write(const void*, PxU32 count)	{ return count;	}
+	};
+
+	// Computes the level of an object from the levels of its requirements
+	class LevelCallback : public PxProcessPxBaseCallback
+	{
+	public:
+		LevelCallback(const SerializationContext& context, const PxArray<ObjectLoadEntry>& entries) : mContext(context), mEntries(entries), mIndex(0), mLevel(0), mValid(true)	{}
+
+		virtual void process(PxBase& base)
+		{
+			const PxU32* index = mContext.getObjectIndex(base);
+			if(!index)
+				return;	// external reference
+
+			// the collection is sorted so that required objects come first. Cyclic requirements break that
+			// ordering, in which case the collection is deserialized on a single thread.
+			if(*index >= mIndex)
+				mValid = false;
+			else
+				mLevel = PxMax(mLevel, mEntries[*index].level + 1);
+		}
+
+		const SerializationContext&			mContext;
+		const PxArray<ObjectLoadEntry>&		mEntries;
+		PxU32								mIndex;
+		PxU32								mLevel;
+		bool								mValid;
+	private:
+		LevelCallback& operator=(const LevelCallback&);
+	};
+
 	void writeHeader(PxSerializationContext& stream, bool hasDeserializedAssets)
 	{
 		PX_UNUSED(hasDeserializedAssets);
@@ -297,9 +346,9 @@ bool PxSerialization::serializeCollectionToBinary(PxOutputStream& outputStream,
 	stream.writeData(&nbObjectsInCollection, sizeof(PxU32));
 
 	// write the manifest table (PxU32 offset, PxConcreteType type)
+	PxU32 headerOffset = 0;
 	{
 		PxArray<ManifestEntry> manifestTable(collection.internalGetNbObjects());
-		PxU32 headerOffset = 0;
 		for(PxU32 i=0;i<collection.internalGetNbObjects();i++)
 		{
 			PxBase* s = collection.internalGetObject(i);
@@ -382,6 +431,53 @@ bool PxSerialization::serializeCollectionToBinary(PxOutputStream& outputStream,
 		stream.writeData(internalReferencesHandle16.begin(), internalReferencesHandle16.size()*sizeof(InternalReferenceHandle16));
 	}
 
+	// write object load table (PxU32 extraDataOffset, PxU32 level)
+	PxArray<ObjectLoadEntry> objectLoadTable;
+	{
+		const PxU32 nb = collection.internalGetNbObjects();
+		objectLoadTable.resize(nb);
+
+		LevelCallback levelCallback(context, objectLoadTable);
+		for(PxU32 i=0;i<nb && levelCallback.mValid;i++)
+		{
+			PxBase* s = collection.internalGetObject(i);
+			const PxSerializer* serializer = sn.getSerializer(s->getConcreteType());
+			PX_ASSERT(serializer);
+			levelCallback.mIndex = i;
+			levelCallback.mLevel = 0;
+			serializer->requiresObjects(*s, levelCallback);
+			objectLoadTable[i].level = levelCallback.mLevel;
+		}
+
+		// the position of the extra data block in the stream is needed to reproduce its alignment
+		const PxU32 tableStart = stream.getTotalStoredSize() + getPadding(stream.getTotalStoredSize(), PX_SERIAL_ALIGN);
+		const PxU32 tableEnd = tableStart + sizeof(PxU32) + nb*sizeof(ObjectLoadEntry);
+		const PxU32 objectDataStart = tableEnd + getPadding(tableEnd, PX_SERIAL_ALIGN);
+		const PxU32 extraDataStart = objectDataStart + headerOffset + getPadding(objectDataStart + headerOffset, PX_SERIAL_ALIGN);
+
+		NullOutputStream nullStream;
+		OutputStreamWriter nullWriter(nullStream, extraDataStart);
+		LegacySerialStream extraDataCounter(nullWriter, collection, exportNames);
+		for(PxU32 i=0;i<nb;i++)
+		{
+			PxBase* s = collection.internalGetObject(i);
+			const PxSerializer* serializer = sn.getSerializer(s->getConcreteType());
+			PX_ASSERT(serializer);
+			extraDataCounter.alignData(PX_SERIAL_ALIGN);
+			objectLoadTable[i].extraDataOffset = extraDataCounter.getTotalStoredSize() - extraDataStart;
+			serializer->exportExtraData(*s, extraDataCounter);
+		}
+
+		if(!levelCallback.mValid)
+			objectLoadTable.clear();
+
+		stream.alignData(PX_SERIAL_ALIGN);
+		PX_ASSERT(stream.getTotalStoredSize() == tableStart);
+		const PxU32 nbEntries = objectLoadTable.size();
+		stream.writeData(&nbEntries, sizeof(PxU32));
+		stream.writeData(objectLoadTable.begin(), nbEntries*sizeof(ObjectLoadEntry));
+	}
+
 	// write object data
 	{
 		stream.alignData(PX_SERIAL_ALIGN);
@@ -400,6 +496,9 @@ bool PxSerialization::serializeCollectionToBinary(PxOutputStream& outputStream,
 	// write extra data
 	{
 		const PxU32 nb = collection.internalGetNbObjects();
+		stream.alignData(PX_SERIAL_ALIGN);
+		const PxU32 extraDataStart = stream.getTotalStoredSize();
+		PX_UNUSED(extraDataStart);
 		for(PxU32 i=0;i<nb;i++)
 		{
 			PxBase* s = collection.internalGetObject(i);
@@ -409,6 +508,7 @@ bool PxSerialization::serializeCollectionToBinary(PxOutputStream& outputStream,
 			PX_ASSERT(serializer);
 
 			stream.alignData(PX_SERIAL_ALIGN);
+			PX_ASSERT(objectLoadTable.empty() || stream.getTotalStoredSize() - extraDataStart == objectLoadTable[i].extraDataOffset);
 			serializer->exportExtraData(*s, stream);
 		}
 	}
@@ -123,6 +123,7 @@ namespace Sn {
 						const void*				convertImportReferences(const void* buffer, int& fileSize);
 						const void*				convertExportReferences(const void* buffer, int& fileSize);
 						const void*				convertInternalReferences(const void* buffer, int& fileSize);
+						const void*				convertObjectLoadTable(const void* buffer, int& fileSize);
 						const void*				convertReferenceTables(const void* buffer, int& fileSize, int& nbObjectsInCollection);
 						bool					checkPaddingBytes(const char* buffer, int byteCount);
 
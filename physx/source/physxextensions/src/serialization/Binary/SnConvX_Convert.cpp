@@ -1437,6 +1437,23 @@ const void* Sn::ConvX::convertInternalReferences(const void* buffer, int& fileSi
 }
 
 
+// PT: the object load table contains extra data offsets that are only valid for the source platform, and we cannot compute
+// them for the target platform before the extra data has been converted. So we write an empty table instead, which makes
+// the converted data deserialize on a single thread.
+const void* Sn::ConvX::convertObjectLoadTable(const void* buffer, int& fileSize)
+{
+	PxU32 padding = getPadding(size_t(buffer), ALIGN_DEFAULT);
+	buffer = alignStream(reinterpret_cast<const char*>(buffer));
+	fileSize -= padding;
+
+	const int nb = *reinterpret_cast<const int*>(buffer);
+	output(0);
+	const int tableSize = 4 + nb*int(2*sizeof(PxU32));	// PxU32 size, (PxU32 extraDataOffset, PxU32 level)*size
+	fileSize -= tableSize;
+	assert(fileSize>=0);
+	return reinterpret_cast<const char*>(buffer) + tableSize;
+}
+
 const void* Sn::ConvX::convertReferenceTables(const void* buffer, int& fileSize, int& nbObjectsInCollection)
 {	
 	// PT: the map should not be used while creating it, so use one indirection
@@ -1465,6 +1482,7 @@ const void* Sn::ConvX::convertReferenceTables(const void* buffer, int& fileSize,
 	buffer = convertImportReferences(buffer, fileSize);
 	buffer = convertExportReferences(buffer, fileSize);
 	buffer = convertInternalReferences(buffer, fileSize);
+	buffer = convertObjectLoadTable(buffer, fileSize);
 
 	// PT: the map can now be used
 	mPointerActiveRemap = &mPointerRemap;
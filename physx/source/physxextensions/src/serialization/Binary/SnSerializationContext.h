@@ -204,6 +204,18 @@ namespace physx
 			SerialObjectIndex objIndex;
 		};
 
+		// PT: per-object information used to deserialize a collection on multiple threads. Objects can be created
+		// independently once their extra data address is known, and objects of the same level do not depend on each other.
+		// This table is not converted by the binary converter (it writes an empty table instead).
+		struct ObjectLoadEntry
+		{
+			PX_FORCE_INLINE	ObjectLoadEntry()	{}
+			PX_FORCE_INLINE	ObjectLoadEntry(PxU32 _extraDataOffset, PxU32 _level) : extraDataOffset(_extraDataOffset), level(_level)	{}
+
+			PxU32 extraDataOffset;	// offset of the object's extra data, relative to the start of the extra data block
+			PxU32 level;			// 0 for objects without requirements, else 1 + largest level of required objects
+		};
+
 		typedef Cm::CollectionHashMap<size_t, SerialObjectIndex> InternalPtrRefMap;
 		typedef Cm::CollectionHashMap<PxU16, SerialObjectIndex> InternalHandle16RefMap;
 
@@ -231,6 +243,8 @@ namespace physx
 
 			virtual	PxBase*	resolveReference(PxU32 kind, size_t reference) const;
 
+			PX_FORCE_INLINE	void	setExtraDataAddress(PxU8* extraData)	{ mExtraDataAddress = extraData;	}
+
 		private:
 			//various pointers to deserialized data
 			const ManifestEntry* mManifestTable;
@@ -290,6 +304,12 @@ namespace physx
 
 			virtual void registerReference(PxBase& serializable, PxU32 kind, size_t reference);
 
+			PX_FORCE_INLINE	const PxU32* getObjectIndex(const PxBase& object) const
+			{
+				const PxHashMap<const PxBase*, PxU32>::Entry* entry = mObjToCollectionIndexMap.find(&object);
+				return entry ? &entry->second : NULL;
+			}
+
 			const PxArray<ImportReference>& getImportReferences() { return mImportReferences; }
 			InternalPtrRefMap& getInternalPtrReferencesMap() { return mInternalPtrReferencesMap; }
 			InternalHandle16RefMap& getInternalHandle16ReferencesMap() { return mInternalHandle16ReferencesMap; }
@@ -0,0 +1,446 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "extensions/PxStreamingCollectionLoader.h"
+#include "extensions/PxSerialization.h"
+#include "extensions/PxCollectionExt.h"
+#include "foundation/PxAlignedMalloc.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxHashMap.h"
+#include "foundation/PxTime.h"
+#include "PxScene.h"
+#include "PxAggregate.h"
+#include "PxRigidActor.h"
+#include "PxShape.h"
+#include "PxMaterial.h"
+#include "geometry/PxConvexMesh.h"
+#include "geometry/PxTriangleMesh.h"
+#include "geometry/PxHeightField.h"
+#include "geometry/PxTetrahedronMesh.h"
+#include "PxPruningStructure.h"
+#include "PxArticulationReducedCoordinate.h"
+#include "PxPhysicsSerialization.h"
+
+#include "SnBinaryDeserialization.h"
+#include "serialization/SnSerializationRegistry.h"
+
+using namespace physx;
+using namespace Sn;
+
+namespace
+{
+	// Number of objects deserialized, and of actors gathered for PxScene::addActors(), per step
+	const PxU32 gBatchSize = 64;
+	// Number of internal references added to the deserialization maps per step
+	const PxU32 gReferenceBatchSize = 4096;
+
+	typedef PxAlignedAllocator<PX_SERIAL_FILE_ALIGN> FileAllocator;
+
+	class StreamingCollectionLoader : public PxStreamingCollectionLoader, public PxUserAllocated
+	{
+		public:
+									StreamingCollectionLoader(PxInputData& data, SerializationRegistry& sn, PxScene& scene, const PxStreamingCollectionLoaderDesc& desc, const Cm::Collection* externalRefs);
+		virtual						~StreamingCollectionLoader();
+
+		// PxStreamingCollectionLoader
+		virtual	void									release()	PX_OVERRIDE;
+		virtual	PxStreamingCollectionLoaderState::Enum	update(PxReal timeBudget)	PX_OVERRIDE;
+		virtual	PxStreamingCollectionLoaderState::Enum	getState()	const	PX_OVERRIDE	{ return mState;		}
+		virtual	const PxCollection*						getCollection()	const	PX_OVERRIDE	{ return mCollection;	}
+		//~PxStreamingCollectionLoader
+
+		private:
+				PxInputData*							mData;
+				SerializationRegistry&					mSn;
+				PxScene&								mScene;
+				const PxStreamingCollectionLoaderDesc	mDesc;
+				const Cm::Collection*					mExternalRefs;
+				PxStreamingCollectionLoaderState::Enum	mState;
+
+				// Reading
+				PxU8*									mMemBlock;
+				PxU32									mSize;
+				PxU32									mNbReadBytes;
+
+				// Deserialization
+				BinaryCollectionLoader					mLoader;
+				bool									mLoaderStarted;
+				Cm::Collection*							mRegistrationBatch;	// Objects of the current step, registered with PxPhysics at the end of the step
+				PxArray<PxPruningStructure*>			mPruningStructures;
+
+				// Insertion
+				Cm::Collection*							mCollection;
+				PxU32									mNbInsertedPruningStructures;
+				PxU32									mInsertionIndex;	// Next collection object considered for insertion
+				PxArray<PxActor*>						mActorBatch;
+
+				// Each step returns false if it could not make progress within the given limit
+				bool									readStep(PxU32 maxNbBytes, PxU32& nbBytes);
+				bool									deserializationStep(PxU32 maxNbObjects, PxU32& nbObjects);
+				bool									insertionStep(PxU32 maxNbActors, PxU32& nbActors);
+				void									flushActorBatch(PxU32& nbActors);
+				void									fail(const char* message);
+				void									releaseObjects();
+				bool									hasExternalReferences()	const;
+	};
+}
+
+StreamingCollectionLoader::StreamingCollectionLoader(PxInputData& data, SerializationRegistry& sn, PxScene& scene, const PxStreamingCollectionLoaderDesc& desc, const Cm::Collection* externalRefs) :
+	mData							(&data),
+	mSn								(sn),
+	mScene							(scene),
+	mDesc							(desc),
+	mExternalRefs					(externalRefs),
+	mState							(PxStreamingCollectionLoaderState::eREADING),
+	mMemBlock						(NULL),
+	mSize							(data.getLength() - data.tell()),
+	mNbReadBytes					(0),
+	mLoaderStarted					(false),
+	mRegistrationBatch				(static_cast<Cm::Collection*>(PxCreateCollection())),
+	mCollection						(NULL),
+	mNbInsertedPruningStructures	(0),
+	mInsertionIndex					(0)
+{
+	if(mSize)
+	{
+		mMemBlock = reinterpret_cast<PxU8*>(FileAllocator().allocate(mSize, PX_FL));
+		if(!mMemBlock)
+		{
+			PxGetFoundation().error(PxErrorCode::eOUT_OF_MEMORY, PX_FL, "PxSerialization::createStreamingCollectionLoader: failed to allocate %u bytes for the input data.", mSize);
+			mData = NULL;
+			mState = PxStreamingCollectionLoaderState::eFAILED;
+		}
+	}
+	// Cm::Collection::internalAdd() does not grow the collection
+	mRegistrationBatch->mObjects.reserve(gBatchSize*2);
+	mActorBatch.reserve(gBatchSize);
+}
+
+StreamingCollectionLoader::~StreamingCollectionLoader()
+{
+	if(mCollection)
+		mCollection->release();
+	mRegistrationBatch->release();
+	FileAllocator().deallocate(mMemBlock);
+}
+
+void StreamingCollectionLoader::release()
+{
+	// the loader's memory block contains the objects, so it can only be freed if nothing else uses them
+	if(hasExternalReferences())
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_OPERATION, PX_FL, "PxStreamingCollectionLoader::release(): objects of the collection are still referenced by other objects. Release call ignored.");
+		return;
+	}
+
+	releaseObjects();
+	PX_DELETE_THIS;
+}
+
+static PX_FORCE_INLINE void addInternalReference(PxHashMap<const PxBase*, PxU32>& internalRefs, const Cm::Collection& collection, PxBase* object)
+{
+	if(object && collection.contains(*object))
+		internalRefs[object]++;
+}
+
+// Reference-counted objects that can be part of a binary collection
+static PxRefCounted* getRefCounted(PxBase* object)
+{
+	if(PxShape* shape = object->is<PxShape>())
+		return shape;
+	if(PxMaterial* material = object->is<PxMaterial>())
+		return material;
+	if(PxConvexMesh* convexMesh = object->is<PxConvexMesh>())
+		return convexMesh;
+	if(PxTriangleMesh* triangleMesh = object->is<PxTriangleMesh>())
+		return triangleMesh;
+	if(PxHeightField* heightField = object->is<PxHeightField>())
+		return heightField;
+	if(PxTetrahedronMesh* tetrahedronMesh = object->is<PxTetrahedronMesh>())
+		return tetrahedronMesh;
+	return NULL;
+}
+
+// After deserialization, the reference count of a reference-counted object is one (released with the collection) plus the
+// number of objects of the collection referencing it: actors for shapes, shapes for materials and meshes. Anything above
+// that comes from outside the collection.
+bool StreamingCollectionLoader::hasExternalReferences() const
+{
+	const Cm::Collection* collection = mCollection ? mCollection : mLoader.getCollection();
+	if(!collection)
+		return false;
+
+	PxHashMap<const PxBase*, PxU32> internalRefs;
+	const PxU32 nbObjects = collection->internalGetNbObjects();
+	for(PxU32 i=0;i<nbObjects;i++)
+	{
+		PxBase* object = collection->internalGetObject(i);
+		if(PxRigidActor* actor = object->is<PxRigidActor>())
+		{
+			const PxU32 nbShapes = actor->getNbShapes();
+			for(PxU32 j=0;j<nbShapes;j++)
+			{
+				PxShape* shape;
+				actor->getShapes(&shape, 1, j);
+				addInternalReference(internalRefs, *collection, shape);
+			}
+		}
+		else if(PxShape* shape = object->is<PxShape>())
+		{
+			const PxU32 nbMaterials = shape->getNbMaterials();
+			for(PxU32 j=0;j<nbMaterials;j++)
+			{
+				PxMaterial* material;
+				shape->getMaterials(&material, 1, j);
+				addInternalReference(internalRefs, *collection, material);
+			}
+
+			const PxGeometry& geometry = shape->getGeometry();
+			switch(geometry.getType())
+			{
+				case PxGeometryType::eCONVEXMESH:		addInternalReference(internalRefs, *collection, static_cast<const PxConvexMeshGeometry&>(geometry).convexMesh);			break;
+				case PxGeometryType::eHEIGHTFIELD:		addInternalReference(internalRefs, *collection, static_cast<const PxHeightFieldGeometry&>(geometry).heightField);			break;
+				case PxGeometryType::eTRIANGLEMESH:		addInternalReference(internalRefs, *collection, static_cast<const PxTriangleMeshGeometry&>(geometry).triangleMesh);		break;
+				case PxGeometryType::eTETRAHEDRONMESH:	addInternalReference(internalRefs, *collection, static_cast<const PxTetrahedronMeshGeometry&>(geometry).tetrahedronMesh);	break;
+				default:																																							break;
+			}
+		}
+	}
+
+	for(PxU32 i=0;i<nbObjects;i++)
+	{
+		PxBase* object = collection->internalGetObject(i);
+		const PxRefCounted* refCounted = getRefCounted(object);
+		if(!refCounted)
+			continue;
+
+		const PxHashMap<const PxBase*, PxU32>::Entry* entry = internalRefs.find(object);
+		if(refCounted->getReferenceCount() > 1 + (entry ? entry->second : 0))
+			return true;
+	}
+	return false;
+}
+
+void StreamingCollectionLoader::releaseObjects()
+{
+	Cm::Collection* collection = mCollection ? mCollection : mLoader.getCollection();
+	if(collection)
+		PxCollectionExt::releaseObjects(*collection);
+}
+
+void StreamingCollectionLoader::fail(const char* message)
+{
+	PxGetFoundation().error(PxErrorCode::eINVALID_OPERATION, PX_FL, "PxStreamingCollectionLoader::update(): %s", message);
+	releaseObjects();
+	mData = NULL;
+	mState = PxStreamingCollectionLoaderState::eFAILED;
+}
+
+bool StreamingCollectionLoader::readStep(PxU32 maxNbBytes, PxU32& nbBytes)
+{
+	const PxU32 nbToRead = PxMin(PxMin(mDesc.readChunkSize, maxNbBytes), mSize - mNbReadBytes);
+	if(mData->read(mMemBlock + mNbReadBytes, nbToRead) != nbToRead)
+	{
+		fail("unexpected end of input data.");
+		return false;
+	}
+	mNbReadBytes += nbToRead;
+	nbBytes += nbToRead;
+
+	if(mNbReadBytes == mSize)
+	{
+		mData = NULL;
+		mState = PxStreamingCollectionLoaderState::eDESERIALIZING;
+	}
+	return true;
+}
+
+bool StreamingCollectionLoader::deserializationStep(PxU32 maxNbObjects, PxU32& nbObjects)
+{
+	// reading the header and reference tables, and mapping the internal references, are steps of their own
+	if(!mLoaderStarted)
+	{
+		mLoaderStarted = true;
+		if(!mSize || !mLoader.begin(mMemBlock, mSn, mExternalRefs))
+		{
+			fail("invalid binary data.");
+			return false;
+		}
+		return true;
+	}
+
+	if(!mLoader.areInternalReferencesMapped())
+	{
+		mLoader.mapInternalReferences(gReferenceBatchSize);
+		return true;
+	}
+
+	const PxU32 start = mLoader.getNbCreatedObjects();
+	const bool status = mLoader.createObjects(PxMin(maxNbObjects, gBatchSize));
+	const PxU32 end = mLoader.getNbCreatedObjects();
+	nbObjects += end - start;
+
+	// register the new objects, including those created before a failure, so that they can be released like the others
+	const Cm::Collection* collection = mLoader.getCollection();
+	for(PxU32 i=start;i<end;i++)
+	{
+		PxBase* object = collection->internalGetObject(i);
+		mRegistrationBatch->internalAdd(object);
+		if(object->getConcreteType() == PxConcreteType::ePRUNING_STRUCTURE)
+			mPruningStructures.pushBack(static_cast<PxPruningStructure*>(object));
+	}
+	PxAddCollectionToPhysics(*mRegistrationBatch);
+	mRegistrationBatch->mObjects.clear();
+
+	if(!status)
+	{
+		fail("cannot create object.");
+		return false;
+	}
+
+	if(end == mLoader.getNbObjects())
+	{
+		mCollection = mLoader.finish(false);
+		mExternalRefs = NULL;
+		mState = PxStreamingCollectionLoaderState::eINSERTING;
+	}
+	return true;
+}
+
+void StreamingCollectionLoader::flushActorBatch(PxU32& nbActors)
+{
+	if(mActorBatch.size())
+	{
+		mScene.addActors(mActorBatch.begin(), mActorBatch.size());
+		nbActors += mActorBatch.size();
+		mActorBatch.clear();
+	}
+}
+
+bool StreamingCollectionLoader::insertionStep(PxU32 maxNbActors, PxU32& nbActors)
+{
+	// pruning structures first, so that the actors they insert are skipped below
+	if(mNbInsertedPruningStructures < mPruningStructures.size())
+	{
+		PxPruningStructure* ps = mPruningStructures[mNbInsertedPruningStructures];
+		const PxU32 nb = ps->getNbRigidActors();
+		if(nb > maxNbActors && nbActors)
+			return false;
+
+		mScene.addActors(*ps);
+		mNbInsertedPruningStructures++;
+		nbActors += nb;
+		return true;
+	}
+
+	// NpArticulationLink and NpArticulationJoint are added with the articulation. Actors and articulations that are members
+	// of an aggregate are added with the aggregate.
+	const PxU32 maxBatchSize = PxMin(maxNbActors, gBatchSize);
+	const PxU32 nbObjects = mCollection->internalGetNbObjects();
+	while(mInsertionIndex < nbObjects)
+	{
+		PxBase* object = mCollection->internalGetObject(mInsertionIndex);
+		const PxType type = object->getConcreteType();
+
+		if(type == PxConcreteType::eRIGID_DYNAMIC || type == PxConcreteType::eRIGID_STATIC)
+		{
+			PxRigidActor* actor = static_cast<PxRigidActor*>(object);
+			if(!actor->getScene() && !actor->getAggregate())
+			{
+				if(mActorBatch.size() == maxBatchSize)
+					break;
+				mActorBatch.pushBack(actor);
+			}
+		}
+		else if(type == PxConcreteType::eARTICULATION_REDUCED_COORDINATE || type == PxConcreteType::eAGGREGATE)
+		{
+			PxArticulationReducedCoordinate* articulation = object->is<PxArticulationReducedCoordinate>();
+			if(!articulation || !articulation->getAggregate())
+			{
+				// pending actors are added first, in a step of their own
+				if(mActorBatch.size())
+					break;
+
+				const PxU32 nb = articulation ? articulation->getNbLinks() : static_cast<PxAggregate*>(object)->getNbActors();
+				if(nb > maxNbActors && nbActors)
+					return false;
+
+				if(articulation)
+					mScene.addArticulation(*articulation);
+				else
+					mScene.addAggregate(*static_cast<PxAggregate*>(object));
+				nbActors += nb;
+				mInsertionIndex++;
+				return true;
+			}
+		}
+		mInsertionIndex++;
+	}
+
+	flushActorBatch(nbActors);
+
+	if(mInsertionIndex == nbObjects)
+		mState = PxStreamingCollectionLoaderState::eCOMPLETE;
+	return true;
+}
+
+PxStreamingCollectionLoaderState::Enum StreamingCollectionLoader::update(PxReal timeBudget)
+{
+	PxTime timer;
+	PxU32 nbBytes = 0;
+	PxU32 nbObjects = 0;
+	PxU32 nbActors = 0;
+
+	for(;;)
+	{
+		bool progress;
+		if(mState == PxStreamingCollectionLoaderState::eREADING)
+			progress = nbBytes < mDesc.maxBytesPerUpdate && readStep(mDesc.maxBytesPerUpdate - nbBytes, nbBytes);
+		else if(mState == PxStreamingCollectionLoaderState::eDESERIALIZING)
+			progress = nbObjects < mDesc.maxObjectsPerUpdate && deserializationStep(mDesc.maxObjectsPerUpdate - nbObjects, nbObjects);
+		else if(mState == PxStreamingCollectionLoaderState::eINSERTING)
+			progress = nbActors < mDesc.maxActorsPerUpdate && insertionStep(mDesc.maxActorsPerUpdate - nbActors, nbActors);
+		else
+			break;
+
+		if(!progress || timer.peekElapsedSeconds() >= PxF64(timeBudget))
+			break;
+	}
+	return mState;
+}
+
+PxStreamingCollectionLoader* PxSerialization::createStreamingCollectionLoader(PxInputData& data, PxSerializationRegistry& sr, PxScene& scene, const PxStreamingCollectionLoaderDesc& desc, const PxCollection* externalRefs)
+{
+	if(!desc.isValid())
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxSerialization::createStreamingCollectionLoader: invalid descriptor.");
+		return NULL;
+	}
+
+	return PX_NEW(StreamingCollectionLoader)(data, static_cast<SerializationRegistry&>(sr), scene, desc, static_cast<const Cm::Collection*>(externalRefs));
+}
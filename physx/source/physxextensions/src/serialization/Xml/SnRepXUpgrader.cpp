@@ -411,50 +411,58 @@ namespace physx { namespace Sn {
 		return *dest;
 	}
 
-	RepXCollection& RepXUpgrader::upgradeCollection(RepXCollection& src)
+	typedef RepXCollection& (*UPGRADE_FUNCTION)(RepXCollection& src);
+
+	struct Upgrade { const char* versionString; UPGRADE_FUNCTION upgradeFunction; };
+
+	static const Upgrade gUpgradeTable[] =
+	{
+		{   "1.0", RepXUpgrader::upgrade10CollectionTo3_1Collection	},
+		{   "3.1", NULL													},
+		{ "3.1.1", RepXUpgrader::upgrade3_1CollectionTo3_2Collection	},
+		{ "3.2.0", RepXUpgrader::upgrade3_2CollectionTo3_3Collection	},
+		{ "3.3.0", NULL													},
+		{ "3.3.1", NULL													},
+		{ "3.3.2", NULL													},
+		{ "3.3.3", NULL													},
+		{ "3.3.4", RepXUpgrader::upgrade3_3CollectionTo3_4Collection	},
+		{ "3.4.0", NULL													},
+		{ "3.4.1", NULL													},
+		{ "3.4.2", RepXUpgrader::upgrade3_4CollectionTo4_0Collection	}
+	}; //increasing order and complete
+
+	static const PxU32 gUpgradeTableSize = sizeof(gUpgradeTable)/sizeof(gUpgradeTable[0]);
+
+	static PxU32 findUpgradeStart(const char* srcVersion)
 	{
-		const char* srcVersion = src.getVersion();
 		if( safeStrEq( srcVersion, RepXCollection::getLatestVersion() ))
-           return src;		
-
-		typedef RepXCollection& (*UPGRADE_FUNCTION)(RepXCollection& src);
+			return gUpgradeTableSize;
 
-		struct Upgrade { const char* versionString; UPGRADE_FUNCTION upgradeFunction; };
-		
-		static const Upgrade upgradeTable[] =
+		for (PxU32 i=0; i<gUpgradeTableSize; i++)
 		{
-			{   "1.0", upgrade10CollectionTo3_1Collection	},
-			{   "3.1", NULL									},
-			{ "3.1.1", upgrade3_1CollectionTo3_2Collection	},
-			{ "3.2.0", upgrade3_2CollectionTo3_3Collection	},
-			{ "3.3.0", NULL									},
-			{ "3.3.1", NULL									},
-			{ "3.3.2", NULL									},
-			{ "3.3.3", NULL									},
-			{ "3.3.4", upgrade3_3CollectionTo3_4Collection	},
-			{ "3.4.0", NULL									},
-			{ "3.4.1", NULL									},
-			{ "3.4.2", upgrade3_4CollectionTo4_0Collection	}
-		}; //increasing order and complete
-		
-		const PxU32 upgradeTableSize = sizeof(upgradeTable)/sizeof(upgradeTable[0]);
+			if( safeStrEq( srcVersion, gUpgradeTable[i].versionString ))
+				return i;
+		}
+		return gUpgradeTableSize;
+	}
 
-		PxU32 repxVersion = UINT16_MAX;
-		
-		for (PxU32 i=0; i<upgradeTableSize; i++)
-	    {
-			if( safeStrEq( srcVersion, upgradeTable[i].versionString ))
-			{
-				repxVersion = i;
-				break;
-			}
+	bool RepXUpgrader::isUpgradeRequired(const char* srcVersion)
+	{
+		for( PxU32 j = findUpgradeStart( srcVersion ); j < gUpgradeTableSize; j++ )
+		{
+			if( gUpgradeTable[j].upgradeFunction )
+				return true;
 		}
+		return false;
+	}
 
+	RepXCollection& RepXUpgrader::upgradeCollection(RepXCollection& src)
+	{
 		RepXCollection* dest = &src;
-		for( PxU32 j = repxVersion; j < upgradeTableSize; j++ )
+		for( PxU32 j = findUpgradeStart( src.getVersion() ); j < gUpgradeTableSize; j++ )
 		{
-			if( upgradeTable[j].upgradeFunction )
-				dest = &(upgradeTable[j].upgradeFunction)(*dest);
+			if( gUpgradeTable[j].upgradeFunction )
+				dest = &(gUpgradeTable[j].upgradeFunction)(*dest);
 		}
 
 		return *dest;
@@ -43,6 +43,9 @@ namespace physx { namespace Sn {
 		//So be aware, that the argument to these functions may not be valid
 		//after they are called, but the return value always will be valid.
 		static RepXCollection& upgradeCollection( RepXCollection& src );
+		//True if a collection written with this version has to go through upgradeCollection
+		//before it can be instantiated.
+		static bool isUpgradeRequired( const char* srcVersion );
 		static RepXCollection& upgrade10CollectionTo3_1Collection( RepXCollection& src );
 		static RepXCollection& upgrade3_1CollectionTo3_2Collection( RepXCollection& src );
 		static RepXCollection& upgrade3_2CollectionTo3_3Collection( RepXCollection& src );
@@ -57,17 +57,6 @@ namespace physx { namespace Sn {
 		void deallocate( PxU8* inMem ) { mAllocator->deallocate( inMem ); }
 	};
 
-	inline bool isEmpty(const char *s)
-	{
-		while (*s != '\0')
-		{
-			if (!isspace(*s))
-				return false;
-			s++;
-		}
-		return true;
-	}
-
 	inline void strtoLong( Triangle<PxU32>& ioDatatype,const char*& ioData )
 	{
 		strto( ioDatatype.mIdx0, ioData );
@@ -151,20 +140,24 @@ namespace physx { namespace Sn {
 
 			if ( theSrcData )
 			{
-				static PxU32 theCount = 0;
-				++theCount;
-				char* theStartData = const_cast< char*>( copyStr( &tempAllocator, theSrcData ) );
-				const char* theData = theStartData;
-				while( !isEmpty(theData) )
+				//The conversions don't modify the string so it can be parsed in place, 
+				//these buffers can be megabytes for meshes.
+				const char* theData = theSrcData;
+				eatwhite( theData );
+				while( *theData )
 				{
 					//These buffers are whitespace delimited.
 					TDataType theType;
+					const char* thePrevData = theData;
 					strtoLong( theType, theData );
+					//Stop on garbage instead of spinning on it forever.
+					if ( theData == thePrevData )
+						break;
 					tempBuffer.write( &theType, sizeof(theType) );
+					eatwhite( theData );
 				}
 				outData = reinterpret_cast< TDataType* >( tempBuffer.mBuffer );
 				outCount = tempBuffer.mWriteOffset / sizeof( TDataType );
-				tempAllocator.deallocate( reinterpret_cast<PxU8*>(theStartData) );
 			}
 			tempBuffer.releaseBuffer();
 		}
@@ -392,6 +392,172 @@ namespace physx { namespace Sn {
 		XmlParser& operator=(const XmlParser&);
 	};
 
+	//Instantiates the top level objects of a document while it is being parsed. Only the node tree
+	//of the object currently being read is kept in memory, it is released as soon as the object's
+	//element closes, so peak memory no longer scales with the size of the document.
+	//Documents written by older versions still need the upgrader, which works on the complete
+	//document: the parser stops on the root element and reports it, nothing is created in that case.
+	class XmlStreamingParser : public shdfnd::FastXml::Callback
+	{
+		SerializationRegistry&			mRegistry;
+		PxRepXInstantiationArgs&		mArgs;
+		PxCollection&					mCollection;
+		PxAllocatorCallback&			mAllocator;
+		XmlMemoryAllocatorImpl*			mObjectAllocator;
+		XmlNode*						mCurrentNode;
+		PxU32							mDepth;
+		PxVec3							mUpVector;
+		PxTolerancesScale				mScale;
+		bool							mFoundRoot;
+		bool							mUpgradeRequired;
+		bool							mFailed;
+
+	public:
+		XmlStreamingParser( SerializationRegistry& inRegistry, PxRepXInstantiationArgs& inArgs, PxCollection& inCollection, PxAllocatorCallback& inAllocator )
+			: mRegistry( inRegistry )
+			, mArgs( inArgs )
+			, mCollection( inCollection )
+			, mAllocator( inAllocator )
+			, mObjectAllocator( NULL )
+			, mCurrentNode( NULL )
+			, mDepth( 0 )
+			, mUpVector( 0,0,0 )
+			, mScale( 0.f, 0.f )
+			, mFoundRoot( false )
+			, mUpgradeRequired( false )
+			, mFailed( false )
+		{
+		}
+
+		virtual ~XmlStreamingParser()
+		{
+			releaseObjectAllocator();
+		}
+
+		virtual bool processComment(const char* /*comment*/) { return true; }
+
+		virtual bool processClose(const char* /*element*/, physx::PxU32 /*depth*/, bool& isError)
+		{
+			PX_ASSERT( mDepth );
+			--mDepth;
+			//Closing the root or an element that was never built (we don't build the root).
+			if ( mCurrentNode == NULL )
+				return true;
+
+			XmlNode* theNode = mCurrentNode;
+			mCurrentNode = mCurrentNode->mParent;
+			if ( mCurrentNode != NULL )
+				return true;
+
+			//A top level element is complete.
+			const bool success = processTopLevelNode( *theNode );
+			releaseObjectAllocator();
+			if ( !success )
+			{
+				mFailed = true;
+				isError = true;
+				return false;
+			}
+			return true;
+		}
+
+		virtual bool processElement(
+			const char *elementName,
+			const char  *elementData,
+			const shdfnd::FastXml::AttributePairs& attr,
+			PxI32 /*lineno*/)
+		{
+			++mDepth;
+			if ( mDepth == 1 )
+			{
+				mFoundRoot = true;
+				const char* theVersion = NULL;
+				for( PxI32 item = 0; item < attr.getNbAttr(); item ++ )
+				{
+					if ( physx::Pxstricmp( attr.getKey(PxU32(item)), "version" ) == 0 )
+						theVersion = attr.getValue(PxU32(item));
+				}
+				mUpgradeRequired = RepXUpgrader::isUpgradeRequired( theVersion );
+				return !mUpgradeRequired;
+			}
+
+			if ( mObjectAllocator == NULL )
+				mObjectAllocator = PX_PLACEMENT_NEW((mAllocator.allocate(sizeof(XmlMemoryAllocatorImpl), "XmlStreamingParser",  __FILE__, __LINE__ )), XmlMemoryAllocatorImpl)( mAllocator );
+
+			XmlNode* newNode = allocateRepXNode( &mObjectAllocator->mManager, elementName, elementData );
+			if ( mCurrentNode )
+				mCurrentNode->addChild( newNode );
+			mCurrentNode = newNode;
+			//Add the elements as children.
+			for( PxI32 item = 0; item < attr.getNbAttr(); item ++ )
+			{
+				XmlNode* node = allocateRepXNode( &mObjectAllocator->mManager, attr.getKey(PxU32(item)), attr.getValue(PxU32(item)) );
+				mCurrentNode->addChild( node );
+			}
+			return true;
+		}
+
+		bool foundRoot() const { return mFoundRoot; }
+		bool isUpgradeRequired() const { return mUpgradeRequired; }
+		bool hasFailed() const { return mFailed; }
+		PxVec3 getUpVector() const { return mUpVector; }
+		PxTolerancesScale getTolerancesScale() const { return mScale; }
+
+	private:
+		XmlStreamingParser& operator=(const XmlStreamingParser&);
+
+		bool processTopLevelNode( XmlNode& inNode )
+		{
+			XmlNodeReader theReader( &inNode, mAllocator, mObjectAllocator->mManager );
+			XmlMemoryAllocatorImpl instantiationAllocator( mAllocator );
+			if ( physx::Pxstricmp( inNode.mName, "upvector" ) == 0 )
+			{
+				if ( inNode.mData && *inNode.mData )
+					stringToType( inNode.mData, mUpVector );
+				return true;
+			}
+			if ( physx::Pxstricmp( inNode.mName, "scale" ) == 0 )
+			{
+				readAllProperties( PxRepXInstantiationArgs( mRegistry.getPhysics() ), theReader, &mScale, instantiationAllocator, mCollection );
+				return true;
+			}
+			if ( physx::Pxstricmp( inNode.mName, "version" ) == 0 )
+				return true;
+
+			PxRepXSerializer* theSerializer = mRegistry.getRepXSerializer( inNode.mName );
+			if ( theSerializer == NULL )
+			{
+				PxGetFoundation().error(PxErrorCode::eINTERNAL_ERROR, __FILE__, __LINE__, 
+					"PxSerialization::createCollectionFromXml: "
+					"PxRepXSerializer missing for type %s", inNode.mName);
+				return false;
+			}
+
+			PxSerialObjectId theId = 0;
+			theReader.read( "Id", theId );
+			PxRepXObject theLiveObject = theSerializer->fileToObject( theReader, instantiationAllocator, mArgs, &mCollection );
+			if ( !theLiveObject.isValid() )
+				return false;
+
+			const PxBase* s = reinterpret_cast<const PxBase*>( theLiveObject.serializable );
+			mCollection.add( *const_cast<PxBase*>(s), theId );
+			return true;
+		}
+
+		void releaseObjectAllocator()
+		{
+			//The node strings are never returned to the pools, dropping the whole allocator is
+			//the only way to get the memory of an instantiated object back.
+			if ( mObjectAllocator )
+			{
+				mObjectAllocator->~XmlMemoryAllocatorImpl();
+				mAllocator.deallocate( mObjectAllocator );
+				mObjectAllocator = NULL;
+			}
+			mCurrentNode = NULL;
+		}
+	};
+
 	struct RepXCollectionSharedData
 	{
 		PxProfileAllocatorWrapper		mWrapper;
@@ -804,28 +970,54 @@ namespace physx { namespace Sn {
 			collection->add(*const_cast<PxCollection*>(externalRefs));
 
 		PxAllocatorCallback& allocator = *PxGetAllocatorCallback();
-		Sn::RepXCollection* theRepXCollection = Sn::create(sn, inputData, allocator, *collection);
-		theRepXCollection = &Sn::RepXUpgrader::upgradeCollection( *theRepXCollection );
-				
 		PxRepXInstantiationArgs args( sn.getPhysics(), &cooking, stringTable );  
-		if( !theRepXCollection->instantiateCollection(args, *collection) )
+
+		//Objects are created while the document streams in, 16KB at a time.
+		Sn::XmlStreamingParser theParser( sn, args, *collection, allocator );
+		inputData.seek(0);
+		shdfnd::FastXml* theFastXml = shdfnd::createFastXml( &theParser );
+		theFastXml->processXml( inputData, true );
+		theFastXml->release();
+
+		if( theParser.hasFailed() )
 		{
 			collection->release();
-			theRepXCollection->destroy();
 			return NULL;
 		}
+
+		PxVec3 upVector = theParser.getUpVector();
+		PxTolerancesScale scale = theParser.getTolerancesScale();
+		if( theParser.isUpgradeRequired() )
+		{
+			//Older documents go through the upgrader, which needs the whole document in memory.
+			Sn::RepXCollection* theRepXCollection = Sn::create(sn, inputData, allocator, *collection);
+			theRepXCollection = &Sn::RepXUpgrader::upgradeCollection( *theRepXCollection );
+				
+			if( !theRepXCollection->instantiateCollection(args, *collection) )
+			{
+				collection->release();
+				theRepXCollection->destroy();
+				return NULL;
+			}
+			upVector = theRepXCollection->getUpVector();
+			scale = theRepXCollection->getTolerancesScale();
+			theRepXCollection->destroy();
+		}
+		else if( !theParser.foundRoot() )
+		{
+			PxGetFoundation().error(PxErrorCode::eDEBUG_WARNING, __FILE__, __LINE__, 
+			"Cannot parse any object from the input buffer, please check the input repx data.");
+		}
 		
 		if( externalRefs )
 			collection->remove(*const_cast<PxCollection*>(externalRefs));
 		
 		if(outArgs != NULL)
 		{
-			outArgs->upVector = theRepXCollection->getUpVector();
-			outArgs->scale = theRepXCollection->getTolerancesScale();
+			outArgs->upVector = upVector;
+			outArgs->scale = scale;
 		}
 
-		theRepXCollection->destroy();
-		
 		return collection;
 	}
 } 
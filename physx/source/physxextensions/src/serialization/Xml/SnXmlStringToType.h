@@ -51,18 +51,127 @@ namespace physx { namespace Sn {
 		bool compile_error;
 	};
 
+	//Fast paths for the plain decimal numbers the xml writer produces. Both return false and leave
+	//ioData untouched for anything they cannot convert exactly (no digits, too many digits, hex, inf,
+	//nan...), the caller then falls back to the crt conversion. On success ioData is advanced just like
+	//strtoul/strtod would advance it.
+	PX_INLINE bool fastStrToU64( const char*& ioData, PxU64& outValue )
+	{
+		const char* theData = ioData;
+		while ( isspace( static_cast<unsigned char>(*theData) ) )
+			++theData;
+		bool negative = false;
+		if ( *theData == '-' || *theData == '+' )
+			negative = *theData++ == '-';
+
+		PxU64 theValue = 0;
+		PxU32 nbDigits = 0;
+		for ( ; *theData >= '0' && *theData <= '9'; ++theData, ++nbDigits )
+			theValue = theValue * 10 + PxU64( *theData - '0' );
+
+		//19 digits always fit in 64 bits, more than that could overflow.
+		if ( nbDigits == 0 || nbDigits > 19 )
+			return false;
+
+		outValue = negative ? PxU64(0) - theValue : theValue;
+		ioData = theData;
+		return true;
+	}
+
+	PX_INLINE bool fastStrToDouble( const char*& ioData, double& outValue )
+	{
+		//Powers of ten up to 1e22 are exactly representable as doubles.
+		static const double gPowersOfTen[] = 
+		{
+			1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+		};
+
+		const char* theData = ioData;
+		while ( isspace( static_cast<unsigned char>(*theData) ) )
+			++theData;
+		bool negative = false;
+		if ( *theData == '-' || *theData == '+' )
+			negative = *theData++ == '-';
+
+		PxU64 theMantissa = 0;
+		PxU32 nbSignificantDigits = 0;
+		PxU32 nbDigits = 0;
+		PxI32 theExponent = 0;
+		for ( ; *theData >= '0' && *theData <= '9'; ++theData, ++nbDigits )
+		{
+			theMantissa = theMantissa * 10 + PxU64( *theData - '0' );
+			if ( theMantissa )
+				++nbSignificantDigits;
+		}
+		if ( *theData == '.' )
+		{
+			++theData;
+			for ( ; *theData >= '0' && *theData <= '9'; ++theData, ++nbDigits )
+			{
+				theMantissa = theMantissa * 10 + PxU64( *theData - '0' );
+				if ( theMantissa )
+					++nbSignificantDigits;
+				--theExponent;
+			}
+		}
+		//Up to 15 digits the mantissa is exact in a double (10^15 < 2^53).
+		if ( nbDigits == 0 || nbSignificantDigits > 15 )
+			return false;
+
+		if ( *theData == 'e' || *theData == 'E' )
+		{
+			++theData;
+			bool negativeExponent = false;
+			if ( *theData == '-' || *theData == '+' )
+				negativeExponent = *theData++ == '-';
+			if ( *theData < '0' || *theData > '9' )
+				return false;
+			PxI32 theExplicitExponent = 0;
+			for ( ; *theData >= '0' && *theData <= '9' && theExplicitExponent < 1000; ++theData )
+				theExplicitExponent = theExplicitExponent * 10 + PxI32( *theData - '0' );
+			theExponent += negativeExponent ? -theExplicitExponent : theExplicitExponent;
+		}
+
+		//Anything glued to the number (hex digits, 'inf', 'nan', a huge exponent...) goes through strtod.
+		if ( *theData && !isspace( static_cast<unsigned char>(*theData) ) )
+			return false;
+
+		double theValue = double( theMantissa );
+		if ( theMantissa )
+		{
+			//Exact mantissa times an exact power of ten is a single correctly rounded operation,
+			//which gives the same result as strtod.
+			if ( theExponent < -22 || theExponent > 22 )
+				return false;
+			theValue = theExponent < 0 ? theValue / gPowersOfTen[-theExponent] : theValue * gPowersOfTen[theExponent];
+		}
+		outValue = negative ? -theValue : theValue;
+		ioData = theData;
+		return true;
+	}
+
 	template<> struct StrToImpl<PxU64> { 
 		//Id's (void ptrs) are written to file as unsigned
 		//64 bit integers, so this method gets called more
 		//often than one might think.
 		PX_INLINE void strto( PxU64& ioDatatype,const char*& ioData )
 		{
-			ioDatatype = _strtoui64( ioData, const_cast<char **>(&ioData), 10 );
+			if ( !fastStrToU64( ioData, ioDatatype ) )
+				ioDatatype = _strtoui64( ioData, const_cast<char **>(&ioData), 10 );
 		}
 	};
 
 	PX_INLINE PxF32 strToFloat(const char *str,const char **nextScan)
 	{
+		double fastValue;
+		if ( fastStrToDouble( str, fastValue ) )
+		{
+			if ( nextScan )
+				*nextScan = str;
+			return PxF32(fastValue);
+		}
+
 		PxF32 ret;
 		while ( *str && isspace(static_cast<unsigned char>(*str))) str++; // skip leading whitespace
 		char temp[256] = "";
@@ -86,14 +195,22 @@ namespace physx { namespace Sn {
 	template<> struct StrToImpl<PxU32> { 
 	PX_INLINE void strto( PxU32& ioDatatype,const char*& ioData )
 	{
-		ioDatatype = static_cast<PxU32>( strtoul( ioData,const_cast<char **>(&ioData), 10 ) );
+		PxU64 theValue;
+		if ( fastStrToU64( ioData, theValue ) )
+			ioDatatype = static_cast<PxU32>( theValue );
+		else
+			ioDatatype = static_cast<PxU32>( strtoul( ioData,const_cast<char **>(&ioData), 10 ) );
 	}
 	};
 
 	template<> struct StrToImpl<PxI32> { 
 	PX_INLINE void strto( PxI32& ioDatatype,const char*& ioData )
 	{
-		ioDatatype = static_cast<PxI32>( strtoul( ioData,const_cast<char **>(&ioData), 10 ) );
+		PxU64 theValue;
+		if ( fastStrToU64( ioData, theValue ) )
+			ioDatatype = static_cast<PxI32>( theValue );
+		else
+			ioDatatype = static_cast<PxI32>( strtoul( ioData,const_cast<char **>(&ioData), 10 ) );
 	}
 	};
 
@@ -101,7 +218,11 @@ namespace physx { namespace Sn {
 	template<> struct StrToImpl<PxU16> {
 	PX_INLINE void strto( PxU16& ioDatatype,const char*& ioData )
 	{
-		ioDatatype = static_cast<PxU16>( strtoul( ioData,const_cast<char **>(&ioData), 10 ) );
+		PxU64 theValue;
+		if ( fastStrToU64( ioData, theValue ) )
+			ioDatatype = static_cast<PxU16>( theValue );
+		else
+			ioDatatype = static_cast<PxU16>( strtoul( ioData,const_cast<char **>(&ioData), 10 ) );
 	}
 	};
 
@@ -184,7 +305,11 @@ namespace physx { namespace Sn {
 	template<> struct StrToImpl<PxU8> {
 	PX_INLINE void strto( PxU8& ioType,const char* & inValue)
 	{
-		ioType = static_cast<PxU8>( strtoul( inValue,const_cast<char **>(&inValue), 10 ) );
+		PxU64 theValue;
+		if ( fastStrToU64( inValue, theValue ) )
+			ioType = static_cast<PxU8>( theValue );
+		else
+			ioType = static_cast<PxU8>( strtoul( inValue,const_cast<char **>(&inValue), 10 ) );
 	}
 	};
 
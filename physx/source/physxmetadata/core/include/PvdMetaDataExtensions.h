@@ -105,6 +105,34 @@ struct IndexerToNameMap
 	PxEnumTraits<TEnumType> Converter;
 };
 
+//The worker statistics are indexed by a plain slot number, so they get their own names instead of enum names.
+static PxU32ToName g_physx__PxSimulationStatistics__WorkerIndexConversion[] = {
+		{ "0", 0 }, { "1", 1 }, { "2", 2 }, { "3", 3 }, { "4", 4 }, { "5", 5 }, { "6", 6 }, { "7", 7 },
+		{ "8", 8 }, { "9", 9 }, { "10", 10 }, { "11", 11 }, { "12", 12 }, { "13", 13 }, { "14", 14 }, { "15", 15 },
+		{ "16", 16 }, { "17", 17 }, { "18", 18 }, { "19", 19 }, { "20", 20 }, { "21", 21 }, { "22", 22 }, { "23", 23 },
+		{ "24", 24 }, { "25", 25 }, { "26", 26 }, { "27", 27 }, { "28", 28 }, { "29", 29 }, { "30", 30 }, { "31", 31 },
+		{ "32", 32 }, { "33", 33 }, { "34", 34 }, { "35", 35 }, { "36", 36 }, { "37", 37 }, { "38", 38 }, { "39", 39 },
+		{ "40", 40 }, { "41", 41 }, { "42", 42 }, { "43", 43 }, { "44", 44 }, { "45", 45 }, { "46", 46 }, { "47", 47 },
+		{ "48", 48 }, { "49", 49 }, { "50", 50 }, { "51", 51 }, { "52", 52 }, { "53", 53 }, { "54", 54 }, { "55", 55 },
+		{ "56", 56 }, { "57", 57 }, { "58", 58 }, { "59", 59 }, { "60", 60 }, { "61", 61 }, { "62", 62 }, { "63", 63 },
+		{ NULL, 0 }
+	};
+PX_COMPILE_TIME_ASSERT( sizeof( g_physx__PxSimulationStatistics__WorkerIndexConversion ) / sizeof( PxU32ToName ) == PxSimulationStatistics::eMAX_NB_WORKERS + 1 );
+
+struct PxSimulationStatisticsWorkerIndexTraits
+{
+	PxSimulationStatisticsWorkerIndexTraits() : NameConversion( g_physx__PxSimulationStatistics__WorkerIndexConversion ) {}
+	const PxU32ToName* NameConversion;
+};
+
+#define DEFINE_WORKER_INDEXED_PROPERTY( propName ) \
+template<> struct IndexerToNameMap<PxPropertyInfoName::PxSimulationStatistics_##propName, PxU32> { PxSimulationStatisticsWorkerIndexTraits Converter; };
+
+DEFINE_WORKER_INDEXED_PROPERTY( WorkerNbTasks )
+DEFINE_WORKER_INDEXED_PROPERTY( WorkerBusyTime )
+DEFINE_WORKER_INDEXED_PROPERTY( WorkerIdleTime )
+#undef DEFINE_WORKER_INDEXED_PROPERTY
+
 struct ValueStructOffsetRecord
 {
 	mutable bool	mHasValidOffset;
@@ -396,6 +396,8 @@ PxSceneDesc_GpuMaxNumPartitions,
 PxSceneDesc_GpuMaxNumStaticPartitions,
 PxSceneDesc_GpuComputeVersion,
 PxSceneDesc_ContactPairSlabSize,
+PxSceneDesc_TaskPoolChunkSize,
+PxSceneDesc_TaskPoolSize,
 PxSceneDesc_PropertiesStop,
 PxBroadPhaseDesc_PropertiesStart,
 PxBroadPhaseDesc_IsValid,
@@ -474,11 +476,24 @@ PxSimulationStatistics_GpuMemHeapHairSystems,
 PxSimulationStatistics_GpuMemHeapOther,
 PxSimulationStatistics_NbBroadPhaseAdds,
 PxSimulationStatistics_NbBroadPhaseRemoves,
+PxSimulationStatistics_SimulationWallTime,
+PxSimulationStatistics_NbWorkers,
+PxSimulationStatistics_ScratchPeakTotalBytes,
+PxSimulationStatistics_ScratchHeapFallbackBytes,
+PxSimulationStatistics_TaskPoolBytes,
+PxSimulationStatistics_TaskPoolPeakBytes,
 PxSimulationStatistics_NbDiscreteContactPairs,
 PxSimulationStatistics_NbModifiedContactPairs,
 PxSimulationStatistics_NbCCDPairs,
 PxSimulationStatistics_NbTriggerPairs,
 PxSimulationStatistics_NbShapes,
+PxSimulationStatistics_PhaseWallTime,
+PxSimulationStatistics_PhaseCpuTime,
+PxSimulationStatistics_PhaseNbTasks,
+PxSimulationStatistics_WorkerNbTasks,
+PxSimulationStatistics_WorkerBusyTime,
+PxSimulationStatistics_WorkerIdleTime,
+PxSimulationStatistics_ScratchPeakBytes,
 PxSimulationStatistics_PropertiesStop,
 
 
@@ -2909,6 +2909,7 @@ template<> struct PxEnumTraits< physx::PxActorCacheFlag::Enum > { PxEnumTraits()
 template<> struct PxEnumTraits< physx::PxHeightFieldFormat::Enum > { PxEnumTraits() : NameConversion( g_physx__PxHeightFieldFormat__EnumConversion ) {} const PxU32ToName* NameConversion; }; 
 	static PxU32ToName g_physx__PxHeightFieldFlag__EnumConversion[] = {
 		{ "eNO_BOUNDARY_EDGES", static_cast<PxU32>( physx::PxHeightFieldFlag::eNO_BOUNDARY_EDGES ) },
+		{ "eMIN_MAX_PYRAMID", static_cast<PxU32>( physx::PxHeightFieldFlag::eMIN_MAX_PYRAMID ) },
 		{ NULL, 0 }
 	};
 
@@ -3237,6 +3238,8 @@ template<> struct PxEnumTraits< physx::PxBVHBuildStrategy::Enum > { PxEnumTraits
 		PxU32 GpuMaxNumStaticPartitions;
 		PxU32 GpuComputeVersion;
 		PxU32 ContactPairSlabSize;
+		PxU32 TaskPoolChunkSize;
+		PxU32 TaskPoolSize;
 		 PX_PHYSX_CORE_API PxSceneDescGeneratedValues( const PxSceneDesc* inSource );
 	};
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSceneDesc, Gravity, PxSceneDescGeneratedValues)
@@ -3277,6 +3280,8 @@ template<> struct PxEnumTraits< physx::PxBVHBuildStrategy::Enum > { PxEnumTraits
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSceneDesc, GpuMaxNumStaticPartitions, PxSceneDescGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSceneDesc, GpuComputeVersion, PxSceneDescGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSceneDesc, ContactPairSlabSize, PxSceneDescGeneratedValues)
+	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSceneDesc, TaskPoolChunkSize, PxSceneDescGeneratedValues)
+	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSceneDesc, TaskPoolSize, PxSceneDescGeneratedValues)
 	struct PxSceneDescGeneratedInfo
 		: PxSceneQueryDescGeneratedInfo
 	{
@@ -3320,6 +3325,8 @@ template<> struct PxEnumTraits< physx::PxBVHBuildStrategy::Enum > { PxEnumTraits
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSceneDesc_GpuMaxNumStaticPartitions, PxSceneDesc, PxU32, PxU32 > GpuMaxNumStaticPartitions;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSceneDesc_GpuComputeVersion, PxSceneDesc, PxU32, PxU32 > GpuComputeVersion;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSceneDesc_ContactPairSlabSize, PxSceneDesc, PxU32, PxU32 > ContactPairSlabSize;
+		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSceneDesc_TaskPoolChunkSize, PxSceneDesc, PxU32, PxU32 > TaskPoolChunkSize;
+		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSceneDesc_TaskPoolSize, PxSceneDesc, PxU32, PxU32 > TaskPoolSize;
 
 		PX_PHYSX_CORE_API PxSceneDescGeneratedInfo();
 		template<typename TReturnType, typename TOperator>
@@ -3342,7 +3349,7 @@ template<> struct PxEnumTraits< physx::PxBVHBuildStrategy::Enum > { PxEnumTraits
 			inStartIndex = PxSceneQueryDescGeneratedInfo::visitInstanceProperties( inOperator, inStartIndex );
 			return inStartIndex;
 		}
-		static PxU32 instancePropertyCount() { return 39; }
+		static PxU32 instancePropertyCount() { return 41; }
 		static PxU32 totalPropertyCount() { return instancePropertyCount()
 				+ PxSceneQueryDescGeneratedInfo::totalPropertyCount(); }
 		template<typename TOperator>
@@ -3389,7 +3396,9 @@ template<> struct PxEnumTraits< physx::PxBVHBuildStrategy::Enum > { PxEnumTraits
 			inOperator( GpuMaxNumStaticPartitions, inStartIndex + 36 );; 
 			inOperator( GpuComputeVersion, inStartIndex + 37 );; 
 			inOperator( ContactPairSlabSize, inStartIndex + 38 );; 
-			return 39 + inStartIndex;
+			inOperator( TaskPoolChunkSize, inStartIndex + 39 );; 
+			inOperator( TaskPoolSize, inStartIndex + 40 );; 
+			return 41 + inStartIndex;
 		}
 	};
 	template<> struct PxClassInfoTraits<PxSceneDesc>
@@ -3651,6 +3660,30 @@ template<> struct PxEnumTraits< physx::PxBVHBuildStrategy::Enum > { PxEnumTraits
 	};
 
 template<> struct PxEnumTraits< physx::PxSimulationStatistics::RbPairStatsType > { PxEnumTraits() : NameConversion( g_physx__PxSimulationStatistics__RbPairStatsTypeConversion ) {} const PxU32ToName* NameConversion; }; 
+	static PxU32ToName g_physx__PxSimulationStatistics__PhaseTypeConversion[] = {
+		{ "eBROAD_PHASE", static_cast<PxU32>( physx::PxSimulationStatistics::eBROAD_PHASE ) },
+		{ "eNARROW_PHASE", static_cast<PxU32>( physx::PxSimulationStatistics::eNARROW_PHASE ) },
+		{ "eISLAND_GEN", static_cast<PxU32>( physx::PxSimulationStatistics::eISLAND_GEN ) },
+		{ "eSOLVER_SETUP", static_cast<PxU32>( physx::PxSimulationStatistics::eSOLVER_SETUP ) },
+		{ "eSOLVER", static_cast<PxU32>( physx::PxSimulationStatistics::eSOLVER ) },
+		{ "eINTEGRATION", static_cast<PxU32>( physx::PxSimulationStatistics::eINTEGRATION ) },
+		{ "eCCD", static_cast<PxU32>( physx::PxSimulationStatistics::eCCD ) },
+		{ "eSCENE_QUERY_UPDATE", static_cast<PxU32>( physx::PxSimulationStatistics::eSCENE_QUERY_UPDATE ) },
+		{ "eFETCH_RESULTS", static_cast<PxU32>( physx::PxSimulationStatistics::eFETCH_RESULTS ) },
+		{ NULL, 0 }
+	};
+
+template<> struct PxEnumTraits< physx::PxSimulationStatistics::PhaseType > { PxEnumTraits() : NameConversion( g_physx__PxSimulationStatistics__PhaseTypeConversion ) {} const PxU32ToName* NameConversion; }; 
+	static PxU32ToName g_physx__PxSimulationStatistics__ScratchUsageTypeConversion[] = {
+		{ "eSCRATCH_BROAD_PHASE", static_cast<PxU32>( physx::PxSimulationStatistics::eSCRATCH_BROAD_PHASE ) },
+		{ "eSCRATCH_NARROW_PHASE", static_cast<PxU32>( physx::PxSimulationStatistics::eSCRATCH_NARROW_PHASE ) },
+		{ "eSCRATCH_SOLVER", static_cast<PxU32>( physx::PxSimulationStatistics::eSCRATCH_SOLVER ) },
+		{ "eSCRATCH_CONSTRAINT_PROJECTION", static_cast<PxU32>( physx::PxSimulationStatistics::eSCRATCH_CONSTRAINT_PROJECTION ) },
+		{ "eSCRATCH_OTHER", static_cast<PxU32>( physx::PxSimulationStatistics::eSCRATCH_OTHER ) },
+		{ NULL, 0 }
+	};
+
+template<> struct PxEnumTraits< physx::PxSimulationStatistics::ScratchUsageType > { PxEnumTraits() : NameConversion( g_physx__PxSimulationStatistics__ScratchUsageTypeConversion ) {} const PxU32ToName* NameConversion; }; 
 	class PxSimulationStatistics;
 	struct PxSimulationStatisticsGeneratedValues
 	{
@@ -3696,11 +3729,24 @@ template<> struct PxEnumTraits< physx::PxSimulationStatistics::RbPairStatsType >
 		PxU64 GpuMemHeapOther;
 		PxU32 NbBroadPhaseAdds;
 		PxU32 NbBroadPhaseRemoves;
+		PxReal SimulationWallTime;
+		PxU32 NbWorkers;
+		PxU32 ScratchPeakTotalBytes;
+		PxU32 ScratchHeapFallbackBytes;
+		PxU64 TaskPoolBytes;
+		PxU64 TaskPoolPeakBytes;
 		PxU32 NbDiscreteContactPairs[PxGeometryType::eGEOMETRY_COUNT][PxGeometryType::eGEOMETRY_COUNT];
 		PxU32 NbModifiedContactPairs[PxGeometryType::eGEOMETRY_COUNT][PxGeometryType::eGEOMETRY_COUNT];
 		PxU32 NbCCDPairs[PxGeometryType::eGEOMETRY_COUNT][PxGeometryType::eGEOMETRY_COUNT];
 		PxU32 NbTriggerPairs[PxGeometryType::eGEOMETRY_COUNT][PxGeometryType::eGEOMETRY_COUNT];
 		PxU32 NbShapes[PxGeometryType::eGEOMETRY_COUNT];
+		PxReal PhaseWallTime[PxSimulationStatistics::ePHASE_COUNT];
+		PxReal PhaseCpuTime[PxSimulationStatistics::ePHASE_COUNT];
+		PxU32 PhaseNbTasks[PxSimulationStatistics::ePHASE_COUNT];
+		PxU32 WorkerNbTasks[PxSimulationStatistics::eMAX_NB_WORKERS];
+		PxReal WorkerBusyTime[PxSimulationStatistics::eMAX_NB_WORKERS];
+		PxReal WorkerIdleTime[PxSimulationStatistics::eMAX_NB_WORKERS];
+		PxU32 ScratchPeakBytes[PxSimulationStatistics::eSCRATCH_USAGE_COUNT];
 		 PX_PHYSX_CORE_API PxSimulationStatisticsGeneratedValues( const PxSimulationStatistics* inSource );
 	};
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, NbActiveConstraints, PxSimulationStatisticsGeneratedValues)
@@ -3745,11 +3791,24 @@ template<> struct PxEnumTraits< physx::PxSimulationStatistics::RbPairStatsType >
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, GpuMemHeapOther, PxSimulationStatisticsGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, NbBroadPhaseAdds, PxSimulationStatisticsGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, NbBroadPhaseRemoves, PxSimulationStatisticsGeneratedValues)
+	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, SimulationWallTime, PxSimulationStatisticsGeneratedValues)
+	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, NbWorkers, PxSimulationStatisticsGeneratedValues)
+	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, ScratchPeakTotalBytes, PxSimulationStatisticsGeneratedValues)
+	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, ScratchHeapFallbackBytes, PxSimulationStatisticsGeneratedValues)
+	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, TaskPoolBytes, PxSimulationStatisticsGeneratedValues)
+	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, TaskPoolPeakBytes, PxSimulationStatisticsGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, NbDiscreteContactPairs, PxSimulationStatisticsGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, NbModifiedContactPairs, PxSimulationStatisticsGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, NbCCDPairs, PxSimulationStatisticsGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, NbTriggerPairs, PxSimulationStatisticsGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, NbShapes, PxSimulationStatisticsGeneratedValues)
+	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, PhaseWallTime, PxSimulationStatisticsGeneratedValues)
+	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, PhaseCpuTime, PxSimulationStatisticsGeneratedValues)
+	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, PhaseNbTasks, PxSimulationStatisticsGeneratedValues)
+	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, WorkerNbTasks, PxSimulationStatisticsGeneratedValues)
+	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, WorkerBusyTime, PxSimulationStatisticsGeneratedValues)
+	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, WorkerIdleTime, PxSimulationStatisticsGeneratedValues)
+	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, ScratchPeakBytes, PxSimulationStatisticsGeneratedValues)
 	struct PxSimulationStatisticsGeneratedInfo
 
 	{
@@ -3796,11 +3855,24 @@ template<> struct PxEnumTraits< physx::PxSimulationStatistics::RbPairStatsType >
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_GpuMemHeapOther, PxSimulationStatistics, PxU64, PxU64 > GpuMemHeapOther;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_NbBroadPhaseAdds, PxSimulationStatistics, PxU32, PxU32 > NbBroadPhaseAdds;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_NbBroadPhaseRemoves, PxSimulationStatistics, PxU32, PxU32 > NbBroadPhaseRemoves;
+		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_SimulationWallTime, PxSimulationStatistics, PxReal, PxReal > SimulationWallTime;
+		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_NbWorkers, PxSimulationStatistics, PxU32, PxU32 > NbWorkers;
+		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_ScratchPeakTotalBytes, PxSimulationStatistics, PxU32, PxU32 > ScratchPeakTotalBytes;
+		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_ScratchHeapFallbackBytes, PxSimulationStatistics, PxU32, PxU32 > ScratchHeapFallbackBytes;
+		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_TaskPoolBytes, PxSimulationStatistics, PxU64, PxU64 > TaskPoolBytes;
+		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_TaskPoolPeakBytes, PxSimulationStatistics, PxU64, PxU64 > TaskPoolPeakBytes;
 		NbDiscreteContactPairsProperty NbDiscreteContactPairs;
 		NbModifiedContactPairsProperty NbModifiedContactPairs;
 		NbCCDPairsProperty NbCCDPairs;
 		NbTriggerPairsProperty NbTriggerPairs;
 		NbShapesProperty NbShapes;
+		PhaseWallTimeProperty PhaseWallTime;
+		PhaseCpuTimeProperty PhaseCpuTime;
+		PhaseNbTasksProperty PhaseNbTasks;
+		WorkerNbTasksProperty WorkerNbTasks;
+		WorkerBusyTimeProperty WorkerBusyTime;
+		WorkerIdleTimeProperty WorkerIdleTime;
+		ScratchPeakBytesProperty ScratchPeakBytes;
 
 		PX_PHYSX_CORE_API PxSimulationStatisticsGeneratedInfo();
 		template<typename TReturnType, typename TOperator>
@@ -3820,7 +3892,7 @@ template<> struct PxEnumTraits< physx::PxSimulationStatistics::RbPairStatsType >
 			PX_UNUSED(inStartIndex);
 			return inStartIndex;
 		}
-		static PxU32 instancePropertyCount() { return 47; }
+		static PxU32 instancePropertyCount() { return 60; }
 		static PxU32 totalPropertyCount() { return instancePropertyCount(); }
 		template<typename TOperator>
 		PxU32 visitInstanceProperties( TOperator inOperator, PxU32 inStartIndex = 0 ) const
@@ -3869,12 +3941,25 @@ template<> struct PxEnumTraits< physx::PxSimulationStatistics::RbPairStatsType >
 			inOperator( GpuMemHeapOther, inStartIndex + 39 );; 
 			inOperator( NbBroadPhaseAdds, inStartIndex + 40 );; 
 			inOperator( NbBroadPhaseRemoves, inStartIndex + 41 );; 
-			inOperator( NbDiscreteContactPairs, inStartIndex + 42 );; 
-			inOperator( NbModifiedContactPairs, inStartIndex + 43 );; 
-			inOperator( NbCCDPairs, inStartIndex + 44 );; 
-			inOperator( NbTriggerPairs, inStartIndex + 45 );; 
-			inOperator( NbShapes, inStartIndex + 46 );; 
-			return 47 + inStartIndex;
+			inOperator( SimulationWallTime, inStartIndex + 42 );; 
+			inOperator( NbWorkers, inStartIndex + 43 );; 
+			inOperator( ScratchPeakTotalBytes, inStartIndex + 44 );; 
+			inOperator( ScratchHeapFallbackBytes, inStartIndex + 45 );; 
+			inOperator( TaskPoolBytes, inStartIndex + 46 );; 
+			inOperator( TaskPoolPeakBytes, inStartIndex + 47 );; 
+			inOperator( NbDiscreteContactPairs, inStartIndex + 48 );; 
+			inOperator( NbModifiedContactPairs, inStartIndex + 49 );; 
+			inOperator( NbCCDPairs, inStartIndex + 50 );; 
+			inOperator( NbTriggerPairs, inStartIndex + 51 );; 
+			inOperator( NbShapes, inStartIndex + 52 );; 
+			inOperator( PhaseWallTime, inStartIndex + 53 );; 
+			inOperator( PhaseCpuTime, inStartIndex + 54 );; 
+			inOperator( PhaseNbTasks, inStartIndex + 55 );; 
+			inOperator( WorkerNbTasks, inStartIndex + 56 );; 
+			inOperator( WorkerBusyTime, inStartIndex + 57 );; 
+			inOperator( WorkerIdleTime, inStartIndex + 58 );; 
+			inOperator( ScratchPeakBytes, inStartIndex + 59 );; 
+			return 60 + inStartIndex;
 		}
 	};
 	template<> struct PxClassInfoTraits<PxSimulationStatistics>
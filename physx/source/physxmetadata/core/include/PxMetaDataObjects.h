@@ -623,6 +623,42 @@ struct NbTriggerPairsProperty : public PxDualIndexedPropertyInfo<PxPropertyInfoN
 	PX_PHYSX_CORE_API NbTriggerPairsProperty();
 };
 
+// The worker properties are indexed by the slot of the worker, from 0 to PxSimulationStatistics::eMAX_NB_WORKERS - 1
+struct PhaseWallTimeProperty : public PxIndexedPropertyInfo<PxPropertyInfoName::PxSimulationStatistics_PhaseWallTime, PxSimulationStatistics, PxSimulationStatistics::PhaseType, PxReal>
+{
+	PX_PHYSX_CORE_API PhaseWallTimeProperty();
+};
+
+struct PhaseCpuTimeProperty : public PxIndexedPropertyInfo<PxPropertyInfoName::PxSimulationStatistics_PhaseCpuTime, PxSimulationStatistics, PxSimulationStatistics::PhaseType, PxReal>
+{
+	PX_PHYSX_CORE_API PhaseCpuTimeProperty();
+};
+
+struct PhaseNbTasksProperty : public PxIndexedPropertyInfo<PxPropertyInfoName::PxSimulationStatistics_PhaseNbTasks, PxSimulationStatistics, PxSimulationStatistics::PhaseType, PxU32>
+{
+	PX_PHYSX_CORE_API PhaseNbTasksProperty();
+};
+
+struct WorkerNbTasksProperty : public PxIndexedPropertyInfo<PxPropertyInfoName::PxSimulationStatistics_WorkerNbTasks, PxSimulationStatistics, PxU32, PxU32>
+{
+	PX_PHYSX_CORE_API WorkerNbTasksProperty();
+};
+
+struct WorkerBusyTimeProperty : public PxIndexedPropertyInfo<PxPropertyInfoName::PxSimulationStatistics_WorkerBusyTime, PxSimulationStatistics, PxU32, PxReal>
+{
+	PX_PHYSX_CORE_API WorkerBusyTimeProperty();
+};
+
+struct WorkerIdleTimeProperty : public PxIndexedPropertyInfo<PxPropertyInfoName::PxSimulationStatistics_WorkerIdleTime, PxSimulationStatistics, PxU32, PxReal>
+{
+	PX_PHYSX_CORE_API WorkerIdleTimeProperty();
+};
+
+struct ScratchPeakBytesProperty : public PxIndexedPropertyInfo<PxPropertyInfoName::PxSimulationStatistics_ScratchPeakBytes, PxSimulationStatistics, PxSimulationStatistics::ScratchUsageType, PxU32>
+{
+	PX_PHYSX_CORE_API ScratchPeakBytesProperty();
+};
+
 
 struct SimulationStatisticsProperty : public PxReadOnlyPropertyInfo<PxPropertyInfoName::PxScene_SimulationStatistics, PxScene, PxSimulationStatistics>
 {
@@ -1273,6 +1273,10 @@ inline PxU32 getPxSceneDescGpuComputeVersion( const PxSceneDesc* inOwner ) { ret
 inline void setPxSceneDescGpuComputeVersion( PxSceneDesc* inOwner, PxU32 inData) { inOwner->gpuComputeVersion = inData; }
 inline PxU32 getPxSceneDescContactPairSlabSize( const PxSceneDesc* inOwner ) { return inOwner->contactPairSlabSize; }
 inline void setPxSceneDescContactPairSlabSize( PxSceneDesc* inOwner, PxU32 inData) { inOwner->contactPairSlabSize = inData; }
+inline PxU32 getPxSceneDescTaskPoolChunkSize( const PxSceneDesc* inOwner ) { return inOwner->taskPoolChunkSize; }
+inline void setPxSceneDescTaskPoolChunkSize( PxSceneDesc* inOwner, PxU32 inData) { inOwner->taskPoolChunkSize = inData; }
+inline PxU32 getPxSceneDescTaskPoolSize( const PxSceneDesc* inOwner ) { return inOwner->taskPoolSize; }
+inline void setPxSceneDescTaskPoolSize( PxSceneDesc* inOwner, PxU32 inData) { inOwner->taskPoolSize = inData; }
 PX_PHYSX_CORE_API PxSceneDescGeneratedInfo::PxSceneDescGeneratedInfo()
 	: ToDefault( "ToDefault", setPxSceneDesc_ToDefault)
 	, Gravity( "Gravity", setPxSceneDescGravity, getPxSceneDescGravity )
@@ -1313,6 +1317,8 @@ PX_PHYSX_CORE_API PxSceneDescGeneratedInfo::PxSceneDescGeneratedInfo()
 	, GpuMaxNumStaticPartitions( "GpuMaxNumStaticPartitions", setPxSceneDescGpuMaxNumStaticPartitions, getPxSceneDescGpuMaxNumStaticPartitions )
 	, GpuComputeVersion( "GpuComputeVersion", setPxSceneDescGpuComputeVersion, getPxSceneDescGpuComputeVersion )
 	, ContactPairSlabSize( "ContactPairSlabSize", setPxSceneDescContactPairSlabSize, getPxSceneDescContactPairSlabSize )
+	, TaskPoolChunkSize( "TaskPoolChunkSize", setPxSceneDescTaskPoolChunkSize, getPxSceneDescTaskPoolChunkSize )
+	, TaskPoolSize( "TaskPoolSize", setPxSceneDescTaskPoolSize, getPxSceneDescTaskPoolSize )
 {}
 PX_PHYSX_CORE_API PxSceneDescGeneratedValues::PxSceneDescGeneratedValues( const PxSceneDesc* inSource )
 		:PxSceneQueryDescGeneratedValues( inSource )
@@ -1354,6 +1360,8 @@ PX_PHYSX_CORE_API PxSceneDescGeneratedValues::PxSceneDescGeneratedValues( const
 		,GpuMaxNumStaticPartitions( inSource->gpuMaxNumStaticPartitions )
 		,GpuComputeVersion( inSource->gpuComputeVersion )
 		,ContactPairSlabSize( inSource->contactPairSlabSize )
+		,TaskPoolChunkSize( inSource->taskPoolChunkSize )
+		,TaskPoolSize( inSource->taskPoolSize )
 {
 	PX_UNUSED(inSource);
 }
@@ -1569,6 +1577,18 @@ inline PxU32 getPxSimulationStatisticsNbBroadPhaseAdds( const PxSimulationStatis
 inline void setPxSimulationStatisticsNbBroadPhaseAdds( PxSimulationStatistics* inOwner, PxU32 inData) { inOwner->nbBroadPhaseAdds = inData; }
 inline PxU32 getPxSimulationStatisticsNbBroadPhaseRemoves( const PxSimulationStatistics* inOwner ) { return inOwner->nbBroadPhaseRemoves; }
 inline void setPxSimulationStatisticsNbBroadPhaseRemoves( PxSimulationStatistics* inOwner, PxU32 inData) { inOwner->nbBroadPhaseRemoves = inData; }
+inline PxReal getPxSimulationStatisticsSimulationWallTime( const PxSimulationStatistics* inOwner ) { return inOwner->simulationWallTime; }
+inline void setPxSimulationStatisticsSimulationWallTime( PxSimulationStatistics* inOwner, PxReal inData) { inOwner->simulationWallTime = inData; }
+inline PxU32 getPxSimulationStatisticsNbWorkers( const PxSimulationStatistics* inOwner ) { return inOwner->nbWorkers; }
+inline void setPxSimulationStatisticsNbWorkers( PxSimulationStatistics* inOwner, PxU32 inData) { inOwner->nbWorkers = inData; }
+inline PxU32 getPxSimulationStatisticsScratchPeakTotalBytes( const PxSimulationStatistics* inOwner ) { return inOwner->scratchPeakTotalBytes; }
+inline void setPxSimulationStatisticsScratchPeakTotalBytes( PxSimulationStatistics* inOwner, PxU32 inData) { inOwner->scratchPeakTotalBytes = inData; }
+inline PxU32 getPxSimulationStatisticsScratchHeapFallbackBytes( const PxSimulationStatistics* inOwner ) { return inOwner->scratchHeapFallbackBytes; }
+inline void setPxSimulationStatisticsScratchHeapFallbackBytes( PxSimulationStatistics* inOwner, PxU32 inData) { inOwner->scratchHeapFallbackBytes = inData; }
+inline PxU64 getPxSimulationStatisticsTaskPoolBytes( const PxSimulationStatistics* inOwner ) { return inOwner->taskPoolBytes; }
+inline void setPxSimulationStatisticsTaskPoolBytes( PxSimulationStatistics* inOwner, PxU64 inData) { inOwner->taskPoolBytes = inData; }
+inline PxU64 getPxSimulationStatisticsTaskPoolPeakBytes( const PxSimulationStatistics* inOwner ) { return inOwner->taskPoolPeakBytes; }
+inline void setPxSimulationStatisticsTaskPoolPeakBytes( PxSimulationStatistics* inOwner, PxU64 inData) { inOwner->taskPoolPeakBytes = inData; }
 PX_PHYSX_CORE_API PxSimulationStatisticsGeneratedInfo::PxSimulationStatisticsGeneratedInfo()
 	: NbActiveConstraints( "NbActiveConstraints", setPxSimulationStatisticsNbActiveConstraints, getPxSimulationStatisticsNbActiveConstraints )
 	, NbActiveDynamicBodies( "NbActiveDynamicBodies", setPxSimulationStatisticsNbActiveDynamicBodies, getPxSimulationStatisticsNbActiveDynamicBodies )
@@ -1612,6 +1632,12 @@ PX_PHYSX_CORE_API PxSimulationStatisticsGeneratedInfo::PxSimulationStatisticsGen
 	, GpuMemHeapOther( "GpuMemHeapOther", setPxSimulationStatisticsGpuMemHeapOther, getPxSimulationStatisticsGpuMemHeapOther )
 	, NbBroadPhaseAdds( "NbBroadPhaseAdds", setPxSimulationStatisticsNbBroadPhaseAdds, getPxSimulationStatisticsNbBroadPhaseAdds )
 	, NbBroadPhaseRemoves( "NbBroadPhaseRemoves", setPxSimulationStatisticsNbBroadPhaseRemoves, getPxSimulationStatisticsNbBroadPhaseRemoves )
+	, SimulationWallTime( "SimulationWallTime", setPxSimulationStatisticsSimulationWallTime, getPxSimulationStatisticsSimulationWallTime )
+	, NbWorkers( "NbWorkers", setPxSimulationStatisticsNbWorkers, getPxSimulationStatisticsNbWorkers )
+	, ScratchPeakTotalBytes( "ScratchPeakTotalBytes", setPxSimulationStatisticsScratchPeakTotalBytes, getPxSimulationStatisticsScratchPeakTotalBytes )
+	, ScratchHeapFallbackBytes( "ScratchHeapFallbackBytes", setPxSimulationStatisticsScratchHeapFallbackBytes, getPxSimulationStatisticsScratchHeapFallbackBytes )
+	, TaskPoolBytes( "TaskPoolBytes", setPxSimulationStatisticsTaskPoolBytes, getPxSimulationStatisticsTaskPoolBytes )
+	, TaskPoolPeakBytes( "TaskPoolPeakBytes", setPxSimulationStatisticsTaskPoolPeakBytes, getPxSimulationStatisticsTaskPoolPeakBytes )
 {}
 PX_PHYSX_CORE_API PxSimulationStatisticsGeneratedValues::PxSimulationStatisticsGeneratedValues( const PxSimulationStatistics* inSource )
 		:NbActiveConstraints( inSource->nbActiveConstraints )
@@ -1656,6 +1682,12 @@ PX_PHYSX_CORE_API PxSimulationStatisticsGeneratedValues::PxSimulationStatisticsG
 		,GpuMemHeapOther( inSource->gpuMemHeapOther )
 		,NbBroadPhaseAdds( inSource->nbBroadPhaseAdds )
 		,NbBroadPhaseRemoves( inSource->nbBroadPhaseRemoves )
+		,SimulationWallTime( inSource->simulationWallTime )
+		,NbWorkers( inSource->nbWorkers )
+		,ScratchPeakTotalBytes( inSource->scratchPeakTotalBytes )
+		,ScratchHeapFallbackBytes( inSource->scratchHeapFallbackBytes )
+		,TaskPoolBytes( inSource->taskPoolBytes )
+		,TaskPoolPeakBytes( inSource->taskPoolPeakBytes )
 {
 	PX_UNUSED(inSource);
 	PxMemCopy( NbDiscreteContactPairs, inSource->nbDiscreteContactPairs, sizeof( NbDiscreteContactPairs ) );
@@ -1663,4 +1695,11 @@ PX_PHYSX_CORE_API PxSimulationStatisticsGeneratedValues::PxSimulationStatisticsG
 	PxMemCopy( NbCCDPairs, inSource->nbCCDPairs, sizeof( NbCCDPairs ) );
 	PxMemCopy( NbTriggerPairs, inSource->nbTriggerPairs, sizeof( NbTriggerPairs ) );
 	PxMemCopy( NbShapes, inSource->nbShapes, sizeof( NbShapes ) );
+	PxMemCopy( PhaseWallTime, inSource->phaseWallTime, sizeof( PhaseWallTime ) );
+	PxMemCopy( PhaseCpuTime, inSource->phaseCpuTime, sizeof( PhaseCpuTime ) );
+	PxMemCopy( PhaseNbTasks, inSource->phaseNbTasks, sizeof( PhaseNbTasks ) );
+	PxMemCopy( WorkerNbTasks, inSource->workerNbTasks, sizeof( WorkerNbTasks ) );
+	PxMemCopy( WorkerBusyTime, inSource->workerBusyTime, sizeof( WorkerBusyTime ) );
+	PxMemCopy( WorkerIdleTime, inSource->workerIdleTime, sizeof( WorkerIdleTime ) );
+	PxMemCopy( ScratchPeakBytes, inSource->scratchPeakBytes, sizeof( ScratchPeakBytes ) );
 }
@@ -141,6 +141,76 @@ PX_PHYSX_CORE_API NbTriggerPairsProperty::NbTriggerPairsProperty()
 {
 }
 
+inline void SetPhaseWallTime( PxSimulationStatistics* inStats, PxSimulationStatistics::PhaseType idx, PxReal val ) { inStats->phaseWallTime[idx] = val; }
+inline PxReal GetPhaseWallTime( const PxSimulationStatistics* inStats, PxSimulationStatistics::PhaseType idx ) { return inStats->phaseWallTime[idx]; }
+PX_PHYSX_CORE_API PhaseWallTimeProperty::PhaseWallTimeProperty()
+	: PxIndexedPropertyInfo<PxPropertyInfoName::PxSimulationStatistics_PhaseWallTime
+			, PxSimulationStatistics
+			, PxSimulationStatistics::PhaseType
+			, PxReal> ( "PhaseWallTime", SetPhaseWallTime, GetPhaseWallTime )
+{
+}
+
+inline void SetPhaseCpuTime( PxSimulationStatistics* inStats, PxSimulationStatistics::PhaseType idx, PxReal val ) { inStats->phaseCpuTime[idx] = val; }
+inline PxReal GetPhaseCpuTime( const PxSimulationStatistics* inStats, PxSimulationStatistics::PhaseType idx ) { return inStats->phaseCpuTime[idx]; }
+PX_PHYSX_CORE_API PhaseCpuTimeProperty::PhaseCpuTimeProperty()
+	: PxIndexedPropertyInfo<PxPropertyInfoName::PxSimulationStatistics_PhaseCpuTime
+			, PxSimulationStatistics
+			, PxSimulationStatistics::PhaseType
+			, PxReal> ( "PhaseCpuTime", SetPhaseCpuTime, GetPhaseCpuTime )
+{
+}
+
+inline void SetPhaseNbTasks( PxSimulationStatistics* inStats, PxSimulationStatistics::PhaseType idx, PxU32 val ) { inStats->phaseNbTasks[idx] = val; }
+inline PxU32 GetPhaseNbTasks( const PxSimulationStatistics* inStats, PxSimulationStatistics::PhaseType idx ) { return inStats->phaseNbTasks[idx]; }
+PX_PHYSX_CORE_API PhaseNbTasksProperty::PhaseNbTasksProperty()
+	: PxIndexedPropertyInfo<PxPropertyInfoName::PxSimulationStatistics_PhaseNbTasks
+			, PxSimulationStatistics
+			, PxSimulationStatistics::PhaseType
+			, PxU32> ( "PhaseNbTasks", SetPhaseNbTasks, GetPhaseNbTasks )
+{
+}
+
+inline void SetWorkerNbTasks( PxSimulationStatistics* inStats, PxU32 idx, PxU32 val ) { inStats->workerNbTasks[idx] = val; }
+inline PxU32 GetWorkerNbTasks( const PxSimulationStatistics* inStats, PxU32 idx ) { return inStats->workerNbTasks[idx]; }
+PX_PHYSX_CORE_API WorkerNbTasksProperty::WorkerNbTasksProperty()
+	: PxIndexedPropertyInfo<PxPropertyInfoName::PxSimulationStatistics_WorkerNbTasks
+			, PxSimulationStatistics
+			, PxU32
+			, PxU32> ( "WorkerNbTasks", SetWorkerNbTasks, GetWorkerNbTasks )
+{
+}
+
+inline void SetWorkerBusyTime( PxSimulationStatistics* inStats, PxU32 idx, PxReal val ) { inStats->workerBusyTime[idx] = val; }
+inline PxReal GetWorkerBusyTime( const PxSimulationStatistics* inStats, PxU32 idx ) { return inStats->workerBusyTime[idx]; }
+PX_PHYSX_CORE_API WorkerBusyTimeProperty::WorkerBusyTimeProperty()
+	: PxIndexedPropertyInfo<PxPropertyInfoName::PxSimulationStatistics_WorkerBusyTime
+			, PxSimulationStatistics
+			, PxU32
+			, PxReal> ( "WorkerBusyTime", SetWorkerBusyTime, GetWorkerBusyTime )
+{
+}
+
+inline void SetWorkerIdleTime( PxSimulationStatistics* inStats, PxU32 idx, PxReal val ) { inStats->workerIdleTime[idx] = val; }
+inline PxReal GetWorkerIdleTime( const PxSimulationStatistics* inStats, PxU32 idx ) { return inStats->workerIdleTime[idx]; }
+PX_PHYSX_CORE_API WorkerIdleTimeProperty::WorkerIdleTimeProperty()
+	: PxIndexedPropertyInfo<PxPropertyInfoName::PxSimulationStatistics_WorkerIdleTime
+			, PxSimulationStatistics
+			, PxU32
+			, PxReal> ( "WorkerIdleTime", SetWorkerIdleTime, GetWorkerIdleTime )
+{
+}
+
+inline void SetScratchPeakBytes( PxSimulationStatistics* inStats, PxSimulationStatistics::ScratchUsageType idx, PxU32 val ) { inStats->scratchPeakBytes[idx] = val; }
+inline PxU32 GetScratchPeakBytes( const PxSimulationStatistics* inStats, PxSimulationStatistics::ScratchUsageType idx ) { return inStats->scratchPeakBytes[idx]; }
+PX_PHYSX_CORE_API ScratchPeakBytesProperty::ScratchPeakBytesProperty()
+	: PxIndexedPropertyInfo<PxPropertyInfoName::PxSimulationStatistics_ScratchPeakBytes
+			, PxSimulationStatistics
+			, PxSimulationStatistics::ScratchUsageType
+			, PxU32> ( "ScratchPeakBytes", SetScratchPeakBytes, GetScratchPeakBytes )
+{
+}
+
 inline PxSimulationStatistics GetStats( const PxScene* inScene ) { PxSimulationStatistics stats; inScene->getSimulationStatistics( stats ); return stats; }
 PX_PHYSX_CORE_API SimulationStatisticsProperty::SimulationStatisticsProperty() 
 	: PxReadOnlyPropertyInfo<PxPropertyInfoName::PxScene_SimulationStatistics, PxScene, PxSimulationStatistics >( "SimulationStatistics", GetStats )
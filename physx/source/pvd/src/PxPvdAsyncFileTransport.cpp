@@ -0,0 +1,488 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#include "PxPvdAsyncFileTransport.h"
+#include "PxPvdBlockCodec.h"
+#include "PxPvdCommStreamEvents.h"
+#include "PxPvdFoundation.h"
+
+#include "foundation/PxAtomic.h"
+#include "foundation/PxMemory.h"
+
+namespace physx
+{
+namespace pvdsdk
+{
+
+namespace
+{
+// Every event sent by PvdDataStream is written between a lock() and an unlock() of the transport as an
+// EventGroup header followed by the event type and the event itself.
+const uint32_t EVENT_GROUP_HEADER_SIZE = 24;
+const uint32_t EVENT_GROUP_STREAM_ID_OFFSET = 8;
+
+PX_FORCE_INLINE uint8_t* allocateBytes(uint32_t size, const char* name)
+{
+	return reinterpret_cast<uint8_t*>(gPvdAllocatorCallback->allocate(size, name, __FILE__, __LINE__));
+}
+
+PX_FORCE_INLINE void deallocateBytes(uint8_t* ptr)
+{
+	if(ptr)
+		gPvdAllocatorCallback->deallocate(ptr);
+}
+}
+
+PvdAsyncFileTransport::Block::Block(uint32_t capacity) : mData(NULL), mSize(0), mCapacity(0), mNextToWrite(NULL)
+{
+	reserve(capacity);
+}
+
+PvdAsyncFileTransport::Block::~Block()
+{
+	deallocateBytes(mData);
+}
+
+void PvdAsyncFileTransport::Block::reserve(uint32_t capacity)
+{
+	if(capacity <= mCapacity)
+		return;
+	uint8_t* data = allocateBytes(capacity, "PvdAsyncFileTransport::Block");
+	if(mSize)
+		PxMemCopy(data, mData, mSize);
+	deallocateBytes(mData);
+	mData = data;
+	mCapacity = capacity;
+}
+
+PvdAsyncFileTransport::PvdAsyncFileTransport(const PxPvdAsyncFileTransportDesc& desc) :
+	mDesc(desc),
+	mConnected(false),
+	mLocked(false),
+	mCurrentBlock(NULL),
+	mSpanStart(0),
+	mNbDroppingStreams(0),
+	mBytesAccepted(0),
+	mQueuedBytes(0),
+	mHashTable(NULL),
+	mCompressed(NULL),
+	mCompressedCapacity(0),
+	mWriteFailed(0),
+	mNbBytesWritten(0)
+{
+	PxMemZero(&mStats, sizeof(mStats));
+
+	mFileBuffer = PX_NEW(PsFileBuffer)(desc.filename, PxFileBuf::OPEN_WRITE_ONLY);
+
+	if(mDesc.flags & PxPvdAsyncFileTransportFlag::eCOMPRESS)
+	{
+		mHashTable = PX_ALLOCATE(uint32_t, PVD_BLOCK_CODEC_HASH_SIZE, "PvdAsyncFileTransport::mHashTable");
+
+		const uint32_t header[2] = { PVD_COMPRESSED_CAPTURE_MAGIC, PVD_COMPRESSED_CAPTURE_VERSION };
+		if(mFileBuffer->isOpen())
+			writeToFile(header, sizeof(header));
+	}
+}
+
+PvdAsyncFileTransport::~PvdAsyncFileTransport()
+{
+}
+
+bool PvdAsyncFileTransport::connect()
+{
+	PX_ASSERT(mFileBuffer);
+	mConnected = mFileBuffer->isOpen() && !mWriteFailed;
+	return mConnected;
+}
+
+void PvdAsyncFileTransport::disconnect()
+{
+	flush();
+	mConnected = false;
+}
+
+bool PvdAsyncFileTransport::isConnected()
+{
+	return mConnected && !mWriteFailed;
+}
+
+bool PvdAsyncFileTransport::write(const uint8_t* inBytes, uint32_t inLength)
+{
+	PX_ASSERT(mLocked);
+	if(!mConnected || mWriteFailed)
+		return false;
+
+	Block& block = *mCurrentBlock;
+	if(block.mSize + inLength > block.mCapacity)
+		block.reserve(PxMax(block.mSize + inLength, block.mCapacity * 2));
+	PxMemCopy(block.mData + block.mSize, inBytes, inLength);
+	block.mSize += inLength;
+	return true;
+}
+
+PxPvdTransport& PvdAsyncFileTransport::lock()
+{
+	mMutex.lock();
+	PX_ASSERT(!mLocked);
+	mLocked = true;
+	// the first block is allocated here, once PVD has set up its allocator
+	if(!mCurrentBlock)
+		mCurrentBlock = acquireBlock();
+	mSpanStart = mCurrentBlock->mSize;
+	return *this;
+}
+
+void PvdAsyncFileTransport::unlock()
+{
+	PX_ASSERT(mLocked);
+
+	// The data written since lock() is one event, which can be discarded as a whole. Blocks are only
+	// submitted here so that they always contain whole events.
+	const uint32_t spanSize = mCurrentBlock->mSize - mSpanStart;
+	mStats.bytesReceived += spanSize;
+	if(spanSize && dropSpan(mCurrentBlock->mData + mSpanStart, spanSize))
+	{
+		mCurrentBlock->mSize = mSpanStart;
+		mStats.bytesDropped += spanSize;
+		mStats.eventsDropped++;
+	}
+	else
+	{
+		mBytesAccepted += spanSize;
+		if(mCurrentBlock->mSize >= mDesc.blockSize)
+			submitCurrentBlock();
+	}
+
+	mLocked = false;
+	mMutex.unlock();
+}
+
+void PvdAsyncFileTransport::flush()
+{
+	PxMutex::ScopedLock lock(mMutex);
+	submitCurrentBlock();
+	waitUntilWritten();
+}
+
+uint64_t PvdAsyncFileTransport::getWrittenDataSize()
+{
+	return mBytesAccepted;
+}
+
+void PvdAsyncFileTransport::release()
+{
+	// the writer thread only quits once the queue is empty
+	mMutex.lock();
+	submitCurrentBlock();
+	mMutex.unlock();
+	signalQuit();
+	mWorkReady.set();
+	waitForQuit();
+
+	PVD_DELETE(mCurrentBlock);
+	while(PxSListEntry* entry = mFreeBlocks.pop())
+	{
+		Block* block = static_cast<Block*>(entry);
+		PVD_DELETE(block);
+	}
+	PX_FREE(mHashTable);
+	deallocateBytes(mCompressed);
+
+	if(mFileBuffer)
+	{
+		mFileBuffer->close();
+		PX_DELETE(mFileBuffer);
+	}
+	PX_DELETE_THIS;
+}
+
+void PvdAsyncFileTransport::getStats(PxPvdAsyncFileTransportStats& stats) const
+{
+	PxMutex::ScopedLock lock(mMutex);
+	stats = mStats;
+	stats.bytesWritten += uint32_t(mNbBytesWritten);
+}
+
+PvdAsyncFileTransport::Block* PvdAsyncFileTransport::acquireBlock()
+{
+	PxSListEntry* entry = mFreeBlocks.pop();
+	if(entry)
+		return static_cast<Block*>(entry);
+	// leave room for the event that makes the block reach its nominal size
+	return PVD_NEW(Block)(mDesc.blockSize + mDesc.blockSize / 4);
+}
+
+// The writer thread writes at most twice the memory budget between two submissions, so the 32-bit
+// counter cannot wrap around before it is collected here.
+void PvdAsyncFileTransport::collectBytesWritten()
+{
+	mStats.bytesWritten += uint32_t(PxAtomicExchange(&mNbBytesWritten, 0));
+}
+
+bool PvdAsyncFileTransport::isOverBudget() const
+{
+	return uint32_t(mQueuedBytes) + mCurrentBlock->mSize > mDesc.memoryBudget;
+}
+
+void PvdAsyncFileTransport::submitCurrentBlock()
+{
+	const uint32_t size = mCurrentBlock ? mCurrentBlock->mSize : 0;
+	if(!size)
+		return;
+
+	// When dropping, the events that are kept can still exceed the budget, the producer only waits
+	// past twice the budget.
+	const uint32_t limit = (mDesc.flags & PxPvdAsyncFileTransportFlag::eDROP_WHEN_OVER_BUDGET) ? mDesc.memoryBudget * 2 : mDesc.memoryBudget;
+	if(mQueuedBytes && uint32_t(mQueuedBytes) + size > limit)
+	{
+		mStats.nbThrottles++;
+		for(;;)
+		{
+			mBlockWritten.reset();
+			if(!mQueuedBytes || uint32_t(mQueuedBytes) + size <= limit || mWriteFailed)
+				break;
+			mBlockWritten.wait();
+		}
+	}
+
+	collectBytesWritten();
+	const uint32_t queued = uint32_t(PxAtomicAdd(&mQueuedBytes, int32_t(size)));
+	mStats.maxQueuedBytes = PxMax(mStats.maxQueuedBytes, queued);
+
+	mPendingBlocks.push(*mCurrentBlock);
+	mWorkReady.set();
+	mCurrentBlock = acquireBlock();
+}
+
+void PvdAsyncFileTransport::waitUntilWritten()
+{
+	for(;;)
+	{
+		mBlockWritten.reset();
+		if(!mQueuedBytes)
+			break;
+		mBlockWritten.wait();
+	}
+}
+
+bool PvdAsyncFileTransport::dropSpan(const uint8_t* span, uint32_t size)
+{
+	if(!(mDesc.flags & PxPvdAsyncFileTransportFlag::eDROP_WHEN_OVER_BUDGET))
+		return false;
+
+	// Only spans holding exactly one event group can be recognized, anything else is kept.
+	if(size <= EVENT_GROUP_HEADER_SIZE)
+		return false;
+	uint32_t dataSize;
+	uint64_t streamId;
+	PxMemCopy(&dataSize, span, sizeof(uint32_t));
+	PxMemCopy(&streamId, span + EVENT_GROUP_STREAM_ID_OFFSET, sizeof(uint64_t));
+	if(dataSize != size - EVENT_GROUP_HEADER_SIZE)
+		return false;
+	const PvdCommStreamEventTypes::Enum type = PvdCommStreamEventTypes::Enum(span[EVENT_GROUP_HEADER_SIZE]);
+
+	// Once the start of a multi-event update is dropped, the rest of it goes as well.
+	for(uint32_t i = 0; i < mNbDroppingStreams; i++)
+	{
+		if(mDroppingStreams[i] == streamId)
+		{
+			if(type == PvdCommStreamEventTypes::EndSetPropertyValue || type == PvdCommStreamEventTypes::EndPropertyMessageGroup)
+				mDroppingStreams[i] = mDroppingStreams[--mNbDroppingStreams];
+			return true;
+		}
+	}
+
+	if(!isOverBudget())
+		return false;
+
+	switch(type)
+	{
+	case PvdCommStreamEventTypes::SetPropertyValue:
+	case PvdCommStreamEventTypes::SetPropertyMessage:
+		return true;
+	case PvdCommStreamEventTypes::BeginSetPropertyValue:
+	case PvdCommStreamEventTypes::BeginPropertyMessageGroup:
+		if(mNbDroppingStreams == MAX_DROPPING_STREAMS)
+			return false;
+		mDroppingStreams[mNbDroppingStreams++] = streamId;
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool PvdAsyncFileTransport::writeToFile(const void* data, uint32_t size)
+{
+	if(mFileBuffer->write(data, size) != size)
+	{
+		PxAtomicExchange(&mWriteFailed, 1);
+		return false;
+	}
+	PxAtomicAdd(&mNbBytesWritten, int32_t(size));
+	return true;
+}
+
+void PvdAsyncFileTransport::writeBlock(const Block& block)
+{
+	if(mWriteFailed)
+		return;
+
+	if(!mHashTable)
+	{
+		writeToFile(block.mData, block.mSize);
+		return;
+	}
+
+	const uint32_t rawSize = block.mSize;
+	if(mCompressedCapacity < rawSize)
+	{
+		deallocateBytes(mCompressed);
+		mCompressedCapacity = PxMax(rawSize, block.mCapacity);
+		mCompressed = allocateBytes(mCompressedCapacity, "PvdAsyncFileTransport::mCompressed");
+	}
+	uint32_t storedSize = compressBlock(block.mData, rawSize, mCompressed, rawSize - 1, mHashTable);
+	const uint8_t* stored = mCompressed;
+	if(!storedSize)
+	{
+		storedSize = rawSize;
+		stored = block.mData;
+	}
+
+	const uint32_t header[2] = { rawSize, storedSize };
+	if(writeToFile(header, sizeof(header)))
+		writeToFile(stored, storedSize);
+}
+
+void PvdAsyncFileTransport::execute()
+{
+	setName("PxPvdAsyncFileTransport");
+
+	for(;;)
+	{
+		PxSListEntry* entry = mPendingBlocks.flush();
+		if(!entry)
+		{
+			if(quitIsSignalled())
+				break;
+			mWorkReady.wait();
+			mWorkReady.reset();
+			continue;
+		}
+
+		// the list comes out in reverse submission order
+		Block* blocks = NULL;
+		for(; entry; entry = entry->next())
+		{
+			Block* block = static_cast<Block*>(entry);
+			block->mNextToWrite = blocks;
+			blocks = block;
+		}
+
+		for(Block* block = blocks; block; block = block->mNextToWrite)
+			writeBlock(*block);
+		if(!mWriteFailed)
+			mFileBuffer->flush();
+
+		while(blocks)
+		{
+			Block* block = blocks;
+			blocks = block->mNextToWrite;
+			const int32_t size = int32_t(block->mSize);
+			block->mSize = 0;
+			mFreeBlocks.push(*block);
+			PxAtomicAdd(&mQueuedBytes, -size);
+		}
+		mBlockWritten.set();
+	}
+	quit();
+}
+
+static bool decompressCapture(PsFileBuffer& src, PsFileBuffer& dst)
+{
+	uint32_t header[2];
+	if(src.read(header, sizeof(header)) != sizeof(header))
+		return false;
+	if(header[0] != PVD_COMPRESSED_CAPTURE_MAGIC || header[1] != PVD_COMPRESSED_CAPTURE_VERSION)
+		return false;
+
+	PxArray<uint8_t> stored;
+	PxArray<uint8_t> raw;
+	for(;;)
+	{
+		const uint32_t nbRead = src.read(header, sizeof(header));
+		if(!nbRead)
+			return true;
+		if(nbRead != sizeof(header))
+			return false;
+
+		const uint32_t rawSize = header[0];
+		const uint32_t storedSize = header[1];
+		if(storedSize > rawSize)
+			return false;
+
+		stored.resizeUninitialized(storedSize);
+		if(src.read(stored.begin(), storedSize) != storedSize)
+			return false;
+
+		const uint8_t* data = stored.begin();
+		if(storedSize != rawSize)
+		{
+			raw.resizeUninitialized(rawSize);
+			if(!decompressBlock(stored.begin(), storedSize, raw.begin(), rawSize))
+				return false;
+			data = raw.begin();
+		}
+
+		if(dst.write(data, rawSize) != rawSize)
+			return false;
+	}
+}
+
+} // namespace pvdsdk
+
+PxPvdAsyncFileTransport* PxDefaultPvdAsyncFileTransportCreate(const PxPvdAsyncFileTransportDesc& desc)
+{
+	if(!desc.isValid())
+		return NULL;
+	pvdsdk::PvdAsyncFileTransport* transport = PX_NEW(pvdsdk::PvdAsyncFileTransport)(desc);
+	transport->start();
+	return transport;
+}
+
+bool PxDecompressPvdCapture(const char* srcName, const char* dstName)
+{
+	PsFileBuffer src(srcName, PxFileBuf::OPEN_READ_ONLY);
+	if(!src.isOpen())
+		return false;
+	PsFileBuffer dst(dstName, PxFileBuf::OPEN_WRITE_ONLY);
+	if(!dst.isOpen())
+		return false;
+	return pvdsdk::decompressCapture(src, dst);
+}
+
+} // namespace physx
@@ -0,0 +1,144 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#ifndef PX_PVD_ASYNC_FILE_TRANSPORT_IMPL_H
+#define PX_PVD_ASYNC_FILE_TRANSPORT_IMPL_H
+
+#include "pvd/PxPvdAsyncFileTransport.h"
+
+#include "foundation/PxMutex.h"
+#include "foundation/PxSList.h"
+#include "foundation/PxSync.h"
+#include "foundation/PxThread.h"
+#include "PsFileBuffer.h"
+
+namespace physx
+{
+namespace pvdsdk
+{
+
+// Header of a compressed capture, followed by blocks made of the raw size, the stored size and the stored
+// data. A block whose stored size equals its raw size is not compressed.
+static const uint32_t PVD_COMPRESSED_CAPTURE_MAGIC = 0x5a445850; // "PXDZ"
+static const uint32_t PVD_COMPRESSED_CAPTURE_VERSION = 1;
+
+class PvdAsyncFileTransport : public physx::PxPvdAsyncFileTransport, public physx::PxThread
+{
+	PX_NOCOPY(PvdAsyncFileTransport)
+
+	static const uint32_t MAX_DROPPING_STREAMS = 16;
+
+  public:
+	PvdAsyncFileTransport(const PxPvdAsyncFileTransportDesc& desc);
+	virtual ~PvdAsyncFileTransport();
+
+	// PxPvdTransport
+	virtual bool connect();
+	virtual void disconnect();
+	virtual bool isConnected();
+
+	virtual bool write(const uint8_t* inBytes, uint32_t inLength);
+
+	virtual PxPvdTransport& lock();
+	virtual void unlock();
+
+	virtual void flush();
+
+	virtual uint64_t getWrittenDataSize();
+
+	virtual void release();
+	//~PxPvdTransport
+
+	// PxPvdAsyncFileTransport
+	virtual void getStats(PxPvdAsyncFileTransportStats& stats) const;
+	//~PxPvdAsyncFileTransport
+
+	// PxThread
+	virtual void execute();
+	//~PxThread
+
+  private:
+	// Blocks are allocated with the PVD allocator, allocations reported to PVD would send events from
+	// inside the transport.
+	struct Block : public PxSListEntry
+	{
+		uint8_t* mData;
+		uint32_t mSize;
+		uint32_t mCapacity;
+		Block* mNextToWrite;
+
+		Block(uint32_t capacity);
+		~Block();
+		void reserve(uint32_t capacity);
+	};
+
+	// Producer side, called with the mutex held.
+	Block* acquireBlock();
+	void submitCurrentBlock();
+	void waitUntilWritten();
+	bool dropSpan(const uint8_t* span, uint32_t size);
+	bool isOverBudget() const;
+	void collectBytesWritten();
+
+	// Writer thread side.
+	void writeBlock(const Block& block);
+	bool writeToFile(const void* data, uint32_t size);
+
+	const PxPvdAsyncFileTransportDesc mDesc;
+	physx::PsFileBuffer* mFileBuffer;
+	bool mConnected;
+	mutable physx::PxMutex mMutex;
+	bool mLocked;
+
+	Block* mCurrentBlock;
+	uint32_t mSpanStart;
+	uint64_t mDroppingStreams[MAX_DROPPING_STREAMS];
+	uint32_t mNbDroppingStreams;
+	uint64_t mBytesAccepted;
+
+	PxSList mPendingBlocks;
+	PxSList mFreeBlocks;
+	volatile int32_t mQueuedBytes;
+	PxSync mWorkReady;
+	PxSync mBlockWritten;
+
+	uint32_t* mHashTable;
+	uint8_t* mCompressed;
+	uint32_t mCompressedCapacity;
+	// Written by the writer thread and read by the producer: mWriteFailed is set atomically, and the
+	// bytes written are counted in mNbBytesWritten until the producer adds them to mStats.
+	volatile int32_t mWriteFailed;
+	volatile int32_t mNbBytesWritten;
+
+	PxPvdAsyncFileTransportStats mStats;
+};
+
+} // pvdsdk
+} // physx
+
+#endif
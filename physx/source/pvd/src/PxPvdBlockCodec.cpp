@@ -0,0 +1,221 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#include "PxPvdBlockCodec.h"
+#include "foundation/PxMemory.h"
+
+namespace physx
+{
+namespace pvdsdk
+{
+
+namespace
+{
+const uint32_t MIN_MATCH = 4;
+const uint32_t LAST_LITERALS = 5; // the block always ends with literals
+const uint32_t MATCH_FIND_LIMIT = 12; // no match starts in the last bytes
+const uint32_t MAX_OFFSET = 65535;
+const uint32_t SKIP_TRIGGER = 6; // speeds up the search in incompressible data
+
+PX_FORCE_INLINE uint32_t read32(const uint8_t* p)
+{
+	uint32_t v;
+	PxMemCopy(&v, p, sizeof(uint32_t));
+	return v;
+}
+
+PX_FORCE_INLINE uint32_t hash(uint32_t v)
+{
+	return (v * 2654435761u) >> (32 - PVD_BLOCK_CODEC_HASH_BITS);
+}
+
+PX_FORCE_INLINE uint8_t* writeLength(uint8_t* op, uint32_t len)
+{
+	while(len >= 255)
+	{
+		*op++ = 255;
+		len -= 255;
+	}
+	*op++ = uint8_t(len);
+	return op;
+}
+
+// Writes one sequence, returns NULL if it does not fit.
+uint8_t* writeSequence(uint8_t* op, const uint8_t* oend, const uint8_t* literals, uint32_t litLen, uint32_t offset, uint32_t matchLen, bool hasMatch)
+{
+	const size_t worstCase = 1 + (litLen / 255 + 1) + litLen + (hasMatch ? 2 + matchLen / 255 + 1 : 0);
+	if(size_t(oend - op) < worstCase)
+		return NULL;
+
+	uint8_t* token = op++;
+	*token = uint8_t((litLen < 15 ? litLen : 15) << 4);
+	if(litLen >= 15)
+		op = writeLength(op, litLen - 15);
+	PxMemCopy(op, literals, litLen);
+	op += litLen;
+
+	if(hasMatch)
+	{
+		*op++ = uint8_t(offset);
+		*op++ = uint8_t(offset >> 8);
+		*token |= uint8_t(matchLen < 15 ? matchLen : 15);
+		if(matchLen >= 15)
+			op = writeLength(op, matchLen - 15);
+	}
+	return op;
+}
+
+// Reads a 255-byte extended length, returns false if the input ends first.
+PX_FORCE_INLINE bool readLength(const uint8_t*& ip, const uint8_t* iend, uint32_t& len)
+{
+	uint8_t b;
+	do
+	{
+		if(ip >= iend)
+			return false;
+		b = *ip++;
+		len += b;
+	} while(b == 255);
+	return true;
+}
+}
+
+uint32_t compressBlock(const uint8_t* src, uint32_t srcSize, uint8_t* dst, uint32_t dstCapacity, uint32_t* hashTable)
+{
+	uint8_t* op = dst;
+	const uint8_t* oend = dst + dstCapacity;
+	const uint8_t* anchor = src;
+
+	if(srcSize > MATCH_FIND_LIMIT)
+	{
+		PxMemZero(hashTable, PVD_BLOCK_CODEC_HASH_SIZE * sizeof(uint32_t));
+
+		const uint8_t* ip = src + 1;
+		const uint8_t* matchLimit = src + srcSize - LAST_LITERALS;
+		const uint8_t* findLimit = src + srcSize - MATCH_FIND_LIMIT;
+		uint32_t searchCount = 1 << SKIP_TRIGGER;
+
+		while(ip <= findLimit)
+		{
+			const uint32_t seq = read32(ip);
+			const uint32_t h = hash(seq);
+			const uint8_t* ref = src + hashTable[h];
+			hashTable[h] = uint32_t(ip - src);
+
+			// the table is not cleared between matches, so the entry can point anywhere before ip
+			if(ref >= ip || uint32_t(ip - ref) > MAX_OFFSET || read32(ref) != seq)
+			{
+				ip += searchCount++ >> SKIP_TRIGGER;
+				continue;
+			}
+			searchCount = 1 << SKIP_TRIGGER;
+
+			while(ip > anchor && ref > src && ip[-1] == ref[-1])
+			{
+				ip--;
+				ref--;
+			}
+
+			const uint8_t* matchEnd = ip + MIN_MATCH;
+			const uint8_t* r = ref + MIN_MATCH;
+			while(matchEnd < matchLimit && *matchEnd == *r)
+			{
+				matchEnd++;
+				r++;
+			}
+
+			op = writeSequence(op, oend, anchor, uint32_t(ip - anchor), uint32_t(ip - ref), uint32_t(matchEnd - ip) - MIN_MATCH, true);
+			if(!op)
+				return 0;
+
+			ip = matchEnd;
+			anchor = ip;
+			if(ip <= findLimit)
+				hashTable[hash(read32(ip - 2))] = uint32_t(ip - 2 - src);
+		}
+	}
+
+	op = writeSequence(op, oend, anchor, uint32_t(src + srcSize - anchor), 0, 0, false);
+	return op ? uint32_t(op - dst) : 0;
+}
+
+bool decompressBlock(const uint8_t* src, uint32_t srcSize, uint8_t* dst, uint32_t dstSize)
+{
+	const uint8_t* ip = src;
+	const uint8_t* iend = src + srcSize;
+	uint8_t* op = dst;
+	uint8_t* oend = dst + dstSize;
+
+	while(ip < iend)
+	{
+		const uint8_t token = *ip++;
+
+		uint32_t litLen = uint32_t(token >> 4);
+		if(litLen == 15 && !readLength(ip, iend, litLen))
+			return false;
+		if(litLen > size_t(iend - ip) || litLen > size_t(oend - op))
+			return false;
+		PxMemCopy(op, ip, litLen);
+		ip += litLen;
+		op += litLen;
+
+		// the last sequence has no match
+		if(ip == iend)
+			break;
+
+		if(iend - ip < 2)
+			return false;
+		const uint32_t offset = uint32_t(ip[0]) | (uint32_t(ip[1]) << 8);
+		ip += 2;
+
+		uint32_t matchLen = uint32_t(token & 15);
+		if(matchLen == 15 && !readLength(ip, iend, matchLen))
+			return false;
+		matchLen += MIN_MATCH;
+
+		if(offset == 0 || offset > size_t(op - dst) || matchLen > size_t(oend - op))
+			return false;
+
+		// the match can overlap the bytes it produces
+		const uint8_t* ref = op - offset;
+		if(offset >= matchLen)
+		{
+			PxMemCopy(op, ref, matchLen);
+			op += matchLen;
+		}
+		else
+		{
+			for(uint32_t i = 0; i < matchLen; i++)
+				*op++ = *ref++;
+		}
+	}
+	return op == oend;
+}
+
+} // pvdsdk
+} // physx
@@ -0,0 +1,57 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2022 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#ifndef PX_PVD_BLOCK_CODEC_H
+#define PX_PVD_BLOCK_CODEC_H
+
+#include "foundation/PxSimpleTypes.h"
+
+namespace physx
+{
+namespace pvdsdk
+{
+
+// Fast LZ77 block codec used by the asynchronous file transport. A compressed block is a sequence of
+// (literal length, literals, match offset, match length) sequences in the LZ4 block layout: a token holding
+// the literal length and the match length minus 4 in its two nibbles, 255-byte extensions of either length
+// when its nibble is 15, and a 16 bit little-endian offset. The last sequence has no match.
+
+static const uint32_t PVD_BLOCK_CODEC_HASH_BITS = 12;
+static const uint32_t PVD_BLOCK_CODEC_HASH_SIZE = 1 << PVD_BLOCK_CODEC_HASH_BITS;
+
+// Compresses srcSize bytes into dst, which can hold dstCapacity bytes. hashTable is scratch memory of
+// PVD_BLOCK_CODEC_HASH_SIZE entries. Returns the compressed size, or 0 if the result does not fit in dst.
+uint32_t compressBlock(const uint8_t* src, uint32_t srcSize, uint8_t* dst, uint32_t dstCapacity, uint32_t* hashTable);
+
+// Decompresses a block into exactly dstSize bytes. Returns false if the block is corrupted.
+bool decompressBlock(const uint8_t* src, uint32_t srcSize, uint8_t* dst, uint32_t dstSize);
+
+} // pvdsdk
+} // physx
+
+#endif
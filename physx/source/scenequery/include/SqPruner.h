@@ -149,6 +149,7 @@ class CompoundPruner : public Gu::BasePruner
 	 */
 	virtual	bool					raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, CompoundPrunerRaycastCallback&, PxCompoundPrunerQueryFlags flags) const = 0;
 	virtual	bool					overlap(const Gu::ShapeData& queryVolume, CompoundPrunerOverlapCallback&, PxCompoundPrunerQueryFlags flags) const = 0;
+	virtual	bool					cull(PxU32 nbPlanes, const PxPlane* planes, CompoundPrunerOverlapCallback&, PxCompoundPrunerQueryFlags flags) const = 0;
 	virtual	bool					sweep(const Gu::ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, CompoundPrunerRaycastCallback&, PxCompoundPrunerQueryFlags flags) const = 0;
 
 	/**
@@ -43,6 +43,7 @@
 namespace physx
 {
 class PxGeometry;
+class PxPlane;
 struct PxQueryFilterData;
 struct PxFilterData;
 class PxQueryFilterCallback;
@@ -118,6 +119,12 @@ namespace Sq
 														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
 														const PxQueryCache* cache, PxGeometryQueryFlags flags) const;
 
+						bool						_cull(
+														PxU32 nbPlanes, const PxPlane* planes,	// Culling volume
+														PxOverlapCallback& hitCall,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														PxGeometryQueryFlags flags) const;
+
 		PX_FORCE_INLINE	PxU64						getContextId()			const	{ return mSQManager.getContextId();	}
 						Sq::PrunerManager			mSQManager;
 		public:
@@ -46,10 +46,6 @@ using namespace physx;
 using namespace Gu;
 using namespace Sq;
 
-// PT: TODO: this is copied from SqBounds.h, should be either moved to Gu and shared or passed as a user parameter
-	#define SQ_PRUNER_EPSILON	0.005f
-	#define SQ_PRUNER_INFLATION	(1.0f + SQ_PRUNER_EPSILON)	// pruner test shape inflation (not narrow phase shape)
-
 #define PARANOIA_CHECKS 0
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -545,6 +541,58 @@ bool BVHCompoundPruner::overlap(const ShapeData& queryVolume, CompoundPrunerOver
 	return again;
 }
 
+//////////////////////////////////////////////////////////////////////////
+// cull main tree callback
+struct MainTreeCullCompoundPrunerCallback : MainTreeCompoundPrunerCallback<CompoundPrunerOverlapCallback>
+{
+	MainTreeCullCompoundPrunerCallback(PxU32 nbPlanes, const PxPlane* planes, CompoundPrunerOverlapCallback& prunerCallback, PxCompoundPrunerQueryFlags flags, const CompoundTree* compoundTrees)
+		: MainTreeCompoundPrunerCallback(prunerCallback, flags, compoundTrees), mNbPlanes(nbPlanes), mPlanes(planes)
+	{
+	}
+
+	virtual ~MainTreeCullCompoundPrunerCallback() {}
+
+	bool invoke(PxU32 primIndex)
+	{
+		const CompoundTree& compoundTree = mCompoundTrees[primIndex];
+
+		if(filtering(compoundTree))
+			return true;
+
+		// transfer planes to actor local space
+		PxPlane localPlanes[GU_MAX_NB_CULLING_PLANES];
+		for(PxU32 i=0;i<mNbPlanes;i++)
+			localPlanes[i] = mPlanes[i].inverseTransform(compoundTree.mGlobalPose);
+
+		const PlanesAABBTest localTest(mNbPlanes, localPlanes);
+		// cull the compound local tree
+		CompoundCallbackOverlapAdapter pcb(mPrunerCallback, compoundTree);
+		return AABBTreeCull<true, IncrementalAABBTree, IncrementalAABBTreeNode, CompoundCallbackOverlapAdapter>()
+			(compoundTree.mPruningPool->getCurrentAABBTreeBounds(), *compoundTree.mTree, localTest, pcb);
+	}
+
+	PX_NOCOPY(MainTreeCullCompoundPrunerCallback)
+
+private:
+	const PxU32		mNbPlanes;
+	const PxPlane*	mPlanes;
+};
+
+//////////////////////////////////////////////////////////////////////////
+// cull implementation
+bool BVHCompoundPruner::cull(PxU32 nbPlanes, const PxPlane* planes, CompoundPrunerOverlapCallback& prunerCallback, PxCompoundPrunerQueryFlags flags) const
+{
+	if(!mMainTree.getNodes())
+		return true;
+
+	if(nbPlanes>GU_MAX_NB_CULLING_PLANES)
+		nbPlanes = GU_MAX_NB_CULLING_PLANES;
+
+	const PlanesAABBTest test(nbPlanes, planes);
+	MainTreeCullCompoundPrunerCallback pcb(nbPlanes, planes, prunerCallback, flags, mCompoundTreePool.getCompoundTrees());
+	return AABBTreeOverlap<true, PlanesAABBTest, IncrementalAABBTree, IncrementalAABBTreeNode, MainTreeCullCompoundPrunerCallback>()(mCompoundTreePool.getCurrentAABBTreeBounds(), mMainTree, test, pcb);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
 bool BVHCompoundPruner::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, CompoundPrunerRaycastCallback& prunerCallback, PxCompoundPrunerQueryFlags flags) const
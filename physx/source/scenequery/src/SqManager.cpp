@@ -505,6 +505,9 @@ void PrunerManager::shiftOrigin(const PxVec3& shift)
 		mPrunerExt[i].pruner()->shiftOrigin(shift);
 
 	mCompoundPrunerExt.pruner()->shiftOrigin(shift);
+
+	// PT: static objects moved, so data captured by users for static objects (e.g. query candidate caches) is now invalid
+	invalidateStaticTimestamp();
 }
 
 void PrunerManager::addCompoundShape(const PxBVH& pxbvh, PrunerCompoundId compoundId, const PxTransform& compoundTransform, PrunerData* prunerData, const PrunerPayload* payloads, const PxTransform* transforms, bool isDynamic)
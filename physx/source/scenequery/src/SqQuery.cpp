@@ -764,6 +764,91 @@ static PX_FORCE_INLINE PxCompoundPrunerQueryFlags convertFlags(PxQueryFlags	inFl
 	return outFlags;
 }
 
+namespace
+{
+	// PT: captures the static candidates for a query candidate cache
+	struct CandidateCaptureCallback : public PrunerOverlapCallback
+	{
+		CandidateCaptureCallback(PxQueryCandidateCache& cache) : mCache(cache), mNbCandidates(0), mOverflow(false)	{}
+
+		virtual bool	invoke(PxU32 primIndex, const PrunerPayload* payloads, const PxTransform* transforms)
+		{
+			if(mNbCandidates==mCache.maxNbCandidates)
+			{
+				mOverflow = true;
+				return false;
+			}
+
+			PxQueryCandidate& candidate = mCache.candidates[mNbCandidates++];
+			candidate.payload[0] = payloads[primIndex].data[0];
+			candidate.payload[1] = payloads[primIndex].data[1];
+			candidate.pose = transforms[primIndex];
+			return true;
+		}
+
+		PxQueryCandidateCache&	mCache;
+		PxU32					mNbCandidates;
+		bool					mOverflow;
+
+		PX_NOCOPY(CandidateCaptureCallback)
+	};
+}
+
+PX_COMPILE_TIME_ASSERT(sizeof(PrunerPayload)==sizeof(PxQueryCandidate::payload));
+
+// PT: returns true if the cached candidates can replace the static pruner traversal for a query whose pruner-level
+// bounds are 'queryBounds'. New candidates are captured when the query volume left the cached volume, or when the
+// static structure changed since the last capture.
+static bool useCandidateCache(PxQueryCandidateCache& cache, const void* owner, const PrunerManager& manager, const PxBounds3& queryBounds)
+{
+	const PxU32 timestamp = manager.getStaticTimestamp();
+	if(cache.owner==owner && cache.timestamp==timestamp && queryBounds.isInside(cache.cachedBounds))
+	{
+		// PT: if the last capture overflowed the buffer we don't retry for the same volume, it would overflow again
+		if(cache.nbCandidates==0xffffffff)
+		{
+			cache.nbMisses++;
+			return false;
+		}
+		cache.nbHits++;
+		return true;
+	}
+
+	cache.nbMisses++;
+	if(!cache.candidates || !cache.maxNbCandidates)
+		return false;
+
+	const PxBounds3 cachedBounds(queryBounds.minimum - PxVec3(cache.tolerance), queryBounds.maximum + PxVec3(cache.tolerance));
+
+	const PxBoxGeometry boxGeom(cachedBounds.getExtents());
+	const ShapeData sd(boxGeom, PxTransform(cachedBounds.getCenter()), 0.0f);
+	CandidateCaptureCallback cb(cache);
+	manager.getPruner(PruningIndex::eSTATIC)->overlap(sd, cb);
+
+	cache.cachedBounds	= cachedBounds;
+	cache.owner			= owner;
+	cache.timestamp		= timestamp;
+	cache.nbCandidates	= cb.mOverflow ? 0xffffffff : cb.mNbCandidates;
+	return !cb.mOverflow;
+}
+
+// PT: runs the narrow-phase tests against the cached candidates, in place of the static pruner traversal
+template<typename HitType>
+static bool doQueryVsCandidates(const PxQueryCandidateCache& cache, MultiQueryCallback<HitType>& pcb)
+{
+	const PxU32 nbCandidates = cache.nbCandidates;
+	for(PxU32 i=0;i<nbCandidates;i++)
+	{
+		const PxQueryCandidate& candidate = cache.candidates[i];
+		const PrunerPayload* payload = reinterpret_cast<const PrunerPayload*>(candidate.payload);
+
+		const bool again = HitTypeSupport<HitType>::IsOverlap ? pcb.invoke(0, payload, &candidate.pose) : pcb.invoke(pcb.mShrunkDistance, 0, payload, &candidate.pose);
+		if(!again)
+			return false;
+	}
+	return true;
+}
+
 // PT: TODO: revisit error messages without breaking UTs
 template<typename HitType>
 bool SceneQueries::multiQuery(
@@ -805,7 +890,7 @@ bool SceneQueries::multiQuery(
 			"NpSceneQueries multiQuery input check: zero-length sweep only valid without the PxHitFlag::eASSUME_NO_INITIAL_OVERLAP flag", 0);
 	}
 
-	PX_CHECK_MSG(!cache || (cache && cache->shape && cache->actor), "Raycast cache specified but shape or actor pointer is NULL!");
+	PX_CHECK_MSG(!cache || cache->candidates || (cache->shape && cache->actor), "Raycast cache specified but shape or actor pointer is NULL!");
 	PrunerCompoundId cachedCompoundId = INVALID_COMPOUND_ID;
 	// PT: this is similar to the code in the SqRefFinder so we could share that code maybe. But here we later retrieve the payload from the PrunerData,
 	// i.e. we basically go back to the same pointers we started from. I suppose it's to make sure they get properly invalidated when an object is deleted etc,
@@ -813,7 +898,8 @@ bool SceneQueries::multiQuery(
 	//
 	// how can this work anyway? if the actor has been deleted the lookup won't work either => doc says it's up to users to manage that....
 	PxU32 prunerIndex = 0xffffffff;
-	const PrunerHandle cacheData = cache ? static_cast<const QueryAdapter&>(mSQManager.getAdapter()).findPrunerHandle(*cache, cachedCompoundId, prunerIndex) : INVALID_PRUNERHANDLE;
+	const PrunerHandle cacheData = (cache && cache->shape && cache->actor) ? static_cast<const QueryAdapter&>(mSQManager.getAdapter()).findPrunerHandle(*cache, cachedCompoundId, prunerIndex) : INVALID_PRUNERHANDLE;
+	PxQueryCandidateCache* candidateCache = (cache && HitTypeSupport<HitType>::IsRaycast == 0) ? cache->candidates : NULL;
 
 	// this function is logically const for the SDK user, as flushUpdates() will not have an API-visible effect on this object
 	// internally however, flushUpdates() changes the states of the Pruners in mSQManager
@@ -870,7 +956,14 @@ bool SceneQueries::multiQuery(
 
 		const ShapeData sd(*input.geometry, *input.pose, input.inflation);
 		pcb.mShapeData = &sd;
-		bool again = doStatics ? staticPruner->overlap(sd, pcb) : true;
+		bool again = true;
+		if(doStatics)
+		{
+			if(candidateCache && useCandidateCache(*candidateCache, this, mSQManager, sd.getPrunerInflatedWorldAABB()))
+				again = doQueryVsCandidates(*candidateCache, pcb);
+			else
+				again = staticPruner->overlap(sd, pcb);
+		}
 		if(!again) // && (filterData.flags & PxQueryFlag::eANY_HIT))
 			return hits.hasAnyHits();
 		
@@ -891,7 +984,24 @@ bool SceneQueries::multiQuery(
 		const ShapeData sd(*input.geometry, *input.pose, input.inflation);
 		pcb.mQueryShapeBounds = &sd.getPrunerInflatedWorldAABB();
 		pcb.mShapeData = &sd;
-		bool again = doStatics ? staticPruner->sweep(sd, input.getDir(), pcb.mShrunkDistance, pcb) : true;
+		bool again = true;
+		if(doStatics)
+		{
+			bool useCandidates = false;
+			if(candidateCache)
+			{
+				const PxBounds3& startBounds = sd.getPrunerInflatedWorldAABB();
+				const PxVec3 motion = input.getDir() * pcb.mShrunkDistance;
+				PxBounds3 sweptBounds = startBounds;
+				sweptBounds.include(PxBounds3(startBounds.minimum + motion, startBounds.maximum + motion));
+				useCandidates = useCandidateCache(*candidateCache, this, mSQManager, sweptBounds);
+			}
+
+			if(useCandidates)
+				again = doQueryVsCandidates(*candidateCache, pcb);
+			else
+				again = staticPruner->sweep(sd, input.getDir(), pcb.mShrunkDistance, pcb);
+		}
 		if(!again)
 			return hits.hasAnyHits();
 		
@@ -941,6 +1051,141 @@ bool SceneQueries::_overlap(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+	// PT: culling queries don't run narrow-phase tests. Objects whose bounds are not culled by the planes are reported
+	// as touches (or as the blocking hit without a touch buffer), after the regular pre- and post-filtering.
+	struct CullQueryCallback : public PrunerOverlapCallback, public CompoundPrunerOverlapCallback
+	{
+		CullQueryCallback(const QueryAdapter& adapter, PxOverlapCallback& hitCall, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall) :
+			mAdapter	(adapter),
+			mHitCall	(hitCall),
+			mFilterData	(filterData),
+			mFilterCall	(filterCall),
+			mAnyHit		((filterData.flags & PxQueryFlag::eANY_HIT) == PxQueryFlag::eANY_HIT),
+			mNoBlock	(filterData.flags & PxQueryFlag::eNO_BLOCK),
+			mAborted	(false)
+		{
+		}
+
+		bool	_invoke(const PrunerPayload& payload)
+		{
+			PxActorShape actorShape;
+			mAdapter.getActorShape(payload, actorShape);
+
+			PxQueryHitType::Enum hitType = mHitCall.maxNbTouches ? PxQueryHitType::eTOUCH : PxQueryHitType::eBLOCK;
+
+			PxHitFlags unusedHitFlags;
+			if(!applyAllPreFiltersSQ(mAdapter, payload, actorShape, hitType, mFilterData.flags, mFilterData, mFilterCall, unusedHitFlags))
+				return true;
+
+			PxOverlapHit hit;
+			hit.actor = actorShape.actor;
+			hit.shape = actorShape.shape;
+			hit.faceIndex = 0xffffffff;
+
+			if(mFilterCall && (mFilterData.flags & PxQueryFlag::ePOSTFILTER))
+				hitType = mFilterCall->postFilter(mFilterData.data, hit, hit.shape, hit.actor);
+
+			if(hitType == PxQueryHitType::eNONE)
+				return true;
+
+			if(mAnyHit)
+			{
+				mHitCall.block = hit;
+				mHitCall.hasBlock = true;
+				return false;
+			}
+
+			if(mNoBlock)
+				hitType = PxQueryHitType::eTOUCH;
+
+			if(hitType == PxQueryHitType::eBLOCK)
+			{
+				mHitCall.block = hit;
+				mHitCall.hasBlock = true;
+				return true;
+			}
+
+			if(!mHitCall.maxNbTouches)
+				return true;
+
+			if(mHitCall.nbTouches == mHitCall.maxNbTouches)
+			{
+				if(!mHitCall.processTouches(mHitCall.touches, mHitCall.nbTouches))
+				{
+					mAborted = true;
+					return false;
+				}
+				mHitCall.nbTouches = 0;
+			}
+			mHitCall.touches[mHitCall.nbTouches++] = hit;
+			return true;
+		}
+
+		virtual bool	invoke(PxU32 primIndex, const PrunerPayload* payloads, const PxTransform*)
+		{
+			return _invoke(payloads[primIndex]);
+		}
+
+		virtual bool	invoke(PxU32 primIndex, const PrunerPayload* payloads, const PxTransform*, const PxTransform*)
+		{
+			return _invoke(payloads[primIndex]);
+		}
+
+		const QueryAdapter&			mAdapter;
+		PxOverlapCallback&			mHitCall;
+		const PxQueryFilterData&	mFilterData;
+		PxQueryFilterCallback*		mFilterCall;
+		const bool					mAnyHit;
+		const bool					mNoBlock;
+		bool						mAborted;
+
+		PX_NOCOPY(CullQueryCallback)
+	};
+}
+
+bool SceneQueries::_cull(
+	PxU32 nbPlanes, const PxPlane* planes, PxOverlapCallback& hits,
+	const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall, PxGeometryQueryFlags flags) const
+{
+	PX_PROFILE_ZONE("SceneQuery.cull", getContextId());
+	PX_SIMD_GUARD_CNDT(flags & PxGeometryQueryFlag::eSIMD_GUARD)
+
+	PX_CHECK_AND_RETURN_VAL(planes || !nbPlanes, "PxSceneQuerySystem::cull(): planes pointer is NULL.", false);
+	PX_CHECK_AND_RETURN_VAL(nbPlanes <= 32, "PxSceneQuerySystem::cull(): only 32 planes max are supported.", false);
+	PX_CHECK_AND_RETURN_VAL(hits.maxNbTouches > 0 || (filterData.flags & PxQueryFlag::eANY_HIT), "PxSceneQuerySystem::cull() calls without eANY_HIT flag require a touch hit buffer for return results.", false);
+
+	// see multiQuery() for the const_cast
+	const_cast<SceneQueries*>(this)->mSQManager.flushUpdates();
+
+	IssueCallbacksOnReturn<PxOverlapHit> cbr(hits); // destructor will execute callbacks on return from this function
+	hits.hasBlock = false;
+	hits.nbTouches = 0;
+
+	CullQueryCallback pcb(static_cast<const QueryAdapter&>(mSQManager.getAdapter()), hits, filterData, filterCall);
+
+	const Pruner* staticPruner = mSQManager.getPruner(PruningIndex::eSTATIC);
+	const Pruner* dynamicPruner = mSQManager.getPruner(PruningIndex::eDYNAMIC);
+	const CompoundPruner* compoundPruner = mSQManager.getCompoundPruner();
+
+	bool again = true;
+	if(staticPruner && (filterData.flags & PxQueryFlag::eSTATIC))
+		again = staticPruner->cull(nbPlanes, planes, pcb);
+
+	if(again && dynamicPruner && (filterData.flags & PxQueryFlag::eDYNAMIC))
+		again = dynamicPruner->cull(nbPlanes, planes, pcb);
+
+	if(again && compoundPruner)
+		again = compoundPruner->cull(nbPlanes, planes, pcb, convertFlags(filterData.flags));
+
+	// PT: only skip the final processTouches() call if the user callback stopped the query
+	cbr.again = !pcb.mAborted;
+	return hits.hasAnyHits();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 bool SceneQueries::_sweep(
 	const PxGeometry& geometry, const PxTransform& pose, const PxVec3& unitDir, const PxReal distance,
 	PxHitCallback<PxSweepHit>& hits, PxHitFlags hitFlags, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
@@ -101,7 +101,7 @@ public:
 
 	PX_FORCE_INLINE ScratchAllocatorList(PxcScratchAllocator& scratchAllocator) : mScratchAllocator(scratchAllocator)
 	{
-		mFirstBlock = reinterpret_cast<ElementBlock*>(scratchAllocator.alloc(sizeof(ElementBlock), true));
+		mFirstBlock = reinterpret_cast<ElementBlock*>(scratchAllocator.alloc(sizeof(ElementBlock), true, PxSimulationStatistics::eSCRATCH_CONSTRAINT_PROJECTION));
 		if (mFirstBlock)
 			mFirstBlock->init(0);
 
@@ -128,7 +128,7 @@ public:
 				PX_ASSERT(mCurrentBlock->next == NULL);
 				PX_ASSERT(mCurrentBlock->count == elementsPerBlock);
 
-				ElementBlock* newBlock = reinterpret_cast<ElementBlock*>(mScratchAllocator.alloc(sizeof(ElementBlock), true));
+				ElementBlock* newBlock = reinterpret_cast<ElementBlock*>(mScratchAllocator.alloc(sizeof(ElementBlock), true, PxSimulationStatistics::eSCRATCH_CONSTRAINT_PROJECTION));
 				if (newBlock)
 				{
 					newBlock->init(1);
@@ -1446,6 +1446,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mScene.getLowLevelContext()->getSimStats(), eISLAND_GEN);
 		SimStats::TriggerPairCountsNonVolatile triggerPairStats;
 #if PX_ENABLE_SIM_STATS
 		PxMemZero(&triggerPairStats, sizeof(SimStats::TriggerPairCountsNonVolatile));
@@ -1569,7 +1570,7 @@ void NPhaseCore::processTriggerInteractions(PxBaseTask* continuation)
 		const PxU32 maxTaskCount = taskCountWithoutRemainder + 1;
 		const PxU32 pairPtrSize = pairCount * sizeof(TriggerInteraction*);
 		const PxU32 memBlockSize = pairPtrSize + (maxTaskCount * sizeof(TriggerContactTask));
-		void* triggerProcessingBlock = scene.getLowLevelContext()->getScratchAllocator().alloc(memBlockSize, true);
+		void* triggerProcessingBlock = scene.getLowLevelContext()->getScratchAllocator().alloc(memBlockSize, true, PxSimulationStatistics::eSCRATCH_NARROW_PHASE);
 		if(triggerProcessingBlock)
 		{
 			const bool hasMultipleThreads = scene.getTaskManager().getCpuDispatcher()->getWorkerCount() > 1;
@@ -1679,6 +1680,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mCore.getScene().getLowLevelContext()->getSimStats(), eISLAND_GEN);
 		PX_PROFILE_ZONE("ProcessPersistentContactTask", mCore.getScene().getContextId());
 		PxU32 size = mNbPersistentEventPairs;
 		ShapeInteraction*const* persistentEventPairs = mPersistentEventPairs;
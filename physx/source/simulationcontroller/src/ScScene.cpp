@@ -111,6 +111,9 @@ using namespace physx::Dy;
 
 PX_IMPLEMENT_OUTPUT_ERROR
 
+// Records the time spent in a task body into the timings of PxSimulationStatistics
+#define SC_SIM_PHASE_ZONE(phase)	PXV_SIM_PHASE_ZONE(&mLLContext->getSimStats(), phase)
+
 namespace physx { 
 namespace Sc {
 
@@ -180,6 +183,7 @@ public:
 
 	virtual void runInternal()
 	{		
+		PXV_SIM_PHASE_ZONE(&mContext->getSimStats(), eINTEGRATION);
 		const PxU32 rigidBodyOffset = Sc::BodySim::getRigidBodyOffset();
 
 		Sc::BodySim* bpUpdates[MaxTasks];
@@ -782,7 +786,7 @@ Sc::Scene::Scene(const PxSceneDesc& desc, PxU64 contextID) :
 	mBpSecondPass					(contextID, this, "ScScene.broadPhaseSecondPass"),
 	mBpUpdate						(contextID, this, "ScScene.updateBroadPhase"),
 	mPreIntegrate                   (contextID, this, "ScScene.preIntegrate"),
-	mTaskPool						(16384),
+	mTaskPool						(desc.taskPoolChunkSize, desc.taskPoolSize),
 	mTaskManager					(NULL),
 	mCudaContextManager				(desc.cudaContextManager),
 	mContactReportsNeedPostSolverVelocity(false),
@@ -904,6 +908,8 @@ Sc::Scene::Scene(const PxSceneDesc& desc, PxU64 contextID) :
 			desc.limits.maxNbStaticShapes, 
 			desc.limits.maxNbDynamicShapes,
 			contextID);
+
+		broadPhase->setSimStats(&mLLContext->getSimStats());
 	}
 #if PX_SUPPORT_GPU_PHYSX
 	else
@@ -2914,6 +2920,7 @@ void Sc::Scene::deallocateConstraintBlock(void* ptr, PxU32 size)
 
 void Sc::Scene::advanceStep(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eSOLVER_SETUP);
 	PX_PROFILE_ZONE("Sim.solveQueueTasks", getContextId());
 
 	if (mDt != 0.0f)
@@ -2960,6 +2967,7 @@ void Sc::Scene::advanceStep(PxBaseTask* continuation)
 
 void Sc::Scene::collideStep(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eBROAD_PHASE);
 	PX_PROFILE_ZONE("Sim.collideQueueTasks", getContextId());
 	PX_PROFILE_START_CROSSTHREAD("Basic.collision", getContextId());
 
@@ -2985,6 +2993,7 @@ void Sc::Scene::collideStep(PxBaseTask* continuation)
 
 void Sc::Scene::broadPhase(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eBROAD_PHASE);
 	PX_PROFILE_START_CROSSTHREAD("Basic.broadPhase", getContextId());
 
 	mProcessLostPatchesTask.setContinuation(&mPostNarrowPhase);
@@ -3073,6 +3082,7 @@ void Sc::Scene::broadPhase(PxBaseTask* continuation)
 
 void Sc::Scene::broadPhaseFirstPass(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eBROAD_PHASE);
 	PX_PROFILE_ZONE("Basic.broadPhaseFirstPass", getContextId());
 
 	const PxU32 numCpuTasks = continuation->getTaskManager()->getCpuDispatcher()->getWorkerCount();
@@ -3085,6 +3095,7 @@ void Sc::Scene::broadPhaseFirstPass(PxBaseTask* continuation)
 
 void Sc::Scene::broadPhaseSecondPass(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eBROAD_PHASE);
 	PX_PROFILE_ZONE("Basic.broadPhaseSecondPass", getContextId());
 
 	mBpUpdate.setContinuation(continuation);
@@ -3096,12 +3107,14 @@ void Sc::Scene::broadPhaseSecondPass(PxBaseTask* continuation)
 
 void Sc::Scene::preIntegrate(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eBROAD_PHASE);
 	if (!mCCDBp && isUsingGpuDynamicsOrBp())
 		mSimulationController->preIntegrateAndUpdateBound(continuation, mGravity, mDt);
 }
 
 void Sc::Scene::updateBroadPhase(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eBROAD_PHASE);
 	PxBaseTask* rigidBodyNPhaseUnlock = mCCDPass ? NULL : &mRigidBodyNPhaseUnlock;
 
 	const PxU32 numCpuTasks = continuation->getTaskManager()->getCpuDispatcher()->getWorkerCount();
@@ -3119,6 +3132,7 @@ void Sc::Scene::updateBroadPhase(PxBaseTask* continuation)
 
 void Sc::Scene::postBroadPhase(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eBROAD_PHASE);
 	PX_PROFILE_START_CROSSTHREAD("Basic.postBroadPhase", getContextId());
 
 	//Notify narrow phase that broad phase has completed
@@ -3128,6 +3142,7 @@ void Sc::Scene::postBroadPhase(PxBaseTask* continuation)
 
 void Sc::Scene::postBroadPhaseContinuation(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eBROAD_PHASE);
 	mAABBManager->getChangedAABBMgActorHandleMap().clear();
 
 	// - Finishes broadphase update
@@ -3137,6 +3152,7 @@ void Sc::Scene::postBroadPhaseContinuation(PxBaseTask* continuation)
 
 void Sc::Scene::postBroadPhaseStage2(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eBROAD_PHASE);
 	// - Wakes actors that lost touch if appropriate
 	processLostTouchPairs();
 	//Release unused Cms back to the pool (later, this needs to be done in a thread-safe way from multiple worker threads
@@ -3173,6 +3189,7 @@ void Sc::Scene::postBroadPhaseStage2(PxBaseTask* continuation)
 
 void Sc::Scene::postBroadPhaseStage3(PxBaseTask* /*continuation*/)
 {
+	SC_SIM_PHASE_ZONE(eBROAD_PHASE);
 	finishBroadPhaseStage2(0);
 
 	PX_PROFILE_STOP_CROSSTHREAD("Basic.postBroadPhase", getContextId());
@@ -3186,19 +3203,22 @@ public:
 
 	PxsTransformCache& mCache;
 	Bp::BoundsArray& mBoundsArray;
+	PxvSimStats& mSimStats;
 	Sc::ShapeSim* mShapes[MaxShapes];
 	PxU32 mNbShapes;
 
-	DirtyShapeUpdatesTask(PxU64 contextID, PxsTransformCache& cache, Bp::BoundsArray& boundsArray) : 
+	DirtyShapeUpdatesTask(PxU64 contextID, PxsTransformCache& cache, Bp::BoundsArray& boundsArray, PxvSimStats& simStats) : 
 		Cm::Task	(contextID),
 		mCache		(cache),
 		mBoundsArray(boundsArray),
+		mSimStats	(simStats),
 		mNbShapes	(0)
 	{
 	}
 
 	virtual void runInternal() 
 	{
+		PXV_SIM_PHASE_ZONE(&mSimStats, eNARROW_PHASE);
 		for (PxU32 a = 0; a < mNbShapes; ++a)
 		{
 			mShapes[a]->updateCached(mCache, mBoundsArray);
@@ -3213,6 +3233,7 @@ private:
 
 void Sc::Scene::preRigidBodyNarrowPhase(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eNARROW_PHASE);
 	PX_PROFILE_ZONE("Scene.preNarrowPhase", getContextId());
 
 	updateContactDistances(continuation);
@@ -3226,7 +3247,7 @@ void Sc::Scene::preRigidBodyNarrowPhase(PxBaseTask* continuation)
 	Cm::FlushPool& pool = mLLContext->getTaskPool();
 	PxBitMapPinned& changedMap = mAABBManager->getChangedAABBMgActorHandleMap();
 
-	DirtyShapeUpdatesTask* task = PX_PLACEMENT_NEW(pool.allocate(sizeof(DirtyShapeUpdatesTask)), DirtyShapeUpdatesTask)(getContextId(), cache, boundsArray);
+	DirtyShapeUpdatesTask* task = PX_PLACEMENT_NEW(pool.allocate(sizeof(DirtyShapeUpdatesTask)), DirtyShapeUpdatesTask)(getContextId(), cache, boundsArray, mLLContext->getSimStats());
 
 	bool hasDirtyShapes = false;
 	PxU32 index;
@@ -3242,7 +3263,7 @@ void Sc::Scene::preRigidBodyNarrowPhase(PxBaseTask* continuation)
 			{
 				task->setContinuation(continuation);
 				task->removeReference();
-				task = PX_PLACEMENT_NEW(pool.allocate(sizeof(DirtyShapeUpdatesTask)), DirtyShapeUpdatesTask)(getContextId(), cache, boundsArray);
+				task = PX_PLACEMENT_NEW(pool.allocate(sizeof(DirtyShapeUpdatesTask)), DirtyShapeUpdatesTask)(getContextId(), cache, boundsArray, mLLContext->getSimStats());
 			}
 		}
 	}
@@ -3266,6 +3287,7 @@ void Sc::Scene::preRigidBodyNarrowPhase(PxBaseTask* continuation)
 
 void Sc::Scene::updateBoundsAndShapes(PxBaseTask* /*continuation*/)
 {
+	SC_SIM_PHASE_ZONE(eNARROW_PHASE);
 	//if the scene isn't use gpu dynamic and gpu broad phase and the user raise suppress readback flag,
 	//the sdk will refuse to create the scene.
 	const bool useDirectGpuApi = mPublicFlags & PxSceneFlag::eSUPPRESS_READBACK;
@@ -3274,6 +3296,7 @@ void Sc::Scene::updateBoundsAndShapes(PxBaseTask* /*continuation*/)
 
 void Sc::Scene::rigidBodyNarrowPhase(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eNARROW_PHASE);
 	PX_PROFILE_START_CROSSTHREAD("Basic.narrowPhase", getContextId());
 
 	mCCDPass = 0;
@@ -3305,6 +3328,7 @@ void Sc::Scene::rigidBodyNarrowPhase(PxBaseTask* continuation)
 
 void Sc::Scene::unblockNarrowPhase(PxBaseTask*)
 {
+	SC_SIM_PHASE_ZONE(eNARROW_PHASE);
 	/*if (!mCCDBp && mUseGpuRigidBodies)
 		mSimulationController->updateParticleSystemsAndSoftBodies();*/
 	//
@@ -3313,6 +3337,7 @@ void Sc::Scene::unblockNarrowPhase(PxBaseTask*)
 
 void Sc::Scene::postNarrowPhase(PxBaseTask* /*continuation*/)
 {
+	SC_SIM_PHASE_ZONE(eNARROW_PHASE);
 	setCollisionPhaseToInactive();
 
 	mHasContactDistanceChanged = false;
@@ -3331,6 +3356,7 @@ void Sc::Scene::postNarrowPhase(PxBaseTask* /*continuation*/)
 
 void Sc::Scene::fetchPatchEvents(PxBaseTask*)
 {
+	SC_SIM_PHASE_ZONE(eNARROW_PHASE);
 	//PxU32 foundPatchCount, lostPatchCount;
 
 	//{
@@ -3412,6 +3438,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mNphaseCore->getScene().getLowLevelContext()->getSimStats(), eISLAND_GEN);
 		mNphaseCore->lockReports();
 		for (PxU32 i = 0; i < mNbEvents; ++i)
 		{
@@ -3457,6 +3484,7 @@ void Sc::Scene::processNarrowPhaseTouchEventsStage2(PxBaseTask* continuation)
 
 void Sc::Scene::setEdgesConnected(PxBaseTask*)
 {
+	SC_SIM_PHASE_ZONE(eISLAND_GEN);
 	PX_PROFILE_ZONE("Sim.preIslandGen.islandTouches", getContextId());
 	{
 		PX_PROFILE_ZONE("Sim.preIslandGen.setEdgesConnected", getContextId());
@@ -3476,6 +3504,7 @@ void Sc::Scene::setEdgesConnected(PxBaseTask*)
 
 void Sc::Scene::processNarrowPhaseLostTouchEventsIslands(PxBaseTask*)
 {
+	SC_SIM_PHASE_ZONE(eISLAND_GEN);
 	PX_PROFILE_ZONE("Sc::Scene.islandLostTouches", getContextId());
 	const PxU32 count = mTouchLostEvents.size();
 	for(PxU32 i=0; i <count; ++i)
@@ -3487,6 +3516,7 @@ void Sc::Scene::processNarrowPhaseLostTouchEventsIslands(PxBaseTask*)
 
 void Sc::Scene::processNarrowPhaseLostTouchEvents(PxBaseTask*)
 {
+	SC_SIM_PHASE_ZONE(eISLAND_GEN);
 	PX_PROFILE_ZONE("Sc::Scene.processNarrowPhaseLostTouchEvents", getContextId());
 	mLLContext->getNphaseImplementationContext()->waitForContactsReady();
 	PxsContactManagerOutputIterator outputs = this->mLLContext->getNphaseImplementationContext()->getContactManagerOutputs();
@@ -3502,18 +3532,21 @@ void Sc::Scene::processNarrowPhaseLostTouchEvents(PxBaseTask*)
 
 void Sc::Scene::processLostSolverPatches(PxBaseTask* /*continuation*/)
 {
+	SC_SIM_PHASE_ZONE(eNARROW_PHASE);
 	PxvNphaseImplementationContext* nphase = mLLContext->getNphaseImplementationContext();
 	mDynamicsContext->processLostPatches(*mSimpleIslandManager, nphase->getFoundPatchManagers(), nphase->getNbFoundPatchManagers(), nphase->getFoundPatchOutputCounts());
 }
 
 void Sc::Scene::processFoundSolverPatches(PxBaseTask* /*continuation*/)
 {
+	SC_SIM_PHASE_ZONE(eNARROW_PHASE);
 	PxvNphaseImplementationContext* nphase = mLLContext->getNphaseImplementationContext();
 	mDynamicsContext->processFoundPatches(*mSimpleIslandManager, nphase->getFoundPatchManagers(), nphase->getNbFoundPatchManagers(), nphase->getFoundPatchOutputCounts());
 }
 
 void Sc::Scene::islandGen(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eISLAND_GEN);
 	PX_PROFILE_ZONE("Sc::Scene::islandGen", getContextId());
 //	PX_PROFILE_START_CROSSTHREAD("Basic.rigidBodySolver", getContextId());
 
@@ -3694,6 +3727,7 @@ void Sc::Scene::wakeObjectsUp(PxU32 infoFlag)
 
 void Sc::Scene::postIslandGen(PxBaseTask* continuationTask)
 {
+	SC_SIM_PHASE_ZONE(eISLAND_GEN);
 	PX_PROFILE_ZONE("Sim.postIslandGen", getContextId());
 
 	mSetEdgesConnectedTask.setContinuation(continuationTask);
@@ -3705,6 +3739,7 @@ void Sc::Scene::postIslandGen(PxBaseTask* continuationTask)
 
 void Sc::Scene::solver(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eSOLVER_SETUP);
 	PX_PROFILE_START_CROSSTHREAD("Basic.rigidBodySolver", getContextId());
 	//Update forces per body in parallel. This can overlap with the other work in this phase.
 	beforeSolver(continuation);
@@ -3719,6 +3754,7 @@ void Sc::Scene::solver(PxBaseTask* continuation)
 
 void Sc::Scene::updateBodies(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eSOLVER_SETUP);
 	PX_UNUSED(continuation);
 
 	//dma bodies and articulation data to gpu
@@ -3727,6 +3763,7 @@ void Sc::Scene::updateBodies(PxBaseTask* continuation)
 
 void Sc::Scene::updateShapes(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eBROAD_PHASE);
 	//dma shapes data to gpu
 	mSimulationController->updateShapes(continuation);
 }
@@ -3794,6 +3831,7 @@ static bool deactivateInteraction(Sc::Interaction* interaction, const Sc::Intera
 
 void Sc::Scene::postThirdPassIslandGen(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eISLAND_GEN);
 	PX_PROFILE_ZONE("Sc::Scene::postThirdPassIslandGen", getContextId());
 	putObjectsToSleep(ActorSim::AS_PART_OF_ISLAND_GEN);
 
@@ -3843,6 +3881,7 @@ void Sc::Scene::postThirdPassIslandGen(PxBaseTask* continuation)
 
 void Sc::Scene::processLostContacts(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eISLAND_GEN);
 	PX_PROFILE_ZONE("Sc::Scene::processLostContacts", getContextId());
 	mProcessNarrowPhaseLostTouchTasks.setContinuation(continuation);
 	mProcessNarrowPhaseLostTouchTasks.removeReference();
@@ -3869,6 +3908,7 @@ void Sc::Scene::processLostContacts(PxBaseTask* continuation)
 
 void Sc::Scene::lostTouchReports(PxBaseTask*)
 {
+	SC_SIM_PHASE_ZONE(eISLAND_GEN);
 	PX_PROFILE_ZONE("Sim.lostTouchReports", getContextId());
 	PxsContactManagerOutputIterator outputs = mLLContext->getNphaseImplementationContext()->getContactManagerOutputs();
 
@@ -3895,6 +3935,7 @@ void Sc::Scene::lostTouchReports(PxBaseTask*)
 
 void Sc::Scene::unregisterInteractions(PxBaseTask*)
 {
+	SC_SIM_PHASE_ZONE(eISLAND_GEN);
 	PX_PROFILE_ZONE("Sim.unregisterInteractions", getContextId());
 
 	Bp::AABBManagerBase* aabbMgr = mAABBManager;
@@ -3920,6 +3961,7 @@ void Sc::Scene::unregisterInteractions(PxBaseTask*)
 
 void Sc::Scene::destroyManagers(PxBaseTask*)
 {
+	SC_SIM_PHASE_ZONE(eISLAND_GEN);
 	PX_PROFILE_ZONE("Sim.destroyManagers", getContextId());
 
 	mPostThirdPassIslandGenTask.setContinuation(mProcessLostContactsTask3.getContinuation());
@@ -3947,6 +3989,7 @@ void Sc::Scene::destroyManagers(PxBaseTask*)
 
 void Sc::Scene::processLostContacts2(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eISLAND_GEN);
 	mDestroyManagersTask.setContinuation(continuation);
 	mLostTouchReportsTask.setContinuation(&mDestroyManagersTask);
 	mLostTouchReportsTask.removeReference();
@@ -3983,6 +4026,7 @@ void Sc::Scene::processLostContacts2(PxBaseTask* continuation)
 
 void Sc::Scene::processLostContacts3(PxBaseTask* /*continuation*/)
 {
+	SC_SIM_PHASE_ZONE(eISLAND_GEN);
 	{
 		PX_PROFILE_ZONE("Sim.processLostOverlapsStage2", getContextId());
 
@@ -4024,6 +4068,7 @@ void Sc::Scene::processLostContacts3(PxBaseTask* /*continuation*/)
 //This is called after solver finish
 void Sc::Scene::updateSimulationController(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eINTEGRATION);
 	PX_PROFILE_ZONE("Sim.updateSimulationController", getContextId());
 	
 	PxsTransformCache& cache = getLowLevelContext()->getTransformCache();
@@ -4046,6 +4091,7 @@ void Sc::Scene::updateSimulationController(PxBaseTask* continuation)
 
 void Sc::Scene::updateDynamics(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eSOLVER_SETUP);
 	//Allow processLostContactsTask to run until after 2nd pass of solver completes (update bodies, run sleeping logic etc.)
 	mProcessLostContactsTask3.setContinuation(static_cast<PxLightCpuTask*>(continuation)->getContinuation());
 	mProcessLostContactsTask2.setContinuation(&mProcessLostContactsTask3);
@@ -4078,6 +4124,7 @@ void Sc::Scene::updateDynamics(PxBaseTask* continuation)
 //CCD
 void Sc::Scene::updateCCDMultiPass(PxBaseTask* parentContinuation)
 {
+	SC_SIM_PHASE_ZONE(eCCD);
 	getCcdBodies().forceSize_Unsafe(mSimulationControllerCallback->getNbCcdBodies());
 	
 	// second run of the broadphase for making sure objects we have integrated did not tunnel.
@@ -4134,18 +4181,20 @@ class UpdateCCDBoundsTask : public Cm::Task
 	Sc::BodySim**		mBodySims;
 	PxU32				mNbToProcess;
 	PxI32*				mNumFastMovingShapes;
+	PxvSimStats*		mSimStats;
 
 public:
 
 	static const PxU32 MaxPerTask = 256;
 
-	UpdateCCDBoundsTask(PxU64 contextID, Bp::BoundsArray* boundsArray, PxsTransformCache* transformCache, Sc::BodySim** bodySims, PxU32 nbToProcess, PxI32* numFastMovingShapes) :
+	UpdateCCDBoundsTask(PxU64 contextID, Bp::BoundsArray* boundsArray, PxsTransformCache* transformCache, Sc::BodySim** bodySims, PxU32 nbToProcess, PxI32* numFastMovingShapes, PxvSimStats* simStats) :
 		Cm::Task			(contextID),
 		mBoundArray			(boundsArray),
 		mTransformCache		(transformCache),
 		mBodySims			(bodySims), 
 		mNbToProcess		(nbToProcess),
-		mNumFastMovingShapes(numFastMovingShapes)
+		mNumFastMovingShapes(numFastMovingShapes),
+		mSimStats			(simStats)
 	{
 	}
 
@@ -4201,6 +4250,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(mSimStats, eCCD);
 		PxU32 activeShapes = 0;
 		const PxU32 nb = mNbToProcess;
 		for(PxU32 i=0; i<nb; i++)
@@ -4232,6 +4282,7 @@ public:
 //CCD
 void Sc::Scene::ccdBroadPhaseAABB(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eCCD);
 	PX_PROFILE_START_CROSSTHREAD("Sim.ccdBroadPhaseComplete", getContextId());
 	PX_PROFILE_ZONE("Sim.ccdBroadPhaseAABB", getContextId());
 	PX_UNUSED(continuation);
@@ -4249,7 +4300,7 @@ void Sc::Scene::ccdBroadPhaseAABB(PxBaseTask* continuation)
 		for (PxU32 i = 0; i < mCcdBodies.size(); i+= UpdateCCDBoundsTask::MaxPerTask)
 		{
 			const PxU32 nbToProcess = PxMin(UpdateCCDBoundsTask::MaxPerTask, mCcdBodies.size() - i);
-			UpdateCCDBoundsTask* task = PX_PLACEMENT_NEW(flushPool.allocate(sizeof(UpdateCCDBoundsTask)), UpdateCCDBoundsTask)(getContextId(), mBoundsArray, &transformCache, &mCcdBodies[i], nbToProcess, &mNumFastMovingShapes);
+			UpdateCCDBoundsTask* task = PX_PLACEMENT_NEW(flushPool.allocate(sizeof(UpdateCCDBoundsTask)), UpdateCCDBoundsTask)(getContextId(), mBoundsArray, &transformCache, &mCcdBodies[i], nbToProcess, &mNumFastMovingShapes, &mLLContext->getSimStats());
 			task->setContinuation(continuation);
 			task->removeReference();
 		}
@@ -4259,6 +4310,7 @@ void Sc::Scene::ccdBroadPhaseAABB(PxBaseTask* continuation)
 //CCD
 void Sc::Scene::ccdBroadPhase(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eCCD);
 	PX_PROFILE_ZONE("Sim.ccdBroadPhase", getContextId());
 
 	PxU32 currentPass = mCCDContext->getCurrentCCDPass();
@@ -4316,6 +4368,7 @@ void Sc::Scene::ccdBroadPhase(PxBaseTask* continuation)
 //CCD
 void Sc::Scene::updateCCDSinglePass(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eCCD);
 	PX_PROFILE_ZONE("Sim.updateCCDSinglePass", getContextId());
 	mReportShapePairTimeStamp++;  // This will makes sure that new report pairs will get created instead of re-using the existing ones.
 
@@ -4345,6 +4398,7 @@ void Sc::Scene::updateCCDSinglePass(PxBaseTask* continuation)
 //CCD
 void Sc::Scene::updateCCDSinglePassStage2(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eCCD);
 	PX_PROFILE_ZONE("Sim.updateCCDSinglePassStage2", getContextId());
 	postBroadPhaseStage2(continuation);
 }
@@ -4352,6 +4406,7 @@ void Sc::Scene::updateCCDSinglePassStage2(PxBaseTask* continuation)
 //CCD
 void Sc::Scene::updateCCDSinglePassStage3(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eCCD);
 	PX_PROFILE_ZONE("Sim.updateCCDSinglePassStage3", getContextId());
 	mReportShapePairTimeStamp++;  // This will makes sure that new report pairs will get created instead of re-using the existing ones.
 
@@ -4557,6 +4612,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mLLContext->getSimStats(), eINTEGRATION);
 		PX_PROFILE_ZONE("ConstraintProjection", mContextID);
 		PxcNpThreadContext* context = mLLContext->getNpThreadContext();
 		PxArray<Sc::BodySim*>& tempArray = context->mBodySimPool;
@@ -4596,6 +4652,7 @@ private:
 
 void Sc::Scene::constraintProjection(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eINTEGRATION);
 	if(mConstraints.size() == 0)
 		return;
 	PxU32 constraintGroupRootCount = 0;
@@ -4612,7 +4669,7 @@ void Sc::Scene::constraintProjection(PxBaseTask* continuation)
 
 	if(activeBodyCount)
 	{
-		mTmpConstraintGroupRootBuffer = reinterpret_cast<ConstraintGroupNode**>(mLLContext->getScratchAllocator().alloc(sizeof(ConstraintGroupNode*) * activeBodyCount, true));
+		mTmpConstraintGroupRootBuffer = reinterpret_cast<ConstraintGroupNode**>(mLLContext->getScratchAllocator().alloc(sizeof(ConstraintGroupNode*) * activeBodyCount, true, PxSimulationStatistics::eSCRATCH_CONSTRAINT_PROJECTION));
 		if(mTmpConstraintGroupRootBuffer)
 		{
 			while(activeBodyCount--)
@@ -4674,6 +4731,7 @@ void Sc::Scene::constraintProjection(PxBaseTask* continuation)
 
 void Sc::Scene::postSolver(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eINTEGRATION);
 	PX_PROFILE_ZONE("Sc::Scene::postSolver", getContextId());
 	PxcNpMemBlockPool& blockPool = mLLContext->getNpMemBlockPool();
 
@@ -4717,6 +4775,7 @@ void Sc::Scene::postSolver(PxBaseTask* continuation)
 //CCD
 void Sc::Scene::postCCDPass(PxBaseTask* /*continuation*/)
 {
+	SC_SIM_PHASE_ZONE(eCCD);
 	// - Performs sleep check
 	// - Updates touch flags
 
@@ -4784,6 +4843,7 @@ void Sc::Scene::postCCDPass(PxBaseTask* /*continuation*/)
 
 void Sc::Scene::finalizationPhase(PxBaseTask* /*continuation*/)
 {
+	SC_SIM_PHASE_ZONE(eINTEGRATION);
 	PX_PROFILE_ZONE("Sim.sceneFinalization", getContextId());
 
 	if (mCCDContext)
@@ -4816,8 +4876,6 @@ void Sc::Scene::finalizationPhase(PxBaseTask* /*continuation*/)
 
 	PX_PROFILE_STOP_CROSSTHREAD("Basic.rigidBodySolver", getContextId());
 
-	mTaskPool.clear();
-
 	mReportShapePairTimeStamp++;	// important to do this before fetchResults() is called to make sure that delayed deleted actors/shapes get
 									// separate pair entries in contact reports
 }
@@ -4834,6 +4892,9 @@ void Sc::Scene::postReportsCleanup()
 	mConstraintIDTracker->clearDeletedIDMap();
 
 	mSimulationController->flush();
+
+	// the task pool holds the allocations of the whole step, including the callback tasks of fetchResults
+	mTaskPool.clear();
 }
 
 PX_COMPILE_TIME_ASSERT(sizeof(PxTransform32)==sizeof(PxsCachedTransform));
@@ -5002,19 +5063,22 @@ public:
 	const PxReal				mDt;
 	IG::SimpleIslandManager*	mIslandManager;
 	PxsSimulationController*	mSimulationController;
+	PxvSimStats*				mSimStats;
 
 public:
 
-	ScBeforeSolverTask(PxReal dt, IG::SimpleIslandManager* islandManager, PxsSimulationController* simulationController, PxU64 contextID) : 
+	ScBeforeSolverTask(PxReal dt, IG::SimpleIslandManager* islandManager, PxsSimulationController* simulationController, PxvSimStats* simStats, PxU64 contextID) : 
 		Cm::Task				(contextID),
 		mDt						(dt),
 		mIslandManager			(islandManager),
-		mSimulationController	(simulationController)
+		mSimulationController	(simulationController),
+		mSimStats				(simStats)
 	{
 	}
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(mSimStats, eSOLVER_SETUP);
 		PX_PROFILE_ZONE("Sim.ScBeforeSolverTask", mContextID);
 		const IG::IslandSim& islandSim = mIslandManager->getAccurateIslandSim();
 		const PxU32 rigidBodyOffset = Sc::BodySim::getRigidBodyOffset();
@@ -5101,20 +5165,23 @@ public:
 	const PxU32							mNumArticulations;
 	const PxReal						mDt;
 	IG::SimpleIslandManager*			mIslandManager;
+	PxvSimStats*						mSimStats;
 
 public:
 
-	ScArticBeforeSolverTask(Sc::ArticulationSim* const* articSims, PxU32 nbArtics, PxReal dt, IG::SimpleIslandManager* islandManager, PxU64 contextID) :
+	ScArticBeforeSolverTask(Sc::ArticulationSim* const* articSims, PxU32 nbArtics, PxReal dt, IG::SimpleIslandManager* islandManager, PxvSimStats* simStats, PxU64 contextID) :
 		Cm::Task(contextID),
 		mArticSims(articSims),
 		mNumArticulations(nbArtics),
 		mDt(dt),
-		mIslandManager(islandManager)
+		mIslandManager(islandManager),
+		mSimStats(simStats)
 	{
 	}
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(mSimStats, eSOLVER_SETUP);
 		PX_PROFILE_ZONE("Sim.ScArticBeforeSolverTask", mContextID);
 		//const IG::IslandSim& islandSim = mIslandManager->getAccurateIslandSim();
 
@@ -5169,7 +5236,7 @@ void Sc::Scene::beforeSolver(PxBaseTask* continuation)
 
 		for (PxU32 i = iter.getNext(); i != PxBitMap::Iterator::DONE; /*i = iter.getNext()*/)
 		{
-			ScBeforeSolverTask* task = PX_PLACEMENT_NEW(flushPool.allocate(sizeof(ScBeforeSolverTask)), ScBeforeSolverTask(mDt, mSimpleIslandManager, mSimulationController, getContextId()));
+			ScBeforeSolverTask* task = PX_PLACEMENT_NEW(flushPool.allocate(sizeof(ScBeforeSolverTask)), ScBeforeSolverTask(mDt, mSimpleIslandManager, mSimulationController, &mLLContext->getSimStats(), getContextId()));
 			PxU32 count = 0;
 			for (; count < MaxBodiesPerTask && i != PxBitMap::Iterator::DONE; i = iter.getNext())
 			{
@@ -5202,7 +5269,7 @@ void Sc::Scene::beforeSolver(PxBaseTask* continuation)
 		const PxU32 nbToProcess = PxMin(PxU32(nbDirtyArticulations - a), nbArticsPerTask);
 
 		ScArticBeforeSolverTask* task = PX_PLACEMENT_NEW(flushPool.allocate(sizeof(ScArticBeforeSolverTask)), ScArticBeforeSolverTask(artiSim + a, nbToProcess,
-			mDt, mSimpleIslandManager, getContextId()));
+			mDt, mSimpleIslandManager, &mLLContext->getSimStats(), getContextId()));
 
 		task->setContinuation(continuation);
 		task->removeReference();
@@ -5267,6 +5334,7 @@ public:
 
 void Sc::Scene::afterIntegration(PxBaseTask* continuation)
 {		
+	SC_SIM_PHASE_ZONE(eINTEGRATION);
 	PX_PROFILE_ZONE("Sc::Scene::afterIntegration", getContextId());
 	mLLContext->getTransformCache().resetChangedState(); //Reset the changed state. If anything outside of the GPU kernels updates any shape's transforms, this will be raised again
 	getBoundsArray().resetChangedState();
@@ -6115,6 +6183,15 @@ void Sc::Scene::getStats(PxSimulationStatistics& s) const
 	for(PxU32 i=0; i<PxGeometryType::eGEOMETRY_COUNT; i++)
 		s.nbShapes[i] = mNbGeometries[i];
 
+	const PxcScratchAllocator& scratchAllocator = mLLContext->getScratchAllocator();
+	for(PxU32 i=0; i<PxSimulationStatistics::eSCRATCH_USAGE_COUNT; i++)
+		s.scratchPeakBytes[i] = scratchAllocator.getPeakBytes(PxSimulationStatistics::ScratchUsageType(i));
+	s.scratchPeakTotalBytes = scratchAllocator.getPeakTotalBytes();
+	s.scratchHeapFallbackBytes = scratchAllocator.getHeapFallbackBytes();
+
+	s.taskPoolBytes = mTaskPool.getLastUsedBytes();
+	s.taskPoolPeakBytes = mTaskPool.getPeakUsedBytes();
+
 #if PX_SUPPORT_GPU_PHYSX
 	if (mHeapMemoryAllocationManager)
 	{
@@ -7219,6 +7296,7 @@ static PX_FORCE_INLINE bool isParticleSystem(const PxActorType::Enum actorType)
 
 void Sc::Scene::islandInsertion(PxBaseTask* /*continuation*/)
 {
+	SC_SIM_PHASE_ZONE(eBROAD_PHASE);
 	{
 		PX_PROFILE_ZONE("Sim.processNewOverlaps.islandInsertion", getContextId());
 
@@ -7276,6 +7354,7 @@ void Sc::Scene::islandInsertion(PxBaseTask* /*continuation*/)
 
 void Sc::Scene::registerContactManagers(PxBaseTask* /*continuation*/)
 {
+	SC_SIM_PHASE_ZONE(eBROAD_PHASE);
 	{
 		PxvNphaseImplementationContext* nphaseContext = mLLContext->getNphaseImplementationContext();
 		nphaseContext->lock();
@@ -7299,6 +7378,7 @@ void Sc::Scene::registerContactManagers(PxBaseTask* /*continuation*/)
 
 void Sc::Scene::registerInteractions(PxBaseTask* /*continuation*/)
 {
+	SC_SIM_PHASE_ZONE(eBROAD_PHASE);
 	{
 		PX_PROFILE_ZONE("Sim.processNewOverlaps.registerInteractions", getContextId());
 		const PxU32 nbShapeIdxCreated = mPreallocatedShapeInteractions.size();
@@ -7346,6 +7426,7 @@ void Sc::Scene::registerInteractions(PxBaseTask* /*continuation*/)
 
 void Sc::Scene::registerSceneInteractions(PxBaseTask* /*continuation*/)
 {
+	SC_SIM_PHASE_ZONE(eBROAD_PHASE);
 	PX_PROFILE_ZONE("Sim.processNewOverlaps.registerInteractionsScene", getContextId());
 	const PxU32 nbShapeIdxCreated = mPreallocatedShapeInteractions.size();
 	for (PxU32 a = 0; a < nbShapeIdxCreated; ++a)
@@ -7413,6 +7494,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mNPhaseCore->getScene().getLowLevelContext()->getSimStats(), eBROAD_PHASE);
 		mNPhaseCore->runOverlapFilters(	mNbToProcess, mPairs, mFinfo, mNbToKeep, mNbToSuppress, mNbToCallback, mKeepMap, mCallbackMap);
 	}
 
@@ -7445,6 +7527,7 @@ public:
 
 	virtual void runInternal()
 	{
+		PXV_SIM_PHASE_ZONE(&mNPhaseCore->getScene().getLowLevelContext()->getSimStats(), eBROAD_PHASE);
 		PxsContactManager** currentCm = mContactManagers;
 		Sc::ShapeInteraction** currentSI = mShapeInteractions;
 		Sc::ElementInteractionMarker** currentEI = mInteractionMarkers;
@@ -7554,6 +7637,7 @@ void Sc::Scene::finishBroadPhase(PxBaseTask* continuation)
 
 void Sc::Scene::preallocateContactManagers(PxBaseTask* continuation)
 {
+	SC_SIM_PHASE_ZONE(eBROAD_PHASE);
 	//Iterate over all filter tasks and work out how many pairs we need...
 
 	PxU32 createdOverlapCount = 0;
@@ -7821,6 +7905,7 @@ void Sc::Scene::activateEdgesInternal(const IG::EdgeIndex* activatingEdges, cons
 
 void Sc::Scene::secondPassNarrowPhase(PxBaseTask* /*continuation*/)
 {
+	SC_SIM_PHASE_ZONE(eNARROW_PHASE);
 	{
 		PX_PROFILE_ZONE("Sim.postIslandGen", getContextId());
 		mSimpleIslandManager->additionalSpeculativeActivation();
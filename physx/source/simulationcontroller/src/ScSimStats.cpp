@@ -65,6 +65,62 @@ void Sc::SimStats::simStart()
 #endif
 }
 
+static PX_FORCE_INLINE PxReal toMilliseconds(PxU64 ticks, const PxCounterFrequencyToTensOfNanos& freq)
+{
+	return PxReal(PxF64(freq.toTensOfNanos(ticks)) * 0.00001);
+}
+
+static void readOutTimers(PxSimulationStatistics& s, const PxvSimTimers& timers)
+{
+	const PxCounterFrequencyToTensOfNanos& freq = PxTime::getBootCounterFrequency();
+
+	s.simulationWallTime = toMilliseconds(timers.mStepEnd - timers.mStepStart, freq);
+
+	const PxU32 nbThreads = timers.getNbThreads();
+
+	for(PxU32 i=0; i < PxSimulationStatistics::ePHASE_COUNT; i++)
+	{
+		PxU64 firstStart = 0;
+		PxU64 lastEnd = 0;
+		PxU64 time = 0;
+		PxU32 nbTasks = 0;
+		for(PxU32 j=0; j < nbThreads; j++)
+		{
+			const PxvSimThreadTimers& thread = timers.mThreads[j];
+			if(!thread.mFirstStart[i])
+				continue;
+
+			if(!firstStart || thread.mFirstStart[i] < firstStart)
+				firstStart = thread.mFirstStart[i];
+			lastEnd = PxMax(lastEnd, thread.mLastEnd[i]);
+			time += thread.mTime[i];
+			nbTasks += thread.mNbTasks[i];
+		}
+
+		s.phaseWallTime[i] = lastEnd ? toMilliseconds(lastEnd - firstStart, freq) : 0.0f;
+		s.phaseCpuTime[i] = toMilliseconds(time, freq);
+		s.phaseNbTasks[i] = nbTasks;
+	}
+
+	s.nbWorkers = nbThreads;
+	for(PxU32 j=0; j < nbThreads; j++)
+	{
+		const PxvSimThreadTimers& thread = timers.mThreads[j];
+
+		PxU64 time = 0;
+		PxU32 nbTasks = 0;
+		for(PxU32 i=0; i < PxSimulationStatistics::ePHASE_COUNT; i++)
+		{
+			time += thread.mTime[i];
+			nbTasks += thread.mNbTasks[i];
+		}
+
+		s.workerNbTasks[j] = nbTasks;
+		s.workerBusyTime[j] = toMilliseconds(time, freq);
+		s.workerIdleTime[j] = PxMax(s.simulationWallTime - s.workerBusyTime[j], 0.0f);
+	}
+}
+
 void Sc::SimStats::readOut(PxSimulationStatistics& s, const PxvSimStats& simStats) const
 {
 #if PX_ENABLE_SIM_STATS
@@ -135,6 +191,8 @@ void Sc::SimStats::readOut(PxSimulationStatistics& s, const PxvSimStats& simStat
 	s.gpuMemParticles = gpuMemSizeParticles;
 	s.gpuMemSoftBodies = gpuMemSizeSoftBodies;
 
+	readOutTimers(s, simStats.mTimers);
+
 #else
 	PX_CATCH_UNDEFINED_ENABLE_SIM_STATS
 	PX_UNUSED(s);
@@ -127,6 +127,15 @@ static CustomProperty gCustomProperties[] = {
 	DEFINE_SIM_STATS_DUAL_INDEXED_PROPERTY( NbTriggerPairs, NbTriggerPairsProperty, nbTriggerPairs),
 #undef DEFINE_SIM_STATS_DUAL_INDEXED_PROPERTY
 	CustomProperty( "PxSimulationStatistics",	"NbShapes",				"NbShapesProperty", "PxU32 NbShapes[PxGeometryType::eGEOMETRY_COUNT];", "PxMemCopy( NbShapes, inSource->nbShapes, sizeof( NbShapes ) );" ),
+#define DEFINE_SIM_STATS_INDEXED_PROPERTY( propName, propType, fieldName, valueType, count ) CustomProperty("PxSimulationStatistics", #propName,	#propType, #valueType " " #propName "[" #count "];", "PxMemCopy( "#propName ", inSource->"#fieldName", sizeof( "#propName" ) );" )
+	DEFINE_SIM_STATS_INDEXED_PROPERTY( PhaseWallTime, PhaseWallTimeProperty, phaseWallTime, PxReal, PxSimulationStatistics::ePHASE_COUNT ),
+	DEFINE_SIM_STATS_INDEXED_PROPERTY( PhaseCpuTime, PhaseCpuTimeProperty, phaseCpuTime, PxReal, PxSimulationStatistics::ePHASE_COUNT ),
+	DEFINE_SIM_STATS_INDEXED_PROPERTY( PhaseNbTasks, PhaseNbTasksProperty, phaseNbTasks, PxU32, PxSimulationStatistics::ePHASE_COUNT ),
+	DEFINE_SIM_STATS_INDEXED_PROPERTY( WorkerNbTasks, WorkerNbTasksProperty, workerNbTasks, PxU32, PxSimulationStatistics::eMAX_NB_WORKERS ),
+	DEFINE_SIM_STATS_INDEXED_PROPERTY( WorkerBusyTime, WorkerBusyTimeProperty, workerBusyTime, PxReal, PxSimulationStatistics::eMAX_NB_WORKERS ),
+	DEFINE_SIM_STATS_INDEXED_PROPERTY( WorkerIdleTime, WorkerIdleTimeProperty, workerIdleTime, PxReal, PxSimulationStatistics::eMAX_NB_WORKERS ),
+	DEFINE_SIM_STATS_INDEXED_PROPERTY( ScratchPeakBytes, ScratchPeakBytesProperty, scratchPeakBytes, PxU32, PxSimulationStatistics::eSCRATCH_USAGE_COUNT ),
+#undef DEFINE_SIM_STATS_INDEXED_PROPERTY
 	CustomProperty( "PxScene",					"SimulationStatistics",	"SimulationStatisticsProperty", "PxSimulationStatistics SimulationStatistics;", "inSource->getSimulationStatistics(SimulationStatistics);"  ),
 	CustomProperty( "PxShape",					"Geom",					"PxShapeGeomProperty", "PxGeometryHolder Geom;", "Geom = PxGeometryHolder(inSource->getGeometry());"  ),
 	CustomProperty( "PxCustomGeometry", "CustomType", "PxCustomGeometryCustomTypeProperty", "PxU32 CustomType;", "PxCustomGeometry::Type t = inSource->callbacks->getCustomType(); CustomType = *reinterpret_cast<const PxU32*>(&t);"  ),